@@ -62,60 +62,23 @@ void AudioBuffer::changeMaxBlockSize(uint16_t mbs) {
 uint16_t AudioBuffer::getMaxBlockSize() { return m_maxBlockSize; }
 
 size_t AudioBuffer::freeSpace() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_freeSpace = m_buffSize;
-        else m_freeSpace = 0;
-    }
-    if(m_readPtr < m_writePtr) {
-        m_freeSpace = (m_endPtr - m_writePtr) + (m_readPtr - m_buffer);
-    }
-    if(m_readPtr > m_writePtr) {
-        m_freeSpace = m_readPtr - m_writePtr;
-    }
-    return m_freeSpace;
+    return m_buffSize - bufferFilled();
 }
 
 size_t AudioBuffer::writeSpace() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_writeSpace = m_endPtr - m_writePtr;
-        else m_writeSpace = 0;
-    }
-    if(m_readPtr < m_writePtr) {
-        m_writeSpace = m_endPtr - m_writePtr;
-    }
-    if(m_readPtr > m_writePtr) {
-        m_writeSpace = m_readPtr - m_writePtr;
-    }
-    return m_writeSpace;
+    size_t space = freeSpace();
+    size_t toEnd = m_endPtr - m_writePtr;
+    return space < toEnd ? space : toEnd;
 }
 
 size_t AudioBuffer::bufferFilled() {
-    if(m_readPtr == m_writePtr) {
-        if(m_f_isEmpty == true) m_dataLength = 0;
-        else m_dataLength = m_buffSize;
-    }
-    if(m_readPtr < m_writePtr) {
-        m_dataLength = m_writePtr - m_readPtr;
-    }
-    if(m_readPtr > m_writePtr) {
-        m_dataLength = (m_endPtr - m_readPtr) + (m_writePtr - m_buffer);
-    }
-    return m_dataLength;
+    return m_written.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
 }
 
 size_t AudioBuffer::getMaxAvailableBytes() {
-    if(m_readPtr == m_writePtr) {
-    //   if(m_f_start)m_dataLength = 0;
-        if(m_f_isEmpty == true) m_dataLength = 0;
-        else m_dataLength = (m_endPtr - m_readPtr);
-    }
-    if(m_readPtr < m_writePtr) {
-        m_dataLength = m_writePtr - m_readPtr;
-    }
-    if(m_readPtr > m_writePtr) {
-        m_dataLength = (m_endPtr - m_readPtr);
-    }
-    return m_dataLength;
+    size_t filled = bufferFilled();
+    size_t toEnd = m_endPtr - m_readPtr;
+    return filled < toEnd ? filled : toEnd;
 }
 
 void AudioBuffer::bytesWritten(size_t bw) {
@@ -123,7 +86,7 @@ void AudioBuffer::bytesWritten(size_t bw) {
     m_writePtr += bw;
     if(m_writePtr == m_endPtr) { m_writePtr = m_buffer; }
     if(m_writePtr > m_endPtr) log_e("m_writePtr %i, m_endPtr %i", m_writePtr, m_endPtr);
-    m_f_isEmpty = false;
+    m_written.store(m_written.load(std::memory_order_relaxed) + bw, std::memory_order_release); // publish after the data
 }
 
 void AudioBuffer::bytesWasRead(size_t br) {
@@ -133,7 +96,7 @@ void AudioBuffer::bytesWasRead(size_t br) {
         size_t tmp = m_readPtr - m_endPtr;
         m_readPtr = m_buffer + tmp;
     }
-    if(m_readPtr == m_writePtr) m_f_isEmpty = true;
+    m_read.store(m_read.load(std::memory_order_relaxed) + br, std::memory_order_release); // hand the space back
 }
 
 uint8_t* AudioBuffer::getWritePtr() { return m_writePtr; }
@@ -146,11 +109,12 @@ uint8_t* AudioBuffer::getReadPtr() {
     return m_readPtr;
 }
 
-void AudioBuffer::resetBuffer() {
+void AudioBuffer::resetBuffer() { // writer and reader must both be idle
     m_writePtr = m_buffer;
     m_readPtr = m_buffer;
     m_endPtr = m_buffer + m_buffSize;
-    m_f_isEmpty = true;
+    m_written.store(0);
+    m_read.store(0);
 }
 
 uint32_t AudioBuffer::getWritePos() { return m_writePtr - m_buffer; }
@@ -160,7 +124,7 @@ uint32_t AudioBuffer::getReadPos() { return m_readPtr - m_buffer; }
 // clang-format off
 Audio::Audio(uint8_t i2sPort) {
 
-    mutex_playAudioData = xSemaphoreCreateMutex();
+    mutex_playAudioData = xSemaphoreCreateRecursiveMutex();
     mutex_audioTask     = xSemaphoreCreateMutex();
 
     if(!psramFound()) log_e("audioI2S requires PSRAM!");
@@ -194,6 +158,9 @@ Audio::Audio(uint8_t i2sPort) {
     m_i2s_std_cfg.clk_cfg.clk_src        = I2S_CLK_SRC_DEFAULT;        // Select PLL_F160M as the default source clock
     m_i2s_std_cfg.clk_cfg.mclk_multiple  = I2S_MCLK_MULTIPLE_128;      // mclk = sample_rate * 256
     i2s_channel_init_std_mode(m_i2s_tx_handle, &m_i2s_std_cfg);
+    i2s_event_callbacks_t i2s_cbs = {};
+    i2s_cbs.on_sent = i2sOnSent;                           // every DMA buffer sent wakes the feeder, must be registered before enable
+    i2s_channel_register_event_callback(m_i2s_tx_handle, &i2s_cbs, this);
     I2Sstart();
     m_sampleRate = m_i2s_std_cfg.clk_cfg.sample_rate_hz;
 
@@ -206,11 +173,14 @@ Audio::Audio(uint8_t i2sPort) {
     }
     computeLimit();  // first init, vol = 21, vol_steps = 21
     startAudioTask();
+    startNetworkTask();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 Audio::~Audio() {
     // I2Sstop(m_i2s_num);
     // InBuff.~AudioBuffer(); #215 the AudioBuffer is automatically destroyed by the destructor
+    stopNetworkTask();
+    stopAudioTask(); // the feeder writes to the channel, stop it before the channel is deleted
     setDefaults();
 
     i2s_channel_disable(m_i2s_tx_handle);
@@ -224,8 +194,9 @@ Audio::~Audio() {
     x_ps_free(&m_ibuff);
     x_ps_free(&m_lastM3U8host);
     x_ps_free(&m_speechtxt);
+    m_pipe.begin(NULL, 0);
+    x_ps_free(&m_pcmRing);
 
-    stopAudioTask();
     vSemaphoreDelete(mutex_playAudioData);
     vSemaphoreDelete(mutex_audioTask);
 }
@@ -339,7 +310,7 @@ void Audio::setDefaults() {
     m_M4A_objectType = 0;
     m_M4A_sampleRate = 0;
     m_sumBytesDecoded = 0;
-    m_vuLeft = m_vuRight = 0; // #835
+    m_dsp.resetMeter(); // #835
 
     if(m_f_reset_m3u8Codec){m_m3u8Codec = CODEC_AAC;} // reset to default
     m_f_reset_m3u8Codec = true;
@@ -2338,6 +2309,7 @@ size_t Audio::process_m3u8_ID3_Header(uint8_t* packet) {
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::stopSong() {
+    xSemaphoreTakeRecursive(mutex_playAudioData, 0.3 * configTICK_RATE_HZ); // not while the network task is in the middle of a read
     m_f_lockInBuffer = true; // wait for the decoding to finish
         static uint8_t maxWait = 0;
         while(m_f_audioTaskIsDecoding) {vTaskDelay(1); maxWait++; if(maxWait > 100) break;} // in case of error wait max 100ms
@@ -2355,7 +2327,7 @@ uint32_t Audio::stopSong() {
             AUDIO_INFO("Closing audio file \"%s\"", audiofile.name());
             audiofile.close();
         }
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // Clear FilterBuffer
+        m_dsp.reset(); // Clear FilterBuffer
         if(m_codec == CODEC_MP3) MP3Decoder_FreeBuffers();
         if(m_codec == CODEC_AAC) AACDecoder_FreeBuffers();
         if(m_codec == CODEC_M4A) AACDecoder_FreeBuffers();
@@ -2369,7 +2341,10 @@ uint32_t Audio::stopSong() {
         m_dataMode = AUDIO_NONE;
         m_streamType = ST_NONE;
         m_playlistFormat = FORMAT_NONE;
+        m_pipe.setActive(false);
+        if(!m_f_eof) m_pipe.flush(); // stopped by the user, a song that ended plays out
         m_f_lockInBuffer = false;
+    xSemaphoreGiveRecursive(mutex_playAudioData);
     return pos;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -2383,54 +2358,29 @@ bool Audio::pauseResume() {
             memset(m_outBuff, 0, m_outbuffSize * sizeof(int16_t)); // Clear OutputBuffer
             memset(m_samplesBuff48K, 0, m_samplesBuff48KSize * sizeof(int16_t)); // Clear SamplesBuffer
             m_validSamples = 0;
+            m_pipe.flush();
         }
+        m_pipe.setActive(m_f_running);
     }
     xSemaphoreGive(mutex_audioTask);
     return retVal;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-size_t Audio::resampleTo48kStereo(const int16_t* input, size_t inputFrames) {
-
-    float exactOutputFrames = inputFrames * m_resampleRatio;;
-    size_t outputFrames = static_cast<size_t>(std::floor(exactOutputFrames + m_resampleError));
-    m_resampleError += exactOutputFrames - outputFrames;
-
-    std::vector<int16_t> output(outputFrames * 2);
-
-    for (size_t i = 0; i < outputFrames; ++i) {
-        float inFramePos = i / m_resampleRatio;
-        size_t idx = static_cast<size_t>(inFramePos);
-        float frac = inFramePos - idx;
-
-        size_t i1 = idx * 2;
-        size_t i2 = (idx + 1 < inputFrames) ? (idx + 1) * 2 : i1;
-
-        int16_t left1 = input[i1];
-        int16_t right1 = input[i1 + 1];
-        int16_t left2 = input[i2];
-        int16_t right2 = input[i2 + 1];
-
-        m_samplesBuff48K[i * 2]     = static_cast<int16_t>(left1 * (1.0f - frac) + left2 * frac);
-        m_samplesBuff48K[i * 2 + 1] = static_cast<int16_t>(right1 * (1.0f - frac) + right2 * frac);
-    }
-
-    return outputFrames;
+int16_t* Audio::resampleTo48kStereo(int16_t* input, size_t inputFrames, size_t* outputFrames) {
+    // m_samplesBuff48K, or the input itself if it is 48kHz already
+    return m_dsp.resample48k(input, inputFrames, m_samplesBuff48K, outputFrames);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void IRAM_ATTR Audio::playChunk() {
 
-    int32_t validSamples = 0;
     static int32_t samples48K = 0; // samples in 48kHz
+    static int16_t* buff48K = NULL; // holds them
     static uint32_t count = 0;
-    size_t i2s_bytesConsumed = 0;
-    int16_t* sample[2] = {0};
-    int16_t* s2;
-    int sampleSize = 4; // 2 bytes per sample (int16_t) * 2 channels
-    esp_err_t err = ESP_OK;
-    int i= 0;
+    size_t frames48K = 0;
+    uint32_t pushed = 0;
 
-    if(count > 0) goto i2swrite;
+    if(count > 0) goto pcmwrite;
 
     if(getChannels() == 1){
         for (int i = m_validSamples - 1; i >= 0; --i) {
@@ -2441,40 +2391,18 @@ void IRAM_ATTR Audio::playChunk() {
     //    m_validSamples *= 2;
     }
 
-    validSamples = m_validSamples;
-
-    while(validSamples) {
-        *sample = m_outBuff + i;
-        computeVUlevel(*sample);
+    // VU meter, filter chain, mono and gain in one pass over the chunk
+    m_dsp.setMono(m_f_forceMono && m_channels == 2);
+    m_dsp.process(m_outBuff, m_validSamples);
 
-        //---------- Filterchain, can commented out if not used-------------
-        {
-            if(m_corr > 1) {
-                s2 = *sample;
-                s2[LEFTCHANNEL] /= m_corr;
-                s2[RIGHTCHANNEL] /= m_corr;
-            }
-            IIR_filterChain0(*sample);
-            IIR_filterChain1(*sample);
-            IIR_filterChain2(*sample);
-        }
-        //------------------------------------------------------------------
-        if(m_f_forceMono && m_channels == 2){
-            int32_t xy = ((*sample)[RIGHTCHANNEL] + (*sample)[LEFTCHANNEL]) / 2;
-            (*sample)[RIGHTCHANNEL] = (int16_t)xy;
-            (*sample)[LEFTCHANNEL]  = (int16_t)xy;
-        }
-        Gain(*sample);
-        i += 2;
-        validSamples -= 1;
-    }
     //------------------------------------------------------------------------------------------
-    samples48K = resampleTo48kStereo(m_outBuff, m_validSamples);
+    buff48K = resampleTo48kStereo(m_outBuff, m_validSamples, &frames48K);
+    samples48K = frames48K;
 
     if(audio_process_i2s) {
         // processing the audio samples from external before forwarding them to i2s
         bool continueI2S = false;
-        audio_process_i2s((int16_t*)m_samplesBuff48K, samples48K, &continueI2S); // 48KHz stereo 16bps
+        audio_process_i2s(buff48K, samples48K, &continueI2S); // 48KHz stereo 16bps
         if(!continueI2S) {
             samples48K = 0;
             count = 0;
@@ -2482,12 +2410,12 @@ void IRAM_ATTR Audio::playChunk() {
         }
     }
 
-i2swrite:
+pcmwrite:
 
-    err = i2s_channel_write(m_i2s_tx_handle, (int16_t*)m_samplesBuff48K + count, samples48K * sampleSize, &i2s_bytesConsumed, 10);
-    if( ! (err == ESP_OK || err == ESP_ERR_TIMEOUT)) goto exit;
-    samples48K -= i2s_bytesConsumed / sampleSize;
-    count += i2s_bytesConsumed / 2;
+    // into the PCM ring, never blocks: what does not fit stays in m_validSamples until the feeder asks for more
+    pushed = m_pipe.push(buff48K + count, samples48K);
+    samples48K -= pushed;
+    count += pushed * 2;
     if(samples48K <= 0) { m_validSamples = 0; count = 0; }
 
 // ---- statistics, bytes written to I2S (every 10s)
@@ -2499,20 +2427,16 @@ i2swrite:
     //     cnt = 0;
     //     t = millis();
     // }
-    // cnt+= i2s_bytesConsumed;
+    // cnt+= pushed * 4;
 //-------------------------------------------
-
-
-    return;
-exit:
-    if     (err == ESP_OK) return;
-    else if(err == ESP_ERR_INVALID_ARG)   log_e("NULL pointer or this handle is not tx handle");
-    else if(err == ESP_ERR_TIMEOUT)       log_e("Writing timeout, no writing event received from ISR within ticks_to_wait");
-    else if(err == ESP_ERR_INVALID_STATE) log_e("I2S is not ready to write");
-    else log_e("i2s err %i", err);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::loop() {
+    if(m_f_netTaskIsRunning) return; // processNetwork() runs in its own task
+    processNetwork();
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::processNetwork() {
     if(!m_f_running) return;
 
     if(m_playlistFormat != FORMAT_M3U8) { // normal process
@@ -3305,6 +3229,7 @@ void Audio::processLocalFile() {
         m_f_lockInBuffer = true;                          // lock the buffer, the InBuffer must not be re-entered in playAudioData()
             while(m_f_audioTaskIsDecoding) vTaskDelay(1); // We can't reset the InBuffer while the decoding is in progress
             InBuff.resetBuffer();
+            m_pipe.flush();                               // the old position must not be heard after the jump
         m_f_lockInBuffer = false;
         newFilePos = m_resumeFilePos;
         audiofile.seek(newFilePos);
@@ -3456,6 +3381,9 @@ void Audio::processWebStream() {
 
     // buffer fill routine - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
     if(availableBytes) {
+        static bool f_full = false; // count each time the buffer runs full once, not every pass
+        if(InBuff.freeSpace() == 0) {if(!f_full) m_pipe.countOverrun(); f_full = true;}
+        else f_full = false;
         availableBytes = min(availableBytes, (uint32_t)InBuff.writeSpace());
         int32_t bytesAddedToBuffer = _client->read(InBuff.getWritePtr(), availableBytes);
         if(bytesAddedToBuffer > 0) {
@@ -3867,6 +3795,7 @@ void Audio::playAudioData() {
         m_bytesNotDecoded = 0;
         lastFrames = false;
         m_f_eof = false;
+        m_pipe.setActive(true); // from now on an empty PCM ring is a dropout
     }
     //--------------------------------------------------------------------------------
 
@@ -3905,6 +3834,7 @@ void Audio::playAudioData() {
     if(bytesDecoded <= 0) {
         if(lastFrames) {m_f_eof = true; goto exit;} // end of file reached
         count++;
+        if(!m_f_allDataReceived) m_pipe.countInputStarved();
         vTaskDelay(50); // wait for data
         if(count == 10) {if(m_f_allDataReceived) m_f_eof = true;}  // maybe slow stream
         goto exit; // syncword at pos0
@@ -3924,6 +3854,7 @@ void Audio::playAudioData() {
     }
 
 exit:
+    if(m_f_eof) m_pipe.setActive(false); // the rest of the ring plays out, then silence
     m_f_audioTaskIsDecoding = false;
     return;
 }
@@ -4674,7 +4605,7 @@ void Audio::setDecoderItems() {
         AUDIO_INFO("Num of channels must be 1 or 2, found %i", getChannels());
         stopSong();
     }
-    memset(m_filterBuff, 0, sizeof(m_filterBuff)); // Clear FilterBuffer
+    m_dsp.reset(); // Clear FilterBuffer
     IIR_calculateCoefficients(m_gain0, m_gain1, m_gain2); // must be recalculated after each samplerate change
     showCodecParams();
 }
@@ -5069,6 +5000,12 @@ bool Audio::setPinout(uint8_t BCLK, uint8_t LRC, uint8_t DOUT, int8_t MCLK) {
     gpio_cfg.mclk = (gpio_num_t)MCLK;
     gpio_cfg.ws = (gpio_num_t)LRC;
     I2Sstop();
+    if(!m_pcmRing) { // once, nothing plays before the first setPinout()
+        const uint32_t frames = PIPELINE_RING_SLOTS * PIPELINE_SLOT_FRAMES;
+        m_pcmRing = (int16_t*)x_ps_malloc(frames * 2 * sizeof(int16_t));
+        if(m_pcmRing) m_pipe.begin(m_pcmRing, frames);
+        else log_e("oom");
+    }
     result = i2s_channel_reconfig_std_gpio(m_i2s_tx_handle, &gpio_cfg);
     I2Sstart();
 
@@ -5187,7 +5124,7 @@ bool Audio::setSampleRate(uint32_t sampRate) {
         m_sampleRate = 8000;
     }
     m_sampleRate = sampRate;
-    m_resampleRatio = 48000.0f / (float)m_sampleRate;
+    m_dsp.setSampleRate(m_sampleRate);
     return true;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -5241,72 +5178,10 @@ void Audio::setI2SCommFMT_LSB(bool commFMT) {
     i2s_channel_enable(m_i2s_tx_handle);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::computeVUlevel(int16_t sample[2]) {
-    static uint8_t sampleArray[2][4][8] = {0};
-    static uint8_t cnt0 = 0, cnt1 = 0, cnt2 = 0, cnt3 = 0, cnt4 = 0;
-    static bool    f_vu = false;
-
-    auto avg = [&](uint8_t* sampArr) { // lambda, inner function, compute the average of 8 samples
-        uint16_t av = 0;
-        for(int i = 0; i < 8; i++) { av += sampArr[i]; }
-        return av >> 3;
-    };
-
-    auto largest = [&](uint8_t* sampArr) { // lambda, inner function, compute the largest of 8 samples
-        uint16_t maxValue = 0;
-        for(int i = 0; i < 8; i++) {
-            if(maxValue < sampArr[i]) maxValue = sampArr[i];
-        }
-        return maxValue;
-    };
-
-    if(cnt0 == 64) {
-        cnt0 = 0;
-        cnt1++;
-    }
-    if(cnt1 == 8) {
-        cnt1 = 0;
-        cnt2++;
-    }
-    if(cnt2 == 8) {
-        cnt2 = 0;
-        cnt3++;
-    }
-    if(cnt3 == 8) {
-        cnt3 = 0;
-        cnt4++;
-        f_vu = true;
-    }
-    if(cnt4 == 8) { cnt4 = 0; }
-
-    if(!cnt0) { // store every 64th sample in the array[0]
-        sampleArray[LEFTCHANNEL][0][cnt1] = abs(sample[LEFTCHANNEL] >> 7);
-        sampleArray[RIGHTCHANNEL][0][cnt1] = abs(sample[RIGHTCHANNEL] >> 7);
-    }
-    if(!cnt1) { // store argest from 64 * 8 samples in the array[1]
-        sampleArray[LEFTCHANNEL][1][cnt2] = largest(sampleArray[LEFTCHANNEL][0]);
-        sampleArray[RIGHTCHANNEL][1][cnt2] = largest(sampleArray[RIGHTCHANNEL][0]);
-    }
-    if(!cnt2) { // store avg from 64 * 8 * 8 samples in the array[2]
-        sampleArray[LEFTCHANNEL][2][cnt3] = largest(sampleArray[LEFTCHANNEL][1]);
-        sampleArray[RIGHTCHANNEL][2][cnt3] = largest(sampleArray[RIGHTCHANNEL][1]);
-    }
-    if(!cnt3) { // store avg from 64 * 8 * 8 * 8 samples in the array[3]
-        sampleArray[LEFTCHANNEL][3][cnt4] = avg(sampleArray[LEFTCHANNEL][2]);
-        sampleArray[RIGHTCHANNEL][3][cnt4] = avg(sampleArray[RIGHTCHANNEL][2]);
-    }
-    if(f_vu) {
-        f_vu = false;
-        m_vuLeft = avg(sampleArray[LEFTCHANNEL][3]);
-        m_vuRight = avg(sampleArray[RIGHTCHANNEL][3]);
-    }
-    cnt1++;
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint16_t Audio::getVUlevel() {
     // avg 0 ... 127
     if(!m_f_running) return 0;
-    return (m_vuLeft << 8) + m_vuRight;
+    return (m_dsp.vuLeft() << 8) + m_dsp.vuRight();
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass) {
@@ -5319,7 +5194,8 @@ void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass
 
     // gain, attenuation (set in digital filters)
     int db = max(m_gain0, max(m_gain1, m_gain2));
-    m_corr = pow10f((float)db / 20);
+    float corr = pow10f((float)db / 20); // correction factor for level adjustment
+    m_dsp.setPreGain(corr > 1 ? 1 / corr : 1);
 
     IIR_calculateCoefficients(m_gain0, m_gain1, m_gain2);
 
@@ -5328,14 +5204,16 @@ void Audio::setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass
           Because when the EQ is adjusted, the IIR filter will be cleared and played,
           mixed in the audio data frame, and a click-like sound will be produced.
 
-          int16_t tmp[2]; tmp[0] = 0; tmp[1]= 0;
-
-          IIR_filterChain0(tmp, true ); // flush the filter
-          IIR_filterChain1(tmp, true ); // flush the filter
-          IIR_filterChain2(tmp, true ); // flush the filter
+          m_dsp.reset(); // flush the filter
         */
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+void Audio::setResampleQuality(uint8_t quality) { // polyphase FIR taps: 8, 24, 48
+    xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ); // the tables switch between chunks
+    m_dsp.setResampleQuality(quality);
+    xSemaphoreGive(mutex_audioTask);
+}
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 void Audio::forceMono(bool m) { // #100 mono option
     m_f_forceMono = m;          // false stereo, true mono
 }
@@ -5382,16 +5260,9 @@ void Audio::computeLimit() {    // is calculated when the volume or balance chan
             break;
     }
 
-    m_limit_left = l * v;
-    m_limit_right = r * v;
+    m_dsp.setGain(l * v, r * v);
 
-    // log_i("m_limit_left %f,  m_limit_right %f ",m_limit_left, m_limit_right);
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::Gain(int16_t* sample) {
-    /* important: these multiplications must all be signed ints, or the result will be invalid */
-    sample[LEFTCHANNEL]  *= m_limit_left ;
-    sample[RIGHTCHANNEL] *= m_limit_right;
+    // log_i("limit left %f,  limit right %f ", l * v, r * v);
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 uint32_t Audio::inBufferFilled() {
@@ -5517,150 +5388,9 @@ void Audio::IIR_calculateCoefficients(int8_t G0, int8_t G1, int8_t G2) { // Infi
     //                                                  m_filter[1].b1, m_filter[1].b2);
     //    log_i("HS a0=%f, a1=%f, a2=%f, b1=%f, b2=%f", m_filter[2].a0, m_filter[2].a1, m_filter[2].a2,
     //                                                  m_filter[2].b1, m_filter[2].b2);
+
+    for(int i = 0; i < 3; i++) m_dsp.setFilter(i, m_filter[i].a0, m_filter[i].a1, m_filter[i].a2, m_filter[i].b1, m_filter[i].b2);
 }
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-// clang-format off
-void Audio::IIR_filterChain0(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-    float          inSample[2];
-    float          outSample[2];
-    static int16_t iir_out[2];
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        iir_out[0] = 0;
-        iir_out[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    inSample[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    inSample[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    outSample[LEFTCHANNEL] =
-        m_filter[0].a0 * inSample[LEFTCHANNEL] + m_filter[0].a1 * m_filterBuff[0][z1][in][LEFTCHANNEL] +
-        m_filter[0].a2 * m_filterBuff[0][z2][in][LEFTCHANNEL] - m_filter[0].b1 * m_filterBuff[0][z1][out][LEFTCHANNEL] -
-        m_filter[0].b2 * m_filterBuff[0][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[0][z2][in][LEFTCHANNEL] = m_filterBuff[0][z1][in][LEFTCHANNEL];
-    m_filterBuff[0][z1][in][LEFTCHANNEL] = inSample[LEFTCHANNEL];
-    m_filterBuff[0][z2][out][LEFTCHANNEL] = m_filterBuff[0][z1][out][LEFTCHANNEL];
-    m_filterBuff[0][z1][out][LEFTCHANNEL] = outSample[LEFTCHANNEL];
-    iir_out[LEFTCHANNEL] = (int16_t)outSample[LEFTCHANNEL];
-
-    outSample[RIGHTCHANNEL] = m_filter[0].a0 * inSample[RIGHTCHANNEL] +
-                              m_filter[0].a1 * m_filterBuff[0][z1][in][RIGHTCHANNEL] +
-                              m_filter[0].a2 * m_filterBuff[0][z2][in][RIGHTCHANNEL] -
-                              m_filter[0].b1 * m_filterBuff[0][z1][out][RIGHTCHANNEL] -
-                              m_filter[0].b2 * m_filterBuff[0][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[0][z2][in][RIGHTCHANNEL] = m_filterBuff[0][z1][in][RIGHTCHANNEL];
-    m_filterBuff[0][z1][in][RIGHTCHANNEL] = inSample[RIGHTCHANNEL];
-    m_filterBuff[0][z2][out][RIGHTCHANNEL] = m_filterBuff[0][z1][out][RIGHTCHANNEL];
-    m_filterBuff[0][z1][out][RIGHTCHANNEL] = outSample[RIGHTCHANNEL];
-    iir_out[RIGHTCHANNEL] = (int16_t)outSample[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = iir_out[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = iir_out[RIGHTCHANNEL];
-    return;
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::IIR_filterChain1(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-    float          inSample[2];
-    float          outSample[2];
-    static int16_t iir_out[2];
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        iir_out[0] = 0;
-        iir_out[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    inSample[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    inSample[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    outSample[LEFTCHANNEL] =
-        m_filter[1].a0 * inSample[LEFTCHANNEL] + m_filter[1].a1 * m_filterBuff[1][z1][in][LEFTCHANNEL] +
-        m_filter[1].a2 * m_filterBuff[1][z2][in][LEFTCHANNEL] - m_filter[1].b1 * m_filterBuff[1][z1][out][LEFTCHANNEL] -
-        m_filter[1].b2 * m_filterBuff[1][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[1][z2][in][LEFTCHANNEL] = m_filterBuff[1][z1][in][LEFTCHANNEL];
-    m_filterBuff[1][z1][in][LEFTCHANNEL] = inSample[LEFTCHANNEL];
-    m_filterBuff[1][z2][out][LEFTCHANNEL] = m_filterBuff[1][z1][out][LEFTCHANNEL];
-    m_filterBuff[1][z1][out][LEFTCHANNEL] = outSample[LEFTCHANNEL];
-    iir_out[LEFTCHANNEL] = (int16_t)outSample[LEFTCHANNEL];
-
-    outSample[RIGHTCHANNEL] = m_filter[1].a0 * inSample[RIGHTCHANNEL] +
-                              m_filter[1].a1 * m_filterBuff[1][z1][in][RIGHTCHANNEL] +
-                              m_filter[1].a2 * m_filterBuff[1][z2][in][RIGHTCHANNEL] -
-                              m_filter[1].b1 * m_filterBuff[1][z1][out][RIGHTCHANNEL] -
-                              m_filter[1].b2 * m_filterBuff[1][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[1][z2][in][RIGHTCHANNEL] = m_filterBuff[1][z1][in][RIGHTCHANNEL];
-    m_filterBuff[1][z1][in][RIGHTCHANNEL] = inSample[RIGHTCHANNEL];
-    m_filterBuff[1][z2][out][RIGHTCHANNEL] = m_filterBuff[1][z1][out][RIGHTCHANNEL];
-    m_filterBuff[1][z1][out][RIGHTCHANNEL] = outSample[RIGHTCHANNEL];
-    iir_out[RIGHTCHANNEL] = (int16_t)outSample[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = iir_out[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = iir_out[RIGHTCHANNEL];
-    return;
-}
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-void Audio::IIR_filterChain2(int16_t iir_in[2], bool clear) { // Infinite Impulse Response (IIR) filters
-
-    uint8_t z1 = 0, z2 = 1;
-    enum : uint8_t { in = 0, out = 1 };
-    float          inSample[2];
-    float          outSample[2];
-    static int16_t iir_out[2];
-
-    if(clear) {
-        memset(m_filterBuff, 0, sizeof(m_filterBuff)); // zero IIR filterbuffer
-        iir_out[0] = 0;
-        iir_out[1] = 0;
-        iir_in[0] = 0;
-        iir_in[1] = 0;
-    }
-
-    inSample[LEFTCHANNEL] = (float)(iir_in[LEFTCHANNEL]);
-    inSample[RIGHTCHANNEL] = (float)(iir_in[RIGHTCHANNEL]);
-
-    outSample[LEFTCHANNEL] =
-        m_filter[2].a0 * inSample[LEFTCHANNEL] + m_filter[2].a1 * m_filterBuff[2][z1][in][LEFTCHANNEL] +
-        m_filter[2].a2 * m_filterBuff[2][z2][in][LEFTCHANNEL] - m_filter[2].b1 * m_filterBuff[2][z1][out][LEFTCHANNEL] -
-        m_filter[2].b2 * m_filterBuff[2][z2][out][LEFTCHANNEL];
-
-    m_filterBuff[2][z2][in][LEFTCHANNEL] = m_filterBuff[2][z1][in][LEFTCHANNEL];
-    m_filterBuff[2][z1][in][LEFTCHANNEL] = inSample[LEFTCHANNEL];
-    m_filterBuff[2][z2][out][LEFTCHANNEL] = m_filterBuff[2][z1][out][LEFTCHANNEL];
-    m_filterBuff[2][z1][out][LEFTCHANNEL] = outSample[LEFTCHANNEL];
-    iir_out[LEFTCHANNEL] = (int16_t)outSample[LEFTCHANNEL];
-
-    outSample[RIGHTCHANNEL] = m_filter[2].a0 * inSample[RIGHTCHANNEL] +
-                              m_filter[2].a1 * m_filterBuff[2][z1][in][RIGHTCHANNEL] +
-                              m_filter[2].a2 * m_filterBuff[2][z2][in][RIGHTCHANNEL] -
-                              m_filter[2].b1 * m_filterBuff[2][z1][out][RIGHTCHANNEL] -
-                              m_filter[2].b2 * m_filterBuff[2][z2][out][RIGHTCHANNEL];
-
-    m_filterBuff[2][z2][in][RIGHTCHANNEL] = m_filterBuff[2][z1][in][RIGHTCHANNEL];
-    m_filterBuff[2][z1][in][RIGHTCHANNEL] = inSample[RIGHTCHANNEL];
-    m_filterBuff[2][z2][out][RIGHTCHANNEL] = m_filterBuff[2][z1][out][RIGHTCHANNEL];
-    m_filterBuff[2][z1][out][RIGHTCHANNEL] = outSample[RIGHTCHANNEL];
-    iir_out[RIGHTCHANNEL] = (int16_t)outSample[RIGHTCHANNEL];
-
-    iir_in[LEFTCHANNEL] = iir_out[LEFTCHANNEL];
-    iir_in[RIGHTCHANNEL] = iir_out[RIGHTCHANNEL];
-    return;
-}
-// clang-format on
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //    AAC - T R A N S P O R T S T R E A M
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -6547,8 +6277,11 @@ uint8_t Audio::determineOggCodec(uint8_t* data, uint16_t len) {
     return CODEC_NONE;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-// separate task for decoding and outputting the data. 'playAudioData()' is started periodically and fetches the data from the InBuffer. This ensures
-// that the I2S-DMA is always sufficiently filled, even if the Arduino 'loop' is stuck.
+// Three tasks, connected by wait-free rings (audio_pipeline.h):
+//   network task  fills InBuff from the client or the file (processNetwork(), the former loop() body)
+//   decode task   'playAudioData()' decodes from InBuff into the PCM ring, woken by the feeder when the ring wants data
+//   I2S feeder    woken by every DMA buffer sent, hands the driver exactly one buffer: audio from the ring or silence
+// The DMA never waits for the decoder and the decoder never waits for the network, even if the Arduino 'loop' is stuck.
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void Audio::setAudioTaskCore(uint8_t coreID){  // Recommendation:If the ARDUINO RUNNING CORE is 1, the audio task should be core 0 or vice versa
@@ -6566,7 +6299,18 @@ void Audio::startAudioTask() {
         return;
     }
     m_f_audioTaskIsRunning = true;
+    m_f_feedTaskIsRunning = true;
 
+    m_feedTaskHandle = xTaskCreateStaticPinnedToCore(
+        &Audio::feedTaskWrapper, /* Function to implement the task */
+        "I2SFeeder",            /* Name of the task */
+        AUDIO_FEED_STACK_SIZE,  /* Stack size in words */
+        this,                   /* Task input parameter */
+        10,                     /* Priority, above the decoder and the user tasks, below WiFi and lwIP */
+        xFeedStack,             /* Task stack */
+        &xFeedTaskBuffer,       /* Memory for the task's control block */
+        m_audioTaskCoreId       /* Core where the task should run */
+    );
 
     m_audioTaskHandle = xTaskCreateStaticPinnedToCore(
         &Audio::taskWrapper,    /* Function to implement the task */
@@ -6592,6 +6336,15 @@ void Audio::stopAudioTask()  {
         m_audioTaskHandle = nullptr;
     }
     xSemaphoreGive(mutex_audioTask);
+
+    // the feeder may be inside i2s_channel_write() and holding the driver's lock, it parks itself before it is deleted
+    m_f_feedTaskIsRunning = false;
+    if (m_feedTaskHandle != nullptr) {
+        xTaskNotifyGive(m_feedTaskHandle);
+        while (eTaskGetState(m_feedTaskHandle) != eSuspended) vTaskDelay(1);
+        vTaskDelete(m_feedTaskHandle);
+        m_feedTaskHandle = nullptr;
+    }
 }
 
 void Audio::taskWrapper(void *param) {
@@ -6601,7 +6354,8 @@ void Audio::taskWrapper(void *param) {
 
 void Audio::audioTask() {
     while (m_f_audioTaskIsRunning) {
-        vTaskDelay(1 / portTICK_PERIOD_MS);  // periodically every x ms
+        // PCM ring full: sleep until the feeder has taken it down to the refill level, otherwise decode every tick
+        ulTaskNotifyTake(pdTRUE, m_validSamples ? 20 / portTICK_PERIOD_MS : 1);
         performAudioTask();
     }
     vTaskDelete(nullptr);  // Delete this task
@@ -6613,10 +6367,90 @@ void Audio::performAudioTask() {
     if(m_codec == CODEC_NONE) return; // wait for codec is  set
     if(m_codec == CODEC_OGG)  return; // wait for FLAC, VORBIS or OPUS
     xSemaphoreTake(mutex_audioTask, 0.3 * configTICK_RATE_HZ);
-    while(m_validSamples) {vTaskDelay(20 / portTICK_PERIOD_MS); playChunk();} // I2S buffer full
-    playAudioData();
+    if(m_validSamples) playChunk();    // the rest of the last chunk first
+    if(!m_validSamples) playAudioData();
     xSemaphoreGive(mutex_audioTask);
 }
+
+bool IRAM_ATTR Audio::i2sOnSent(i2s_chan_handle_t handle, i2s_event_data_t* event, void* userCtx) { // ISR
+    Audio* self = static_cast<Audio*>(userCtx);
+    BaseType_t woken = pdFALSE;
+    self->m_pipe.dmaSent();
+    if(self->m_feedTaskHandle) vTaskNotifyGiveFromISR(self->m_feedTaskHandle, &woken);
+    return woken == pdTRUE;
+}
+
+void Audio::feedTaskWrapper(void *param) {
+    Audio *runner = static_cast<Audio*>(param);
+    runner->feedTask();
+}
+
+void Audio::feedTask() {
+    const TickType_t slotTicks = (PIPELINE_SLOT_FRAMES * 1000 / 48000) / portTICK_PERIOD_MS + 1;
+    while (m_f_feedTaskIsRunning) {
+        ulTaskNotifyTake(pdTRUE, 100 / portTICK_PERIOD_MS);
+        while (m_pipe.due() && m_f_feedTaskIsRunning) {
+            size_t written = 0;
+            m_pipe.fillSlot(m_slotBuff);
+            // one slot = one DMA buffer, so a freed buffer takes it whole; the timeout only matters after the channel was restarted
+            i2s_channel_write(m_i2s_tx_handle, m_slotBuff, sizeof(m_slotBuff), &written, 2 * slotTicks);
+        }
+        if (m_pipe.wantsData() && m_audioTaskHandle) xTaskNotifyGive(m_audioTaskHandle);
+    }
+    vTaskSuspend(nullptr); // stopAudioTask() deletes it, so the static stack is free again at once
+}
+
+void Audio::startNetworkTask() {
+    if (m_f_netTaskIsRunning) return;
+    m_f_netTaskIsRunning = true;
+    m_netTaskHandle = xTaskCreateStatic(
+        &Audio::networkTaskWrapper, /* Function to implement the task */
+        "AudioNetwork",         /* Name of the task */
+        AUDIO_NET_STACK_SIZE,   /* Stack size in words */
+        this,                   /* Task input parameter */
+        1,                      /* Priority, as the Arduino loop */
+        xNetStack,              /* Task stack */
+        &xNetTaskBuffer         /* Memory for the task's control block */
+    );
+}
+
+void Audio::stopNetworkTask() {
+    if (!m_f_netTaskIsRunning) return;
+    xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // between two passes, never inside a read
+    m_f_netTaskIsRunning = false;
+    if (m_netTaskHandle != nullptr) {
+        vTaskDelete(m_netTaskHandle);
+        m_netTaskHandle = nullptr;
+    }
+    xSemaphoreGiveRecursive(mutex_playAudioData);
+}
+
+void Audio::networkTaskWrapper(void *param) {
+    Audio *runner = static_cast<Audio*>(param);
+    runner->networkTask();
+}
+
+void Audio::networkTask() {
+    while (m_f_netTaskIsRunning) {
+        xSemaphoreTakeRecursive(mutex_playAudioData, portMAX_DELAY); // connecttoXXX() and stopSong() wait for the end of the pass
+        processNetwork();
+        xSemaphoreGiveRecursive(mutex_playAudioData);
+        vTaskDelay(m_f_running ? 1 : 10 / portTICK_PERIOD_MS);
+    }
+    vTaskDelete(nullptr);
+}
+
+uint32_t Audio::getUnderruns() {
+    AudioPipelineStats st;
+    m_pipe.getStats(&st);
+    return st.underruns;
+}
+
+uint32_t Audio::getOverruns() {
+    AudioPipelineStats st;
+    m_pipe.getStats(&st);
+    return st.overruns;
+}
 uint32_t Audio::getHighWatermark(){
     UBaseType_t highWaterMark = uxTaskGetStackHighWaterMark(m_audioTaskHandle);
     return highWaterMark; // dwords
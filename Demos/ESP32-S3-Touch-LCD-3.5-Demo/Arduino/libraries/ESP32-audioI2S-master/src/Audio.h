@@ -21,6 +21,8 @@
 #include <atomic>
 #include <codecvt>
 #include <locale>
+#include "audio_dsp/audio_dsp.h"
+#include "audio_pipeline/audio_pipeline.h"
 
 #if ESP_ARDUINO_VERSION_MAJOR >= 3
 #include <NetworkClient.h>
@@ -75,6 +77,9 @@ class AudioBuffer {
 //   if the space between m_readPtr and buffend < m_resBuffSize copy data from the beginning to resBuff
 //   so that the mp3/aac/flac frame is always completed
 //
+//   one writer and one reader, wait-free: each moves its own pointer and publishes the byte count with a release
+//   store; fill level and free space are the difference of the two counts
+//
 //  m_buffer                      m_writePtr                 m_readPtr        m_endPtr
 //   |                                 |<-------writeSpace------>|<--dataLength-->|
 //   ▼                                 ▼                         ▼                ▼
@@ -111,18 +116,16 @@ protected:
     size_t            m_buffSizePSRAM    = UINT16_MAX * 10;   // most webstreams limit the advance to 100...300Kbytes
     size_t            m_buffSizeRAM      = 1600 * 10;
     size_t            m_buffSize         = 0;
-    size_t            m_freeSpace        = 0;
-    size_t            m_writeSpace       = 0;
-    size_t            m_dataLength       = 0;
     size_t            m_resBuffSizeRAM   = 4096;     // reserved buffspace, >= one wav  frame
     size_t            m_resBuffSizePSRAM = 4096 * 6; // reserved buffspace, >= one flac frame
     size_t            m_maxBlockSize     = 1600;
     uint8_t*          m_buffer           = NULL;
-    uint8_t*          m_writePtr         = NULL;
-    uint8_t*          m_readPtr          = NULL;
+    uint8_t*          m_writePtr         = NULL;     // owned by the writer (network task)
+    uint8_t*          m_readPtr          = NULL;     // owned by the reader (decode task)
     uint8_t*          m_endPtr           = NULL;
+    std::atomic<uint32_t> m_written{0};              // bytes ever written, published by the writer
+    std::atomic<uint32_t> m_read{0};                 // bytes ever read, published by the reader
     bool              m_f_init           = false;
-    bool              m_f_isEmpty        = true;
     bool              m_f_psram          = false;    // PSRAM is available (and used...)
 };
 //----------------------------------------------------------------------------------------------------------------------
@@ -130,6 +133,12 @@ protected:
 static const size_t AUDIO_STACK_SIZE = 3300;
 static StaticTask_t __attribute__((unused)) xAudioTaskBuffer;
 static StackType_t  __attribute__((unused)) xAudioStack[AUDIO_STACK_SIZE];
+static const size_t AUDIO_FEED_STACK_SIZE = 2048;
+static StaticTask_t __attribute__((unused)) xFeedTaskBuffer;
+static StackType_t  __attribute__((unused)) xFeedStack[AUDIO_FEED_STACK_SIZE];
+static const size_t AUDIO_NET_STACK_SIZE = 8192; // TLS reads run in this task
+static StaticTask_t __attribute__((unused)) xNetTaskBuffer;
+static StackType_t  __attribute__((unused)) xNetStack[AUDIO_NET_STACK_SIZE];
 extern char audioI2SVers[];
 
 class Audio : private AudioBuffer{
@@ -150,7 +159,7 @@ public:
     bool setPinout(uint8_t BCLK, uint8_t LRC, uint8_t DOUT, int8_t MCLK = I2S_GPIO_UNUSED);
     bool pauseResume();
     bool isRunning() {return m_f_running;}
-    void loop();
+    void loop(); // kept for existing sketches, the network task does the work (and calls the audio_xxx callbacks)
     uint32_t stopSong();
     void forceMono(bool m);
     void setBalance(int8_t bal = 0);
@@ -172,11 +181,18 @@ public:
     uint32_t getTotalPlayingTime();
     uint16_t getVUlevel();
 
+    // network task -> InBuff -> decode task -> PCM ring -> I2S feeder (audio_pipeline.h)
+    void     getPipelineStats(AudioPipelineStats* stats) {m_pipe.getStats(stats);}
+    uint32_t getUnderruns();     // output ran dry while playing, audible dropouts
+    uint32_t getOverruns();      // webstream data arrived with the input buffer full, playback slower than the station
+    void     resetPipelineStats() {m_pipe.resetStats();}
+
     uint32_t inBufferFilled(); // returns the number of stored bytes in the inputbuffer
     uint32_t inBufferFree();   // returns the number of free bytes in the inputbuffer
     uint32_t inBufferSize();   // returns the size of the inputbuffer in bytes
     void setBufferSize(size_t mbs); // sets the size of the inputbuffer in bytes
     void setTone(int8_t gainLowPass, int8_t gainBandPass, int8_t gainHighPass);
+    void setResampleQuality(uint8_t quality); // RESAMPLE_LOW, RESAMPLE_MEDIUM (default), RESAMPLE_HIGH
     void setI2SCommFMT_LSB(bool commFMT);
     int getCodec() {return m_codec;}
     const char *getCodecname() {return codecname[m_codec];}
@@ -232,11 +248,9 @@ private:
   bool            setBitsPerSample(int bits);
   bool            setChannels(int channels);
   bool            setBitrate(int br);
-  size_t          resampleTo48kStereo(const int16_t* input, size_t inputFrames);
+  int16_t*        resampleTo48kStereo(int16_t* input, size_t inputFrames, size_t* outputFrames);
   void            playChunk();
-  void            computeVUlevel(int16_t sample[2]);
   void            computeLimit();
-  void            Gain(int16_t* sample);
   void            showstreamtitle(char* ml);
   bool            parseContentType(char* ct);
   bool            parseHttpResponseHeader();
@@ -244,9 +258,6 @@ private:
   esp_err_t       I2Sstart();
   esp_err_t       I2Sstop();
   void            zeroI2Sbuff();
-  void            IIR_filterChain0(int16_t iir_in[2], bool clear = false);
-  void            IIR_filterChain1(int16_t iir_in[2], bool clear = false);
-  void            IIR_filterChain2(int16_t iir_in[2], bool clear = false);
   inline uint32_t streamavail() { return _client ? _client->available() : 0; }
   void            IIR_calculateCoefficients(int8_t G1, int8_t G2, int8_t G3);
   bool            ts_parsePacket(uint8_t* packet, uint8_t* packetStart, uint8_t* packetLength);
@@ -257,11 +268,19 @@ public:
   void            setAudioTaskCore(uint8_t coreID);
   uint32_t        getHighWatermark();
 private:
-  void            startAudioTask(); // starts a task for decode and play
-  void            stopAudioTask();  // stops task for audio
+  void            startAudioTask(); // starts the decode task and the I2S feeder
+  void            stopAudioTask();  // stops both
   static void     taskWrapper(void *param);
   void            audioTask();
   void            performAudioTask();
+  static void     feedTaskWrapper(void *param);
+  void            feedTask();
+  static bool     i2sOnSent(i2s_chan_handle_t handle, i2s_event_data_t* event, void* userCtx);
+  void            startNetworkTask();
+  void            stopNetworkTask();
+  static void     networkTaskWrapper(void *param);
+  void            networkTask();
+  void            processNetwork(); // fills InBuff: headers, playlists, file and stream reads
 
   //+++ W E B S T R E A M  -  H E L P   F U N C T I O N S +++
   uint16_t readMetadata(uint16_t b, bool first = false);
@@ -612,9 +631,11 @@ private:
     NetworkClientSecure	  clientsecure;
     NetworkClient*       _client = nullptr;
 #endif
-    SemaphoreHandle_t     mutex_playAudioData;
+    SemaphoreHandle_t     mutex_playAudioData; // recursive: the network task and the connecttoXXX() calls
     SemaphoreHandle_t     mutex_audioTask;
     TaskHandle_t          m_audioTaskHandle = nullptr;
+    TaskHandle_t          m_feedTaskHandle = nullptr;
+    TaskHandle_t          m_netTaskHandle = nullptr;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
@@ -664,8 +685,6 @@ private:
     int8_t          m_balance = 0;                  // -16 (mute left) ... +16 (mute right)
     uint16_t        m_vol = 21;                     // volume
     uint16_t        m_vol_steps = 21;               // default
-    double          m_limit_left = 0;               // limiter 0 ... 1, left channel
-    double          m_limit_right = 0;              // limiter 0 ... 1, right channel
     uint8_t         m_timeoutCounter = 0;           // timeout counter
     uint8_t         m_curve = 0;                    // volume characteristic
     uint8_t         m_bitsPerSample = 16;           // bitsPerSample
@@ -679,8 +698,6 @@ private:
     uint8_t         m_filterType[2];                // lowpass, highpass
     uint8_t         m_streamType = ST_NONE;
     uint8_t         m_ID3Size = 0;                  // lengt of ID3frame - ID3header
-    uint8_t         m_vuLeft = 0;                   // average value of samples, left channel
-    uint8_t         m_vuRight = 0;                  // average value of samples, right channel
     uint8_t         m_audioTaskCoreId = 0;
     uint8_t         m_M4A_objectType = 0;           // set in read_M4A_Header
     uint8_t         m_M4A_chConfig = 0;             // set in read_M4A_Header
@@ -751,12 +768,14 @@ private:
     uint8_t         m_f_channelEnabled = 3;         //
     uint32_t        m_audioFileDuration = 0;
     float           m_audioCurrentTime = 0;
-    float           m_resampleError = 0.0f;
-    float           m_resampleRatio = 1.0f;         // resample ratio for e.g. 44.1kHz to 48kHz
     uint32_t        m_audioDataStart = 0;           // in bytes
     size_t          m_audioDataSize = 0;            //
-    float           m_filterBuff[3][2][2][2];       // IIR filters memory for Audio DSP
-    float           m_corr = 1.0;					// correction factor for level adjustment
+    AudioDSP        m_dsp;                          // VU, tone, mono, volume, resampling to 48kHz
+    AudioPipeline   m_pipe;                         // PCM ring decode task -> I2S feeder, counters
+    int16_t*        m_pcmRing = NULL;               // its memory, PSRAM
+    int16_t         m_slotBuff[PIPELINE_SLOT_FRAMES * 2]; // one DMA buffer, filled by the feeder
+    bool            m_f_feedTaskIsRunning = false;
+    bool            m_f_netTaskIsRunning = false;
     size_t          m_i2s_bytesWritten = 0;         // set in i2s_write() but not used
     size_t          m_fileSize = 0;                 // size of the file
     uint16_t        m_filterFrequency[2];
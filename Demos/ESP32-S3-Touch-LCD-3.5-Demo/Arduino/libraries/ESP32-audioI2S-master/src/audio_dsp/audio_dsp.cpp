@@ -0,0 +1,201 @@
+/*
+ * audio_dsp.cpp
+ *
+ * Implementation
+ */
+#include "audio_dsp.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+  #include <esp_attr.h>
+#else
+  #define IRAM_ATTR
+#endif
+
+#if AUDIO_DSP_ESP_DSP
+  #include <esp_dsp.h>
+#endif
+
+#define Q28 268435456.0f
+#define Q16 65536.0f
+
+static inline int16_t saturate16(int32_t v) {
+    return v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+}
+
+// One biquad step, Q28 coefficients, Q8 samples. x and y hold [n-1], [n-2].
+static inline int32_t biquadQ28(const int32_t* q, int32_t* x, int32_t* y, int32_t in) {
+    int64_t acc = (int64_t)q[0] * in + (int64_t)q[1] * x[0] + (int64_t)q[2] * x[1]
+                - (int64_t)q[3] * y[0] - (int64_t)q[4] * y[1];
+    int32_t out = (int32_t)((acc + (1 << 27)) >> 28);
+    x[1] = x[0];
+    x[0] = in;
+    y[1] = y[0];
+    y[0] = out;
+    return out;
+}
+//----------------------------------------------------------------------------------------------------------------------
+AudioDSP::AudioDSP() {
+    memset(m_stage, 0, sizeof(m_stage));
+    m_preGain = 1;
+    for(uint8_t i = 0; i < AUDIO_DSP_STAGES; i++) setFilter(i, 1, 0, 0, 0, 0);
+    m_mono = false;
+    m_gain[0] = m_gain[1] = 1 << 16;
+    reset();
+    resetMeter();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setFilter(uint8_t stage, float a0, float a1, float a2, float b1, float b2) {
+    if(stage >= AUDIO_DSP_STAGES) return;
+    float* raw = m_stage[stage].raw;
+    raw[0] = a0;
+    raw[1] = a1;
+    raw[2] = a2;
+    raw[3] = b1;
+    raw[4] = b2;
+    applyStage(stage);
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setPreGain(float gain) {
+    m_preGain = gain;
+    applyStage(0);
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioDSP::setGain(float left, float right) {
+    m_gain[0] = (uint32_t)lroundf(left * Q16);
+    m_gain[1] = (uint32_t)lroundf(right * Q16);
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioDSP::reset() {
+    memset(m_x, 0, sizeof(m_x));
+    memset(m_y, 0, sizeof(m_y));
+#if AUDIO_DSP_ESP_DSP
+    memset(m_w, 0, sizeof(m_w));
+#endif
+    m_resampler.reset();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioDSP::resetMeter() {
+    memset(m_vuPeak, 0, sizeof(m_vuPeak));
+    memset(m_vuPeaks, 0, sizeof(m_vuPeaks));
+    memset(m_vuAvg, 0, sizeof(m_vuAvg));
+    memset(m_vuLevel, 0, sizeof(m_vuLevel));
+    m_vuCount = m_vuPeakIdx = m_vuAvgIdx = 0;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioDSP::applyStage(uint8_t stage) {
+    Stage& s = m_stage[stage];
+    // The pre-gain scales the input of the chain: fold it into the feed-forward part of the first stage
+    float pre = stage == 0 ? m_preGain : 1.0f;
+    for(uint8_t i = 0; i < 5; i++) s.coef[i] = i < 3 ? s.raw[i] * pre : s.raw[i];
+    for(uint8_t i = 0; i < 5; i++) s.q[i] = (int32_t)lroundf(s.coef[i] * Q28);
+
+    // H(z) = 1: a0 = 1 and the feed-forward taps cancel the feedback taps
+    const float eps = 1e-6f;
+    s.bypass = fabsf(s.coef[0] - 1) < eps && fabsf(s.coef[1] - s.coef[3]) < eps && fabsf(s.coef[2] - s.coef[4]) < eps;
+
+    m_filterActive = false;
+    for(uint8_t i = 0; i < AUDIO_DSP_STAGES; i++) m_filterActive |= !m_stage[i].bypass;
+}
+//----------------------------------------------------------------------------------------------------------------------
+inline void AudioDSP::meter(int16_t left, int16_t right) {
+    int16_t in[2] = {left, right};
+    for(uint8_t ch = 0; ch < 2; ch++) {
+        int32_t v = in[ch] >> 7;
+        v = v < 0 ? -v : v;
+        uint8_t level = v > 255 ? 255 : v;
+        if(level > m_vuPeak[ch]) m_vuPeak[ch] = level;
+    }
+    if(++m_vuCount < 64) return;
+
+    // Every 64 frames: store the peak, every 8 peaks an average, every 8 averages the level
+    m_vuCount = 0;
+    for(uint8_t ch = 0; ch < 2; ch++) {
+        m_vuPeaks[ch][m_vuPeakIdx] = m_vuPeak[ch];
+        m_vuPeak[ch] = 0;
+    }
+    if(++m_vuPeakIdx < 8) return;
+    m_vuPeakIdx = 0;
+    for(uint8_t ch = 0; ch < 2; ch++) {
+        uint16_t sum = 0;
+        for(uint8_t i = 0; i < 8; i++) sum += m_vuPeaks[ch][i];
+        m_vuAvg[ch][m_vuAvgIdx] = sum >> 3;
+    }
+    if(++m_vuAvgIdx < 8) return;
+    m_vuAvgIdx = 0;
+    for(uint8_t ch = 0; ch < 2; ch++) {
+        uint16_t sum = 0;
+        for(uint8_t i = 0; i < 8; i++) sum += m_vuAvg[ch][i];
+        m_vuLevel[ch] = sum >> 3;
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+template <bool FILTER, bool MONO>
+void IRAM_ATTR AudioDSP::processFixed(int16_t* s, size_t frames) {
+    const int64_t gainL = m_gain[0], gainR = m_gain[1];
+
+    for(size_t n = 0; n < frames; n++, s += 2) {
+        meter(s[0], s[1]);
+        int32_t l = (int32_t)s[0] * 256; // Q8
+        int32_t r = (int32_t)s[1] * 256;
+        if(FILTER) {
+            for(uint8_t k = 0; k < AUDIO_DSP_STAGES; k++) {
+                const Stage& st = m_stage[k];
+                if(st.bypass) continue;
+                l = biquadQ28(st.q, m_x[k][0], m_y[k][0], l);
+                r = biquadQ28(st.q, m_x[k][1], m_y[k][1], r);
+            }
+        }
+        if(MONO) l = r = (l + r) >> 1;
+        // Q8 x Q16 -> >> 24
+        s[0] = saturate16((int32_t)((l * gainL + (1 << 23)) >> 24));
+        s[1] = saturate16((int32_t)((r * gainR + (1 << 23)) >> 24));
+    }
+}
+//----------------------------------------------------------------------------------------------------------------------
+#if AUDIO_DSP_ESP_DSP
+void IRAM_ATTR AudioDSP::processFloat(int16_t* s, size_t frames) {
+    const float gainL = m_gain[0] / Q16, gainR = m_gain[1] / Q16;
+
+    while(frames) {
+        size_t n = frames < AUDIO_DSP_BLOCK ? frames : AUDIO_DSP_BLOCK;
+
+        for(size_t i = 0; i < n; i++) {
+            meter(s[2 * i], s[2 * i + 1]);
+            m_plane[0][i] = s[2 * i];
+            m_plane[1][i] = s[2 * i + 1];
+        }
+        for(uint8_t k = 0; k < AUDIO_DSP_STAGES; k++) {
+            if(m_stage[k].bypass) continue;
+            dsps_biquad_f32(m_plane[0], m_plane[0], n, m_stage[k].coef, m_w[k][0]);
+            dsps_biquad_f32(m_plane[1], m_plane[1], n, m_stage[k].coef, m_w[k][1]);
+        }
+        for(size_t i = 0; i < n; i++) {
+            float l = m_plane[0][i], r = m_plane[1][i];
+            if(m_mono) l = r = (l + r) * 0.5f;
+            s[2 * i] = saturate16(lroundf(l * gainL));
+            s[2 * i + 1] = saturate16(lroundf(r * gainR));
+        }
+        s += 2 * n;
+        frames -= n;
+    }
+}
+#endif
+//----------------------------------------------------------------------------------------------------------------------
+void IRAM_ATTR AudioDSP::process(int16_t* samples, size_t frames) {
+#if AUDIO_DSP_ESP_DSP
+    if(m_filterActive) {
+        processFloat(samples, frames);
+        return;
+    }
+#else
+    if(m_filterActive) {
+        if(m_mono) processFixed<true, true>(samples, frames);
+        else processFixed<true, false>(samples, frames);
+        return;
+    }
+#endif
+    if(m_mono) processFixed<false, true>(samples, frames);
+    else processFixed<false, false>(samples, frames);
+}
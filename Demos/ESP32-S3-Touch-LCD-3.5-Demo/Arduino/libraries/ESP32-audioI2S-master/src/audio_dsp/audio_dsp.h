@@ -0,0 +1,110 @@
+/*
+ * audio_dsp.h
+ *
+ * Block processing for Audio::playChunk(): VU meter, tone control (three
+ * biquads: low shelf, peak EQ, high shelf), mono mix and volume/balance in
+ * one pass over the whole chunk, then the resample to 48 kHz (resampler.h).
+ *
+ * Nothing allocates: filter state and scratch buffers are members.
+ *
+ * Filters run in one of two ways:
+ *   - ESP-DSP available (esp_dsp.h, e.g. ESP32-S3): dsps_biquad_f32 on
+ *     de-interleaved float blocks, which uses the PIE/AE32 kernels
+ *   - otherwise: fixed point, Q28 coefficients, samples carried as Q8
+ *     between the stages (no int16 truncation inside the chain)
+ * Define AUDIO_DSP_PORTABLE to force the fixed-point path.
+ *
+ * A stage whose coefficients reduce to H(z) = 1 (every EQ gain at 0 dB) is
+ * skipped; with all three flat the filters cost nothing.
+ *
+ * Volume is Q16 fixed point (the limit used to be a double, i.e. soft float
+ * on the ESP32).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "resampler.h"
+
+#if !defined(AUDIO_DSP_PORTABLE) && defined(ESP_PLATFORM) && __has_include(<esp_dsp.h>)
+  #define AUDIO_DSP_ESP_DSP 1
+#else
+  #define AUDIO_DSP_ESP_DSP 0
+#endif
+
+#define AUDIO_DSP_STAGES   3
+#define AUDIO_DSP_BLOCK    256     // frames per float block (ESP-DSP path)
+
+class AudioDSP {
+public:
+    AudioDSP();
+
+    // Biquad `stage`, in the naming of Audio::IIR_calculateCoefficients():
+    // a0..a2 feed forward, b1, b2 feedback
+    void setFilter(uint8_t stage, float a0, float a1, float a2, float b1, float b2);
+    // Applied before the filters (headroom for EQ boost), 1.0 = none
+    void setPreGain(float gain);
+    // Volume and balance per channel, 0.0 ... 1.0
+    void setGain(float left, float right);
+    void setMono(bool mono) { m_mono = mono; }
+    // Clear the filter memory and the resampler delay line
+    void reset();
+    // Clear the VU meter
+    void resetMeter();
+
+    // In place, `frames` interleaved stereo frames
+    void process(int16_t* samples, size_t frames);
+
+    // Output rate is always 48 kHz
+    void setSampleRate(uint32_t sampleRate) { m_resampler.setSampleRate(sampleRate); }
+    // RESAMPLE_LOW, RESAMPLE_MEDIUM or RESAMPLE_HIGH
+    void setResampleQuality(uint8_t quality) { m_resampler.setQuality(quality); }
+    // Stereo `in` -> stereo 48 kHz, see Resampler::process()
+    int16_t* resample48k(int16_t* in, size_t frames, int16_t* out, size_t* outFrames) {
+        return m_resampler.process(in, frames, out, outFrames);
+    }
+
+    // |sample| >> 7 per channel (0 ... 255), peaks over 64 frames averaged
+    // over the last 4096 frames
+    uint8_t vuLeft() const { return m_vuLevel[0]; }
+    uint8_t vuRight() const { return m_vuLevel[1]; }
+
+private:
+    struct Stage {
+        float   raw[5];      // b0 b1 b2 a1 a2 (ESP-DSP order), as set
+        float   coef[5];     // Same, pre-gain folded in (stage 0)
+        int32_t q[5];        // coef, Q28
+        bool    bypass;
+    };
+
+    Stage    m_stage[AUDIO_DSP_STAGES];
+    float    m_preGain;
+    bool     m_filterActive;
+    bool     m_mono;
+    uint32_t m_gain[2];      // Q16
+
+    int32_t  m_x[AUDIO_DSP_STAGES][2][2];          // x[n-1], x[n-2] per channel, Q8
+    int32_t  m_y[AUDIO_DSP_STAGES][2][2];          // y[n-1], y[n-2] per channel, Q8
+#if AUDIO_DSP_ESP_DSP
+    float    m_w[AUDIO_DSP_STAGES][2][2];          // dsps_biquad_f32 delay line per channel
+    float    m_plane[2][AUDIO_DSP_BLOCK];
+#endif
+
+    // VU: peak over 64 frames, 8 peaks averaged, 8 of those averaged
+    uint8_t  m_vuPeak[2];
+    uint8_t  m_vuCount;
+    uint8_t  m_vuPeaks[2][8];
+    uint8_t  m_vuAvg[2][8];
+    uint8_t  m_vuPeakIdx;
+    uint8_t  m_vuAvgIdx;
+    uint8_t  m_vuLevel[2];
+
+    Resampler m_resampler;
+
+    void     applyStage(uint8_t stage);
+    void     meter(int16_t left, int16_t right);
+    template <bool FILTER, bool MONO> void processFixed(int16_t* samples, size_t frames);
+#if AUDIO_DSP_ESP_DSP
+    void     processFloat(int16_t* samples, size_t frames);
+#endif
+};
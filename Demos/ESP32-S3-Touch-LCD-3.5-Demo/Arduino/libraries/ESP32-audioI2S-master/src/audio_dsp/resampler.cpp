@@ -0,0 +1,169 @@
+/*
+ * resampler.cpp
+ *
+ * Implementation
+ */
+#include "resampler.h"
+#include "resampler_tables.h"
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+  #include <esp_attr.h>
+#else
+  #define IRAM_ATTR
+#endif
+
+// Rates with a polyphase table: 48000 / rate = up / down
+static const struct {
+    uint32_t rate;
+    uint16_t up;
+    uint16_t down;
+} RESAMPLE_RATES[] = {
+    { 8000,   6,   1},
+    {16000,   3,   1},
+    {22050, 320, 147},
+    {24000,   2,   1},
+    {32000,   3,   2},
+    {44100, 320, 294},
+};
+
+static inline int16_t saturate16(int64_t v) {
+    return v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+}
+
+// One output sample. Each half of the phase is summed in int32, which the
+// table generator guarantees cannot overflow; the halves are added in 64 bit.
+template <uint8_t TAPS>
+static inline int16_t dot(const int16_t* h, const int16_t* x) {
+    int32_t a = 0, b = 0;
+    for(uint8_t j = 0; j < TAPS / 2; j++) a += h[j] * x[j];
+    for(uint8_t j = TAPS / 2; j < TAPS; j++) b += h[j] * x[j];
+    return saturate16(((int64_t)a + b + (1 << 14)) >> 15);
+}
+//----------------------------------------------------------------------------------------------------------------------
+Resampler::Resampler() {
+    m_table = nullptr;
+    m_quality = RESAMPLE_MEDIUM;
+    m_up = m_down = 1;
+    setSampleRate(48000);
+}
+//----------------------------------------------------------------------------------------------------------------------
+void Resampler::setQuality(uint8_t quality) {
+    if(quality > RESAMPLE_HIGH) quality = RESAMPLE_HIGH;
+    if(quality == m_quality) return;
+    m_quality = quality;
+    select();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void Resampler::setSampleRate(uint32_t sampleRate) {
+    if(sampleRate == 0) return;
+    m_sampleRate = sampleRate;
+    m_step = (uint32_t)(((uint64_t)sampleRate << 16) / 48000);
+    m_rem = 0;
+    select();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void Resampler::select() {
+    m_table = nullptr;
+    for(const auto& r : RESAMPLE_RATES) {
+        if(r.rate != m_sampleRate) continue;
+        for(const ResampleTable& t : RESAMPLE_TABLES) {
+            if(t.up != r.up || t.quality != m_quality) continue;
+            m_table = &t;
+            m_up = r.up;
+            m_down = r.down;
+        }
+    }
+    reset();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void Resampler::reset() {
+    memset(m_line, 0, sizeof(m_line));
+    m_phase = 0;
+    m_next = m_table ? m_table->taps - 1 : 0;
+    m_rem = 0;
+}
+//----------------------------------------------------------------------------------------------------------------------
+float Resampler::delay() const {
+    if(!m_table) return 0;
+    return (float)(m_table->taps * m_up - 1) / (2 * m_up);
+}
+//----------------------------------------------------------------------------------------------------------------------
+int16_t* IRAM_ATTR Resampler::process(int16_t* in, size_t frames, int16_t* out, size_t* outFrames) {
+    if(passThrough()) {
+        *outFrames = frames;
+        return in;
+    }
+    if(!m_table) {
+        *outFrames = linear(in, frames, out);
+        return out;
+    }
+    switch(m_table->taps) {
+        case 8:  *outFrames = fir<8>(in, frames, out); break;
+        case 24: *outFrames = fir<24>(in, frames, out); break;
+        default: *outFrames = fir<48>(in, frames, out); break;
+    }
+    return out;
+}
+//----------------------------------------------------------------------------------------------------------------------
+// The delay line holds the last TAPS - 1 frames of the previous block, then the new block, de-interleaved
+template <uint8_t TAPS>
+size_t IRAM_ATTR Resampler::fir(const int16_t* in, size_t frames, int16_t* out) {
+    static_assert(TAPS <= RESAMPLE_TAPS_MAX, "delay line too short");
+    const size_t   hist = TAPS - 1;
+    const int16_t* coef = m_table->coef;
+    size_t         written = 0;
+
+    while(frames) {
+        size_t n = frames < RESAMPLE_BLOCK ? frames : RESAMPLE_BLOCK;
+        for(size_t i = 0; i < n; i++) {
+            m_line[0][hist + i] = in[2 * i];
+            m_line[1][hist + i] = in[2 * i + 1];
+        }
+
+        const size_t end = hist + n;
+        while(m_next < end) {
+            const int16_t* h = coef + m_phase * TAPS;
+            const size_t   first = m_next - hist;
+            out[2 * written] = dot<TAPS>(h, m_line[0] + first);
+            out[2 * written + 1] = dot<TAPS>(h, m_line[1] + first);
+            written++;
+            m_phase += m_down;
+            while(m_phase >= m_up) {
+                m_phase -= m_up;
+                m_next++;
+            }
+        }
+
+        memmove(m_line[0], m_line[0] + n, hist * sizeof(int16_t));
+        memmove(m_line[1], m_line[1] + n, hist * sizeof(int16_t));
+        m_next -= n;
+        in += 2 * n;
+        frames -= n;
+    }
+    return written;
+}
+//----------------------------------------------------------------------------------------------------------------------
+// Rates without a table: linear interpolation inside the chunk, position as
+// Q16 input frames (chunks below 65536 frames)
+size_t IRAM_ATTR Resampler::linear(const int16_t* in, size_t frames, int16_t* out) {
+    if(frames == 0) return 0;
+
+    // Exact frame count: the fraction left over is carried as a remainder, no float error accumulates
+    uint64_t total = (uint64_t)frames * 48000 + m_rem;
+    size_t   outFrames = (size_t)(total / m_sampleRate);
+    m_rem = (uint32_t)(total % m_sampleRate);
+
+    const size_t last = frames - 1;
+    uint32_t     pos = 0;
+    for(size_t i = 0; i < outFrames; i++, pos += m_step) {
+        size_t  idx = pos >> 16;
+        int32_t frac = (pos >> 1) & 0x7FFF; // Q15
+        if(idx > last) idx = last;
+        const int16_t* a = in + 2 * idx;
+        const int16_t* b = idx < last ? a + 2 : a;
+        out[2 * i] = (int16_t)(a[0] + (((b[0] - a[0]) * frac) >> 15));
+        out[2 * i + 1] = (int16_t)(a[1] + (((b[1] - a[1]) * frac) >> 15));
+    }
+    return outFrames;
+}
@@ -0,0 +1,70 @@
+/*
+ * resampler.h
+ *
+ * Stereo int16 to 48 kHz for AudioDSP::resample48k().
+ *
+ * 8, 16, 22.05, 24, 32 and 44.1 kHz go through a polyphase FIR, up by L
+ * and down by M, with Q15 tables from resampler_tables.h in three quality
+ * tiers:
+ *
+ *   RESAMPLE_LOW     8 taps per phase, ~45 dB
+ *   RESAMPLE_MEDIUM 24 taps, ~72 dB (default)
+ *   RESAMPLE_HIGH   48 taps, ~83 dB
+ *
+ * The delay line carries over between chunks, so chunk boundaries are
+ * seamless. 48 kHz passes through untouched: process() hands back the
+ * input buffer. Any other rate falls back to linear interpolation.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RESAMPLE_TAPS_MAX  48
+#define RESAMPLE_BLOCK     256     // input frames per pass through the delay line
+
+enum : uint8_t { RESAMPLE_LOW = 0, RESAMPLE_MEDIUM = 1, RESAMPLE_HIGH = 2 };
+
+struct ResampleTable {
+    uint16_t       up;
+    uint8_t        quality;
+    uint8_t        taps;
+    const int16_t* coef;     // [up][taps], Q15, each phase oldest input first
+};
+
+class Resampler {
+public:
+    Resampler();
+
+    void     setQuality(uint8_t quality);
+    uint8_t  getQuality() const { return m_quality; }
+    void     setSampleRate(uint32_t sampleRate);
+    // Clear the delay line
+    void     reset();
+
+    // `frames` stereo frames from `in`. Returns the buffer holding the 48 kHz
+    // result, `outFrames` frames: `in` itself at 48 kHz, otherwise `out`.
+    int16_t* process(int16_t* in, size_t frames, int16_t* out, size_t* outFrames);
+
+    bool     passThrough() const { return m_sampleRate == 48000; }
+    bool     polyphase() const { return m_table != nullptr; }
+    // Output lags input by this many input frames (FIR group delay)
+    float    delay() const;
+
+private:
+    const ResampleTable* m_table;  // nullptr: pass-through or linear
+    uint8_t   m_quality;
+    uint32_t  m_sampleRate;
+    uint16_t  m_up;
+    uint16_t  m_down;
+    uint16_t  m_phase;             // 0 ... m_up - 1
+    size_t    m_next;              // Delay line frame the next output ends on
+    int16_t   m_line[2][RESAMPLE_TAPS_MAX - 1 + RESAMPLE_BLOCK];   // Per channel, so the taps run over contiguous samples
+
+    uint32_t  m_step;              // Linear: input frames per output frame, Q16
+    uint32_t  m_rem;               // Linear: output frames owed to the next chunk, x m_sampleRate
+
+    void      select();
+    template <uint8_t TAPS> size_t fir(const int16_t* in, size_t frames, int16_t* out);
+    size_t    linear(const int16_t* in, size_t frames, int16_t* out);
+};
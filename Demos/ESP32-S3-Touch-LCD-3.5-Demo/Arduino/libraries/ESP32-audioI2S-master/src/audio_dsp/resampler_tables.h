@@ -0,0 +1,1068 @@
+/*
+ * resampler_tables.h
+ *
+ * Generated by host/tools/resampler_tables.py, do not edit.
+ *
+ * Polyphase FIR tables, Q15, [phase][tap], each phase reversed (oldest
+ * input first) and summing to 32768.
+ */
+#pragma once
+
+#include <stdint.h>
+
+// up 2, 8 taps, 40 dB from 0.60 fs_in, flat to 0.321 fs_in
+static const int16_t RS_UP2_LOW[16] = {
+    19, 601, -3248, 27425, 10839, -4049, 1588, -407,
+    -407, 1588, -4049, 10839, 27425, -3248, 601, 19,
+};
+
+// up 2, 24 taps, 70 dB from 0.55 fs_in, flat to 0.370 fs_in
+static const int16_t RS_UP2_MEDIUM[48] = {
+    14, -46, 109, -208, 333, -458, 527, -450, 80, 900, -3655, 27549, 11357, -5231, 3176, -1984, 1186, -648, 308, -116, 24, 7, -10, 4,
+    4, -10, 7, 24, -116, 308, -648, 1186, -1984, 3176, -5231, 11357, 27549, -3655, 900, 80, -450, 527, -458, 333, -208, 109, -46, 14,
+};
+
+// up 2, 48 taps, 90 dB from 0.52 fs_in, flat to 0.401 fs_in
+static const int16_t RS_UP2_HIGH[96] = {
+    -1, 2, -5, 9, -13, 16, -16, 7, 14, -52, 112, -198, 308, -438, 579, -713, 817, -860, 799, -571, 64, 1003, -3772, 27602, 11436, -5470, 3565, -2475, 1710, -1130, 686, -355, 120, 33, -120, 157, -159, 141, -112, 81, -53, 32, -17, 7, -2, 0, 0, 0,
+    0, 0, 0, -2, 7, -17, 32, -53, 81, -112, 141, -159, 157, -120, 33, 120, -355, 686, -1130, 1710, -2475, 3565, -5470, 11436, 27602, -3772, 1003, 64, -571, 799, -860, 817, -713, 579, -438, 308, -198, 112, -52, 14, 7, -16, 16, -13, 9, -5, 2, -1,
+};
+
+// up 3, 8 taps, 40 dB from 0.60 fs_in, flat to 0.321 fs_in
+static const int16_t RS_UP3_LOW[24] = {
+    271, -42, -1810, 28880, 7787, -3352, 1434, -400,
+    -440, 1754, -5192, 20262, 20262, -5192, 1754, -440,
+    -400, 1434, -3352, 7787, 28880, -1810, -42, 271,
+};
+
+// up 3, 24 taps, 70 dB from 0.55 fs_in, flat to 0.370 fs_in
+static const int16_t RS_UP3_MEDIUM[72] = {
+    14, -49, 118, -234, 395, -584, 758, -841, 707, -92, -1979, 28973, 8247, -4396, 2901, -1939, 1238, -730, 385, -172, 59, -10, -3, 2,
+    11, -35, 69, -102, 107, -37, -174, 618, -1437, 2932, -6147, 20579, 20579, -6147, 2932, -1437, 618, -174, -37, 107, -102, 69, -35, 11,
+    2, -3, -10, 59, -172, 385, -730, 1238, -1939, 2901, -4396, 8247, 28973, -1979, -92, 707, -841, 758, -584, 395, -234, 118, -49, 14,
+};
+
+// up 3, 48 taps, 90 dB from 0.52 fs_in, flat to 0.401 fs_in
+static const int16_t RS_UP3_HIGH[144] = {
+    -1, 3, -6, 11, -17, 23, -27, 24, -10, -21, 76, -159, 273, -417, 586, -765, 937, -1073, 1137, -1075, 794, -67, -2051, 29016, 8309, -4605, 3265, -2427, 1790, -1274, 853, -520, 267, -88, -28, 92, -117, 116, -100, 77, -54, 34, -20, 10, -4, 1, 0, 0,
+    -1, 2, -3, 3, -2, -3, 15, -36, 69, -114, 173, -239, 307, -362, 387, -362, 260, -50, -308, 872, -1756, 3239, -6369, 20662, 20662, -6369, 3239, -1756, 872, -308, -50, 260, -362, 387, -362, 307, -239, 173, -114, 69, -36, 15, -3, -2, 3, -3, 2, -1,
+    0, 0, 1, -4, 10, -20, 34, -54, 77, -100, 116, -117, 92, -28, -88, 267, -520, 853, -1274, 1790, -2427, 3265, -4605, 8309, 29016, -2051, -67, 794, -1075, 1137, -1073, 937, -765, 586, -417, 273, -159, 76, -21, -10, 24, -27, 23, -17, 11, -6, 3, -1,
+};
+
+// up 6, 8 taps, 40 dB from 0.60 fs_in, flat to 0.321 fs_in
+static const int16_t RS_UP6_LOW[48] = {
+    585, -821, 60, 29730, 4921, -2549, 1212, -370,
+    21, 632, -3295, 27464, 10900, -4168, 1725, -511,
+    -366, 1568, -4992, 23082, 17260, -5156, 1906, -534,
+    -534, 1906, -5156, 17260, 23082, -4992, 1568, -366,
+    -511, 1725, -4168, 10900, 27464, -3295, 632, 21,
+    -370, 1212, -2549, 4921, 29730, 60, -821, 585,
+};
+
+// up 6, 24 taps, 70 dB from 0.55 fs_in, flat to 0.370 fs_in
+static const int16_t RS_UP6_MEDIUM[144] = {
+    13, -47, 120, -248, 439, -687, 964, -1214, 1344, -1178, 100, 29848, 5279, -3397, 2482, -1787, 1217, -766, 436, -217, 89, -27, 4, 1,
+    16, -52, 119, -220, 347, -471, 537, -456, 81, 903, -3659, 27549, 11361, -5241, 3192, -2003, 1204, -664, 319, -122, 26, 8, -11, 5,
+    15, -44, 92, -149, 195, -184, 52, 299, -1022, 2446, -5741, 23278, 17628, -6175, 3223, -1752, 887, -377, 100, 25, -60, 51, -29, 10,
+    10, -29, 51, -60, 25, 100, -377, 887, -1752, 3223, -6175, 17628, 23278, -5741, 2446, -1022, 299, 52, -184, 195, -149, 92, -44, 15,
+    5, -11, 8, 26, -122, 319, -664, 1204, -2003, 3192, -5241, 11361, 27549, -3659, 903, 81, -456, 537, -471, 347, -220, 119, -52, 16,
+    1, 4, -27, 89, -217, 436, -766, 1217, -1787, 2482, -3397, 5279, 29848, 100, -1178, 1344, -1214, 964, -687, 439, -248, 120, -47, 13,
+};
+
+// up 6, 48 taps, 90 dB from 0.52 fs_in, flat to 0.401 fs_in
+static const int16_t RS_UP6_HIGH[288] = {
+    -1, 3, -6, 12, -20, 29, -37, 41, -36, 14, 31, -107, 219, -370, 557, -774, 1006, -1232, 1424, -1542, 1522, -1225, 69, 29885, 5316, -3562, 2800, -2243, 1765, -1339, 965, -649, 394, -200, 64, 23, -69, 85, -82, 69, -52, 35, -21, 11, -5, 2, -1, 0,
+    -1, 3, -6, 10, -14, 17, -16, 7, 14, -53, 115, -201, 313, -444, 584, -718, 822, -863, 801, -572, 64, 1004, -3773, 27602, 11437, -5472, 3568, -2479, 1714, -1134, 690, -357, 121, 33, -122, 160, -163, 144, -115, 84, -56, 33, -18, 8, -3, 0, 0, 0,
+    -1, 2, -4, 6, -6, 3, 6, -24, 55, -102, 165, -243, 329, -414, 481, -509, 471, -335, 56, 430, -1244, 2691, -5931, 23352, 17714, -6411, 3569, -2141, 1246, -639, 225, 45, -204, 280, -295, 272, -227, 174, -123, 79, -46, 23, -9, 2, 1, -2, 1, 0,
+    0, 1, -2, 1, 2, -9, 23, -46, 79, -123, 174, -227, 272, -295, 280, -204, 45, 225, -639, 1246, -2141, 3569, -6411, 17714, 23352, -5931, 2691, -1244, 430, 56, -335, 471, -509, 481, -414, 329, -243, 165, -102, 55, -24, 6, 3, -6, 6, -4, 2, -1,
+    0, 0, 0, -3, 8, -18, 33, -56, 84, -115, 144, -163, 160, -122, 33, 121, -357, 690, -1134, 1714, -2479, 3568, -5472, 11437, 27602, -3773, 1004, 64, -572, 801, -863, 822, -718, 584, -444, 313, -201, 115, -53, 14, 7, -16, 17, -14, 10, -6, 3, -1,
+    0, -1, 2, -5, 11, -21, 35, -52, 69, -82, 85, -69, 23, 64, -200, 394, -649, 965, -1339, 1765, -2243, 2800, -3562, 5316, 29885, 69, -1225, 1522, -1542, 1424, -1232, 1006, -774, 557, -370, 219, -107, 31, 14, -36, 41, -37, 29, -20, 12, -6, 3, -1,
+};
+
+// up 320, 8 taps, 40 dB from 0.60 fs_in, flat to 0.321 fs_in
+static const int16_t RS_UP320_LOW[2560] = {
+    934, -1679, 2278, 29953, 2370, -1712, 946, -322,
+    921, -1646, 2188, 29956, 2462, -1746, 958, -325,
+    909, -1614, 2097, 29958, 2555, -1779, 971, -329,
+    897, -1581, 2007, 29958, 2648, -1812, 983, -332,
+    885, -1548, 1918, 29958, 2742, -1846, 995, -336,
+    872, -1515, 1829, 29957, 2836, -1879, 1008, -340,
+    860, -1483, 1741, 29955, 2931, -1913, 1020, -343,
+    848, -1450, 1653, 29952, 3026, -1946, 1032, -347,
+    836, -1418, 1565, 29949, 3122, -1980, 1045, -351,
+    823, -1385, 1478, 29944, 3218, -2013, 1057, -354,
+    811, -1352, 1391, 29939, 3314, -2046, 1069, -358,
+    799, -1320, 1305, 29933, 3411, -2080, 1081, -361,
+    787, -1288, 1220, 29925, 3509, -2114, 1094, -365,
+    775, -1255, 1134, 29917, 3607, -2147, 1106, -369,
+    762, -1223, 1050, 29909, 3705, -2181, 1118, -372,
+    750, -1191, 966, 29899, 3804, -2214, 1130, -376,
+    738, -1159, 882, 29889, 3903, -2248, 1142, -379,
+    726, -1127, 799, 29877, 4003, -2281, 1154, -383,
+    714, -1095, 716, 29865, 4103, -2315, 1166, -386,
+    701, -1063, 634, 29852, 4204, -2348, 1178, -390,
+    689, -1031, 553, 29837, 4305, -2382, 1190, -393,
+    677, -999, 471, 29823, 4406, -2415, 1202, -397,
+    665, -968, 391, 29807, 4508, -2449, 1214, -400,
+    653, -936, 311, 29790, 4610, -2482, 1226, -404,
+    641, -905, 231, 29773, 4713, -2516, 1238, -407,
+    629, -873, 152, 29754, 4816, -2549, 1250, -411,
+    616, -842, 74, 29735, 4920, -2582, 1261, -414,
+    604, -811, -4, 29715, 5023, -2615, 1273, -417,
+    592, -779, -82, 29694, 5128, -2649, 1285, -421,
+    580, -748, -159, 29672, 5233, -2682, 1296, -424,
+    568, -718, -235, 29650, 5338, -2715, 1308, -428,
+    556, -687, -311, 29626, 5443, -2748, 1320, -431,
+    544, -656, -387, 29602, 5549, -2781, 1331, -434,
+    532, -625, -461, 29577, 5655, -2814, 1342, -438,
+    521, -595, -536, 29550, 5762, -2847, 1354, -441,
+    509, -565, -609, 29523, 5869, -2880, 1365, -444,
+    497, -534, -682, 29496, 5976, -2913, 1376, -448,
+    485, -504, -755, 29467, 6084, -2945, 1387, -451,
+    473, -474, -827, 29437, 6192, -2978, 1399, -454,
+    462, -444, -899, 29407, 6300, -3011, 1410, -457,
+    450, -414, -970, 29376, 6409, -3043, 1420, -460,
+    438, -385, -1040, 29344, 6518, -3075, 1432, -464,
+    426, -355, -1110, 29311, 6628, -3108, 1443, -467,
+    415, -325, -1179, 29277, 6737, -3140, 1453, -470,
+    403, -296, -1248, 29243, 6847, -3172, 1464, -473,
+    391, -267, -1316, 29207, 6958, -3204, 1475, -476,
+    380, -238, -1384, 29171, 7069, -3236, 1485, -479,
+    369, -209, -1451, 29134, 7179, -3268, 1496, -482,
+    357, -180, -1517, 29096, 7291, -3300, 1506, -485,
+    346, -152, -1583, 29057, 7402, -3331, 1517, -488,
+    335, -123, -1649, 29017, 7515, -3363, 1527, -491,
+    323, -95, -1713, 28977, 7627, -3394, 1537, -494,
+    312, -67, -1778, 28936, 7739, -3425, 1547, -496,
+    301, -39, -1841, 28893, 7852, -3456, 1557, -499,
+    290, -11, -1905, 28850, 7965, -3487, 1568, -502,
+    278, 17, -1967, 28807, 8079, -3518, 1577, -505,
+    267, 45, -2029, 28762, 8193, -3549, 1587, -508,
+    256, 72, -2091, 28717, 8306, -3579, 1597, -510,
+    245, 99, -2151, 28670, 8421, -3610, 1607, -513,
+    234, 127, -2211, 28623, 8535, -3640, 1616, -516,
+    224, 153, -2271, 28575, 8650, -3670, 1625, -518,
+    213, 180, -2330, 28527, 8764, -3700, 1635, -521,
+    202, 207, -2389, 28477, 8880, -3730, 1644, -523,
+    191, 234, -2446, 28427, 8995, -3760, 1653, -526,
+    180, 260, -2504, 28376, 9111, -3789, 1662, -528,
+    170, 286, -2561, 28324, 9227, -3818, 1671, -531,
+    159, 312, -2617, 28271, 9343, -3847, 1680, -533,
+    149, 338, -2672, 28218, 9459, -3877, 1689, -536,
+    138, 363, -2727, 28163, 9576, -3905, 1698, -538,
+    128, 389, -2781, 28108, 9692, -3934, 1706, -540,
+    118, 414, -2835, 28052, 9809, -3962, 1715, -543,
+    107, 439, -2888, 27996, 9926, -3990, 1723, -545,
+    97, 464, -2941, 27938, 10044, -4018, 1731, -547,
+    87, 489, -2993, 27880, 10161, -4046, 1739, -549,
+    77, 514, -3045, 27821, 10279, -4074, 1747, -551,
+    67, 538, -3096, 27761, 10397, -4101, 1755, -553,
+    57, 562, -3146, 27700, 10515, -4128, 1763, -555,
+    47, 586, -3195, 27639, 10633, -4155, 1770, -557,
+    37, 610, -3244, 27577, 10751, -4182, 1778, -559,
+    27, 634, -3293, 27514, 10870, -4209, 1786, -561,
+    18, 658, -3341, 27450, 10988, -4235, 1793, -563,
+    8, 681, -3388, 27386, 11107, -4261, 1800, -565,
+    -2, 704, -3435, 27321, 11226, -4287, 1807, -566,
+    -11, 727, -3481, 27255, 11345, -4313, 1814, -568,
+    -21, 750, -3526, 27189, 11463, -4338, 1820, -569,
+    -30, 772, -3571, 27121, 11583, -4363, 1827, -571,
+    -39, 795, -3616, 27053, 11702, -4388, 1834, -573,
+    -48, 817, -3659, 26984, 11821, -4413, 1840, -574,
+    -58, 839, -3703, 26915, 11941, -4437, 1846, -575,
+    -67, 861, -3745, 26845, 12060, -4461, 1852, -577,
+    -76, 882, -3787, 26774, 12180, -4485, 1858, -578,
+    -85, 903, -3828, 26702, 12300, -4509, 1864, -579,
+    -94, 925, -3869, 26629, 12420, -4532, 1870, -581,
+    -103, 946, -3909, 26556, 12539, -4555, 1876, -582,
+    -111, 967, -3949, 26482, 12659, -4578, 1881, -583,
+    -120, 987, -3988, 26408, 12779, -4600, 1886, -584,
+    -129, 1007, -4026, 26333, 12899, -4622, 1891, -585,
+    -137, 1028, -4064, 26257, 13019, -4645, 1896, -586,
+    -146, 1048, -4101, 26180, 13139, -4666, 1901, -587,
+    -154, 1067, -4138, 26103, 13260, -4688, 1906, -588,
+    -162, 1087, -4174, 26024, 13380, -4709, 1910, -588,
+    -171, 1106, -4210, 25946, 13500, -4729, 1915, -589,
+    -179, 1125, -4244, 25867, 13620, -4750, 1919, -590,
+    -187, 1144, -4279, 25787, 13740, -4770, 1923, -590,
+    -195, 1163, -4312, 25706, 13860, -4790, 1927, -591,
+    -203, 1181, -4345, 25624, 13980, -4809, 1931, -591,
+    -211, 1200, -4378, 25542, 14101, -4828, 1934, -592,
+    -219, 1218, -4410, 25460, 14221, -4847, 1937, -592,
+    -226, 1236, -4441, 25376, 14341, -4866, 1941, -593,
+    -234, 1253, -4472, 25292, 14461, -4884, 1944, -592,
+    -242, 1271, -4502, 25208, 14581, -4902, 1947, -593,
+    -249, 1288, -4532, 25123, 14701, -4920, 1950, -593,
+    -256, 1305, -4561, 25037, 14821, -4937, 1952, -593,
+    -264, 1322, -4589, 24950, 14940, -4953, 1955, -593,
+    -271, 1339, -4617, 24863, 15060, -4970, 1957, -593,
+    -278, 1355, -4644, 24775, 15180, -4986, 1959, -593,
+    -285, 1371, -4671, 24687, 15299, -5002, 1961, -592,
+    -292, 1387, -4697, 24598, 15419, -5018, 1963, -592,
+    -299, 1403, -4723, 24509, 15538, -5032, 1964, -592,
+    -306, 1418, -4748, 24418, 15658, -5047, 1966, -591,
+    -312, 1433, -4772, 24328, 15777, -5062, 1967, -591,
+    -319, 1449, -4796, 24236, 15896, -5076, 1968, -590,
+    -326, 1463, -4819, 24145, 16015, -5089, 1969, -590,
+    -332, 1478, -4842, 24052, 16134, -5103, 1970, -589,
+    -339, 1492, -4864, 23959, 16253, -5115, 1970, -588,
+    -345, 1507, -4886, 23865, 16371, -5128, 1971, -587,
+    -351, 1521, -4907, 23771, 16490, -5140, 1971, -587,
+    -358, 1534, -4927, 23677, 16608, -5151, 1971, -586,
+    -364, 1548, -4947, 23582, 16726, -5163, 1971, -585,
+    -370, 1561, -4966, 23486, 16844, -5174, 1970, -583,
+    -376, 1575, -4985, 23389, 16962, -5184, 1969, -582,
+    -382, 1587, -5003, 23292, 17080, -5194, 1969, -581,
+    -387, 1600, -5021, 23195, 17197, -5204, 1968, -580,
+    -393, 1612, -5038, 23097, 17315, -5213, 1966, -578,
+    -399, 1625, -5055, 22999, 17432, -5222, 1965, -577,
+    -404, 1637, -5071, 22900, 17548, -5230, 1963, -575,
+    -410, 1649, -5086, 22800, 17665, -5238, 1962, -574,
+    -415, 1660, -5101, 22700, 17782, -5246, 1960, -572,
+    -420, 1671, -5116, 22600, 17898, -5253, 1958, -570,
+    -425, 1683, -5129, 22499, 18014, -5260, 1955, -569,
+    -431, 1694, -5143, 22398, 18130, -5266, 1953, -567,
+    -435, 1704, -5155, 22296, 18245, -5272, 1950, -565,
+    -440, 1715, -5168, 22193, 18361, -5277, 1947, -563,
+    -445, 1725, -5180, 22090, 18476, -5282, 1944, -560,
+    -450, 1735, -5191, 21987, 18591, -5287, 1941, -558,
+    -455, 1745, -5201, 21884, 18705, -5291, 1937, -556,
+    -459, 1755, -5211, 21779, 18819, -5295, 1934, -554,
+    -464, 1764, -5221, 21675, 18933, -5298, 1930, -551,
+    -469, 1773, -5230, 21570, 19047, -5300, 1926, -549,
+    -473, 1782, -5239, 21464, 19161, -5302, 1921, -546,
+    -477, 1791, -5247, 21358, 19273, -5304, 1917, -543,
+    -481, 1799, -5254, 21252, 19386, -5306, 1912, -540,
+    -485, 1808, -5261, 21145, 19499, -5307, 1907, -538,
+    -489, 1816, -5268, 21038, 19611, -5307, 1902, -535,
+    -493, 1824, -5274, 20931, 19723, -5307, 1896, -532,
+    -497, 1831, -5279, 20823, 19834, -5306, 1891, -529,
+    -501, 1839, -5284, 20714, 19946, -5305, 1885, -526,
+    -505, 1846, -5289, 20606, 20057, -5304, 1879, -522,
+    -508, 1853, -5293, 20497, 20167, -5302, 1873, -519,
+    -512, 1860, -5296, 20387, 20277, -5299, 1867, -516,
+    -516, 1867, -5299, 20277, 20387, -5296, 1860, -512,
+    -519, 1873, -5302, 20167, 20497, -5293, 1853, -508,
+    -522, 1879, -5304, 20057, 20606, -5289, 1846, -505,
+    -526, 1885, -5305, 19946, 20714, -5284, 1839, -501,
+    -529, 1891, -5306, 19834, 20823, -5279, 1831, -497,
+    -532, 1896, -5307, 19723, 20931, -5274, 1824, -493,
+    -535, 1902, -5307, 19611, 21038, -5268, 1816, -489,
+    -538, 1907, -5307, 19499, 21145, -5261, 1808, -485,
+    -540, 1912, -5306, 19386, 21252, -5254, 1799, -481,
+    -543, 1917, -5304, 19273, 21358, -5247, 1791, -477,
+    -546, 1921, -5302, 19161, 21464, -5239, 1782, -473,
+    -549, 1926, -5300, 19047, 21570, -5230, 1773, -469,
+    -551, 1930, -5298, 18933, 21675, -5221, 1764, -464,
+    -554, 1934, -5295, 18819, 21779, -5211, 1755, -459,
+    -556, 1937, -5291, 18705, 21884, -5201, 1745, -455,
+    -558, 1941, -5287, 18591, 21987, -5191, 1735, -450,
+    -560, 1944, -5282, 18476, 22090, -5180, 1725, -445,
+    -563, 1947, -5277, 18361, 22193, -5168, 1715, -440,
+    -565, 1950, -5272, 18245, 22296, -5155, 1704, -435,
+    -567, 1953, -5266, 18130, 22398, -5143, 1694, -431,
+    -569, 1955, -5260, 18014, 22499, -5129, 1683, -425,
+    -570, 1958, -5253, 17898, 22600, -5116, 1671, -420,
+    -572, 1960, -5246, 17782, 22700, -5101, 1660, -415,
+    -574, 1962, -5238, 17665, 22800, -5086, 1649, -410,
+    -575, 1963, -5230, 17548, 22900, -5071, 1637, -404,
+    -577, 1965, -5222, 17432, 22999, -5055, 1625, -399,
+    -578, 1966, -5213, 17315, 23097, -5038, 1612, -393,
+    -580, 1968, -5204, 17197, 23195, -5021, 1600, -387,
+    -581, 1969, -5194, 17080, 23292, -5003, 1587, -382,
+    -582, 1969, -5184, 16962, 23389, -4985, 1575, -376,
+    -583, 1970, -5174, 16844, 23486, -4966, 1561, -370,
+    -585, 1971, -5163, 16726, 23582, -4947, 1548, -364,
+    -586, 1971, -5151, 16608, 23677, -4927, 1534, -358,
+    -587, 1971, -5140, 16490, 23771, -4907, 1521, -351,
+    -587, 1971, -5128, 16371, 23865, -4886, 1507, -345,
+    -588, 1970, -5115, 16253, 23959, -4864, 1492, -339,
+    -589, 1970, -5103, 16134, 24052, -4842, 1478, -332,
+    -590, 1969, -5089, 16015, 24145, -4819, 1463, -326,
+    -590, 1968, -5076, 15896, 24236, -4796, 1449, -319,
+    -591, 1967, -5062, 15777, 24328, -4772, 1433, -312,
+    -591, 1966, -5047, 15658, 24418, -4748, 1418, -306,
+    -592, 1964, -5032, 15538, 24509, -4723, 1403, -299,
+    -592, 1963, -5018, 15419, 24598, -4697, 1387, -292,
+    -592, 1961, -5002, 15299, 24687, -4671, 1371, -285,
+    -593, 1959, -4986, 15180, 24775, -4644, 1355, -278,
+    -593, 1957, -4970, 15060, 24863, -4617, 1339, -271,
+    -593, 1955, -4953, 14940, 24950, -4589, 1322, -264,
+    -593, 1952, -4937, 14821, 25037, -4561, 1305, -256,
+    -593, 1950, -4920, 14701, 25123, -4532, 1288, -249,
+    -593, 1947, -4902, 14581, 25208, -4502, 1271, -242,
+    -592, 1944, -4884, 14461, 25292, -4472, 1253, -234,
+    -593, 1941, -4866, 14341, 25376, -4441, 1236, -226,
+    -592, 1937, -4847, 14221, 25460, -4410, 1218, -219,
+    -592, 1934, -4828, 14101, 25542, -4378, 1200, -211,
+    -591, 1931, -4809, 13980, 25624, -4345, 1181, -203,
+    -591, 1927, -4790, 13860, 25706, -4312, 1163, -195,
+    -590, 1923, -4770, 13740, 25787, -4279, 1144, -187,
+    -590, 1919, -4750, 13620, 25867, -4244, 1125, -179,
+    -589, 1915, -4729, 13500, 25946, -4210, 1106, -171,
+    -588, 1910, -4709, 13380, 26024, -4174, 1087, -162,
+    -588, 1906, -4688, 13260, 26103, -4138, 1067, -154,
+    -587, 1901, -4666, 13139, 26180, -4101, 1048, -146,
+    -586, 1896, -4645, 13019, 26257, -4064, 1028, -137,
+    -585, 1891, -4622, 12899, 26333, -4026, 1007, -129,
+    -584, 1886, -4600, 12779, 26408, -3988, 987, -120,
+    -583, 1881, -4578, 12659, 26482, -3949, 967, -111,
+    -582, 1876, -4555, 12539, 26556, -3909, 946, -103,
+    -581, 1870, -4532, 12420, 26629, -3869, 925, -94,
+    -579, 1864, -4509, 12300, 26702, -3828, 903, -85,
+    -578, 1858, -4485, 12180, 26774, -3787, 882, -76,
+    -577, 1852, -4461, 12060, 26845, -3745, 861, -67,
+    -575, 1846, -4437, 11941, 26915, -3703, 839, -58,
+    -574, 1840, -4413, 11821, 26984, -3659, 817, -48,
+    -573, 1834, -4388, 11702, 27053, -3616, 795, -39,
+    -571, 1827, -4363, 11583, 27121, -3571, 772, -30,
+    -569, 1820, -4338, 11463, 27189, -3526, 750, -21,
+    -568, 1814, -4313, 11345, 27255, -3481, 727, -11,
+    -566, 1807, -4287, 11226, 27321, -3435, 704, -2,
+    -565, 1800, -4261, 11107, 27386, -3388, 681, 8,
+    -563, 1793, -4235, 10988, 27450, -3341, 658, 18,
+    -561, 1786, -4209, 10870, 27514, -3293, 634, 27,
+    -559, 1778, -4182, 10751, 27577, -3244, 610, 37,
+    -557, 1770, -4155, 10633, 27639, -3195, 586, 47,
+    -555, 1763, -4128, 10515, 27700, -3146, 562, 57,
+    -553, 1755, -4101, 10397, 27761, -3096, 538, 67,
+    -551, 1747, -4074, 10279, 27821, -3045, 514, 77,
+    -549, 1739, -4046, 10161, 27880, -2993, 489, 87,
+    -547, 1731, -4018, 10044, 27938, -2941, 464, 97,
+    -545, 1723, -3990, 9926, 27996, -2888, 439, 107,
+    -543, 1715, -3962, 9809, 28052, -2835, 414, 118,
+    -540, 1706, -3934, 9692, 28108, -2781, 389, 128,
+    -538, 1698, -3905, 9576, 28163, -2727, 363, 138,
+    -536, 1689, -3877, 9459, 28218, -2672, 338, 149,
+    -533, 1680, -3847, 9343, 28271, -2617, 312, 159,
+    -531, 1671, -3818, 9227, 28324, -2561, 286, 170,
+    -528, 1662, -3789, 9111, 28376, -2504, 260, 180,
+    -526, 1653, -3760, 8995, 28427, -2446, 234, 191,
+    -523, 1644, -3730, 8880, 28477, -2389, 207, 202,
+    -521, 1635, -3700, 8764, 28527, -2330, 180, 213,
+    -518, 1625, -3670, 8650, 28575, -2271, 153, 224,
+    -516, 1616, -3640, 8535, 28623, -2211, 127, 234,
+    -513, 1607, -3610, 8421, 28670, -2151, 99, 245,
+    -510, 1597, -3579, 8306, 28717, -2091, 72, 256,
+    -508, 1587, -3549, 8193, 28762, -2029, 45, 267,
+    -505, 1577, -3518, 8079, 28807, -1967, 17, 278,
+    -502, 1568, -3487, 7965, 28850, -1905, -11, 290,
+    -499, 1557, -3456, 7852, 28893, -1841, -39, 301,
+    -496, 1547, -3425, 7739, 28936, -1778, -67, 312,
+    -494, 1537, -3394, 7627, 28977, -1713, -95, 323,
+    -491, 1527, -3363, 7515, 29017, -1649, -123, 335,
+    -488, 1517, -3331, 7402, 29057, -1583, -152, 346,
+    -485, 1506, -3300, 7291, 29096, -1517, -180, 357,
+    -482, 1496, -3268, 7179, 29134, -1451, -209, 369,
+    -479, 1485, -3236, 7069, 29171, -1384, -238, 380,
+    -476, 1475, -3204, 6958, 29207, -1316, -267, 391,
+    -473, 1464, -3172, 6847, 29243, -1248, -296, 403,
+    -470, 1453, -3140, 6737, 29277, -1179, -325, 415,
+    -467, 1443, -3108, 6628, 29311, -1110, -355, 426,
+    -464, 1432, -3075, 6518, 29344, -1040, -385, 438,
+    -460, 1420, -3043, 6409, 29376, -970, -414, 450,
+    -457, 1410, -3011, 6300, 29407, -899, -444, 462,
+    -454, 1399, -2978, 6192, 29437, -827, -474, 473,
+    -451, 1387, -2945, 6084, 29467, -755, -504, 485,
+    -448, 1376, -2913, 5976, 29496, -682, -534, 497,
+    -444, 1365, -2880, 5869, 29523, -609, -565, 509,
+    -441, 1354, -2847, 5762, 29550, -536, -595, 521,
+    -438, 1342, -2814, 5655, 29577, -461, -625, 532,
+    -434, 1331, -2781, 5549, 29602, -387, -656, 544,
+    -431, 1320, -2748, 5443, 29626, -311, -687, 556,
+    -428, 1308, -2715, 5338, 29650, -235, -718, 568,
+    -424, 1296, -2682, 5233, 29672, -159, -748, 580,
+    -421, 1285, -2649, 5128, 29694, -82, -779, 592,
+    -417, 1273, -2615, 5023, 29715, -4, -811, 604,
+    -414, 1261, -2582, 4920, 29735, 74, -842, 616,
+    -411, 1250, -2549, 4816, 29754, 152, -873, 629,
+    -407, 1238, -2516, 4713, 29773, 231, -905, 641,
+    -404, 1226, -2482, 4610, 29790, 311, -936, 653,
+    -400, 1214, -2449, 4508, 29807, 391, -968, 665,
+    -397, 1202, -2415, 4406, 29823, 471, -999, 677,
+    -393, 1190, -2382, 4305, 29837, 553, -1031, 689,
+    -390, 1178, -2348, 4204, 29852, 634, -1063, 701,
+    -386, 1166, -2315, 4103, 29865, 716, -1095, 714,
+    -383, 1154, -2281, 4003, 29877, 799, -1127, 726,
+    -379, 1142, -2248, 3903, 29889, 882, -1159, 738,
+    -376, 1130, -2214, 3804, 29899, 966, -1191, 750,
+    -372, 1118, -2181, 3705, 29909, 1050, -1223, 762,
+    -369, 1106, -2147, 3607, 29917, 1134, -1255, 775,
+    -365, 1094, -2114, 3509, 29925, 1220, -1288, 787,
+    -361, 1081, -2080, 3411, 29933, 1305, -1320, 799,
+    -358, 1069, -2046, 3314, 29939, 1391, -1352, 811,
+    -354, 1057, -2013, 3218, 29944, 1478, -1385, 823,
+    -351, 1045, -1980, 3122, 29949, 1565, -1418, 836,
+    -347, 1032, -1946, 3026, 29952, 1653, -1450, 848,
+    -343, 1020, -1913, 2931, 29955, 1741, -1483, 860,
+    -340, 1008, -1879, 2836, 29957, 1829, -1515, 872,
+    -336, 995, -1846, 2742, 29958, 1918, -1548, 885,
+    -332, 983, -1812, 2648, 29958, 2007, -1581, 897,
+    -329, 971, -1779, 2555, 29958, 2097, -1614, 909,
+    -325, 958, -1746, 2462, 29956, 2188, -1646, 921,
+    -322, 946, -1712, 2370, 29953, 2278, -1679, 934,
+};
+
+// up 320, 24 taps, 70 dB from 0.55 fs_in, flat to 0.370 fs_in
+static const int16_t RS_UP320_MEDIUM[7680] = {
+    10, -41, 113, -247, 459, -756, 1126, -1538, 1943, -2283, 2491, 30144, 2588, -2325, 1965, -1549, 1131, -757, 459, -246, 113, -41, 10, -1,
+    10, -41, 114, -247, 459, -754, 1121, -1527, 1921, -2241, 2394, 30143, 2686, -2367, 1986, -1560, 1135, -759, 459, -245, 112, -40, 10, -1,
+    10, -42, 114, -248, 459, -753, 1116, -1516, 1900, -2198, 2297, 30141, 2785, -2409, 2008, -1570, 1140, -760, 459, -245, 111, -40, 10, -1,
+    11, -42, 115, -248, 459, -751, 1111, -1504, 1878, -2156, 2201, 30139, 2883, -2451, 2029, -1581, 1145, -762, 458, -244, 110, -40, 9, -1,
+    11, -43, 115, -249, 459, -749, 1106, -1493, 1856, -2114, 2105, 30135, 2983, -2493, 2050, -1591, 1149, -763, 458, -243, 110, -39, 9, -1,
+    11, -43, 116, -249, 459, -747, 1101, -1482, 1833, -2072, 2009, 30131, 3082, -2534, 2071, -1602, 1154, -764, 458, -243, 109, -39, 9, 0,
+    11, -43, 116, -250, 459, -746, 1095, -1470, 1811, -2030, 1915, 30126, 3182, -2576, 2092, -1612, 1158, -765, 458, -242, 108, -38, 9, 0,
+    11, -44, 117, -250, 458, -744, 1090, -1459, 1789, -1987, 1820, 30120, 3283, -2618, 2113, -1622, 1162, -766, 457, -241, 108, -38, 9, 0,
+    11, -44, 117, -251, 458, -742, 1084, -1447, 1767, -1945, 1726, 30114, 3384, -2660, 2134, -1632, 1166, -767, 457, -240, 107, -37, 8, 0,
+    12, -45, 118, -251, 458, -740, 1079, -1435, 1744, -1903, 1632, 30106, 3485, -2701, 2155, -1642, 1170, -768, 457, -240, 106, -37, 8, 0,
+    12, -45, 118, -251, 457, -738, 1073, -1423, 1722, -1861, 1539, 30098, 3587, -2743, 2175, -1652, 1174, -769, 456, -239, 106, -36, 8, 0,
+    12, -45, 119, -252, 457, -735, 1067, -1411, 1699, -1819, 1447, 30088, 3689, -2784, 2195, -1662, 1178, -770, 456, -238, 105, -36, 8, 0,
+    12, -46, 119, -252, 457, -733, 1062, -1399, 1676, -1776, 1354, 30079, 3791, -2825, 2216, -1672, 1182, -771, 455, -237, 104, -35, 7, 0,
+    12, -46, 120, -252, 456, -731, 1056, -1387, 1654, -1734, 1263, 30068, 3894, -2867, 2236, -1681, 1186, -772, 454, -236, 103, -35, 7, 0,
+    12, -46, 120, -253, 456, -729, 1050, -1375, 1631, -1692, 1171, 30056, 3997, -2908, 2256, -1691, 1190, -772, 454, -235, 103, -34, 7, 0,
+    13, -47, 121, -253, 455, -726, 1044, -1363, 1608, -1650, 1081, 30043, 4101, -2949, 2276, -1700, 1193, -773, 453, -234, 102, -34, 7, 0,
+    13, -47, 121, -253, 455, -724, 1038, -1350, 1585, -1607, 990, 30030, 4204, -2990, 2296, -1709, 1197, -773, 452, -233, 101, -34, 6, 0,
+    13, -47, 121, -253, 454, -721, 1032, -1338, 1562, -1565, 900, 30016, 4309, -3031, 2315, -1718, 1200, -774, 452, -232, 100, -33, 6, 0,
+    13, -47, 122, -254, 454, -719, 1026, -1326, 1539, -1523, 811, 30001, 4413, -3072, 2335, -1727, 1203, -774, 451, -231, 99, -32, 6, 0,
+    13, -48, 122, -254, 453, -716, 1019, -1313, 1516, -1481, 722, 29985, 4518, -3112, 2354, -1736, 1207, -775, 450, -230, 99, -32, 6, 1,
+    13, -48, 123, -254, 452, -714, 1013, -1300, 1493, -1439, 634, 29969, 4624, -3153, 2373, -1745, 1210, -775, 449, -229, 98, -31, 5, 0,
+    14, -48, 123, -254, 452, -711, 1007, -1288, 1469, -1397, 546, 29951, 4729, -3194, 2392, -1753, 1213, -775, 448, -228, 97, -31, 5, 1,
+    14, -48, 123, -254, 451, -708, 1000, -1275, 1446, -1355, 458, 29933, 4835, -3234, 2411, -1762, 1216, -775, 447, -227, 96, -30, 5, 1,
+    14, -49, 123, -254, 450, -705, 993, -1262, 1423, -1313, 372, 29914, 4942, -3274, 2430, -1770, 1218, -775, 446, -226, 95, -30, 5, 1,
+    14, -49, 124, -254, 449, -703, 987, -1249, 1399, -1271, 285, 29894, 5048, -3314, 2449, -1778, 1221, -775, 445, -224, 94, -29, 4, 1,
+    14, -49, 124, -254, 448, -700, 980, -1236, 1376, -1229, 199, 29873, 5156, -3354, 2467, -1786, 1224, -775, 444, -223, 93, -29, 4, 1,
+    14, -50, 124, -254, 447, -697, 974, -1223, 1352, -1187, 114, 29852, 5263, -3394, 2486, -1794, 1226, -775, 443, -222, 92, -28, 4, 1,
+    14, -50, 125, -254, 446, -694, 967, -1210, 1329, -1145, 29, 29829, 5371, -3434, 2504, -1802, 1229, -775, 442, -221, 91, -28, 4, 1,
+    14, -50, 125, -254, 446, -691, 960, -1196, 1305, -1103, -55, 29806, 5478, -3474, 2522, -1810, 1231, -775, 441, -220, 90, -27, 4, 1,
+    15, -50, 125, -254, 445, -688, 953, -1183, 1281, -1062, -139, 29782, 5587, -3513, 2540, -1817, 1233, -775, 440, -218, 89, -27, 3, 1,
+    15, -50, 126, -254, 443, -684, 946, -1170, 1258, -1020, -223, 29757, 5695, -3553, 2558, -1825, 1235, -774, 438, -217, 89, -26, 3, 1,
+    15, -51, 126, -254, 442, -681, 939, -1156, 1234, -978, -305, 29732, 5804, -3592, 2575, -1832, 1237, -774, 437, -216, 87, -25, 3, 1,
+    15, -51, 126, -254, 441, -678, 932, -1143, 1210, -937, -388, 29705, 5914, -3631, 2593, -1839, 1239, -773, 436, -214, 87, -25, 2, 1,
+    15, -51, 126, -254, 440, -675, 925, -1129, 1187, -895, -470, 29678, 6023, -3670, 2610, -1846, 1241, -773, 434, -213, 86, -24, 2, 1,
+    15, -51, 126, -254, 439, -671, 918, -1116, 1163, -854, -551, 29650, 6133, -3709, 2627, -1853, 1243, -772, 433, -211, 84, -24, 2, 1,
+    15, -52, 127, -254, 438, -668, 910, -1102, 1139, -813, -632, 29621, 6243, -3747, 2644, -1860, 1245, -771, 431, -210, 83, -23, 2, 2,
+    15, -52, 127, -253, 437, -664, 903, -1088, 1115, -772, -712, 29591, 6353, -3786, 2661, -1867, 1246, -770, 430, -209, 82, -22, 1, 2,
+    16, -52, 127, -253, 435, -661, 896, -1075, 1091, -730, -792, 29561, 6464, -3824, 2677, -1873, 1248, -770, 428, -207, 81, -22, 1, 2,
+    16, -52, 127, -253, 434, -657, 888, -1061, 1067, -689, -871, 29529, 6575, -3862, 2694, -1880, 1249, -769, 427, -206, 80, -21, 1, 2,
+    16, -52, 127, -253, 433, -654, 881, -1047, 1043, -648, -949, 29497, 6686, -3900, 2710, -1886, 1250, -768, 425, -204, 79, -21, 1, 2,
+    16, -52, 127, -252, 431, -650, 873, -1033, 1019, -608, -1027, 29465, 6798, -3938, 2726, -1892, 1252, -767, 423, -203, 78, -20, 0, 2,
+    16, -53, 127, -252, 430, -647, 866, -1019, 995, -567, -1105, 29431, 6910, -3975, 2742, -1898, 1252, -766, 422, -201, 77, -19, 0, 2,
+    16, -53, 127, -252, 428, -643, 858, -1005, 971, -526, -1182, 29396, 7022, -4013, 2758, -1904, 1254, -764, 420, -199, 76, -19, 0, 2,
+    16, -53, 127, -251, 427, -639, 850, -991, 947, -485, -1258, 29361, 7134, -4050, 2773, -1909, 1254, -763, 418, -198, 75, -18, -1, 2,
+    16, -53, 128, -251, 425, -635, 842, -977, 924, -445, -1334, 29325, 7246, -4087, 2788, -1915, 1255, -762, 416, -196, 74, -17, -1, 2,
+    16, -53, 128, -251, 424, -632, 835, -963, 900, -405, -1410, 29288, 7359, -4124, 2804, -1920, 1256, -761, 414, -194, 73, -17, -1, 2,
+    16, -53, 128, -250, 422, -628, 827, -949, 875, -364, -1484, 29251, 7472, -4160, 2818, -1925, 1256, -759, 412, -193, 71, -16, -1, 2,
+    17, -54, 128, -250, 421, -624, 819, -934, 852, -324, -1559, 29212, 7585, -4197, 2833, -1931, 1257, -758, 410, -191, 70, -15, -2, 3,
+    16, -54, 128, -249, 419, -620, 811, -920, 827, -284, -1632, 29173, 7699, -4233, 2848, -1936, 1257, -756, 408, -189, 69, -15, -2, 3,
+    17, -54, 128, -249, 417, -616, 803, -906, 803, -244, -1705, 29133, 7812, -4269, 2862, -1940, 1257, -754, 406, -188, 68, -14, -2, 3,
+    17, -54, 128, -248, 416, -612, 795, -892, 779, -204, -1778, 29092, 7926, -4305, 2876, -1945, 1257, -753, 404, -186, 67, -13, -2, 3,
+    17, -54, 128, -248, 414, -608, 787, -877, 755, -165, -1850, 29051, 8041, -4340, 2890, -1949, 1257, -751, 402, -184, 65, -13, -3, 3,
+    17, -54, 128, -247, 412, -604, 779, -863, 731, -125, -1922, 29008, 8155, -4375, 2904, -1954, 1257, -749, 400, -182, 64, -12, -3, 3,
+    17, -54, 128, -247, 411, -600, 771, -849, 707, -86, -1992, 28965, 8269, -4411, 2918, -1958, 1257, -747, 398, -181, 63, -11, -3, 3,
+    17, -54, 128, -246, 409, -595, 762, -834, 683, -46, -2063, 28921, 8384, -4445, 2931, -1962, 1257, -745, 395, -179, 62, -11, -4, 3,
+    17, -54, 128, -246, 407, -591, 754, -820, 659, -7, -2132, 28877, 8499, -4480, 2944, -1966, 1256, -743, 393, -177, 61, -10, -4, 3,
+    17, -55, 128, -245, 405, -587, 746, -805, 636, 32, -2202, 28831, 8614, -4514, 2957, -1970, 1256, -741, 391, -175, 59, -9, -4, 3,
+    17, -55, 128, -244, 403, -583, 738, -790, 612, 71, -2270, 28785, 8729, -4549, 2970, -1973, 1255, -739, 388, -173, 58, -9, -5, 4,
+    17, -55, 127, -244, 401, -578, 729, -776, 588, 109, -2338, 28738, 8845, -4583, 2983, -1977, 1255, -736, 386, -171, 57, -8, -5, 4,
+    17, -55, 127, -243, 399, -574, 721, -761, 564, 148, -2406, 28690, 8961, -4616, 2995, -1980, 1254, -734, 383, -169, 55, -7, -5, 4,
+    17, -55, 127, -242, 397, -569, 713, -747, 540, 187, -2473, 28642, 9076, -4650, 3007, -1983, 1253, -732, 381, -167, 54, -6, -6, 4,
+    17, -55, 127, -242, 395, -565, 704, -732, 516, 225, -2539, 28593, 9192, -4683, 3019, -1986, 1252, -729, 379, -165, 53, -6, -6, 4,
+    17, -55, 127, -241, 393, -561, 696, -717, 492, 263, -2605, 28543, 9309, -4716, 3031, -1989, 1251, -727, 376, -163, 51, -5, -6, 4,
+    18, -55, 127, -240, 391, -556, 687, -703, 468, 301, -2670, 28492, 9425, -4748, 3042, -1991, 1249, -724, 373, -161, 50, -4, -7, 4,
+    18, -55, 127, -240, 389, -552, 678, -688, 445, 339, -2734, 28441, 9541, -4781, 3053, -1994, 1248, -721, 371, -159, 49, -4, -7, 4,
+    18, -55, 127, -239, 387, -547, 670, -673, 421, 377, -2798, 28388, 9658, -4813, 3064, -1996, 1246, -719, 368, -157, 47, -3, -7, 4,
+    18, -55, 126, -238, 385, -542, 661, -658, 397, 414, -2862, 28335, 9775, -4845, 3075, -1998, 1245, -716, 365, -155, 46, -2, -7, 4,
+    18, -55, 126, -237, 383, -538, 652, -644, 373, 452, -2925, 28282, 9892, -4876, 3086, -2000, 1243, -713, 362, -153, 45, -1, -8, 4,
+    18, -55, 126, -237, 381, -533, 644, -629, 350, 489, -2987, 28227, 10009, -4908, 3096, -2002, 1241, -710, 360, -150, 43, -1, -8, 4,
+    18, -55, 126, -236, 378, -528, 635, -614, 326, 526, -3049, 28172, 10126, -4939, 3106, -2004, 1240, -707, 357, -148, 42, 0, -9, 5,
+    18, -55, 126, -235, 376, -524, 626, -599, 302, 563, -3110, 28116, 10243, -4969, 3116, -2005, 1238, -704, 354, -146, 40, 1, -9, 5,
+    18, -55, 125, -234, 374, -519, 618, -585, 279, 599, -3170, 28060, 10361, -5000, 3126, -2007, 1235, -701, 351, -144, 39, 2, -9, 5,
+    18, -55, 125, -233, 372, -514, 609, -570, 256, 636, -3230, 28002, 10478, -5030, 3136, -2008, 1233, -698, 348, -142, 38, 2, -10, 5,
+    18, -55, 125, -232, 369, -509, 600, -555, 232, 672, -3289, 27944, 10596, -5060, 3145, -2009, 1231, -694, 345, -140, 36, 3, -10, 5,
+    18, -55, 125, -231, 367, -505, 591, -540, 209, 708, -3348, 27885, 10713, -5089, 3154, -2010, 1228, -691, 342, -137, 35, 4, -10, 5,
+    18, -55, 124, -230, 365, -500, 582, -525, 185, 744, -3406, 27826, 10831, -5119, 3163, -2010, 1226, -688, 339, -135, 33, 5, -10, 5,
+    18, -55, 124, -229, 362, -495, 573, -510, 162, 780, -3464, 27766, 10949, -5147, 3171, -2011, 1223, -684, 336, -132, 32, 5, -11, 5,
+    18, -55, 124, -228, 360, -490, 564, -496, 139, 816, -3521, 27705, 11067, -5176, 3179, -2011, 1220, -680, 332, -130, 31, 6, -11, 5,
+    18, -55, 124, -227, 357, -485, 555, -481, 116, 851, -3577, 27643, 11185, -5204, 3187, -2011, 1217, -677, 329, -128, 29, 7, -11, 6,
+    18, -55, 123, -227, 355, -480, 546, -466, 93, 887, -3633, 27581, 11303, -5232, 3195, -2011, 1214, -673, 326, -126, 28, 8, -12, 6,
+    18, -55, 123, -226, 353, -475, 537, -451, 69, 922, -3688, 27517, 11421, -5260, 3203, -2011, 1211, -669, 323, -123, 26, 9, -12, 6,
+    18, -55, 123, -224, 350, -470, 528, -436, 46, 956, -3742, 27454, 11540, -5287, 3210, -2011, 1208, -666, 319, -121, 25, 9, -12, 6,
+    18, -55, 122, -223, 348, -465, 519, -421, 24, 991, -3796, 27389, 11658, -5314, 3217, -2011, 1205, -662, 316, -118, 23, 10, -13, 6,
+    18, -55, 122, -222, 345, -460, 510, -407, 1, 1026, -3850, 27324, 11777, -5341, 3224, -2010, 1201, -658, 313, -116, 22, 11, -13, 6,
+    18, -55, 122, -221, 342, -455, 501, -392, -22, 1060, -3902, 27258, 11895, -5367, 3231, -2009, 1198, -654, 309, -113, 20, 12, -14, 6,
+    18, -55, 121, -220, 340, -449, 492, -377, -45, 1094, -3954, 27192, 12013, -5393, 3237, -2008, 1194, -650, 306, -111, 19, 12, -14, 6,
+    18, -55, 121, -219, 337, -444, 483, -362, -68, 1128, -4006, 27125, 12132, -5419, 3243, -2007, 1190, -645, 302, -108, 17, 13, -14, 6,
+    18, -55, 121, -218, 335, -439, 474, -347, -90, 1161, -4057, 27057, 12250, -5444, 3249, -2006, 1187, -641, 299, -106, 15, 14, -15, 6,
+    18, -55, 120, -217, 332, -434, 464, -333, -113, 1195, -4107, 26988, 12369, -5469, 3255, -2004, 1183, -637, 295, -103, 14, 15, -15, 7,
+    18, -54, 120, -216, 329, -429, 455, -318, -135, 1228, -4157, 26919, 12488, -5494, 3260, -2002, 1179, -633, 291, -101, 12, 16, -15, 7,
+    18, -54, 119, -215, 327, -423, 446, -303, -158, 1261, -4206, 26849, 12606, -5518, 3265, -2001, 1174, -628, 288, -98, 11, 17, -16, 7,
+    18, -54, 119, -213, 324, -418, 437, -288, -180, 1294, -4255, 26778, 12725, -5542, 3270, -1998, 1170, -624, 284, -96, 9, 17, -16, 7,
+    18, -54, 119, -212, 321, -413, 428, -274, -202, 1326, -4303, 26707, 12844, -5566, 3274, -1996, 1166, -619, 280, -93, 8, 18, -16, 7,
+    18, -54, 118, -211, 319, -408, 419, -259, -224, 1359, -4350, 26635, 12962, -5589, 3279, -1994, 1161, -615, 277, -90, 6, 19, -17, 7,
+    18, -54, 118, -210, 316, -402, 409, -244, -246, 1391, -4397, 26563, 13081, -5612, 3283, -1991, 1156, -610, 273, -88, 4, 20, -17, 7,
+    18, -54, 117, -209, 313, -397, 400, -229, -269, 1423, -4443, 26489, 13200, -5634, 3287, -1989, 1152, -605, 269, -85, 3, 21, -17, 7,
+    18, -54, 117, -207, 310, -392, 391, -215, -290, 1454, -4488, 26416, 13318, -5656, 3290, -1986, 1147, -600, 265, -82, 1, 22, -18, 7,
+    18, -54, 116, -206, 308, -386, 382, -200, -312, 1486, -4533, 26341, 13437, -5678, 3293, -1983, 1142, -595, 261, -80, 0, 22, -18, 7,
+    18, -53, 116, -205, 305, -381, 372, -186, -334, 1517, -4577, 26266, 13555, -5699, 3296, -1980, 1137, -590, 257, -77, -2, 23, -18, 8,
+    18, -53, 116, -204, 302, -375, 363, -171, -356, 1548, -4621, 26190, 13674, -5720, 3299, -1976, 1131, -585, 253, -74, -4, 24, -19, 8,
+    18, -53, 115, -202, 299, -370, 354, -156, -377, 1579, -4664, 26114, 13792, -5741, 3301, -1973, 1126, -580, 249, -72, -5, 25, -19, 8,
+    18, -53, 115, -201, 296, -365, 345, -142, -399, 1609, -4707, 26037, 13911, -5761, 3304, -1969, 1121, -575, 245, -69, -7, 26, -19, 8,
+    18, -53, 114, -200, 293, -359, 335, -127, -420, 1640, -4748, 25959, 14029, -5780, 3306, -1965, 1115, -570, 241, -66, -9, 27, -20, 8,
+    18, -53, 114, -198, 290, -354, 326, -113, -441, 1670, -4790, 25881, 14148, -5800, 3307, -1961, 1110, -565, 237, -63, -10, 27, -20, 8,
+    18, -53, 113, -197, 288, -348, 317, -98, -463, 1700, -4830, 25802, 14266, -5819, 3309, -1957, 1104, -560, 233, -61, -12, 28, -20, 8,
+    18, -53, 113, -196, 285, -343, 308, -84, -484, 1729, -4870, 25722, 14384, -5837, 3310, -1952, 1098, -554, 229, -58, -13, 29, -21, 8,
+    18, -52, 112, -194, 282, -337, 298, -70, -505, 1759, -4910, 25642, 14503, -5856, 3311, -1948, 1092, -549, 225, -55, -15, 30, -21, 8,
+    18, -52, 111, -193, 279, -332, 289, -55, -526, 1788, -4949, 25561, 14621, -5873, 3311, -1943, 1086, -543, 221, -52, -17, 31, -22, 9,
+    18, -52, 111, -191, 276, -326, 280, -41, -546, 1816, -4987, 25480, 14739, -5891, 3312, -1938, 1080, -538, 216, -49, -19, 31, -22, 9,
+    18, -52, 110, -190, 273, -321, 270, -27, -567, 1845, -5025, 25398, 14857, -5907, 3312, -1933, 1074, -532, 212, -46, -20, 32, -22, 9,
+    18, -52, 110, -189, 270, -315, 261, -12, -588, 1874, -5062, 25315, 14975, -5924, 3311, -1927, 1067, -526, 208, -43, -22, 33, -23, 9,
+    18, -51, 109, -187, 267, -310, 252, 2, -608, 1902, -5098, 25232, 15092, -5940, 3311, -1922, 1061, -521, 203, -41, -23, 34, -23, 9,
+    17, -51, 109, -186, 264, -304, 243, 16, -628, 1929, -5134, 25149, 15210, -5956, 3310, -1916, 1054, -515, 199, -38, -25, 35, -23, 9,
+    17, -51, 108, -184, 261, -298, 234, 30, -649, 1957, -5169, 25064, 15328, -5971, 3309, -1910, 1047, -509, 195, -35, -27, 36, -24, 9,
+    18, -51, 108, -183, 258, -293, 224, 44, -669, 1984, -5204, 24979, 15445, -5985, 3308, -1904, 1041, -503, 190, -32, -29, 37, -24, 9,
+    17, -51, 107, -181, 255, -287, 215, 58, -689, 2012, -5238, 24894, 15562, -6000, 3306, -1898, 1034, -497, 186, -29, -30, 37, -24, 9,
+    17, -50, 107, -180, 252, -282, 206, 72, -709, 2038, -5271, 24808, 15680, -6014, 3304, -1892, 1027, -491, 181, -26, -32, 38, -25, 10,
+    17, -51, 106, -178, 248, -276, 197, 86, -729, 2065, -5304, 24721, 15797, -6027, 3302, -1885, 1020, -485, 177, -23, -34, 39, -25, 10,
+    17, -50, 105, -177, 245, -270, 187, 100, -748, 2091, -5336, 24634, 15914, -6040, 3300, -1879, 1012, -479, 172, -20, -35, 40, -25, 10,
+    17, -50, 105, -175, 242, -265, 178, 114, -768, 2117, -5368, 24547, 16030, -6053, 3297, -1872, 1005, -472, 168, -17, -37, 41, -26, 10,
+    17, -50, 104, -174, 239, -259, 169, 128, -787, 2143, -5399, 24458, 16147, -6065, 3294, -1865, 998, -466, 163, -14, -39, 42, -26, 10,
+    17, -50, 103, -172, 236, -254, 160, 142, -807, 2169, -5429, 24370, 16264, -6077, 3290, -1857, 990, -460, 158, -11, -41, 43, -26, 10,
+    17, -49, 103, -171, 233, -248, 151, 155, -826, 2194, -5459, 24280, 16380, -6088, 3287, -1850, 983, -454, 154, -8, -42, 43, -27, 10,
+    17, -49, 102, -169, 230, -242, 141, 169, -845, 2219, -5488, 24190, 16496, -6099, 3283, -1842, 975, -447, 149, -5, -44, 44, -27, 10,
+    17, -49, 101, -168, 227, -237, 133, 183, -864, 2244, -5517, 24100, 16612, -6109, 3279, -1835, 967, -441, 144, -2, -46, 45, -27, 11,
+    17, -49, 101, -166, 224, -231, 123, 196, -883, 2268, -5545, 24009, 16728, -6119, 3274, -1826, 959, -434, 140, 1, -48, 46, -28, 11,
+    17, -49, 100, -165, 220, -225, 114, 210, -901, 2292, -5572, 23917, 16844, -6128, 3269, -1819, 951, -427, 135, 4, -49, 47, -28, 11,
+    17, -48, 99, -163, 217, -220, 105, 223, -920, 2316, -5599, 23825, 16959, -6137, 3265, -1810, 943, -421, 130, 7, -51, 48, -28, 11,
+    17, -48, 99, -162, 214, -214, 96, 237, -939, 2340, -5625, 23733, 17075, -6146, 3259, -1802, 935, -414, 125, 10, -53, 49, -29, 11,
+    17, -48, 98, -160, 211, -209, 87, 250, -957, 2363, -5651, 23640, 17190, -6153, 3254, -1793, 926, -407, 120, 14, -55, 49, -29, 11,
+    17, -48, 97, -158, 208, -203, 78, 263, -975, 2387, -5676, 23546, 17305, -6161, 3248, -1784, 918, -401, 115, 17, -56, 50, -30, 11,
+    17, -47, 97, -157, 204, -197, 69, 277, -993, 2410, -5701, 23452, 17419, -6168, 3242, -1775, 909, -394, 110, 20, -58, 51, -30, 11,
+    16, -47, 96, -155, 201, -192, 60, 290, -1011, 2432, -5724, 23358, 17534, -6174, 3235, -1766, 901, -387, 105, 23, -60, 52, -30, 11,
+    16, -47, 95, -153, 198, -186, 51, 303, -1029, 2455, -5748, 23263, 17648, -6180, 3228, -1757, 892, -380, 101, 26, -62, 53, -31, 12,
+    16, -47, 95, -152, 195, -180, 42, 316, -1046, 2476, -5770, 23167, 17762, -6186, 3221, -1747, 883, -373, 95, 29, -63, 54, -31, 12,
+    16, -46, 94, -150, 192, -175, 33, 329, -1064, 2498, -5793, 23071, 17876, -6191, 3214, -1738, 874, -366, 91, 32, -65, 55, -31, 12,
+    16, -46, 93, -149, 188, -169, 24, 342, -1081, 2520, -5814, 22975, 17990, -6196, 3206, -1728, 865, -358, 85, 36, -67, 56, -32, 12,
+    16, -46, 93, -147, 185, -163, 15, 355, -1099, 2541, -5835, 22878, 18103, -6200, 3198, -1718, 856, -351, 81, 39, -69, 56, -32, 12,
+    16, -46, 92, -145, 182, -158, 6, 368, -1116, 2562, -5855, 22780, 18217, -6203, 3190, -1708, 847, -344, 75, 42, -71, 57, -32, 12,
+    16, -45, 91, -144, 179, -152, -3, 381, -1133, 2583, -5875, 22682, 18329, -6206, 3182, -1697, 837, -337, 70, 45, -72, 58, -33, 12,
+    16, -45, 90, -142, 175, -146, -11, 393, -1150, 2603, -5894, 22584, 18442, -6209, 3173, -1687, 828, -329, 65, 48, -74, 59, -33, 12,
+    16, -45, 89, -140, 172, -141, -20, 406, -1166, 2623, -5913, 22485, 18554, -6211, 3164, -1676, 819, -322, 60, 51, -76, 60, -33, 12,
+    16, -45, 89, -139, 169, -135, -29, 418, -1183, 2643, -5931, 22386, 18667, -6212, 3154, -1665, 809, -315, 55, 55, -78, 61, -34, 12,
+    16, -44, 88, -137, 166, -130, -38, 431, -1199, 2662, -5949, 22286, 18778, -6214, 3145, -1654, 799, -307, 50, 58, -79, 61, -34, 13,
+    16, -44, 87, -135, 162, -124, -46, 443, -1215, 2681, -5966, 22186, 18890, -6214, 3135, -1643, 789, -300, 45, 61, -81, 62, -34, 13,
+    15, -44, 87, -133, 159, -118, -55, 456, -1232, 2700, -5982, 22086, 19001, -6214, 3125, -1632, 780, -292, 39, 64, -83, 63, -35, 13,
+    15, -43, 86, -132, 156, -113, -64, 468, -1248, 2719, -5998, 21985, 19112, -6214, 3114, -1620, 770, -284, 34, 68, -85, 64, -35, 13,
+    15, -43, 85, -130, 152, -107, -72, 480, -1263, 2737, -6013, 21883, 19223, -6213, 3103, -1608, 759, -277, 29, 71, -86, 65, -35, 13,
+    15, -43, 84, -128, 149, -102, -81, 492, -1279, 2756, -6027, 21781, 19334, -6211, 3092, -1597, 749, -269, 24, 74, -88, 66, -36, 13,
+    15, -43, 83, -127, 146, -96, -90, 504, -1294, 2773, -6041, 21679, 19444, -6209, 3081, -1584, 739, -261, 18, 77, -90, 67, -36, 13,
+    15, -42, 83, -125, 143, -90, -98, 516, -1310, 2791, -6055, 21576, 19554, -6207, 3069, -1572, 729, -254, 13, 80, -92, 67, -36, 13,
+    15, -42, 82, -123, 140, -85, -107, 528, -1325, 2808, -6068, 21473, 19663, -6203, 3057, -1560, 718, -246, 8, 84, -93, 68, -37, 13,
+    15, -42, 81, -122, 136, -79, -115, 540, -1340, 2825, -6080, 21370, 19772, -6200, 3045, -1547, 708, -238, 2, 87, -95, 69, -37, 13,
+    15, -41, 80, -120, 133, -74, -124, 552, -1355, 2842, -6092, 21266, 19881, -6196, 3032, -1535, 697, -230, -3, 90, -97, 70, -37, 14,
+    15, -41, 79, -118, 130, -68, -132, 563, -1370, 2858, -6103, 21162, 19990, -6191, 3019, -1522, 686, -222, -8, 93, -99, 71, -38, 14,
+    15, -41, 79, -116, 126, -63, -140, 575, -1384, 2874, -6114, 21057, 20098, -6186, 3006, -1509, 676, -214, -14, 97, -101, 71, -38, 14,
+    14, -40, 78, -115, 123, -57, -149, 587, -1399, 2890, -6124, 20952, 20206, -6180, 2992, -1496, 665, -206, -19, 100, -102, 72, -38, 14,
+    14, -40, 77, -113, 120, -52, -157, 598, -1413, 2906, -6134, 20846, 20314, -6174, 2979, -1482, 654, -198, -24, 103, -104, 73, -39, 14,
+    14, -40, 76, -111, 116, -46, -165, 609, -1427, 2921, -6143, 20741, 20421, -6167, 2965, -1469, 643, -190, -30, 107, -106, 74, -39, 14,
+    14, -40, 75, -109, 113, -41, -174, 621, -1441, 2936, -6151, 20634, 20528, -6159, 2950, -1455, 632, -182, -35, 110, -108, 75, -39, 14,
+    14, -39, 75, -108, 110, -35, -182, 632, -1455, 2950, -6159, 20528, 20634, -6151, 2936, -1441, 621, -174, -41, 113, -109, 75, -40, 14,
+    14, -39, 74, -106, 107, -30, -190, 643, -1469, 2965, -6167, 20421, 20741, -6143, 2921, -1427, 609, -165, -46, 116, -111, 76, -40, 14,
+    14, -39, 73, -104, 103, -24, -198, 654, -1482, 2979, -6174, 20314, 20846, -6134, 2906, -1413, 598, -157, -52, 120, -113, 77, -40, 14,
+    14, -38, 72, -102, 100, -19, -206, 665, -1496, 2992, -6180, 20206, 20952, -6124, 2890, -1399, 587, -149, -57, 123, -115, 78, -40, 14,
+    14, -38, 71, -101, 97, -14, -214, 676, -1509, 3006, -6186, 20098, 21057, -6114, 2874, -1384, 575, -140, -63, 126, -116, 79, -41, 15,
+    14, -38, 71, -99, 93, -8, -222, 686, -1522, 3019, -6191, 19990, 21162, -6103, 2858, -1370, 563, -132, -68, 130, -118, 79, -41, 15,
+    14, -37, 70, -97, 90, -3, -230, 697, -1535, 3032, -6196, 19881, 21266, -6092, 2842, -1355, 552, -124, -74, 133, -120, 80, -41, 15,
+    13, -37, 69, -95, 87, 2, -238, 708, -1547, 3045, -6200, 19772, 21370, -6080, 2825, -1340, 540, -115, -79, 136, -122, 81, -42, 15,
+    13, -37, 68, -93, 84, 8, -246, 718, -1560, 3057, -6203, 19663, 21473, -6068, 2808, -1325, 528, -107, -85, 140, -123, 82, -42, 15,
+    13, -36, 67, -92, 80, 13, -254, 729, -1572, 3069, -6207, 19554, 21576, -6055, 2791, -1310, 516, -98, -90, 143, -125, 83, -42, 15,
+    13, -36, 67, -90, 77, 18, -261, 739, -1584, 3081, -6209, 19444, 21679, -6041, 2773, -1294, 504, -90, -96, 146, -127, 83, -43, 15,
+    13, -36, 66, -88, 74, 24, -269, 749, -1597, 3092, -6211, 19334, 21781, -6027, 2756, -1279, 492, -81, -102, 149, -128, 84, -43, 15,
+    13, -35, 65, -86, 71, 29, -277, 759, -1608, 3103, -6213, 19223, 21883, -6013, 2737, -1263, 480, -72, -107, 152, -130, 85, -43, 15,
+    13, -35, 64, -85, 68, 34, -284, 770, -1620, 3114, -6214, 19112, 21985, -5998, 2719, -1248, 468, -64, -113, 156, -132, 86, -43, 15,
+    13, -35, 63, -83, 64, 39, -292, 780, -1632, 3125, -6214, 19001, 22086, -5982, 2700, -1232, 456, -55, -118, 159, -133, 87, -44, 15,
+    13, -34, 62, -81, 61, 45, -300, 789, -1643, 3135, -6214, 18890, 22186, -5966, 2681, -1215, 443, -46, -124, 162, -135, 87, -44, 16,
+    13, -34, 61, -79, 58, 50, -307, 799, -1654, 3145, -6214, 18778, 22286, -5949, 2662, -1199, 431, -38, -130, 166, -137, 88, -44, 16,
+    12, -34, 61, -78, 55, 55, -315, 809, -1665, 3154, -6212, 18667, 22386, -5931, 2643, -1183, 418, -29, -135, 169, -139, 89, -45, 16,
+    12, -33, 60, -76, 51, 60, -322, 819, -1676, 3164, -6211, 18554, 22485, -5913, 2623, -1166, 406, -20, -141, 172, -140, 89, -45, 16,
+    12, -33, 59, -74, 48, 65, -329, 828, -1687, 3173, -6209, 18442, 22584, -5894, 2603, -1150, 393, -11, -146, 175, -142, 90, -45, 16,
+    12, -33, 58, -72, 45, 70, -337, 837, -1697, 3182, -6206, 18329, 22682, -5875, 2583, -1133, 381, -3, -152, 179, -144, 91, -45, 16,
+    12, -32, 57, -71, 42, 75, -344, 847, -1708, 3190, -6203, 18217, 22780, -5855, 2562, -1116, 368, 6, -158, 182, -145, 92, -46, 16,
+    12, -32, 56, -69, 39, 81, -351, 856, -1718, 3198, -6200, 18103, 22878, -5835, 2541, -1099, 355, 15, -163, 185, -147, 93, -46, 16,
+    12, -32, 56, -67, 36, 85, -358, 865, -1728, 3206, -6196, 17990, 22975, -5814, 2520, -1081, 342, 24, -169, 188, -149, 93, -46, 16,
+    12, -31, 55, -65, 32, 91, -366, 874, -1738, 3214, -6191, 17876, 23071, -5793, 2498, -1064, 329, 33, -175, 192, -150, 94, -46, 16,
+    12, -31, 54, -63, 29, 95, -373, 883, -1747, 3221, -6186, 17762, 23167, -5770, 2476, -1046, 316, 42, -180, 195, -152, 95, -47, 16,
+    12, -31, 53, -62, 26, 101, -380, 892, -1757, 3228, -6180, 17648, 23263, -5748, 2455, -1029, 303, 51, -186, 198, -153, 95, -47, 16,
+    11, -30, 52, -60, 23, 105, -387, 901, -1766, 3235, -6174, 17534, 23358, -5724, 2432, -1011, 290, 60, -192, 201, -155, 96, -47, 16,
+    11, -30, 51, -58, 20, 110, -394, 909, -1775, 3242, -6168, 17419, 23452, -5701, 2410, -993, 277, 69, -197, 204, -157, 97, -47, 17,
+    11, -30, 50, -56, 17, 115, -401, 918, -1784, 3248, -6161, 17305, 23546, -5676, 2387, -975, 263, 78, -203, 208, -158, 97, -48, 17,
+    11, -29, 49, -55, 14, 120, -407, 926, -1793, 3254, -6153, 17190, 23640, -5651, 2363, -957, 250, 87, -209, 211, -160, 98, -48, 17,
+    11, -29, 49, -53, 10, 125, -414, 935, -1802, 3259, -6146, 17075, 23733, -5625, 2340, -939, 237, 96, -214, 214, -162, 99, -48, 17,
+    11, -28, 48, -51, 7, 130, -421, 943, -1810, 3265, -6137, 16959, 23825, -5599, 2316, -920, 223, 105, -220, 217, -163, 99, -48, 17,
+    11, -28, 47, -49, 4, 135, -427, 951, -1819, 3269, -6128, 16844, 23917, -5572, 2292, -901, 210, 114, -225, 220, -165, 100, -49, 17,
+    11, -28, 46, -48, 1, 140, -434, 959, -1826, 3274, -6119, 16728, 24009, -5545, 2268, -883, 196, 123, -231, 224, -166, 101, -49, 17,
+    11, -27, 45, -46, -2, 144, -441, 967, -1835, 3279, -6109, 16612, 24100, -5517, 2244, -864, 183, 133, -237, 227, -168, 101, -49, 17,
+    10, -27, 44, -44, -5, 149, -447, 975, -1842, 3283, -6099, 16496, 24190, -5488, 2219, -845, 169, 141, -242, 230, -169, 102, -49, 17,
+    10, -27, 43, -42, -8, 154, -454, 983, -1850, 3287, -6088, 16380, 24280, -5459, 2194, -826, 155, 151, -248, 233, -171, 103, -49, 17,
+    10, -26, 43, -41, -11, 158, -460, 990, -1857, 3290, -6077, 16264, 24370, -5429, 2169, -807, 142, 160, -254, 236, -172, 103, -50, 17,
+    10, -26, 42, -39, -14, 163, -466, 998, -1865, 3294, -6065, 16147, 24458, -5399, 2143, -787, 128, 169, -259, 239, -174, 104, -50, 17,
+    10, -26, 41, -37, -17, 168, -472, 1005, -1872, 3297, -6053, 16030, 24547, -5368, 2117, -768, 114, 178, -265, 242, -175, 105, -50, 17,
+    10, -25, 40, -35, -20, 172, -479, 1012, -1879, 3300, -6040, 15914, 24634, -5336, 2091, -748, 100, 187, -270, 245, -177, 105, -50, 17,
+    10, -25, 39, -34, -23, 177, -485, 1020, -1885, 3302, -6027, 15797, 24721, -5304, 2065, -729, 86, 197, -276, 248, -178, 106, -51, 17,
+    10, -25, 38, -32, -26, 181, -491, 1027, -1892, 3304, -6014, 15680, 24808, -5271, 2038, -709, 72, 206, -282, 252, -180, 107, -50, 17,
+    9, -24, 37, -30, -29, 186, -497, 1034, -1898, 3306, -6000, 15562, 24894, -5238, 2012, -689, 58, 215, -287, 255, -181, 107, -51, 17,
+    9, -24, 37, -29, -32, 190, -503, 1041, -1904, 3308, -5985, 15445, 24979, -5204, 1984, -669, 44, 224, -293, 258, -183, 108, -51, 18,
+    9, -24, 36, -27, -35, 195, -509, 1047, -1910, 3309, -5971, 15328, 25064, -5169, 1957, -649, 30, 234, -298, 261, -184, 108, -51, 17,
+    9, -23, 35, -25, -38, 199, -515, 1054, -1916, 3310, -5956, 15210, 25149, -5134, 1929, -628, 16, 243, -304, 264, -186, 109, -51, 17,
+    9, -23, 34, -23, -41, 203, -521, 1061, -1922, 3311, -5940, 15092, 25232, -5098, 1902, -608, 2, 252, -310, 267, -187, 109, -51, 18,
+    9, -23, 33, -22, -43, 208, -526, 1067, -1927, 3311, -5924, 14975, 25315, -5062, 1874, -588, -12, 261, -315, 270, -189, 110, -52, 18,
+    9, -22, 32, -20, -46, 212, -532, 1074, -1933, 3312, -5907, 14857, 25398, -5025, 1845, -567, -27, 270, -321, 273, -190, 110, -52, 18,
+    9, -22, 31, -19, -49, 216, -538, 1080, -1938, 3312, -5891, 14739, 25480, -4987, 1816, -546, -41, 280, -326, 276, -191, 111, -52, 18,
+    9, -22, 31, -17, -52, 221, -543, 1086, -1943, 3311, -5873, 14621, 25561, -4949, 1788, -526, -55, 289, -332, 279, -193, 111, -52, 18,
+    8, -21, 30, -15, -55, 225, -549, 1092, -1948, 3311, -5856, 14503, 25642, -4910, 1759, -505, -70, 298, -337, 282, -194, 112, -52, 18,
+    8, -21, 29, -13, -58, 229, -554, 1098, -1952, 3310, -5837, 14384, 25722, -4870, 1729, -484, -84, 308, -343, 285, -196, 113, -53, 18,
+    8, -20, 28, -12, -61, 233, -560, 1104, -1957, 3309, -5819, 14266, 25802, -4830, 1700, -463, -98, 317, -348, 288, -197, 113, -53, 18,
+    8, -20, 27, -10, -63, 237, -565, 1110, -1961, 3307, -5800, 14148, 25881, -4790, 1670, -441, -113, 326, -354, 290, -198, 114, -53, 18,
+    8, -20, 27, -9, -66, 241, -570, 1115, -1965, 3306, -5780, 14029, 25959, -4748, 1640, -420, -127, 335, -359, 293, -200, 114, -53, 18,
+    8, -19, 26, -7, -69, 245, -575, 1121, -1969, 3304, -5761, 13911, 26037, -4707, 1609, -399, -142, 345, -365, 296, -201, 115, -53, 18,
+    8, -19, 25, -5, -72, 249, -580, 1126, -1973, 3301, -5741, 13792, 26114, -4664, 1579, -377, -156, 354, -370, 299, -202, 115, -53, 18,
+    8, -19, 24, -4, -74, 253, -585, 1131, -1976, 3299, -5720, 13674, 26190, -4621, 1548, -356, -171, 363, -375, 302, -204, 116, -53, 18,
+    8, -18, 23, -2, -77, 257, -590, 1137, -1980, 3296, -5699, 13555, 26266, -4577, 1517, -334, -186, 372, -381, 305, -205, 116, -53, 18,
+    7, -18, 22, 0, -80, 261, -595, 1142, -1983, 3293, -5678, 13437, 26341, -4533, 1486, -312, -200, 382, -386, 308, -206, 116, -54, 18,
+    7, -18, 22, 1, -82, 265, -600, 1147, -1986, 3290, -5656, 13318, 26416, -4488, 1454, -290, -215, 391, -392, 310, -207, 117, -54, 18,
+    7, -17, 21, 3, -85, 269, -605, 1152, -1989, 3287, -5634, 13200, 26489, -4443, 1423, -269, -229, 400, -397, 313, -209, 117, -54, 18,
+    7, -17, 20, 4, -88, 273, -610, 1156, -1991, 3283, -5612, 13081, 26563, -4397, 1391, -246, -244, 409, -402, 316, -210, 118, -54, 18,
+    7, -17, 19, 6, -90, 277, -615, 1161, -1994, 3279, -5589, 12962, 26635, -4350, 1359, -224, -259, 419, -408, 319, -211, 118, -54, 18,
+    7, -16, 18, 8, -93, 280, -619, 1166, -1996, 3274, -5566, 12844, 26707, -4303, 1326, -202, -274, 428, -413, 321, -212, 119, -54, 18,
+    7, -16, 17, 9, -96, 284, -624, 1170, -1998, 3270, -5542, 12725, 26778, -4255, 1294, -180, -288, 437, -418, 324, -213, 119, -54, 18,
+    7, -16, 17, 11, -98, 288, -628, 1174, -2001, 3265, -5518, 12606, 26849, -4206, 1261, -158, -303, 446, -423, 327, -215, 119, -54, 18,
+    7, -15, 16, 12, -101, 291, -633, 1179, -2002, 3260, -5494, 12488, 26919, -4157, 1228, -135, -318, 455, -429, 329, -216, 120, -54, 18,
+    7, -15, 15, 14, -103, 295, -637, 1183, -2004, 3255, -5469, 12369, 26988, -4107, 1195, -113, -333, 464, -434, 332, -217, 120, -55, 18,
+    6, -15, 14, 15, -106, 299, -641, 1187, -2006, 3249, -5444, 12250, 27057, -4057, 1161, -90, -347, 474, -439, 335, -218, 121, -55, 18,
+    6, -14, 13, 17, -108, 302, -645, 1190, -2007, 3243, -5419, 12132, 27125, -4006, 1128, -68, -362, 483, -444, 337, -219, 121, -55, 18,
+    6, -14, 12, 19, -111, 306, -650, 1194, -2008, 3237, -5393, 12013, 27192, -3954, 1094, -45, -377, 492, -449, 340, -220, 121, -55, 18,
+    6, -14, 12, 20, -113, 309, -654, 1198, -2009, 3231, -5367, 11895, 27258, -3902, 1060, -22, -392, 501, -455, 342, -221, 122, -55, 18,
+    6, -13, 11, 22, -116, 313, -658, 1201, -2010, 3224, -5341, 11777, 27324, -3850, 1026, 1, -407, 510, -460, 345, -222, 122, -55, 18,
+    6, -13, 10, 23, -118, 316, -662, 1205, -2011, 3217, -5314, 11658, 27389, -3796, 991, 24, -421, 519, -465, 348, -223, 122, -55, 18,
+    6, -12, 9, 25, -121, 319, -666, 1208, -2011, 3210, -5287, 11540, 27454, -3742, 956, 46, -436, 528, -470, 350, -224, 123, -55, 18,
+    6, -12, 9, 26, -123, 323, -669, 1211, -2011, 3203, -5260, 11421, 27517, -3688, 922, 69, -451, 537, -475, 353, -226, 123, -55, 18,
+    6, -12, 8, 28, -126, 326, -673, 1214, -2011, 3195, -5232, 11303, 27581, -3633, 887, 93, -466, 546, -480, 355, -227, 123, -55, 18,
+    6, -11, 7, 29, -128, 329, -677, 1217, -2011, 3187, -5204, 11185, 27643, -3577, 851, 116, -481, 555, -485, 357, -227, 124, -55, 18,
+    5, -11, 6, 31, -130, 332, -680, 1220, -2011, 3179, -5176, 11067, 27705, -3521, 816, 139, -496, 564, -490, 360, -228, 124, -55, 18,
+    5, -11, 5, 32, -132, 336, -684, 1223, -2011, 3171, -5147, 10949, 27766, -3464, 780, 162, -510, 573, -495, 362, -229, 124, -55, 18,
+    5, -10, 5, 33, -135, 339, -688, 1226, -2010, 3163, -5119, 10831, 27826, -3406, 744, 185, -525, 582, -500, 365, -230, 124, -55, 18,
+    5, -10, 4, 35, -137, 342, -691, 1228, -2010, 3154, -5089, 10713, 27885, -3348, 708, 209, -540, 591, -505, 367, -231, 125, -55, 18,
+    5, -10, 3, 36, -140, 345, -694, 1231, -2009, 3145, -5060, 10596, 27944, -3289, 672, 232, -555, 600, -509, 369, -232, 125, -55, 18,
+    5, -10, 2, 38, -142, 348, -698, 1233, -2008, 3136, -5030, 10478, 28002, -3230, 636, 256, -570, 609, -514, 372, -233, 125, -55, 18,
+    5, -9, 2, 39, -144, 351, -701, 1235, -2007, 3126, -5000, 10361, 28060, -3170, 599, 279, -585, 618, -519, 374, -234, 125, -55, 18,
+    5, -9, 1, 40, -146, 354, -704, 1238, -2005, 3116, -4969, 10243, 28116, -3110, 563, 302, -599, 626, -524, 376, -235, 126, -55, 18,
+    5, -9, 0, 42, -148, 357, -707, 1240, -2004, 3106, -4939, 10126, 28172, -3049, 526, 326, -614, 635, -528, 378, -236, 126, -55, 18,
+    4, -8, -1, 43, -150, 360, -710, 1241, -2002, 3096, -4908, 10009, 28227, -2987, 489, 350, -629, 644, -533, 381, -237, 126, -55, 18,
+    4, -8, -1, 45, -153, 362, -713, 1243, -2000, 3086, -4876, 9892, 28282, -2925, 452, 373, -644, 652, -538, 383, -237, 126, -55, 18,
+    4, -7, -2, 46, -155, 365, -716, 1245, -1998, 3075, -4845, 9775, 28335, -2862, 414, 397, -658, 661, -542, 385, -238, 126, -55, 18,
+    4, -7, -3, 47, -157, 368, -719, 1246, -1996, 3064, -4813, 9658, 28388, -2798, 377, 421, -673, 670, -547, 387, -239, 127, -55, 18,
+    4, -7, -4, 49, -159, 371, -721, 1248, -1994, 3053, -4781, 9541, 28441, -2734, 339, 445, -688, 678, -552, 389, -240, 127, -55, 18,
+    4, -7, -4, 50, -161, 373, -724, 1249, -1991, 3042, -4748, 9425, 28492, -2670, 301, 468, -703, 687, -556, 391, -240, 127, -55, 18,
+    4, -6, -5, 51, -163, 376, -727, 1251, -1989, 3031, -4716, 9309, 28543, -2605, 263, 492, -717, 696, -561, 393, -241, 127, -55, 17,
+    4, -6, -6, 53, -165, 379, -729, 1252, -1986, 3019, -4683, 9192, 28593, -2539, 225, 516, -732, 704, -565, 395, -242, 127, -55, 17,
+    4, -6, -6, 54, -167, 381, -732, 1253, -1983, 3007, -4650, 9076, 28642, -2473, 187, 540, -747, 713, -569, 397, -242, 127, -55, 17,
+    4, -5, -7, 55, -169, 383, -734, 1254, -1980, 2995, -4616, 8961, 28690, -2406, 148, 564, -761, 721, -574, 399, -243, 127, -55, 17,
+    4, -5, -8, 57, -171, 386, -736, 1255, -1977, 2983, -4583, 8845, 28738, -2338, 109, 588, -776, 729, -578, 401, -244, 127, -55, 17,
+    4, -5, -9, 58, -173, 388, -739, 1255, -1973, 2970, -4549, 8729, 28785, -2270, 71, 612, -790, 738, -583, 403, -244, 128, -55, 17,
+    3, -4, -9, 59, -175, 391, -741, 1256, -1970, 2957, -4514, 8614, 28831, -2202, 32, 636, -805, 746, -587, 405, -245, 128, -55, 17,
+    3, -4, -10, 61, -177, 393, -743, 1256, -1966, 2944, -4480, 8499, 28877, -2132, -7, 659, -820, 754, -591, 407, -246, 128, -54, 17,
+    3, -4, -11, 62, -179, 395, -745, 1257, -1962, 2931, -4445, 8384, 28921, -2063, -46, 683, -834, 762, -595, 409, -246, 128, -54, 17,
+    3, -3, -11, 63, -181, 398, -747, 1257, -1958, 2918, -4411, 8269, 28965, -1992, -86, 707, -849, 771, -600, 411, -247, 128, -54, 17,
+    3, -3, -12, 64, -182, 400, -749, 1257, -1954, 2904, -4375, 8155, 29008, -1922, -125, 731, -863, 779, -604, 412, -247, 128, -54, 17,
+    3, -3, -13, 65, -184, 402, -751, 1257, -1949, 2890, -4340, 8041, 29051, -1850, -165, 755, -877, 787, -608, 414, -248, 128, -54, 17,
+    3, -2, -13, 67, -186, 404, -753, 1257, -1945, 2876, -4305, 7926, 29092, -1778, -204, 779, -892, 795, -612, 416, -248, 128, -54, 17,
+    3, -2, -14, 68, -188, 406, -754, 1257, -1940, 2862, -4269, 7812, 29133, -1705, -244, 803, -906, 803, -616, 417, -249, 128, -54, 17,
+    3, -2, -15, 69, -189, 408, -756, 1257, -1936, 2848, -4233, 7699, 29173, -1632, -284, 827, -920, 811, -620, 419, -249, 128, -54, 16,
+    3, -2, -15, 70, -191, 410, -758, 1257, -1931, 2833, -4197, 7585, 29212, -1559, -324, 852, -934, 819, -624, 421, -250, 128, -54, 17,
+    2, -1, -16, 71, -193, 412, -759, 1256, -1925, 2818, -4160, 7472, 29251, -1484, -364, 875, -949, 827, -628, 422, -250, 128, -53, 16,
+    2, -1, -17, 73, -194, 414, -761, 1256, -1920, 2804, -4124, 7359, 29288, -1410, -405, 900, -963, 835, -632, 424, -251, 128, -53, 16,
+    2, -1, -17, 74, -196, 416, -762, 1255, -1915, 2788, -4087, 7246, 29325, -1334, -445, 924, -977, 842, -635, 425, -251, 128, -53, 16,
+    2, -1, -18, 75, -198, 418, -763, 1254, -1909, 2773, -4050, 7134, 29361, -1258, -485, 947, -991, 850, -639, 427, -251, 127, -53, 16,
+    2, 0, -19, 76, -199, 420, -764, 1254, -1904, 2758, -4013, 7022, 29396, -1182, -526, 971, -1005, 858, -643, 428, -252, 127, -53, 16,
+    2, 0, -19, 77, -201, 422, -766, 1252, -1898, 2742, -3975, 6910, 29431, -1105, -567, 995, -1019, 866, -647, 430, -252, 127, -53, 16,
+    2, 0, -20, 78, -203, 423, -767, 1252, -1892, 2726, -3938, 6798, 29465, -1027, -608, 1019, -1033, 873, -650, 431, -252, 127, -52, 16,
+    2, 1, -21, 79, -204, 425, -768, 1250, -1886, 2710, -3900, 6686, 29497, -949, -648, 1043, -1047, 881, -654, 433, -253, 127, -52, 16,
+    2, 1, -21, 80, -206, 427, -769, 1249, -1880, 2694, -3862, 6575, 29529, -871, -689, 1067, -1061, 888, -657, 434, -253, 127, -52, 16,
+    2, 1, -22, 81, -207, 428, -770, 1248, -1873, 2677, -3824, 6464, 29561, -792, -730, 1091, -1075, 896, -661, 435, -253, 127, -52, 16,
+    2, 1, -22, 82, -209, 430, -770, 1246, -1867, 2661, -3786, 6353, 29591, -712, -772, 1115, -1088, 903, -664, 437, -253, 127, -52, 15,
+    2, 2, -23, 83, -210, 431, -771, 1245, -1860, 2644, -3747, 6243, 29621, -632, -813, 1139, -1102, 910, -668, 438, -254, 127, -52, 15,
+    1, 2, -24, 84, -211, 433, -772, 1243, -1853, 2627, -3709, 6133, 29650, -551, -854, 1163, -1116, 918, -671, 439, -254, 126, -51, 15,
+    1, 2, -24, 86, -213, 434, -773, 1241, -1846, 2610, -3670, 6023, 29678, -470, -895, 1187, -1129, 925, -675, 440, -254, 126, -51, 15,
+    1, 2, -25, 87, -214, 436, -773, 1239, -1839, 2593, -3631, 5914, 29705, -388, -937, 1210, -1143, 932, -678, 441, -254, 126, -51, 15,
+    1, 3, -25, 87, -216, 437, -774, 1237, -1832, 2575, -3592, 5804, 29732, -305, -978, 1234, -1156, 939, -681, 442, -254, 126, -51, 15,
+    1, 3, -26, 89, -217, 438, -774, 1235, -1825, 2558, -3553, 5695, 29757, -223, -1020, 1258, -1170, 946, -684, 443, -254, 126, -50, 15,
+    1, 3, -27, 89, -218, 440, -775, 1233, -1817, 2540, -3513, 5587, 29782, -139, -1062, 1281, -1183, 953, -688, 445, -254, 125, -50, 15,
+    1, 4, -27, 90, -220, 441, -775, 1231, -1810, 2522, -3474, 5478, 29806, -55, -1103, 1305, -1196, 960, -691, 446, -254, 125, -50, 14,
+    1, 4, -28, 91, -221, 442, -775, 1229, -1802, 2504, -3434, 5371, 29829, 29, -1145, 1329, -1210, 967, -694, 446, -254, 125, -50, 14,
+    1, 4, -28, 92, -222, 443, -775, 1226, -1794, 2486, -3394, 5263, 29852, 114, -1187, 1352, -1223, 974, -697, 447, -254, 124, -50, 14,
+    1, 4, -29, 93, -223, 444, -775, 1224, -1786, 2467, -3354, 5156, 29873, 199, -1229, 1376, -1236, 980, -700, 448, -254, 124, -49, 14,
+    1, 4, -29, 94, -224, 445, -775, 1221, -1778, 2449, -3314, 5048, 29894, 285, -1271, 1399, -1249, 987, -703, 449, -254, 124, -49, 14,
+    1, 5, -30, 95, -226, 446, -775, 1218, -1770, 2430, -3274, 4942, 29914, 372, -1313, 1423, -1262, 993, -705, 450, -254, 123, -49, 14,
+    1, 5, -30, 96, -227, 447, -775, 1216, -1762, 2411, -3234, 4835, 29933, 458, -1355, 1446, -1275, 1000, -708, 451, -254, 123, -48, 14,
+    1, 5, -31, 97, -228, 448, -775, 1213, -1753, 2392, -3194, 4729, 29951, 546, -1397, 1469, -1288, 1007, -711, 452, -254, 123, -48, 14,
+    0, 5, -31, 98, -229, 449, -775, 1210, -1745, 2373, -3153, 4624, 29969, 634, -1439, 1493, -1300, 1013, -714, 452, -254, 123, -48, 13,
+    1, 6, -32, 99, -230, 450, -775, 1207, -1736, 2354, -3112, 4518, 29985, 722, -1481, 1516, -1313, 1019, -716, 453, -254, 122, -48, 13,
+    0, 6, -32, 99, -231, 451, -774, 1203, -1727, 2335, -3072, 4413, 30001, 811, -1523, 1539, -1326, 1026, -719, 454, -254, 122, -47, 13,
+    0, 6, -33, 100, -232, 452, -774, 1200, -1718, 2315, -3031, 4309, 30016, 900, -1565, 1562, -1338, 1032, -721, 454, -253, 121, -47, 13,
+    0, 6, -34, 101, -233, 452, -773, 1197, -1709, 2296, -2990, 4204, 30030, 990, -1607, 1585, -1350, 1038, -724, 455, -253, 121, -47, 13,
+    0, 7, -34, 102, -234, 453, -773, 1193, -1700, 2276, -2949, 4101, 30043, 1081, -1650, 1608, -1363, 1044, -726, 455, -253, 121, -47, 13,
+    0, 7, -34, 103, -235, 454, -772, 1190, -1691, 2256, -2908, 3997, 30056, 1171, -1692, 1631, -1375, 1050, -729, 456, -253, 120, -46, 12,
+    0, 7, -35, 103, -236, 454, -772, 1186, -1681, 2236, -2867, 3894, 30068, 1263, -1734, 1654, -1387, 1056, -731, 456, -252, 120, -46, 12,
+    0, 7, -35, 104, -237, 455, -771, 1182, -1672, 2216, -2825, 3791, 30079, 1354, -1776, 1676, -1399, 1062, -733, 457, -252, 119, -46, 12,
+    0, 8, -36, 105, -238, 456, -770, 1178, -1662, 2195, -2784, 3689, 30088, 1447, -1819, 1699, -1411, 1067, -735, 457, -252, 119, -45, 12,
+    0, 8, -36, 106, -239, 456, -769, 1174, -1652, 2175, -2743, 3587, 30098, 1539, -1861, 1722, -1423, 1073, -738, 457, -251, 118, -45, 12,
+    0, 8, -37, 106, -240, 457, -768, 1170, -1642, 2155, -2701, 3485, 30106, 1632, -1903, 1744, -1435, 1079, -740, 458, -251, 118, -45, 12,
+    0, 8, -37, 107, -240, 457, -767, 1166, -1632, 2134, -2660, 3384, 30114, 1726, -1945, 1767, -1447, 1084, -742, 458, -251, 117, -44, 11,
+    0, 9, -38, 108, -241, 457, -766, 1162, -1622, 2113, -2618, 3283, 30120, 1820, -1987, 1789, -1459, 1090, -744, 458, -250, 117, -44, 11,
+    0, 9, -38, 108, -242, 458, -765, 1158, -1612, 2092, -2576, 3182, 30126, 1915, -2030, 1811, -1470, 1095, -746, 459, -250, 116, -43, 11,
+    0, 9, -39, 109, -243, 458, -764, 1154, -1602, 2071, -2534, 3082, 30131, 2009, -2072, 1833, -1482, 1101, -747, 459, -249, 116, -43, 11,
+    -1, 9, -39, 110, -243, 458, -763, 1149, -1591, 2050, -2493, 2983, 30135, 2105, -2114, 1856, -1493, 1106, -749, 459, -249, 115, -43, 11,
+    -1, 9, -40, 110, -244, 458, -762, 1145, -1581, 2029, -2451, 2883, 30139, 2201, -2156, 1878, -1504, 1111, -751, 459, -248, 115, -42, 11,
+    -1, 10, -40, 111, -245, 459, -760, 1140, -1570, 2008, -2409, 2785, 30141, 2297, -2198, 1900, -1516, 1116, -753, 459, -248, 114, -42, 10,
+    -1, 10, -40, 112, -245, 459, -759, 1135, -1560, 1986, -2367, 2686, 30143, 2394, -2241, 1921, -1527, 1121, -754, 459, -247, 114, -41, 10,
+    -1, 10, -41, 113, -246, 459, -757, 1131, -1549, 1965, -2325, 2588, 30144, 2491, -2283, 1943, -1538, 1126, -756, 459, -247, 113, -41, 10,
+};
+
+// up 320, 48 taps, 90 dB from 0.52 fs_in, flat to 0.401 fs_in
+static const int16_t RS_UP320_HIGH[15360] = {
+    -1, 3, -6, 13, -22, 33, -46, 57, -61, 50, -17, -47, 150, -298, 495, -738, 1019, -1325, 1637, -1935, 2194, -2391, 2495, 30178, 2594, -2435, 2218, -1948, 1644, -1327, 1018, -735, 492, -295, 147, -44, -19, 51, -61, 58, -47, 34, -22, 12, -6, 3, -1, 0,
+    -1, 3, -6, 13, -22, 33, -46, 56, -60, 49, -15, -49, 153, -302, 498, -740, 1019, -1322, 1630, -1921, 2169, -2346, 2397, 30177, 2693, -2479, 2242, -1961, 1650, -1328, 1017, -733, 489, -292, 144, -42, -21, 53, -62, 58, -47, 34, -22, 12, -6, 3, -1, 0,
+    -1, 3, -6, 12, -22, 33, -46, 56, -59, 47, -13, -52, 156, -305, 501, -742, 1020, -1320, 1624, -1908, 2145, -2302, 2299, 30176, 2793, -2523, 2266, -1974, 1656, -1330, 1016, -731, 486, -289, 141, -39, -23, 54, -63, 59, -47, 34, -22, 12, -6, 3, -1, 0,
+    -1, 3, -6, 13, -22, 33, -45, 55, -58, 46, -11, -54, 159, -308, 504, -744, 1020, -1318, 1617, -1894, 2120, -2258, 2201, 30173, 2893, -2567, 2290, -1987, 1662, -1332, 1015, -728, 482, -285, 138, -37, -25, 55, -64, 59, -47, 34, -22, 13, -6, 3, -1, 0,
+    -1, 3, -6, 13, -22, 33, -45, 55, -57, 44, -10, -57, 162, -311, 507, -747, 1021, -1315, 1610, -1880, 2096, -2213, 2104, 30170, 2993, -2611, 2314, -2000, 1668, -1334, 1014, -725, 479, -282, 135, -34, -27, 57, -65, 60, -48, 34, -22, 12, -6, 3, -1, 0,
+    -1, 3, -6, 13, -21, 33, -45, 54, -56, 43, -8, -59, 164, -314, 510, -749, 1021, -1313, 1603, -1866, 2071, -2169, 2008, 30166, 3094, -2655, 2337, -2012, 1674, -1335, 1013, -723, 476, -279, 132, -32, -29, 58, -66, 60, -48, 34, -22, 13, -6, 3, -1, 0,
+    -1, 3, -6, 13, -22, 33, -45, 54, -55, 42, -6, -61, 167, -317, 513, -751, 1021, -1310, 1596, -1852, 2046, -2124, 1911, 30161, 3196, -2699, 2361, -2025, 1680, -1337, 1012, -720, 472, -275, 129, -29, -31, 59, -67, 61, -48, 34, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 33, -44, 53, -54, 40, -4, -64, 170, -320, 516, -752, 1022, -1307, 1588, -1838, 2021, -2080, 1816, 30155, 3297, -2743, 2384, -2037, 1685, -1338, 1010, -717, 469, -272, 126, -27, -33, 61, -68, 61, -48, 34, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 12, -21, 32, -44, 53, -53, 39, -2, -66, 173, -323, 518, -754, 1022, -1304, 1581, -1823, 1996, -2035, 1720, 30148, 3399, -2787, 2407, -2050, 1691, -1339, 1009, -714, 466, -268, 123, -24, -35, 62, -69, 62, -49, 34, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 32, -44, 52, -52, 38, 0, -69, 176, -326, 521, -756, 1022, -1301, 1573, -1809, 1970, -1991, 1625, 30141, 3502, -2830, 2430, -2062, 1696, -1340, 1007, -711, 462, -265, 119, -22, -36, 64, -69, 62, -49, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -21, 32, -43, 51, -51, 36, 2, -71, 178, -329, 524, -758, 1022, -1298, 1566, -1794, 1945, -1946, 1531, 30133, 3604, -2874, 2453, -2074, 1701, -1341, 1006, -708, 458, -261, 116, -19, -38, 65, -70, 63, -49, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 12, -21, 32, -43, 51, -50, 35, 4, -73, 181, -332, 526, -760, 1021, -1295, 1558, -1780, 1920, -1901, 1437, 30124, 3708, -2917, 2476, -2085, 1706, -1342, 1004, -705, 455, -258, 113, -17, -40, 66, -71, 63, -50, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 32, -43, 50, -49, 34, 6, -76, 184, -335, 529, -761, 1021, -1292, 1550, -1765, 1894, -1857, 1343, 30114, 3811, -2961, 2499, -2097, 1711, -1343, 1002, -702, 451, -254, 110, -14, -42, 68, -72, 64, -50, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 32, -42, 50, -49, 32, 7, -78, 187, -338, 531, -763, 1021, -1288, 1542, -1750, 1868, -1812, 1250, 30103, 3915, -3004, 2521, -2108, 1716, -1343, 1000, -699, 448, -251, 107, -11, -44, 69, -73, 64, -50, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 32, -42, 49, -48, 31, 9, -80, 189, -340, 534, -764, 1020, -1285, 1534, -1735, 1843, -1768, 1158, 30091, 4020, -3047, 2543, -2120, 1721, -1344, 998, -696, 444, -247, 104, -9, -46, 70, -74, 65, -50, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 31, -42, 49, -47, 29, 11, -83, 192, -343, 536, -765, 1020, -1281, 1526, -1720, 1817, -1723, 1065, 30079, 4124, -3090, 2565, -2131, 1725, -1344, 996, -692, 440, -243, 101, -6, -48, 72, -75, 65, -50, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 31, -41, 48, -46, 28, 13, -85, 195, -346, 539, -767, 1019, -1278, 1517, -1704, 1791, -1678, 974, 30066, 4229, -3133, 2587, -2142, 1730, -1344, 994, -689, 436, -240, 97, -4, -50, 73, -75, 66, -51, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 13, -21, 31, -41, 47, -45, 27, 15, -87, 197, -349, 541, -768, 1019, -1274, 1509, -1689, 1765, -1634, 882, 30052, 4335, -3176, 2609, -2153, 1734, -1345, 992, -685, 433, -236, 94, -1, -52, 74, -76, 66, -51, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -21, 31, -41, 47, -44, 25, 17, -90, 200, -351, 543, -769, 1018, -1270, 1500, -1674, 1739, -1589, 792, 30037, 4440, -3219, 2631, -2163, 1738, -1345, 990, -682, 429, -232, 91, 2, -54, 76, -77, 67, -51, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 12, -21, 31, -40, 46, -43, 24, 19, -92, 203, -354, 545, -770, 1017, -1266, 1492, -1658, 1713, -1544, 701, 30021, 4546, -3261, 2652, -2174, 1742, -1345, 987, -678, 425, -229, 88, 4, -56, 77, -78, 67, -51, 35, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 12, -21, 31, -40, 46, -42, 23, 20, -94, 205, -356, 547, -771, 1016, -1262, 1483, -1642, 1686, -1500, 612, 30005, 4653, -3304, 2673, -2184, 1746, -1345, 985, -675, 421, -225, 84, 7, -58, 78, -79, 68, -52, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -21, 30, -40, 45, -41, 21, 22, -96, 208, -359, 549, -772, 1015, -1258, 1474, -1626, 1660, -1455, 522, 29988, 4760, -3346, 2695, -2195, 1750, -1344, 982, -671, 417, -221, 81, 9, -60, 80, -79, 68, -52, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -21, 30, -39, 44, -40, 20, 24, -99, 210, -362, 552, -773, 1014, -1254, 1465, -1610, 1634, -1411, 433, 29969, 4867, -3388, 2716, -2205, 1753, -1344, 980, -667, 413, -217, 78, 12, -61, 81, -80, 68, -52, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -21, 30, -39, 44, -39, 18, 26, -101, 213, -364, 554, -774, 1013, -1249, 1456, -1594, 1607, -1366, 345, 29951, 4974, -3431, 2736, -2215, 1757, -1344, 977, -664, 409, -213, 75, 14, -63, 82, -81, 69, -52, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -20, 30, -39, 43, -38, 17, 28, -103, 215, -366, 556, -775, 1012, -1245, 1446, -1578, 1581, -1322, 257, 29931, 5082, -3472, 2757, -2224, 1760, -1343, 974, -660, 404, -209, 71, 17, -65, 83, -82, 69, -52, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -20, 30, -38, 43, -37, 16, 30, -105, 218, -369, 557, -776, 1010, -1240, 1437, -1562, 1554, -1277, 170, 29910, 5190, -3514, 2777, -2234, 1763, -1342, 971, -656, 400, -206, 68, 20, -67, 85, -83, 70, -53, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -6, 12, -20, 30, -38, 42, -36, 14, 31, -108, 220, -371, 559, -776, 1009, -1236, 1428, -1546, 1527, -1233, 83, 29889, 5298, -3556, 2798, -2243, 1766, -1341, 968, -652, 396, -202, 65, 22, -69, 86, -83, 70, -53, 36, -22, 12, -6, 2, 0, 0,
+    -1, 3, -6, 12, -20, 29, -38, 41, -35, 13, 33, -110, 223, -374, 561, -777, 1007, -1231, 1418, -1529, 1500, -1189, -3, 29867, 5407, -3597, 2818, -2252, 1769, -1341, 965, -648, 392, -198, 61, 25, -71, 87, -84, 71, -53, 36, -22, 12, -5, 2, 0, 0,
+    -1, 3, -7, 12, -20, 29, -37, 41, -34, 12, 35, -112, 225, -376, 563, -778, 1006, -1226, 1409, -1513, 1474, -1144, -89, 29844, 5516, -3639, 2838, -2262, 1772, -1340, 962, -644, 387, -194, 58, 28, -73, 89, -85, 71, -53, 36, -22, 12, -6, 2, -1, 0,
+    -1, 3, -7, 12, -20, 29, -37, 40, -33, 10, 37, -114, 227, -378, 565, -778, 1004, -1221, 1399, -1496, 1447, -1100, -174, 29820, 5625, -3680, 2857, -2271, 1775, -1339, 959, -639, 383, -190, 55, 30, -75, 90, -86, 71, -53, 36, -22, 12, -5, 2, -1, 0,
+    -1, 3, -7, 12, -20, 29, -37, 39, -32, 9, 39, -116, 230, -381, 566, -779, 1003, -1216, 1389, -1480, 1420, -1056, -259, 29795, 5735, -3721, 2877, -2279, 1777, -1337, 955, -635, 379, -186, 51, 33, -77, 91, -87, 72, -53, 36, -22, 12, -5, 2, 0, 0,
+    -1, 3, -7, 12, -20, 29, -36, 39, -31, 7, 40, -118, 232, -383, 568, -779, 1001, -1211, 1379, -1463, 1393, -1012, -343, 29770, 5845, -3762, 2896, -2288, 1780, -1336, 952, -631, 374, -182, 48, 36, -79, 92, -87, 72, -54, 36, -22, 12, -5, 2, 0, 0,
+    -1, 3, -7, 12, -20, 28, -36, 38, -30, 6, 42, -121, 234, -385, 569, -779, 999, -1206, 1369, -1446, 1366, -968, -427, 29744, 5955, -3803, 2915, -2296, 1782, -1334, 949, -626, 370, -178, 44, 38, -80, 94, -88, 73, -54, 36, -22, 12, -5, 2, 0, 0,
+    -1, 3, -7, 12, -20, 28, -35, 38, -30, 5, 44, -123, 237, -387, 571, -779, 997, -1200, 1359, -1429, 1339, -924, -511, 29717, 6065, -3843, 2934, -2304, 1784, -1333, 945, -622, 365, -174, 41, 41, -82, 95, -89, 73, -54, 36, -22, 12, -5, 2, -1, 0,
+    -1, 3, -7, 12, -20, 28, -35, 37, -29, 3, 46, -125, 239, -389, 572, -780, 995, -1195, 1349, -1412, 1312, -879, -593, 29689, 6176, -3884, 2953, -2312, 1786, -1331, 941, -618, 361, -169, 38, 43, -84, 96, -90, 73, -54, 36, -22, 12, -5, 2, 0, 0,
+    -1, 3, -6, 12, -20, 28, -35, 36, -28, 2, 47, -127, 241, -391, 574, -780, 993, -1189, 1339, -1395, 1284, -836, -676, 29660, 6287, -3924, 2972, -2320, 1787, -1329, 938, -613, 356, -165, 34, 46, -86, 97, -90, 74, -54, 36, -22, 12, -5, 2, 0, 0,
+    -1, 3, -7, 12, -20, 28, -34, 36, -27, 1, 49, -129, 243, -393, 575, -780, 990, -1184, 1328, -1378, 1257, -792, -757, 29631, 6399, -3964, 2990, -2328, 1789, -1327, 934, -609, 352, -161, 31, 49, -88, 99, -91, 74, -54, 36, -22, 11, -5, 2, 0, 0,
+    -1, 3, -6, 12, -19, 27, -34, 35, -26, -1, 51, -131, 246, -395, 577, -780, 988, -1178, 1318, -1360, 1230, -748, -838, 29600, 6510, -4004, 3008, -2335, 1790, -1325, 930, -604, 347, -157, 27, 51, -90, 100, -92, 75, -55, 36, -22, 11, -5, 2, 0, 0,
+    -1, 3, -7, 12, -19, 27, -33, 34, -25, -2, 53, -133, 248, -397, 578, -780, 986, -1173, 1307, -1343, 1203, -704, -919, 29569, 6622, -4043, 3026, -2343, 1792, -1323, 926, -599, 343, -153, 24, 54, -92, 101, -93, 75, -55, 36, -22, 11, -5, 2, 0, 0,
+    -1, 3, -6, 12, -19, 27, -33, 34, -24, -3, 54, -135, 250, -399, 579, -779, 983, -1167, 1296, -1325, 1175, -661, -999, 29538, 6734, -4083, 3044, -2350, 1793, -1321, 922, -594, 338, -149, 20, 57, -94, 102, -93, 75, -55, 36, -22, 11, -5, 2, 0, 0,
+    -1, 3, -6, 12, -19, 27, -33, 33, -23, -5, 56, -137, 252, -401, 580, -779, 981, -1161, 1286, -1308, 1148, -617, -1079, 29505, 6847, -4122, 3061, -2357, 1794, -1319, 918, -590, 333, -144, 17, 59, -96, 104, -94, 76, -55, 36, -22, 11, -5, 2, 0, 0,
+    -1, 3, -7, 12, -19, 27, -32, 33, -22, -6, 58, -139, 254, -403, 581, -779, 978, -1155, 1275, -1290, 1120, -574, -1158, 29472, 6959, -4161, 3079, -2364, 1795, -1316, 914, -585, 328, -140, 13, 62, -97, 105, -95, 76, -55, 36, -22, 11, -5, 2, 0, 0,
+    -1, 3, -7, 12, -19, 26, -32, 32, -21, -7, 59, -141, 256, -405, 582, -779, 976, -1149, 1264, -1273, 1093, -530, -1236, 29437, 7072, -4200, 3096, -2370, 1796, -1313, 909, -580, 323, -136, 10, 65, -99, 106, -95, 76, -55, 36, -21, 11, -5, 2, 0, 0,
+    -1, 3, -7, 12, -19, 26, -32, 31, -20, -9, 61, -143, 258, -407, 584, -778, 973, -1143, 1253, -1255, 1066, -487, -1314, 29402, 7185, -4238, 3113, -2377, 1796, -1311, 905, -575, 319, -132, 7, 67, -101, 107, -96, 77, -55, 36, -21, 11, -5, 2, 0, 0,
+    -1, 3, -6, 12, -19, 26, -31, 31, -19, -10, 63, -145, 260, -408, 584, -778, 970, -1136, 1242, -1237, 1038, -444, -1392, 29367, 7298, -4277, 3129, -2383, 1797, -1308, 900, -570, 314, -127, 3, 70, -103, 108, -97, 77, -56, 36, -21, 11, -5, 2, 0, 0,
+    -1, 3, -7, 12, -19, 26, -31, 30, -18, -11, 64, -147, 262, -410, 585, -777, 967, -1130, 1231, -1219, 1011, -401, -1469, 29330, 7412, -4315, 3146, -2389, 1797, -1305, 896, -565, 309, -123, 0, 72, -105, 110, -97, 77, -56, 36, -21, 11, -5, 2, 0, 0,
+    -1, 3, -6, 12, -18, 26, -30, 29, -17, -13, 66, -149, 264, -412, 586, -776, 964, -1124, 1219, -1201, 983, -358, -1545, 29293, 7526, -4353, 3162, -2395, 1797, -1302, 891, -560, 304, -119, -4, 75, -107, 111, -98, 78, -56, 36, -21, 11, -5, 2, 0, 0,
+    -1, 3, -6, 12, -18, 25, -30, 29, -16, -14, 68, -151, 266, -413, 587, -776, 961, -1117, 1208, -1183, 955, -315, -1621, 29254, 7640, -4391, 3178, -2401, 1797, -1299, 886, -554, 299, -114, -7, 78, -109, 112, -99, 78, -56, 36, -21, 11, -5, 2, 0, 0,
+    -1, 3, -7, 12, -18, 25, -30, 28, -15, -15, 69, -153, 268, -415, 588, -775, 958, -1110, 1197, -1165, 928, -272, -1696, 29215, 7754, -4428, 3194, -2406, 1797, -1296, 882, -549, 294, -110, -11, 80, -110, 113, -99, 78, -56, 36, -21, 11, -5, 1, 0, 0,
+    -1, 3, -7, 12, -18, 25, -29, 27, -14, -17, 71, -154, 270, -417, 589, -774, 955, -1104, 1185, -1147, 900, -229, -1771, 29176, 7869, -4466, 3210, -2412, 1797, -1292, 877, -544, 289, -106, -15, 83, -112, 114, -100, 79, -56, 36, -21, 11, -5, 1, 0, 0,
+    -1, 3, -6, 12, -18, 25, -29, 27, -13, -18, 73, -156, 272, -418, 589, -773, 952, -1097, 1173, -1129, 873, -187, -1845, 29135, 7983, -4503, 3225, -2417, 1796, -1289, 872, -539, 284, -101, -18, 86, -114, 115, -101, 79, -56, 36, -21, 11, -5, 1, 0, 0,
+    -1, 3, -6, 12, -18, 24, -28, 26, -12, -19, 74, -158, 274, -420, 590, -773, 948, -1090, 1162, -1111, 845, -144, -1918, 29094, 8098, -4539, 3240, -2422, 1796, -1285, 867, -533, 279, -97, -22, 88, -116, 116, -101, 79, -56, 36, -21, 11, -5, 1, 0, 0,
+    -1, 3, -6, 12, -18, 24, -28, 25, -11, -20, 76, -160, 275, -421, 590, -772, 945, -1083, 1150, -1092, 817, -102, -1991, 29052, 8213, -4576, 3255, -2427, 1795, -1281, 862, -528, 274, -93, -25, 91, -118, 118, -102, 79, -56, 36, -21, 11, -4, 1, 0, 0,
+    -1, 3, -6, 11, -18, 24, -28, 25, -10, -22, 77, -162, 277, -422, 591, -770, 941, -1076, 1138, -1074, 790, -60, -2064, 29009, 8329, -4612, 3270, -2431, 1794, -1277, 857, -522, 268, -88, -29, 93, -119, 119, -103, 80, -56, 36, -21, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -18, 24, -27, 24, -9, -23, 79, -163, 279, -424, 592, -769, 938, -1069, 1126, -1055, 762, -18, -2136, 28966, 8444, -4648, 3284, -2436, 1793, -1274, 851, -517, 263, -84, -32, 96, -121, 120, -103, 80, -56, 36, -21, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -18, 24, -27, 23, -8, -24, 81, -165, 281, -425, 592, -768, 934, -1062, 1114, -1037, 735, 24, -2207, 28921, 8560, -4684, 3298, -2440, 1792, -1270, 846, -511, 258, -79, -36, 99, -123, 121, -104, 80, -56, 36, -21, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 23, -26, 23, -7, -26, 82, -167, 282, -426, 592, -767, 930, -1055, 1102, -1018, 707, 66, -2278, 28876, 8676, -4720, 3312, -2444, 1791, -1265, 841, -505, 253, -75, -39, 101, -125, 122, -104, 81, -57, 36, -21, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 23, -26, 22, -6, -27, 84, -169, 284, -428, 593, -766, 927, -1048, 1090, -1000, 679, 108, -2348, 28830, 8792, -4755, 3326, -2448, 1789, -1261, 835, -500, 248, -70, -43, 104, -126, 123, -105, 81, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 23, -26, 22, -6, -28, 85, -171, 286, -429, 593, -764, 923, -1040, 1078, -981, 652, 149, -2417, 28784, 8908, -4790, 3340, -2451, 1787, -1257, 829, -494, 242, -66, -46, 106, -128, 124, -106, 81, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 23, -25, 21, -5, -29, 87, -172, 287, -430, 593, -763, 919, -1033, 1066, -963, 624, 190, -2486, 28736, 9024, -4825, 3353, -2455, 1786, -1252, 824, -488, 237, -61, -50, 109, -130, 125, -106, 81, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 22, -25, 20, -4, -31, 88, -174, 289, -431, 593, -761, 915, -1025, 1054, -944, 597, 232, -2555, 28688, 9141, -4859, 3366, -2458, 1784, -1248, 818, -482, 231, -57, -53, 112, -132, 126, -107, 82, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 22, -24, 20, -3, -32, 90, -176, 291, -432, 593, -760, 911, -1018, 1041, -925, 569, 273, -2623, 28639, 9257, -4894, 3379, -2461, 1782, -1243, 812, -476, 226, -52, -57, 114, -134, 128, -107, 82, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 22, -24, 19, -2, -33, 91, -177, 292, -434, 594, -758, 907, -1010, 1029, -906, 541, 314, -2690, 28590, 9374, -4928, 3391, -2464, 1779, -1238, 806, -470, 221, -48, -61, 117, -135, 129, -108, 82, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -17, 22, -24, 18, -1, -34, 93, -179, 294, -435, 594, -757, 903, -1002, 1016, -888, 514, 355, -2757, 28539, 9491, -4961, 3403, -2466, 1777, -1233, 800, -464, 215, -43, -64, 119, -137, 130, -108, 82, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 21, -23, 18, 0, -36, 94, -180, 295, -435, 594, -755, 898, -994, 1004, -869, 486, 395, -2823, 28488, 9608, -4995, 3416, -2469, 1774, -1228, 794, -458, 210, -38, -68, 122, -139, 131, -109, 82, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 21, -23, 17, 1, -37, 96, -182, 297, -437, 593, -753, 894, -987, 991, -850, 459, 436, -2888, 28436, 9725, -5028, 3427, -2471, 1772, -1223, 788, -452, 204, -34, -71, 125, -140, 132, -110, 83, -57, 36, -20, 10, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 21, -22, 16, 2, -38, 97, -184, 298, -437, 593, -751, 890, -979, 979, -831, 431, 476, -2953, 28384, 9843, -5061, 3439, -2473, 1769, -1218, 782, -446, 199, -29, -75, 127, -142, 133, -110, 83, -57, 35, -20, 9, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 21, -22, 16, 3, -39, 99, -185, 300, -438, 593, -749, 885, -971, 966, -812, 404, 516, -3018, 28330, 9960, -5093, 3450, -2475, 1766, -1212, 776, -440, 193, -25, -78, 130, -144, 134, -111, 83, -57, 35, -20, 9, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 21, -21, 15, 4, -40, 100, -187, 301, -439, 593, -747, 881, -963, 953, -793, 377, 556, -3082, 28276, 10078, -5125, 3461, -2477, 1763, -1207, 769, -434, 188, -20, -82, 132, -145, 135, -111, 83, -57, 35, -20, 9, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 20, -21, 14, 5, -42, 102, -188, 302, -440, 593, -746, 876, -954, 940, -774, 349, 596, -3145, 28221, 10196, -5157, 3472, -2478, 1759, -1201, 763, -427, 182, -15, -85, 135, -147, 136, -112, 83, -57, 35, -19, 9, -4, 1, 0, 0,
+    -1, 3, -6, 11, -16, 20, -21, 14, 6, -43, 103, -190, 304, -441, 592, -743, 871, -946, 927, -755, 322, 636, -3207, 28166, 10313, -5189, 3482, -2479, 1756, -1196, 757, -421, 176, -11, -89, 137, -149, 137, -112, 84, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 11, -16, 20, -20, 13, 6, -44, 104, -191, 305, -442, 592, -741, 867, -938, 914, -736, 295, 675, -3270, 28110, 10431, -5220, 3493, -2480, 1752, -1190, 750, -415, 171, -6, -92, 140, -151, 138, -113, 84, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 11, -15, 19, -20, 12, 7, -45, 106, -193, 306, -442, 592, -739, 862, -930, 901, -717, 267, 715, -3331, 28053, 10549, -5251, 3503, -2481, 1749, -1184, 743, -408, 165, -2, -96, 142, -152, 139, -113, 84, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 10, -15, 19, -19, 12, 8, -46, 107, -194, 307, -443, 591, -737, 857, -921, 888, -697, 240, 754, -3392, 27995, 10668, -5281, 3512, -2482, 1745, -1178, 737, -402, 159, 3, -100, 145, -154, 140, -114, 84, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 10, -15, 19, -19, 11, 9, -48, 109, -196, 309, -444, 591, -735, 852, -913, 875, -678, 213, 793, -3452, 27936, 10786, -5312, 3522, -2482, 1741, -1172, 730, -395, 154, 8, -103, 147, -155, 140, -114, 84, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 10, -15, 19, -19, 10, 10, -49, 110, -197, 310, -444, 590, -732, 847, -904, 862, -659, 186, 832, -3512, 27877, 10904, -5342, 3531, -2482, 1737, -1165, 723, -389, 148, 12, -107, 150, -157, 141, -114, 84, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 10, -15, 19, -18, 10, 11, -50, 111, -198, 311, -445, 590, -730, 842, -896, 849, -640, 159, 870, -3571, 27817, 11022, -5371, 3540, -2482, 1732, -1159, 716, -382, 142, 17, -110, 152, -159, 142, -115, 85, -57, 35, -19, 9, -3, 1, 0, 0,
+    -1, 3, -6, 10, -15, 18, -18, 9, 12, -51, 113, -200, 312, -445, 589, -727, 837, -887, 836, -621, 132, 909, -3629, 27757, 11141, -5401, 3548, -2482, 1728, -1153, 709, -375, 136, 22, -114, 155, -160, 143, -115, 85, -57, 34, -19, 9, -3, 0, 0, 0,
+    -1, 3, -6, 10, -15, 18, -17, 9, 13, -52, 114, -201, 313, -446, 588, -725, 832, -878, 822, -601, 105, 947, -3687, 27695, 11260, -5430, 3557, -2482, 1723, -1146, 702, -369, 131, 26, -117, 157, -162, 144, -116, 85, -57, 34, -18, 8, -3, 1, 0, 0,
+    -1, 3, -6, 10, -15, 18, -17, 8, 14, -53, 115, -203, 314, -446, 588, -722, 827, -870, 809, -582, 78, 985, -3744, 27633, 11378, -5459, 3565, -2481, 1718, -1139, 695, -362, 125, 31, -121, 160, -163, 145, -116, 85, -57, 34, -18, 8, -3, 0, 0, 0,
+    -1, 3, -6, 10, -14, 17, -16, 7, 15, -54, 117, -204, 315, -446, 587, -720, 822, -861, 795, -563, 51, 1023, -3801, 27571, 11497, -5487, 3573, -2481, 1713, -1133, 688, -355, 119, 36, -124, 162, -165, 146, -117, 85, -57, 34, -18, 8, -3, 0, 0, 0,
+    -1, 3, -6, 10, -14, 17, -16, 7, 16, -56, 118, -205, 316, -447, 586, -717, 816, -852, 782, -544, 24, 1061, -3857, 27507, 11616, -5515, 3580, -2480, 1708, -1126, 681, -348, 113, 41, -128, 165, -166, 147, -117, 85, -57, 34, -18, 8, -3, 0, 0, 0,
+    -1, 3, -6, 10, -14, 17, -16, 6, 16, -57, 119, -206, 317, -447, 585, -714, 811, -843, 769, -524, -3, 1098, -3913, 27443, 11734, -5542, 3588, -2478, 1703, -1119, 673, -342, 107, 45, -131, 167, -168, 148, -117, 85, -56, 34, -18, 8, -3, 0, 0, 0,
+    -1, 3, -6, 10, -14, 17, -15, 5, 17, -58, 121, -208, 318, -447, 584, -711, 805, -834, 755, -505, -30, 1135, -3967, 27379, 11853, -5570, 3595, -2477, 1698, -1112, 666, -335, 101, 50, -135, 170, -170, 149, -118, 85, -56, 34, -18, 8, -3, 0, 0, 0,
+    -1, 3, -6, 10, -14, 16, -15, 5, 18, -59, 122, -209, 319, -448, 583, -708, 800, -825, 742, -486, -56, 1172, -4022, 27313, 11972, -5597, 3601, -2475, 1692, -1104, 658, -328, 95, 55, -138, 172, -171, 149, -118, 85, -56, 34, -18, 8, -2, 0, 0, 0,
+    -1, 3, -6, 10, -14, 16, -14, 4, 19, -60, 123, -210, 320, -448, 582, -706, 794, -816, 728, -467, -83, 1209, -4075, 27247, 12091, -5623, 3608, -2473, 1686, -1097, 651, -321, 89, 59, -142, 174, -173, 150, -118, 86, -56, 34, -18, 8, -2, 0, 0, 0,
+    -1, 3, -6, 10, -14, 16, -14, 3, 20, -61, 124, -211, 321, -448, 581, -703, 789, -807, 714, -447, -110, 1246, -4129, 27180, 12210, -5649, 3614, -2471, 1681, -1090, 643, -314, 83, 64, -145, 177, -174, 151, -119, 86, -56, 33, -18, 8, -2, 0, 0, 0,
+    -1, 3, -6, 9, -13, 16, -13, 3, 21, -62, 125, -213, 322, -448, 580, -700, 783, -798, 700, -428, -136, 1282, -4181, 27112, 12329, -5675, 3620, -2469, 1675, -1082, 636, -307, 77, 69, -149, 179, -176, 152, -119, 86, -56, 33, -17, 7, -2, 0, 0, 0,
+    -1, 3, -6, 9, -13, 15, -13, 2, 22, -63, 127, -214, 323, -448, 579, -697, 777, -788, 687, -409, -162, 1318, -4233, 27044, 12448, -5701, 3625, -2467, 1668, -1075, 628, -300, 72, 74, -152, 182, -177, 153, -120, 86, -56, 33, -17, 7, -2, 0, 0, 0,
+    -1, 3, -6, 9, -13, 15, -13, 2, 23, -64, 128, -215, 324, -448, 578, -693, 771, -779, 673, -389, -189, 1354, -4284, 26975, 12567, -5726, 3631, -2464, 1662, -1067, 620, -293, 66, 78, -156, 184, -179, 153, -120, 86, -56, 33, -17, 7, -2, 0, 0, 0,
+    -1, 3, -6, 9, -13, 15, -12, 1, 23, -65, 129, -216, 324, -448, 576, -690, 766, -770, 659, -370, -215, 1390, -4335, 26906, 12686, -5751, 3636, -2461, 1656, -1059, 612, -286, 60, 83, -159, 186, -180, 154, -120, 86, -56, 33, -17, 7, -2, 0, 0, 0,
+    -1, 3, -6, 9, -13, 15, -12, 0, 24, -67, 130, -217, 325, -449, 575, -687, 760, -760, 646, -351, -241, 1426, -4385, 26836, 12805, -5775, 3640, -2458, 1649, -1052, 604, -278, 54, 88, -163, 189, -181, 155, -120, 86, -56, 33, -17, 7, -2, 0, 0, 0,
+    -1, 3, -6, 9, -13, 14, -11, 0, 25, -68, 131, -218, 326, -448, 574, -684, 754, -751, 632, -332, -267, 1461, -4434, 26765, 12924, -5799, 3645, -2455, 1642, -1044, 596, -271, 48, 92, -166, 191, -183, 156, -121, 86, -56, 33, -17, 7, -2, 0, 1, 0,
+    -1, 3, -6, 9, -13, 14, -11, -1, 26, -69, 133, -219, 327, -448, 572, -681, 748, -741, 618, -312, -293, 1496, -4483, 26693, 13043, -5822, 3649, -2451, 1636, -1035, 588, -264, 41, 97, -170, 193, -184, 156, -121, 86, -56, 32, -17, 7, -2, 0, 1, 0,
+    -1, 3, -6, 9, -12, 14, -11, -2, 27, -70, 134, -220, 327, -448, 571, -677, 742, -732, 604, -293, -319, 1531, -4531, 26621, 13161, -5846, 3653, -2448, 1629, -1027, 580, -257, 35, 102, -173, 196, -186, 157, -121, 86, -55, 32, -16, 7, -2, 0, 0, 0,
+    -1, 3, -6, 9, -12, 13, -10, -2, 28, -71, 135, -221, 328, -448, 569, -674, 736, -722, 590, -274, -345, 1566, -4579, 26548, 13280, -5868, 3657, -2444, 1621, -1019, 572, -249, 29, 107, -177, 198, -187, 158, -122, 86, -55, 32, -16, 7, -2, 0, 0, 0,
+    -1, 3, -5, 9, -12, 13, -10, -3, 29, -72, 136, -222, 329, -448, 568, -670, 729, -713, 576, -255, -371, 1600, -4626, 26475, 13399, -5891, 3660, -2440, 1614, -1011, 564, -242, 23, 111, -180, 200, -188, 159, -122, 86, -55, 32, -16, 7, -2, 0, 1, 0,
+    -1, 3, -5, 9, -12, 13, -9, -3, 29, -73, 137, -223, 329, -448, 566, -667, 723, -703, 562, -235, -397, 1634, -4672, 26401, 13518, -5913, 3663, -2435, 1607, -1002, 556, -235, 17, 116, -183, 202, -190, 159, -122, 86, -55, 32, -16, 6, -2, 0, 1, 0,
+    -1, 3, -6, 9, -12, 13, -9, -4, 30, -74, 138, -224, 330, -448, 565, -663, 717, -693, 548, -216, -422, 1668, -4718, 26326, 13637, -5934, 3666, -2431, 1599, -994, 547, -227, 11, 121, -187, 205, -191, 160, -122, 86, -55, 31, -16, 6, -2, 0, 1, 0,
+    -1, 3, -5, 9, -12, 12, -8, -5, 31, -75, 139, -225, 330, -447, 563, -660, 711, -684, 534, -197, -448, 1702, -4763, 26251, 13756, -5955, 3668, -2426, 1591, -985, 539, -220, 5, 126, -190, 207, -193, 161, -123, 86, -55, 31, -16, 6, -1, 0, 1, 0,
+    -1, 3, -5, 9, -12, 12, -8, -5, 32, -76, 140, -226, 331, -447, 561, -656, 704, -674, 520, -178, -473, 1736, -4808, 26175, 13875, -5976, 3670, -2421, 1583, -976, 530, -212, -1, 130, -194, 209, -194, 161, -123, 86, -55, 31, -15, 6, -1, 0, 1, 0,
+    -1, 3, -5, 8, -11, 12, -8, -6, 33, -77, 141, -227, 331, -446, 560, -652, 698, -664, 506, -159, -499, 1769, -4852, 26098, 13993, -5997, 3672, -2416, 1575, -967, 522, -205, -7, 135, -197, 211, -195, 162, -123, 86, -54, 31, -15, 6, -1, -1, 1, 0,
+    -1, 3, -5, 8, -11, 12, -7, -7, 33, -78, 142, -228, 332, -446, 558, -648, 691, -654, 492, -140, -524, 1802, -4895, 26021, 14112, -6017, 3673, -2411, 1567, -958, 513, -198, -14, 140, -200, 214, -196, 163, -123, 86, -54, 31, -15, 6, -1, -1, 1, 0,
+    -1, 3, -5, 8, -11, 11, -7, -7, 34, -79, 143, -229, 332, -446, 556, -645, 685, -644, 478, -121, -549, 1835, -4938, 25943, 14231, -6036, 3675, -2405, 1559, -949, 505, -190, -20, 144, -204, 216, -198, 163, -123, 86, -54, 31, -15, 6, -1, 0, 1, 0,
+    -1, 3, -5, 8, -11, 11, -6, -8, 35, -79, 144, -229, 332, -445, 554, -641, 678, -634, 464, -101, -574, 1867, -4980, 25864, 14349, -6055, 3676, -2399, 1550, -940, 496, -182, -26, 149, -207, 218, -199, 164, -124, 86, -54, 30, -15, 6, -1, -1, 1, 0,
+    -1, 3, -5, 8, -11, 11, -6, -8, 36, -80, 145, -230, 333, -445, 552, -637, 672, -624, 450, -82, -599, 1899, -5021, 25785, 14468, -6074, 3676, -2393, 1542, -931, 487, -175, -32, 154, -210, 220, -200, 164, -124, 85, -54, 30, -15, 6, -1, -1, 1, 0,
+    -1, 3, -5, 8, -11, 11, -5, -9, 37, -81, 146, -231, 333, -444, 550, -633, 665, -614, 436, -63, -624, 1931, -5062, 25705, 14586, -6092, 3677, -2387, 1533, -922, 479, -167, -38, 158, -214, 222, -201, 165, -124, 85, -54, 30, -14, 5, -1, -1, 1, 0,
+    -1, 3, -5, 8, -10, 10, -5, -10, 37, -82, 147, -232, 333, -443, 548, -629, 658, -604, 421, -44, -648, 1963, -5102, 25625, 14704, -6110, 3677, -2381, 1524, -912, 470, -159, -44, 163, -217, 224, -203, 166, -124, 85, -53, 30, -14, 5, -1, -1, 1, 0,
+    -1, 3, -5, 8, -10, 10, -5, -10, 38, -83, 148, -233, 334, -443, 546, -625, 652, -594, 407, -26, -673, 1995, -5142, 25544, 14823, -6127, 3676, -2374, 1515, -903, 461, -152, -51, 168, -220, 227, -204, 166, -124, 85, -53, 30, -14, 5, -1, -1, 1, 0,
+    -1, 3, -5, 8, -10, 10, -4, -11, 39, -84, 149, -233, 334, -442, 544, -621, 645, -584, 393, -7, -698, 2026, -5181, 25462, 14941, -6144, 3676, -2367, 1506, -893, 452, -144, -57, 172, -224, 229, -205, 167, -124, 85, -53, 29, -14, 5, -1, -1, 1, 0,
+    -1, 3, -5, 8, -10, 10, -4, -11, 40, -85, 150, -234, 334, -441, 542, -617, 638, -574, 379, 12, -722, 2057, -5220, 25380, 15059, -6161, 3675, -2360, 1497, -883, 443, -136, -63, 177, -227, 231, -206, 167, -125, 85, -53, 29, -14, 5, -1, -1, 1, 0,
+    -1, 3, -5, 8, -10, 9, -3, -12, 40, -86, 151, -235, 334, -441, 540, -612, 631, -564, 365, 31, -746, 2088, -5257, 25298, 15177, -6177, 3674, -2353, 1487, -874, 434, -129, -69, 182, -230, 233, -207, 168, -125, 85, -53, 29, -14, 5, -1, -1, 1, 0,
+    -1, 3, -5, 8, -10, 9, -3, -13, 41, -87, 152, -236, 334, -440, 538, -608, 624, -553, 351, 50, -770, 2118, -5295, 25214, 15294, -6193, 3672, -2345, 1478, -864, 425, -121, -75, 186, -233, 235, -209, 168, -125, 85, -52, 29, -13, 5, 0, -1, 1, 0,
+    -1, 3, -5, 8, -10, 9, -2, -13, 42, -88, 152, -236, 335, -439, 536, -604, 618, -543, 336, 69, -795, 2148, -5331, 25130, 15412, -6208, 3670, -2338, 1468, -854, 416, -113, -82, 191, -236, 237, -210, 169, -125, 85, -52, 29, -13, 4, 0, -1, 1, -1,
+    -1, 3, -5, 7, -9, 9, -2, -14, 43, -89, 153, -237, 335, -438, 533, -600, 611, -533, 322, 87, -818, 2178, -5367, 25046, 15530, -6222, 3668, -2330, 1458, -844, 407, -105, -88, 196, -240, 239, -211, 169, -125, 85, -52, 28, -13, 4, 0, -1, 1, 0,
+    -1, 3, -5, 7, -9, 8, -2, -14, 44, -89, 154, -237, 335, -437, 531, -595, 604, -523, 308, 106, -842, 2208, -5403, 24961, 15647, -6237, 3666, -2322, 1448, -834, 397, -97, -94, 200, -243, 241, -212, 170, -125, 84, -52, 28, -13, 4, 0, -1, 1, 0,
+    -1, 3, -5, 7, -9, 8, -1, -15, 44, -90, 155, -238, 335, -437, 529, -591, 597, -512, 294, 125, -866, 2238, -5437, 24875, 15764, -6251, 3663, -2313, 1438, -824, 388, -90, -100, 205, -246, 243, -213, 170, -125, 84, -52, 28, -13, 4, 0, -1, 1, 0,
+    -1, 3, -5, 7, -9, 8, -1, -15, 45, -91, 156, -239, 335, -436, 526, -586, 589, -502, 280, 143, -890, 2267, -5472, 24789, 15882, -6264, 3660, -2305, 1427, -813, 379, -82, -106, 210, -249, 245, -214, 171, -125, 84, -51, 28, -13, 4, 0, -1, 1, -1,
+    -1, 3, -5, 7, -9, 7, 0, -16, 46, -92, 157, -239, 335, -435, 524, -582, 582, -492, 265, 162, -913, 2296, -5505, 24702, 15999, -6277, 3657, -2296, 1417, -803, 369, -74, -113, 214, -252, 247, -215, 171, -125, 84, -51, 27, -12, 4, 0, -1, 1, 0,
+    -1, 2, -5, 7, -9, 7, 0, -17, 46, -93, 157, -240, 335, -434, 521, -577, 575, -481, 251, 180, -936, 2324, -5538, 24615, 16116, -6289, 3653, -2287, 1407, -792, 360, -66, -119, 219, -255, 249, -216, 172, -125, 84, -51, 27, -12, 4, 0, -1, 1, 0,
+    -1, 2, -5, 7, -8, 7, 0, -17, 47, -94, 158, -240, 335, -433, 519, -573, 568, -471, 237, 199, -959, 2353, -5570, 24527, 16232, -6301, 3649, -2278, 1396, -782, 351, -58, -125, 223, -259, 251, -217, 172, -125, 84, -51, 27, -12, 4, 0, -1, 1, -1,
+    -1, 2, -5, 7, -8, 7, 1, -18, 48, -94, 159, -241, 335, -432, 516, -568, 561, -460, 223, 217, -983, 2381, -5602, 24439, 16349, -6313, 3645, -2269, 1385, -771, 341, -50, -131, 228, -262, 253, -218, 172, -125, 83, -50, 27, -12, 3, 0, -1, 1, -1,
+    -1, 2, -5, 7, -8, 6, 1, -18, 49, -95, 160, -241, 335, -430, 514, -564, 553, -450, 209, 236, -1005, 2409, -5633, 24350, 16465, -6324, 3640, -2259, 1374, -761, 331, -42, -138, 232, -265, 255, -219, 173, -125, 83, -50, 27, -12, 3, 0, -1, 1, -1,
+    -1, 2, -4, 7, -8, 6, 2, -19, 49, -96, 160, -242, 334, -429, 511, -559, 546, -439, 195, 254, -1028, 2436, -5664, 24260, 16581, -6334, 3635, -2249, 1363, -750, 322, -34, -144, 237, -268, 257, -220, 173, -125, 83, -50, 26, -11, 3, 0, -1, 1, 0,
+    -1, 2, -4, 7, -8, 6, 2, -19, 50, -97, 161, -242, 334, -428, 508, -554, 539, -429, 180, 272, -1051, 2463, -5694, 24170, 16698, -6344, 3630, -2240, 1352, -739, 312, -26, -150, 242, -271, 258, -221, 173, -125, 83, -49, 26, -11, 3, 1, -1, 1, -1,
+    -1, 2, -5, 7, -8, 6, 2, -20, 51, -97, 162, -242, 334, -427, 506, -549, 531, -418, 166, 290, -1074, 2490, -5723, 24079, 16813, -6354, 3625, -2229, 1340, -728, 303, -18, -156, 246, -274, 260, -222, 174, -125, 83, -49, 26, -11, 3, 1, -2, 1, -1,
+    -1, 2, -4, 7, -7, 5, 3, -21, 51, -98, 163, -243, 334, -426, 503, -545, 524, -408, 152, 309, -1096, 2517, -5752, 23988, 16929, -6363, 3619, -2219, 1329, -717, 293, -10, -162, 251, -277, 262, -223, 174, -125, 82, -49, 26, -11, 3, 1, -2, 1, -1,
+    -1, 2, -4, 6, -7, 5, 3, -21, 52, -99, 163, -243, 334, -424, 500, -540, 517, -397, 138, 327, -1118, 2543, -5780, 23897, 17045, -6371, 3613, -2208, 1317, -706, 283, -2, -169, 255, -280, 264, -224, 174, -125, 82, -49, 25, -11, 3, 1, -2, 1, -1,
+    -1, 2, -4, 6, -7, 5, 4, -22, 53, -100, 164, -244, 333, -423, 497, -535, 509, -387, 124, 345, -1140, 2570, -5807, 23805, 17160, -6380, 3606, -2198, 1306, -695, 273, 6, -175, 260, -283, 266, -225, 175, -125, 82, -48, 25, -10, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -7, 5, 4, -22, 53, -100, 164, -244, 333, -422, 494, -530, 502, -376, 110, 363, -1162, 2595, -5834, 23712, 17275, -6387, 3600, -2187, 1294, -683, 263, 14, -181, 264, -286, 267, -226, 175, -125, 82, -48, 25, -10, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -7, 4, 5, -23, 54, -101, 165, -244, 333, -420, 492, -525, 494, -365, 96, 381, -1184, 2621, -5860, 23619, 17390, -6394, 3592, -2176, 1282, -672, 254, 22, -187, 268, -289, 269, -227, 175, -125, 81, -48, 24, -10, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -7, 4, 5, -23, 55, -102, 166, -244, 332, -419, 489, -520, 487, -355, 82, 398, -1206, 2646, -5886, 23525, 17505, -6401, 3585, -2164, 1270, -661, 244, 30, -193, 273, -292, 271, -227, 175, -125, 81, -48, 24, -10, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -6, 4, 5, -24, 55, -102, 166, -245, 332, -417, 486, -515, 479, -344, 67, 416, -1227, 2671, -5911, 23431, 17619, -6407, 3577, -2153, 1257, -649, 234, 38, -200, 277, -295, 273, -228, 176, -125, 81, -47, 24, -9, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -6, 3, 6, -24, 56, -103, 167, -245, 332, -416, 483, -510, 471, -334, 53, 434, -1249, 2696, -5936, 23336, 17734, -6413, 3569, -2141, 1245, -638, 224, 46, -206, 282, -298, 274, -229, 176, -124, 81, -47, 24, -9, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -6, 3, 6, -25, 57, -104, 167, -245, 331, -414, 480, -505, 464, -323, 39, 452, -1270, 2720, -5960, 23241, 17848, -6418, 3561, -2129, 1233, -626, 214, 54, -212, 286, -300, 276, -230, 176, -124, 80, -47, 23, -9, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -6, 3, 6, -25, 57, -104, 168, -245, 331, -413, 477, -500, 456, -312, 25, 469, -1291, 2744, -5983, 23145, 17961, -6423, 3552, -2117, 1220, -614, 204, 63, -218, 290, -303, 278, -231, 176, -124, 80, -46, 23, -9, 2, 1, -2, 1, -1,
+    -1, 2, -4, 6, -6, 3, 7, -26, 58, -105, 169, -246, 330, -411, 473, -495, 448, -302, 11, 487, -1312, 2768, -6006, 23049, 18075, -6427, 3543, -2104, 1207, -603, 194, 71, -224, 295, -306, 279, -231, 177, -124, 80, -46, 23, -9, 1, 2, -2, 1, -1,
+    -1, 2, -4, 6, -6, 2, 7, -26, 58, -106, 169, -246, 330, -410, 470, -489, 441, -291, -3, 504, -1333, 2792, -6028, 22953, 18188, -6430, 3534, -2092, 1194, -591, 184, 79, -230, 299, -309, 281, -232, 177, -124, 79, -46, 23, -8, 1, 2, -2, 1, -1,
+    -1, 2, -4, 6, -6, 2, 8, -27, 59, -106, 170, -246, 329, -408, 467, -484, 433, -280, -17, 521, -1353, 2815, -6049, 22856, 18301, -6433, 3524, -2079, 1181, -579, 173, 87, -237, 304, -312, 282, -233, 177, -124, 79, -45, 22, -8, 1, 2, -2, 1, -1,
+    -1, 2, -4, 5, -5, 2, 8, -27, 60, -107, 170, -246, 329, -407, 464, -479, 425, -270, -30, 539, -1374, 2838, -6070, 22758, 18414, -6436, 3514, -2066, 1168, -567, 163, 95, -243, 308, -314, 284, -234, 177, -124, 79, -45, 22, -8, 1, 2, -2, 1, -1,
+    -1, 2, -4, 5, -5, 2, 8, -28, 60, -108, 170, -246, 328, -405, 461, -474, 417, -259, -44, 556, -1394, 2861, -6091, 22660, 18527, -6438, 3504, -2053, 1155, -555, 153, 103, -249, 312, -317, 286, -234, 177, -123, 79, -45, 22, -8, 1, 2, -2, 1, -1,
+    -1, 2, -4, 5, -5, 1, 9, -28, 61, -108, 171, -246, 327, -403, 457, -468, 410, -248, -58, 573, -1415, 2883, -6110, 22561, 18639, -6439, 3494, -2040, 1142, -543, 143, 111, -255, 316, -320, 287, -235, 177, -123, 78, -44, 21, -8, 1, 2, -2, 1, -1,
+    -1, 2, -4, 5, -5, 1, 9, -29, 61, -109, 171, -246, 327, -401, 454, -463, 402, -237, -72, 590, -1435, 2905, -6130, 22463, 18751, -6440, 3483, -2026, 1128, -531, 133, 120, -261, 321, -323, 288, -236, 177, -123, 78, -44, 21, -7, 0, 2, -2, 2, -1,
+    -1, 2, -4, 5, -5, 1, 9, -29, 62, -109, 172, -246, 326, -400, 451, -458, 394, -227, -86, 607, -1454, 2927, -6148, 22363, 18863, -6441, 3472, -2012, 1114, -519, 122, 128, -267, 325, -325, 290, -236, 177, -123, 77, -44, 21, -7, 0, 2, -2, 2, -1,
+    -1, 2, -4, 5, -5, 1, 10, -30, 63, -110, 172, -246, 325, -398, 447, -452, 386, -216, -100, 624, -1474, 2948, -6166, 22263, 18974, -6441, 3460, -1998, 1101, -506, 112, 136, -273, 329, -328, 291, -237, 178, -122, 77, -43, 20, -7, 0, 2, -2, 2, -1,
+    -1, 2, -4, 5, -4, 0, 10, -30, 63, -111, 173, -246, 325, -396, 444, -447, 378, -205, -113, 641, -1494, 2969, -6184, 22163, 19085, -6440, 3448, -1984, 1087, -494, 102, 144, -279, 333, -331, 293, -237, 177, -122, 77, -43, 20, -7, 0, 2, -2, 2, -1,
+    -1, 2, -4, 5, -4, 0, 11, -31, 64, -111, 173, -246, 324, -394, 440, -441, 370, -195, -127, 657, -1513, 2990, -6200, 22062, 19196, -6439, 3436, -1970, 1073, -482, 91, 152, -285, 337, -333, 294, -238, 178, -122, 76, -42, 20, -6, 0, 2, -2, 2, -1,
+    -1, 2, -4, 5, -4, 0, 11, -31, 64, -112, 173, -246, 323, -392, 437, -436, 362, -184, -141, 674, -1532, 3011, -6217, 21961, 19307, -6438, 3424, -1955, 1059, -469, 81, 160, -291, 341, -336, 296, -239, 178, -122, 76, -42, 20, -6, 0, 2, -2, 2, -1,
+    -1, 2, -4, 5, -4, 0, 11, -32, 65, -112, 174, -246, 322, -390, 433, -430, 354, -173, -155, 690, -1551, 3031, -6232, 21860, 19417, -6435, 3411, -1941, 1045, -457, 70, 168, -297, 346, -338, 297, -239, 178, -122, 76, -42, 19, -6, 0, 3, -3, 2, -1,
+    -1, 2, -3, 5, -4, -1, 12, -32, 65, -113, 174, -246, 321, -388, 430, -425, 346, -163, -168, 707, -1570, 3051, -6247, 21758, 19527, -6433, 3398, -1926, 1031, -444, 60, 177, -303, 350, -341, 298, -240, 178, -121, 75, -41, 19, -6, -1, 3, -3, 2, -1,
+    -1, 2, -3, 4, -4, -1, 12, -33, 66, -113, 174, -246, 321, -386, 426, -419, 338, -152, -182, 723, -1589, 3070, -6262, 21655, 19637, -6429, 3384, -1911, 1016, -431, 50, 185, -309, 354, -343, 300, -240, 178, -121, 75, -41, 19, -5, -1, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -1, 12, -33, 66, -114, 175, -246, 320, -384, 423, -414, 330, -141, -195, 740, -1607, 3090, -6276, 21552, 19746, -6425, 3371, -1895, 1002, -419, 39, 193, -315, 358, -346, 301, -241, 178, -121, 74, -41, 18, -5, -1, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -1, 13, -34, 67, -114, 175, -246, 319, -382, 419, -408, 322, -131, -209, 756, -1626, 3109, -6289, 21449, 19855, -6421, 3357, -1880, 987, -406, 29, 201, -321, 362, -348, 302, -241, 177, -120, 74, -40, 18, -5, -1, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -2, 13, -34, 67, -115, 175, -245, 318, -380, 416, -402, 314, -120, -222, 772, -1644, 3127, -6302, 21346, 19964, -6416, 3342, -1864, 972, -393, 18, 209, -327, 366, -351, 304, -241, 177, -120, 74, -40, 18, -5, -1, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -2, 14, -35, 68, -115, 175, -245, 317, -378, 412, -397, 306, -109, -236, 788, -1662, 3146, -6314, 21242, 20072, -6411, 3328, -1848, 958, -380, 8, 217, -333, 370, -353, 305, -242, 177, -120, 73, -39, 17, -5, -1, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -2, 14, -35, 68, -116, 176, -245, 316, -376, 408, -391, 298, -98, -249, 804, -1680, 3164, -6326, 21137, 20181, -6405, 3313, -1832, 943, -367, -3, 225, -339, 374, -356, 306, -242, 177, -119, 73, -39, 17, -4, -2, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -2, 14, -36, 69, -116, 176, -245, 315, -374, 405, -385, 290, -88, -262, 820, -1697, 3182, -6337, 21032, 20288, -6398, 3297, -1816, 928, -354, -13, 234, -345, 378, -358, 307, -243, 177, -119, 72, -39, 17, -4, -2, 3, -3, 2, -1,
+    -1, 2, -3, 4, -3, -3, 15, -36, 70, -116, 176, -245, 314, -372, 401, -380, 282, -77, -276, 835, -1715, 3199, -6347, 20927, 20396, -6391, 3282, -1800, 913, -341, -24, 242, -351, 382, -360, 308, -243, 177, -118, 72, -38, 16, -4, -2, 3, -3, 2, -1,
+    -1, 2, -3, 4, -2, -3, 15, -36, 70, -117, 176, -244, 313, -369, 397, -374, 274, -66, -289, 851, -1732, 3216, -6357, 20822, 20503, -6383, 3266, -1783, 897, -328, -35, 250, -357, 385, -363, 309, -243, 177, -118, 71, -38, 16, -4, -2, 3, -3, 2, -1,
+    -1, 2, -3, 4, -2, -3, 15, -37, 70, -117, 176, -244, 312, -367, 393, -368, 266, -56, -302, 866, -1749, 3233, -6366, 20715, 20609, -6375, 3250, -1766, 882, -315, -45, 258, -362, 389, -365, 311, -244, 177, -118, 71, -37, 15, -3, -2, 3, -3, 2, -1,
+    -1, 2, -3, 3, -2, -3, 15, -37, 71, -118, 177, -244, 311, -365, 389, -362, 258, -45, -315, 882, -1766, 3250, -6375, 20609, 20715, -6366, 3233, -1749, 866, -302, -56, 266, -368, 393, -367, 312, -244, 176, -117, 70, -37, 15, -3, -2, 4, -3, 2, -1,
+    -1, 2, -3, 3, -2, -4, 16, -38, 71, -118, 177, -243, 309, -363, 385, -357, 250, -35, -328, 897, -1783, 3266, -6383, 20503, 20822, -6357, 3216, -1732, 851, -289, -66, 274, -374, 397, -369, 313, -244, 176, -117, 70, -36, 15, -3, -2, 4, -3, 2, -1,
+    -1, 2, -3, 3, -2, -4, 16, -38, 72, -118, 177, -243, 308, -360, 382, -351, 242, -24, -341, 913, -1800, 3282, -6391, 20396, 20927, -6347, 3199, -1715, 835, -276, -77, 282, -380, 401, -372, 314, -245, 176, -116, 70, -36, 15, -3, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -2, -4, 17, -39, 72, -119, 177, -243, 307, -358, 378, -345, 234, -13, -354, 928, -1816, 3297, -6398, 20288, 21032, -6337, 3182, -1697, 820, -262, -88, 290, -385, 405, -374, 315, -245, 176, -116, 69, -36, 14, -2, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -2, -4, 17, -39, 73, -119, 177, -242, 306, -356, 374, -339, 225, -3, -367, 943, -1832, 3313, -6405, 20181, 21137, -6326, 3164, -1680, 804, -249, -98, 298, -391, 408, -376, 316, -245, 176, -116, 68, -35, 14, -2, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -1, -5, 17, -39, 73, -120, 177, -242, 305, -353, 370, -333, 217, 8, -380, 958, -1848, 3328, -6411, 20072, 21242, -6314, 3146, -1662, 788, -236, -109, 306, -397, 412, -378, 317, -245, 175, -115, 68, -35, 14, -2, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -1, -5, 18, -40, 74, -120, 177, -241, 304, -351, 366, -327, 209, 18, -393, 972, -1864, 3342, -6416, 19964, 21346, -6302, 3127, -1644, 772, -222, -120, 314, -402, 416, -380, 318, -245, 175, -115, 67, -34, 13, -2, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -1, -5, 18, -40, 74, -120, 177, -241, 302, -348, 362, -321, 201, 29, -406, 987, -1880, 3357, -6421, 19855, 21449, -6289, 3109, -1626, 756, -209, -131, 322, -408, 419, -382, 319, -246, 175, -114, 67, -34, 13, -1, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -1, -5, 18, -41, 74, -121, 178, -241, 301, -346, 358, -315, 193, 39, -419, 1002, -1895, 3371, -6425, 19746, 21552, -6276, 3090, -1607, 740, -195, -141, 330, -414, 423, -384, 320, -246, 175, -114, 66, -33, 12, -1, -3, 4, -3, 2, -1,
+    -1, 2, -3, 3, -1, -5, 19, -41, 75, -121, 178, -240, 300, -343, 354, -309, 185, 50, -431, 1016, -1911, 3384, -6429, 19637, 21655, -6262, 3070, -1589, 723, -182, -152, 338, -419, 426, -386, 321, -246, 174, -113, 66, -33, 12, -1, -4, 4, -3, 2, -1,
+    -1, 2, -3, 3, -1, -6, 19, -41, 75, -121, 178, -240, 298, -341, 350, -303, 177, 60, -444, 1031, -1926, 3398, -6433, 19527, 21758, -6247, 3051, -1570, 707, -168, -163, 346, -425, 430, -388, 321, -246, 174, -113, 65, -32, 12, -1, -4, 5, -3, 2, -1,
+    -1, 2, -3, 3, 0, -6, 19, -42, 76, -122, 178, -239, 297, -338, 346, -297, 168, 70, -457, 1045, -1941, 3411, -6435, 19417, 21860, -6232, 3031, -1551, 690, -155, -173, 354, -430, 433, -390, 322, -246, 174, -112, 65, -32, 11, 0, -4, 5, -4, 2, -1,
+    -1, 2, -2, 2, 0, -6, 20, -42, 76, -122, 178, -239, 296, -336, 341, -291, 160, 81, -469, 1059, -1955, 3424, -6438, 19307, 21961, -6217, 3011, -1532, 674, -141, -184, 362, -436, 437, -392, 323, -246, 173, -112, 64, -31, 11, 0, -4, 5, -4, 2, -1,
+    -1, 2, -2, 2, 0, -6, 20, -42, 76, -122, 178, -238, 294, -333, 337, -285, 152, 91, -482, 1073, -1970, 3436, -6439, 19196, 22062, -6200, 2990, -1513, 657, -127, -195, 370, -441, 440, -394, 324, -246, 173, -111, 64, -31, 11, 0, -4, 5, -4, 2, -1,
+    -1, 2, -2, 2, 0, -7, 20, -43, 77, -122, 177, -237, 293, -331, 333, -279, 144, 102, -494, 1087, -1984, 3448, -6440, 19085, 22163, -6184, 2969, -1494, 641, -113, -205, 378, -447, 444, -396, 325, -246, 173, -111, 63, -30, 10, 0, -4, 5, -4, 2, -1,
+    -1, 2, -2, 2, 0, -7, 20, -43, 77, -122, 178, -237, 291, -328, 329, -273, 136, 112, -506, 1101, -1998, 3460, -6441, 18974, 22263, -6166, 2948, -1474, 624, -100, -216, 386, -452, 447, -398, 325, -246, 172, -110, 63, -30, 10, 1, -5, 5, -4, 2, -1,
+    -1, 2, -2, 2, 0, -7, 21, -44, 77, -123, 177, -236, 290, -325, 325, -267, 128, 122, -519, 1114, -2012, 3472, -6441, 18863, 22363, -6148, 2927, -1454, 607, -86, -227, 394, -458, 451, -400, 326, -246, 172, -109, 62, -29, 9, 1, -5, 5, -4, 2, -1,
+    -1, 2, -2, 2, 0, -7, 21, -44, 78, -123, 177, -236, 288, -323, 321, -261, 120, 133, -531, 1128, -2026, 3483, -6440, 18751, 22463, -6130, 2905, -1435, 590, -72, -237, 402, -463, 454, -401, 327, -246, 171, -109, 61, -29, 9, 1, -5, 5, -4, 2, -1,
+    -1, 1, -2, 2, 1, -8, 21, -44, 78, -123, 177, -235, 287, -320, 316, -255, 111, 143, -543, 1142, -2040, 3494, -6439, 18639, 22561, -6110, 2883, -1415, 573, -58, -248, 410, -468, 457, -403, 327, -246, 171, -108, 61, -28, 9, 1, -5, 5, -4, 2, -1,
+    -1, 1, -2, 2, 1, -8, 22, -45, 79, -123, 177, -234, 286, -317, 312, -249, 103, 153, -555, 1155, -2053, 3504, -6438, 18527, 22660, -6091, 2861, -1394, 556, -44, -259, 417, -474, 461, -405, 328, -246, 170, -108, 60, -28, 8, 2, -5, 5, -4, 2, -1,
+    -1, 1, -2, 2, 1, -8, 22, -45, 79, -124, 177, -234, 284, -314, 308, -243, 95, 163, -567, 1168, -2066, 3514, -6436, 18414, 22758, -6070, 2838, -1374, 539, -30, -270, 425, -479, 464, -407, 329, -246, 170, -107, 60, -27, 8, 2, -5, 5, -4, 2, -1,
+    -1, 1, -2, 2, 1, -8, 22, -45, 79, -124, 177, -233, 282, -312, 304, -237, 87, 173, -579, 1181, -2079, 3524, -6433, 18301, 22856, -6049, 2815, -1353, 521, -17, -280, 433, -484, 467, -408, 329, -246, 170, -106, 59, -27, 8, 2, -6, 6, -4, 2, -1,
+    -1, 1, -2, 2, 1, -8, 23, -46, 79, -124, 177, -232, 281, -309, 299, -230, 79, 184, -591, 1194, -2092, 3534, -6430, 18188, 22953, -6028, 2792, -1333, 504, -3, -291, 441, -489, 470, -410, 330, -246, 169, -106, 58, -26, 7, 2, -6, 6, -4, 2, -1,
+    -1, 1, -2, 2, 1, -9, 23, -46, 80, -124, 177, -231, 279, -306, 295, -224, 71, 194, -603, 1207, -2104, 3543, -6427, 18075, 23049, -6006, 2768, -1312, 487, 11, -302, 448, -495, 473, -411, 330, -246, 169, -105, 58, -26, 7, 3, -6, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -9, 23, -46, 80, -124, 176, -231, 278, -303, 290, -218, 63, 204, -614, 1220, -2117, 3552, -6423, 17961, 23145, -5983, 2744, -1291, 469, 25, -312, 456, -500, 477, -413, 331, -245, 168, -104, 57, -25, 6, 3, -6, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -9, 23, -47, 80, -124, 176, -230, 276, -300, 286, -212, 54, 214, -626, 1233, -2129, 3561, -6418, 17848, 23241, -5960, 2720, -1270, 452, 39, -323, 464, -505, 480, -414, 331, -245, 167, -104, 57, -25, 6, 3, -6, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -9, 24, -47, 81, -124, 176, -229, 274, -298, 282, -206, 46, 224, -638, 1245, -2141, 3569, -6413, 17734, 23336, -5936, 2696, -1249, 434, 53, -334, 471, -510, 483, -416, 332, -245, 167, -103, 56, -24, 6, 3, -6, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -9, 24, -47, 81, -125, 176, -228, 273, -295, 277, -200, 38, 234, -649, 1257, -2153, 3577, -6407, 17619, 23431, -5911, 2671, -1227, 416, 67, -344, 479, -515, 486, -417, 332, -245, 166, -102, 55, -24, 5, 4, -6, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -10, 24, -48, 81, -125, 175, -227, 271, -292, 273, -193, 30, 244, -661, 1270, -2164, 3585, -6401, 17505, 23525, -5886, 2646, -1206, 398, 82, -355, 487, -520, 489, -419, 332, -244, 166, -102, 55, -23, 5, 4, -7, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -10, 24, -48, 81, -125, 175, -227, 269, -289, 268, -187, 22, 254, -672, 1282, -2176, 3592, -6394, 17390, 23619, -5860, 2621, -1184, 381, 96, -365, 494, -525, 492, -420, 333, -244, 165, -101, 54, -23, 5, 4, -7, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -10, 25, -48, 82, -125, 175, -226, 267, -286, 264, -181, 14, 263, -683, 1294, -2187, 3600, -6387, 17275, 23712, -5834, 2595, -1162, 363, 110, -376, 502, -530, 494, -422, 333, -244, 164, -100, 53, -22, 4, 5, -7, 6, -4, 2, -1,
+    -1, 1, -2, 1, 2, -10, 25, -48, 82, -125, 175, -225, 266, -283, 260, -175, 6, 273, -695, 1306, -2198, 3606, -6380, 17160, 23805, -5807, 2570, -1140, 345, 124, -387, 509, -535, 497, -423, 333, -244, 164, -100, 53, -22, 4, 5, -7, 6, -4, 2, -1,
+    -1, 1, -2, 1, 3, -11, 25, -49, 82, -125, 174, -224, 264, -280, 255, -169, -2, 283, -706, 1317, -2208, 3613, -6371, 17045, 23897, -5780, 2543, -1118, 327, 138, -397, 517, -540, 500, -424, 334, -243, 163, -99, 52, -21, 3, 5, -7, 6, -4, 2, -1,
+    -1, 1, -2, 1, 3, -11, 26, -49, 82, -125, 174, -223, 262, -277, 251, -162, -10, 293, -717, 1329, -2219, 3619, -6363, 16929, 23988, -5752, 2517, -1096, 309, 152, -408, 524, -545, 503, -426, 334, -243, 163, -98, 51, -21, 3, 5, -7, 7, -4, 2, -1,
+    -1, 1, -2, 1, 3, -11, 26, -49, 83, -125, 174, -222, 260, -274, 246, -156, -18, 303, -728, 1340, -2229, 3625, -6354, 16813, 24079, -5723, 2490, -1074, 290, 166, -418, 531, -549, 506, -427, 334, -242, 162, -97, 51, -20, 2, 6, -8, 7, -5, 2, -1,
+    -1, 1, -1, 1, 3, -11, 26, -49, 83, -125, 173, -221, 258, -271, 242, -150, -26, 312, -739, 1352, -2240, 3630, -6344, 16698, 24170, -5694, 2463, -1051, 272, 180, -429, 539, -554, 508, -428, 334, -242, 161, -97, 50, -19, 2, 6, -8, 7, -4, 2, -1,
+    0, 1, -1, 0, 3, -11, 26, -50, 83, -125, 173, -220, 257, -268, 237, -144, -34, 322, -750, 1363, -2249, 3635, -6334, 16581, 24260, -5664, 2436, -1028, 254, 195, -439, 546, -559, 511, -429, 334, -242, 160, -96, 49, -19, 2, 6, -8, 7, -4, 2, -1,
+    -1, 1, -1, 0, 3, -12, 27, -50, 83, -125, 173, -219, 255, -265, 232, -138, -42, 331, -761, 1374, -2259, 3640, -6324, 16465, 24350, -5633, 2409, -1005, 236, 209, -450, 553, -564, 514, -430, 335, -241, 160, -95, 49, -18, 1, 6, -8, 7, -5, 2, -1,
+    -1, 1, -1, 0, 3, -12, 27, -50, 83, -125, 172, -218, 253, -262, 228, -131, -50, 341, -771, 1385, -2269, 3645, -6313, 16349, 24439, -5602, 2381, -983, 217, 223, -460, 561, -568, 516, -432, 335, -241, 159, -94, 48, -18, 1, 7, -8, 7, -5, 2, -1,
+    -1, 1, -1, 0, 4, -12, 27, -51, 84, -125, 172, -217, 251, -259, 223, -125, -58, 351, -782, 1396, -2278, 3649, -6301, 16232, 24527, -5570, 2353, -959, 199, 237, -471, 568, -573, 519, -433, 335, -240, 158, -94, 47, -17, 0, 7, -8, 7, -5, 2, -1,
+    0, 1, -1, 0, 4, -12, 27, -51, 84, -125, 172, -216, 249, -255, 219, -119, -66, 360, -792, 1407, -2287, 3653, -6289, 16116, 24615, -5538, 2324, -936, 180, 251, -481, 575, -577, 521, -434, 335, -240, 157, -93, 46, -17, 0, 7, -9, 7, -5, 2, -1,
+    0, 1, -1, 0, 4, -12, 27, -51, 84, -125, 171, -215, 247, -252, 214, -113, -74, 369, -803, 1417, -2296, 3657, -6277, 15999, 24702, -5505, 2296, -913, 162, 265, -492, 582, -582, 524, -435, 335, -239, 157, -92, 46, -16, 0, 7, -9, 7, -5, 3, -1,
+    -1, 1, -1, 0, 4, -13, 28, -51, 84, -125, 171, -214, 245, -249, 210, -106, -82, 379, -813, 1427, -2305, 3660, -6264, 15882, 24789, -5472, 2267, -890, 143, 280, -502, 589, -586, 526, -436, 335, -239, 156, -91, 45, -15, -1, 8, -9, 7, -5, 3, -1,
+    0, 1, -1, 0, 4, -13, 28, -52, 84, -125, 170, -213, 243, -246, 205, -100, -90, 388, -824, 1438, -2313, 3663, -6251, 15764, 24875, -5437, 2238, -866, 125, 294, -512, 597, -591, 529, -437, 335, -238, 155, -90, 44, -15, -1, 8, -9, 7, -5, 3, -1,
+    0, 1, -1, 0, 4, -13, 28, -52, 84, -125, 170, -212, 241, -243, 200, -94, -97, 397, -834, 1448, -2322, 3666, -6237, 15647, 24961, -5403, 2208, -842, 106, 308, -523, 604, -595, 531, -437, 335, -237, 154, -89, 44, -14, -2, 8, -9, 7, -5, 3, -1,
+    0, 1, -1, 0, 4, -13, 28, -52, 85, -125, 169, -211, 239, -240, 196, -88, -105, 407, -844, 1458, -2330, 3668, -6222, 15530, 25046, -5367, 2178, -818, 87, 322, -533, 611, -600, 533, -438, 335, -237, 153, -89, 43, -14, -2, 9, -9, 7, -5, 3, -1,
+    -1, 1, -1, 0, 4, -13, 29, -52, 85, -125, 169, -210, 237, -236, 191, -82, -113, 416, -854, 1468, -2338, 3670, -6208, 15412, 25130, -5331, 2148, -795, 69, 336, -543, 618, -604, 536, -439, 335, -236, 152, -88, 42, -13, -2, 9, -10, 8, -5, 3, -1,
+    0, 1, -1, 0, 5, -13, 29, -52, 85, -125, 168, -209, 235, -233, 186, -75, -121, 425, -864, 1478, -2345, 3672, -6193, 15294, 25214, -5295, 2118, -770, 50, 351, -553, 624, -608, 538, -440, 334, -236, 152, -87, 41, -13, -3, 9, -10, 8, -5, 3, -1,
+    0, 1, -1, -1, 5, -14, 29, -53, 85, -125, 168, -207, 233, -230, 182, -69, -129, 434, -874, 1487, -2353, 3674, -6177, 15177, 25298, -5257, 2088, -746, 31, 365, -564, 631, -612, 540, -441, 334, -235, 151, -86, 40, -12, -3, 9, -10, 8, -5, 3, -1,
+    0, 1, -1, -1, 5, -14, 29, -53, 85, -125, 167, -206, 231, -227, 177, -63, -136, 443, -883, 1497, -2360, 3675, -6161, 15059, 25380, -5220, 2057, -722, 12, 379, -574, 638, -617, 542, -441, 334, -234, 150, -85, 40, -11, -4, 10, -10, 8, -5, 3, -1,
+    0, 1, -1, -1, 5, -14, 29, -53, 85, -124, 167, -205, 229, -224, 172, -57, -144, 452, -893, 1506, -2367, 3676, -6144, 14941, 25462, -5181, 2026, -698, -7, 393, -584, 645, -621, 544, -442, 334, -233, 149, -84, 39, -11, -4, 10, -10, 8, -5, 3, -1,
+    0, 1, -1, -1, 5, -14, 30, -53, 85, -124, 166, -204, 227, -220, 168, -51, -152, 461, -903, 1515, -2374, 3676, -6127, 14823, 25544, -5142, 1995, -673, -26, 407, -594, 652, -625, 546, -443, 334, -233, 148, -83, 38, -10, -5, 10, -10, 8, -5, 3, -1,
+    0, 1, -1, -1, 5, -14, 30, -53, 85, -124, 166, -203, 224, -217, 163, -44, -159, 470, -912, 1524, -2381, 3677, -6110, 14704, 25625, -5102, 1963, -648, -44, 421, -604, 658, -629, 548, -443, 333, -232, 147, -82, 37, -10, -5, 10, -10, 8, -5, 3, -1,
+    0, 1, -1, -1, 5, -14, 30, -54, 85, -124, 165, -201, 222, -214, 158, -38, -167, 479, -922, 1533, -2387, 3677, -6092, 14586, 25705, -5062, 1931, -624, -63, 436, -614, 665, -633, 550, -444, 333, -231, 146, -81, 37, -9, -5, 11, -11, 8, -5, 3, -1,
+    0, 1, -1, -1, 6, -15, 30, -54, 85, -124, 164, -200, 220, -210, 154, -32, -175, 487, -931, 1542, -2393, 3676, -6074, 14468, 25785, -5021, 1899, -599, -82, 450, -624, 672, -637, 552, -445, 333, -230, 145, -80, 36, -8, -6, 11, -11, 8, -5, 3, -1,
+    0, 1, -1, -1, 6, -15, 30, -54, 86, -124, 164, -199, 218, -207, 149, -26, -182, 496, -940, 1550, -2399, 3676, -6055, 14349, 25864, -4980, 1867, -574, -101, 464, -634, 678, -641, 554, -445, 332, -229, 144, -79, 35, -8, -6, 11, -11, 8, -5, 3, -1,
+    0, 1, 0, -1, 6, -15, 31, -54, 86, -123, 163, -198, 216, -204, 144, -20, -190, 505, -949, 1559, -2405, 3675, -6036, 14231, 25943, -4938, 1835, -549, -121, 478, -644, 685, -645, 556, -446, 332, -229, 143, -79, 34, -7, -7, 11, -11, 8, -5, 3, -1,
+    0, 1, -1, -1, 6, -15, 31, -54, 86, -123, 163, -196, 214, -200, 140, -14, -198, 513, -958, 1567, -2411, 3673, -6017, 14112, 26021, -4895, 1802, -524, -140, 492, -654, 691, -648, 558, -446, 332, -228, 142, -78, 33, -7, -7, 12, -11, 8, -5, 3, -1,
+    0, 1, -1, -1, 6, -15, 31, -54, 86, -123, 162, -195, 211, -197, 135, -7, -205, 522, -967, 1575, -2416, 3672, -5997, 13993, 26098, -4852, 1769, -499, -159, 506, -664, 698, -652, 560, -446, 331, -227, 141, -77, 33, -6, -8, 12, -11, 8, -5, 3, -1,
+    0, 1, 0, -1, 6, -15, 31, -55, 86, -123, 161, -194, 209, -194, 130, -1, -212, 530, -976, 1583, -2421, 3670, -5976, 13875, 26175, -4808, 1736, -473, -178, 520, -674, 704, -656, 561, -447, 331, -226, 140, -76, 32, -5, -8, 12, -12, 9, -5, 3, -1,
+    0, 1, 0, -1, 6, -16, 31, -55, 86, -123, 161, -193, 207, -190, 126, 5, -220, 539, -985, 1591, -2426, 3668, -5955, 13756, 26251, -4763, 1702, -448, -197, 534, -684, 711, -660, 563, -447, 330, -225, 139, -75, 31, -5, -8, 12, -12, 9, -5, 3, -1,
+    0, 1, 0, -2, 6, -16, 31, -55, 86, -122, 160, -191, 205, -187, 121, 11, -227, 547, -994, 1599, -2431, 3666, -5934, 13637, 26326, -4718, 1668, -422, -216, 548, -693, 717, -663, 565, -448, 330, -224, 138, -74, 30, -4, -9, 13, -12, 9, -6, 3, -1,
+    0, 1, 0, -2, 6, -16, 32, -55, 86, -122, 159, -190, 202, -183, 116, 17, -235, 556, -1002, 1607, -2435, 3663, -5913, 13518, 26401, -4672, 1634, -397, -235, 562, -703, 723, -667, 566, -448, 329, -223, 137, -73, 29, -3, -9, 13, -12, 9, -5, 3, -1,
+    0, 1, 0, -2, 7, -16, 32, -55, 86, -122, 159, -188, 200, -180, 111, 23, -242, 564, -1011, 1614, -2440, 3660, -5891, 13399, 26475, -4626, 1600, -371, -255, 576, -713, 729, -670, 568, -448, 329, -222, 136, -72, 29, -3, -10, 13, -12, 9, -5, 3, -1,
+    0, 0, 0, -2, 7, -16, 32, -55, 86, -122, 158, -187, 198, -177, 107, 29, -249, 572, -1019, 1621, -2444, 3657, -5868, 13280, 26548, -4579, 1566, -345, -274, 590, -722, 736, -674, 569, -448, 328, -221, 135, -71, 28, -2, -10, 13, -12, 9, -6, 3, -1,
+    0, 0, 0, -2, 7, -16, 32, -55, 86, -121, 157, -186, 196, -173, 102, 35, -257, 580, -1027, 1629, -2448, 3653, -5846, 13161, 26621, -4531, 1531, -319, -293, 604, -732, 742, -677, 571, -448, 327, -220, 134, -70, 27, -2, -11, 14, -12, 9, -6, 3, -1,
+    0, 1, 0, -2, 7, -17, 32, -56, 86, -121, 156, -184, 193, -170, 97, 41, -264, 588, -1035, 1636, -2451, 3649, -5822, 13043, 26693, -4483, 1496, -293, -312, 618, -741, 748, -681, 572, -448, 327, -219, 133, -69, 26, -1, -11, 14, -13, 9, -6, 3, -1,
+    0, 1, 0, -2, 7, -17, 33, -56, 86, -121, 156, -183, 191, -166, 92, 48, -271, 596, -1044, 1642, -2455, 3645, -5799, 12924, 26765, -4434, 1461, -267, -332, 632, -751, 754, -684, 574, -448, 326, -218, 131, -68, 25, 0, -11, 14, -13, 9, -6, 3, -1,
+    0, 0, 0, -2, 7, -17, 33, -56, 86, -120, 155, -181, 189, -163, 88, 54, -278, 604, -1052, 1649, -2458, 3640, -5775, 12805, 26836, -4385, 1426, -241, -351, 646, -760, 760, -687, 575, -449, 325, -217, 130, -67, 24, 0, -12, 15, -13, 9, -6, 3, -1,
+    0, 0, 0, -2, 7, -17, 33, -56, 86, -120, 154, -180, 186, -159, 83, 60, -286, 612, -1059, 1656, -2461, 3636, -5751, 12686, 26906, -4335, 1390, -215, -370, 659, -770, 766, -690, 576, -448, 324, -216, 129, -65, 23, 1, -12, 15, -13, 9, -6, 3, -1,
+    0, 0, 0, -2, 7, -17, 33, -56, 86, -120, 153, -179, 184, -156, 78, 66, -293, 620, -1067, 1662, -2464, 3631, -5726, 12567, 26975, -4284, 1354, -189, -389, 673, -779, 771, -693, 578, -448, 324, -215, 128, -64, 23, 2, -13, 15, -13, 9, -6, 3, -1,
+    0, 0, 0, -2, 7, -17, 33, -56, 86, -120, 153, -177, 182, -152, 74, 72, -300, 628, -1075, 1668, -2467, 3625, -5701, 12448, 27044, -4233, 1318, -162, -409, 687, -788, 777, -697, 579, -448, 323, -214, 127, -63, 22, 2, -13, 15, -13, 9, -6, 3, -1,
+    0, 0, 0, -2, 7, -17, 33, -56, 86, -119, 152, -176, 179, -149, 69, 77, -307, 636, -1082, 1675, -2469, 3620, -5675, 12329, 27112, -4181, 1282, -136, -428, 700, -798, 783, -700, 580, -448, 322, -213, 125, -62, 21, 3, -13, 16, -13, 9, -6, 3, -1,
+    0, 0, 0, -2, 8, -18, 33, -56, 86, -119, 151, -174, 177, -145, 64, 83, -314, 643, -1090, 1681, -2471, 3614, -5649, 12210, 27180, -4129, 1246, -110, -447, 714, -807, 789, -703, 581, -448, 321, -211, 124, -61, 20, 3, -14, 16, -14, 10, -6, 3, -1,
+    0, 0, 0, -2, 8, -18, 34, -56, 86, -118, 150, -173, 174, -142, 59, 89, -321, 651, -1097, 1686, -2473, 3608, -5623, 12091, 27247, -4075, 1209, -83, -467, 728, -816, 794, -706, 582, -448, 320, -210, 123, -60, 19, 4, -14, 16, -14, 10, -6, 3, -1,
+    0, 0, 0, -2, 8, -18, 34, -56, 85, -118, 149, -171, 172, -138, 55, 95, -328, 658, -1104, 1692, -2475, 3601, -5597, 11972, 27313, -4022, 1172, -56, -486, 742, -825, 800, -708, 583, -448, 319, -209, 122, -59, 18, 5, -15, 16, -14, 10, -6, 3, -1,
+    0, 0, 0, -3, 8, -18, 34, -56, 85, -118, 149, -170, 170, -135, 50, 101, -335, 666, -1112, 1698, -2477, 3595, -5570, 11853, 27379, -3967, 1135, -30, -505, 755, -834, 805, -711, 584, -447, 318, -208, 121, -58, 17, 5, -15, 17, -14, 10, -6, 3, -1,
+    0, 0, 0, -3, 8, -18, 34, -56, 85, -117, 148, -168, 167, -131, 45, 107, -342, 673, -1119, 1703, -2478, 3588, -5542, 11734, 27443, -3913, 1098, -3, -524, 769, -843, 811, -714, 585, -447, 317, -206, 119, -57, 16, 6, -16, 17, -14, 10, -6, 3, -1,
+    0, 0, 0, -3, 8, -18, 34, -57, 85, -117, 147, -166, 165, -128, 41, 113, -348, 681, -1126, 1708, -2480, 3580, -5515, 11616, 27507, -3857, 1061, 24, -544, 782, -852, 816, -717, 586, -447, 316, -205, 118, -56, 16, 7, -16, 17, -14, 10, -6, 3, -1,
+    0, 0, 0, -3, 8, -18, 34, -57, 85, -117, 146, -165, 162, -124, 36, 119, -355, 688, -1133, 1713, -2481, 3573, -5487, 11497, 27571, -3801, 1023, 51, -563, 795, -861, 822, -720, 587, -446, 315, -204, 117, -54, 15, 7, -16, 17, -14, 10, -6, 3, -1,
+    0, 0, 0, -3, 8, -18, 34, -57, 85, -116, 145, -163, 160, -121, 31, 125, -362, 695, -1139, 1718, -2481, 3565, -5459, 11378, 27633, -3744, 985, 78, -582, 809, -870, 827, -722, 588, -446, 314, -203, 115, -53, 14, 8, -17, 18, -15, 10, -6, 3, -1,
+    0, 0, 1, -3, 8, -18, 34, -57, 85, -116, 144, -162, 157, -117, 26, 131, -369, 702, -1146, 1723, -2482, 3557, -5430, 11260, 27695, -3687, 947, 105, -601, 822, -878, 832, -725, 588, -446, 313, -201, 114, -52, 13, 9, -17, 18, -15, 10, -6, 3, -1,
+    0, 0, 0, -3, 9, -19, 34, -57, 85, -115, 143, -160, 155, -114, 22, 136, -375, 709, -1153, 1728, -2482, 3548, -5401, 11141, 27757, -3629, 909, 132, -621, 836, -887, 837, -727, 589, -445, 312, -200, 113, -51, 12, 9, -18, 18, -15, 10, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 85, -115, 142, -159, 152, -110, 17, 142, -382, 716, -1159, 1732, -2482, 3540, -5371, 11022, 27817, -3571, 870, 159, -640, 849, -896, 842, -730, 590, -445, 311, -198, 111, -50, 11, 10, -18, 19, -15, 10, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 84, -114, 141, -157, 150, -107, 12, 148, -389, 723, -1165, 1737, -2482, 3531, -5342, 10904, 27877, -3512, 832, 186, -659, 862, -904, 847, -732, 590, -444, 310, -197, 110, -49, 10, 10, -19, 19, -15, 10, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 84, -114, 140, -155, 147, -103, 8, 154, -395, 730, -1172, 1741, -2482, 3522, -5312, 10786, 27936, -3452, 793, 213, -678, 875, -913, 852, -735, 591, -444, 309, -196, 109, -48, 9, 11, -19, 19, -15, 10, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 84, -114, 140, -154, 145, -100, 3, 159, -402, 737, -1178, 1745, -2482, 3512, -5281, 10668, 27995, -3392, 754, 240, -697, 888, -921, 857, -737, 591, -443, 307, -194, 107, -46, 8, 12, -19, 19, -15, 10, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 84, -113, 139, -152, 142, -96, -2, 165, -408, 743, -1184, 1749, -2481, 3503, -5251, 10549, 28053, -3331, 715, 267, -717, 901, -930, 862, -739, 592, -442, 306, -193, 106, -45, 7, 12, -20, 19, -15, 11, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 84, -113, 138, -151, 140, -92, -6, 171, -415, 750, -1190, 1752, -2480, 3493, -5220, 10431, 28110, -3270, 675, 295, -736, 914, -938, 867, -741, 592, -442, 305, -191, 104, -44, 6, 13, -20, 20, -16, 11, -6, 3, -1,
+    0, 0, 1, -3, 9, -19, 35, -57, 84, -112, 137, -149, 137, -89, -11, 176, -421, 757, -1196, 1756, -2479, 3482, -5189, 10313, 28166, -3207, 636, 322, -755, 927, -946, 871, -743, 592, -441, 304, -190, 103, -43, 6, 14, -21, 20, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 9, -19, 35, -57, 83, -112, 136, -147, 135, -85, -15, 182, -427, 763, -1201, 1759, -2478, 3472, -5157, 10196, 28221, -3145, 596, 349, -774, 940, -954, 876, -746, 593, -440, 302, -188, 102, -42, 5, 14, -21, 20, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 9, -20, 35, -57, 83, -111, 135, -145, 132, -82, -20, 188, -434, 769, -1207, 1763, -2477, 3461, -5125, 10078, 28276, -3082, 556, 377, -793, 953, -963, 881, -747, 593, -439, 301, -187, 100, -40, 4, 15, -21, 21, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 9, -20, 35, -57, 83, -111, 134, -144, 130, -78, -25, 193, -440, 776, -1212, 1766, -2475, 3450, -5093, 9960, 28330, -3018, 516, 404, -812, 966, -971, 885, -749, 593, -438, 300, -185, 99, -39, 3, 16, -22, 21, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 9, -20, 35, -57, 83, -110, 133, -142, 127, -75, -29, 199, -446, 782, -1218, 1769, -2473, 3439, -5061, 9843, 28384, -2953, 476, 431, -831, 979, -979, 890, -751, 593, -437, 298, -184, 97, -38, 2, 16, -22, 21, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 83, -110, 132, -140, 125, -71, -34, 204, -452, 788, -1223, 1772, -2471, 3427, -5028, 9725, 28436, -2888, 436, 459, -850, 991, -987, 894, -753, 593, -437, 297, -182, 96, -37, 1, 17, -23, 21, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 82, -109, 131, -139, 122, -68, -38, 210, -458, 794, -1228, 1774, -2469, 3416, -4995, 9608, 28488, -2823, 395, 486, -869, 1004, -994, 898, -755, 594, -435, 295, -180, 94, -36, 0, 18, -23, 21, -16, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 82, -108, 130, -137, 119, -64, -43, 215, -464, 800, -1233, 1777, -2466, 3403, -4961, 9491, 28539, -2757, 355, 514, -888, 1016, -1002, 903, -757, 594, -435, 294, -179, 93, -34, -1, 18, -24, 22, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 82, -108, 129, -135, 117, -61, -48, 221, -470, 806, -1238, 1779, -2464, 3391, -4928, 9374, 28590, -2690, 314, 541, -906, 1029, -1010, 907, -758, 594, -434, 292, -177, 91, -33, -2, 19, -24, 22, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 82, -107, 128, -134, 114, -57, -52, 226, -476, 812, -1243, 1782, -2461, 3379, -4894, 9257, 28639, -2623, 273, 569, -925, 1041, -1018, 911, -760, 593, -432, 291, -176, 90, -32, -3, 20, -24, 22, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 82, -107, 126, -132, 112, -53, -57, 231, -482, 818, -1248, 1784, -2458, 3366, -4859, 9141, 28688, -2555, 232, 597, -944, 1054, -1025, 915, -761, 593, -431, 289, -174, 88, -31, -4, 20, -25, 22, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 81, -106, 125, -130, 109, -50, -61, 237, -488, 824, -1252, 1786, -2455, 3353, -4825, 9024, 28736, -2486, 190, 624, -963, 1066, -1033, 919, -763, 593, -430, 287, -172, 87, -29, -5, 21, -25, 23, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 81, -106, 124, -128, 106, -46, -66, 242, -494, 829, -1257, 1787, -2451, 3340, -4790, 8908, 28784, -2417, 149, 652, -981, 1078, -1040, 923, -764, 593, -429, 286, -171, 85, -28, -6, 22, -26, 23, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -20, 36, -57, 81, -105, 123, -126, 104, -43, -70, 248, -500, 835, -1261, 1789, -2448, 3326, -4755, 8792, 28830, -2348, 108, 679, -1000, 1090, -1048, 927, -766, 593, -428, 284, -169, 84, -27, -6, 22, -26, 23, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -21, 36, -57, 81, -104, 122, -125, 101, -39, -75, 253, -505, 841, -1265, 1791, -2444, 3312, -4720, 8676, 28876, -2278, 66, 707, -1018, 1102, -1055, 930, -767, 592, -426, 282, -167, 82, -26, -7, 23, -26, 23, -17, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -21, 36, -56, 80, -104, 121, -123, 99, -36, -79, 258, -511, 846, -1270, 1792, -2440, 3298, -4684, 8560, 28921, -2207, 24, 735, -1037, 1114, -1062, 934, -768, 592, -425, 281, -165, 81, -24, -8, 23, -27, 24, -18, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -21, 36, -56, 80, -103, 120, -121, 96, -32, -84, 263, -517, 851, -1274, 1793, -2436, 3284, -4648, 8444, 28966, -2136, -18, 762, -1055, 1126, -1069, 938, -769, 592, -424, 279, -163, 79, -23, -9, 24, -27, 24, -18, 11, -6, 3, -1,
+    0, 0, 1, -4, 10, -21, 36, -56, 80, -103, 119, -119, 93, -29, -88, 268, -522, 857, -1277, 1794, -2431, 3270, -4612, 8329, 29009, -2064, -60, 790, -1074, 1138, -1076, 941, -770, 591, -422, 277, -162, 77, -22, -10, 25, -28, 24, -18, 11, -6, 3, -1,
+    0, 0, 1, -4, 11, -21, 36, -56, 79, -102, 118, -118, 91, -25, -93, 274, -528, 862, -1281, 1795, -2427, 3255, -4576, 8213, 29052, -1991, -102, 817, -1092, 1150, -1083, 945, -772, 590, -421, 275, -160, 76, -20, -11, 25, -28, 24, -18, 12, -6, 3, -1,
+    0, 0, 1, -5, 11, -21, 36, -56, 79, -101, 116, -116, 88, -22, -97, 279, -533, 867, -1285, 1796, -2422, 3240, -4539, 8098, 29094, -1918, -144, 845, -1111, 1162, -1090, 948, -773, 590, -420, 274, -158, 74, -19, -12, 26, -28, 24, -18, 12, -6, 3, -1,
+    0, 0, 1, -5, 11, -21, 36, -56, 79, -101, 115, -114, 86, -18, -101, 284, -539, 872, -1289, 1796, -2417, 3225, -4503, 7983, 29135, -1845, -187, 873, -1129, 1173, -1097, 952, -773, 589, -418, 272, -156, 73, -18, -13, 27, -29, 25, -18, 12, -6, 3, -1,
+    0, 0, 1, -5, 11, -21, 36, -56, 79, -100, 114, -112, 83, -15, -106, 289, -544, 877, -1292, 1797, -2412, 3210, -4466, 7869, 29176, -1771, -229, 900, -1147, 1185, -1104, 955, -774, 589, -417, 270, -154, 71, -17, -14, 27, -29, 25, -18, 12, -7, 3, -1,
+    0, 0, 1, -5, 11, -21, 36, -56, 78, -99, 113, -110, 80, -11, -110, 294, -549, 882, -1296, 1797, -2406, 3194, -4428, 7754, 29215, -1696, -272, 928, -1165, 1197, -1110, 958, -775, 588, -415, 268, -153, 69, -15, -15, 28, -30, 25, -18, 12, -7, 3, -1,
+    0, 0, 2, -5, 11, -21, 36, -56, 78, -99, 112, -109, 78, -7, -114, 299, -554, 886, -1299, 1797, -2401, 3178, -4391, 7640, 29254, -1621, -315, 955, -1183, 1208, -1117, 961, -776, 587, -413, 266, -151, 68, -14, -16, 29, -30, 25, -18, 12, -6, 3, -1,
+    0, 0, 2, -5, 11, -21, 36, -56, 78, -98, 111, -107, 75, -4, -119, 304, -560, 891, -1302, 1797, -2395, 3162, -4353, 7526, 29293, -1545, -358, 983, -1201, 1219, -1124, 964, -776, 586, -412, 264, -149, 66, -13, -17, 29, -30, 26, -18, 12, -6, 3, -1,
+    0, 0, 2, -5, 11, -21, 36, -56, 77, -97, 110, -105, 72, 0, -123, 309, -565, 896, -1305, 1797, -2389, 3146, -4315, 7412, 29330, -1469, -401, 1011, -1219, 1231, -1130, 967, -777, 585, -410, 262, -147, 64, -11, -18, 30, -31, 26, -19, 12, -7, 3, -1,
+    0, 0, 2, -5, 11, -21, 36, -56, 77, -97, 108, -103, 70, 3, -127, 314, -570, 900, -1308, 1797, -2383, 3129, -4277, 7298, 29367, -1392, -444, 1038, -1237, 1242, -1136, 970, -778, 584, -408, 260, -145, 63, -10, -19, 31, -31, 26, -19, 12, -6, 3, -1,
+    0, 0, 2, -5, 11, -21, 36, -55, 77, -96, 107, -101, 67, 7, -132, 319, -575, 905, -1311, 1796, -2377, 3113, -4238, 7185, 29402, -1314, -487, 1066, -1255, 1253, -1143, 973, -778, 584, -407, 258, -143, 61, -9, -20, 31, -32, 26, -19, 12, -7, 3, -1,
+    0, 0, 2, -5, 11, -21, 36, -55, 76, -95, 106, -99, 65, 10, -136, 323, -580, 909, -1313, 1796, -2370, 3096, -4200, 7072, 29437, -1236, -530, 1093, -1273, 1264, -1149, 976, -779, 582, -405, 256, -141, 59, -7, -21, 32, -32, 26, -19, 12, -7, 3, -1,
+    0, 0, 2, -5, 11, -22, 36, -55, 76, -95, 105, -97, 62, 13, -140, 328, -585, 914, -1316, 1795, -2364, 3079, -4161, 6959, 29472, -1158, -574, 1120, -1290, 1275, -1155, 978, -779, 581, -403, 254, -139, 58, -6, -22, 33, -32, 27, -19, 12, -7, 3, -1,
+    0, 0, 2, -5, 11, -22, 36, -55, 76, -94, 104, -96, 59, 17, -144, 333, -590, 918, -1319, 1794, -2357, 3061, -4122, 6847, 29505, -1079, -617, 1148, -1308, 1286, -1161, 981, -779, 580, -401, 252, -137, 56, -5, -23, 33, -33, 27, -19, 12, -6, 3, -1,
+    0, 0, 2, -5, 11, -22, 36, -55, 75, -93, 102, -94, 57, 20, -149, 338, -594, 922, -1321, 1793, -2350, 3044, -4083, 6734, 29538, -999, -661, 1175, -1325, 1296, -1167, 983, -779, 579, -399, 250, -135, 54, -3, -24, 34, -33, 27, -19, 12, -6, 3, -1,
+    0, 0, 2, -5, 11, -22, 36, -55, 75, -93, 101, -92, 54, 24, -153, 343, -599, 926, -1323, 1792, -2343, 3026, -4043, 6622, 29569, -919, -704, 1203, -1343, 1307, -1173, 986, -780, 578, -397, 248, -133, 53, -2, -25, 34, -33, 27, -19, 12, -7, 3, -1,
+    0, 0, 2, -5, 11, -22, 36, -55, 75, -92, 100, -90, 51, 27, -157, 347, -604, 930, -1325, 1790, -2335, 3008, -4004, 6510, 29600, -838, -748, 1230, -1360, 1318, -1178, 988, -780, 577, -395, 246, -131, 51, -1, -26, 35, -34, 27, -19, 12, -6, 3, -1,
+    0, 0, 2, -5, 11, -22, 36, -54, 74, -91, 99, -88, 49, 31, -161, 352, -609, 934, -1327, 1789, -2328, 2990, -3964, 6399, 29631, -757, -792, 1257, -1378, 1328, -1184, 990, -780, 575, -393, 243, -129, 49, 1, -27, 36, -34, 28, -20, 12, -7, 3, -1,
+    0, 0, 2, -5, 12, -22, 36, -54, 74, -90, 97, -86, 46, 34, -165, 356, -613, 938, -1329, 1787, -2320, 2972, -3924, 6287, 29660, -676, -836, 1284, -1395, 1339, -1189, 993, -780, 574, -391, 241, -127, 47, 2, -28, 36, -35, 28, -20, 12, -6, 3, -1,
+    0, 0, 2, -5, 12, -22, 36, -54, 73, -90, 96, -84, 43, 38, -169, 361, -618, 941, -1331, 1786, -2312, 2953, -3884, 6176, 29689, -593, -879, 1312, -1412, 1349, -1195, 995, -780, 572, -389, 239, -125, 46, 3, -29, 37, -35, 28, -20, 12, -7, 3, -1,
+    0, -1, 2, -5, 12, -22, 36, -54, 73, -89, 95, -82, 41, 41, -174, 365, -622, 945, -1333, 1784, -2304, 2934, -3843, 6065, 29717, -511, -924, 1339, -1429, 1359, -1200, 997, -779, 571, -387, 237, -123, 44, 5, -30, 38, -35, 28, -20, 12, -7, 3, -1,
+    0, 0, 2, -5, 12, -22, 36, -54, 73, -88, 94, -80, 38, 44, -178, 370, -626, 949, -1334, 1782, -2296, 2915, -3803, 5955, 29744, -427, -968, 1366, -1446, 1369, -1206, 999, -779, 569, -385, 234, -121, 42, 6, -30, 38, -36, 28, -20, 12, -7, 3, -1,
+    0, 0, 2, -5, 12, -22, 36, -54, 72, -87, 92, -79, 36, 48, -182, 374, -631, 952, -1336, 1780, -2288, 2896, -3762, 5845, 29770, -343, -1012, 1393, -1463, 1379, -1211, 1001, -779, 568, -383, 232, -118, 40, 7, -31, 39, -36, 29, -20, 12, -7, 3, -1,
+    0, 0, 2, -5, 12, -22, 36, -53, 72, -87, 91, -77, 33, 51, -186, 379, -635, 955, -1337, 1777, -2279, 2877, -3721, 5735, 29795, -259, -1056, 1420, -1480, 1389, -1216, 1003, -779, 566, -381, 230, -116, 39, 9, -32, 39, -37, 29, -20, 12, -7, 3, -1,
+    0, -1, 2, -5, 12, -22, 36, -53, 71, -86, 90, -75, 30, 55, -190, 383, -639, 959, -1339, 1775, -2271, 2857, -3680, 5625, 29820, -174, -1100, 1447, -1496, 1399, -1221, 1004, -778, 565, -378, 227, -114, 37, 10, -33, 40, -37, 29, -20, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -53, 71, -85, 89, -73, 28, 58, -194, 387, -644, 962, -1340, 1772, -2262, 2838, -3639, 5516, 29844, -89, -1144, 1474, -1513, 1409, -1226, 1006, -778, 563, -376, 225, -112, 35, 12, -34, 41, -37, 29, -20, 12, -7, 3, -1,
+    0, 0, 2, -5, 12, -22, 36, -53, 71, -84, 87, -71, 25, 61, -198, 392, -648, 965, -1341, 1769, -2252, 2818, -3597, 5407, 29867, -3, -1189, 1500, -1529, 1418, -1231, 1007, -777, 561, -374, 223, -110, 33, 13, -35, 41, -38, 29, -20, 12, -6, 3, -1,
+    0, 0, 2, -6, 12, -22, 36, -53, 70, -83, 86, -69, 22, 65, -202, 396, -652, 968, -1341, 1766, -2243, 2798, -3556, 5298, 29889, 83, -1233, 1527, -1546, 1428, -1236, 1009, -776, 559, -371, 220, -108, 31, 14, -36, 42, -38, 30, -20, 12, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -53, 70, -83, 85, -67, 20, 68, -206, 400, -656, 971, -1342, 1763, -2234, 2777, -3514, 5190, 29910, 170, -1277, 1554, -1562, 1437, -1240, 1010, -776, 557, -369, 218, -105, 30, 16, -37, 43, -38, 30, -20, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -52, 69, -82, 83, -65, 17, 71, -209, 404, -660, 974, -1343, 1760, -2224, 2757, -3472, 5082, 29931, 257, -1322, 1581, -1578, 1446, -1245, 1012, -775, 556, -366, 215, -103, 28, 17, -38, 43, -39, 30, -20, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -52, 69, -81, 82, -63, 14, 75, -213, 409, -664, 977, -1344, 1757, -2215, 2736, -3431, 4974, 29951, 345, -1366, 1607, -1594, 1456, -1249, 1013, -774, 554, -364, 213, -101, 26, 18, -39, 44, -39, 30, -21, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -52, 68, -80, 81, -61, 12, 78, -217, 413, -667, 980, -1344, 1753, -2205, 2716, -3388, 4867, 29969, 433, -1411, 1634, -1610, 1465, -1254, 1014, -773, 552, -362, 210, -99, 24, 20, -40, 44, -39, 30, -21, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -52, 68, -79, 80, -60, 9, 81, -221, 417, -671, 982, -1344, 1750, -2195, 2695, -3346, 4760, 29988, 522, -1455, 1660, -1626, 1474, -1258, 1015, -772, 549, -359, 208, -96, 22, 21, -41, 45, -40, 30, -21, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 36, -52, 68, -79, 78, -58, 7, 84, -225, 421, -675, 985, -1345, 1746, -2184, 2673, -3304, 4653, 30005, 612, -1500, 1686, -1642, 1483, -1262, 1016, -771, 547, -356, 205, -94, 20, 23, -42, 46, -40, 31, -21, 12, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -51, 67, -78, 77, -56, 4, 88, -229, 425, -678, 987, -1345, 1742, -2174, 2652, -3261, 4546, 30021, 701, -1544, 1713, -1658, 1492, -1266, 1017, -770, 545, -354, 203, -92, 19, 24, -43, 46, -40, 31, -21, 12, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -51, 67, -77, 76, -54, 2, 91, -232, 429, -682, 990, -1345, 1738, -2163, 2631, -3219, 4440, 30037, 792, -1589, 1739, -1674, 1500, -1270, 1018, -769, 543, -351, 200, -90, 17, 25, -44, 47, -41, 31, -21, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -51, 66, -76, 74, -52, -1, 94, -236, 433, -685, 992, -1345, 1734, -2153, 2609, -3176, 4335, 30052, 882, -1634, 1765, -1689, 1509, -1274, 1019, -768, 541, -349, 197, -87, 15, 27, -45, 47, -41, 31, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -51, 66, -75, 73, -50, -4, 97, -240, 436, -689, 994, -1344, 1730, -2142, 2587, -3133, 4229, 30066, 974, -1678, 1791, -1704, 1517, -1278, 1019, -767, 539, -346, 195, -85, 13, 28, -46, 48, -41, 31, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -50, 65, -75, 72, -48, -6, 101, -243, 440, -692, 996, -1344, 1725, -2131, 2565, -3090, 4124, 30079, 1065, -1723, 1817, -1720, 1526, -1281, 1020, -765, 536, -343, 192, -83, 11, 29, -47, 49, -42, 31, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -50, 65, -74, 70, -46, -9, 104, -247, 444, -696, 998, -1344, 1721, -2120, 2543, -3047, 4020, 30091, 1158, -1768, 1843, -1735, 1534, -1285, 1020, -764, 534, -340, 189, -80, 9, 31, -48, 49, -42, 32, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -50, 64, -73, 69, -44, -11, 107, -251, 448, -699, 1000, -1343, 1716, -2108, 2521, -3004, 3915, 30103, 1250, -1812, 1868, -1750, 1542, -1288, 1021, -763, 531, -338, 187, -78, 7, 32, -49, 50, -42, 32, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -50, 64, -72, 68, -42, -14, 110, -254, 451, -702, 1002, -1343, 1711, -2097, 2499, -2961, 3811, 30114, 1343, -1857, 1894, -1765, 1550, -1292, 1021, -761, 529, -335, 184, -76, 6, 34, -49, 50, -43, 32, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -50, 63, -71, 66, -40, -17, 113, -258, 455, -705, 1004, -1342, 1706, -2085, 2476, -2917, 3708, 30124, 1437, -1901, 1920, -1780, 1558, -1295, 1021, -760, 526, -332, 181, -73, 4, 35, -50, 51, -43, 32, -21, 12, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -49, 63, -70, 65, -38, -19, 116, -261, 458, -708, 1006, -1341, 1701, -2074, 2453, -2874, 3604, 30133, 1531, -1946, 1945, -1794, 1566, -1298, 1022, -758, 524, -329, 178, -71, 2, 36, -51, 51, -43, 32, -21, 12, -7, 3, -1,
+    0, -1, 2, -6, 12, -22, 35, -49, 62, -69, 64, -36, -22, 119, -265, 462, -711, 1007, -1340, 1696, -2062, 2430, -2830, 3502, 30141, 1625, -1991, 1970, -1809, 1573, -1301, 1022, -756, 521, -326, 176, -69, 0, 38, -52, 52, -44, 32, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 34, -49, 62, -69, 62, -35, -24, 123, -268, 466, -714, 1009, -1339, 1691, -2050, 2407, -2787, 3399, 30148, 1720, -2035, 1996, -1823, 1581, -1304, 1022, -754, 518, -323, 173, -66, -2, 39, -53, 53, -44, 32, -21, 12, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 34, -48, 61, -68, 61, -33, -27, 126, -272, 469, -717, 1010, -1338, 1685, -2037, 2384, -2743, 3297, 30155, 1816, -2080, 2021, -1838, 1588, -1307, 1022, -752, 516, -320, 170, -64, -4, 40, -54, 53, -44, 33, -21, 13, -6, 3, -1,
+    0, -1, 2, -6, 12, -22, 34, -48, 61, -67, 59, -31, -29, 129, -275, 472, -720, 1012, -1337, 1680, -2025, 2361, -2699, 3196, 30161, 1911, -2124, 2046, -1852, 1596, -1310, 1021, -751, 513, -317, 167, -61, -6, 42, -55, 54, -45, 33, -22, 13, -6, 3, -1,
+    0, -1, 3, -6, 13, -22, 34, -48, 60, -66, 58, -29, -32, 132, -279, 476, -723, 1013, -1335, 1674, -2012, 2337, -2655, 3094, 30166, 2008, -2169, 2071, -1866, 1603, -1313, 1021, -749, 510, -314, 164, -59, -8, 43, -56, 54, -45, 33, -21, 13, -6, 3, -1,
+    0, -1, 3, -6, 12, -22, 34, -48, 60, -65, 57, -27, -34, 135, -282, 479, -725, 1014, -1334, 1668, -2000, 2314, -2611, 2993, 30170, 2104, -2213, 2096, -1880, 1610, -1315, 1021, -747, 507, -311, 162, -57, -10, 44, -57, 55, -45, 33, -22, 13, -6, 3, -1,
+    0, -1, 3, -6, 13, -22, 34, -47, 59, -64, 55, -25, -37, 138, -285, 482, -728, 1015, -1332, 1662, -1987, 2290, -2567, 2893, 30173, 2201, -2258, 2120, -1894, 1617, -1318, 1020, -744, 504, -308, 159, -54, -11, 46, -58, 55, -45, 33, -22, 13, -6, 3, -1,
+    0, -1, 3, -6, 12, -22, 34, -47, 59, -63, 54, -23, -39, 141, -289, 486, -731, 1016, -1330, 1656, -1974, 2266, -2523, 2793, 30176, 2299, -2302, 2145, -1908, 1624, -1320, 1020, -742, 501, -305, 156, -52, -13, 47, -59, 56, -46, 33, -22, 12, -6, 3, -1,
+    0, -1, 3, -6, 12, -22, 34, -47, 58, -62, 53, -21, -42, 144, -292, 489, -733, 1017, -1328, 1650, -1961, 2242, -2479, 2693, 30177, 2397, -2346, 2169, -1921, 1630, -1322, 1019, -740, 498, -302, 153, -49, -15, 49, -60, 56, -46, 33, -22, 13, -6, 3, -1,
+    0, -1, 3, -6, 12, -22, 34, -47, 58, -61, 51, -19, -44, 147, -295, 492, -735, 1018, -1327, 1644, -1948, 2218, -2435, 2594, 30178, 2495, -2391, 2194, -1935, 1637, -1325, 1019, -738, 495, -298, 150, -47, -17, 50, -61, 57, -46, 33, -22, 13, -6, 3, -1,
+};
+
+static const ResampleTable RESAMPLE_TABLES[] = {
+    // up  quality          taps  coefficients
+    {  2, RESAMPLE_LOW,      8,  RS_UP2_LOW},
+    {  2, RESAMPLE_MEDIUM,  24,  RS_UP2_MEDIUM},
+    {  2, RESAMPLE_HIGH,    48,  RS_UP2_HIGH},
+    {  3, RESAMPLE_LOW,      8,  RS_UP3_LOW},
+    {  3, RESAMPLE_MEDIUM,  24,  RS_UP3_MEDIUM},
+    {  3, RESAMPLE_HIGH,    48,  RS_UP3_HIGH},
+    {  6, RESAMPLE_LOW,      8,  RS_UP6_LOW},
+    {  6, RESAMPLE_MEDIUM,  24,  RS_UP6_MEDIUM},
+    {  6, RESAMPLE_HIGH,    48,  RS_UP6_HIGH},
+    {320, RESAMPLE_LOW,      8,  RS_UP320_LOW},
+    {320, RESAMPLE_MEDIUM,  24,  RS_UP320_MEDIUM},
+    {320, RESAMPLE_HIGH,    48,  RS_UP320_HIGH},
+};
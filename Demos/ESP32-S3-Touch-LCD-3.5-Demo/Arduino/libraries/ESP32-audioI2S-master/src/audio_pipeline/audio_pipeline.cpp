@@ -0,0 +1,180 @@
+/*
+ * audio_pipeline.cpp
+ *
+ * Implementation
+ */
+#include "audio_pipeline.h"
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+  #include <esp_attr.h>
+#else
+  #define IRAM_ATTR
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+PcmRing::PcmRing() : m_buffer(nullptr), m_size(0), m_head(0), m_tail(0) {}
+//----------------------------------------------------------------------------------------------------------------------
+void PcmRing::attach(int16_t* buffer, uint32_t frames) {
+    while(frames & (frames - 1)) frames &= frames - 1; // Round down to a power of two
+    m_buffer = buffer;
+    m_size = buffer ? frames : 0;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------------------------------------------------
+// The counters run freely and wrap at 2^32; with a power of two size the
+// difference and the index (count & (size - 1)) stay right across the wrap.
+uint32_t PcmRing::space() const {
+    return m_size - (m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire));
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t PcmRing::filled() const {
+    return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t IRAM_ATTR PcmRing::write(const int16_t* in, uint32_t frames) {
+    const uint32_t head = m_head.load(std::memory_order_relaxed);
+    const uint32_t free = m_size - (head - m_tail.load(std::memory_order_acquire));
+    if(frames > free) frames = free;
+    if(!frames) return 0;
+
+    const uint32_t at = head & (m_size - 1);
+    const uint32_t first = frames < m_size - at ? frames : m_size - at;
+    memcpy(m_buffer + 2 * at, in, first * 2 * sizeof(int16_t));
+    memcpy(m_buffer, in + 2 * first, (frames - first) * 2 * sizeof(int16_t));
+    m_head.store(head + frames, std::memory_order_release); // Publish after the copy
+    return frames;
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t IRAM_ATTR PcmRing::read(int16_t* out, uint32_t frames) {
+    const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+    const uint32_t avail = m_head.load(std::memory_order_acquire) - tail;
+    if(frames > avail) frames = avail;
+    if(!frames) return 0;
+
+    const uint32_t at = tail & (m_size - 1);
+    const uint32_t first = frames < m_size - at ? frames : m_size - at;
+    memcpy(out, m_buffer + 2 * at, first * 2 * sizeof(int16_t));
+    memcpy(out + 2 * first, m_buffer, (frames - first) * 2 * sizeof(int16_t));
+    m_tail.store(tail + frames, std::memory_order_release); // Hand the space back after the copy
+    return frames;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void PcmRing::drop() {
+    m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+//----------------------------------------------------------------------------------------------------------------------
+AudioPipeline::AudioPipeline() : m_refillLevel(0), m_startLevel(0), m_due(0), m_active(false), m_flush(false),
+                                 m_pushing(false), m_primed(false), m_dry(false) {
+    resetStats();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioPipeline::begin(int16_t* buffer, uint32_t frames) {
+    m_ring.attach(buffer, frames);
+    const uint32_t size = m_ring.capacity();
+    setWatermarks(size / PIPELINE_RING_SLOTS * PIPELINE_REFILL_SLOTS, size / PIPELINE_RING_SLOTS * PIPELINE_START_SLOTS);
+    m_due.store(0);
+    m_active.store(false);
+    m_flush.store(false);
+    m_pushing.store(false);
+    m_primed = false;
+    m_dry = false;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioPipeline::setWatermarks(uint32_t refillFrames, uint32_t startFrames) {
+    const uint32_t size = m_ring.capacity();
+    if(startFrames > size) startFrames = size;
+    if(startFrames < PIPELINE_SLOT_FRAMES) startFrames = PIPELINE_SLOT_FRAMES; // At least one slot of audio to start with
+    if(refillFrames > size - PIPELINE_SLOT_FRAMES) refillFrames = size - PIPELINE_SLOT_FRAMES;
+    m_refillLevel = refillFrames;
+    m_startLevel = startFrames;
+}
+//----------------------------------------------------------------------------------------------------------------------
+// m_pushing and m_flush are sequentially consistent: either the feeder
+// sees this push running and waits for it, or the push sees the flush.
+uint32_t AudioPipeline::push(const int16_t* pcm, uint32_t frames) {
+    m_pushing.store(true);
+    uint32_t taken = 0;
+    if(!m_flush.load()) taken = m_ring.write(pcm, frames); // Else old audio still queued
+    // flush() may have come in during the write: then what it took is old
+    // audio too, and the feeder drops it with the rest once this is clear
+    m_pushing.store(false);
+    return taken;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioPipeline::setActive(bool active) {
+    m_active.store(active, std::memory_order_release);
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioPipeline::flush() {
+    m_flush.store(true);
+}
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t IRAM_ATTR AudioPipeline::fillSlot(int16_t* slot) {
+    if(m_due.load(std::memory_order_acquire)) m_due.fetch_sub(1, std::memory_order_acq_rel);
+
+    if(m_flush.load()) {
+        if(m_pushing.load()) { // A write of old audio may still land: silence, drop on the next slot
+            memset(slot, 0, PIPELINE_SLOT_FRAMES * 2 * sizeof(int16_t));
+            bump(m_slots);
+            return 0;
+        }
+        m_ring.drop();
+        m_primed = false;
+        m_dry = false;
+        m_flush.store(false);
+    }
+
+    const bool     active = m_active.load(std::memory_order_acquire);
+    const uint32_t fill = m_ring.filled();
+    uint32_t       frames = 0;
+
+    // Start at the start level; at the end of a song whatever is left goes out
+    if(!m_primed && (fill >= m_startLevel || (!active && fill > 0))) {
+        m_primed = true;
+        m_dry = false;
+    }
+    if(m_primed) frames = m_ring.read(slot, PIPELINE_SLOT_FRAMES);
+    if(frames < PIPELINE_SLOT_FRAMES) memset(slot + 2 * frames, 0, (PIPELINE_SLOT_FRAMES - frames) * 2 * sizeof(int16_t));
+
+    if(active) {
+        if(m_primed) {
+            if(fill < m_lowest.load(std::memory_order_relaxed)) m_lowest.store(fill, std::memory_order_relaxed);
+            if(frames < PIPELINE_SLOT_FRAMES) { // Ran dry: count it once, then fill up to the start level again
+                bump(m_underruns);
+                bump(m_silentFrames, PIPELINE_SLOT_FRAMES - frames);
+                m_primed = false;
+                m_dry = true;
+            }
+        }
+        else if(m_dry) {
+            bump(m_silentFrames, PIPELINE_SLOT_FRAMES);
+        }
+    }
+    else if(frames < PIPELINE_SLOT_FRAMES) {
+        m_primed = false; // Played out
+    }
+    bump(m_slots);
+    return frames;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioPipeline::getStats(AudioPipelineStats* stats) const {
+    stats->underruns = m_underruns.load(std::memory_order_relaxed);
+    stats->silentFrames = m_silentFrames.load(std::memory_order_relaxed);
+    stats->overruns = m_overruns.load(std::memory_order_relaxed);
+    stats->inputStarved = m_inputStarved.load(std::memory_order_relaxed);
+    stats->slots = m_slots.load(std::memory_order_relaxed);
+    stats->pcmFill = m_ring.filled();
+    uint32_t lowest = m_lowest.load(std::memory_order_relaxed);
+    stats->pcmLowest = lowest == UINT32_MAX ? 0 : lowest;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void AudioPipeline::resetStats() {
+    m_underruns.store(0);
+    m_silentFrames.store(0);
+    m_overruns.store(0);
+    m_inputStarved.store(0);
+    m_slots.store(0);
+    m_lowest.store(UINT32_MAX);
+}
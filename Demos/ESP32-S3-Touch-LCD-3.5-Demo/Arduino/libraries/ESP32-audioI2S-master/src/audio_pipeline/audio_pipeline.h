@@ -0,0 +1,131 @@
+/*
+ * audio_pipeline.h
+ *
+ * The decoded half of the player: a PCM ring between the decode task and
+ * the I2S feeder, and the feeder's side of the DMA.
+ *
+ *   network task  --InBuff-->  decode task  --PcmRing-->  I2S feeder  -->  DMA
+ *
+ * Both rings are single producer, single consumer and wait-free. Each side
+ * owns its index and publishes it with a release store, so neither ever
+ * waits on the other: a full or empty ring is only seen, never blocked on.
+ *
+ * The feeder is driven by the DMA. Every completed DMA buffer (the I2S
+ * on_sent event) frees one slot. The feeder then hands exactly one slot
+ * of 48 kHz stereo to the driver, audio or silence, so the writes stay
+ * aligned with the DMA buffers.
+ *
+ * Two watermarks on the PCM ring, in frames:
+ *   refill  the feeder wakes the decoder when the fill drops to this
+ *   start   output starts, and restarts after an underrun, at this fill
+ *
+ * Nothing here knows FreeRTOS or the I2S driver. Audio.cpp does the tasks
+ * and the callback, and the host runs the same code from threads.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define PIPELINE_SLOT_FRAMES   1024    // = dma_frame_num, one DMA buffer
+#define PIPELINE_RING_SLOTS    16      // PCM ring, 341 ms at 48 kHz
+#define PIPELINE_REFILL_SLOTS  12      // Wake the decoder at 3/4
+#define PIPELINE_START_SLOTS   8       // (Re)start output at 1/2
+
+// Wait-free SPSC ring of stereo int16 frames over a caller buffer of a
+// power of two frames
+class PcmRing {
+public:
+    PcmRing();
+    void     attach(int16_t* buffer, uint32_t frames);
+    uint32_t capacity() const { return m_size; }
+
+    // Producer
+    uint32_t space() const;
+    uint32_t write(const int16_t* in, uint32_t frames);   // Returns the frames taken
+
+    // Consumer
+    uint32_t filled() const;
+    uint32_t read(int16_t* out, uint32_t frames);         // Returns the frames copied
+    void     drop();                                      // Discard everything readable
+
+private:
+    int16_t*              m_buffer;
+    uint32_t              m_size;      // Frames
+    std::atomic<uint32_t> m_head;      // Frames written, ever (producer)
+    std::atomic<uint32_t> m_tail;      // Frames read, ever (consumer)
+};
+
+struct AudioPipelineStats {
+    uint32_t underruns;       // Output ran dry while playing: audible dropouts
+    uint32_t silentFrames;    // 48 kHz frames of silence they inserted
+    uint32_t overruns;        // Live stream data arrived with InBuff full: playing slower than the source
+    uint32_t inputStarved;    // Decoder found less than one block in InBuff, stream still running
+    uint32_t slots;           // DMA slots fed
+    uint32_t pcmFill;         // Frames in the PCM ring now
+    uint32_t pcmLowest;       // Lowest fill while playing since the last resetStats()
+};
+
+class AudioPipeline {
+public:
+    AudioPipeline();
+
+    // The ring memory, a power of two frames, at least two slots. The
+    // watermarks scale with it. Call with the tasks stopped.
+    void     begin(int16_t* buffer, uint32_t frames);
+    bool     isReady() const { return m_ring.capacity() > 0; }
+    void     setWatermarks(uint32_t refillFrames, uint32_t startFrames);
+
+    //---- decode task -------------------------------------------------------------------------------------------------
+    // Hands over up to `frames` decoded 48 kHz frames. Returns the frames
+    // taken; the rest must be offered again once the feeder asks for more.
+    uint32_t push(const int16_t* pcm, uint32_t frames);
+    // A song is playing: an empty ring now counts as an underrun. Inactive,
+    // the feeder plays out what is left and then silence.
+    void     setActive(bool active);
+    bool     isActive() const { return m_active.load(std::memory_order_relaxed); }
+    // Discard the queued audio (stop, seek). The feeder does it on its next
+    // slot; push() takes nothing until then. A push() already past its
+    // check goes with the old audio: the feeder plays silence until it
+    // returns, then drops what it wrote too.
+    void     flush();
+
+    //---- I2S feeder --------------------------------------------------------------------------------------------------
+    // From the DMA completion interrupt: one more slot to fill
+    void     dmaSent() { m_due.fetch_add(1, std::memory_order_release); }
+    // Slots waiting for fillSlot()
+    uint32_t due() const { return m_due.load(std::memory_order_acquire); }
+    // The next slot: PIPELINE_SLOT_FRAMES frames into `slot`, audio or
+    // silence. Returns the frames of audio in it.
+    uint32_t fillSlot(int16_t* slot);
+    // After fillSlot(): the decoder has room to run
+    bool     wantsData() const { return m_ring.filled() <= m_refillLevel; }
+
+    //---- counters ----------------------------------------------------------------------------------------------------
+    void     countOverrun() { bump(m_overruns); }             // network task
+    void     countInputStarved() { bump(m_inputStarved); }    // decode task
+    void     getStats(AudioPipelineStats* stats) const;
+    void     resetStats();
+
+private:
+    PcmRing               m_ring;
+    uint32_t              m_refillLevel;
+    uint32_t              m_startLevel;
+    std::atomic<uint32_t> m_due;
+    std::atomic<bool>     m_active;
+    std::atomic<bool>     m_flush;
+    std::atomic<bool>     m_pushing;     // Decode task: inside push()
+    bool                  m_primed;      // Feeder: playing from the ring
+    bool                  m_dry;         // Feeder: ran dry while active, not yet back at the start level
+
+    // Each written by one task, read by any
+    std::atomic<uint32_t> m_underruns;
+    std::atomic<uint32_t> m_silentFrames;
+    std::atomic<uint32_t> m_overruns;
+    std::atomic<uint32_t> m_inputStarved;
+    std::atomic<uint32_t> m_slots;
+    std::atomic<uint32_t> m_lowest;
+
+    static void bump(std::atomic<uint32_t>& c, uint32_t n = 1) { c.fetch_add(n, std::memory_order_relaxed); }
+};
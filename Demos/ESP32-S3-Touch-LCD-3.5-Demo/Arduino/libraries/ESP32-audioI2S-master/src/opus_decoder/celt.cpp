@@ -1986,9 +1986,9 @@ int32_t celt_decoder_init(int32_t channels){
 
     s_celtDec->channels = channels;
     if(channels == 1) s_celtDec->disable_inv = 1; else s_celtDec->disable_inv = 0; // 1 mono ,  0 stereo
+    s_celtDec->mode = &m_CELTMode;
     s_celtDec->end = s_celtDec->mode->effEBands; // 21
     s_celtDec->error = 0;
-    s_celtDec->mode = &m_CELTMode;
     s_celtDec->overlap = m_CELTMode.overlap;
 
     s_celtDec->postfilter_gain = 0;
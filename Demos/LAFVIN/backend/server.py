@@ -1,10 +1,12 @@
+import io
 import os
 import wave
 import json
 import requests
-from flask import Flask, request, jsonify, send_from_directory
+from flask import Flask, Response, request, jsonify, send_from_directory, stream_with_context
 import speech_recognition as sr
-from gTTS import gTTS
+from gtts import gTTS
+from pydub import AudioSegment
 
 app = Flask(__name__)
 
@@ -19,6 +21,9 @@ SAMPLE_RATE = 16000
 CHANNELS = 1
 SAMPLE_WIDTH = 2 # 16-bit = 2 bytes
 
+# /talk: reply text sent in a header, kept short and on one line for the ESP32 display
+REPLY_TEXT_MAX = 480
+
 # Ollama Config
 OLLAMA_URL = "http://localhost:11434/api/generate"
 MODEL_NAME = "tinyllama"
@@ -68,6 +73,21 @@ def text_to_speech(text, output_path):
         print(f"TTS Error: {e}")
         return False
 
+def speech_pcm(text):
+    """Raw PCM in the ESP32 format, one gTTS part (about a sentence) at a time,
+    so the first words can play while the rest is still being synthesized."""
+    try:
+        for part in gTTS(text=text, lang='en').stream():
+            seg = AudioSegment.from_file(io.BytesIO(part), format="mp3")
+            seg = seg.set_frame_rate(SAMPLE_RATE).set_channels(CHANNELS).set_sample_width(SAMPLE_WIDTH)
+            yield seg.raw_data
+    except Exception as e:
+        print(f"TTS Error: {e}")
+
+def reply_header(text):
+    flat = " ".join(text.split())
+    return flat.encode("ascii", "replace").decode()[:REPLY_TEXT_MAX]
+
 @app.route('/upload', methods=['POST'])
 def handle_audio():
     print("Received audio stream...")
@@ -110,13 +130,38 @@ def handle_audio():
         "audio_url": audio_url
     })
 
+@app.route('/talk', methods=['POST'])
+def handle_talk():
+    """Streaming variant of /upload: the reply text in X-Reply-Text and the
+    speech as raw 16-bit PCM in the same response, no second request."""
+    print("Received audio stream...")
+    raw_data = request.get_data() # Chunked upload, werkzeug de-chunks it
+
+    wav_path = os.path.join(UPLOAD_FOLDER, 'input.wav')
+    raw_to_wav(raw_data, wav_path)
+
+    text_input = transcribe_audio(wav_path)
+    print(f"User said: {text_input}")
+
+    if text_input:
+        llm_response = query_llm(text_input)
+    else:
+        llm_response = "Sorry, I didn't catch that."
+    print(f"LLM said: {llm_response}")
+
+    return Response(
+        stream_with_context(speech_pcm(llm_response)),
+        content_type=f"audio/L16;rate={SAMPLE_RATE};channels={CHANNELS}",
+        headers={"X-Reply-Text": reply_header(llm_response)},
+    )
+
 @app.route('/audio/<filename>')
 def serve_audio(filename):
     return send_from_directory(OUTPUT_FOLDER, filename)
 
 @app.route('/chat', methods=['GET'])
 def check_status():
-    return "Server is running. POST raw audio to /upload."
+    return "Server is running. POST raw audio to /upload, or to /talk for a streamed reply."
 
 if __name__ == '__main__':
     # Run on all interfaces
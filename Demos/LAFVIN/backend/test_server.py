@@ -1,5 +1,6 @@
 import requests
 import sys
+import time
 
 # Create a dummy wav file (1 second of silence) if not exists
 import wave
@@ -31,5 +32,36 @@ def test_upload():
     except Exception as e:
         print(f"TEST FAILED: {e}")
 
+def test_talk():
+    url = "http://localhost:5000/talk"
+
+    # Chunked upload, 4 KB per chunk as the ESP32 sends it
+    def chunks():
+        for _ in range(8):
+            yield b'\x00\x00' * 2048
+
+    print(f"Streaming 32768 bytes to {url}...")
+    try:
+        start = time.time()
+        response = requests.post(url, data=chunks(), stream=True)
+        print("Status Code:", response.status_code)
+        print("Content-Type:", response.headers.get("Content-Type"))
+        print("Reply:", response.headers.get("X-Reply-Text"))
+        first = None
+        total = 0
+        for part in response.iter_content(chunk_size=2048):
+            if first is None:
+                first = time.time() - start
+            total += len(part)
+        print(f"Speech: {total} bytes of PCM, first after {first or 0:.2f} s")
+
+        if response.status_code == 200 and response.headers.get("Content-Type", "").startswith("audio/L16"):
+            print("TEST PASSED")
+        else:
+            print("TEST FAILED")
+    except Exception as e:
+        print(f"TEST FAILED: {e}")
+
 if __name__ == "__main__":
     test_upload()
+    test_talk()
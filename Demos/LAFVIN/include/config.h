@@ -35,4 +35,17 @@
 #define SAMPLE_RATE 16000
 #define BUFFER_SIZE 1024
 
+// --- Streaming ---
+#define MIC_DMA_BUF_COUNT 8            // Mic DMA ring: 8 x 256 samples = 128 ms
+#define MIC_DMA_BUF_LEN   256          // Samples, also the capture task's read size
+#define MIC_RING_BYTES    (32 * 1024)  // Capture -> upload, 1 s of audio
+#define UPLOAD_CHUNK      4096         // HTTP chunk, 128 ms of audio
+#define SPK_DMA_BUF_COUNT 8            // Speaker DMA ring: 128 ms
+#define SPK_DMA_BUF_LEN   256
+#define PLAY_READ         2048         // Socket -> speaker per read
+#define SPK_VOLUME        180          // 0...256, 256 = as received
+#define REPLY_TIMEOUT_MS  60000        // STT + LLM + first TTS sentence
+#define REPLY_TEXT_MAX    480          // X-Reply-Text kept for the display
+#define DEBOUNCE_MS       30
+
 #endif
@@ -1,36 +1,45 @@
 #include <Arduino.h>
 #include <WiFi.h>
-#include <HTTPClient.h>
-#include <Audio.h> // ESP32-audioI2S library
-#include <ArduinoJson.h>
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include <freertos/stream_buffer.h>
 #include "config.h"
 #include <driver/i2s.h>
 
 // --- Globals ---
-Audio audio;
-bool isRecording = false;
-const i2s_port_t I2S_PORT = I2S_NUM_0;
+// Full duplex: the mic and the speaker each have their own I2S port, both always running
+const i2s_port_t I2S_MIC_PORT = I2S_NUM_0;
+const i2s_port_t I2S_SPK_PORT = I2S_NUM_1;
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+SemaphoreHandle_t displayLock;
+
+// Capture task -> session task: raw 16-bit mono PCM
+StreamBufferHandle_t micRing;
+TaskHandle_t sessionTask;
+
+enum SessionState : uint8_t { IDLE, UPLOADING, WAITING, PLAYING };
+volatile SessionState sessionState = IDLE;
+volatile bool capturing = false;   // Button held: the capture task queues the mic
+volatile bool micStopped = true;   // The capture task has seen capturing go false, nothing more will be queued
+volatile bool abortReply = false;  // Pressed again during the reply
+volatile uint32_t droppedBytes = 0;
+volatile uint32_t pressedAt = 0;   // millis()
+volatile uint32_t releasedAt = 0;
 
 void showStatus(const char* msg) {
+    xSemaphoreTake(displayLock, portMAX_DELAY);
     display.clearDisplay();
     display.setCursor(0, 0);
     display.println(msg);
     display.display();
+    xSemaphoreGive(displayLock);
     Serial.println(msg);
 }
 
-// Buffer for audio recording
-// 5 seconds * 16000 samples/sec * 2 bytes/sample = 160,000 bytes.
-// We'll allocate this in PSRAM if available, or just use chunks.
-// For this example, we will stream chunks to the server to save RAM.
-
 void setupWifi() {
     showStatus("Connecting WiFi...");
     WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
@@ -38,11 +47,13 @@ void setupWifi() {
         delay(500);
         Serial.print(".");
     }
+    WiFi.setSleep(false); // Modem sleep adds up to a beacon interval to every packet
     Serial.println("\nWiFi connected");
     Serial.println(WiFi.localIP());
     showStatus("WiFi Connected");
 }
 
+// The mic runs all the time; its DMA ring is the first stage of the capture
 void setupI2S_Mic() {
     i2s_config_t i2s_config = {
         .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX),
@@ -51,13 +62,13 @@ void setupI2S_Mic() {
         .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
         .communication_format = I2S_COMM_FORMAT_I2S,
         .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
-        .dma_buf_count = 8,
-        .dma_buf_len = 64,
+        .dma_buf_count = MIC_DMA_BUF_COUNT,
+        .dma_buf_len = MIC_DMA_BUF_LEN,
         .use_apll = false,
         .tx_desc_auto_clear = false,
         .fixed_mclk = 0
     };
-    
+
     i2s_pin_config_t pin_config = {
         .bck_io_num = I2S_MIC_SCK,
         .ws_io_num = I2S_MIC_WS,
@@ -65,35 +76,287 @@ void setupI2S_Mic() {
         .data_in_num = I2S_MIC_SD
     };
 
-    i2s_driver_install(I2S_PORT, &i2s_config, 0, NULL);
-    i2s_set_pin(I2S_PORT, &pin_config);
+    i2s_driver_install(I2S_MIC_PORT, &i2s_config, 0, NULL);
+    i2s_set_pin(I2S_MIC_PORT, &pin_config);
 }
 
-// We need to switch I2S modes because some libraries claim the driver exclusively.
-// Audio library handles Output, we handle Input manually or share?
-// For simplicity, we will deinit Audio lib when recording, and re-init when playing.
+// The reply is played as it arrives: raw 16-bit mono PCM straight from the socket
+void setupI2S_Speaker() {
+    i2s_config_t i2s_config = {
+        .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX),
+        .sample_rate = SAMPLE_RATE,
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+        .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
+        .communication_format = I2S_COMM_FORMAT_I2S,
+        .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
+        .dma_buf_count = SPK_DMA_BUF_COUNT,
+        .dma_buf_len = SPK_DMA_BUF_LEN,
+        .use_apll = false,
+        .tx_desc_auto_clear = true, // Silence, not the last buffer again, when the network is late
+        .fixed_mclk = 0
+    };
+
+    i2s_pin_config_t pin_config = {
+        .bck_io_num = I2S_SPK_BCLK,
+        .ws_io_num = I2S_SPK_LRC,
+        .data_out_num = I2S_SPK_DIN,
+        .data_in_num = I2S_PIN_NO_CHANGE
+    };
 
-void sendAudioToServer(uint8_t *data, size_t len) {
-    if (WiFi.status() != WL_CONNECTED) return;
+    i2s_driver_install(I2S_SPK_PORT, &i2s_config, 0, NULL);
+    i2s_set_pin(I2S_SPK_PORT, &pin_config);
+}
 
-    HTTPClient http;
-    String serverPath = "http://" + String(SERVER_IP) + ":" + String(SERVER_PORT) + "/chat";
-    
-    http.begin(serverPath);
-    http.addHeader("Content-Type", "audio/wav"); // Or application/octet-stream
-    
-    // In a real streaming implementation, we'd use chunked encoding.
-    // Here we'll just simulate sending a buffer for the demo logic.
-    // NOTE: This function placeholder implies we have the full buffer.
+// --- Capture task ---
+// Takes each mic DMA buffer as it completes. While the button is held it
+// goes into micRing without waiting: if the upload falls more than
+// MIC_RING_BYTES behind, the overflow is counted and dropped.
+void captureTask(void*) {
+    static int16_t block[MIC_DMA_BUF_LEN];
+    bool queued = false; // Only this task's own view of the release may set micStopped
+    while (true) {
+        size_t got = 0;
+        i2s_read(I2S_MIC_PORT, block, sizeof(block), &got, portMAX_DELAY);
+        if (!capturing) {
+            if (queued) micStopped = true;
+            queued = false;
+            continue;
+        }
+        queued = true;
+        size_t put = xStreamBufferSend(micRing, block, got, 0);
+        if (put < got) droppedBytes += got - put;
+    }
+}
+
+// --- HTTP helpers, no String ---
+
+bool writeAll(WiFiClient& client, const uint8_t* data, size_t len) {
+    while (len) {
+        size_t n = client.write(data, len);
+        if (n == 0) return false;
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+// One line without CR/LF into buf (cut to size), false on timeout, abort or a closed connection
+bool readLine(WiFiClient& client, char* buf, size_t size, uint32_t deadline) {
+    size_t len = 0;
+    while (true) {
+        if (abortReply) return false;
+        int c = client.read();
+        if (c < 0) {
+            if (!client.connected() && !client.available()) return false;
+            if ((int32_t)(millis() - deadline) > 0) return false;
+            vTaskDelay(pdMS_TO_TICKS(2));
+            continue;
+        }
+        if (c == '\n') break;
+        if (c != '\r' && len + 1 < size) buf[len++] = (char)c;
+    }
+    buf[len] = '\0';
+    return true;
+}
+
+// "Name: value" -> value, or NULL if the line is another header
+const char* headerValue(const char* line, const char* name) {
+    size_t n = strlen(name);
+    if (strncasecmp(line, name, n) != 0 || line[n] != ':') return NULL;
+    line += n + 1;
+    while (*line == ' ') line++;
+    return line;
+}
+
+// Response body, plain or chunked
+struct Body {
+    bool chunked;
+    bool done;
+    bool crlf;      // The CRLF after a chunk is still to be read
+    uint32_t left;  // Bytes left in the current chunk
+};
+
+// Up to max payload bytes into out; 0 if nothing is there yet or the body has ended (b.done)
+size_t readBody(WiFiClient& client, Body& b, uint8_t* out, size_t max, uint32_t deadline) {
+    if (b.chunked && b.left == 0) {
+        char line[16];
+        if (b.crlf && !readLine(client, line, sizeof(line), deadline)) { b.done = true; return 0; }
+        b.crlf = false;
+        if (!readLine(client, line, sizeof(line), deadline)) { b.done = true; return 0; }
+        b.left = strtoul(line, NULL, 16);
+        if (b.left == 0) { b.done = true; return 0; }
+    }
+    if (b.chunked && max > b.left) max = b.left;
+    int n = client.read(out, max);
+    if (n <= 0) {
+        if (!client.connected() && !client.available()) b.done = true;
+        return 0;
+    }
+    if (b.chunked) {
+        b.left -= n;
+        b.crlf = b.left == 0;
+    }
+    return n;
+}
+
+// --- Session: upload while held, then play the reply from the same response ---
+
+// Streams micRing as HTTP chunks of UPLOAD_CHUNK bytes until the button is released and the ring is empty
+bool uploadVoice(WiFiClient& client, uint32_t* bytes, uint32_t* chunks) {
+    // "XXXX\r\n" is written right before the data and "\r\n" after it: one write per chunk
+    static uint8_t chunk[8 + UPLOAD_CHUNK + 2];
+    *bytes = 0;
+    *chunks = 0;
+    while (true) {
+        size_t avail = xStreamBufferBytesAvailable(micRing);
+        if (!micStopped && avail < UPLOAD_CHUNK) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
+        if (micStopped && avail == 0) break; // Released and drained
+        size_t got = xStreamBufferReceive(micRing, chunk + 8, UPLOAD_CHUNK, 0);
+        char hex[9];
+        int h = snprintf(hex, sizeof(hex), "%X\r\n", (unsigned)got);
+        memcpy(chunk + 8 - h, hex, h);
+        chunk[8 + got] = '\r';
+        chunk[9 + got] = '\n';
+        if (!writeAll(client, chunk + 8 - h, h + got + 2)) return false;
+        *bytes += got;
+        (*chunks)++;
+    }
+    return writeAll(client, (const uint8_t*)"0\r\n\r\n", 5);
+}
+
+// Status line and headers: reply text and sample rate; false on an error or timeout
+bool readReplyHeaders(WiFiClient& client, Body& body, char* text, size_t textSize, uint32_t* rate) {
+    char line[REPLY_TEXT_MAX + 32];
+    uint32_t deadline = millis() + REPLY_TIMEOUT_MS;
+    if (!readLine(client, line, sizeof(line), deadline)) return false;
+    int status = 0;
+    sscanf(line, "HTTP/%*s %d", &status);
+    if (status != 200) {
+        Serial.printf("[talk] %s\n", line);
+        return false;
+    }
+    body = {false, false, false, 0};
+    text[0] = '\0';
+    *rate = SAMPLE_RATE;
+    while (readLine(client, line, sizeof(line), deadline)) {
+        if (line[0] == '\0') return true; // End of the headers
+        const char* v;
+        if ((v = headerValue(line, "Transfer-Encoding"))) body.chunked = strcasestr(v, "chunked") != NULL;
+        if ((v = headerValue(line, "X-Reply-Text"))) snprintf(text, textSize, "%s", v);
+        if ((v = headerValue(line, "Content-Type")) && strcasestr(v, "rate=")) *rate = atoi(strcasestr(v, "rate=") + 5);
+    }
+    return false;
+}
+
+// Plays the body until it ends or the button is pressed again; returns when the first audio went out in *firstAudio
+void playReply(WiFiClient& client, Body& body, uint32_t* firstByte, uint32_t* firstAudio) {
+    alignas(4) static uint8_t pcm[PLAY_READ + 1];
+    size_t carry = 0; // An odd byte from the last read, the first half of a sample
+    uint32_t deadline = millis() + REPLY_TIMEOUT_MS;
+    while (!body.done && !abortReply) {
+        size_t n = readBody(client, body, pcm + carry, PLAY_READ, deadline);
+        if (n == 0) {
+            if ((int32_t)(millis() - deadline) > 0) break; // Server stalled
+            vTaskDelay(1);
+            continue;
+        }
+        if (!*firstByte) *firstByte = millis();
+        size_t total = carry + n;
+        size_t even = total & ~(size_t)1;
+        int16_t* s = (int16_t*)pcm;
+        for (size_t i = 0; i < even / 2; i++) s[i] = (int16_t)((s[i] * SPK_VOLUME) >> 8);
+        size_t written = 0;
+        while (written < even && !abortReply) {
+            size_t w = 0;
+            i2s_write(I2S_SPK_PORT, pcm + written, even - written, &w, pdMS_TO_TICKS(100));
+            written += w;
+            if (w && !*firstAudio) *firstAudio = millis();
+        }
+        carry = total - even;
+        if (carry) pcm[0] = pcm[even];
+        deadline = millis() + REPLY_TIMEOUT_MS;
+    }
+}
+
+void runSession() {
+    char text[REPLY_TEXT_MAX + 1];
+    char head[192];
+    uint32_t rate = SAMPLE_RATE, bytes = 0, chunks = 0;
+    uint32_t uploadDone = 0, headers = 0, firstByte = 0, firstAudio = 0;
+    Body body;
+    WiFiClient client;
+
+    sessionState = UPLOADING;
+    abortReply = false;
+    if (WiFi.status() != WL_CONNECTED || !client.connect(SERVER_IP, SERVER_PORT)) {
+        showStatus("Conn Failed");
+        while (!micStopped) vTaskDelay(pdMS_TO_TICKS(10));
+        xStreamBufferReset(micRing);
+        sessionState = IDLE;
+        return;
+    }
+    client.setNoDelay(true);
+    int n = snprintf(head, sizeof(head),
+                     "POST /talk HTTP/1.1\r\nHost: %s:%d\r\nContent-Type: audio/L16;rate=%d;channels=1\r\n"
+                     "Transfer-Encoding: chunked\r\nConnection: close\r\n\r\n",
+                     SERVER_IP, SERVER_PORT, SAMPLE_RATE);
+    bool ok = writeAll(client, (const uint8_t*)head, n) && uploadVoice(client, &bytes, &chunks);
+    uploadDone = millis();
+    if (!ok) {
+        showStatus("Upload Failed");
+        while (!micStopped) vTaskDelay(pdMS_TO_TICKS(10));
+        xStreamBufferReset(micRing);
+        client.stop();
+        sessionState = IDLE;
+        return;
+    }
+    Serial.printf("[talk] %u bytes in %u chunks, %u dropped, %u ms after release\n", (unsigned)bytes,
+                  (unsigned)chunks, (unsigned)droppedBytes, (unsigned)(uploadDone - releasedAt));
+
+    sessionState = WAITING;
+    showStatus("Thinking...");
+    if (!readReplyHeaders(client, body, text, sizeof(text), &rate)) {
+        client.stop();
+        if (!abortReply) showStatus("Error/No Reply");
+        sessionState = IDLE;
+        return;
+    }
+    headers = millis();
+    showStatus(text[0] ? text : "Error/No Text");
+
+    sessionState = PLAYING;
+    if (rate != SAMPLE_RATE) i2s_set_sample_rates(I2S_SPK_PORT, rate);
+    playReply(client, body, &firstByte, &firstAudio);
+    client.stop();
+    if (abortReply) i2s_zero_dma_buffer(I2S_SPK_PORT);
+    if (rate != SAMPLE_RATE) i2s_set_sample_rates(I2S_SPK_PORT, SAMPLE_RATE);
+
+    // First audio is when the first samples entered the speaker DMA; they sound SPK_DMA_BUF_COUNT buffers later at most
+    Serial.printf("[latency] release -> upload end %u ms, reply %u ms, first byte %u ms, first audio %u ms%s\n",
+                  (unsigned)(uploadDone - releasedAt), (unsigned)(headers - releasedAt),
+                  (unsigned)(firstByte ? firstByte - releasedAt : 0), (unsigned)(firstAudio ? firstAudio - releasedAt : 0),
+                  abortReply ? " (interrupted)" : "");
+    sessionState = IDLE;
+}
+
+void sessionTaskFn(void*) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // A press
+        runSession();
+    }
 }
 
 void setup() {
     Serial.begin(115200);
     pinMode(BUTTON_PIN, INPUT_PULLUP);
-    
+    displayLock = xSemaphoreCreateMutex();
+
     // Setup Display
     Wire.begin(I2C_SDA, I2C_SCL);
-    if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) { 
+    if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
         Serial.println(F("SSD1306 allocation failed"));
     }
     display.setTextSize(1);
@@ -102,113 +365,41 @@ void setup() {
     display.display();
 
     setupWifi();
-    
-    // Setup Speaker (Output) using Audio Library
-    audio.setPinout(I2S_SPK_BCLK, I2S_SPK_LRC, I2S_SPK_DIN);
-    audio.setVolume(15); // 0...21
-    
+
+    setupI2S_Mic();
+    setupI2S_Speaker();
+    micRing = xStreamBufferCreate(MIC_RING_BYTES, UPLOAD_CHUNK);
+    xTaskCreatePinnedToCore(captureTask, "capture", 4096, NULL, 5, NULL, 1);
+    xTaskCreatePinnedToCore(sessionTaskFn, "session", 8192, NULL, 3, &sessionTask, 1);
+
     showStatus("Ready. Hold Button");
 }
 
+// Push-to-talk: press starts the capture (and cuts a reply short), release ends the upload
 void loop() {
-    audio.loop();
-
-    // Simple Push-to-Talk Logic
-    if (digitalRead(BUTTON_PIN) == LOW) {
-        if (!isRecording) {
+    static bool held = false;
+    static bool ignored = false; // Pressed while the last upload was still going: its release is ignored too
+    static uint32_t changedAt = 0;
+    bool down = digitalRead(BUTTON_PIN) == LOW;
+    if (down != held && millis() - changedAt > DEBOUNCE_MS) {
+        changedAt = millis();
+        held = down;
+        if (down) ignored = sessionState == UPLOADING;
+        if (down && !ignored) {
+            if (sessionState != IDLE) abortReply = true; // The session task finishes the reply, then takes this press
+            xStreamBufferReset(micRing);
+            droppedBytes = 0;
+            pressedAt = millis();
+            micStopped = false;
+            capturing = true;
+            xTaskNotifyGive(sessionTask);
             showStatus("Recording...");
-            isRecording = true;
-            
-            // Stop playback to free I2S or avoid conflict (if sharing bus)
-            // audio.stopSong(); 
-            
-            // Initialize Mic I2S
-            setupI2S_Mic();
-            
-            // Open Connection to Server
-            WiFiClient client;
-            if (client.connect(SERVER_IP, SERVER_PORT)) {
-                Serial.println("Connected to server");
-                client.println("POST /upload HTTP/1.1");
-                client.println("Host: " + String(SERVER_IP));
-                client.println("Content-Type: application/octet-stream");
-                client.println("Transfer-Encoding: chunked");
-                client.println("Connection: keep-alive");
-                client.println();
-
-                // Read from Mic and Stream to Server
-                size_t bytes_read = 0;
-                char *i2s_buffer = (char *)calloc(1024, sizeof(char));
-                
-                while (digitalRead(BUTTON_PIN) == LOW) {
-                    i2s_read(I2S_PORT, i2s_buffer, 1024, &bytes_read, portMAX_DELAY);
-                    if (bytes_read > 0) {
-                        client.print(String(bytes_read, HEX));
-                        client.println();
-                        client.write((const uint8_t*)i2s_buffer, bytes_read);
-                        client.println();
-                    }
-                    delay(1); // Watchdog
-                }
-                
-                // End Chunk
-                client.println("0");
-                client.println();
-                
-                showStatus("Thinking...");
-
-                // Read Response (Simple JSON with "audio_url" and "text")
-                String response = "";
-                bool headerEnded = false;
-                while (client.connected()) {
-                    String line = client.readStringUntil('\n');
-                    if (line == "\r") headerEnded = true;
-                    if (headerEnded && line.length() > 0 && line != "\r") {
-                        response += line;
-                    }
-                    if (!client.available() && headerEnded) break;
-                }
-                client.stop();
-                
-                Serial.println("Response: " + response);
-                
-                // Parse JSON
-                // Expected: {"text": "Hello...", "audio_url": "http://..."}
-                DynamicJsonDocument doc(1024);
-                deserializeJson(doc, response);
-                const char* audio_url = doc["audio_url"];
-                const char* text_response = doc["text"];
-                
-                if (text_response) {
-                    showStatus(text_response);
-                } else {
-                    showStatus("Error/No Text");
-                }
-                
-                // Cleanup Mic
-                i2s_driver_uninstall(I2S_PORT);
-                
-                // Play Audio
-                if (audio_url) {
-                    audio.connecttohost(audio_url);
-                }
-                
-                free(i2s_buffer);
-            } else {
-                showStatus("Conn Failed");
-                delay(1000);
-            }
-            
-            isRecording = false;
-            // showStatus("Ready"); // Don't clear immediately so user can read text
+        }
+        else if (!down && !ignored) {
+            releasedAt = millis();
+            capturing = false;
+            Serial.printf("[talk] held %u ms\n", (unsigned)(releasedAt - pressedAt));
         }
     }
-}
-
-// Audio library status callbacks
-void audio_info(const char *info){
-    Serial.print("info        "); Serial.println(info);
-}
-void audio_eof_mp3(const char *info){  //end of file
-    Serial.print("eof_mp3     "); Serial.println(info);
+    delay(2);
 }
@@ -1,73 +1,486 @@
+/*
+ * ESP32-P4 Hub - Complete Sensor System
+ *
+ * Event-driven: every bus has its own task, pinned and prioritised, and
+ * tasks talk through lock-free SPSC queues (spsc_queue.h) plus task
+ * notifications, so nothing polls at a fixed 10 Hz. The radar task sleeps
+ * until a UART's onReceive() says a burst has arrived.
+ *
+ *   radar (UART x4) ─┐
+ *   i2c (BH1750, AI cams) ─┼─► fusion ──► network ──► MQTT
+ *   mic (INMP441 I2S) ─┘
+ *
+ * The network task also publishes vanguard/hub/diagnostics: per-task CPU,
+ * queue high-water marks and sensor -> MQTT latency (hub_diagnostics.h).
+ */
+
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
+#include <KVN_Telemetry.h>
+#include <KVN_RadarParser.h>
+#include <KVN_Presence.h>
 #include <Wire.h>
+#include <ESP_I2S.h>
+#include <math.h>
+#include <atomic>
 #include "secrets.h"
 #include "hub_config.h"
+#include "hub_events.h"
+#include "hub_diagnostics.h"
+#include "spsc_queue.h"
 #include <ESP32_AI.h>
 
 WiFiClient espClient;
 PubSubClient client(espClient);
+KVN_Connection conn(client);
 ESP32_AI ai(ANTHROPIC_API_KEY, "anthropic");
 
-void setup_wifi() {
-  delay(10);
-  Serial.println();
-  Serial.print("Connecting to ");
-  Serial.println(WIFI_SSID);
+// ==================== TASKS & QUEUES ====================
+
+enum { TASK_RADAR, TASK_I2C, TASK_MIC, TASK_FUSION, TASK_NET, TASK_COUNT };
+
+TaskHandle_t radarHandle = nullptr;
+TaskHandle_t fusionHandle = nullptr;
+TaskHandle_t networkHandle = nullptr;
+HubDiagnostics diag;
+
+SpscQueue<RadarEvent, RADAR_QUEUE_LEN> radarQueue;     // radar -> fusion
+SpscQueue<SensorEvent, SENSOR_QUEUE_LEN> sensorQueue;  // i2c -> fusion
+SpscQueue<SoundEvent, SOUND_QUEUE_LEN> soundQueue;     // mic -> fusion
+SpscQueue<OutMessage, OUT_QUEUE_LEN> outQueue;         // fusion -> network
+
+std::atomic<bool> resyncRequested(false);  // Network asks fusion to republish state
+
+// ==================== RADAR TASK ====================
+
+// Radars (parser id = presence source id)
+enum { RADAR_BED, RADAR_DOOR, RADAR_ZONE, RADAR_INTENT, RADAR_COUNT };
+HardwareSerial ZoneRadarSerial(3);
+HardwareSerial IntentRadarSerial(4);
+KVN_RadarParser radars[RADAR_COUNT] = {
+  KVN_RadarParser(RADAR_BED), KVN_RadarParser(RADAR_DOOR),
+  KVN_RadarParser(RADAR_ZONE), KVN_RadarParser(RADAR_INTENT)
+};
+HardwareSerial* radarPorts[RADAR_COUNT] = {&Serial1, &Serial2, &ZoneRadarSerial, &IntentRadarSerial};
+
+void onRadarFrame(uint8_t radar, const KVNRadarFrame& frame) {
+  RadarEvent ev;
+  ev.radar = radar;
+  ev.originUs = micros();
+  ev.frame = frame;
+  radarQueue.push(ev);
+}
+
+void radarTask(void* arg) {
+  for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+    radars[i].onFrame(onRadarFrame);
+  }
+
+  for (;;) {
+    // Bit i: radar i's UART received a burst (onRadarReceive)
+    uint32_t ready = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &ready, portMAX_DELAY);
+
+    diag.busyBegin(TASK_RADAR);
+    uint32_t frames = 0;
+    for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+      if (ready & (1UL << i)) frames += radars[i].poll(*radarPorts[i]);
+    }
+    if (frames) xTaskNotifyGive(fusionHandle);
+    diag.busyEnd(TASK_RADAR);
+  }
+}
+
+// Runs in the UART driver's event task once the line has been idle for
+// RADAR_RX_TIMEOUT symbols (end of a frame) or its FIFO filled up. Bytes
+// that arrive while the radar task drains set the bit again.
+void onRadarReceive(uint8_t radar) {
+  xTaskNotify(radarHandle, 1UL << radar, eSetBits);
+}
+
+// ==================== I2C TASK ====================
+
+const uint8_t CAMERA_ADDR[2] = {GRAVITY_AI_1, GRAVITY_AI_2};
+
+bool readBH1750(uint16_t& lux) {
+  if (Wire.requestFrom((uint8_t)BH1750_ADDR, (uint8_t)2) != 2) return false;
+  uint16_t raw = (Wire.read() << 8) | Wire.read();
+  lux = (uint32_t)raw * 10 / 12;   // Datasheet: lux = count / 1.2
+  return true;
+}
+
+bool probe(uint8_t addr) {
+  Wire.beginTransmission(addr);
+  return Wire.endTransmission() == 0;
+}
+
+void pushSensor(uint8_t kind, uint8_t index, int32_t value) {
+  SensorEvent ev;
+  ev.kind = kind;
+  ev.index = index;
+  ev.originUs = micros();
+  ev.value = value;
+  if (sensorQueue.push(ev)) xTaskNotifyGive(fusionHandle);
+}
+
+void i2cTask(void* arg) {
+  // BH1750 continuous high-resolution mode
+  Wire.beginTransmission(BH1750_ADDR);
+  Wire.write(0x10);
+  Wire.endTransmission();
+
+  bool cameraOnline[2] = {false, false};
+  unsigned long lastCameraCheck = 0;
+  bool firstCheck = true;
+
+  for (;;) {
+    diag.busyBegin(TASK_I2C);
+
+    uint16_t lux;
+    if (readBH1750(lux)) pushSensor(SENSOR_LUX, 0, lux);
+
+    if (firstCheck || millis() - lastCameraCheck >= CAMERA_CHECK_MS) {
+      lastCameraCheck = millis();
+      for (uint8_t i = 0; i < 2; i++) {
+        bool online = probe(CAMERA_ADDR[i]);
+        if (firstCheck || online != cameraOnline[i]) {
+          cameraOnline[i] = online;
+          pushSensor(SENSOR_CAMERA, i, online);
+        }
+      }
+      firstCheck = false;
+    }
+
+    diag.busyEnd(TASK_I2C);
+    vTaskDelay(pdMS_TO_TICKS(I2C_POLL_MS));
+  }
+}
+
+// ==================== MIC TASK ====================
+
+I2SClass mic;
+int32_t micBlock[MIC_BLOCK_SAMPLES];   // Static: too big for the task stack
+
+void micTask(void* arg) {
+  mic.setPins(I2S_SCK, I2S_WS, -1, I2S_SD);
+  if (!mic.begin(I2S_MODE_STD, MIC_SAMPLE_RATE, I2S_DATA_BIT_WIDTH_32BIT,
+                 I2S_SLOT_MODE_MONO, I2S_STD_SLOT_LEFT)) {
+    Serial.println("INMP441 init failed - mic task stopped");
+    // Suspend, not delete: diagnostics hold this handle and read its stack
+    vTaskSuspend(nullptr);
+  }
+
+  for (;;) {
+    // Blocks on the I2S DMA - no polling
+    size_t bytes = mic.readBytes((char*)micBlock, sizeof(micBlock));
+
+    diag.busyBegin(TASK_MIC);
+    size_t n = bytes / sizeof(int32_t);
+    if (n > 0) {
+      // INMP441: 24-bit samples, left-justified in 32-bit slots
+      int64_t sumSq = 0;
+      for (size_t i = 0; i < n; i++) {
+        int32_t s = micBlock[i] >> 8;
+        sumSq += (int64_t)s * s;
+      }
+      float rms = sqrtf((float)sumSq / n);
+      float dbfs = rms > 0 ? 20.0f * log10f(rms / 8388608.0f) : -120.0f;
+
+      SoundEvent ev;
+      ev.originUs = micros();
+      ev.dbfs10 = (int16_t)(dbfs * 10);
+      if (soundQueue.push(ev)) xTaskNotifyGive(fusionHandle);
+    }
+    diag.busyEnd(TASK_MIC);
+  }
+}
+
+// ==================== FUSION TASK ====================
+
+KVN_Presence presence;
+
+void setupPresence() {
+  int bed = presence.addZone("bed");
+  int door = presence.addZone("door");
+  int room = presence.addZone("room");
+
+  presence.addSource(RADAR_BED, bed);
+  presence.addSource(RADAR_DOOR, door);
+  // Both RD-03s watch the room; either one seeing someone is enough
+  presence.addSource(RADAR_ZONE, room, 0, ROOM_RADAR_MAX_CM);
+  presence.addSource(RADAR_INTENT, room, 0, ROOM_RADAR_MAX_CM);
+}
+
+void enqueue(const char* topic, const char* payload, bool retained, uint32_t originUs) {
+  OutMessage msg;
+  strlcpy(msg.topic, topic, sizeof(msg.topic));
+  strlcpy(msg.payload, payload, sizeof(msg.payload));
+  msg.retained = retained;
+  msg.originUs = originUs;
+  if (outQueue.push(msg)) xTaskNotifyGive(networkHandle);
+}
+
+void enqueuePresence(uint8_t index, uint32_t originUs) {
+  const PresenceZone& zone = presence.zone(index);
+
+  char payload[96];
+  KVN_JsonWriter json(payload, sizeof(payload));
+  json.addBool("occupied", zone.occupied);
+  json.addUInt("distance", zone.distance);
+  json.addUInt("radars", zone.radars);
+  if (!json.finish()) return;
+
+  char topic[48];
+  snprintf(topic, sizeof(topic), "vanguard/hub/presence/%s", zone.name);
+  enqueue(topic, payload, true, originUs);
+}
+
+void enqueueCamera(uint8_t index, bool online, uint32_t originUs) {
+  char topic[48];
+  snprintf(topic, sizeof(topic), "vanguard/hub/camera/%u", index + 1);
+  enqueue(topic, online ? "online" : "offline", true, originUs);
+}
+
+void fusionTask(void* arg) {
+  int32_t publishedLux = -1;
+  bool cameraOnline[2] = {false, false};
+  int16_t soundPeak = -1200;
+  int32_t soundSum = 0;
+  uint16_t soundBlocks = 0;
+  uint32_t soundOrigin = 0;
+  unsigned long lastSound = millis();
+
+  for (;;) {
+    // Woken by any producer, or every FUSION_TICK_MS for debounce timeouts
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FUSION_TICK_MS));
+    diag.busyBegin(TASK_FUSION);
+
+    unsigned long now = millis();
+
+    RadarEvent radar;
+    uint32_t radarOrigin = 0;
+    while (radarQueue.pop(radar)) {
+      presence.update(radar.radar, radar.frame, now);
+      radarOrigin = radar.originUs;
+    }
+
+    uint32_t changed = presence.evaluate(now);
+    for (uint8_t i = 0; i < presence.zoneCount(); i++) {
+      if (!(changed & (1UL << i))) continue;
+
+      Serial.print("Presence: ");
+      Serial.print(presence.zone(i).name);
+      Serial.println(presence.occupied(i) ? " occupied" : " clear");
+
+      // A hold timeout has no sensor origin
+      enqueuePresence(i, presence.occupied(i) ? radarOrigin : 0);
+    }
+
+    SensorEvent sensor;
+    while (sensorQueue.pop(sensor)) {
+      if (sensor.kind == SENSOR_LUX) {
+        int32_t band = publishedLux * LUX_DEADBAND_PCT / 100;
+        if (band < LUX_DEADBAND_MIN) band = LUX_DEADBAND_MIN;
+        if (publishedLux < 0 || abs(sensor.value - publishedLux) > band) {
+          char payload[16];
+          snprintf(payload, sizeof(payload), "%ld", (long)sensor.value);
+          enqueue("vanguard/hub/lux", payload, false, sensor.originUs);
+          publishedLux = sensor.value;
+        }
+      } else if (sensor.kind == SENSOR_CAMERA && sensor.index < 2) {
+        cameraOnline[sensor.index] = sensor.value != 0;
+        enqueueCamera(sensor.index, cameraOnline[sensor.index], sensor.originUs);
+      }
+    }
+
+    SoundEvent sound;
+    while (soundQueue.pop(sound)) {
+      if (sound.dbfs10 > soundPeak) soundPeak = sound.dbfs10;
+      soundSum += sound.dbfs10;
+      soundBlocks++;
+      soundOrigin = sound.originUs;
+    }
+    if (soundBlocks && now - lastSound >= SOUND_REPORT_MS) {
+      char payload[48];
+      snprintf(payload, sizeof(payload), "{\"dbfs\":%.1f,\"peak\":%.1f}",
+               soundSum / (soundBlocks * 10.0f), soundPeak / 10.0f);
+      enqueue("vanguard/hub/sound", payload, false, soundOrigin);
+      soundPeak = -1200;
+      soundSum = 0;
+      soundBlocks = 0;
+      lastSound = now;
+    }
+
+    // Broker came back: retained state may have been missed while offline
+    if (resyncRequested.exchange(false)) {
+      for (uint8_t i = 0; i < presence.zoneCount(); i++) enqueuePresence(i, 0);
+      for (uint8_t i = 0; i < 2; i++) enqueueCamera(i, cameraOnline[i], 0);
+    }
+
+    diag.busyEnd(TASK_FUSION);
+  }
+}
+
+// ==================== NETWORK TASK ====================
+
+void onConnectionState(KVNConnState from, KVNConnState to) {
+  Serial.print("Connection: ");
+  Serial.print(KVN_Connection::stateName(from));
+  Serial.print(" -> ");
+  Serial.println(KVN_Connection::stateName(to));
+
+  if (to == KVN_CONN_CONNECTED) {
+    Serial.print("IP address: ");
+    Serial.println(WiFi.localIP());
+  }
+}
+
+void onMqttConnected(PubSubClient& mqtt) {
+  resyncRequested.store(true);
+  xTaskNotifyGive(fusionHandle);
+}
+
+// Scouts built with TELEMETRY_BINARY send CBOR frames to <base>/telemetry.
+// Decode them and republish as JSON on <base>/telemetry/json for Home Assistant.
+void onTelemetryFrame(const char* topic, const byte* payload, unsigned int length) {
+  KVN_Telemetry frame;
+  if (!frame.fromCBOR(payload, length)) {
+    Serial.print("Bad telemetry frame on ");
+    Serial.println(topic);
+    return;
+  }
+
+  char json[256];
+  if (frame.toJSON(json, sizeof(json), true) == 0) return;
 
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+  char jsonTopic[128];
+  snprintf(jsonTopic, sizeof(jsonTopic), "%s/json", topic);
+  client.publish(jsonTopic, json);
+}
+
+// Runs in the network task (inside conn.tick())
+void mqttCallback(char* topic, byte* payload, unsigned int length) {
+  size_t topicLen = strlen(topic);
+  const char* suffix = "/telemetry";
+  size_t suffixLen = strlen(suffix);
 
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    Serial.print(".");
+  if (topicLen > suffixLen && strcmp(topic + topicLen - suffixLen, suffix) == 0) {
+    onTelemetryFrame(topic, payload, length);
   }
+}
+
+void publishDiagnostics() {
+  char payload[MQTT_BUFFER_SIZE - 64];
+  KVN_JsonWriter json(payload, sizeof(payload));
+
+  json.addUInt("uptime", millis() / 1000);
+  diag.writeTasks(json, micros());
+
+  json.beginArray("queues");
+  HubDiagnostics::writeQueue(json, "radar", radarQueue);
+  HubDiagnostics::writeQueue(json, "sensor", sensorQueue);
+  HubDiagnostics::writeQueue(json, "sound", soundQueue);
+  HubDiagnostics::writeQueue(json, "out", outQueue);
+  json.endArray();
+
+  diag.writeLatency(json);
+  json.addUInt("heap_min", ESP.getMinFreeHeap());
+
+  if (json.finish()) {
+    client.publish("vanguard/hub/diagnostics", payload);
+  }
+}
+
+void networkTask(void* arg) {
+  conn.begin(WIFI_SSID, WIFI_PASSWORD, "ESP32P4Hub", MQTT_USER, MQTT_PASSWORD);
+  unsigned long lastDiag = millis();
+
+  for (;;) {
+    // Woken by fusion when a message is queued; ticks MQTT in between
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(NET_TICK_MS));
+    diag.busyBegin(TASK_NET);
+
+    conn.tick();
+
+    // While offline messages wait in the queue; fusion counts drops if it fills
+    if (conn.connected()) {
+      OutMessage msg;
+      for (uint8_t i = 0; i < NET_PUBLISH_BUDGET && outQueue.pop(msg); i++) {
+        if (client.publish(msg.topic, msg.payload, msg.retained) && msg.originUs) {
+          diag.recordLatency(msg.originUs);
+        }
+      }
+      if (outQueue.size()) xTaskNotifyGive(networkHandle);   // More next round
+    }
 
-  Serial.println("");
-  Serial.println("WiFi connected");
-  Serial.println("IP address: ");
-  Serial.println(WiFi.localIP());
-}
-
-void reconnect() {
-  while (!client.connected()) {
-    Serial.print("Attempting MQTT connection...");
-    if (client.connect("ESP32P4Hub", MQTT_USER, MQTT_PASSWORD)) {
-      Serial.println("connected");
-      client.subscribe("vanguard/#");
-    } else {
-      Serial.print("failed, rc=");
-      Serial.print(client.state());
-      Serial.println(" try again in 5 seconds");
-      delay(5000);
+    if (millis() - lastDiag >= DIAG_INTERVAL_MS) {
+      lastDiag = millis();
+      if (conn.connected()) publishDiagnostics();
     }
+
+    diag.busyEnd(TASK_NET);
   }
 }
 
+// ==================== SETUP ====================
+
 void setup() {
   Serial.begin(115200);
-  
+
   // Initialize I2C
   Wire.begin(I2C_SDA, I2C_SCL);
-  
-  // Initialize UARTs for Radars
-  Serial1.begin(115200, SERIAL_8N1, UART1_RX, UART1_TX);
-  Serial2.begin(115200, SERIAL_8N1, UART2_RX, UART2_TX);
-  
-  setup_wifi();
-  
+
+  // Initialize UARTs for Radars. The UART driver's ring buffer holds
+  // bytes until the radar task drains them.
+  for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+    radarPorts[i]->setRxBufferSize(RADAR_RX_BUFFER);
+  }
+  Serial1.begin(LD2420_BAUD, SERIAL_8N1, UART1_RX, UART1_TX);
+  Serial2.begin(LD2420_BAUD, SERIAL_8N1, UART2_RX, UART2_TX);
+  ZoneRadarSerial.begin(RD03_BAUD, SERIAL_8N1, UART3_RX, -1);
+  IntentRadarSerial.begin(RD03_BAUD, SERIAL_8N1, UART4_RX, -1);
+  setupPresence();
+
   client.setServer(MQTT_SERVER, MQTT_PORT);
-  
+  client.setCallback(mqttCallback);
+  client.setBufferSize(MQTT_BUFFER_SIZE);
+
+  // WiFi + MQTT come up in the network task
+  conn.subscribe("vanguard/#");
+  conn.onStateChange(onConnectionState);
+  conn.onConnect(onMqttConnected);
+
   // Initialize AI
   ai.begin();
   Serial.println("AI System Initialized");
+
+  diag.setTask(TASK_RADAR, "radar");
+  diag.setTask(TASK_I2C, "i2c");
+  diag.setTask(TASK_MIC, "mic");
+  diag.setTask(TASK_FUSION, "fusion");
+  diag.setTask(TASK_NET, "network");
+
+  // Consumers first, so producers always have a handle to notify
+  TaskHandle_t handle;
+  xTaskCreatePinnedToCore(networkTask, "network", 8192, nullptr, 2, &networkHandle, NET_CORE);
+  diag.setHandle(TASK_NET, networkHandle);
+  xTaskCreatePinnedToCore(fusionTask, "fusion", 4096, nullptr, 3, &fusionHandle, IO_CORE);
+  diag.setHandle(TASK_FUSION, fusionHandle);
+
+  xTaskCreatePinnedToCore(micTask, "mic", 4096, nullptr, 5, &handle, IO_CORE);
+  diag.setHandle(TASK_MIC, handle);
+  xTaskCreatePinnedToCore(radarTask, "radar", 4096, nullptr, 4, &radarHandle, IO_CORE);
+  diag.setHandle(TASK_RADAR, radarHandle);
+  for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+    radarPorts[i]->setRxTimeout(RADAR_RX_TIMEOUT);
+    radarPorts[i]->onReceive([i]() { onRadarReceive(i); });
+  }
+  xTaskCreatePinnedToCore(i2cTask, "i2c", 3072, nullptr, 3, &handle, IO_CORE);
+  diag.setHandle(TASK_I2C, handle);
 }
 
 void loop() {
-  if (!client.connected()) {
-    reconnect();
-  }
-  client.loop();
-  
-  // Main Hub Logic Placeholder
-  delay(100);
-}
\ No newline at end of file
+  // Everything runs in the tasks above
+  vTaskDelete(nullptr);
+}
@@ -8,7 +8,16 @@
 #define UART2_RX 18  // LD2420 Door Radar
 #define UART2_TX 19
 #define UART3_RX 26  // RD03-EG521 Zone Radar
-#define UART4_TX 33  // RD03-DG521 Intent Radar
+#define UART4_RX 33  // RD03-DG521 Intent Radar (radar TX -> GPIO 33)
+
+// Radar serial (KVN_RadarParser)
+#define LD2420_BAUD 115200
+#define RD03_BAUD 256000
+#define RADAR_RX_BUFFER 1024  // UART driver ring per radar: ~40 ms at 256000 baud
+#define RADAR_RX_TIMEOUT 2    // Idle symbols that end a burst and wake the radar task
+
+// Presence zones (KVN_Presence)
+#define ROOM_RADAR_MAX_CM 500  // Zone/intent radars: ignore targets past 5 m
 
 // I2C Bus (Sensors)
 #define I2C_SDA 21
@@ -21,5 +30,31 @@
 #define I2S_WS 25
 #define I2S_SCK 32
 #define I2S_SD 34
+#define MIC_SAMPLE_RATE 16000
+#define MIC_BLOCK_SAMPLES 1600  // 100 ms per level reading
+
+// FreeRTOS tasks
+#define IO_CORE 1               // Radar, I2C, mic and fusion tasks
+#define NET_CORE 0              // Network task, next to the WiFi stack
+#define I2C_POLL_MS 200
+#define CAMERA_CHECK_MS 5000
+#define FUSION_TICK_MS 50       // Presence debounce resolution
+#define NET_TICK_MS 10
+#define NET_PUBLISH_BUDGET 8    // Messages published per network wake
+#ifndef DIAG_INTERVAL_MS
+#define DIAG_INTERVAL_MS 10000
+#endif
+#define MQTT_BUFFER_SIZE 1024   // Diagnostics JSON is ~600 bytes
+
+// Task queues (power of two)
+#define RADAR_QUEUE_LEN 32
+#define SENSOR_QUEUE_LEN 16
+#define SOUND_QUEUE_LEN 8
+#define OUT_QUEUE_LEN 32
+
+// Publishing
+#define LUX_DEADBAND_PCT 10     // Republish hub lux after this much change
+#define LUX_DEADBAND_MIN 5
+#define SOUND_REPORT_MS 1000
 
 #endif
@@ -0,0 +1,102 @@
+/*
+ * hub_diagnostics.cpp - Implementation
+ */
+
+#include "hub_diagnostics.h"
+#include <string.h>
+
+HubDiagnostics::HubDiagnostics() {
+  for (uint8_t i = 0; i < DIAG_MAX_TASKS; i++) {
+    _tasks[i].name = nullptr;
+    _tasks[i].handle = nullptr;
+    _tasks[i].startedUs = 0;
+    _tasks[i].busyUs.store(0);
+    _tasks[i].reportedBusyUs = 0;
+  }
+  _taskCount = 0;
+  _reportedUs = 0;
+
+  memset(_latency, 0, sizeof(_latency));
+  _latencyCount = 0;
+  _latencyNext = 0;
+  _latencyTotal = 0;
+  _latencyMax = 0;
+}
+
+void HubDiagnostics::setTask(uint8_t id, const char* name) {
+  if (id >= DIAG_MAX_TASKS) return;
+
+  _tasks[id].name = name;
+  if (id >= _taskCount) _taskCount = id + 1;
+}
+
+void HubDiagnostics::recordLatency(uint32_t originUs) {
+  uint32_t us = micros() - originUs;
+
+  _latency[_latencyNext] = us;
+  _latencyNext = (_latencyNext + 1) % DIAG_LATENCY_WINDOW;
+  if (_latencyCount < DIAG_LATENCY_WINDOW) _latencyCount++;
+
+  _latencyTotal++;
+  if (us > _latencyMax) _latencyMax = us;
+}
+
+void HubDiagnostics::writeTasks(KVN_JsonWriter& json, uint32_t nowUs) {
+  uint32_t elapsed = nowUs - _reportedUs;
+  _reportedUs = nowUs;
+
+  json.beginArray("tasks");
+  for (uint8_t i = 0; i < _taskCount; i++) {
+    DiagTask& t = _tasks[i];
+    if (t.name == nullptr) continue;
+
+    uint32_t busy = t.busyUs.load(std::memory_order_relaxed);
+    uint32_t delta = busy - t.reportedBusyUs;
+    t.reportedBusyUs = busy;
+
+    json.beginObject(nullptr);
+    json.addString("name", t.name);
+    json.addFloat("cpu", elapsed ? delta * 100.0f / elapsed : 0.0f, 2);
+    if (t.handle) {
+      json.addUInt("stack_free", uxTaskGetStackHighWaterMark(t.handle));
+    }
+    json.endObject();
+  }
+  json.endArray();
+}
+
+void HubDiagnostics::writeLatency(KVN_JsonWriter& json) {
+  uint32_t sorted[DIAG_LATENCY_WINDOW];
+  uint16_t n = _latencyCount;
+  memcpy(sorted, _latency, n * sizeof(uint32_t));
+
+  // Insertion sort - 128 entries every few seconds
+  for (uint16_t i = 1; i < n; i++) {
+    uint32_t v = sorted[i];
+    int j = i - 1;
+    while (j >= 0 && sorted[j] > v) {
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = v;
+  }
+
+  json.beginObject("latency_us");
+  json.addUInt("n", _latencyTotal);
+  json.addUInt("p50", percentile(sorted, n, 50));
+  json.addUInt("p95", percentile(sorted, n, 95));
+  json.addUInt("p99", percentile(sorted, n, 99));
+  json.addUInt("max", _latencyMax);
+  json.endObject();
+
+  _latencyCount = 0;
+  _latencyNext = 0;
+  _latencyTotal = 0;
+  _latencyMax = 0;
+}
+
+uint32_t HubDiagnostics::percentile(uint32_t* sorted, uint16_t n, uint8_t pct) const {
+  if (n == 0) return 0;
+  uint16_t index = ((uint32_t)n * pct + 99) / 100;   // Nearest rank
+  return sorted[index ? index - 1 : 0];
+}
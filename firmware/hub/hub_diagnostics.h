@@ -0,0 +1,84 @@
+/*
+ * hub_diagnostics.h - Task and latency instrumentation for the P4 hub
+ *
+ * Each task brackets its work with busyBegin()/busyEnd(), so blocking
+ * waits (queue notifications, I2S DMA, vTaskDelay) are not counted. The
+ * network task reports every DIAG_INTERVAL_MS:
+ *   - per task: CPU % of one core since the last report, free stack
+ *   - per queue: depth, high-water mark, drops
+ *   - sensor -> MQTT latency: micros() from the bus read that produced
+ *     a message to the publish() that sent it (p50/p95/p99/max)
+ *
+ * busyBegin/busyEnd are called by the owning task only; the latency
+ * window and the report belong to the network task.
+ */
+
+#ifndef HUB_DIAGNOSTICS_H
+#define HUB_DIAGNOSTICS_H
+
+#include <Arduino.h>
+#include <KVN_JsonWriter.h>
+#include <atomic>
+
+#define DIAG_MAX_TASKS      8
+#define DIAG_LATENCY_WINDOW 128   // Latest samples kept for percentiles
+
+struct DiagTask {
+  const char* name;
+  TaskHandle_t handle;
+  uint32_t startedUs;               // Owning task only
+  std::atomic<uint32_t> busyUs;     // Total, wraps
+  uint32_t reportedBusyUs;          // Network task only
+};
+
+class HubDiagnostics {
+public:
+  HubDiagnostics();
+
+  // Before the task starts; `id` is the task's fixed index
+  void setTask(uint8_t id, const char* name);
+  void setHandle(uint8_t id, TaskHandle_t handle) { _tasks[id].handle = handle; }
+
+  void busyBegin(uint8_t id) { _tasks[id].startedUs = micros(); }
+  void busyEnd(uint8_t id) {
+    DiagTask& t = _tasks[id];
+    t.busyUs.store(t.busyUs.load(std::memory_order_relaxed) + (micros() - t.startedUs),
+                   std::memory_order_relaxed);
+  }
+
+  // Network task: one published message that originated at originUs
+  void recordLatency(uint32_t originUs);
+
+  // Network task: append the "tasks" array (CPU % since the last call)
+  void writeTasks(KVN_JsonWriter& json, uint32_t nowUs);
+
+  // Network task: append the "latency_us" object and start a new window
+  void writeLatency(KVN_JsonWriter& json);
+
+  // Append one entry to an open "queues" array
+  template <typename Q>
+  static void writeQueue(KVN_JsonWriter& json, const char* name, const Q& q) {
+    json.beginObject(nullptr);
+    json.addString("name", name);
+    json.addUInt("depth", q.size());
+    json.addUInt("hwm", q.highWater());
+    json.addUInt("cap", q.capacity());
+    json.addUInt("drops", q.drops());
+    json.endObject();
+  }
+
+private:
+  DiagTask _tasks[DIAG_MAX_TASKS];
+  uint8_t _taskCount;
+  uint32_t _reportedUs;
+
+  uint32_t _latency[DIAG_LATENCY_WINDOW];
+  uint16_t _latencyCount;     // Samples held (<= window)
+  uint16_t _latencyNext;
+  uint32_t _latencyTotal;     // Samples since last report
+  uint32_t _latencyMax;
+
+  uint32_t percentile(uint32_t* sorted, uint16_t n, uint8_t pct) const;
+};
+
+#endif // HUB_DIAGNOSTICS_H
@@ -0,0 +1,50 @@
+/*
+ * hub_events.h - Messages passed between the hub tasks
+ *
+ * Every event carries originUs: micros() when its data came off the bus.
+ * The fusion task copies it onto the MQTT message it causes, and the
+ * network task measures sensor -> publish latency from it. 0 means the
+ * message has no sensor origin (timeouts, resync after reconnect).
+ */
+
+#ifndef HUB_EVENTS_H
+#define HUB_EVENTS_H
+
+#include <Arduino.h>
+#include <KVN_RadarParser.h>
+
+// Radar task -> fusion
+struct RadarEvent {
+  uint8_t radar;
+  uint32_t originUs;
+  KVNRadarFrame frame;
+};
+
+enum SensorKind {
+  SENSOR_LUX,      // value = lux
+  SENSOR_CAMERA    // index = camera, value = 1 online / 0 offline
+};
+
+// I2C task -> fusion
+struct SensorEvent {
+  uint8_t kind;
+  uint8_t index;
+  uint32_t originUs;
+  int32_t value;
+};
+
+// Mic task -> fusion, one per block
+struct SoundEvent {
+  uint32_t originUs;
+  int16_t dbfs10;    // RMS level, dBFS x 10
+};
+
+// Fusion -> network
+struct OutMessage {
+  char topic[48];
+  char payload[112];
+  bool retained;
+  uint32_t originUs;
+};
+
+#endif // HUB_EVENTS_H
@@ -0,0 +1,75 @@
+/*
+ * spsc_queue.h - Lock-free single-producer / single-consumer ring
+ *
+ * Connects two hub tasks without a mutex: exactly one task may push and
+ * exactly one may pop. Head and tail are free-running atomic counters and
+ * each side only writes its own, so neither ever waits on the other.
+ * Fixed capacity (power of two), no heap.
+ *
+ * The producer also tracks the high-water mark and the pushes rejected
+ * while full, for the diagnostics topic.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, uint32_t N>
+class SpscQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+  SpscQueue() : _head(0), _tail(0), _highWater(0), _drops(0) {}
+
+  // Producer side. Returns false (and counts a drop) when full.
+  bool push(const T& item) {
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    uint32_t head = _head.load(std::memory_order_acquire);
+
+    if (tail - head >= N) {
+      _drops.store(_drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    _items[tail & (N - 1)] = item;
+    _tail.store(tail + 1, std::memory_order_release);
+
+    uint32_t used = tail + 1 - head;
+    if (used > _highWater.load(std::memory_order_relaxed)) {
+      _highWater.store(used, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // Consumer side. Returns false when empty.
+  bool pop(T& item) {
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t tail = _tail.load(std::memory_order_acquire);
+
+    if (head == tail) return false;
+
+    item = _items[head & (N - 1)];
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Safe from either side or a third task; may be stale by the time it returns
+  uint32_t size() const {
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+  }
+  uint32_t capacity() const { return N; }
+  uint32_t highWater() const { return _highWater.load(std::memory_order_relaxed); }
+  uint32_t drops() const { return _drops.load(std::memory_order_relaxed); }
+
+private:
+  T _items[N];
+  std::atomic<uint32_t> _head;       // Written by the consumer only
+  std::atomic<uint32_t> _tail;       // Written by the producer only
+  std::atomic<uint32_t> _highWater;  // Written by the producer only
+  std::atomic<uint32_t> _drops;      // Written by the producer only
+};
+
+#endif // SPSC_QUEUE_H
@@ -15,8 +15,14 @@
 
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
 #include <KVN_LDR.h>
+#include <KVN_Router.h>
 #include "secrets.h"
+#include "light_aggregator.h"
+#include "light_benchmark.h"
+#include "context_aggregator.h"
+#include "context_benchmark.h"
 
 // Pin configuration
 #define HUB_LDR_PIN 1  // Adjust based on your P4 pinout
@@ -31,22 +37,44 @@
 #define MQTT_TOPIC_DAY_MODE "vanguard/hub/day_mode"
 #define MQTT_TOPIC_SYSTEM_MODE "vanguard/system/mode"
 #define MQTT_TOPIC_SYSTEM_EVENT "vanguard/system/event"
+#define MQTT_TOPIC_AI_CONTEXT "vanguard/ai/context/light"
+
+// Night security: every reporting room dark (and the hub too)
+#define NIGHT_MIN_ROOMS 1          // Rooms that must be reporting first
+#define LIGHT_EXPIRE_INTERVAL 5000 // How often silent rooms are checked
+
+// Set to 1 to time the aggregator with 17 simulated rooms at 10 Hz on boot
+#define LIGHT_BENCHMARK 0
+
+// AI context: one batched document for every device
+#define AI_CONTEXT_INTERVAL 60000  // Regular cadence, if anything changed
+#define AI_CONTEXT_MIN_GAP 10000   // Significant changes go out this soon
+#define MQTT_BUFFER_SIZE (CONTEXT_DOC_SIZE + 128)
+
+// Set to 1 to compare AI context bytes/tokens per hour for 17 devices on boot
+#define CONTEXT_BENCHMARK 0
 
 // Timing
 unsigned long lastMQTTPublish = 0;
 const unsigned long MQTT_PUBLISH_INTERVAL = 60000; // 1 minute
+#define LIGHT_CHANGE_ADC 200       // Smoothed ADC move that publishes at once
 
 // Network clients
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+KVN_Router router;
 
 // LDR sensor
 KVN_LDR hubLight(HUB_LDR_PIN);
 
 // State tracking
+uint16_t lastReportedLight = 0;    // Smoothed ADC of the last change publish
 bool wasDay = true;
-int darkRoomCount = 0;
-int totalRooms = 17; // All non-hub devices
+bool nightSecurity = false;
+LightAggregator rooms;
+ContextAggregator context;
+char aiContext[CONTEXT_DOC_SIZE];
 
 void setup() {
     Serial.begin(115200);
@@ -63,32 +91,70 @@ void setup() {
 
     Serial.println("LDR initialized on GPIO " + String(HUB_LDR_PIN));
 
-    // Connect to WiFi
-    connectWiFi();
+    rooms.setMinRooms(NIGHT_MIN_ROOMS);
+    context.setCadence(AI_CONTEXT_INTERVAL, AI_CONTEXT_MIN_GAP);
+
+#if LIGHT_BENCHMARK
+    runLightBenchmark(Serial);
+#endif
+#if CONTEXT_BENCHMARK
+    runContextBenchmark(Serial);
+#endif
 
     // Setup MQTT
     mqtt.setServer(MQTT_BROKER, MQTT_PORT);
     mqtt.setCallback(mqttCallback);
+    mqtt.setBufferSize(MQTT_BUFFER_SIZE);  // A full context document
+
+    // Connect WiFi + MQTT in the background
+    router.on("vanguard/+/ambient_light", onAmbientLight);
+    router.on("homeassistant/sensor/+/lux", onSensorLux);
+    router.on("vanguard/+/+/presence", onPresence);
+    router.on("vanguard/+/+/status", onStatus);
+    for (uint8_t i = 0; i < router.routeCount(); i++) {
+        conn.subscribe(router.pattern(i));
+    }
+    conn.setWill("vanguard/hub/status", "offline", true);
+    conn.onConnect(onMqttConnected);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, DEVICE_ID, MQTT_USER, MQTT_PASS);
 
     Serial.println("\nHub ready!");
     Serial.println("Publishing master light level to MQTT\n");
 }
 
 void loop() {
-    // Maintain connections
-    if (!mqtt.connected()) {
-        reconnectMQTT();
-    }
-    mqtt.loop();
+    // Maintain connections (non-blocking)
+    conn.tick();
+
+    // One ADC read per pass: publishing, change and sunrise/sunset all use it
+    const LDRSnapshot& light = hubLight.sample();
 
     // Publish light data periodically or on significant change
-    if (hubLight.hasChanged(200) || (millis() - lastMQTTPublish > MQTT_PUBLISH_INTERVAL)) {
-        publishLightData();
+    bool changed = abs((int)light.smoothed - (int)lastReportedLight) > LIGHT_CHANGE_ADC;
+    if (changed) lastReportedLight = light.smoothed;
+    if (changed || (millis() - lastMQTTPublish > MQTT_PUBLISH_INTERVAL)) {
+        publishLightData(light);
+        evaluateNightMode();  // Hub light is part of the decision
         lastMQTTPublish = millis();
     }
 
-    // Detect sunrise/sunset
-    bool isDay = hubLight.isDay(1500);
+    // Rooms that stopped reporting no longer count towards "all dark"
+    static unsigned long lastExpire = 0;
+    if (millis() - lastExpire > LIGHT_EXPIRE_INTERVAL) {
+        if (rooms.expire(millis())) {
+            evaluateNightMode();
+        }
+        context.expire(millis());
+        lastExpire = millis();
+    }
+
+    // One batched AI context document, on cadence or on significant change
+    if (context.due(millis())) {
+        publishAIContext();
+    }
+
+    // Detect sunrise/sunset (smoothed > LDR_DAY_THRESHOLD)
+    bool isDay = light.isDay;
     if (wasDay != isDay) {
         if (isDay) {
             Serial.println("☀️ Sunrise detected!");
@@ -104,12 +170,13 @@ void loop() {
             // - Reduce polling frequency
         }
         wasDay = isDay;
+        context.setHouse(wasDay, nightSecurity);
     }
 
     // Debug output
     static unsigned long lastDebug = 0;
     if (millis() - lastDebug > 5000) {
-        hubLight.printDebug();
+        KVN_LDR::printDebug(light);
         Serial.println();
         lastDebug = millis();
     }
@@ -117,105 +184,129 @@ void loop() {
     delay(100);
 }
 
-void connectWiFi() {
-    Serial.print("Connecting to WiFi");
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(500);
-        Serial.print(".");
-    }
-
-    Serial.println(" Connected!");
+void onMqttConnected(PubSubClient& client) {
+    Serial.println("MQTT connected!");
     Serial.print("IP: ");
     Serial.println(WiFi.localIP());
+
+    // Publish online status
+    client.publish("vanguard/hub/status", "online", true);
+
+    // A flip while offline was never published: the retained mode may be stale
+    client.publish(MQTT_TOPIC_SYSTEM_MODE, nightSecurity ? "night_security" : "normal", true);
 }
 
-void reconnectMQTT() {
-    while (!mqtt.connected()) {
-        Serial.print("Connecting to MQTT...");
+void mqttCallback(char* topic, byte* payload, unsigned int length) {
+    router.dispatch(topic, payload, length);
+}
 
-        if (mqtt.connect(DEVICE_ID, MQTT_USER, MQTT_PASS)) {
-            Serial.println(" connected!");
+// Copy the payload so it can be parsed as a C string
+size_t payloadText(const KVNTopicMatch& match, char* out, size_t size) {
+    size_t n = match.length < size - 1 ? match.length : size - 1;
+    memcpy(out, match.payload, n);
+    out[n] = '\0';
+    return n;
+}
 
-            // Subscribe to device light levels
-            mqtt.subscribe("vanguard/+/ambient_light");
-            mqtt.subscribe("homeassistant/sensor/+/lux");
+void roomLux(const KVNTopicSpan& id, const char* value) {
+    char* end;
+    long lux = strtol(value, &end, 10);
+    if (end == value || lux < 0) return;
+    if (lux > 65535) lux = 65535;
 
-            // Publish online status
-            mqtt.publish("vanguard/hub/status", "online", true);
+    context.updateLux(id.data, id.length, lux, millis());
 
-        } else {
-            Serial.print(" failed, rc=");
-            Serial.println(mqtt.state());
-            delay(5000);
-        }
+    // Only a dark/light flip can change the house-wide state
+    if (rooms.update(id.data, id.length, lux, millis()) == LIGHT_UPDATE_FLIPPED) {
+        evaluateNightMode();
     }
 }
 
-void mqttCallback(char* topic, byte* payload, unsigned int length) {
-    // Parse incoming light levels from other devices
-    String message = "";
-    for (unsigned int i = 0; i < length; i++) {
-        message += (char)payload[i];
-    }
+// vanguard/<device>/ambient_light (KVN_LDR JSON)
+void onAmbientLight(const KVNTopicMatch& match) {
+    // Our own ambient_light comes back through the wildcard
+    if (match[0].equals("hub")) return;
 
-    // Track dark rooms for system-wide night mode
-    if (String(topic).indexOf("/lux") > 0) {
-        int lux = message.toInt();
+    char message[96];
+    payloadText(match, message, sizeof(message));
 
-        // Count dark rooms (this is simplified - you'd track per device)
-        if (lux < 50) {
-            // Room is dark
-        }
+    const char* value = strstr(message, "\"lux\":");
+    if (value != nullptr) roomLux(match[0], value + 6);
+}
 
-        // If ALL rooms are dark, enable security mode
-        if (darkRoomCount == totalRooms && hubLight.getLux() < 50) {
-            mqtt.publish(MQTT_TOPIC_SYSTEM_MODE, "night_security");
+// homeassistant/sensor/<device>/lux (plain number)
+void onSensorLux(const KVNTopicMatch& match) {
+    char message[16];
+    payloadText(match, message, sizeof(message));
+    roomLux(match[0], message);
+}
 
-            // Enable security features:
-            // - Arm motion sensors
-            // - Enable camera recording
-            // - Disable notification sounds
-            // - Reduce LED brightness
-        }
+// vanguard/<kind>/<device>/presence
+void onPresence(const KVNTopicMatch& match) {
+    char message[96];
+    payloadText(match, message, sizeof(message));
+
+    bool occupied = strstr(message, "\"occupied\":true") != nullptr;
+    context.updatePresence(match[1].data, match[1].length, occupied, millis());
+}
+
+// vanguard/<kind>/<device>/status
+void onStatus(const KVNTopicMatch& match) {
+    char message[16];
+    payloadText(match, message, sizeof(message));
+    context.updateOnline(match[1].data, match[1].length, strcmp(message, "offline") != 0, millis());
+}
+
+void evaluateNightMode() {
+    // Hub light from its last sample - no ADC read from the MQTT callback
+    bool night = rooms.allDark() && hubLight.snapshot().lux < LIGHT_DARK_LUX;
+    if (night == nightSecurity) return;
+
+    nightSecurity = night;
+    context.setHouse(wasDay, nightSecurity);
+    Serial.printf("Rooms dark: %u/%u -> %s\n", rooms.darkCount(), rooms.activeCount(),
+                  night ? "night_security" : "normal");
+
+    if (night) {
+        mqtt.publish(MQTT_TOPIC_SYSTEM_MODE, "night_security", true);
+
+        // Enable security features:
+        // - Arm motion sensors
+        // - Enable camera recording
+        // - Disable notification sounds
+        // - Reduce LED brightness
+    } else {
+        mqtt.publish(MQTT_TOPIC_SYSTEM_MODE, "normal", true);
     }
 }
 
-void publishLightData() {
+// Everything published comes from the loop's one sample
+void publishLightData(const LDRSnapshot& light) {
     // Publish full JSON
-    String json = hubLight.toJSON();
-    mqtt.publish(MQTT_TOPIC_AMBIENT, json.c_str());
+    char json[64];
+    if (KVN_LDR::formatJSON(light, json, sizeof(json))) {
+        mqtt.publish(MQTT_TOPIC_AMBIENT, json);
+    }
 
     // Publish individual values
-    mqtt.publish(MQTT_TOPIC_LUX, String(hubLight.getLux()).c_str());
-    mqtt.publish(MQTT_TOPIC_DAY_MODE, hubLight.isDay() ? "true" : "false");
+    mqtt.publish(MQTT_TOPIC_LUX, String(light.lux).c_str());
+    mqtt.publish(MQTT_TOPIC_DAY_MODE, light.isDay ? "true" : "false");
 
-    // Send AI context (if AI integration enabled)
-    String aiContext = buildAIContext();
-    if (aiContext.length() > 0) {
-        mqtt.publish("vanguard/ai/context/light", aiContext.c_str());
-    }
+    // The hub is one more device in the AI context
+    context.updateLux("hub", 3, light.lux, millis());
 
     Serial.print("Published: ");
     Serial.println(json);
 }
 
-String buildAIContext() {
-    String context = "";
+void publishAIContext() {
+    size_t len = context.build(aiContext, sizeof(aiContext), millis());
+    if (len == 0) return;
 
-    context += "Hub ambient light: " + String(hubLight.getLux()) + " lux. ";
-    context += hubLight.isDay() ? "Daytime conditions." : "Nighttime conditions.";
-
-    // Add light level description
-    uint8_t level = hubLight.getLightLevel();
-    switch (level) {
-        case 0: context += " Very dark."; break;
-        case 1: context += " Dim lighting."; break;
-        case 2: context += " Normal lighting."; break;
-        case 3: context += " Bright lighting."; break;
-        case 4: context += " Very bright."; break;
+    // Only a published document counts as sent
+    if (mqtt.publish(MQTT_TOPIC_AI_CONTEXT, aiContext)) {
+        context.commit();
+    } else {
+        context.retryLater(millis());
     }
-
-    return context;
 }
@@ -0,0 +1,272 @@
+/*
+ * context_aggregator.cpp - Implementation
+ */
+
+#include "context_aggregator.h"
+#include <string.h>
+
+ContextAggregator::ContextAggregator() {
+    memset(_devices, 0, sizeof(_devices));
+    _count = 0;
+
+    _day = true;
+    _night = false;
+    _sentDay = true;
+    _sentNight = false;
+    _houseSent = false;
+
+    _intervalMs = CONTEXT_INTERVAL_MS;
+    _minGapMs = CONTEXT_MIN_GAP_MS;
+    _keyframeEvery = CONTEXT_KEYFRAME_EVERY;
+
+    _pendingMinor = false;
+    _pendingSignificant = false;
+    _lastBuild = 0;
+    _backoff = false;
+    _stagedBytes = 0;
+    _stagedDay = true;
+    _stagedNight = false;
+    _documents = 0;
+    _bytes = 0;
+}
+
+void ContextAggregator::setCadence(unsigned long intervalMs, unsigned long minGapMs) {
+    _intervalMs = intervalMs;
+    _minGapMs = minGapMs < intervalMs ? minGapMs : intervalMs;
+}
+
+DeviceContext* ContextAggregator::findOrAdd(const char* id, size_t len, unsigned long now, bool& added) {
+    added = false;
+    if (len == 0 || len >= LIGHT_ID_MAX_LEN) return nullptr;
+
+    // A couple of dozen devices - a linear scan on the hash is enough
+    uint32_t h = LightAggregator::hash(id, len);
+    for (size_t i = 0; i < _count; i++) {
+        DeviceContext& d = _devices[i];
+        if (d.hash == h && strncmp(d.id, id, len) == 0 && d.id[len] == '\0') {
+            return &d;
+        }
+    }
+
+    if (_count >= CONTEXT_MAX_DEVICES) return nullptr;
+
+    DeviceContext& d = _devices[_count++];
+    memset(&d, 0, sizeof(d));
+    memcpy(d.id, id, len);
+    d.id[len] = '\0';
+    d.hash = h;
+    d.lastSeen = now;
+    d.presence = CONTEXT_PRESENCE_UNKNOWN;
+    d.sentPresence = CONTEXT_PRESENCE_UNKNOWN;
+    added = true;
+    return &d;
+}
+
+// How the device differs from what was last sent
+ContextChange ContextAggregator::pending(const DeviceContext& d) const {
+    if (!d.sent) return CONTEXT_SIGNIFICANT;
+    if (d.online != d.sentOnline || d.presence != d.sentPresence) return CONTEXT_SIGNIFICANT;
+
+    bool sentDark = d.sentHasLux && d.sentLux < LIGHT_DARK_LUX;
+    if (d.dark() != sentDark) return CONTEXT_SIGNIFICANT;
+
+    if (d.hasLux != d.sentHasLux) return CONTEXT_MINOR;
+    if (d.hasLux) {
+        uint16_t deadband = (uint32_t)d.sentLux * CONTEXT_LUX_DEADBAND_PCT / 100;
+        if (deadband < CONTEXT_LUX_DEADBAND_MIN) deadband = CONTEXT_LUX_DEADBAND_MIN;
+        uint16_t diff = d.lux > d.sentLux ? d.lux - d.sentLux : d.sentLux - d.lux;
+        if (diff > deadband) return CONTEXT_MINOR;
+    }
+
+    return CONTEXT_NONE;
+}
+
+void ContextAggregator::mark(ContextChange change) {
+    if (change == CONTEXT_SIGNIFICANT) _pendingSignificant = true;
+    else if (change == CONTEXT_MINOR) _pendingMinor = true;
+}
+
+// Pending flags from scratch, for whatever a committed document left out
+void ContextAggregator::recount() {
+    _pendingMinor = false;
+    _pendingSignificant = false;
+    for (size_t i = 0; i < _count; i++) mark(pending(_devices[i]));
+    if (!_houseSent || _sentDay != _day || _sentNight != _night) mark(CONTEXT_SIGNIFICANT);
+}
+
+void ContextAggregator::unstage() {
+    for (size_t i = 0; i < _count; i++) _devices[i].staged = false;
+    _stagedBytes = 0;
+}
+
+ContextChange ContextAggregator::touch(DeviceContext& d, unsigned long now) {
+    d.lastSeen = now;
+    d.online = true;
+
+    ContextChange change = pending(d);
+    mark(change);
+    return change;
+}
+
+ContextChange ContextAggregator::updateLux(const char* id, size_t len, uint16_t lux, unsigned long now) {
+    bool added;
+    DeviceContext* d = findOrAdd(id, len, now, added);
+    if (d == nullptr) return CONTEXT_REJECTED;
+
+    d->lux = lux;
+    d->hasLux = true;
+    return touch(*d, now);
+}
+
+ContextChange ContextAggregator::updatePresence(const char* id, size_t len, bool occupied, unsigned long now) {
+    bool added;
+    DeviceContext* d = findOrAdd(id, len, now, added);
+    if (d == nullptr) return CONTEXT_REJECTED;
+
+    d->presence = occupied ? 1 : 0;
+    return touch(*d, now);
+}
+
+ContextChange ContextAggregator::updateOnline(const char* id, size_t len, bool online, unsigned long now) {
+    bool added;
+    DeviceContext* d = findOrAdd(id, len, now, added);
+    if (d == nullptr) return CONTEXT_REJECTED;
+
+    if (online) return touch(*d, now);
+
+    // Last will: keep lastSeen so the device is not revived by expire()
+    d->online = false;
+    ContextChange change = pending(*d);
+    mark(change);
+    return change;
+}
+
+ContextChange ContextAggregator::setHouse(bool day, bool nightSecurity) {
+    _day = day;
+    _night = nightSecurity;
+
+    if (_houseSent && _sentDay == day && _sentNight == nightSecurity) return CONTEXT_NONE;
+
+    mark(CONTEXT_SIGNIFICANT);
+    return CONTEXT_SIGNIFICANT;
+}
+
+bool ContextAggregator::expire(unsigned long now) {
+    bool changed = false;
+
+    for (size_t i = 0; i < _count; i++) {
+        DeviceContext& d = _devices[i];
+        if (!d.online || now - d.lastSeen < CONTEXT_STALE_MS) continue;
+
+        d.online = false;
+        mark(pending(d));
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool ContextAggregator::due(unsigned long now) const {
+    // The first document goes out as soon as anything is known, unless
+    // building or publishing it failed
+    unsigned long since = now - _lastBuild;
+    bool first = _documents == 0 && !_backoff;
+    if (_pendingSignificant && (first || since >= _minGapMs)) return true;
+    if (_pendingMinor && (first || since >= _intervalMs)) return true;
+    return false;
+}
+
+size_t ContextAggregator::build(char* out, size_t outSize, unsigned long now) {
+    unstage();
+    bool keyframe = _documents % _keyframeEvery == 0;
+    bool house = !_houseSent || _sentDay != _day || _sentNight != _night;
+
+    size_t listed = 0;
+    for (size_t i = 0; i < _count; i++) {
+        if (keyframe || pending(_devices[i]) != CONTEXT_NONE) listed++;
+    }
+
+    if (listed == 0 && !house && !keyframe) {
+        // Changes fell back inside the deadband before they were sent
+        _pendingMinor = false;
+        _pendingSignificant = false;
+        return 0;
+    }
+
+    // Header: sequence, kind, devices listed / known, house state
+    int n = snprintf(out, outSize, "#%lu %s %u/%u %s%s\n", (unsigned long)_documents,
+                     keyframe ? "full" : "delta", (unsigned)listed, (unsigned)_count,
+                     _day ? "day" : "night", _night ? " security" : "");
+    if (n < 0 || (size_t)n >= outSize) {
+        retryLater(now);
+        return 0;
+    }
+    size_t pos = n;
+
+    // One line per device: id [lux [dark]] [occ|clear] [offline]
+    for (size_t i = 0; i < _count; i++) {
+        DeviceContext& d = _devices[i];
+        if (!keyframe && pending(d) == CONTEXT_NONE) continue;
+
+        const char* tail = "";
+        if (d.presence != CONTEXT_PRESENCE_UNKNOWN) {
+            tail = d.presence ? (d.online ? " occ" : " occ offline") : (d.online ? " clear" : " clear offline");
+        } else if (!d.online) {
+            tail = " offline";
+        }
+        if (d.hasLux) {
+            n = snprintf(out + pos, outSize - pos, d.dark() ? "%s %u dark%s\n" : "%s %u%s\n",
+                         d.id, d.lux, tail);
+        } else {
+            n = snprintf(out + pos, outSize - pos, "%s%s\n", d.id, tail);
+        }
+        if (n < 0 || (size_t)n >= outSize - pos) {
+            retryLater(now);
+            return 0;
+        }
+        pos += n;
+
+        d.staged = true;
+        d.stagedLux = d.lux;
+        d.stagedHasLux = d.hasLux;
+        d.stagedPresence = d.presence;
+        d.stagedOnline = d.online;
+    }
+
+    _stagedDay = _day;
+    _stagedNight = _night;
+    _stagedBytes = pos;
+    _lastBuild = now;
+    return pos;
+}
+
+void ContextAggregator::commit() {
+    if (_stagedBytes == 0) return;
+
+    for (size_t i = 0; i < _count; i++) {
+        DeviceContext& d = _devices[i];
+        if (!d.staged) continue;
+
+        d.sent = true;
+        d.sentLux = d.stagedLux;
+        d.sentHasLux = d.stagedHasLux;
+        d.sentPresence = d.stagedPresence;
+        d.sentOnline = d.stagedOnline;
+    }
+
+    _sentDay = _stagedDay;
+    _sentNight = _stagedNight;
+    _houseSent = true;
+
+    _documents++;
+    _bytes += _stagedBytes;
+    _backoff = false;
+    unstage();
+    recount();
+}
+
+void ContextAggregator::retryLater(unsigned long now) {
+    unstage();
+    _lastBuild = now;
+    _backoff = true;
+}
@@ -0,0 +1,152 @@
+/*
+ * context_aggregator.h - Batched AI context for the KVN Hub
+ *
+ * Keeps a compact typed snapshot of every device (lux, dark, presence,
+ * online) and turns it into one plain-text context document for the AI,
+ * instead of one free-text string per sensor per interval:
+ *
+ *   #7 delta 2/18 day
+ *   esp32_c3_scout1 12 dark
+ *   3C84AA10 240 occ
+ *
+ * Each field remembers the value last sent. A document lists only the
+ * devices whose fields changed since then (lux beyond a deadband), and
+ * every CONTEXT_KEYFRAME_EVERY-th document is a full snapshot so a
+ * consumer that missed one resyncs. Documents go out on a regular
+ * cadence when anything changed, or sooner (rate limited) when something
+ * significant changed: a room went dark/light, presence or online status
+ * flipped, or day/night / security mode changed.
+ *
+ * build() only stages a document; commit() records it as sent once it
+ * was published, retryLater() keeps it pending and backs off.
+ */
+
+#ifndef CONTEXT_AGGREGATOR_H
+#define CONTEXT_AGGREGATOR_H
+
+#include <Arduino.h>
+#include "light_aggregator.h"
+
+#define CONTEXT_MAX_DEVICES       24
+// Longest lines: "#4294967295 delta 24/24 night security" and
+// "<id> 65535 dark clear offline", each with its newline
+#define CONTEXT_HEADER_MAX        40
+#define CONTEXT_LINE_MAX          (LIGHT_ID_MAX_LEN - 1 + 26)
+#define CONTEXT_DOC_SIZE          (CONTEXT_HEADER_MAX + CONTEXT_MAX_DEVICES * CONTEXT_LINE_MAX + 1)
+#define CONTEXT_INTERVAL_MS       60000    // Regular cadence, if anything changed
+#define CONTEXT_MIN_GAP_MS        10000    // Significant changes wait at least this long
+#define CONTEXT_KEYFRAME_EVERY    10       // Every Nth document is a full snapshot
+#define CONTEXT_LUX_DEADBAND_PCT  15       // Smaller lux changes are left out
+#define CONTEXT_LUX_DEADBAND_MIN  5
+#define CONTEXT_STALE_MS          LIGHT_STALE_MS
+
+#define CONTEXT_PRESENCE_UNKNOWN  -1
+
+struct DeviceContext {
+    char id[LIGHT_ID_MAX_LEN];
+    uint32_t hash;
+    unsigned long lastSeen;
+
+    // Latest state
+    uint16_t lux;
+    bool hasLux;
+    int8_t presence;      // 1 occupied, 0 clear, CONTEXT_PRESENCE_UNKNOWN
+    bool online;
+
+    // As written into the staged document
+    bool staged;
+    uint16_t stagedLux;
+    bool stagedHasLux;
+    int8_t stagedPresence;
+    bool stagedOnline;
+
+    // As last sent
+    bool sent;
+    uint16_t sentLux;
+    bool sentHasLux;
+    int8_t sentPresence;
+    bool sentOnline;
+
+    bool dark() const { return hasLux && lux < LIGHT_DARK_LUX; }
+};
+
+enum ContextChange {
+    CONTEXT_NONE,          // Nothing new to report
+    CONTEXT_MINOR,         // Goes out with the next regular document
+    CONTEXT_SIGNIFICANT,   // Worth a document after CONTEXT_MIN_GAP_MS
+    CONTEXT_REJECTED       // ID too long or table full
+};
+
+class ContextAggregator {
+public:
+    ContextAggregator();
+
+    void setCadence(unsigned long intervalMs, unsigned long minGapMs);
+    void setKeyframeEvery(uint8_t documents) { _keyframeEvery = documents ? documents : 1; }
+
+    // `id` need not be NUL-terminated
+    ContextChange updateLux(const char* id, size_t len, uint16_t lux, unsigned long now);
+    ContextChange updatePresence(const char* id, size_t len, bool occupied, unsigned long now);
+    ContextChange updateOnline(const char* id, size_t len, bool online, unsigned long now);
+    ContextChange setHouse(bool day, bool nightSecurity);
+
+    // Mark devices silent for CONTEXT_STALE_MS offline. Returns true if any went.
+    bool expire(unsigned long now);
+
+    // A document should be built now
+    bool due(unsigned long now) const;
+
+    // Write the next document (NUL-terminated) and stage its fields.
+    // Returns its length, or 0 if there is nothing to send or it did not
+    // fit (then it backs off like retryLater()).
+    size_t build(char* out, size_t outSize, unsigned long now);
+
+    // The staged document was published: its fields are what the consumer knows
+    void commit();
+
+    // The staged document was not published: keep its changes pending and
+    // try again after the min gap
+    void retryLater(unsigned long now);
+
+    size_t size() const { return _count; }
+    const DeviceContext& at(size_t index) const { return _devices[index]; }
+
+    uint32_t documents() const { return _documents; }
+    uint32_t bytes() const { return _bytes; }
+
+    // Rough token count for English-like text: ~4 bytes per token
+    static uint32_t estimateTokens(uint32_t bytes) { return (bytes + 3) / 4; }
+
+private:
+    DeviceContext _devices[CONTEXT_MAX_DEVICES];
+    size_t _count;
+
+    bool _day;
+    bool _night;
+    bool _sentDay;
+    bool _sentNight;
+    bool _houseSent;
+
+    unsigned long _intervalMs;
+    unsigned long _minGapMs;
+    uint8_t _keyframeEvery;
+
+    bool _pendingMinor;
+    bool _pendingSignificant;
+    unsigned long _lastBuild;
+    bool _backoff;         // The last attempt failed: wait the min gap
+    size_t _stagedBytes;   // 0: nothing staged
+    bool _stagedDay;
+    bool _stagedNight;
+    uint32_t _documents;
+    uint32_t _bytes;
+
+    DeviceContext* findOrAdd(const char* id, size_t len, unsigned long now, bool& added);
+    ContextChange touch(DeviceContext& d, unsigned long now);
+    ContextChange pending(const DeviceContext& d) const;
+    void mark(ContextChange change);
+    void recount();
+    void unstage();
+};
+
+#endif // CONTEXT_AGGREGATOR_H
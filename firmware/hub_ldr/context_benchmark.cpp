@@ -0,0 +1,161 @@
+/*
+ * context_benchmark.cpp - Implementation
+ */
+
+#include "context_benchmark.h"
+#include "context_aggregator.h"
+#include <KVN_LDR.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_GAP_MS 10000
+
+// The old per-sensor sentence, as buildAIContext() produced it for the hub
+static size_t formatLegacyContext(char* out, size_t outSize, const char* id, uint16_t lux, bool isDay) {
+    static const char* const levels[] = {
+        " Very dark.", " Dim lighting.", " Normal lighting.", " Bright lighting.", " Very bright."
+    };
+    uint8_t level = KVN_LDR::levelFromLux(lux);
+    int n = snprintf(out, outSize, "%s ambient light: %u lux. %s%s", id, lux,
+                     isDay ? "Daytime conditions." : "Nighttime conditions.",
+                     level < 5 ? levels[level] : "");
+    return n > 0 ? n : 0;
+}
+
+static void check(Print& out, const char* name, bool ok, bool& all) {
+    out.printf("  %-40s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) all = false;
+}
+
+// Every device at its longest: a 23-character ID, five-digit lux,
+// clear and offline
+static bool worstCaseFits(size_t& len) {
+    static ContextAggregator agg;
+    static char doc[CONTEXT_DOC_SIZE];
+
+    char id[LIGHT_ID_MAX_LEN];
+    for (uint8_t d = 0; d < CONTEXT_MAX_DEVICES; d++) {
+        size_t n = snprintf(id, sizeof(id), "esp32_c3_scout_bedroom%u", d % 10);
+        id[n - 2] = 'a' + d / 10;   // Keep every ID 23 characters and unique
+        agg.updateLux(id, n, 65535, 0);
+        agg.updatePresence(id, n, false, 0);
+        agg.updateOnline(id, n, false, 0);
+    }
+    agg.setHouse(false, true);
+
+    len = agg.build(doc, sizeof(doc), 0);
+    agg.commit();
+    return agg.size() == CONTEXT_MAX_DEVICES && len > 0 && agg.documents() == 1;
+}
+
+// Too small a buffer: no document, and no new attempt before the min gap
+static bool overflowBacksOff() {
+    static ContextAggregator agg;
+    static char doc[CONTEXT_DOC_SIZE];
+    agg.setCadence(60000, BENCH_GAP_MS);
+
+    agg.updateLux("esp32_c3_scout1", 15, 240, 0);
+    agg.updatePresence("esp32_c3_scout2", 15, true, 0);
+    bool failed = agg.due(0) && agg.build(doc, 24, 0) == 0;
+    bool waits = !agg.due(BENCH_GAP_MS - 1) && agg.due(BENCH_GAP_MS);
+    bool sent = agg.build(doc, sizeof(doc), BENCH_GAP_MS) > 0;
+    agg.commit();
+    return failed && waits && sent && agg.documents() == 1 && !agg.due(2 * BENCH_GAP_MS);
+}
+
+// A document that was built but not published is built again, unchanged
+static bool failedPublishKept() {
+    static ContextAggregator agg;
+    static char first[CONTEXT_DOC_SIZE];
+    static char again[CONTEXT_DOC_SIZE];
+    agg.setCadence(60000, BENCH_GAP_MS);
+
+    agg.updateLux("esp32_c3_scout1", 15, 12, 0);
+    agg.updatePresence("esp32_c3_scout2", 15, true, 0);
+    size_t len = agg.build(first, sizeof(first), 0);
+    agg.retryLater(0);
+
+    bool kept = len > 0 && agg.documents() == 0 && !agg.due(BENCH_GAP_MS - 1) && agg.due(BENCH_GAP_MS);
+    bool same = agg.build(again, sizeof(again), BENCH_GAP_MS) == len && strcmp(first, again) == 0;
+    agg.commit();
+    return kept && same && agg.documents() == 1 && !agg.due(2 * BENCH_GAP_MS);
+}
+
+bool runContextBenchmark(Print& out) {
+    static char ids[CONTEXT_BENCH_DEVICES][LIGHT_ID_MAX_LEN];
+    static size_t lens[CONTEXT_BENCH_DEVICES];
+    static uint16_t base[CONTEXT_BENCH_DEVICES];
+    static uint16_t lux[CONTEXT_BENCH_DEVICES];
+    for (uint8_t d = 0; d < CONTEXT_BENCH_DEVICES; d++) {
+        lens[d] = snprintf(ids[d], sizeof(ids[d]), "esp32_c3_scout%u", d + 1);
+        base[d] = 150 + random(300);
+    }
+    const uint32_t reportEvery = 10;  // Each device reports lux every 10 s
+    const uint32_t dusk = CONTEXT_BENCH_SECONDS / 2;
+
+    out.printf("\n=== AI context: %u devices, %u s ===\n", CONTEXT_BENCH_DEVICES, CONTEXT_BENCH_SECONDS);
+
+    // Static: the aggregator and document are too big for the loop stack
+    static ContextAggregator bench;
+    static char doc[CONTEXT_DOC_SIZE];
+    char line[96];
+    uint32_t legacyBytes = 0;
+    uint32_t legacyMessages = 0;
+    uint32_t worst = 0;
+    bool day = true;
+    bench.setCadence(60000, BENCH_GAP_MS);
+
+    for (uint32_t t = 0; t < CONTEXT_BENCH_SECONDS; t++) {
+        unsigned long now = t * 1000;
+        day = t < CONTEXT_BENCH_SECONDS * 3 / 4;
+
+        for (uint8_t d = 0; d < CONTEXT_BENCH_DEVICES; d++) {
+            bool off = t >= dusk + d * 90u;
+            lux[d] = off ? 5 + random(10) : base[d] - base[d] / 10 + random(base[d] / 5);
+
+            if ((t + d) % reportEvery == 0) {
+                bench.updateLux(ids[d], lens[d], lux[d], now);
+            }
+            if (d < 4 && (t + d * 37) % 300 == 0) {
+                bench.updatePresence(ids[d], lens[d], (t / 300 + d) & 1, now);
+            }
+        }
+        bench.setHouse(day, !day && t >= dusk + CONTEXT_BENCH_DEVICES * 90u);
+
+        // Old scheme: one sentence per sensor per minute
+        if (t % 60 == 0) {
+            for (uint8_t d = 0; d < CONTEXT_BENCH_DEVICES; d++) {
+                legacyBytes += formatLegacyContext(line, sizeof(line), ids[d], lux[d], day);
+                legacyMessages++;
+            }
+        }
+
+        if (bench.due(now)) {
+            uint32_t t0 = micros();
+            if (bench.build(doc, sizeof(doc), now) > 0) bench.commit();
+            uint32_t dt = micros() - t0;
+            if (dt > worst) worst = dt;
+        }
+    }
+
+    uint32_t legacyTokens = ContextAggregator::estimateTokens(legacyBytes);
+    uint32_t batchedTokens = ContextAggregator::estimateTokens(bench.bytes());
+    out.printf("per-sensor strings: %lu messages, %lu bytes, ~%lu tokens\n",
+               (unsigned long)legacyMessages, (unsigned long)legacyBytes, (unsigned long)legacyTokens);
+    out.printf("batched documents:  %lu messages, %lu bytes, ~%lu tokens, %lu us worst build\n",
+               (unsigned long)bench.documents(), (unsigned long)bench.bytes(),
+               (unsigned long)batchedTokens, (unsigned long)worst);
+
+    bool all = true;
+    check(out, "batched: under a quarter of the tokens",
+          bench.documents() > 0 && batchedTokens * 4 < legacyTokens, all);
+
+    size_t len = 0;
+    bool fits = worstCaseFits(len);
+    out.printf("worst-case full snapshot: %u of %u bytes\n", (unsigned)len, (unsigned)CONTEXT_DOC_SIZE);
+    check(out, "full snapshot of every device fits", fits, all);
+    check(out, "overflow backs off for the min gap", overflowBacksOff(), all);
+    check(out, "failed publish stays pending", failedPublishKept(), all);
+
+    return all;
+}
@@ -0,0 +1,31 @@
+/*
+ * context_benchmark.h - Bytes and checks for the hub's ContextAggregator
+ *
+ * Runs one simulated hour with CONTEXT_BENCH_DEVICES devices reporting
+ * lux every 10 s: lights drift +-10%, rooms switch off one by one in the
+ * second half (dusk at 45 min), presence flips every ~5 min in 4 rooms.
+ * It prints the bytes and estimated tokens of the old per-sensor strings
+ * next to the batched documents, then checks that:
+ *
+ *   - the batched documents take under a quarter of the tokens
+ *   - a full snapshot of CONTEXT_MAX_DEVICES longest lines fits
+ *     CONTEXT_DOC_SIZE
+ *   - a document that does not fit backs off for the min gap
+ *   - a failed publish keeps its changes pending until one succeeds
+ *
+ * Enabled with CONTEXT_BENCHMARK in the hub sketch. It runs on the hub
+ * itself (no WiFi needed) and as the host test context_aggregator.
+ */
+
+#ifndef CONTEXT_BENCHMARK_H
+#define CONTEXT_BENCHMARK_H
+
+#include <Arduino.h>
+
+#define CONTEXT_BENCH_DEVICES  17
+#define CONTEXT_BENCH_SECONDS  3600
+
+// Returns true when every check passed
+bool runContextBenchmark(Print& out);
+
+#endif // CONTEXT_BENCHMARK_H
@@ -0,0 +1,166 @@
+/*
+ * light_aggregator.cpp - Implementation
+ */
+
+#include "light_aggregator.h"
+#include <string.h>
+
+#define WINDOW_MASK (LIGHT_WINDOW - 1)
+
+uint16_t RoomLight::mean() const {
+    uint32_t n = samples < LIGHT_WINDOW ? samples : LIGHT_WINDOW;
+    return n ? sum / n : 0;
+}
+
+LightAggregator::LightAggregator() {
+    memset(_slots, 0, sizeof(_slots));
+    memset(_used, 0, sizeof(_used));
+    memset(_order, 0, sizeof(_order));
+    _count = 0;
+    _active = 0;
+    _dark = 0;
+    _minRooms = 1;
+}
+
+uint32_t LightAggregator::hash(const char* id, size_t len) {
+    // FNV-1a (32-bit)
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)id[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Returns the slot holding `id`, or -(first empty slot) - 1 if absent
+int LightAggregator::probe(const char* id, size_t len, uint32_t h) const {
+    const size_t mask = LIGHT_MAX_ROOMS - 1;
+    size_t slot = h & mask;
+
+    for (size_t i = 0; i < LIGHT_MAX_ROOMS; i++) {
+        if (!_used[slot]) {
+            return -(int)slot - 1;
+        }
+        const RoomLight& r = _slots[slot];
+        if (r.hash == h && strncmp(r.id, id, len) == 0 && r.id[len] == '\0') {
+            return (int)slot;
+        }
+        slot = (slot + 1) & mask;  // Linear probing
+    }
+
+    return -(int)LIGHT_MAX_ROOMS - 1;  // Full, not found
+}
+
+RoomLight* LightAggregator::find(const char* id, size_t len) {
+    if (len == 0 || len >= LIGHT_ID_MAX_LEN) return nullptr;
+
+    int slot = probe(id, len, hash(id, len));
+    return slot >= 0 ? &_slots[slot] : nullptr;
+}
+
+void LightAggregator::addSample(RoomLight& room, uint16_t lux) {
+    uint32_t seq = room.samples++;
+    uint8_t slot = seq & WINDOW_MASK;
+
+    // Evict the sample leaving the window (it shares the new sample's slot)
+    if (seq >= LIGHT_WINDOW) {
+        uint32_t expired = seq - LIGHT_WINDOW;
+        room.sum -= room.window[slot];
+        if (room.minQ.size && room.minQ.seq[room.minQ.head] == expired) {
+            room.minQ.head = (room.minQ.head + 1) & WINDOW_MASK;
+            room.minQ.size--;
+        }
+        if (room.maxQ.size && room.maxQ.seq[room.maxQ.head] == expired) {
+            room.maxQ.head = (room.maxQ.head + 1) & WINDOW_MASK;
+            room.maxQ.size--;
+        }
+    }
+
+    room.window[slot] = lux;
+    room.sum += lux;
+
+    // Monotonic queues: drop entries from the back that can never be the
+    // min (or max) again. Amortised O(1) - each sample is pushed and popped once.
+    LightMonoQueue& mn = room.minQ;
+    while (mn.size && room.window[mn.seq[(mn.head + mn.size - 1) & WINDOW_MASK] & WINDOW_MASK] >= lux) {
+        mn.size--;
+    }
+    mn.seq[(mn.head + mn.size) & WINDOW_MASK] = seq;
+    mn.size++;
+
+    LightMonoQueue& mx = room.maxQ;
+    while (mx.size && room.window[mx.seq[(mx.head + mx.size - 1) & WINDOW_MASK] & WINDOW_MASK] <= lux) {
+        mx.size--;
+    }
+    mx.seq[(mx.head + mx.size) & WINDOW_MASK] = seq;
+    mx.size++;
+}
+
+LightUpdate LightAggregator::update(const char* id, size_t len, uint16_t lux, unsigned long now) {
+    if (len == 0 || len >= LIGHT_ID_MAX_LEN) return LIGHT_UPDATE_REJECTED;
+
+    uint32_t h = hash(id, len);
+    int slot = probe(id, len, h);
+
+    if (slot < 0) {
+        // Keep at least one slot free so probing always terminates
+        if (_count >= LIGHT_MAX_ROOMS - 1) return LIGHT_UPDATE_REJECTED;
+
+        slot = -slot - 1;
+        RoomLight& r = _slots[slot];
+        memset(&r, 0, sizeof(r));
+        memcpy(r.id, id, len);
+        r.id[len] = '\0';
+        r.hash = h;
+
+        _used[slot] = 1;
+        _order[_count++] = (uint8_t)slot;
+    }
+
+    RoomLight& room = _slots[slot];
+    addSample(room, lux);
+    room.lux = lux;
+    room.lastSeen = now;
+
+    // Room (re)joins the predicate
+    if (!room.active) {
+        room.active = true;
+        room.dark = lux < LIGHT_DARK_LUX;
+        _active++;
+        if (room.dark) _dark++;
+        return LIGHT_UPDATE_FLIPPED;
+    }
+
+    if (!room.dark && lux < LIGHT_DARK_LUX) {
+        room.dark = true;
+        _dark++;
+        return LIGHT_UPDATE_FLIPPED;
+    }
+
+    if (room.dark && lux >= LIGHT_BRIGHT_LUX) {
+        room.dark = false;
+        _dark--;
+        return LIGHT_UPDATE_FLIPPED;
+    }
+
+    return LIGHT_UPDATE_NONE;
+}
+
+bool LightAggregator::expire(unsigned long now) {
+    bool changed = false;
+
+    for (size_t i = 0; i < _count; i++) {
+        RoomLight& room = _slots[_order[i]];
+        if (!room.active || now - room.lastSeen < LIGHT_STALE_MS) continue;
+
+        room.active = false;
+        _active--;
+        if (room.dark) {
+            room.dark = false;
+            _dark--;
+        }
+        changed = true;
+    }
+
+    return changed;
+}
@@ -0,0 +1,99 @@
+/*
+ * light_aggregator.h - Per-room light aggregation for the KVN Hub
+ *
+ * Tracks the latest lux of every reporting device in a fixed-size
+ * open-addressed table, with a rolling min/max/mean over the last
+ * LIGHT_WINDOW samples per room. Every update is O(1): the mean is a
+ * running sum and min/max use monotonic queues.
+ *
+ * Each room is classified dark/light with hysteresis. The aggregator keeps
+ * counts of active and dark rooms, so the house-wide "all rooms dark"
+ * predicate is a comparison, and update() reports when a classification
+ * flipped so callers only re-evaluate modes when it can have changed.
+ */
+
+#ifndef LIGHT_AGGREGATOR_H
+#define LIGHT_AGGREGATOR_H
+
+#include <Arduino.h>
+
+#define LIGHT_MAX_ROOMS    32       // Slots (power of two, >= 2x device count)
+#define LIGHT_ID_MAX_LEN   24       // e.g. "esp32_c3_scout6"
+#define LIGHT_WINDOW       16       // Samples in the rolling window (power of two)
+#define LIGHT_DARK_LUX     50       // A room turns dark below this...
+#define LIGHT_BRIGHT_LUX   70       // ...and light again at or above this
+#define LIGHT_STALE_MS     600000   // Silent rooms leave the predicate after 10 min
+
+// Indices into a room's sample ring, front = oldest, values monotonic
+struct LightMonoQueue {
+    uint32_t seq[LIGHT_WINDOW];
+    uint8_t head;
+    uint8_t size;
+};
+
+struct RoomLight {
+    char id[LIGHT_ID_MAX_LEN];
+    uint32_t hash;
+    uint16_t lux;                 // Latest reading
+    unsigned long lastSeen;
+    bool dark;
+    bool active;                  // Reported within LIGHT_STALE_MS
+
+    uint16_t window[LIGHT_WINDOW];
+    uint32_t samples;             // Total samples (sequence of the next one)
+    uint32_t sum;                 // Sum over the window
+    LightMonoQueue minQ;
+    LightMonoQueue maxQ;
+
+    uint16_t min() const { return window[minQ.seq[minQ.head] & (LIGHT_WINDOW - 1)]; }
+    uint16_t max() const { return window[maxQ.seq[maxQ.head] & (LIGHT_WINDOW - 1)]; }
+    uint16_t mean() const;
+};
+
+enum LightUpdate {
+    LIGHT_UPDATE_NONE,      // Stored, classification unchanged
+    LIGHT_UPDATE_FLIPPED,   // Room joined, went dark or went light
+    LIGHT_UPDATE_REJECTED   // ID too long or table full
+};
+
+class LightAggregator {
+public:
+    LightAggregator();
+
+    // Record a reading for `id` (not necessarily NUL-terminated)
+    LightUpdate update(const char* id, size_t len, uint16_t lux, unsigned long now);
+
+    // Drop rooms silent for LIGHT_STALE_MS from the predicate.
+    // O(rooms); call every few seconds. Returns true if any room expired.
+    bool expire(unsigned long now);
+
+    // Rooms that must be reporting before allDark() can be true
+    void setMinRooms(uint8_t rooms) { _minRooms = rooms; }
+
+    bool allDark() const { return _active >= _minRooms && _active > 0 && _dark == _active; }
+    uint8_t activeCount() const { return _active; }
+    uint8_t darkCount() const { return _dark; }
+
+    RoomLight* find(const char* id, size_t len);
+
+    // Rooms in registration order
+    size_t size() const { return _count; }
+    const RoomLight& at(size_t index) const { return _slots[_order[index]]; }
+
+    static uint32_t hash(const char* id, size_t len);
+
+private:
+    RoomLight _slots[LIGHT_MAX_ROOMS];
+    uint8_t _used[LIGHT_MAX_ROOMS];
+    uint8_t _order[LIGHT_MAX_ROOMS];
+    size_t _count;
+
+    uint8_t _active;
+    uint8_t _dark;
+    uint8_t _minRooms;
+
+    int probe(const char* id, size_t len, uint32_t h) const;
+    void addSample(RoomLight& room, uint16_t lux);
+};
+
+#endif // LIGHT_AGGREGATOR_H
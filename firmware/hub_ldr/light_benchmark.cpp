@@ -0,0 +1,99 @@
+/*
+ * light_benchmark.cpp - Implementation
+ */
+
+#include "light_benchmark.h"
+#include "light_aggregator.h"
+#include <stdio.h>
+#include <string.h>
+
+// The lux a room reports at `tick` (10 Hz): lit, then dark from halfway
+static uint16_t benchLux(uint32_t tick) {
+    return tick < LIGHT_BENCH_SECONDS * 5 ? 120 + random(80) : 10 + random(20);
+}
+
+static void check(Print& out, const char* name, bool ok, bool& all) {
+    out.printf("  %-40s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) all = false;
+}
+
+bool runLightBenchmark(Print& out) {
+    static char ids[LIGHT_BENCH_DEVICES][LIGHT_ID_MAX_LEN];
+    static size_t lens[LIGHT_BENCH_DEVICES];
+    for (uint8_t d = 0; d < LIGHT_BENCH_DEVICES; d++) {
+        lens[d] = snprintf(ids[d], sizeof(ids[d]), "esp32_sim_%u", d);
+    }
+    const uint32_t ticks = LIGHT_BENCH_SECONDS * 10;
+
+    out.printf("\n=== Light aggregator: %u rooms at 10 Hz, %u s ===\n",
+               LIGHT_BENCH_DEVICES, LIGHT_BENCH_SECONDS);
+
+    // Timed pass (static: the aggregator is ~7 KB, too big for the loop stack)
+    static LightAggregator bench;
+    uint32_t flips = 0;
+    uint32_t messages = 0;
+    uint32_t worst = 0;
+    uint32_t start = micros();
+
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        for (uint8_t d = 0; d < LIGHT_BENCH_DEVICES; d++) {
+            uint16_t lux = benchLux(tick);
+            uint32_t t0 = micros();
+            if (bench.update(ids[d], lens[d], lux, tick * 100) == LIGHT_UPDATE_FLIPPED) flips++;
+            uint32_t dt = micros() - t0;
+            if (dt > worst) worst = dt;
+            messages++;
+        }
+    }
+
+    uint32_t elapsed = micros() - start;
+    out.printf("%lu messages, %.3f us/msg avg, %lu us worst, %lu flips\n",
+               (unsigned long)messages, (float)elapsed / messages, (unsigned long)worst,
+               (unsigned long)flips);
+
+    // Checked pass: a brute-force window per room next to the aggregator
+    static LightAggregator agg;
+    static uint16_t shadow[LIGHT_BENCH_DEVICES][LIGHT_WINDOW];
+    bool all = true;
+    bool windowOk = true;
+    bool litOk = true;
+    uint32_t checkedFlips = 0;
+
+    for (uint32_t tick = 0; tick < ticks; tick++) {
+        for (uint8_t d = 0; d < LIGHT_BENCH_DEVICES; d++) {
+            uint16_t lux = benchLux(tick);
+            if (agg.update(ids[d], lens[d], lux, tick * 100) == LIGHT_UPDATE_FLIPPED) checkedFlips++;
+            shadow[d][tick % LIGHT_WINDOW] = lux;
+
+            uint32_t n = tick + 1 < LIGHT_WINDOW ? tick + 1 : LIGHT_WINDOW;
+            uint16_t mn = 0xFFFF, mx = 0;
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < n; i++) {
+                uint16_t v = shadow[d][i];
+                if (v < mn) mn = v;
+                if (v > mx) mx = v;
+                sum += v;
+            }
+            const RoomLight* room = agg.find(ids[d], lens[d]);
+            if (!room || room->min() != mn || room->max() != mx || room->mean() != sum / n) {
+                windowOk = false;
+            }
+        }
+        if (tick == ticks / 2 - 1 && agg.allDark()) litOk = false;
+    }
+
+    check(out, "two flips per room", flips == 2 * LIGHT_BENCH_DEVICES && checkedFlips == flips, all);
+    check(out, "rolling min/max/mean match the window", windowOk, all);
+    check(out, "all dark only once every room is dark",
+          litOk && agg.allDark() && agg.darkCount() == LIGHT_BENCH_DEVICES, all);
+
+    // Everyone falls silent; one room keeps reporting
+    unsigned long last = (ticks - 1) * 100UL;
+    bool early = agg.expire(last + LIGHT_STALE_MS - 1);
+    agg.update(ids[0], lens[0], 15, last + LIGHT_STALE_MS / 2);
+    bool expired = agg.expire(last + LIGHT_STALE_MS);
+    check(out, "silent rooms expire after LIGHT_STALE_MS",
+          !early && expired && agg.activeCount() == 1 && agg.allDark(), all);
+
+    return all;
+}
@@ -0,0 +1,28 @@
+/*
+ * light_benchmark.h - Timing and checks for the hub's LightAggregator
+ *
+ * Feeds LIGHT_BENCH_DEVICES rooms at 10 Hz for LIGHT_BENCH_SECONDS:
+ * lights on for the first half, then off. It prints the average and
+ * worst µs per update, then checks that:
+ *
+ *   - every room flips exactly twice (joins light, goes dark)
+ *   - allDark() is false while lit and true once every room is dark
+ *   - the rolling min/max/mean match a brute-force window every update
+ *   - silent rooms expire after LIGHT_STALE_MS and leave the predicate
+ *
+ * Enabled with LIGHT_BENCHMARK in the hub sketch. It runs on the hub
+ * itself (no WiFi needed) and as the host test light_aggregator.
+ */
+
+#ifndef LIGHT_BENCHMARK_H
+#define LIGHT_BENCHMARK_H
+
+#include <Arduino.h>
+
+#define LIGHT_BENCH_DEVICES  17
+#define LIGHT_BENCH_SECONDS  60
+
+// Returns true when every check passed
+bool runLightBenchmark(Print& out);
+
+#endif // LIGHT_BENCHMARK_H
@@ -11,6 +11,7 @@
 #include <Arduino_GFX_Library.h>
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Router.h>
 #include <Wire.h>
 #include "TCA9554.h"
 #include "../secrets.h"
@@ -63,14 +64,18 @@ Arduino_GFX* gfx = new Arduino_AXS15231B(bus, -1, 1 /* rotation */, false /* IPS
 // ===== Network =====
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Router router;
 
 // ===== State =====
 unsigned long lastDisplayUpdate = 0;
 unsigned long lastMQTTCheck = 0;
 
+// Last message as shown on screen, cut to one line
+#define LINE_CHARS 50
 int messageCount = 0;
-String lastTopic = "";
-String lastMessage = "";
+char lastTopic[LINE_CHARS + 1] = "";
+char lastMessage[LINE_CHARS + 1] = "";
+char lastDevice[32] = "";
 unsigned long lastMessageTime = 0;
 bool tcaReady = false;
 
@@ -207,6 +212,8 @@ void setup() {
   // MQTT
   mqtt.setServer(MQTT_BROKER, MQTT_PORT);
   mqtt.setCallback(mqttCallback);
+  router.on("homeassistant/sensor/+/+", onDeviceMessage);
+  router.on("vanguard/+/+", onDeviceMessage);
 
   delay(3000);
 
@@ -224,8 +231,9 @@ void loop() {
     Serial.print("MQTT connecting...");
     if (mqtt.connect(DEVICE_ID, MQTT_USER, MQTT_PASS)) {
       Serial.println(" OK!");
-      mqtt.subscribe("homeassistant/sensor/+/+");
-      mqtt.subscribe("vanguard/+/+");
+      for (uint8_t i = 0; i < router.routeCount(); i++) {
+        mqtt.subscribe(router.pattern(i));
+      }
     } else {
       Serial.println(" Failed!");
     }
@@ -244,19 +252,29 @@ void loop() {
 
 // ===== MQTT Callback =====
 void mqttCallback(char* topic, byte* payload, unsigned int length) {
-  messageCount++;
+  router.dispatch(topic, payload, length);
+}
 
-  lastTopic = String(topic);
-  lastMessage = "";
-  for (unsigned int i = 0; i < length; i++) {
-    lastMessage += (char)payload[i];
+// Copy `len` bytes into a screen line, ending in "..." if they do not fit
+void copyLine(char* line, const char* text, size_t len) {
+  if (len > LINE_CHARS) {
+    memcpy(line, text, LINE_CHARS - 3);
+    memcpy(line + LINE_CHARS - 3, "...", 4);
+  } else {
+    memcpy(line, text, len);
+    line[len] = '\0';
   }
+}
+
+// homeassistant/sensor/<device>/<sensor> and vanguard/<device>/<field>
+void onDeviceMessage(const KVNTopicMatch& m) {
+  messageCount++;
+  copyLine(lastTopic, m.topic, strlen(m.topic));
+  copyLine(lastMessage, (const char*)m.payload, m.length);
+  if (!m[0].copyTo(lastDevice, sizeof(lastDevice))) lastDevice[0] = '\0';
   lastMessageTime = millis();
 
-  Serial.print("MQTT: ");
-  Serial.print(topic);
-  Serial.print(" = ");
-  Serial.println(lastMessage);
+  Serial.printf("MQTT: %s = %.*s\n", m.topic, (int)m.length, (const char*)m.payload);
 }
 
 // ===== Draw Status Screen =====
@@ -310,6 +328,14 @@ void drawStatus() {
   gfx->setTextColor(WHITE);
   gfx->println(messageCount);
 
+  // Device of the last message
+  gfx->setTextSize(1);
+  gfx->setTextColor(YELLOW);
+  gfx->setCursor(10, 202);
+  gfx->print("From: ");
+  gfx->setTextColor(WHITE);
+  gfx->println(lastDevice[0] ? lastDevice : "-");
+
   // Last message section
   gfx->setTextSize(1);
   gfx->setTextColor(MAGENTA);
@@ -318,10 +344,8 @@ void drawStatus() {
 
   gfx->setTextColor(WHITE);
   gfx->setCursor(10, 240);
-  if (lastTopic.length() > 0) {
-    String topic = lastTopic;
-    if (topic.length() > 50) topic = topic.substring(0, 47) + "...";
-    gfx->println(topic);
+  if (lastTopic[0]) {
+    gfx->println(lastTopic);
   } else {
     gfx->setTextColor(DARKGREY);
     gfx->println("Waiting for messages...");
@@ -333,10 +357,8 @@ void drawStatus() {
 
   gfx->setTextColor(WHITE);
   gfx->setCursor(10, 290);
-  if (lastMessage.length() > 0) {
-    String msg = lastMessage;
-    if (msg.length() > 50) msg = msg.substring(0, 47) + "...";
-    gfx->println(msg);
+  if (lastMessage[0]) {
+    gfx->println(lastMessage);
   } else {
     gfx->setTextColor(DARKGREY);
     gfx->println("Waiting for messages...");
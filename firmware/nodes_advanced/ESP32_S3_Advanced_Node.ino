@@ -1,5 +1,8 @@
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
+#include <KVN_RadarParser.h>
+#include <KVN_Presence.h>
 #include "s3_config.h"
 
 // WiFi and MQTT Config (Replace with secrets or shared config)
@@ -10,6 +13,13 @@ const uint16_t MQTT_PORT = 1883;
 
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+String clientId;
+String commandTopic;
+
+KVN_RadarParser radar;
+KVN_Presence presence;
+int radarZone;
 
 // Placeholder for Display Library (e.g., TFT_eSPI)
 // #include <TFT_eSPI.h>
@@ -26,26 +36,19 @@ String topicBase() {
   return String("vanguard/node/") + chipId();
 }
 
-void connectWiFi() {
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  int attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-    delay(500);
-    attempts++;
-  }
+void onRadarFrame(uint8_t id, const KVNRadarFrame& frame) {
+  presence.update(id, frame, millis());
 }
 
-void connectMQTT() {
-  mqtt.setServer(MQTT_HOST, MQTT_PORT);
-  while (!mqtt.connected()) {
-    String cid = String("s3-") + chipId();
-    if (mqtt.connect(cid.c_str())) {
-      mqtt.subscribe((topicBase() + "/#").c_str());
-    } else {
-      delay(2000);
-    }
-  }
+void publishPresence() {
+  const PresenceZone& zone = presence.zone(radarZone);
+
+  char payload[64];
+  snprintf(payload, sizeof(payload), "{\"occupied\":%s,\"distance\":%u}",
+           zone.occupied ? "true" : "false", zone.distance);
+
+  String topic = topicBase() + "/presence";
+  mqtt.publish(topic.c_str(), payload, true);
 }
 
 void setup() {
@@ -56,24 +59,29 @@ void setup() {
   // tft.setRotation(1);
   
   // Initialize UART Radar
-  Serial1.begin(115200, SERIAL_8N1, RADAR_RX, RADAR_TX);
+  Serial1.setRxBufferSize(RADAR_RX_BUFFER);
+  Serial1.begin(RADAR_BAUD, SERIAL_8N1, RADAR_RX, RADAR_TX);
+  radarZone = presence.addZone("node");
+  presence.addSource(0, radarZone);
+  radar.onFrame(onRadarFrame);
   
   // Initialize I2C
   // Wire.begin(I2C_SDA, I2C_SCL);
 
-  connectWiFi();
-  connectMQTT();
+  mqtt.setServer(MQTT_HOST, MQTT_PORT);
+  clientId = String("s3-") + chipId();
+  commandTopic = topicBase() + "/#";
+  conn.subscribe(commandTopic.c_str());
+  conn.begin(WIFI_SSID, WIFI_PASSWORD, clientId.c_str());
 }
 
 void loop() {
-  if (WiFi.status() != WL_CONNECTED) connectWiFi();
-  if (!mqtt.connected()) connectMQTT();
-  mqtt.loop();
+  conn.tick();
 
-  // Radar Reading Logic (Placeholder)
-  if (Serial1.available()) {
-    // Process radar data
+  radar.poll(Serial1);
+  if (presence.evaluate(millis()) && conn.connected()) {
+    publishPresence();
   }
-  
+
   delay(10);
 }
@@ -12,6 +12,8 @@
 // UART Radar (HIGH GPIOs to avoid I2S conflict!)
 #define RADAR_RX 44
 #define RADAR_TX 43
+#define RADAR_BAUD 115200
+#define RADAR_RX_BUFFER 1024
 
 // I2C (Optional)
 #define I2C_SDA 9
@@ -18,7 +18,9 @@
 
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
 #include <KVN_LDR.h>
+#include <KVN_JsonWriter.h>
 #include "secrets.h"
 
 // Node configuration - CHANGE THIS FOR EACH DEVICE!
@@ -28,6 +30,10 @@
 #define S3_LDR_PIN 1        // LDR analog input
 #define S3_DISPLAY_BL 10    // Display backlight PWM
 
+// Light readings go straight to Home Assistant, or through the relay's
+// coalescer ("vanguard/raw/"), which forwards them on the same HA topics
+#define SENSOR_TOPIC_PREFIX "homeassistant/sensor/"
+
 // Room names (customize per deployment)
 const char* ROOM_NAMES[] = {
     "Unknown",
@@ -60,6 +66,7 @@ const unsigned long MQTT_PUBLISH_INTERVAL = 60000; // 1 minute
 // Network clients
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
 
 // LDR sensor
 KVN_LDR roomLight(S3_LDR_PIN);
@@ -86,27 +93,26 @@ void setup() {
     Serial.println("Display backlight on GPIO " + String(S3_DISPLAY_BL));
 
     // Build MQTT topics
-    mqttTopicLux = "homeassistant/sensor/" + deviceId + "/lux";
-    mqttTopicAmbient = "homeassistant/sensor/" + deviceId + "/ambient_light";
+    mqttTopicLux = SENSOR_TOPIC_PREFIX + deviceId + "/lux";
+    mqttTopicAmbient = SENSOR_TOPIC_PREFIX + deviceId + "/ambient_light";
     mqttTopicRoomEvent = "vanguard/s3/" + deviceName + "/event";
     mqttTopicStatus = "homeassistant/sensor/" + deviceId + "/status";
 
-    // Connect to WiFi
-    connectWiFi();
-
     // Setup MQTT
     mqtt.setServer(MQTT_BROKER, MQTT_PORT);
 
+    // Connect WiFi + MQTT in the background
+    conn.setWill(mqttTopicStatus.c_str(), "offline", true);
+    conn.onConnect(onMqttConnected);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, deviceId.c_str(), MQTT_USER, MQTT_PASS);
+
     Serial.println("\nWatchtower ready!");
     Serial.println("Monitoring " + deviceName + " light levels\n");
 }
 
 void loop() {
-    // Maintain MQTT connection
-    if (!mqtt.connected()) {
-        reconnectMQTT();
-    }
-    mqtt.loop();
+    // Maintain WiFi + MQTT connection (non-blocking)
+    conn.tick();
 
     // Auto-brightness for display
     updateDisplayBrightness();
@@ -132,39 +138,16 @@ void loop() {
     delay(100);
 }
 
-void connectWiFi() {
-    Serial.print("Connecting to WiFi");
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(500);
-        Serial.print(".");
-    }
-
-    Serial.println(" Connected!");
+void onMqttConnected(PubSubClient& client) {
+    Serial.println("MQTT connected!");
     Serial.print("IP: ");
     Serial.println(WiFi.localIP());
-}
-
-void reconnectMQTT() {
-    while (!mqtt.connected()) {
-        Serial.print("Connecting to MQTT...");
-
-        if (mqtt.connect(deviceId.c_str(), MQTT_USER, MQTT_PASS)) {
-            Serial.println(" connected!");
-
-            // Publish online status
-            mqtt.publish(mqttTopicStatus.c_str(), "online", true);
 
-            // Publish Home Assistant auto-discovery
-            publishDiscovery();
+    // Publish online status
+    client.publish(mqttTopicStatus.c_str(), "online", true);
 
-        } else {
-            Serial.print(" failed, rc=");
-            Serial.println(mqtt.state());
-            delay(5000);
-        }
-    }
+    // Publish Home Assistant auto-discovery
+    publishDiscovery();
 }
 
 void updateDisplayBrightness() {
@@ -177,8 +160,9 @@ void updateDisplayBrightness() {
 
 void publishLightData() {
     // Publish full JSON to ambient_light topic
-    String json = roomLight.toJSON();
-    mqtt.publish(mqttTopicAmbient.c_str(), json.c_str());
+    char json[64];
+    roomLight.toJSON(json, sizeof(json));
+    mqtt.publish(mqttTopicAmbient.c_str(), json);
 
     // Publish lux value to individual topic (Home Assistant)
     mqtt.publish(mqttTopicLux.c_str(), String(roomLight.getLux()).c_str());
@@ -230,20 +214,41 @@ void publishDiscovery() {
     // Home Assistant MQTT Discovery for lux sensor
     String discoveryTopic = "homeassistant/sensor/" + deviceId + "_lux/config";
 
-    String discoveryPayload = "{";
-    discoveryPayload += "\"name\":\"" + deviceName + " Light\",";
-    discoveryPayload += "\"stat_t\":\"" + mqttTopicLux + "\",";
-    discoveryPayload += "\"unit_of_meas\":\"lx\",";
-    discoveryPayload += "\"dev_cla\":\"illuminance\",";
-    discoveryPayload += "\"uniq_id\":\"" + deviceId + "_lux\",";
-    discoveryPayload += "\"device\":{";
-    discoveryPayload += "\"identifiers\":[\"" + deviceId + "\"],";
-    discoveryPayload += "\"name\":\"" + deviceName + " Watchtower\",";
-    discoveryPayload += "\"model\":\"ESP32-S3 Watchtower\",";
-    discoveryPayload += "\"manufacturer\":\"KVN System\"";
-    discoveryPayload += "}}";
-
-    mqtt.publish(discoveryTopic.c_str(), discoveryPayload.c_str(), true);
+    char name[48];
+    char uniqueId[48];
+    char deviceLabel[48];
+    snprintf(name, sizeof(name), "%s Light", deviceName.c_str());
+    snprintf(uniqueId, sizeof(uniqueId), "%s_lux", deviceId.c_str());
+    snprintf(deviceLabel, sizeof(deviceLabel), "%s Watchtower", deviceName.c_str());
+
+    char payload[384];
+    KVN_JsonWriter json(payload, sizeof(payload));
+    json.addString("name", name);
+    // Home Assistant reads the homeassistant/sensor/ topic even when the
+    // relay forwards it for us
+    String stateTopic = "homeassistant/sensor/" + deviceId + "/lux";
+    json.addString("stat_t", stateTopic.c_str());
+    json.addString("unit_of_meas", "lx");
+    json.addString("dev_cla", "illuminance");
+    json.addString("uniq_id", uniqueId);
+    json.beginObject("device");
+    json.beginArray("identifiers");
+    json.addString(nullptr, deviceId.c_str());
+    json.endArray();
+    json.addString("name", deviceLabel);
+    json.addString("model", "ESP32-S3 Watchtower");
+    json.addString("manufacturer", "KVN System");
+    json.endObject();
+
+    if (!json.finish()) {
+        Serial.println("Discovery payload too large");
+        return;
+    }
+
+    // Discovery is larger than PubSubClient's default 256-byte packet
+    mqtt.beginPublish(discoveryTopic.c_str(), json.length(), true);
+    mqtt.write((const uint8_t*)payload, json.length());
+    mqtt.endPublish();
 
     Serial.println("Published Home Assistant discovery");
 }
@@ -17,9 +17,18 @@
 
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
+#include <KVN_JsonWriter.h>
+#include <KVN_Router.h>
+#include <KVN_Probe.h>
 #include <LovyanGFX.hpp>
-#include <map>
-#include <vector>
+#include <LittleFS.h>
+#include "device_table.h"
+#include "device_sim.h"
+#include "coalescer.h"
+#include "coalesce_trace.h"
+#include "message_queue.h"
+#include "relay_ui.h"
 
 // ==================== CONFIGURATION ====================
 #include "../secrets.h"
@@ -38,9 +47,24 @@
 #define RGB_LED_PIN 23
 
 // Device Configuration
-#define DEVICE_TIMEOUT_MS 30000  // Consider device offline after 30s
+#define DEVICE_TIMEOUT_MS 30000  // Consider device offline after 30s (longer for slow reporters)
+#define DEVICE_TOPIC_PREFIX "vanguard/relay/devices/"  // Retained online/offline per device
+#define DEVICE_SIMULATION 0      // 1 = replay 500 devices with dropouts on boot
+#define RAW_TOPIC_PREFIX "vanguard/raw/"  // Devices publish here to be coalesced...
+#define HA_TOPIC_PREFIX "homeassistant/sensor/"  // ...and the relay forwards here
+#define COALESCE_TRACE 0         // 1 = replay a scripted message trace on boot
 #define STATUS_UPDATE_INTERVAL 1000  // Update display every 1s
-#define BUFFER_SIZE 100  // Message buffer size
+#define BUFFER_SIZE 100  // Message buffer size (RAM slots)
+#define BUFFER_POLICY QUEUE_OVERWRITE_OLDEST  // or QUEUE_DROP_NEWEST
+#define BUFFER_SPILL_ENABLED true  // Spill to LittleFS when RAM is full
+#define BUFFER_SPILL_PATH "/mqtt_spill.bin"
+#define BUFFER_SPILL_MAX 5000  // Messages kept in flash (~1.1 MB)
+#define BUFFER_DRAIN_BATCH 5  // Max buffered messages published per loop()
+#define PROBE_REPORT_INTERVAL 10000  // Probe latency/loss report every 10s (0 = off)
+#define PROBE_NTP_SERVER "pool.ntp.org"  // Probe timestamps need wall-clock time
+#ifndef MQTT_RX_ECHO
+#define MQTT_RX_ECHO 0  // 1 = print every inbound message (debug: the UART caps RX at ~50 msg/s)
+#endif
 
 // ==================== LOVYANGFX DISPLAY SETUP ====================
 
@@ -111,17 +135,16 @@ public:
 // ==================== HARDWARE SETUP ====================
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+KVN_Router router;
 LGFX tft;
+FieldRenderer ui(tft);
 
 // ==================== GLOBAL STATE ====================
-struct DeviceStatus {
-    String name;
-    unsigned long lastSeen;
-    bool online;
-    int messageCount;
-};
+void relayPublish(const char* topic, const char* payload, bool retained);
 
-std::map<String, DeviceStatus> devices;
+DeviceTable devices(DEVICE_TIMEOUT_MS);
+Coalescer coalescer(relayPublish);
 unsigned long lastStatusUpdate = 0;
 unsigned long startTime = 0;
 int messagesRX = 0;
@@ -130,12 +153,47 @@ bool haOnline = false;
 int currentScreen = 0;  // 0=status, 1=devices, 2=traffic
 unsigned long lastButtonPress = 0;
 
+// Probe latency/loss, plus the longest loop() pass, per report window
+KVN_ProbeCollector probes;
+unsigned long lastProbeReport = 0;
+uint32_t loopMaxUs = 0;
+
 // Message buffer for failover
-struct BufferedMessage {
-    String topic;
-    String payload;
+QueuedMessage bufferSlots[BUFFER_SIZE];
+MessageQueue messageBuffer(bufferSlots, BUFFER_SIZE, BUFFER_POLICY);
+
+// ==================== UI FIELDS ====================
+// {x, y, height} - each field owns its rectangle on screen
+
+#define STATUS_FIELD_COUNT 9
+#define DEVICE_ROWS 8  // Max devices on screen
+
+UiField statusFields[STATUS_FIELD_COUNT] = {
+    {10, 44, 10},   // WiFi RSSI
+    {10, 55, 10},   // Signal bars
+    {10, 74, 10},   // MQTT
+    {10, 94, 10},   // Devices online
+    {10, 114, 10},  // RX
+    {10, 129, 10},  // TX
+    {10, 149, 10},  // Buffer
+    {10, 169, 10},  // HA
+    {10, 189, 10},  // Uptime
 };
-std::vector<BufferedMessage> messageBuffer;
+UiField& fieldWifi    = statusFields[0];
+UiField& fieldBars    = statusFields[1];
+UiField& fieldMqtt    = statusFields[2];
+UiField& fieldDevices = statusFields[3];
+UiField& fieldRX      = statusFields[4];
+UiField& fieldTX      = statusFields[5];
+UiField& fieldBuffer  = statusFields[6];
+UiField& fieldHA      = statusFields[7];
+UiField& fieldUptime  = statusFields[8];
+
+UiField deviceNameFields[DEVICE_ROWS];
+UiField deviceAgeFields[DEVICE_ROWS];
+UiField fieldDeviceSummary = {10, 289, 10};
+
+int renderedScreen = -1;  // Screen whose chrome is currently painted
 
 // ==================== DISPLAY FUNCTIONS ====================
 
@@ -152,6 +210,15 @@ void initDisplay() {
         analogSetAttenuation(ADC_11db);  // Full 0-3.3V range
     }
 
+    // Field sprites and device row layout
+    if (!ui.begin()) {
+        Serial.println("UI sprite allocation failed!");
+    }
+    for (int i = 0; i < DEVICE_ROWS; i++) {
+        deviceNameFields[i] = {10, (int16_t)(44 + i * 32), 10};
+        deviceAgeFields[i]  = {10, (int16_t)(56 + i * 32), 10};
+    }
+
     // Show boot screen
     tft.setTextColor(TFT_CYAN);
     tft.setTextSize(2);
@@ -196,7 +263,10 @@ void updateBacklight() {
     }
 }
 
-void drawStatusScreen() {
+// Static chrome is painted only when the screen changes; the fields
+// below are redrawn individually when their content changes.
+
+void drawStatusChrome() {
     tft.fillScreen(TFT_BLACK);
 
     // Title
@@ -208,118 +278,135 @@ void drawStatusScreen() {
     // Line separator
     tft.drawFastHLine(0, 35, 172, TFT_DARKGREY);
 
+    // Footer
+    tft.drawFastHLine(0, 300, 172, TFT_DARKGREY);
+    tft.setCursor(20, 310);
     tft.setTextSize(1);
+    tft.setTextColor(TFT_DARKGREY);
+    tft.println("[BOOT=Next Screen]");
+
+    FieldRenderer::invalidate(statusFields, STATUS_FIELD_COUNT);
+}
+
+void drawStatusScreen() {
+    char key[UI_KEY_MAX_LEN];
 
     // WiFi Status
-    tft.setCursor(10, 45);
-    tft.setTextColor(TFT_GREEN);
-    tft.print("WiFi: ");
     int rssi = WiFi.RSSI();
-    tft.print(rssi);
-    tft.println(" dBm");
+    snprintf(key, sizeof(key), "%d", rssi);
+    if (ui.beginField(fieldWifi, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_GREEN);
+        c.printf("WiFi: %d dBm", rssi);
+        ui.commit(fieldWifi);
+    }
 
     // Signal strength bars
     int bars = map(constrain(rssi, -100, -40), -100, -40, 0, 5);
-    for (int i = 0; i < 5; i++) {
-        if (i < bars) {
-            tft.fillCircle(15 + i * 12, 60, 3, TFT_GREEN);
-        } else {
-            tft.drawCircle(15 + i * 12, 60, 3, TFT_DARKGREY);
+    snprintf(key, sizeof(key), "%d", bars);
+    if (ui.beginField(fieldBars, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        for (int i = 0; i < 5; i++) {
+            if (i < bars) {
+                c.fillCircle(5 + i * 12, 4, 3, TFT_GREEN);
+            } else {
+                c.drawCircle(5 + i * 12, 4, 3, TFT_DARKGREY);
+            }
         }
+        ui.commit(fieldBars);
     }
 
     // MQTT Status
-    tft.setCursor(10, 75);
-    if (mqtt.connected()) {
-        tft.setTextColor(TFT_GREEN);
-        tft.println("MQTT: CONNECTED");
-    } else {
-        tft.setTextColor(TFT_RED);
-        tft.println("MQTT: OFFLINE");
+    bool connected = mqtt.connected();
+    if (ui.beginField(fieldMqtt, connected ? "1" : "0")) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(connected ? TFT_GREEN : TFT_RED);
+        c.print(connected ? "MQTT: CONNECTED" : "MQTT: OFFLINE");
+        ui.commit(fieldMqtt);
     }
 
     // Device count
-    int onlineCount = 0;
-    for (auto& device : devices) {
-        if (device.second.online) onlineCount++;
+    size_t onlineCount = devices.onlineCount();
+    snprintf(key, sizeof(key), "%u/%u", (unsigned)onlineCount, (unsigned)devices.size());
+    if (ui.beginField(fieldDevices, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_WHITE);
+        c.print("Devices: ");
+        c.setTextColor(TFT_YELLOW);
+        c.print(onlineCount);
+        c.setTextColor(TFT_DARKGREY);
+        c.print("/");
+        c.print(devices.size());
+        ui.commit(fieldDevices);
     }
 
-    tft.setCursor(10, 95);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("Devices: ");
-    tft.setTextColor(TFT_YELLOW);
-    tft.print(onlineCount);
-    tft.setTextColor(TFT_DARKGREY);
-    tft.print("/");
-    tft.println(devices.size());
-
     // Message stats
-    tft.setCursor(10, 115);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("RX: ");
-    tft.setTextColor(TFT_CYAN);
-    tft.println(messagesRX);
+    snprintf(key, sizeof(key), "%d", messagesRX);
+    if (ui.beginField(fieldRX, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_WHITE);
+        c.print("RX: ");
+        c.setTextColor(TFT_CYAN);
+        c.print(messagesRX);
+        ui.commit(fieldRX);
+    }
 
-    tft.setCursor(10, 130);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("TX: ");
-    tft.setTextColor(TFT_MAGENTA);
-    tft.println(messagesTX);
+    snprintf(key, sizeof(key), "%d", messagesTX);
+    if (ui.beginField(fieldTX, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_WHITE);
+        c.print("TX: ");
+        c.setTextColor(TFT_MAGENTA);
+        c.print(messagesTX);
+        ui.commit(fieldTX);
+    }
 
     // Buffer status
-    tft.setCursor(10, 150);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("Buffer: ");
-    if (messageBuffer.size() > 0) {
-        tft.setTextColor(TFT_YELLOW);
-    } else {
-        tft.setTextColor(TFT_GREEN);
+    size_t buffered = messageBuffer.size();
+    snprintf(key, sizeof(key), "%u", (unsigned)buffered);
+    if (ui.beginField(fieldBuffer, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_WHITE);
+        c.print("Buffer: ");
+        c.setTextColor(buffered > 0 ? TFT_YELLOW : TFT_GREEN);
+        c.print(buffered);
+        c.setTextColor(TFT_DARKGREY);
+        c.print("/");
+        c.print(BUFFER_SIZE);
+        ui.commit(fieldBuffer);
     }
-    tft.print(messageBuffer.size());
-    tft.setTextColor(TFT_DARKGREY);
-    tft.print("/");
-    tft.println(BUFFER_SIZE);
 
     // HA Broker status
-    tft.setCursor(10, 170);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("HA: ");
-    if (haOnline) {
-        tft.setTextColor(TFT_GREEN);
-        tft.println("ONLINE");
-    } else {
-        tft.setTextColor(TFT_RED);
-        tft.println("OFFLINE");
+    if (ui.beginField(fieldHA, haOnline ? "1" : "0")) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_WHITE);
+        c.print("HA: ");
+        c.setTextColor(haOnline ? TFT_GREEN : TFT_RED);
+        c.print(haOnline ? "ONLINE" : "OFFLINE");
+        ui.commit(fieldHA);
     }
 
-    // Uptime
+    // Uptime (minute resolution, so this redraws once a minute)
     unsigned long uptime = (millis() - startTime) / 1000;
     int days = uptime / 86400;
     int hours = (uptime % 86400) / 3600;
     int minutes = (uptime % 3600) / 60;
 
-    tft.setCursor(10, 190);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("Uptime: ");
-    tft.setTextColor(TFT_CYAN);
-    if (days > 0) {
-        tft.print(days);
-        tft.print("d ");
+    snprintf(key, sizeof(key), "%d/%d/%d", days, hours, minutes);
+    if (ui.beginField(fieldUptime, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_WHITE);
+        c.print("Uptime: ");
+        c.setTextColor(TFT_CYAN);
+        if (days > 0) {
+            c.printf("%dd ", days);
+        }
+        c.printf("%dh %dm", hours, minutes);
+        ui.commit(fieldUptime);
     }
-    tft.print(hours);
-    tft.print("h ");
-    tft.print(minutes);
-    tft.println("m");
-
-    // Footer
-    tft.drawFastHLine(0, 300, 172, TFT_DARKGREY);
-    tft.setCursor(20, 310);
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_DARKGREY);
-    tft.println("[BOOT=Next Screen]");
 }
 
-void drawDeviceScreen() {
+void drawDeviceChrome() {
     tft.fillScreen(TFT_BLACK);
 
     // Title
@@ -329,76 +416,77 @@ void drawDeviceScreen() {
     tft.println("DEVICES");
 
     tft.drawFastHLine(0, 35, 172, TFT_DARKGREY);
+    tft.drawFastHLine(0, 280, 172, TFT_DARKGREY);
 
-    tft.setTextSize(1);
-
-    // List devices
-    int y = 45;
-    int index = 0;
-    for (auto& device : devices) {
-        if (index >= 8) break;  // Max 8 devices on screen
-
-        tft.setCursor(10, y);
+    FieldRenderer::invalidate(deviceNameFields, DEVICE_ROWS);
+    FieldRenderer::invalidate(deviceAgeFields, DEVICE_ROWS);
+    fieldDeviceSummary.valid = false;
+}
 
-        // Status indicator
-        if (device.second.online) {
-            tft.setTextColor(TFT_GREEN);
-            tft.print("[OK]");
-        } else {
-            tft.setTextColor(TFT_RED);
-            tft.print("[--]");
-        }
+void drawDeviceScreen() {
+    char key[UI_KEY_MAX_LEN];
 
-        // Device name (truncate if too long)
-        tft.setTextColor(TFT_WHITE);
-        tft.print(" ");
-        String name = device.second.name;
-        if (name.length() > 12) {
-            name = name.substring(0, 12);
+    // List devices
+    for (size_t index = 0; index < devices.size() && index < DEVICE_ROWS; index++) {
+        DeviceStatus& device = devices.at(index);
+
+        // Status indicator + name (truncated to 12 chars)
+        snprintf(key, sizeof(key), "%d%.12s", device.online, device.name);
+        if (ui.beginField(deviceNameFields[index], key)) {
+            LGFX_Sprite& c = ui.canvas();
+            c.setTextColor(device.online ? TFT_GREEN : TFT_RED);
+            c.print(device.online ? "[OK]" : "[--]");
+            c.setTextColor(TFT_WHITE);
+            c.printf(" %.12s", device.name);
+            ui.commit(deviceNameFields[index]);
         }
-        tft.println(name);
 
         // Time since last message
-        tft.setCursor(30, y + 12);
-        tft.setTextColor(TFT_DARKGREY);
-        unsigned long elapsed = (millis() - device.second.lastSeen) / 1000;
+        unsigned long elapsed = (millis() - device.lastSeen) / 1000;
         if (elapsed < 60) {
-            tft.print(elapsed);
-            tft.println("s ago");
+            snprintf(key, sizeof(key), "%lus ago", elapsed);
         } else {
-            tft.print(elapsed / 60);
-            tft.println("m ago");
+            snprintf(key, sizeof(key), "%lum ago", elapsed / 60);
+        }
+        if (ui.beginField(deviceAgeFields[index], key)) {
+            LGFX_Sprite& c = ui.canvas();
+            c.setCursor(20, c.getCursorY());
+            c.setTextColor(TFT_DARKGREY);
+            c.print(key);
+            ui.commit(deviceAgeFields[index]);
         }
-
-        y += 32;
-        index++;
     }
 
     // Summary
-    int onlineCount = 0;
-    for (auto& device : devices) {
-        if (device.second.online) onlineCount++;
+    size_t onlineCount = devices.onlineCount();
+    snprintf(key, sizeof(key), "%u/%u", (unsigned)onlineCount, (unsigned)devices.size());
+    if (ui.beginField(fieldDeviceSummary, key)) {
+        LGFX_Sprite& c = ui.canvas();
+        c.setTextColor(TFT_YELLOW);
+        c.print(onlineCount);
+        c.setTextColor(TFT_WHITE);
+        c.printf("/%u Online", (unsigned)devices.size());
+        ui.commit(fieldDeviceSummary);
     }
-
-    tft.drawFastHLine(0, 280, 172, TFT_DARKGREY);
-    tft.setCursor(10, 290);
-    tft.setTextColor(TFT_YELLOW);
-    tft.print(onlineCount);
-    tft.setTextColor(TFT_WHITE);
-    tft.print("/");
-    tft.print(devices.size());
-    tft.println(" Online");
 }
 
 void updateDisplay() {
-    // Check device timeouts
-    for (auto& device : devices) {
-        if (millis() - device.second.lastSeen > DEVICE_TIMEOUT_MS) {
-            device.second.online = false;
+    if (currentScreen < 0 || currentScreen > 1) {
+        currentScreen = 0;
+    }
+
+    // Full repaint only when switching screens
+    if (currentScreen != renderedScreen) {
+        if (currentScreen == 0) {
+            drawStatusChrome();
+        } else {
+            drawDeviceChrome();
         }
+        renderedScreen = currentScreen;
     }
 
     // Update current screen
+    ui.beginFrame();
     switch (currentScreen) {
         case 0:
             drawStatusScreen();
@@ -406,92 +494,174 @@ void updateDisplay() {
         case 1:
             drawDeviceScreen();
             break;
-        default:
-            currentScreen = 0;
-            drawStatusScreen();
+    }
+    ui.endFrame();
+
+    if (ui.frameFields() > 0) {
+        Serial.printf("UI: %u fields, %lu bytes, %lu us\n", ui.frameFields(),
+                      (unsigned long)ui.frameBytes(), (unsigned long)ui.frameMicros());
     }
 }
 
 // ==================== MQTT FUNCTIONS ====================
 
+// Publish now if possible, otherwise store-and-forward.
+// Anything already buffered goes first so ordering is preserved.
+void relayPublish(const char* topic, const char* payload, bool retained) {
+    if (mqtt.connected() && messageBuffer.empty() &&
+        mqtt.publish(topic, payload, retained)) {
+        messagesTX++;
+        return;
+    }
+    messageBuffer.push(topic, payload, retained);
+}
+
 void mqttCallback(char* topic, byte* payload, unsigned int length) {
+    // Runs for every inbound message - must not allocate or block.
+    // The router matches the topic in place.
     messagesRX++;
 
-    // Convert payload to string
-    String message = "";
-    for (unsigned int i = 0; i < length; i++) {
-        message += (char)payload[i];
-    }
-
+#if MQTT_RX_ECHO
     Serial.print("MQTT RX: ");
     Serial.print(topic);
     Serial.print(" = ");
-    Serial.println(message);
+    Serial.write(payload, length);
+    Serial.println();
+#endif
 
-    // Extract device ID from topic
-    String topicStr = String(topic);
+    router.dispatch(topic, payload, length);
+}
 
-    // Look for device identifier in topic (e.g., esp32_XXXXXX)
-    int deviceIdStart = topicStr.indexOf("esp32_");
-    if (deviceIdStart >= 0) {
-        int deviceIdEnd = topicStr.indexOf("/", deviceIdStart);
-        if (deviceIdEnd < 0) deviceIdEnd = topicStr.length();
+// Count a message from a KVN device (esp32_XXXXXX); other IDs are ignored
+void trackDevice(const KVNTopicSpan& deviceId) {
+    if (deviceId.length < 6 || memcmp(deviceId.data, "esp32_", 6) != 0) return;
 
-        String deviceId = topicStr.substring(deviceIdStart, deviceIdEnd);
+    bool created = false;
+    DeviceStatus* device = devices.intern(deviceId.data, deviceId.length, nullptr, &created);
+    if (device == nullptr) return;  // ID too long or table full
 
-        // Update device status
-        if (devices.find(deviceId) == devices.end()) {
-            // New device discovered
-            devices[deviceId] = {deviceId, millis(), true, 1};
-            Serial.print("New device discovered: ");
-            Serial.println(deviceId);
-        } else {
-            // Update existing device
-            devices[deviceId].lastSeen = millis();
-            devices[deviceId].online = true;
-            devices[deviceId].messageCount++;
-        }
+    devices.seen(*device, millis());
+
+    if (created) {
+        Serial.print("New device discovered: ");
+        Serial.println(device->id);
+        relayPublish("vanguard/relay/discovered", device->id, false);
     }
 }
 
-void mqttReconnect() {
-    while (!mqtt.connected() && WiFi.status() == WL_CONNECTED) {
-        Serial.print("Connecting to MQTT...");
+// homeassistant/sensor/<device>/<metric>, vanguard/control/<device>/<command>
+void onDeviceMessage(const KVNTopicMatch& match) {
+    // Our own coalesced forwards come back through the wildcard; the device
+    // was already counted when its raw message arrived
+    if (coalescer.tracks(match.topic)) return;
 
-        if (mqtt.connect(MQTT_CLIENT_ID, MQTT_USER, MQTT_PASS)) {
-            Serial.println("connected!");
-            haOnline = true;
+    trackDevice(match[0]);
+}
 
-            // Subscribe to all KVN topics
-            mqtt.subscribe("homeassistant/sensor/+/+");
-            mqtt.subscribe("vanguard/control/+/+");
-            mqtt.subscribe("vanguard/ai/+");
+// vanguard/raw/<device>/<metric> - coalesced, then forwarded to
+// homeassistant/sensor/<device>/<metric>
+void onRawMessage(const KVNTopicMatch& match) {
+    trackDevice(match[0]);
 
-            Serial.println("Subscribed to KVN topics");
+    char topic[COALESCE_TOPIC_MAX_LEN];
+    int len = snprintf(topic, sizeof(topic), HA_TOPIC_PREFIX "%.*s/%.*s",
+                       (int)match[0].length, match[0].data,
+                       (int)match[1].length, match[1].data);
+    if (len < 0 || len >= (int)sizeof(topic)) return;
 
-            // Publish relay online status
-            mqtt.publish("vanguard/relay/status", "online");
-            messagesTX++;
+    char payload[QUEUE_PAYLOAD_MAX_LEN];
+    if (match.length >= sizeof(payload)) return;  // Could not be forwarded anyway
+    memcpy(payload, match.payload, match.length);
+    payload[match.length] = '\0';
 
-            // Flush buffered messages
-            if (messageBuffer.size() > 0) {
-                Serial.print("Flushing ");
-                Serial.print(messageBuffer.size());
-                Serial.println(" buffered messages...");
+    coalescer.offer(topic, payload, false, millis());
+}
 
-                for (auto& msg : messageBuffer) {
-                    mqtt.publish(msg.topic.c_str(), msg.payload.c_str());
-                    messagesTX++;
-                }
-                messageBuffer.clear();
-            }
+// Retained, so Home Assistant sees the current state after a restart:
+// vanguard/relay/devices/<id> = {"online":true,"rate_pm":2,"interval_ms":30012,"jitter_ms":40,...}
+void onDeviceTransition(const DeviceStatus& device, bool online) {
+    Serial.printf("Device %s %s\n", device.id, online ? "online" : "offline");
+
+    char topic[QUEUE_TOPIC_MAX_LEN];
+    snprintf(topic, sizeof(topic), DEVICE_TOPIC_PREFIX "%s", device.id);
+
+    char payload[128];
+    KVN_JsonWriter json(payload, sizeof(payload));
+    json.addBool("online", online);
+    json.addUInt("rate_pm", device.ratePerMinute());
+    json.addUInt("interval_ms", device.intervalMs());
+    json.addUInt("jitter_ms", device.jitterMs());
+    json.addUInt("messages", device.messageCount);
+    if (json.finish()) {
+        relayPublish(topic, payload, true);
+    }
+}
 
-        } else {
-            Serial.print("failed, rc=");
-            Serial.println(mqtt.state());
-            haOnline = false;
-            delay(5000);
-        }
+// vanguard/probe/<source> = "<seq>:<sent_us>" - see KVN_Probe
+void onProbeMessage(const KVNTopicMatch& match) {
+    probes.record(match[0].data, match[0].length, match.payload, match.length, KVN_Probe::nowUs());
+}
+
+// vanguard/relay/probe = {"received":980,"lost":2,...,"p50_us":1800,"p99_us":14000,"loop_max_us":41000}
+void publishProbeReport() {
+    const KVNProbeStats& ps = probes.stats();
+    char report[320];
+    KVN_JsonWriter json(report, sizeof(report));
+    json.addUInt("window_ms", millis() - lastProbeReport);
+    json.addUInt("sources", probes.sourceCount());
+    json.addUInt("received", ps.received);
+    json.addUInt("lost", ps.lost);
+    json.addUInt("late", ps.late);
+    json.addUInt("duplicates", ps.duplicates);
+    json.addUInt("restarts", ps.restarts);
+    json.addUInt("skewed", ps.skewed);
+    json.addUInt("min_us", ps.received ? ps.minUs : 0);
+    json.addUInt("mean_us", ps.meanUs());
+    json.addUInt("p50_us", probes.percentile(50));
+    json.addUInt("p90_us", probes.percentile(90));
+    json.addUInt("p99_us", probes.percentile(99));
+    json.addUInt("max_us", ps.maxUs);
+    json.addUInt("loop_max_us", loopMaxUs);
+    json.addUInt("rx", messagesRX);
+    if (json.finish()) {
+        mqtt.publish("vanguard/relay/probe", report);
+    }
+}
+
+// vanguard/ai/<topic> - counted and logged only
+void onAIMessage(const KVNTopicMatch& match) {
+    (void)match;
+}
+
+// Called by the connection manager after every successful (re)connect.
+// Subscriptions are restored by the manager itself.
+void onMqttConnected(PubSubClient& client) {
+    Serial.println("MQTT connected, subscribed to KVN topics");
+
+    // Publish relay online status
+    client.publish("vanguard/relay/status", "online");
+    messagesTX++;
+
+    // Buffered messages drain incrementally from loop()
+    if (!messageBuffer.empty()) {
+        Serial.print("Draining ");
+        Serial.print(messageBuffer.size());
+        Serial.println(" buffered messages...");
+    }
+}
+
+void onConnectionState(KVNConnState from, KVNConnState to) {
+    Serial.print("Connection: ");
+    Serial.print(KVN_Connection::stateName(from));
+    Serial.print(" -> ");
+    Serial.println(KVN_Connection::stateName(to));
+
+    if (to == KVN_CONN_MQTT_BACKOFF && from == KVN_CONN_WIFI_CONNECTING) {
+        Serial.print("WiFi connected, IP: ");
+        Serial.print(WiFi.localIP());
+        Serial.print(" RSSI: ");
+        Serial.print(WiFi.RSSI());
+        Serial.println(" dBm");
     }
 }
 
@@ -508,84 +678,87 @@ void setup() {
 
     startTime = millis();
 
+#if DEVICE_SIMULATION
+    runDeviceSimulation(Serial, DEVICE_TIMEOUT_MS);
+#endif
+#if COALESCE_TRACE
+    runCoalescerTrace(Serial);
+#endif
+
     // Initialize display
     initDisplay();
 
+    // Restore any buffered backlog from flash
+    if (BUFFER_SPILL_ENABLED) {
+        if (LittleFS.begin(true) &&
+            messageBuffer.beginSpill(LittleFS, BUFFER_SPILL_PATH, BUFFER_SPILL_MAX)) {
+            Serial.print("Buffer spill ready, ");
+            Serial.print(messageBuffer.spillSize());
+            Serial.println(" messages pending");
+        } else {
+            Serial.println("Buffer spill unavailable, RAM only");
+        }
+    }
+
     // Configure static IP
     if (!WiFi.config(RELAY_STATIC_IP, GATEWAY_IP, SUBNET_MASK, DNS_PRIMARY)) {
         Serial.println("Static IP configuration failed!");
     }
 
-    // Connect to WiFi
-    Serial.print("Connecting to WiFi: ");
-    Serial.println(WIFI_SSID);
-
-    tft.setCursor(30, 160);
-    tft.setTextColor(TFT_YELLOW);
-    tft.println("Connecting WiFi...");
-
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 30) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
-    }
-
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\nWiFi connected!");
-        Serial.print("IP: ");
-        Serial.println(WiFi.localIP());
-        Serial.print("RSSI: ");
-        Serial.print(WiFi.RSSI());
-        Serial.println(" dBm");
-
-        tft.fillRect(0, 160, 172, 20, TFT_BLACK);
-        tft.setCursor(30, 160);
-        tft.setTextColor(TFT_GREEN);
-        tft.println("WiFi Connected!");
-    } else {
-        Serial.println("\nWiFi connection failed!");
-        tft.setCursor(30, 160);
-        tft.setTextColor(TFT_RED);
-        tft.println("WiFi FAILED");
-        while (1) delay(1000);
-    }
-
     // Setup MQTT
     mqtt.setServer(MQTT_BROKER, MQTT_PORT);
     mqtt.setCallback(mqttCallback);
     mqtt.setBufferSize(2048);
 
-    tft.setCursor(30, 180);
-    tft.setTextColor(TFT_YELLOW);
-    tft.println("Connecting MQTT...");
-
-    mqttReconnect();
+    // Connect in the background - loop() keeps the display alive meanwhile
+    Serial.print("Connecting to WiFi: ");
+    Serial.println(WIFI_SSID);
 
-    if (mqtt.connected()) {
-        tft.fillRect(0, 180, 172, 20, TFT_BLACK);
-        tft.setCursor(30, 180);
-        tft.setTextColor(TFT_GREEN);
-        tft.println("MQTT Connected!");
+    tft.setCursor(30, 160);
+    tft.setTextColor(TFT_YELLOW);
+    tft.println("Connecting...");
+
+    // Subscribe to every routed KVN topic
+    router.on("homeassistant/sensor/+/+", onDeviceMessage);
+    router.on(RAW_TOPIC_PREFIX "+/+", onRawMessage);
+    router.on("vanguard/control/+/+", onDeviceMessage);
+    router.on("vanguard/ai/+", onAIMessage);
+#if PROBE_REPORT_INTERVAL
+    router.on(KVN_PROBE_TOPIC_PREFIX "+", onProbeMessage);
+#endif
+    for (uint8_t i = 0; i < router.routeCount(); i++) {
+        conn.subscribe(router.pattern(i));
     }
+    conn.setWill("vanguard/relay/status", "offline", false);
+    conn.onStateChange(onConnectionState);
+    conn.onConnect(onMqttConnected);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, MQTT_CLIENT_ID, MQTT_USER, MQTT_PASS);
+#if PROBE_REPORT_INTERVAL
+    // Probe latency compares the sender's clock with ours: sync once online
+    configTime(0, 0, PROBE_NTP_SERVER);
+#endif
 
     delay(2000);
 
     // Initialize devices with known KVN devices
-    devices["esp32_p4_hub"] = {"P4-Hub", 0, false, 0};
+    char id[DEVICE_ID_MAX_LEN];
+    char name[DEVICE_NAME_MAX_LEN];
+
+    devices.intern("esp32_p4_hub", strlen("esp32_p4_hub"), "P4-Hub");
     for (int i = 1; i <= 10; i++) {
-        String id = "esp32_s3_node" + String(i);
-        devices[id] = {"S3-Node-" + String(i), 0, false, 0};
+        int len = snprintf(id, sizeof(id), "esp32_s3_node%d", i);
+        snprintf(name, sizeof(name), "S3-Node-%d", i);
+        devices.intern(id, len, name);
     }
     for (int i = 1; i <= 6; i++) {
-        String id = "esp32_c3_scout" + String(i);
-        devices[id] = {"C3-Scout-" + String(i), 0, false, 0};
+        int len = snprintf(id, sizeof(id), "esp32_c3_scout%d", i);
+        snprintf(name, sizeof(name), "C3-Scout-%d", i);
+        devices.intern(id, len, name);
     }
 
     Serial.println("\nKVN MQTT Relay ready!");
-    Serial.println("Monitoring 17 devices...\n");
+    devices.onTransition(onDeviceTransition);
+    Serial.printf("Monitoring %u devices...\n\n", (unsigned)devices.size());
 
     // Show initial status screen
     updateDisplay();
@@ -594,20 +767,24 @@ void setup() {
 // ==================== MAIN LOOP ====================
 
 void loop() {
-    // Maintain WiFi connection
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("WiFi disconnected! Reconnecting...");
-        WiFi.reconnect();
-        delay(5000);
-    }
+    uint32_t loopStart = micros();
+
+    // Maintain WiFi + MQTT (non-blocking, services mqtt.loop())
+    conn.tick();
+    haOnline = conn.connected();
 
-    // Maintain MQTT connection
-    if (!mqtt.connected()) {
-        haOnline = false;
-        mqttReconnect();
-    } else {
-        haOnline = true;
-        mqtt.loop();
+    // Device timeouts: only the buckets of elapsed ticks are visited
+    devices.tick(millis());
+
+    // Forward values held back by a closed coalescing window
+    coalescer.poll(millis());
+
+    // Commit the flash backlog's header (batched while spilling)
+    messageBuffer.poll(millis());
+
+    if (haOnline) {
+        // Forward a bounded slice of the backlog each pass
+        messagesTX += messageBuffer.drain(mqtt, BUFFER_DRAIN_BATCH);
     }
 
     // Update display and backlight periodically
@@ -617,17 +794,40 @@ void loop() {
         lastStatusUpdate = millis();
 
         // Publish relay stats
-        if (mqtt.connected()) {
-            String stats = "{\"rx\":" + String(messagesRX) +
-                          ",\"tx\":" + String(messagesTX) +
-                          ",\"buffer\":" + String(messageBuffer.size()) +
-                          ",\"uptime\":" + String((millis() - startTime) / 1000) + "}";
-            mqtt.publish("vanguard/relay/stats", stats.c_str());
+        if (conn.connected()) {
+            const CoalesceStats& cs = coalescer.stats();
+            char stats[192];
+            KVN_JsonWriter json(stats, sizeof(stats));
+            json.addUInt("rx", messagesRX);
+            json.addUInt("tx", messagesTX);
+            json.addUInt("buffer", messageBuffer.size());
+            json.addUInt("dropped", messageBuffer.droppedCount());
+            json.addUInt("forwarded", cs.forwarded);
+            json.addUInt("coalesced", cs.coalesced);
+            json.addUInt("suppressed", cs.suppressed);
+            json.addUInt("uptime", (millis() - startTime) / 1000);
+            json.addUInt("heap_min", ESP.getMinFreeHeap());
+            if (json.finish()) {
+                mqtt.publish("vanguard/relay/stats", stats);
+            }
         }
     }
 
+#if PROBE_REPORT_INTERVAL
+    if (millis() - lastProbeReport >= PROBE_REPORT_INTERVAL) {
+        if (conn.connected()) publishProbeReport();
+        probes.reset();
+        loopMaxUs = 0;
+        lastProbeReport = millis();
+    }
+#endif
+
     // TODO: Add BOOT button handling to cycle screens
     // GPIO 9 is typically the BOOT button on ESP32-C6
 
+    // Work done this pass; the delay below comes on top
+    uint32_t loopUs = micros() - loopStart;
+    if (loopUs > loopMaxUs) loopMaxUs = loopUs;
+
     delay(10);  // Small delay to prevent WDT issues
 }
@@ -0,0 +1,202 @@
+/*
+ * coalesce_trace.cpp - Implementation
+ */
+
+#include "coalesce_trace.h"
+#include "coalescer.h"
+#include <string.h>
+
+enum TraceRoom { ROOM_STEADY, ROOM_CLOUDS, ROOM_FLICKER, ROOM_STEP, TRACE_ROOMS };
+
+static const char* const traceIds[TRACE_ROOMS] = {
+    "esp32_s3_node1", "esp32_s3_node2", "esp32_s3_node3", "esp32_s3_node4"
+};
+
+#define TRACE_TOPICS (TRACE_ROOMS * 2)   // lux + ambient_light per room
+
+struct TraceTopic {
+    char topic[COALESCE_TOPIC_MAX_LEN];
+    char offered[COALESCE_PAYLOAD_MAX];     // Last value sent to the coalescer
+    char forwarded[COALESCE_PAYLOAD_MAX];   // Last value Home Assistant saw
+    uint32_t received;
+    uint32_t sent;
+    unsigned long lastSent;
+    uint32_t minGap;
+    uint32_t maxSilence;
+    uint32_t stale;                         // Forwards of a value already replaced
+};
+
+static TraceTopic traceTopics[TRACE_TOPICS];
+static unsigned long traceNow;
+
+static uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352D;
+    x ^= x >> 15;
+    x *= 0x846CA68B;
+    x ^= x >> 16;
+    return x;
+}
+
+static TraceTopic* findTopic(const char* topic) {
+    for (size_t i = 0; i < TRACE_TOPICS; i++) {
+        if (strcmp(traceTopics[i].topic, topic) == 0) return &traceTopics[i];
+    }
+    return nullptr;
+}
+
+// Stands in for relayPublish()
+static void onTraceForward(const char* topic, const char* payload, bool retained) {
+    (void)retained;
+    TraceTopic* t = findTopic(topic);
+    if (t == nullptr) return;
+
+    // Gaps are measured over the hour itself, not the flush after it
+    if (t->sent > 0 && traceNow < TRACE_DURATION_MS) {
+        uint32_t gap = traceNow - t->lastSent;
+        if (gap < t->minGap) t->minGap = gap;
+        if (gap > t->maxSilence) t->maxSilence = gap;
+    }
+    if (strcmp(payload, t->offered) != 0) t->stale++;
+    strncpy(t->forwarded, payload, COALESCE_PAYLOAD_MAX - 1);
+    t->lastSent = traceNow;
+    t->sent++;
+}
+
+// One report from a room: the plain lux number and the KVN_LDR JSON
+static void report(Coalescer& coalescer, TraceRoom room, uint16_t lux, uint32_t& draw) {
+    uint16_t raw = lux * 4 + hash32(draw++) % 8;
+    const char* level = lux < 50 ? "dark" : lux < 300 ? "dim" : "bright";
+
+    for (size_t i = 0; i < 2; i++) {
+        TraceTopic& t = traceTopics[room * 2 + i];
+        if (i == 0) {
+            snprintf(t.offered, sizeof(t.offered), "%u", lux);
+        } else {
+            snprintf(t.offered, sizeof(t.offered), "{\"raw\":%u,\"lux\":%u,\"level\":\"%s\"}",
+                     raw, lux, level);
+        }
+        t.received++;
+        coalescer.offer(t.topic, t.offered, false, traceNow);
+    }
+}
+
+static bool check(Print& out, const char* name, bool ok) {
+    out.printf("  %-40s %s\n", name, ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+bool runCoalescerTrace(Print& out) {
+    Coalescer* coalescer = new Coalescer(onTraceForward);   // ~18 KB, trace only
+
+    memset(traceTopics, 0, sizeof(traceTopics));
+    for (size_t room = 0; room < TRACE_ROOMS; room++) {
+        snprintf(traceTopics[room * 2].topic, COALESCE_TOPIC_MAX_LEN,
+                 "homeassistant/sensor/%s/lux", traceIds[room]);
+        snprintf(traceTopics[room * 2 + 1].topic, COALESCE_TOPIC_MAX_LEN,
+                 "homeassistant/sensor/%s/ambient_light", traceIds[room]);
+    }
+    for (size_t i = 0; i < TRACE_TOPICS; i++) {
+        traceTopics[i].minGap = 0xFFFFFFFF;
+    }
+
+    out.printf("\n=== Relay coalescer trace: %u topics, 1 h, %u ms window ===\n",
+               TRACE_TOPICS, COALESCE_WINDOW_MS);
+
+    uint32_t draw = 1;
+    uint16_t clouds = 600;
+    uint32_t pollUs = 0, offerUs = 0;
+
+    for (traceNow = 0; traceNow < TRACE_DURATION_MS; traceNow += TRACE_TICK_MS) {
+        const unsigned long now = traceNow;
+        uint32_t t0 = micros();
+
+        // Steady: 120 +-1 lux once a minute
+        if (now % 60000 == 0) {
+            report(*coalescer, ROOM_STEADY, 119 + hash32(draw++) % 3, draw);
+        }
+
+        // Clouds: a random walk over 200-1000 lux every 2 s
+        if (now % 2000 == 0) {
+            int32_t step = (int32_t)(hash32(draw++) % 301) - 150;
+            int32_t next = (int32_t)clouds + step;
+            clouds = next < 200 ? 200 : next > 1000 ? 1000 : next;
+            report(*coalescer, ROOM_CLOUDS, clouds, draw);
+        }
+
+        // Flicker: a TV at 5 Hz between minutes 20 and 30, otherwise once a minute
+        bool tvOn = now >= 1200000 && now < 1800000;
+        if (tvOn ? now % 200 == 0 : now % 60000 == 0) {
+            uint16_t lux = tvOn ? ((now / 200) & 1 ? 90 : 40) + hash32(draw++) % 10 : 60;
+            report(*coalescer, ROOM_FLICKER, lux, draw);
+        }
+
+        // Step: dark until the lights go on at minute 40 (and settle a second later)
+        if (now % 60000 == 0 || now == 2400000 || now == 2401000) {
+            uint16_t lux = now < 2400000 ? 15 : now == 2400000 ? 430 : 450 + hash32(draw++) % 5;
+            report(*coalescer, ROOM_STEP, lux, draw);
+        }
+
+        offerUs += micros() - t0;
+
+        t0 = micros();
+        coalescer->poll(now);
+        pollUs += micros() - t0;
+    }
+
+    // One more window so anything still held back goes out
+    traceNow += COALESCE_WINDOW_MS;
+    coalescer->poll(traceNow);
+
+    // A last value inside the deadband is held back for up to a heartbeat:
+    // every room repeats its last report one heartbeat later
+    traceNow += COALESCE_HEARTBEAT_MS;
+    for (size_t i = 0; i < TRACE_TOPICS; i++) {
+        traceTopics[i].received++;
+        coalescer->offer(traceTopics[i].topic, traceTopics[i].offered, false, traceNow);
+    }
+    traceNow += COALESCE_WINDOW_MS;
+    coalescer->poll(traceNow);
+
+    uint32_t received = 0, sent = 0;
+    uint32_t stale = 0;
+    bool gapsOk = true, settledOk = true, heartbeatOk = true;
+
+    out.println("topic                                        received forwarded");
+    for (size_t i = 0; i < TRACE_TOPICS; i++) {
+        const TraceTopic& t = traceTopics[i];
+        out.printf("%-44s %8lu %9lu\n", t.topic, (unsigned long)t.received, (unsigned long)t.sent);
+        received += t.received;
+        sent += t.sent;
+
+        if (t.sent > 1 && t.minGap < COALESCE_WINDOW_MS) gapsOk = false;
+        stale += t.stale;
+        if (strcmp(t.forwarded, t.offered) != 0) {
+            settledOk = false;
+            out.printf("  %s ended on %s, last received %s\n", t.topic, t.forwarded, t.offered);
+        }
+        // The steady room reports once a minute
+        if (t.maxSilence > COALESCE_HEARTBEAT_MS + 60000) heartbeatOk = false;
+    }
+
+    const CoalesceStats& s = coalescer->stats();
+    out.printf("received %lu, forwarded %lu (%.1f%%), coalesced %lu, suppressed %lu, passthrough %lu\n",
+               (unsigned long)s.received, (unsigned long)s.forwarded,
+               s.received ? 100.0f * s.forwarded / s.received : 0.0f,
+               (unsigned long)s.coalesced, (unsigned long)s.suppressed,
+               (unsigned long)s.passthrough);
+    out.printf("offer() %.3f us/message, poll() %.3f us/tick\n",
+               (float)offerUs / s.received, (float)pollUs / (TRACE_DURATION_MS / TRACE_TICK_MS));
+
+    bool ok = true;
+    ok &= check(out, "counts add up", s.received == received && s.forwarded == sent &&
+                s.received == s.forwarded + s.coalesced + s.suppressed);
+    ok &= check(out, "at most one forward per window", gapsOk);
+    ok &= check(out, "every forward is the latest value", stale == 0);
+    ok &= check(out, "every topic ends on its last value", settledOk);
+    ok &= check(out, "unchanged topics keep a heartbeat", heartbeatOk);
+    ok &= check(out, "forwarded under a quarter of received", s.forwarded * 4 < s.received);
+
+    delete coalescer;
+    return ok;
+}
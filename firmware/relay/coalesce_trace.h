@@ -0,0 +1,31 @@
+/*
+ * coalesce_trace.h - Scripted message trace for the relay's coalescer
+ *
+ * Replays one hour of light-sensor traffic through a Coalescer: a steady
+ * room reporting every minute, a room under passing clouds reporting every
+ * two seconds, a TV flickering at 5 Hz for ten minutes, and a lights-on
+ * step. Each room sends a plain lux number plus the KVN_LDR JSON. It
+ * prints messages received and forwarded per topic and checks that:
+ *
+ *   - no topic is forwarded twice inside one window
+ *   - every forward carries the latest value offered on its topic
+ *   - every topic ends exactly on the last value it received, once each
+ *     room repeats its last report a heartbeat after the hour
+ *   - unchanged topics are still forwarded once per heartbeat
+ *
+ * Enabled with COALESCE_TRACE in the relay sketch. It runs on the relay
+ * itself (no WiFi needed) and as the host test coalesce_trace.
+ */
+
+#ifndef COALESCE_TRACE_H
+#define COALESCE_TRACE_H
+
+#include <Arduino.h>
+
+#define TRACE_DURATION_MS   3600000UL
+#define TRACE_TICK_MS       100
+
+// Returns true when every check passed
+bool runCoalescerTrace(Print& out);
+
+#endif // COALESCE_TRACE_H
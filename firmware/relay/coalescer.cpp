@@ -0,0 +1,175 @@
+/*
+ * coalescer.cpp - Implementation
+ */
+
+#include "coalescer.h"
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+static uint32_t fnv1a(const char* s, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+Coalescer::Coalescer(ForwardCallback forward) {
+    memset(_entries, 0, sizeof(_entries));
+    memset(_used, 0, sizeof(_used));
+    memset(&_stats, 0, sizeof(_stats));
+    _count = 0;
+    _pending = 0;
+    _forward = forward;
+    _windowMs = COALESCE_WINDOW_MS;
+    _heartbeatMs = COALESCE_HEARTBEAT_MS;
+    _deadbandAbs = COALESCE_DEADBAND_ABS;
+    _deadbandPct = COALESCE_DEADBAND_PCT;
+}
+
+// Returns the slot holding `topic`, or -(first empty slot) - 1 if absent
+int Coalescer::probe(const char* topic, size_t len, uint32_t h) const {
+    const size_t mask = COALESCE_MAX_TOPICS - 1;
+    size_t slot = h & mask;
+
+    for (size_t i = 0; i < COALESCE_MAX_TOPICS; i++) {
+        if (!_used[slot]) {
+            return -(int)slot - 1;
+        }
+        const CoalesceEntry& e = _entries[slot];
+        if (e.hash == h && strncmp(e.topic, topic, len) == 0 && e.topic[len] == '\0') {
+            return (int)slot;
+        }
+        slot = (slot + 1) & mask;  // Linear probing
+    }
+
+    return -(int)COALESCE_MAX_TOPICS - 1;  // Full, not found
+}
+
+// "523", "21.50", or {"raw":2093,"lux":523,...}
+bool Coalescer::valueOf(const char* payload, float& value) {
+    char* end;
+    if (*payload == '{') {
+        const char* field = strstr(payload, "\"" COALESCE_JSON_KEY "\":");
+        if (field == nullptr) return false;
+        field += sizeof(COALESCE_JSON_KEY) + 2;
+        value = strtof(field, &end);
+        return end != field;
+    }
+
+    if (*payload == '\0') return false;
+    value = strtof(payload, &end);
+    return *end == '\0';
+}
+
+bool Coalescer::duplicate(const CoalesceEntry& e, const char* payload, bool numeric, float value) const {
+    if (numeric && e.sentNumeric) {
+        float band = fabsf(e.sentValue) * _deadbandPct / 100.0f;
+        if (band < _deadbandAbs) band = _deadbandAbs;
+        return fabsf(value - e.sentValue) <= band;
+    }
+    return strcmp(payload, e.sent) == 0;
+}
+
+void Coalescer::send(CoalesceEntry& e, const char* payload, bool retained, unsigned long now) {
+    // `payload` may be e.pending; copy before forwarding from e.sent
+    if (payload != e.sent) strcpy(e.sent, payload);
+    e.sentNumeric = valueOf(e.sent, e.sentValue);
+    e.sentAt = now;
+
+    _stats.forwarded++;
+    if (_forward) _forward(e.topic, e.sent, retained);
+}
+
+void Coalescer::offer(const char* topic, const char* payload, bool retained, unsigned long now) {
+    _stats.received++;
+
+    size_t topicLen = strlen(topic);
+    size_t payloadLen = strlen(payload);
+    int slot = -1;
+    uint32_t h = 0;
+
+    if (topicLen > 0 && topicLen < COALESCE_TOPIC_MAX_LEN && payloadLen < COALESCE_PAYLOAD_MAX) {
+        h = fnv1a(topic, topicLen);
+        slot = probe(topic, topicLen, h);
+        if (slot < 0 && slot != -(int)COALESCE_MAX_TOPICS - 1) {
+            // First message on this topic: claim the slot and forward at once
+            slot = -slot - 1;
+            CoalesceEntry& e = _entries[slot];
+            memset(&e, 0, sizeof(e));
+            memcpy(e.topic, topic, topicLen + 1);
+            e.hash = h;
+            _used[slot] = 1;
+            _count++;
+            send(e, payload, retained, now);
+            return;
+        }
+    }
+
+    if (slot < 0) {
+        _stats.passthrough++;
+        _stats.forwarded++;
+        if (_forward) _forward(topic, payload, retained);
+        return;
+    }
+
+    CoalesceEntry& e = _entries[slot];
+    uint32_t age = (uint32_t)(now - e.sentAt);
+
+    // A new value supersedes any pending one, whether or not it is sent
+    if (e.hasPending) {
+        e.hasPending = false;
+        _pending--;
+        _stats.coalesced++;
+    }
+
+    // The deadband is applied here, against what HA last saw: a value back
+    // inside it leaves nothing to send
+    float value;
+    bool numeric = valueOf(payload, value);
+    if (age < _heartbeatMs && duplicate(e, payload, numeric, value)) {
+        _stats.suppressed++;
+        return;
+    }
+
+    if (age < _windowMs) {
+        // Window open: hold the latest value for poll()
+        memcpy(e.pending, payload, payloadLen + 1);
+        e.hasPending = true;
+        e.pendingRetained = retained;
+        _pending++;
+        return;
+    }
+
+    send(e, payload, retained, now);
+}
+
+size_t Coalescer::poll(unsigned long now) {
+    if (_pending == 0) return 0;
+
+    size_t sent = 0;
+    for (size_t slot = 0; slot < COALESCE_MAX_TOPICS && _pending > 0; slot++) {
+        if (!_used[slot]) continue;
+        CoalesceEntry& e = _entries[slot];
+        if (!e.hasPending) continue;
+
+        uint32_t age = (uint32_t)(now - e.sentAt);
+        if (age < _windowMs) continue;
+
+        // Passed the deadband when it arrived: the window closing sends it
+        e.hasPending = false;
+        _pending--;
+        send(e, e.pending, e.pendingRetained, now);
+        sent++;
+    }
+
+    return sent;
+}
+
+bool Coalescer::tracks(const char* topic) const {
+    size_t len = strlen(topic);
+    if (len == 0 || len >= COALESCE_TOPIC_MAX_LEN) return false;
+    return probe(topic, len, fnv1a(topic, len)) >= 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * coalescer.h - Per-topic message coalescing for the KVN MQTT Relay
+ *
+ * Sits between device traffic and Home Assistant. For every topic it
+ * keeps the value last forwarded and at most one pending value:
+ *
+ *   - The first message on a topic is forwarded at once and opens a
+ *     window of COALESCE_WINDOW_MS.
+ *   - Every later message is first compared with the last forwarded
+ *     value. Inside the deadband it is dropped (counted as suppressed),
+ *     unless COALESCE_HEARTBEAT_MS has passed since the last forward.
+ *     Either way it supersedes any pending value (counted as coalesced).
+ *   - A value outside the deadband becomes the pending one inside the
+ *     window, and is forwarded at once outside it.
+ *   - When the window closes, the pending value is forwarded and a new
+ *     window opens. So the latest real change always reaches HA, and once
+ *     a window has closed HA is within the deadband of the latest value.
+ *
+ * Numeric payloads ("123", "21.5") and JSON carrying a "lux" field (the
+ * KVN_LDR ambient_light document) use an absolute + relative deadband on
+ * that number; anything else is a duplicate only when byte-identical. Topics are
+ * kept in a fixed open-addressed table; when it is full, messages pass
+ * straight through.
+ */
+
+#ifndef COALESCER_H
+#define COALESCER_H
+
+#include <Arduino.h>
+
+#define COALESCE_MAX_TOPICS     64     // Topics tracked (power of two)
+#define COALESCE_TOPIC_MAX_LEN  64
+#define COALESCE_PAYLOAD_MAX    96
+#define COALESCE_WINDOW_MS      5000   // At most one forward per topic per window
+#define COALESCE_HEARTBEAT_MS   300000 // Forward an unchanged value at least this often
+#define COALESCE_DEADBAND_ABS   2.0f   // Numeric changes this small are duplicates...
+#define COALESCE_DEADBAND_PCT   5.0f   // ...or this small relative to the last value
+#define COALESCE_JSON_KEY       "lux"  // JSON field compared against the deadband
+
+struct CoalesceEntry {
+    char topic[COALESCE_TOPIC_MAX_LEN];
+    uint32_t hash;
+
+    char sent[COALESCE_PAYLOAD_MAX];      // Last forwarded payload
+    float sentValue;
+    bool sentNumeric;
+    unsigned long sentAt;
+
+    char pending[COALESCE_PAYLOAD_MAX];   // Latest value held back by the window
+    bool hasPending;
+    bool pendingRetained;
+};
+
+struct CoalesceStats {
+    uint32_t received;
+    uint32_t forwarded;
+    uint32_t coalesced;     // Replaced by a later value inside a window
+    uint32_t suppressed;    // Duplicates inside the deadband
+    uint32_t passthrough;   // Table full or topic/payload too long
+};
+
+class Coalescer {
+public:
+    typedef void (*ForwardCallback)(const char* topic, const char* payload, bool retained);
+
+    Coalescer(ForwardCallback forward);
+
+    void setWindow(uint32_t windowMs) { _windowMs = windowMs; }
+    void setHeartbeat(uint32_t heartbeatMs) { _heartbeatMs = heartbeatMs; }
+    void setDeadband(float absolute, float percent) { _deadbandAbs = absolute; _deadbandPct = percent; }
+
+    // A message for `topic` (the topic it will be forwarded on)
+    void offer(const char* topic, const char* payload, bool retained, unsigned long now);
+
+    // Forward pending values whose window has closed. Call from loop().
+    size_t poll(unsigned long now);
+
+    // The topic is forwarded by us (so its echo from the broker can be ignored)
+    bool tracks(const char* topic) const;
+
+    // The number a payload is compared by: the whole payload, or the
+    // COALESCE_JSON_KEY field of a JSON object. False if it has none.
+    static bool valueOf(const char* payload, float& value);
+
+    const CoalesceStats& stats() const { return _stats; }
+    size_t size() const { return _count; }
+
+private:
+    CoalesceEntry _entries[COALESCE_MAX_TOPICS];
+    uint8_t _used[COALESCE_MAX_TOPICS];
+    size_t _count;
+    size_t _pending;
+
+    ForwardCallback _forward;
+    uint32_t _windowMs;
+    uint32_t _heartbeatMs;
+    float _deadbandAbs;
+    float _deadbandPct;
+    CoalesceStats _stats;
+
+    int probe(const char* topic, size_t len, uint32_t h) const;
+    bool duplicate(const CoalesceEntry& e, const char* payload, bool numeric, float value) const;
+    void send(CoalesceEntry& e, const char* payload, bool retained, unsigned long now);
+};
+
+#endif // COALESCER_H
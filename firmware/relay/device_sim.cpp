@@ -0,0 +1,177 @@
+/*
+ * device_sim.cpp - Implementation
+ */
+
+#include "device_sim.h"
+#include "device_table.h"
+
+struct SimDevice {
+    uint32_t period;
+    unsigned long nextReport;
+    unsigned long dropEnd;      // Silent until then
+    uint32_t dropTimeout;       // timeoutFor() when the dropout began
+    bool dropping;
+    bool caught;                // Offline reported during this dropout
+};
+
+struct SimStats {
+    uint32_t messages;
+    uint32_t dropouts;
+    uint32_t expected;          // Dropouts longer than the device's timeout
+    uint32_t caught;
+    uint32_t falseOffline;
+    uint32_t learning;          // Offline before the second message (no interval yet)
+    uint32_t online;
+    uint32_t offline;
+};
+
+static SimDevice* simDevices;
+static DeviceTable* simTable;
+static SimStats simStats;
+
+static uint32_t hash32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352D;
+    x ^= x >> 15;
+    x *= 0x846CA68B;
+    x ^= x >> 16;
+    return x;
+}
+
+static void check(Print& out, const char* name, bool ok, bool& all) {
+    out.printf("  %-40s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) all = false;
+}
+
+static void onSimTransition(const DeviceStatus& device, bool online) {
+    if (online) {
+        simStats.online++;
+        return;
+    }
+
+    simStats.offline++;
+    SimDevice& d = simDevices[&device - &simTable->at(0)];
+    if (d.dropping && !d.caught) {
+        d.caught = true;
+        simStats.caught++;
+    } else if (!d.dropping && device.interval8 == 0) {
+        simStats.learning++;
+    } else if (!d.dropping) {
+        simStats.falseOffline++;
+    }
+}
+
+bool runDeviceSimulation(Print& out, uint32_t timeoutMs) {
+    // ~40 KB each; only allocated when the simulation runs
+    simTable = new DeviceTable(timeoutMs);
+    simDevices = new SimDevice[SIM_DEVICES];
+    memset(&simStats, 0, sizeof(simStats));
+
+    out.printf("\n=== Relay device simulation: %u devices, 1 h ===\n", SIM_DEVICES);
+
+    DeviceTable& table = *simTable;
+    table.onTransition(onSimTransition);
+
+    char id[DEVICE_ID_MAX_LEN];
+    for (uint16_t i = 0; i < SIM_DEVICES; i++) {
+        int len = snprintf(id, sizeof(id), "esp32_sim_%u", i);
+        table.intern(id, len);
+
+        SimDevice& d = simDevices[i];
+        memset(&d, 0, sizeof(d));
+        d.period = SIM_PERIOD_MIN_MS + hash32(i) % (SIM_PERIOD_MAX_MS - SIM_PERIOD_MIN_MS);
+        d.nextReport = hash32(i + 7919) % d.period;
+    }
+
+    uint32_t ticks = 0;
+    uint32_t wheelUs = 0, wheelWorst = 0;
+    uint32_t scanUs = 0, scanWorst = 0;
+    uint32_t seenUs = 0;
+    volatile uint32_t scanOffline = 0;   // Keeps the scan from being optimised out
+    uint32_t draw = 1;
+
+    for (unsigned long now = 0; now < SIM_DURATION_MS; now += DEVICE_TICK_MS) {
+        // Traffic for this tick
+        for (uint16_t i = 0; i < SIM_DEVICES; i++) {
+            SimDevice& d = simDevices[i];
+
+            if (d.dropping && now >= d.dropEnd) {
+                d.dropping = false;
+                d.nextReport = now;
+            }
+            if (d.dropping || now < d.nextReport) continue;
+
+            DeviceStatus& device = table.at(i);
+            uint32_t t0 = micros();
+            table.seen(device, now);
+            seenUs += micros() - t0;
+            simStats.messages++;
+
+            int32_t jitter = (int32_t)(hash32(draw++) % (d.period / 5)) - (int32_t)(d.period / 10);
+            d.nextReport = now + d.period + jitter;
+
+            if (hash32(draw++) % SIM_DROPOUT_ODDS == 0) {
+                // Silent from the next report for 1-10 min
+                uint32_t length = 60000 + hash32(draw++) % 540000;
+                d.dropping = true;
+                d.caught = false;
+                d.dropEnd = now + length;
+                d.dropTimeout = table.timeoutFor(device);
+                simStats.dropouts++;
+                if (length > d.dropTimeout + DEVICE_TICK_MS) simStats.expected++;
+            }
+        }
+
+        // Timer wheel
+        uint32_t t0 = micros();
+        table.tick(now);
+        uint32_t dt = micros() - t0;
+        wheelUs += dt;
+        if (dt > wheelWorst) wheelWorst = dt;
+
+        // The old per-tick scan over every device, for comparison
+        t0 = micros();
+        for (size_t i = 0; i < table.size(); i++) {
+            DeviceStatus& device = table.at(i);
+            if (device.messageCount && now - device.lastSeen > timeoutMs) scanOffline++;
+        }
+        dt = micros() - t0;
+        scanUs += dt;
+        if (dt > scanWorst) scanWorst = dt;
+
+        ticks++;
+    }
+
+    out.printf("%lu ticks of %u ms, %lu messages, %u online at the end\n",
+               (unsigned long)ticks, DEVICE_TICK_MS, (unsigned long)simStats.messages,
+               (unsigned)table.onlineCount());
+    out.printf("timer wheel %8.3f us/tick avg %5lu us worst\n",
+               (float)wheelUs / ticks, (unsigned long)wheelWorst);
+    out.printf("full scan   %8.3f us/tick avg %5lu us worst\n",
+               (float)scanUs / ticks, (unsigned long)scanWorst);
+    out.printf("seen()      %8.3f us/message\n", (float)seenUs / simStats.messages);
+    out.printf("dropouts %lu, longer than timeout %lu, caught %lu, false offline %lu\n",
+               (unsigned long)simStats.dropouts, (unsigned long)simStats.expected,
+               (unsigned long)simStats.caught, (unsigned long)simStats.falseOffline);
+    out.printf("slower than the %lu ms floor, offline before a second message: %lu\n",
+               (unsigned long)timeoutMs, (unsigned long)simStats.learning);
+    out.printf("transitions: %lu online, %lu offline\n",
+               (unsigned long)simStats.online, (unsigned long)simStats.offline);
+
+    // Every device comes online once, then again after each offline
+    // except those still silent at the end
+    uint32_t stillOffline = SIM_DEVICES - table.onlineCount();
+    bool all = true;
+    check(out, "every long dropout caught, no short one",
+          simStats.expected > 0 && simStats.caught == simStats.expected, all);
+    check(out, "no false offlines", simStats.falseOffline == 0, all);
+    check(out, "offline devices come back online",
+          simStats.online == SIM_DEVICES + simStats.offline - stillOffline, all);
+    check(out, "timer wheel cheaper than a full scan", wheelUs < scanUs, all);
+
+    delete[] simDevices;
+    delete simTable;
+    simDevices = nullptr;
+    simTable = nullptr;
+    return all;
+}
@@ -0,0 +1,35 @@
+/*
+ * device_sim.h - Device health simulator for the KVN MQTT Relay
+ *
+ * Replays one hour of traffic from SIM_DEVICES devices through a
+ * DeviceTable. Each device reports on its own period with +-10% jitter,
+ * and now and then drops out for 1-10 minutes. It prints the per-tick
+ * cost of the timer wheel next to a full scan of every device (what
+ * updateDisplay() used to do) and the cost of seen(), then checks that:
+ *
+ *   - every dropout longer than the device's timeout is caught, and
+ *     no shorter one
+ *   - no device goes offline while it is still reporting, once its
+ *     interval is known
+ *   - every device that went offline comes back online
+ *   - the timer wheel costs less per tick than the full scan
+ *
+ * Enabled with DEVICE_SIMULATION in the relay sketch. It runs on the
+ * relay itself (no WiFi needed) and as the host test device_sim.
+ */
+
+#ifndef DEVICE_SIM_H
+#define DEVICE_SIM_H
+
+#include <Arduino.h>
+
+#define SIM_DEVICES         500
+#define SIM_DURATION_MS     3600000UL
+#define SIM_PERIOD_MIN_MS   5000      // Report periods are spread over 5-60 s
+#define SIM_PERIOD_MAX_MS   60000
+#define SIM_DROPOUT_ODDS    300       // 1 in N reports starts a dropout
+
+// Returns true when every check passed
+bool runDeviceSimulation(Print& out, uint32_t timeoutMs);
+
+#endif // DEVICE_SIM_H
@@ -0,0 +1,129 @@
+/*
+ * device_table.cpp - Implementation
+ */
+
+#include "device_table.h"
+#include <string.h>
+
+#define SAMPLE_MAX_MS 3600000L   // Longer gaps (outages) count as one hour
+
+DeviceTable::DeviceTable(uint32_t timeoutMs)
+    : _wheel(DEVICE_TICK_MS) {
+    memset(_devices, 0, sizeof(_devices));
+    memset(_index, 0, sizeof(_index));
+    _count = 0;
+    _online = 0;
+    _timeoutMs = timeoutMs;
+    _transitionCb = nullptr;
+}
+
+uint32_t DeviceTable::hash(const char* id, size_t len) {
+    // FNV-1a (32-bit)
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)id[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Returns the index slot holding `id`, or -(first empty slot) - 1 if absent
+int DeviceTable::probe(const char* id, size_t len, uint32_t h) const {
+    const size_t mask = DEVICE_INDEX_SLOTS - 1;
+    size_t slot = h & mask;
+
+    for (size_t i = 0; i < DEVICE_INDEX_SLOTS; i++) {
+        if (_index[slot] == 0) {
+            return -(int)slot - 1;
+        }
+        const DeviceStatus& d = _devices[_index[slot] - 1];
+        if (d.hash == h && strncmp(d.id, id, len) == 0 && d.id[len] == '\0') {
+            return (int)slot;
+        }
+        slot = (slot + 1) & mask;  // Linear probing
+    }
+
+    return -(int)DEVICE_INDEX_SLOTS - 1;  // Full, not found
+}
+
+DeviceStatus* DeviceTable::find(const char* id, size_t len) {
+    if (len == 0 || len >= DEVICE_ID_MAX_LEN) return nullptr;
+
+    int slot = probe(id, len, hash(id, len));
+    return slot >= 0 ? &_devices[_index[slot] - 1] : nullptr;
+}
+
+DeviceStatus* DeviceTable::intern(const char* id, size_t len, const char* name, bool* created) {
+    if (created) *created = false;
+    if (len == 0 || len >= DEVICE_ID_MAX_LEN) return nullptr;
+
+    uint32_t h = hash(id, len);
+    int slot = probe(id, len, h);
+    if (slot >= 0) return &_devices[_index[slot] - 1];
+
+    // The index is at least twice the table, so probing always terminates
+    if (_count >= DEVICE_TABLE_MAX) return nullptr;
+
+    slot = -slot - 1;
+    DeviceStatus& d = _devices[_count];
+    memset(&d, 0, sizeof(d));
+    memcpy(d.id, id, len);
+    d.id[len] = '\0';
+    strncpy(d.name, name ? name : d.id, DEVICE_NAME_MAX_LEN - 1);
+    d.name[DEVICE_NAME_MAX_LEN - 1] = '\0';
+    d.hash = h;
+
+    _index[slot] = (uint16_t)(++_count);
+
+    if (created) *created = true;
+    return &d;
+}
+
+uint32_t DeviceTable::timeoutFor(const DeviceStatus& device) const {
+    uint32_t adaptive = 2 * device.intervalMs() + 4 * device.jitterMs();
+    return adaptive > _timeoutMs ? adaptive : _timeoutMs;
+}
+
+void DeviceTable::seen(DeviceStatus& device, unsigned long now) {
+    if (device.messageCount > 0) {
+        // Jacobson/Karels: interval += (sample - interval) / 8,
+        // jitter += (|sample - interval| - jitter) / 4, in scaled integers
+        int32_t sample = (int32_t)(now - device.lastSeen);
+        if (sample > SAMPLE_MAX_MS) sample = SAMPLE_MAX_MS;
+        if (device.interval8 == 0) {
+            device.interval8 = sample << 3;
+            device.jitter4 = sample << 1;
+        } else {
+            int32_t err = sample - (int32_t)(device.interval8 >> 3);
+            device.interval8 += err;
+            if (err < 0) err = -err;
+            device.jitter4 += err - (int32_t)(device.jitter4 >> 2);
+        }
+    }
+
+    device.lastSeen = now;
+    device.messageCount++;
+
+    uint16_t index = &device - _devices;
+    _wheel.schedule(index, now, timeoutFor(device));
+
+    if (!device.online) {
+        device.online = true;
+        _online++;
+        if (_transitionCb) _transitionCb(device, true);
+    }
+}
+
+void DeviceTable::expired(uint16_t index, void* context) {
+    DeviceTable* table = (DeviceTable*)context;
+    DeviceStatus& device = table->_devices[index];
+    if (!device.online) return;
+
+    device.online = false;
+    table->_online--;
+    if (table->_transitionCb) table->_transitionCb(device, false);
+}
+
+size_t DeviceTable::tick(unsigned long now) {
+    return _wheel.advance(now, expired, this);
+}
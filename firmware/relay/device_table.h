@@ -0,0 +1,96 @@
+/*
+ * device_table.h - Device registry and health tracking for the KVN MQTT Relay
+ *
+ * Devices live in a flat array in registration order, found through an
+ * open-addressed index keyed by FNV-1a of the device ID. All storage is
+ * preallocated, so lookups and inserts on the MQTT receive path never
+ * touch the heap.
+ *
+ * Every message re-arms the device's timeout on a timer wheel, so going
+ * offline is detected in O(1) per tick rather than by scanning every
+ * device. Each device keeps an EWMA of its message interval and jitter
+ * (integer, as in TCP's RTT estimator), and the timeout stretches to fit
+ * devices that report slowly or irregularly. Online/offline transitions
+ * are reported through a callback.
+ */
+
+#ifndef DEVICE_TABLE_H
+#define DEVICE_TABLE_H
+
+#include <Arduino.h>
+#include "timer_wheel.h"
+
+#define DEVICE_TABLE_MAX      TIMER_WHEEL_CAPACITY  // Devices
+#define DEVICE_INDEX_SLOTS    1024  // Index slots (power of two, >= 2x DEVICE_TABLE_MAX)
+#define DEVICE_ID_MAX_LEN     24    // e.g. "esp32_c3_scout6"
+#define DEVICE_NAME_MAX_LEN   16    // e.g. "C3-Scout-6"
+#define DEVICE_TICK_MS        100   // Timeout resolution
+
+struct DeviceStatus {
+    char id[DEVICE_ID_MAX_LEN];
+    char name[DEVICE_NAME_MAX_LEN];
+    uint32_t hash;
+    unsigned long lastSeen;
+    bool online;
+    int messageCount;
+
+    // Message interval EWMA (ms x 8, gain 1/8) and its mean deviation
+    // (ms x 4, gain 1/4). Zero until the second message.
+    uint32_t interval8;
+    uint32_t jitter4;
+
+    uint32_t intervalMs() const { return interval8 >> 3; }
+    uint32_t jitterMs() const { return jitter4 >> 2; }
+    // Messages per minute from the interval EWMA
+    uint32_t ratePerMinute() const { return interval8 ? 480000UL / interval8 : 0; }
+};
+
+class DeviceTable {
+public:
+    typedef void (*TransitionCallback)(const DeviceStatus& device, bool online);
+
+    // Devices go offline after `timeoutMs` of silence, or longer for slow
+    // or irregular reporters (2 x interval + 4 x jitter)
+    DeviceTable(uint32_t timeoutMs);
+
+    // Look up a device by ID (not necessarily NUL-terminated)
+    DeviceStatus* find(const char* id, size_t len);
+
+    // Look up a device, inserting it if missing. Returns nullptr when the
+    // ID is too long or the table is full. `created` reports a new entry.
+    DeviceStatus* intern(const char* id, size_t len, const char* name = nullptr,
+                         bool* created = nullptr);
+
+    // A message arrived: update stats, re-arm the timeout, and report the
+    // device online if it was not
+    void seen(DeviceStatus& device, unsigned long now);
+
+    // Fire due timeouts. Call often; cost is per elapsed tick, not per device.
+    size_t tick(unsigned long now);
+
+    void onTransition(TransitionCallback cb) { _transitionCb = cb; }
+
+    // Devices in registration order (stable for display)
+    size_t size() const { return _count; }
+    DeviceStatus& at(size_t index) { return _devices[index]; }
+
+    size_t onlineCount() const { return _online; }
+    uint32_t timeoutFor(const DeviceStatus& device) const;
+
+    static uint32_t hash(const char* id, size_t len);
+
+private:
+    DeviceStatus _devices[DEVICE_TABLE_MAX];
+    uint16_t _index[DEVICE_INDEX_SLOTS];   // Device index + 1, 0 = empty
+    size_t _count;
+    size_t _online;
+
+    uint32_t _timeoutMs;
+    TimerWheel _wheel;
+    TransitionCallback _transitionCb;
+
+    int probe(const char* id, size_t len, uint32_t h) const;
+    static void expired(uint16_t index, void* context);
+};
+
+#endif // DEVICE_TABLE_H
@@ -0,0 +1,201 @@
+/*
+ * message_queue.cpp - Implementation
+ */
+
+#include "message_queue.h"
+#include <string.h>
+
+#define SPILL_MAGIC 0x4B564E51  // "KVNQ"
+
+struct SpillHeader {
+    uint32_t magic;
+    uint32_t maxRecords;
+    uint32_t head;
+    uint32_t count;
+};
+
+MessageQueue::MessageQueue(QueuedMessage* slots, size_t capacity, QueuePolicy policy) {
+    _slots = slots;
+    _capacity = capacity;
+    _head = 0;
+    _count = 0;
+    _policy = policy;
+    _dropped = 0;
+
+    _fs = nullptr;
+    _spillMax = 0;
+    _spillHead = 0;
+    _spillCount = 0;
+    _headerDirty = false;
+    _headerSavedAt = 0;
+}
+
+bool MessageQueue::beginSpill(fs::FS& fs, const char* path, uint32_t maxRecords) {
+    _fs = &fs;
+    _spillMax = maxRecords;
+
+    bool exists = fs.exists(path);
+    _spill = fs.open(path, exists ? "r+" : "w+");
+    if (!_spill) {
+        _fs = nullptr;
+        return false;
+    }
+
+    // Resume a backlog persisted before the last reboot
+    SpillHeader header;
+    if (exists && _spill.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+        header.magic == SPILL_MAGIC && header.maxRecords == maxRecords &&
+        header.head < maxRecords && header.count <= maxRecords) {
+        _spillHead = header.head;
+        _spillCount = header.count;
+    } else {
+        _spillHead = 0;
+        _spillCount = 0;
+        spillWriteHeader();
+    }
+
+    return true;
+}
+
+bool MessageQueue::push(const char* topic, const char* payload, bool retained) {
+    size_t topicLen = strlen(topic);
+    size_t payloadLen = strlen(payload);
+
+    // Reject rather than truncate - a cut JSON payload is worse than none
+    if (topicLen >= QUEUE_TOPIC_MAX_LEN || payloadLen >= QUEUE_PAYLOAD_MAX_LEN) {
+        _dropped++;
+        return false;
+    }
+
+    // Once anything has spilled, new messages follow it to keep ordering
+    bool ramFull = _count == _capacity;
+    if (_fs != nullptr && (ramFull || _spillCount > 0)) {
+        QueuedMessage msg;
+        memcpy(msg.topic, topic, topicLen + 1);
+        memcpy(msg.payload, payload, payloadLen + 1);
+        msg.retained = retained;
+        return spillAppend(msg);
+    }
+
+    if (ramFull) {
+        _dropped++;
+        if (_policy == QUEUE_DROP_NEWEST) return false;
+        ramPopFront();
+    }
+
+    QueuedMessage& slot = ramTail();
+    memcpy(slot.topic, topic, topicLen + 1);
+    memcpy(slot.payload, payload, payloadLen + 1);
+    slot.retained = retained;
+    _count++;
+
+    return true;
+}
+
+size_t MessageQueue::drain(PubSubClient& mqtt, size_t budget) {
+    size_t sent = 0;
+
+    while (sent < budget) {
+        if (_count == 0 && _spillCount > 0) {
+            spillRefill();
+        }
+        if (_count == 0) break;
+
+        QueuedMessage& msg = _slots[_head];
+        if (!mqtt.publish(msg.topic, msg.payload, msg.retained)) break;
+
+        ramPopFront();
+        sent++;
+    }
+
+    return sent;
+}
+
+void MessageQueue::ramPopFront() {
+    _head = (_head + 1) % _capacity;
+    _count--;
+}
+
+// ==================== SPILL SEGMENT ====================
+
+size_t MessageQueue::spillOffset(uint32_t index) const {
+    return sizeof(SpillHeader) + (size_t)(index % _spillMax) * sizeof(QueuedMessage);
+}
+
+void MessageQueue::spillWriteHeader() {
+    SpillHeader header = {SPILL_MAGIC, _spillMax, _spillHead, _spillCount};
+    _spill.seek(0);
+    _spill.write((const uint8_t*)&header, sizeof(header));
+    _spill.flush();
+    _headerDirty = false;
+    _headerSavedAt = millis();
+}
+
+void MessageQueue::poll(uint32_t now) {
+    if (_headerDirty && now - _headerSavedAt >= QUEUE_SPILL_SYNC_MS) {
+        spillWriteHeader();
+    }
+}
+
+void MessageQueue::sync() {
+    if (_headerDirty) spillWriteHeader();
+}
+
+bool MessageQueue::spillAppend(const QueuedMessage& msg) {
+    if (_spillCount == _spillMax) {
+        _dropped++;
+        if (_policy == QUEUE_DROP_NEWEST) return false;
+
+        if (_count > 0) {
+            // RAM holds the oldest messages: drop its head and move the
+            // oldest spilled record up behind the rest of RAM
+            ramPopFront();
+            if (spillPopFront(ramTail())) _count++;
+        } else {
+            _spillHead = (_spillHead + 1) % _spillMax;
+            _spillCount--;
+        }
+    }
+
+    _spill.seek(spillOffset(_spillHead + _spillCount));
+    if (_spill.write((const uint8_t*)&msg, sizeof(msg)) != sizeof(msg)) {
+        _dropped++;
+        return false;
+    }
+    _spillCount++;
+
+    // The first record of an outage is committed at once so a reboot
+    // knows there is a backlog; after that, once per QUEUE_SPILL_SYNC_MS
+    _headerDirty = true;
+    if (_spillCount == 1) spillWriteHeader();
+    else poll(millis());
+    return true;
+}
+
+bool MessageQueue::spillPopFront(QueuedMessage& into) {
+    _spill.seek(spillOffset(_spillHead));
+    if (_spill.read((uint8_t*)&into, sizeof(QueuedMessage)) != sizeof(QueuedMessage)) {
+        // Unreadable segment - discard what is left of it
+        _dropped += _spillCount;
+        _spillCount = 0;
+        _spillHead = 0;
+        _headerDirty = true;
+        return false;
+    }
+    _spillHead = (_spillHead + 1) % _spillMax;
+    _spillCount--;
+    _headerDirty = true;
+    return true;
+}
+
+void MessageQueue::spillRefill() {
+    // RAM is empty here; pull the next batch in one pass so the header
+    // is rewritten once per batch rather than once per message
+    while (_count < _capacity && _spillCount > 0) {
+        if (!spillPopFront(ramTail())) break;
+        _count++;
+    }
+
+    if (_spillCount == 0) _spillHead = 0;
+    spillWriteHeader();
+}
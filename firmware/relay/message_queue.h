@@ -0,0 +1,94 @@
+/*
+ * message_queue.h - Store-and-forward queue for the KVN MQTT Relay
+ *
+ * Fixed-slab ring buffer of outbound MQTT messages, used while the
+ * broker is unreachable. When the RAM ring fills up, messages can spill
+ * to a circular LittleFS file so long outages survive a reboot.
+ * drain() publishes a bounded batch per call so it can run from loop()
+ * without stalling the radio.
+ */
+
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+#include <Arduino.h>
+#include <PubSubClient.h>
+#include <FS.h>
+
+#define QUEUE_TOPIC_MAX_LEN    64
+#define QUEUE_PAYLOAD_MAX_LEN  160
+
+// While spilling, the file header (head/count) is committed at most this
+// often; a reboot loses at most this much of the newest backlog
+#ifndef QUEUE_SPILL_SYNC_MS
+#define QUEUE_SPILL_SYNC_MS    5000
+#endif
+
+enum QueuePolicy {
+    QUEUE_OVERWRITE_OLDEST,  // Full queue drops its oldest message (RAM before flash)
+    QUEUE_DROP_NEWEST        // Full queue rejects the incoming message
+};
+
+struct QueuedMessage {
+    char topic[QUEUE_TOPIC_MAX_LEN];
+    char payload[QUEUE_PAYLOAD_MAX_LEN];
+    bool retained;
+};
+
+class MessageQueue {
+public:
+    MessageQueue(QueuedMessage* slots, size_t capacity, QueuePolicy policy = QUEUE_OVERWRITE_OLDEST);
+
+    // Enable the LittleFS spill segment (call after LittleFS.begin()).
+    // Reloads any backlog left over from before a reboot.
+    bool beginSpill(fs::FS& fs, const char* path, uint32_t maxRecords);
+
+    // Queue a message. Returns false if it was rejected or truncated.
+    bool push(const char* topic, const char* payload, bool retained = false);
+
+    // Publish up to `budget` messages. Stops early on publish failure.
+    size_t drain(PubSubClient& mqtt, size_t budget);
+
+    // Commit the spill header if it is stale by QUEUE_SPILL_SYNC_MS.
+    // Call from loop(), online or not.
+    void poll(uint32_t now);
+
+    // Commit the spill header now (e.g. before a planned restart)
+    void sync();
+
+    size_t size() const { return _count + _spillCount; }
+    size_t ramSize() const { return _count; }
+    size_t spillSize() const { return _spillCount; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return size() == 0; }
+
+    uint32_t droppedCount() const { return _dropped; }
+
+private:
+    QueuedMessage* _slots;
+    size_t _capacity;
+    size_t _head;
+    size_t _count;
+    QueuePolicy _policy;
+    uint32_t _dropped;
+
+    // Spill segment: circular file of fixed-size records after a header
+    fs::FS* _fs;
+    File _spill;
+    uint32_t _spillMax;
+    uint32_t _spillHead;
+    uint32_t _spillCount;
+    bool _headerDirty;
+    uint32_t _headerSavedAt;
+
+    QueuedMessage& ramTail() { return _slots[(_head + _count) % _capacity]; }
+    void ramPopFront();
+
+    bool spillAppend(const QueuedMessage& msg);
+    bool spillPopFront(QueuedMessage& into);
+    void spillRefill();
+    void spillWriteHeader();
+    size_t spillOffset(uint32_t index) const;
+};
+
+#endif // MESSAGE_QUEUE_H
@@ -0,0 +1,83 @@
+/*
+ * relay_ui.cpp - Implementation
+ */
+
+#include "relay_ui.h"
+#include <string.h>
+
+FieldRenderer::FieldRenderer(lgfx::LGFX_Device& tft)
+    : _tft(tft) {
+    _active = 0;
+    _pending[0] = false;
+    _pending[1] = false;
+    _frameStart = 0;
+    _frameBytes = 0;
+    _frameMicros = 0;
+    _frameFields = 0;
+}
+
+bool FieldRenderer::begin() {
+    for (auto& sprite : _sprites) {
+        sprite.setColorDepth(16);
+        if (!sprite.createSprite(UI_FIELD_WIDTH, UI_FIELD_MAX_H)) {
+            return false;
+        }
+        sprite.setTextSize(1);
+    }
+    return true;
+}
+
+void FieldRenderer::beginFrame() {
+    _frameStart = micros();
+    _frameBytes = 0;
+    _frameFields = 0;
+    _tft.startWrite();
+}
+
+void FieldRenderer::endFrame() {
+    _tft.waitDMA();
+    _pending[0] = false;
+    _pending[1] = false;
+    _tft.endWrite();
+    _frameMicros = micros() - _frameStart;
+}
+
+bool FieldRenderer::beginField(UiField& field, const char* key) {
+    if (field.valid && strncmp(field.key, key, UI_KEY_MAX_LEN) == 0) {
+        return false;
+    }
+
+    strncpy(field.key, key, UI_KEY_MAX_LEN - 1);
+    field.key[UI_KEY_MAX_LEN - 1] = '\0';
+
+    // Compose into the other sprite; wait only if it is still in flight
+    _active ^= 1;
+    if (_pending[_active]) {
+        _tft.waitDMA();
+        _pending[_active] = false;
+    }
+
+    LGFX_Sprite& sprite = canvas();
+    sprite.fillRect(0, 0, UI_FIELD_WIDTH, field.h, TFT_BLACK);
+    sprite.setCursor(0, (field.h - 8) / 2);
+    return true;
+}
+
+void FieldRenderer::commit(UiField& field) {
+    // Rows 0..h-1 of the sprite are contiguous at the shared stride
+    _tft.pushImageDMA(field.x, field.y, UI_FIELD_WIDTH, field.h,
+                      (lgfx::swap565_t*)canvas().getBuffer());
+    // One transfer at a time: starting this one finished the other sprite's
+    _pending[_active ^ 1] = false;
+    _pending[_active] = true;
+    field.valid = true;
+
+    _frameBytes += (uint32_t)UI_FIELD_WIDTH * field.h * 2;
+    _frameFields++;
+}
+
+void FieldRenderer::invalidate(UiField* fields, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        fields[i].valid = false;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * relay_ui.h - Retained-mode field rendering for the KVN MQTT Relay
+ *
+ * Each on-screen field owns a fixed rectangle and remembers the key it
+ * was last rendered with. A frame only redraws fields whose key changed:
+ * the field is composed into an off-screen sprite and pushed to the
+ * panel with DMA, so the rest of the screen is never touched.
+ *
+ * Two sprites are used alternately so the next field can be composed
+ * while the previous one is still being transferred. Each sprite has a
+ * pending flag: composing only waits when the sprite it reuses is the
+ * one still on the wire.
+ */
+
+#ifndef RELAY_UI_H
+#define RELAY_UI_H
+
+#include <LovyanGFX.hpp>
+
+#define UI_FIELD_WIDTH   162  // All fields share one stride (x = 10..171)
+#define UI_FIELD_MAX_H   12
+#define UI_KEY_MAX_LEN   32
+
+struct UiField {
+    int16_t x;
+    int16_t y;
+    int16_t h;
+    char key[UI_KEY_MAX_LEN];  // What was last rendered
+    bool valid;
+};
+
+class FieldRenderer {
+public:
+    FieldRenderer(lgfx::LGFX_Device& tft);
+
+    bool begin();
+
+    // Frame bracketing: collects bytes pushed and render time
+    void beginFrame();
+    void endFrame();
+
+    // Returns false if `key` matches what the field already shows.
+    // Otherwise clears the canvas and returns true; draw into canvas()
+    // at field-relative coordinates, then call commit().
+    bool beginField(UiField& field, const char* key);
+    void commit(UiField& field);
+
+    LGFX_Sprite& canvas() { return _sprites[_active]; }
+
+    // Forget everything on screen (e.g. after a full-screen repaint)
+    static void invalidate(UiField* fields, size_t count);
+
+    uint32_t frameBytes() const { return _frameBytes; }
+    uint32_t frameMicros() const { return _frameMicros; }
+    uint16_t frameFields() const { return _frameFields; }
+
+private:
+    lgfx::LGFX_Device& _tft;
+    LGFX_Sprite _sprites[2];
+    uint8_t _active;
+    bool _pending[2];  // Sprite may still be read by DMA
+
+    uint32_t _frameStart;
+    uint32_t _frameBytes;
+    uint32_t _frameMicros;
+    uint16_t _frameFields;
+};
+
+#endif // RELAY_UI_H
@@ -0,0 +1,123 @@
+/*
+ * timer_wheel.cpp - Implementation
+ */
+
+#include "timer_wheel.h"
+
+#define L0_MASK (TIMER_WHEEL_L0_SIZE - 1)
+#define L1_MASK (TIMER_WHEEL_L1_SIZE - 1)
+
+TimerWheel::TimerWheel(uint32_t tickMs) {
+    for (size_t i = 0; i < TIMER_WHEEL_CAPACITY; i++) {
+        _nodes[i].expires = 0;
+        _nodes[i].next = TIMER_NONE;
+        _nodes[i].prev = TIMER_NONE;
+        _nodes[i].bucket = TIMER_NONE;
+    }
+    for (size_t i = 0; i < TIMER_WHEEL_BUCKETS; i++) {
+        _buckets[i] = TIMER_NONE;
+    }
+    _tickMs = tickMs ? tickMs : 1;
+    _tick = 0;
+    _lastMs = 0;
+    _started = false;
+}
+
+// The first call pins tick 0 to millis()
+void TimerWheel::sync(unsigned long now) {
+    if (_started) return;
+    _lastMs = now;
+    _started = true;
+}
+
+void TimerWheel::link(uint16_t id, uint16_t bucket) {
+    TimerNode& n = _nodes[id];
+    n.bucket = bucket;
+    n.prev = TIMER_NONE;
+    n.next = _buckets[bucket];
+    if (n.next != TIMER_NONE) _nodes[n.next].prev = id;
+    _buckets[bucket] = id;
+}
+
+void TimerWheel::unlink(uint16_t id) {
+    TimerNode& n = _nodes[id];
+    if (n.prev != TIMER_NONE) _nodes[n.prev].next = n.next;
+    else _buckets[n.bucket] = n.next;
+    if (n.next != TIMER_NONE) _nodes[n.next].prev = n.prev;
+
+    n.next = TIMER_NONE;
+    n.prev = TIMER_NONE;
+    n.bucket = TIMER_NONE;
+}
+
+// Bucket for the node's expiry, relative to the current tick
+void TimerWheel::place(uint16_t id) {
+    uint32_t expires = _nodes[id].expires;
+    int32_t delta = (int32_t)(expires - _tick);
+
+    if (delta <= 0) {
+        link(id, _tick & L0_MASK);  // Overdue: fires on this tick
+    } else if (delta < TIMER_WHEEL_L0_SIZE) {
+        link(id, expires & L0_MASK);
+    } else {
+        uint32_t blocks = (expires >> TIMER_WHEEL_L0_BITS) - (_tick >> TIMER_WHEEL_L0_BITS);
+        // Never the bucket being cascaded: too far out waits in the farthest one
+        if (blocks >= TIMER_WHEEL_L1_SIZE) blocks = TIMER_WHEEL_L1_SIZE - 1;
+        uint32_t slot = ((_tick >> TIMER_WHEEL_L0_BITS) + blocks) & L1_MASK;
+        link(id, TIMER_WHEEL_L0_SIZE + slot);
+    }
+}
+
+void TimerWheel::schedule(uint16_t id, unsigned long now, uint32_t delayMs) {
+    if (id >= TIMER_WHEEL_CAPACITY) return;
+    sync(now);
+    if (armed(id)) unlink(id);
+
+    // Relative to the last processed tick, rounded up to whole ticks
+    uint32_t ms = (uint32_t)(now - _lastMs) + delayMs;
+    uint32_t ticks = (ms + _tickMs - 1) / _tickMs;
+    if (ticks == 0) ticks = 1;
+
+    _nodes[id].expires = _tick + ticks;
+    place(id);
+}
+
+void TimerWheel::cancel(uint16_t id) {
+    if (id < TIMER_WHEEL_CAPACITY && armed(id)) unlink(id);
+}
+
+size_t TimerWheel::advance(unsigned long now, ExpiredCallback expired, void* context) {
+    if (!_started) {
+        sync(now);
+        return 0;
+    }
+
+    size_t fired = 0;
+    uint32_t elapsed = (uint32_t)(now - _lastMs) / _tickMs;
+
+    while (elapsed--) {
+        _tick++;
+        _lastMs += _tickMs;
+
+        // Start of a 256-tick block: move its level-1 bucket down
+        if ((_tick & L0_MASK) == 0) {
+            uint16_t bucket = TIMER_WHEEL_L0_SIZE + ((_tick >> TIMER_WHEEL_L0_BITS) & L1_MASK);
+            uint16_t id;
+            while ((id = _buckets[bucket]) != TIMER_NONE) {
+                unlink(id);
+                place(id);
+            }
+        }
+
+        // Re-read the head each time: the callback may arm or cancel timers
+        uint16_t bucket = _tick & L0_MASK;
+        uint16_t id;
+        while ((id = _buckets[bucket]) != TIMER_NONE) {
+            unlink(id);
+            fired++;
+            if (expired) expired(id, context);
+        }
+    }
+
+    return fired;
+}
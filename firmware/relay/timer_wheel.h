@@ -0,0 +1,67 @@
+/*
+ * timer_wheel.h - Hierarchical timer wheel for the KVN MQTT Relay
+ *
+ * One timer per device, identified by its index. Arming, re-arming and
+ * cancelling unlink/link a node in a bucket list, so they are O(1), and
+ * advance() only visits the bucket of each elapsed tick instead of
+ * scanning every device.
+ *
+ * Two levels: 256 buckets of one tick, then 64 buckets of 256 ticks.
+ * With the relay's 100 ms tick that covers 27 minutes; longer timers wait
+ * in the farthest bucket and are re-placed when it cascades.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <Arduino.h>
+
+#define TIMER_WHEEL_CAPACITY  512
+#define TIMER_WHEEL_L0_BITS   8
+#define TIMER_WHEEL_L1_BITS   6
+#define TIMER_WHEEL_L0_SIZE   (1 << TIMER_WHEEL_L0_BITS)
+#define TIMER_WHEEL_L1_SIZE   (1 << TIMER_WHEEL_L1_BITS)
+#define TIMER_WHEEL_BUCKETS   (TIMER_WHEEL_L0_SIZE + TIMER_WHEEL_L1_SIZE)
+#define TIMER_NONE            0xFFFF
+
+struct TimerNode {
+    uint32_t expires;     // Absolute tick
+    uint16_t next;
+    uint16_t prev;
+    uint16_t bucket;      // TIMER_NONE when not armed
+};
+
+class TimerWheel {
+public:
+    typedef void (*ExpiredCallback)(uint16_t id, void* context);
+
+    TimerWheel(uint32_t tickMs);
+
+    // Arm (or re-arm) timer `id` to fire `delayMs` after `now`
+    void schedule(uint16_t id, unsigned long now, uint32_t delayMs);
+    void cancel(uint16_t id);
+    bool armed(uint16_t id) const { return _nodes[id].bucket != TIMER_NONE; }
+
+    // Run every tick up to `now`, calling `expired` for each timer that
+    // fires. Expired timers are disarmed before the callback, which may
+    // re-arm them. Returns the number fired. Safe across millis() wrap.
+    size_t advance(unsigned long now, ExpiredCallback expired, void* context);
+
+    uint32_t tickMs() const { return _tickMs; }
+    uint32_t ticks() const { return _tick; }
+
+private:
+    TimerNode _nodes[TIMER_WHEEL_CAPACITY];
+    uint16_t _buckets[TIMER_WHEEL_BUCKETS];
+    uint32_t _tickMs;
+    uint32_t _tick;
+    unsigned long _lastMs;   // millis() of _tick
+    bool _started;
+
+    void sync(unsigned long now);
+    void place(uint16_t id);
+    void link(uint16_t id, uint16_t bucket);
+    void unlink(uint16_t id);
+};
+
+#endif // TIMER_WHEEL_H
@@ -1,11 +1,13 @@
 /*
  * ESP32-C3 Scout with LDR Integration (Ultra-Low Power)
  *
- * Battery-powered motion sensor with intelligent power management:
- * - Deep sleep during daylight hours (1 hour intervals)
- * - Active motion detection at night (5 minute intervals)
+ * Battery-powered motion sensor with adaptive power management:
+ * - Deep sleep between short wakes; the interval adapts to how fast the
+ *   light is changing and to recent motion (1 min - 1 hour)
+ * - PIR wakes the scout immediately from deep sleep
+ * - Radio only when light moved past a deadband, on motion, or to send
+ *   a batch of buffered readings (see wake_scheduler.h)
  * - Window curtain/blind detection
- * - 2-3× battery life extension
  *
  * Hardware:
  *   - ESP32-C3 Scout board
@@ -18,21 +20,30 @@
 
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
 #include <KVN_LDR.h>
+#include <KVN_JsonWriter.h>
+#include <sys/time.h>
 #include "secrets.h"
+#include "wake_scheduler.h"
 
 // Scout configuration - CHANGE THIS FOR EACH DEVICE!
 #define SCOUT_NUMBER 1  // 1-6 for different locations
 
 // Pin configuration
 #define C3_LDR_PIN 0         // LDR analog input
-#define C3_PIR_PIN 2         // PIR motion sensor (optional)
+#define C3_PIR_PIN 2         // PIR motion sensor (optional, RTC GPIO for wake-up)
 #define C3_STATUS_LED 8      // Status LED (built-in on many C3 boards)
 
-// Power management
-#define SLEEP_DURATION_DAY   3600  // 1 hour in daylight (seconds)
-#define SLEEP_DURATION_NIGHT  300  // 5 minutes at night (seconds)
+// Power management (sleep intervals: see wake_scheduler.h)
 #define DAY_THRESHOLD        1500  // ADC threshold for daytime
+#define UPLINK_TIMEOUT_MS    10000 // Give up on WiFi + MQTT after this long
+
+// light_batch with a full ring, every field at its widest:
+// {"interval":4294967295,"readings":[[4294967295,65535,1],...]}
+#define BATCH_READING_MAX_LEN 20    // "[4294967295,65535,1],"
+#define BATCH_PAYLOAD_SIZE    (40 + WAKE_RING_SIZE * BATCH_READING_MAX_LEN)
+#define MQTT_BUFFER_SIZE      (BATCH_PAYLOAD_SIZE + 128)  // + header and topic
 
 // Scout location names (customize per deployment)
 const char* SCOUT_LOCATIONS[] = {
@@ -51,207 +62,174 @@ String deviceName = String(SCOUT_LOCATIONS[SCOUT_NUMBER]);
 
 // RTC memory (survives deep sleep)
 RTC_DATA_ATTR int bootCount = 0;
-RTC_DATA_ATTR uint16_t lastLuxValue = 0;
+RTC_DATA_ATTR WakeState wakeState;
+RTC_DATA_ATTR KVNConnCache connCache;  // Last BSSID/channel/IP for fast reconnect
 
 // Network clients
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
 
 // LDR sensor
 KVN_LDR scoutLight(C3_LDR_PIN);
 
+WakeScheduler scheduler(wakeState);
+
 void setup() {
     Serial.begin(115200);
     delay(100);
 
     bootCount++;
 
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    bool motion = cause == ESP_SLEEP_WAKEUP_GPIO;
+    scheduler.begin(cause == ESP_SLEEP_WAKEUP_UNDEFINED);
+
     Serial.println("\n=== ESP32-C3 Scout " + String(SCOUT_NUMBER) + " ===");
     Serial.println("Location: " + deviceName);
-    Serial.println("Boot #" + String(bootCount) + "\n");
+    Serial.println("Boot #" + String(bootCount) + (motion ? " (motion)" : "") + "\n");
 
     // Initialize LDR
     scoutLight.begin();
+    pinMode(C3_PIR_PIN, INPUT);
 
-    // Setup status LED
-    pinMode(C3_STATUS_LED, OUTPUT);
-    digitalWrite(C3_STATUS_LED, HIGH); // LED on during active period
-
-    // Check if it's daytime
-    uint16_t currentLux = scoutLight.getLux();
-    bool isDay = scoutLight.isDay(DAY_THRESHOLD);
+    // One reading per wake
+    const LDRSnapshot& light = scoutLight.sample();
 
     Serial.print("Current light: ");
-    Serial.print(currentLux);
+    Serial.print(light.lux);
     Serial.println(" lux");
 
-    if (isDay) {
-        // DAYTIME - Go to deep sleep for 1 hour
-        Serial.println("☀️ Daytime detected - sleeping for 1 hour");
-        Serial.println("Power saving mode active\n");
-
-        digitalWrite(C3_STATUS_LED, LOW); // LED off
-
-        // Quick MQTT update (optional - comment out to save more power)
-        if (connectQuick()) {
-            publishLightData();
-            mqtt.disconnect();
-        }
-
-        // Deep sleep for 1 hour
-        esp_sleep_enable_timer_wakeup(SLEEP_DURATION_DAY * 1000000ULL);
-        esp_deep_sleep_start();
+    if (!scheduler.record(secondsNow(), light.lux, motion)) {
+        Serial.printf("Within deadband - radio off (%u readings buffered)\n", scheduler.pending());
+        goToSleep();
     }
 
-    // NIGHTTIME - Proceed with motion detection
-    Serial.println("🌙 Nighttime - motion detection active");
-
-    // Connect to WiFi
-    connectWiFi();
+    // Radio needed: motion, significant change, full batch or heartbeat
+    pinMode(C3_STATUS_LED, OUTPUT);
+    digitalWrite(C3_STATUS_LED, HIGH); // LED on while the radio is up
 
-    // Setup MQTT
+    // Cached AP + IP first, full scan only if that fails. Persistent
+    // session: the stable deviceId lets the broker keep our state.
     mqtt.setServer(MQTT_BROKER, MQTT_PORT);
+    mqtt.setBufferSize(MQTT_BUFFER_SIZE);
+    conn.setFastReconnect(connCache);
+    conn.setCleanSession(false);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, deviceId.c_str(), MQTT_USER, MQTT_PASS);
+
+    if (conn.waitConnected(UPLINK_TIMEOUT_MS)) {
+        Serial.printf("MQTT connected in %lu ms (%s)\n", (unsigned long)conn.timing().mqttMs,
+                      conn.timing().fast ? "fast" : "full scan");
+
+        if (motion) {
+            Serial.println("🚨 Motion detected!");
+            String topic = "vanguard/scout/" + deviceName + "/motion";
+            mqtt.publish(topic.c_str(), "detected");
+        }
 
-    if (mqtt.connect(deviceId.c_str(), MQTT_USER, MQTT_PASS)) {
-        Serial.println("MQTT connected");
-
-        // Publish boot status
-        String topic = "vanguard/scout/" + deviceName + "/status";
-        mqtt.publish(topic.c_str(), "online");
-
-        // Publish light data
         publishLightData();
-
-        // Check for window curtain changes
+        publishLatency(millis());
+        bool batchSent = publishBatch();
         detectCurtainState();
-    }
 
-    // Setup PIR sensor (if connected)
-    pinMode(C3_PIR_PIN, INPUT);
-
-    Serial.println("\nMonitoring for motion...\n");
-}
-
-void loop() {
-    // Maintain MQTT connection
-    if (!mqtt.connected()) {
-        // Don't spend too long reconnecting - save battery
-        if (mqtt.connect(deviceId.c_str(), MQTT_USER, MQTT_PASS)) {
-            Serial.println("MQTT reconnected");
+        // Readings are dropped from the ring only once the broker has them
+        if (batchSent) {
+            scheduler.markSent();
+        } else {
+            Serial.println("Batch not sent - readings stay buffered");
         }
+        mqtt.disconnect();
+    } else {
+        Serial.println("Uplink failed - readings stay buffered");
     }
-    mqtt.loop();
-
-    // Monitor motion sensor
-    static unsigned long lastMotion = 0;
-    bool motionDetected = digitalRead(C3_PIR_PIN);
-
-    if (motionDetected && (millis() - lastMotion > 10000)) {
-        Serial.println("🚨 Motion detected!");
 
-        String topic = "vanguard/scout/" + deviceName + "/motion";
-        mqtt.publish(topic.c_str(), "detected");
-
-        lastMotion = millis();
-
-        // Flash LED
-        for (int i = 0; i < 3; i++) {
-            digitalWrite(C3_STATUS_LED, LOW);
-            delay(100);
-            digitalWrite(C3_STATUS_LED, HIGH);
-            delay(100);
-        }
-    }
+    digitalWrite(C3_STATUS_LED, LOW);
+    goToSleep();
+}
 
-    // Publish light updates if changed significantly
-    static unsigned long lastPublish = 0;
-    if (scoutLight.hasChanged(200) && (millis() - lastPublish > 60000)) {
-        publishLightData();
-        lastPublish = millis();
-    }
+void loop() {
+    // Not reached: the scout sleeps from setup()
+    delay(1000);
+}
 
-    // Check if dawn - go back to sleep
-    if (scoutLight.isDay(DAY_THRESHOLD)) {
-        Serial.println("☀️ Dawn detected - entering sleep mode");
+uint32_t secondsNow() {
+    // System time keeps running through deep sleep (RTC timer)
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec;
+}
 
-        digitalWrite(C3_STATUS_LED, LOW);
+void goToSleep() {
+    uint32_t interval = scheduler.nextInterval();
 
-        esp_sleep_enable_timer_wakeup(SLEEP_DURATION_DAY * 1000000ULL);
-        esp_deep_sleep_start();
+    // Wake on PIR unless it is still high from the motion that woke us,
+    // which would wake us again straight away
+    if (digitalRead(C3_PIR_PIN) == LOW) {
+        esp_deep_sleep_enable_gpio_wakeup(1ULL << C3_PIR_PIN, ESP_GPIO_WAKEUP_GPIO_HIGH);
     }
 
-    // After 5 minutes of operation, sleep briefly to save battery
-    if (millis() > SLEEP_DURATION_NIGHT * 1000) {
-        Serial.println("Night cycle complete - sleeping for 5 minutes");
-
-        mqtt.disconnect();
-        WiFi.disconnect();
-        digitalWrite(C3_STATUS_LED, LOW);
-
-        esp_sleep_enable_timer_wakeup(SLEEP_DURATION_NIGHT * 1000000ULL);
-        esp_deep_sleep_start();
-    }
+    Serial.printf("Sleeping for %lu s\n", (unsigned long)interval);
+    Serial.flush();
 
-    delay(100);
+    WiFi.disconnect(true);
+    esp_sleep_enable_timer_wakeup(interval * 1000000ULL);
+    esp_deep_sleep_start();
 }
 
-void connectWiFi() {
-    Serial.print("Connecting to WiFi");
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-        delay(500);
-        Serial.print(".");
-        attempts++;
-    }
+void publishLatency(uint32_t publishMs) {
+    // Wake-to-publish timing for this boot
+    char json[112];
+    if (conn.formatLatency(json, sizeof(json), publishMs) == 0) return;
 
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println(" Connected!");
-        Serial.print("IP: ");
-        Serial.println(WiFi.localIP());
-    } else {
-        Serial.println(" Failed! Continuing offline");
-    }
+    String topic = "vanguard/scout/" + deviceId + "/latency";
+    mqtt.publish(topic.c_str(), json);
 }
 
-bool connectQuick() {
-    // Quick WiFi + MQTT connection for daytime updates
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-
-    for (int i = 0; i < 10; i++) {
-        if (WiFi.status() == WL_CONNECTED) {
-            mqtt.setServer(MQTT_BROKER, MQTT_PORT);
-            if (mqtt.connect(deviceId.c_str(), MQTT_USER, MQTT_PASS)) {
-                return true;
-            }
-        }
-        delay(500);
+bool publishBatch() {
+    // Every reading buffered since the last uplink, oldest first:
+    // {"interval":300,"readings":[[age_s,lux,motion],...]}
+    char payload[BATCH_PAYLOAD_SIZE];
+    KVN_JsonWriter json(payload, sizeof(payload));
+    json.addUInt("interval", scheduler.interval());
+    json.beginArray("readings");
+    for (uint8_t i = 0; i < scheduler.pending(); i++) {
+        const WakeReading& r = scheduler.pendingAt(i);
+        json.beginArray();
+        json.addUInt(nullptr, scheduler.clock() - r.time);
+        json.addUInt(nullptr, r.lux);
+        json.addUInt(nullptr, r.flags & WAKE_FLAG_MOTION ? 1 : 0);
+        json.endArray();
     }
+    json.endArray();
+
+    if (!json.finish()) return false;
 
-    return false;
+    String topic = "vanguard/scout/" + deviceId + "/light_batch";
+    return mqtt.publish(topic.c_str(), payload);
 }
 
 void publishLightData() {
     String topicLux = "homeassistant/sensor/" + deviceId + "/lux";
     String topicAmbient = "homeassistant/sensor/" + deviceId + "/ambient_light";
 
+    // The reading taken at wake-up
+    const LDRSnapshot& light = scoutLight.snapshot();
+
     // Publish lux value
-    mqtt.publish(topicLux.c_str(), String(scoutLight.getLux()).c_str());
+    mqtt.publish(topicLux.c_str(), String(light.lux).c_str());
 
     // Publish full JSON
-    String json = scoutLight.toJSON();
-    mqtt.publish(topicAmbient.c_str(), json.c_str());
+    char json[64];
+    KVN_LDR::formatJSON(light, json, sizeof(json));
+    mqtt.publish(topicAmbient.c_str(), json);
 
     Serial.print("[" + deviceName + "] Published: ");
     Serial.println(json);
-
-    lastLuxValue = scoutLight.getLux();
 }
 
 void detectCurtainState() {
     // Window curtain/blind detection (for window-mounted scouts)
-    uint16_t lux = scoutLight.getLux();
+    uint16_t lux = scoutLight.snapshot().lux;
 
     String topic = "vanguard/scout/" + deviceName + "/window_status";
 
@@ -260,7 +238,7 @@ void detectCurtainState() {
         mqtt.publish(topic.c_str(), "curtains_open");
         Serial.println("Window status: Curtains OPEN");
 
-    } else if (lux < 50 && scoutLight.isDay()) {
+    } else if (lux < 50 && scoutLight.snapshot().smoothed > DAY_THRESHOLD) {
         // Dark during daytime - curtains closed
         mqtt.publish(topic.c_str(), "curtains_closed");
         Serial.println("Window status: Curtains CLOSED");
@@ -272,20 +250,10 @@ void detectCurtainState() {
 }
 
 /*
- * Battery Life Calculation:
- *
- * WITHOUT LDR (24/7 active):
- *   - Current draw: ~80mA
- *   - Battery: 1000mAh
- *   - Runtime: ~12.5 hours
- *
- * WITH LDR (sleep in day):
- *   - Daytime (12h): Deep sleep @ 10µA
- *   - Nighttime (12h): Active @ 80mA + sleep cycles
- *   - Average current: ~35mA
- *   - Battery: 1000mAh
- *   - Runtime: ~28 hours (2.2× longer!)
+ * Battery Life:
  *
- * WITH LARGER BATTERY (2000mAh):
- *   - Runtime: ~56 hours (~2.3 days)
+ * host/build/kvn_sim_scout runs this sketch on a simulated window light
+ * curve with PIR events next to the old fixed schedule (1 h day sleeps,
+ * 5 min awake with WiFi at night), prints radio-on seconds and mAh for
+ * both, and fails if WakeScheduler does not come out ahead.
  */
@@ -0,0 +1,86 @@
+/*
+ * wake_scheduler.cpp - Implementation
+ */
+
+#include "wake_scheduler.h"
+#include <string.h>
+
+#define WAKE_MAGIC 0x4B564E57  // "KVNW"
+
+WakeScheduler::WakeScheduler(WakeState& state) : _s(state) {
+}
+
+void WakeScheduler::begin(bool coldBoot) {
+    if (!coldBoot && _s.magic == WAKE_MAGIC) return;
+
+    memset(&_s, 0, sizeof(_s));
+    _s.magic = WAKE_MAGIC;
+    _s.interval = WAKE_MIN_INTERVAL_S;
+}
+
+const WakeReading* WakeScheduler::newest(uint8_t back) const {
+    if (back >= _s.count) return nullptr;
+    return &_s.ring[(_s.head + WAKE_RING_SIZE - 1 - back) % WAKE_RING_SIZE];
+}
+
+const WakeReading& WakeScheduler::pendingAt(uint8_t index) const {
+    return _s.ring[(_s.head + WAKE_RING_SIZE - _s.unsent + index) % WAKE_RING_SIZE];
+}
+
+bool WakeScheduler::outsideDeadband(uint16_t lux) const {
+    uint16_t band = (uint32_t)_s.lastSentLux * WAKE_DEADBAND_PCT / 100;
+    if (band < WAKE_DEADBAND_LUX) band = WAKE_DEADBAND_LUX;
+
+    return abs((int)lux - (int)_s.lastSentLux) > band;
+}
+
+bool WakeScheduler::record(uint32_t now, uint16_t lux, bool motion) {
+    _s.clock = now;
+
+    WakeReading& r = _s.ring[_s.head];
+    r.time = _s.clock;
+    r.lux = lux;
+    r.flags = motion ? WAKE_FLAG_MOTION : 0;
+
+    _s.head = (_s.head + 1) % WAKE_RING_SIZE;
+    if (_s.count < WAKE_RING_SIZE) _s.count++;
+    if (_s.unsent < WAKE_RING_SIZE) _s.unsent++;  // Oldest unsent is overwritten when full
+
+    if (motion) _s.lastMotion = _s.clock ? _s.clock : 1;
+
+    return !_s.everSent
+        || motion
+        || outsideDeadband(lux)
+        || _s.unsent >= WAKE_BATCH_SIZE
+        || _s.clock - _s.lastUplink >= WAKE_HEARTBEAT_S;
+}
+
+void WakeScheduler::markSent() {
+    const WakeReading* last = newest(0);
+    if (last) _s.lastSentLux = last->lux;
+
+    _s.unsent = 0;
+    _s.lastUplink = _s.clock;
+    _s.everSent = true;
+}
+
+uint32_t WakeScheduler::nextInterval() {
+    // Rate of change between the last two wakes, lux per minute
+    uint32_t rate = 0;
+    const WakeReading* a = newest(0);
+    const WakeReading* b = newest(1);
+    if (a && b && a->time > b->time) {
+        rate = (uint32_t)abs((int)a->lux - (int)b->lux) * 60 / (a->time - b->time);
+    }
+
+    bool recentMotion = _s.lastMotion && _s.clock - _s.lastMotion < WAKE_MOTION_HOLD_S;
+
+    if (recentMotion || rate >= WAKE_FAST_RATE_LUX) {
+        _s.interval /= 2;
+    } else if (rate < WAKE_FAST_RATE_LUX / 4) {
+        _s.interval += _s.interval / 2;
+    }
+    _s.interval = constrain(_s.interval, WAKE_MIN_INTERVAL_S, WAKE_MAX_INTERVAL_S);
+
+    return _s.interval;
+}
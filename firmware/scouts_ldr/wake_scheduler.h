@@ -0,0 +1,94 @@
+/*
+ * wake_scheduler.h - Adaptive deep-sleep scheduler for the C3 Scout
+ *
+ * Every wake takes one light reading and records it in a small ring that
+ * lives in RTC memory. The radio is only switched on when something is
+ * worth sending:
+ *   - motion woke the scout
+ *   - light moved past the deadband since the last uplink
+ *   - WAKE_BATCH_SIZE readings are waiting
+ *   - nothing has been sent for WAKE_HEARTBEAT_S
+ * Everything waiting goes out in one batch.
+ *
+ * The sleep interval adapts on every wake. It halves when light is changing
+ * quickly or there was recent motion, and grows by half when readings are
+ * steady. It always stays within [WAKE_MIN_INTERVAL_S, WAKE_MAX_INTERVAL_S].
+ *
+ * The scheduler is pure logic over a WakeState struct. The sketch keeps that
+ * struct in RTC_DATA_ATTR memory, and the simulator (schedule_sim.cpp)
+ * replays a 24 h trace through the same code.
+ */
+
+#ifndef WAKE_SCHEDULER_H
+#define WAKE_SCHEDULER_H
+
+#include <Arduino.h>
+
+#define WAKE_RING_SIZE        16      // Readings kept across deep sleep
+#ifndef WAKE_BATCH_SIZE
+#define WAKE_BATCH_SIZE       8       // Uplink once this many are waiting
+#endif
+#define WAKE_DEADBAND_LUX     25      // Absolute change that forces an uplink...
+#define WAKE_DEADBAND_PCT     20      // ...or this % of the last sent value, if larger
+#define WAKE_HEARTBEAT_S      7200    // Uplink at least this often
+#define WAKE_MIN_INTERVAL_S   60
+#define WAKE_MAX_INTERVAL_S   3600
+#define WAKE_FAST_RATE_LUX    10      // lux/min counted as "changing quickly"
+#define WAKE_MOTION_HOLD_S    1800    // Recent-motion window keeping wakes short
+
+#define WAKE_FLAG_MOTION 0x01
+
+struct WakeReading {
+    uint32_t time;     // Seconds
+    uint16_t lux;
+    uint8_t flags;     // WAKE_FLAG_*
+};
+
+struct WakeState {
+    uint32_t magic;                 // Detects a cold boot (RTC memory is garbage)
+    uint32_t clock;                 // Time of the latest reading, seconds
+    uint32_t interval;              // Current sleep interval, seconds
+
+    WakeReading ring[WAKE_RING_SIZE];
+    uint8_t head;                   // Next write position
+    uint8_t count;                  // Readings held
+    uint8_t unsent;                 // Newest `unsent` readings not uplinked yet
+
+    uint16_t lastSentLux;
+    uint32_t lastUplink;            // Clock of last uplink
+    uint32_t lastMotion;            // Clock of last motion wake
+    bool everSent;
+};
+
+class WakeScheduler {
+public:
+    explicit WakeScheduler(WakeState& state);
+
+    // Call once per wake. coldBoot reinitialises the RTC state.
+    void begin(bool coldBoot);
+
+    // Record this wake's reading taken at `now` (seconds, monotonic across
+    // deep sleep). Returns true if the radio should be used.
+    bool record(uint32_t now, uint16_t lux, bool motion);
+
+    // Readings waiting for uplink, oldest first
+    uint8_t pending() const { return _s.unsent; }
+    const WakeReading& pendingAt(uint8_t index) const;
+
+    // Call after a successful uplink
+    void markSent();
+
+    // Adapt and return the next sleep interval in seconds
+    uint32_t nextInterval();
+
+    uint32_t clock() const { return _s.clock; }
+    uint32_t interval() const { return _s.interval; }
+
+private:
+    WakeState& _s;
+
+    const WakeReading* newest(uint8_t back) const;
+    bool outsideDeadband(uint16_t lux) const;
+};
+
+#endif // WAKE_SCHEDULER_H
@@ -1,5 +1,7 @@
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <KVN_Connection.h>
+#include <KVN_Telemetry.h>
 #include "c3_config.h"
 
 const char* WIFI_SSID = "guy-fi";
@@ -9,6 +11,12 @@ const uint16_t MQTT_PORT = 1883;
 
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+RTC_DATA_ATTR KVNConnCache connCache;  // Fast reconnect after deep sleep
+String clientId;
+char nodeId[17];
+uint32_t telemetrySeq = 0;
+bool latencyReported = false;
 
 String chipId() {
   uint64_t id = ESP.getEfuseMac();
@@ -21,41 +29,64 @@ String topicBase() {
   return String("vanguard/scout/") + chipId();
 }
 
-void connectWiFi() {
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-  uint8_t attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 40) {
-    delay(250);
-    attempts++;
-  }
-}
-
-void connectMQTT() {
-  mqtt.setServer(MQTT_HOST, MQTT_PORT);
-  uint8_t attempts = 0;
-  while (!mqtt.connected() && attempts < 10) {
-    String cid = String("c3-") + chipId();
-    if (mqtt.connect(cid.c_str())) break;
-    delay(500);
-    attempts++;
-  }
-}
-
 int readBatteryMilliVolts() {
   int raw = analogRead(BATTERY_ADC_PIN);
   return (int)((raw / 4095.0) * 3300);
 }
 
+void buildFrame(KVN_Telemetry& frame) {
+  frame.begin(nodeId, telemetrySeq++, millis() / 1000);
+  frame.addUInt(KVN_TM_BATTERY_MV, readBatteryMilliVolts());
+  frame.addUInt(KVN_TM_UPTIME_MS, millis());
+  frame.addBool(KVN_TM_ONLINE, true);
+}
+
 void publishStatus() {
-  String payload = String("{") +
-    "\"node\":\"" + chipId() + "\"," +
-    "\"battery_mv\":" + readBatteryMilliVolts() + "," +
-    "\"uptime_ms\":" + millis() + "," +
-    "\"online\":true" +
-    "}";
+  KVN_Telemetry frame;
+  buildFrame(frame);
+
+  char payload[128];
+  KVN_JsonWriter json(payload, sizeof(payload));
+  json.addString("node", nodeId);
+  frame.writeFields(json);
+  if (!json.finish()) return;
+
   String topic = topicBase() + "/status";
-  mqtt.publish(topic.c_str(), payload.c_str(), true);
+  mqtt.publish(topic.c_str(), payload, true);
+}
+
+void publishTelemetry() {
+#if TELEMETRY_BINARY
+  KVN_Telemetry frame;
+  buildFrame(frame);
+
+  uint8_t payload[64];
+  size_t len = frame.toCBOR(payload, sizeof(payload));
+  if (len == 0) return;
+
+  String topic = topicBase() + "/telemetry";
+  mqtt.publish(topic.c_str(), payload, len, false);
+#else
+  publishStatus();
+#endif
+}
+
+void publishLatency(uint32_t publishMs) {
+  char payload[112];
+  if (conn.formatLatency(payload, sizeof(payload), publishMs) == 0) return;
+
+  String topic = topicBase() + "/latency";
+  mqtt.publish(topic.c_str(), payload);
+}
+
+void onMqttConnected(PubSubClient& client) {
+  publishStatus();
+
+  // Wake-to-publish timing, once per boot
+  if (!latencyReported) {
+    publishLatency(millis());
+    latencyReported = true;
+  }
 }
 
 // Deep Sleep Helper (Call this when battery is low or after task completion)
@@ -72,21 +103,21 @@ void setup() {
   digitalWrite(SENSOR_POWER_PIN, HIGH);
   pinMode(BATTERY_ADC_PIN, INPUT);
 
-  connectWiFi();
-  connectMQTT();
-  publishStatus();
-
-  delay(2000);
+  mqtt.setServer(MQTT_HOST, MQTT_PORT);
+  strlcpy(nodeId, chipId().c_str(), sizeof(nodeId));
+  clientId = String("c3-") + nodeId;
+  conn.onConnect(onMqttConnected);
+  conn.setFastReconnect(connCache);
+  conn.setCleanSession(false);  // clientId is derived from the chip, stable across boots
+  conn.begin(WIFI_SSID, WIFI_PASSWORD, clientId.c_str());
 }
 
 void loop() {
-  if (WiFi.status() != WL_CONNECTED) connectWiFi();
-  if (!mqtt.connected()) connectMQTT();
-  mqtt.loop();
+  conn.tick();
 
   static uint32_t lastPub = 0;
-  if (millis() - lastPub > 10000) {
-    publishStatus();
+  if (conn.connected() && millis() - lastPub > 10000) {
+    publishTelemetry();
     lastPub = millis();
   }
 }
\ No newline at end of file
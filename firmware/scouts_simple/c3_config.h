@@ -8,4 +8,8 @@
 #define I2C_SCL 5
 #define BATTERY_ADC_PIN 3
 
+// 1 = periodic telemetry as a CBOR frame on <base>/telemetry (hub decodes it),
+// 0 = JSON on <base>/status
+#define TELEMETRY_BINARY 0
+
 #endif
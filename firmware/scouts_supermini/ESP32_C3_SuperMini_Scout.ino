@@ -11,9 +11,15 @@
  */
 
 #include "../secrets.h"
+#include <KVN_Connection.h>
+#include <KVN_Presence.h>
+#include <KVN_RadarParser.h>
+#include <KVN_Telemetry.h>
 #include <PubSubClient.h>
 #include <WiFi.h>
 #include <Wire.h>
+#include "sensor_drivers.h"
+#include "sensor_poller.h"
 
 // --- Pin Definitions (Functional Names) ---
 
@@ -22,6 +28,8 @@
 // We connect ESP RX to Radar TX, ESP TX to Radar RX.
 #define PIN_RADAR_RX 20
 #define PIN_RADAR_TX 21
+#define RADAR_BAUD 115200
+#define RADAR_RX_BUFFER 1024 // Holds radar bytes while the sensors are read
 
 // Primary Sensor Bus (e.g., Light, Env)
 #define PIN_SENSOR_SDA 8
@@ -34,88 +42,108 @@
 // Status Indicator
 #define PIN_STATUS_LED 2
 
+// Both buses share the C3's single I2C controller (re-pinned per bus)
+#define I2C_CLOCK_HZ 400000
+
 // --- System Configuration ---
 #define REPORT_INTERVAL_MS 10000
 
 // --- Globals ---
 WiFiClient espClient;
 PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+RTC_DATA_ATTR KVNConnCache connCache; // Fast reconnect after deep sleep
 String deviceId;
 String topicBase;
+bool latencyReported = false;
+uint32_t telemetrySeq = 0;
 
-TwoWire SensorBus = TwoWire(0);
-TwoWire AuxBus = TwoWire(1);
+RTC_DATA_ATTR SensorCache sensorCache; // Devices + calibration, no rescan on warm boot
+SensorPoller sensors(Wire, SENSOR_DRIVERS, SENSOR_DRIVER_COUNT, I2C_CLOCK_HZ);
+RTC_DATA_ATTR bool discoveryPending = true; // Retained message not yet sent
 
-void setup_wifi() {
-  delay(10);
-  Serial.println();
-  Serial.print("Connecting to ");
-  Serial.println(WIFI_SSID);
+KVN_RadarParser radar;
+KVN_Presence presence;
+int radarZone;
 
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+void onConnectionState(KVNConnState from, KVNConnState to) {
+  Serial.print("Connection: ");
+  Serial.print(KVN_Connection::stateName(from));
+  Serial.print(" -> ");
+  Serial.println(KVN_Connection::stateName(to));
 
-  int attempts = 0;
-  while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-    delay(500);
-    Serial.print(".");
-    attempts++;
-    digitalWrite(PIN_STATUS_LED, !digitalRead(PIN_STATUS_LED));
-  }
-  digitalWrite(PIN_STATUS_LED, LOW);
-
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println("\nWiFi connected");
-    Serial.print("IP address: ");
-    Serial.println(WiFi.localIP());
-  } else {
-    Serial.println("\nWiFi failed. Running in offline mode.");
+  // LED stays lit while connected
+  digitalWrite(PIN_STATUS_LED, to == KVN_CONN_CONNECTED ? HIGH : LOW);
+}
+
+void publishDiscovery() {
+  char payload[384];
+  KVN_JsonWriter json(payload, sizeof(payload));
+  sensors.writeDiscovery(json);
+  if (!json.finish()) {
+    Serial.println("Discovery too large");
+    return;
   }
+  discoveryPending = !mqtt.publish((topicBase + "/discovery").c_str(), payload, true);
 }
 
-void reconnect() {
-  while (!mqtt.connected()) {
-    Serial.print("Attempting MQTT connection...");
-    if (mqtt.connect(deviceId.c_str(), MQTT_USER, MQTT_PASS)) {
-      Serial.println("connected");
-      mqtt.publish((topicBase + "/status").c_str(), "online");
-    } else {
-      Serial.print("failed, rc=");
-      Serial.print(mqtt.state());
-      Serial.println(" try again in 5 seconds");
-      delay(5000);
+void onMqttConnected(PubSubClient &client) {
+  Serial.print("IP address: ");
+  Serial.println(WiFi.localIP());
+  client.publish((topicBase + "/status").c_str(), "online");
+
+  // Wake-to-publish timing, once per boot
+  if (!latencyReported) {
+    char payload[112];
+    if (conn.formatLatency(payload, sizeof(payload), millis()) > 0) {
+      client.publish((topicBase + "/latency").c_str(), payload);
     }
+    latencyReported = true;
+  }
+
+  // Retained, so it only needs sending again after a rescan
+  if (discoveryPending) {
+    publishDiscovery();
   }
 }
 
-void scanI2C(TwoWire &wirePort, String busName) {
-  byte error, address;
-  int nDevices = 0;
+void onRadarFrame(uint8_t id, const KVNRadarFrame &frame) {
+  presence.update(id, frame, millis());
+}
 
-  Serial.println("Scanning " + busName + "...");
+void publishPresence() {
+  const PresenceZone &zone = presence.zone(radarZone);
 
-  for (address = 1; address < 127; address++) {
-    wirePort.beginTransmission(address);
-    error = wirePort.endTransmission();
+  char payload[64];
+  snprintf(payload, sizeof(payload), "{\"occupied\":%s,\"distance\":%u}",
+           zone.occupied ? "true" : "false", zone.distance);
+  mqtt.publish((topicBase + "/presence").c_str(), payload, true);
+}
 
-    if (error == 0) {
-      Serial.print("Device found at 0x");
-      if (address < 16)
-        Serial.print("0");
-      Serial.println(address, HEX);
-      nDevices++;
+// One frame per cycle: every sensor read in one batched poll
+void publishTelemetry() {
+  KVN_Telemetry frame;
+  frame.begin(deviceId.c_str(), telemetrySeq++, millis() / 1000);
+  frame.addUInt(KVN_TM_UPTIME, millis() / 1000);
 
-      if (mqtt.connected()) {
-        String payload = "{\"bus\":\"" + busName + "\",\"address\":\"0x" +
-                         String(address, HEX) + "\"}";
-        mqtt.publish((topicBase + "/discovery").c_str(), payload.c_str());
-      }
-    }
+  if (sensors.poll(frame)) {
+    discoveryPending = true; // A device dropped out and the buses were rescanned
+  }
+  if (sensors.lastFailed() > 0) {
+    Serial.print("Sensor reads failed: ");
+    Serial.println(sensors.lastFailed());
+  }
+
+  if (!mqtt.connected()) return;
+
+  uint8_t payload[96];
+  size_t len = frame.toCBOR(payload, sizeof(payload));
+  if (len > 0) {
+    mqtt.publish((topicBase + "/telemetry").c_str(), payload, len, false);
+  }
+  if (discoveryPending) {
+    publishDiscovery();
   }
-  if (nDevices == 0)
-    Serial.println("No devices found.\n");
-  else
-    Serial.println("done\n");
 }
 
 void setup() {
@@ -130,15 +158,26 @@ void setup() {
 
   // 3. Initialize Radar UART
   // Connect Radar TX to ESP RX (20) and Radar RX to ESP TX (21)
-  Serial1.begin(115200, SERIAL_8N1, PIN_RADAR_RX, PIN_RADAR_TX);
+  Serial1.setRxBufferSize(RADAR_RX_BUFFER);
+  Serial1.begin(RADAR_BAUD, SERIAL_8N1, PIN_RADAR_RX, PIN_RADAR_TX);
+  radarZone = presence.addZone("scout");
+  presence.addSource(0, radarZone);
+  radar.onFrame(onRadarFrame);
   Serial.println("Radar UART Initialized");
 
-  // 4. Initialize I2C Buses
-  SensorBus.begin(PIN_SENSOR_SDA, PIN_SENSOR_SCL, 100000);
-  Serial.println("Primary Sensor Bus Initialized");
-
-  AuxBus.begin(PIN_AUX_SDA, PIN_AUX_SCL, 100000);
-  Serial.println("Aux Sensor Bus Initialized");
+  // 4. Sensors: scan once on a cold boot, reuse the RTC cache after that
+  sensors.addBus(PIN_SENSOR_SDA, PIN_SENSOR_SCL);
+  sensors.addBus(PIN_AUX_SDA, PIN_AUX_SCL);
+  if (sensors.begin(sensorCache)) {
+    discoveryPending = true; // Scanned: the retained discovery may be stale
+  }
+  Serial.print("Sensors: ");
+  Serial.println(sensors.deviceCount());
+  for (uint8_t i = 0; i < sensors.deviceCount(); i++) {
+    const SensorSlot &slot = sensors.device(i);
+    Serial.printf("  bus %u 0x%02x %s\n", slot.bus, slot.address,
+                  sensors.driverName(slot));
+  }
 
   // 5. Identity
   uint64_t mac = ESP.getEfuseMac();
@@ -149,18 +188,19 @@ void setup() {
   Serial.print("Device ID: ");
   Serial.println(deviceId);
 
-  // 6. Connect
-  setup_wifi();
+  // 6. Connect (non-blocking, driven from loop())
+  Serial.print("Connecting to ");
+  Serial.println(WIFI_SSID);
   mqtt.setServer(MQTT_BROKER, MQTT_PORT);
+  conn.onStateChange(onConnectionState);
+  conn.onConnect(onMqttConnected);
+  conn.setFastReconnect(connCache);
+  conn.setCleanSession(false); // deviceId comes from the MAC, stable across boots
+  conn.begin(WIFI_SSID, WIFI_PASSWORD, deviceId.c_str(), MQTT_USER, MQTT_PASS);
 }
 
 void loop() {
-  if (WiFi.status() == WL_CONNECTED) {
-    if (!mqtt.connected()) {
-      reconnect();
-    }
-    mqtt.loop();
-  }
+  conn.tick();
 
   static unsigned long lastMsg = 0;
   unsigned long now = millis();
@@ -168,26 +208,16 @@ void loop() {
     lastMsg = now;
 
     // Blink Heartbeat
-    digitalWrite(PIN_STATUS_OUT, HIGH);
+    digitalWrite(PIN_STATUS_LED, HIGH);
     delay(50);
-    digitalWrite(PIN_STATUS_OUT, LOW);
-
-    // Publish Uptime
-    if (mqtt.connected()) {
-      String uptime = String(millis() / 1000);
-      mqtt.publish((topicBase + "/uptime").c_str(), uptime.c_str());
-    }
+    digitalWrite(PIN_STATUS_LED, LOW);
 
-    // Check for Sensors
-    scanI2C(SensorBus, "PrimaryBus");
-    scanI2C(AuxBus, "AuxBus");
+    publishTelemetry();
   }
 
   // Read Radar
-  if (Serial1.available()) {
-    // Pass through radar data handling here
-    // For now just clear buffer
-    while (Serial1.available())
-      Serial1.read();
+  radar.poll(Serial1);
+  if (presence.evaluate(millis()) && mqtt.connected()) {
+    publishPresence();
   }
 }
@@ -0,0 +1,218 @@
+/*
+ * sensor_drivers.cpp - Implementation
+ */
+
+#include "sensor_drivers.h"
+#include <string.h>
+
+// A field already in the frame came from a higher-priority sensor
+static void addFloatOnce(KVN_Telemetry& frame, uint8_t field, float value) {
+    if (frame.find(field) == nullptr) frame.addFloat(field, value);
+}
+
+static bool writeBytes(TwoWire& wire, uint8_t address, const uint8_t* data, uint8_t length) {
+    wire.beginTransmission(address);
+    wire.write(data, length);
+    return wire.endTransmission() == 0;
+}
+
+static bool readRegisters(TwoWire& wire, uint8_t address, uint8_t reg, uint8_t* out, uint8_t length) {
+    wire.beginTransmission(address);
+    wire.write(reg);
+    if (wire.endTransmission(false) != 0) return false;
+    if (wire.requestFrom(address, length) != length) return false;
+    for (uint8_t i = 0; i < length; i++) out[i] = wire.read();
+    return true;
+}
+
+// ==================== SHT3x ====================
+
+#define SHT3X_PERIODIC_1HZ_HIGH 0x2130
+#define SHT3X_READ_STATUS       0xF32D
+
+// CRC-8, polynomial 0x31, init 0xFF (Sensirion)
+static uint8_t sht3xCrc(const uint8_t* data) {
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static bool sht3xCommand(TwoWire& wire, uint8_t address, uint16_t command) {
+    uint8_t bytes[2] = {(uint8_t)(command >> 8), (uint8_t)command};
+    return writeBytes(wire, address, bytes, 2);
+}
+
+static bool sht3xSetup(TwoWire& wire, uint8_t address, uint8_t* state) {
+    (void)state;
+
+    // Anything at 0x44/0x45 that returns a status word with a valid CRC
+    uint8_t status[3];
+    if (!sht3xCommand(wire, address, SHT3X_READ_STATUS)) return false;
+    if (wire.requestFrom(address, (uint8_t)3) != 3) return false;
+    for (uint8_t i = 0; i < 3; i++) status[i] = wire.read();
+    if (sht3xCrc(status) != status[2]) return false;
+
+    return sht3xCommand(wire, address, SHT3X_PERIODIC_1HZ_HIGH);
+}
+
+static bool sht3xDecode(const uint8_t* raw, const uint8_t* state, KVN_Telemetry& frame) {
+    (void)state;
+    if (sht3xCrc(raw) != raw[2] || sht3xCrc(raw + 3) != raw[5]) return false;
+
+    uint16_t t = (raw[0] << 8) | raw[1];
+    uint16_t rh = (raw[3] << 8) | raw[4];
+    addFloatOnce(frame, KVN_TM_TEMPERATURE, -45.0f + 175.0f * t / 65535.0f);
+    addFloatOnce(frame, KVN_TM_HUMIDITY, 100.0f * rh / 65535.0f);
+    return true;
+}
+
+// ==================== BME280 / BMP280 ====================
+
+#define BME280_REG_CALIB_TP   0x88    // 26 bytes: T1..T3, P1..P9, (pad), H1
+#define BME280_REG_CHIP_ID    0xD0
+#define BME280_REG_CALIB_H    0xE1    // 7 bytes: H2..H6
+#define BME280_REG_CTRL_HUM   0xF2
+#define BME280_REG_CTRL_MEAS  0xF4
+#define BME280_REG_CONFIG     0xF5
+#define BME280_CHIP_ID        0x60
+#define BMP280_CHIP_ID        0x58
+#define BME280_SKIPPED        0x80000 // Reading of a measurement that has not run yet
+
+struct __attribute__((packed)) Bme280Cal {
+    uint16_t t1;
+    int16_t t2, t3;
+    uint16_t p1;
+    int16_t p2, p3, p4, p5, p6, p7, p8, p9;
+    uint8_t h1;
+    int16_t h2;
+    uint8_t h3;
+    int16_t h4, h5;
+    int8_t h6;
+    bool humidity;                     // BME280; a BMP280 has no humidity sensor
+};
+
+static_assert(sizeof(Bme280Cal) <= SENSOR_STATE_SIZE, "BME280 calibration must fit the slot state");
+
+static bool bme280Setup(TwoWire& wire, uint8_t address, uint8_t* state) {
+    uint8_t id;
+    if (!readRegisters(wire, address, BME280_REG_CHIP_ID, &id, 1)) return false;
+    if (id != BME280_CHIP_ID && id != BMP280_CHIP_ID) return false;
+
+    uint8_t tp[26], h[7] = {};
+    if (!readRegisters(wire, address, BME280_REG_CALIB_TP, tp, sizeof(tp))) return false;
+    bool humidity = id == BME280_CHIP_ID;
+    if (humidity && !readRegisters(wire, address, BME280_REG_CALIB_H, h, sizeof(h))) return false;
+
+    // Little-endian words
+    auto word = [&tp](uint8_t at) { return (uint16_t)(tp[at] | tp[at + 1] << 8); };
+
+    Bme280Cal cal;
+    cal.t1 = word(0);
+    cal.t2 = (int16_t)word(2);
+    cal.t3 = (int16_t)word(4);
+    cal.p1 = word(6);
+    cal.p2 = (int16_t)word(8);
+    cal.p3 = (int16_t)word(10);
+    cal.p4 = (int16_t)word(12);
+    cal.p5 = (int16_t)word(14);
+    cal.p6 = (int16_t)word(16);
+    cal.p7 = (int16_t)word(18);
+    cal.p8 = (int16_t)word(20);
+    cal.p9 = (int16_t)word(22);
+    cal.h1 = tp[25];
+    cal.h2 = (int16_t)(h[0] | h[1] << 8);
+    cal.h3 = h[2];
+    cal.h4 = (int16_t)((int8_t)h[3] * 16) | (h[4] & 0x0F);
+    cal.h5 = (int16_t)((int8_t)h[5] * 16) | (h[4] >> 4);
+    cal.h6 = (int8_t)h[6];
+    cal.humidity = humidity;
+    memcpy(state, &cal, sizeof(cal));
+
+    // Humidity x1 (latched by the ctrl_meas write), 1 s standby,
+    // temperature and pressure x1, normal mode
+    const uint8_t hum[2] = {BME280_REG_CTRL_HUM, 0x01};
+    const uint8_t config[2] = {BME280_REG_CONFIG, 0xA0};
+    const uint8_t meas[2] = {BME280_REG_CTRL_MEAS, 0x27};
+    return (!humidity || writeBytes(wire, address, hum, 2)) && writeBytes(wire, address, config, 2) &&
+           writeBytes(wire, address, meas, 2);
+}
+
+// Bosch reference integer compensation (BME280 datasheet, section 4.2.3)
+static bool bme280Decode(const uint8_t* raw, const uint8_t* state, KVN_Telemetry& frame) {
+    Bme280Cal c;
+    memcpy(&c, state, sizeof(c));
+
+    int32_t adcP = (int32_t)raw[0] << 12 | raw[1] << 4 | raw[2] >> 4;
+    int32_t adcT = (int32_t)raw[3] << 12 | raw[4] << 4 | raw[5] >> 4;
+    int32_t adcH = raw[6] << 8 | raw[7];
+    if (adcT == BME280_SKIPPED) return false;
+
+    int32_t var1 = ((((adcT >> 3) - ((int32_t)c.t1 << 1))) * c.t2) >> 11;
+    int32_t var2 = (((((adcT >> 4) - (int32_t)c.t1) * ((adcT >> 4) - (int32_t)c.t1)) >> 12) * c.t3) >> 14;
+    int32_t tFine = var1 + var2;
+    addFloatOnce(frame, KVN_TM_TEMPERATURE, ((tFine * 5 + 128) >> 8) / 100.0f);
+
+    if (adcP != BME280_SKIPPED) {
+        int64_t v1 = (int64_t)tFine - 128000;
+        int64_t v2 = v1 * v1 * c.p6;
+        v2 = v2 + ((v1 * c.p5) * 131072);
+        v2 = v2 + ((int64_t)c.p4 * 34359738368LL);
+        v1 = ((v1 * v1 * c.p3) / 256) + ((v1 * c.p2) * 4096);
+        v1 = ((140737488355328LL + v1) * c.p1) / 8589934592LL;
+        if (v1 != 0) {
+            int64_t pa = 1048576 - adcP;
+            pa = (((pa * 2147483648LL) - v2) * 3125) / v1;
+            v1 = ((int64_t)c.p9 * (pa / 8192) * (pa / 8192)) / 33554432;
+            v2 = ((int64_t)c.p8 * pa) / 524288;
+            pa = ((pa + v1 + v2) / 256) + ((int64_t)c.p7 * 16);   // Pa, Q24.8
+            frame.addFloat(KVN_TM_PRESSURE, pa / 25600.0f);     // hPa
+        }
+    }
+
+    if (c.humidity && adcH != 0x8000) {
+        int32_t v = tFine - 76800;
+        v = (((((adcH << 14) - ((int32_t)c.h4 * 1048576) - ((int32_t)c.h5 * v)) + 16384) >> 15) *
+             (((((((v * (int32_t)c.h6) >> 10) * (((v * (int32_t)c.h3) >> 11) + 32768)) >> 10) + 2097152) *
+                   (int32_t)c.h2 + 8192) >> 14));
+        v = v - (((((v >> 15) * (v >> 15)) >> 7) * (int32_t)c.h1) >> 4);
+        v = v < 0 ? 0 : (v > 419430400 ? 419430400 : v);
+        addFloatOnce(frame, KVN_TM_HUMIDITY, (v >> 12) / 1024.0f);
+    }
+    return true;
+}
+
+// ==================== BH1750 ====================
+
+#define BH1750_POWER_ON        0x01
+#define BH1750_CONTINUOUS_HIGH 0x10
+
+static bool bh1750Setup(TwoWire& wire, uint8_t address, uint8_t* state) {
+    (void)state;
+    uint8_t on = BH1750_POWER_ON, mode = BH1750_CONTINUOUS_HIGH;
+    return writeBytes(wire, address, &on, 1) && writeBytes(wire, address, &mode, 1);
+}
+
+static bool bh1750Decode(const uint8_t* raw, const uint8_t* state, KVN_Telemetry& frame) {
+    (void)state;
+    uint32_t counts = raw[0] << 8 | raw[1];
+    if (frame.find(KVN_TM_LUX) == nullptr) {
+        frame.addUInt(KVN_TM_LUX, (counts * 5 + 3) / 6);   // counts / 1.2
+    }
+    return true;
+}
+
+// ==================== TABLE ====================
+
+const SensorDriver SENSOR_DRIVERS[] = {
+    // name      addresses      cmd           cmdLen read every setup        decode
+    {"sht3x",  {0x44, 0x45}, {0xE0, 0x00}, 2,     6,   1,    sht3xSetup,  sht3xDecode},   // Fetch
+    {"bme280", {0x76, 0x77}, {0xF7, 0x00}, 1,     8,   1,    bme280Setup, bme280Decode},
+    {"bh1750", {0x23, 0x5C}, {0x00, 0x00}, 0,     2,   1,    bh1750Setup, bh1750Decode},
+};
+
+const uint8_t SENSOR_DRIVER_COUNT = sizeof(SENSOR_DRIVERS) / sizeof(SENSOR_DRIVERS[0]);
@@ -0,0 +1,24 @@
+/*
+ * sensor_drivers.h - I2C sensor drivers for the SensorPoller
+ *
+ * Every driver leaves its chip converting on its own, so a poll is a
+ * single burst read with nothing to trigger or wait for:
+ *
+ *   sht3x   0x44/0x45  Periodic mode, 1 Hz. Fetch 0xE000, 6 bytes, CRC checked
+ *   bme280  0x76/0x77  Normal mode, 1 s standby. Burst 0xF7..0xFE, 8 bytes.
+ *                      Chip ID checked; a BMP280 reports no humidity.
+ *   bh1750  0x23/0x5C  Continuous high-resolution mode, 2 bytes
+ *
+ * The table order is the priority for shared fields: SHT3x temperature and
+ * humidity win over the BME280's.
+ */
+
+#ifndef SENSOR_DRIVERS_H
+#define SENSOR_DRIVERS_H
+
+#include "sensor_poller.h"
+
+extern const SensorDriver SENSOR_DRIVERS[];
+extern const uint8_t SENSOR_DRIVER_COUNT;
+
+#endif // SENSOR_DRIVERS_H
@@ -0,0 +1,207 @@
+/*
+ * sensor_poller.cpp - Implementation
+ */
+
+#include "sensor_poller.h"
+#include <string.h>
+
+#define I2C_FIRST_ADDRESS 0x01
+#define I2C_LAST_ADDRESS  0x7E
+
+SensorPoller::SensorPoller(TwoWire& wire, const SensorDriver* drivers, uint8_t driverCount, uint32_t clockHz)
+    : _wire(wire) {
+    _drivers = drivers;
+    _driverCount = driverCount;
+    _clockHz = clockHz;
+    _busCount = 0;
+    _activeBus = -1;
+    _cache = nullptr;
+    _lastRead = 0;
+    _lastFailed = 0;
+}
+
+bool SensorPoller::addBus(int sda, int scl) {
+    if (_busCount >= SENSOR_MAX_BUSES) return false;
+    _sda[_busCount] = sda;
+    _scl[_busCount] = scl;
+    _busCount++;
+    return true;
+}
+
+// Changes to the driver table, pins or clock invalidate a cache left by
+// older firmware
+uint32_t SensorPoller::signature() const {
+    // FNV-1a (32-bit)
+    uint32_t h = 2166136261u;
+    auto mix = [&h](uint32_t v) {
+        for (uint8_t i = 0; i < 4; i++) {
+            h ^= (uint8_t)(v >> (i * 8));
+            h *= 16777619u;
+        }
+    };
+    for (uint8_t d = 0; d < _driverCount; d++) {
+        for (const char* c = _drivers[d].name; *c; c++) mix((uint8_t)*c);
+        mix(_drivers[d].readLength);
+    }
+    for (uint8_t b = 0; b < _busCount; b++) {
+        mix(_sda[b]);
+        mix(_scl[b]);
+    }
+    mix(_clockHz);
+    mix(sizeof(SensorCache));
+    return h ? h : 1;
+}
+
+// The C3 has one I2C controller: switch its pins to `bus`
+void SensorPoller::select(uint8_t bus) {
+    if (_activeBus == bus) return;
+    if (_activeBus >= 0) _wire.end();
+    _wire.begin(_sda[bus], _scl[bus], _clockHz);
+    _activeBus = bus;
+}
+
+bool SensorPoller::begin(SensorCache& cache) {
+    _cache = &cache;
+    if (cache.magic == signature() && cache.count <= SENSOR_MAX_DEVICES) {
+        return false;
+    }
+    scan();
+    return true;
+}
+
+bool SensorPoller::claimed(uint8_t bus, uint8_t address) const {
+    for (uint8_t i = 0; i < _cache->count; i++) {
+        const SensorSlot& s = _cache->slots[i];
+        if (s.bus == bus && s.address == address) return true;
+    }
+    return false;
+}
+
+void SensorPoller::scan() {
+    memset(_cache, 0, sizeof(SensorCache));
+
+    for (uint8_t bus = 0; bus < _busCount; bus++) {
+        select(bus);
+        for (uint8_t address = I2C_FIRST_ADDRESS; address <= I2C_LAST_ADDRESS; address++) {
+            _wire.beginTransmission(address);
+            if (_wire.endTransmission() == 0) {
+                _cache->found[bus][address >> 3] |= 1 << (address & 7);
+            }
+        }
+    }
+
+    // In driver order, so slots are ordered by driver priority
+    for (uint8_t d = 0; d < _driverCount; d++) {
+        const SensorDriver& driver = _drivers[d];
+        for (uint8_t bus = 0; bus < _busCount; bus++) {
+            for (uint8_t a = 0; a < 2; a++) {
+                uint8_t address = driver.addresses[a];
+                if (address == 0 || !(_cache->found[bus][address >> 3] & (1 << (address & 7)))) continue;
+                if (claimed(bus, address) || _cache->count >= SENSOR_MAX_DEVICES) continue;
+
+                SensorSlot& slot = _cache->slots[_cache->count];
+                select(bus);
+                if (!driver.setup(_wire, address, slot.state)) {
+                    memset(&slot, 0, sizeof(slot));
+                    continue;
+                }
+                slot.driver = d;
+                slot.bus = bus;
+                slot.address = address;
+                slot.failures = 0;
+                _cache->count++;
+            }
+        }
+    }
+
+    _cache->magic = signature();
+}
+
+bool SensorPoller::poll(KVN_Telemetry& frame) {
+    bool rescanned = false;
+    if (_cache->magic != signature()) {
+        scan();
+        rescanned = true;
+    }
+
+    uint32_t cycle = _cache->cycle++;
+    uint8_t raw[SENSOR_MAX_DEVICES][SENSOR_READ_MAX];
+    bool due[SENSOR_MAX_DEVICES];
+    bool ok[SENSOR_MAX_DEVICES];
+
+    for (uint8_t i = 0; i < _cache->count; i++) {
+        uint8_t every = _drivers[_cache->slots[i].driver].everyCycles;
+        due[i] = every <= 1 || cycle % every == 0;
+        ok[i] = false;
+    }
+
+    // One transaction per due device, bus by bus, starting with the bus
+    // the controller is already on
+    uint8_t first = _activeBus < 0 ? 0 : _activeBus;
+    for (uint8_t b = 0; b < _busCount; b++) {
+        uint8_t bus = (first + b) % _busCount;
+        for (uint8_t i = 0; i < _cache->count; i++) {
+            SensorSlot& slot = _cache->slots[i];
+            if (slot.bus != bus || !due[i]) continue;
+
+            const SensorDriver& driver = _drivers[slot.driver];
+            select(bus);
+            if (driver.cmdLength) {
+                _wire.beginTransmission(slot.address);
+                _wire.write(driver.cmd, driver.cmdLength);
+                if (_wire.endTransmission(false) != 0) continue;   // Repeated start follows
+            }
+            if (_wire.requestFrom(slot.address, driver.readLength) != driver.readLength) continue;
+            for (uint8_t n = 0; n < driver.readLength; n++) raw[i][n] = _wire.read();
+            ok[i] = true;
+        }
+    }
+
+    // Decode in driver order, so the preferred sensor claims shared fields
+    _lastRead = 0;
+    _lastFailed = 0;
+    for (uint8_t i = 0; i < _cache->count; i++) {
+        if (!due[i]) continue;
+        SensorSlot& slot = _cache->slots[i];
+        if (ok[i] && _drivers[slot.driver].decode(raw[i], slot.state, frame)) {
+            slot.failures = 0;
+            _lastRead++;
+        } else {
+            _lastFailed++;
+            if (++slot.failures >= SENSOR_FAIL_LIMIT) {
+                _cache->magic = 0;   // Rescan on the next poll()
+            }
+        }
+    }
+    return rescanned;
+}
+
+void SensorPoller::writeDiscovery(KVN_JsonWriter& json) const {
+    char address[5];
+
+    json.beginArray("devices");
+    for (uint8_t i = 0; i < _cache->count; i++) {
+        const SensorSlot& slot = _cache->slots[i];
+        snprintf(address, sizeof(address), "0x%02x", slot.address);
+        json.beginObject();
+        json.addUInt("bus", slot.bus);
+        json.addString("address", address);
+        json.addString("driver", _drivers[slot.driver].name);
+        json.endObject();
+    }
+    json.endArray();
+
+    // Answered the scan, but no driver claimed them
+    json.beginArray("unknown");
+    for (uint8_t bus = 0; bus < _busCount; bus++) {
+        for (uint8_t a = I2C_FIRST_ADDRESS; a <= I2C_LAST_ADDRESS; a++) {
+            if (!(_cache->found[bus][a >> 3] & (1 << (a & 7))) || claimed(bus, a)) continue;
+            snprintf(address, sizeof(address), "0x%02x", a);
+            json.beginObject();
+            json.addUInt("bus", bus);
+            json.addString("address", address);
+            json.endObject();
+        }
+    }
+    json.endArray();
+}
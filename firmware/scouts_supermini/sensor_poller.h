@@ -0,0 +1,117 @@
+/*
+ * sensor_poller.h - Batched I2C sensor polling for the SuperMini Scout
+ *
+ * The buses are scanned once, on a cold boot. Every address that answers
+ * is offered to the drivers that can live there. A driver's setup()
+ * identifies the chip, configures it for free-running conversions and
+ * stores any calibration in the device's state bytes. The result (bus,
+ * address, driver, state) is kept in a SensorCache in RTC memory, so a
+ * warm boot does not scan or read calibration again.
+ *
+ * Each poll() then reads every due device with one transaction: the
+ * driver's command or start register, a repeated start and a burst read
+ * of all its result bytes. Devices are grouped by bus, so the single I2C
+ * controller of the C3 is re-pinned at most once per bus per cycle. The
+ * drivers decode into one KVN_Telemetry frame. A device that fails
+ * SENSOR_FAIL_LIMIT reads in a row invalidates the cache, and the next
+ * poll() scans again.
+ */
+
+#ifndef SENSOR_POLLER_H
+#define SENSOR_POLLER_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <KVN_Telemetry.h>
+#include <KVN_JsonWriter.h>
+
+#define SENSOR_MAX_BUSES     2
+#define SENSOR_MAX_DEVICES   8
+#define SENSOR_CMD_MAX       2      // Bytes written before the burst read
+#define SENSOR_READ_MAX      8      // Bytes in one burst read
+#define SENSOR_STATE_SIZE    36     // Driver state per device (calibration)
+#define SENSOR_FAIL_LIMIT    3      // Failed reads in a row before rescanning
+
+struct SensorDriver {
+    const char* name;
+    uint8_t addresses[2];               // Where the chip can answer, 0 = unused
+    uint8_t cmd[SENSOR_CMD_MAX];        // Written before the read (register or command)
+    uint8_t cmdLength;                  // 0 = plain read
+    uint8_t readLength;
+    uint8_t everyCycles;                // Read on every Nth poll()
+
+    // Identify and configure the chip at `address`, filling `state`.
+    // Returns false if it is not this chip.
+    bool (*setup)(TwoWire& wire, uint8_t address, uint8_t* state);
+
+    // Add fields to the frame from one burst read. Returns false if the
+    // data is implausible (counted as a failed read).
+    bool (*decode)(const uint8_t* raw, const uint8_t* state, KVN_Telemetry& frame);
+};
+
+struct SensorSlot {
+    uint8_t driver;                     // Index in the driver table
+    uint8_t bus;
+    uint8_t address;
+    uint8_t failures;                   // Failed reads in a row
+    uint8_t state[SENSOR_STATE_SIZE];
+};
+
+// Keep one in RTC_DATA_ATTR memory and pass it to begin()
+struct SensorCache {
+    uint32_t magic;                     // Driver table and bus signature; anything else = scan
+    uint32_t cycle;
+    uint8_t count;
+    SensorSlot slots[SENSOR_MAX_DEVICES];
+    uint8_t found[SENSOR_MAX_BUSES][16];  // Every address that answered, by bus (bitmap)
+};
+
+class SensorPoller {
+public:
+    // Drivers earlier in the table win when two devices report the same field
+    SensorPoller(TwoWire& wire, const SensorDriver* drivers, uint8_t driverCount, uint32_t clockHz);
+
+    // Register a bus by its pins, before begin(). Returns false if full.
+    bool addBus(int sda, int scl);
+
+    // Restore the devices from `cache`, or scan if it does not match this
+    // firmware. Returns true if a scan ran (publish the discovery again).
+    bool begin(SensorCache& cache);
+
+    // Read every due device into `frame`. Returns true if this poll had to
+    // rescan first (after a device stopped answering).
+    bool poll(KVN_Telemetry& frame);
+
+    uint8_t deviceCount() const { return _cache ? _cache->count : 0; }
+    const SensorSlot& device(uint8_t index) const { return _cache->slots[index]; }
+    const char* driverName(const SensorSlot& slot) const { return _drivers[slot.driver].name; }
+
+    // Devices read and failed in the latest poll()
+    uint8_t lastRead() const { return _lastRead; }
+    uint8_t lastFailed() const { return _lastFailed; }
+
+    // {"devices":[{"bus":0,"address":"0x23","driver":"bh1750"},...],"unknown":[...]}
+    void writeDiscovery(KVN_JsonWriter& json) const;
+
+private:
+    TwoWire& _wire;
+    const SensorDriver* _drivers;
+    uint8_t _driverCount;
+    uint32_t _clockHz;
+
+    int _sda[SENSOR_MAX_BUSES];
+    int _scl[SENSOR_MAX_BUSES];
+    uint8_t _busCount;
+    int8_t _activeBus;
+
+    SensorCache* _cache;
+    uint8_t _lastRead;
+    uint8_t _lastFailed;
+
+    uint32_t signature() const;
+    void select(uint8_t bus);
+    void scan();
+    bool claimed(uint8_t bus, uint8_t address) const;
+};
+
+#endif // SENSOR_POLLER_H
@@ -0,0 +1,810 @@
+/*
+ * audio_codecs.cpp - Conformance, real-time factor and heap of the
+ * ESP32-audioI2S decoders
+ *
+ * Each file is decoded from memory the way Audio::sendBytes() drives the
+ * decoder on the device. The container header is skipped first, as the
+ * read_*_Header() functions do. Then the decoder is handed at most the
+ * input block size of Audio.h (m_frameSizeMP3 and so on): find the sync
+ * word, call decode, advance by the bytes consumed, and skip one byte after
+ * an error. The output buffer has the device size, m_outbuffSize.
+ *
+ * Reported per file:
+ *   kbps    average bitrate of the audio data
+ *   xRT     audio seconds decoded per wall second (1 / real-time factor),
+ *           best of --runs on this host
+ *   heap    peak bytes the decoder had allocated, AllocateBuffers() to
+ *           FreeBuffers(). Every malloc/calloc/realloc/free inside a decoder
+ *           call is counted, PSRAM included (hal/esp_heap_caps.h).
+ *   pcm     FNV-1a of the output, to spot bit-exact changes between builds
+ *   check   FLAC: the MD5 in STREAMINFO over the decoded samples.
+ *           Bundled files: the pcm hash against PINNED ("pcm ok").
+ *           Reference: <refs>/<file>.wav, aligned on the best lag within
+ *           +-4096 frames. The column shows the SNR, or "exact". <refs> is
+ *           bench/refs unless --ref DIR is given.
+ *           A file none of these apply to is "unchecked".
+ *
+ * References come from another decoder (tools/codec_refs.py, ffmpeg) or
+ * from a known-good build of these decoders (--write-ref DIR, cut to
+ * --ref-seconds). bench/refs holds the first half second of each bundled
+ * lossy file, from the build that set PINNED, so a decoder change that
+ * moves a pin still has to stay within the SNR floor. The run exits with 1
+ * if a file does not decode, decodes differently between runs, fails its
+ * MD5 or its pin, or is below the SNR floor against its reference.
+ * Unchecked files are counted on the last line.
+ */
+
+#include "mp3_decoder/mp3_decoder.h"
+#include "aac_decoder/aac_decoder.h"
+#include "flac_decoder/flac_decoder.h"
+#include "vorbis_decoder/vorbis_decoder.h"
+#include "opus_decoder/opus_decoder.h"
+#include <malloc.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define OUTBUFF_SIZE  (4096 * 2)   // Audio.h m_outbuffSize, int16 samples
+#define MAX_LAG       4096         // Reference alignment search, frames
+
+// ==================== HEAP METER ====================
+
+// malloc and friends are replaced for the whole program. Only blocks
+// allocated or freed while g_metering is set are counted. Decoders free
+// only their own blocks, inside their own calls.
+static bool   g_metering;
+static size_t g_inUse;
+static size_t g_peak;
+
+#if defined(__SANITIZE_ADDRESS__)
+  #define HEAP_METER 0             // ASan owns malloc
+#elif defined(__has_feature)
+  #if __has_feature(address_sanitizer)
+    #define HEAP_METER 0
+  #else
+    #define HEAP_METER 1
+  #endif
+#else
+  #define HEAP_METER 1
+#endif
+
+#if HEAP_METER
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void  __libc_free(void* ptr);
+
+static inline void heapAdd(void* p) {
+    if (!g_metering || !p) return;
+    g_inUse += malloc_usable_size(p);
+    if (g_inUse > g_peak) g_peak = g_inUse;
+}
+
+static inline void heapSub(void* p) {
+    if (!g_metering || !p) return;
+    g_inUse -= malloc_usable_size(p);
+}
+
+void* malloc(size_t size) {
+    void* p = __libc_malloc(size);
+    heapAdd(p);
+    return p;
+}
+
+void* calloc(size_t n, size_t size) {
+    void* p = __libc_calloc(n, size);
+    heapAdd(p);
+    return p;
+}
+
+void* realloc(void* ptr, size_t size) {
+    heapSub(ptr);
+    void* p = __libc_realloc(ptr, size);
+    heapAdd(p ? p : ptr);   // A failed realloc keeps the old block
+    return p;
+}
+
+void free(void* ptr) {
+    heapSub(ptr);
+    __libc_free(ptr);
+}
+}
+#endif
+
+// Brackets every decoder call
+struct Metered {
+    Metered() { g_metering = true; }
+    ~Metered() { g_metering = false; }
+};
+
+// ==================== CODECS ====================
+
+struct Input {
+    std::vector<uint8_t> data;
+    size_t   start = 0;            // Audio data, container header skipped
+    size_t   end = 0;
+    // Set by the container parsers
+    uint8_t  channels = 0;
+    uint32_t sampleRate = 0;
+    uint8_t  bitsPerSample = 0;
+    uint8_t  objectType = 0;       // M4A
+    uint64_t totalFrames = 0;      // FLAC
+    uint8_t  md5[16] = {0};        // FLAC, all zero: not set
+};
+
+// One decoder, through the calls Audio.cpp makes
+struct Codec {
+    const char* name;
+    uint16_t    maxBlock;                                  // Audio.h m_frameSize*
+    bool     (*open)();
+    void     (*close)();
+    void     (*start)(const Input& in);                    // After open, before the first sync (or nullptr)
+    int32_t  (*findSync)(uint8_t* data, int32_t len);      // -1: none in this block
+    int32_t  (*decode)(uint8_t* data, int32_t* bytesLeft, int16_t* out);
+    uint32_t (*frames)();                                  // Output frames of the last decode
+    uint32_t (*sampleRate)();
+    uint8_t  (*channels)();
+    bool     (*silent)(int32_t ret);                       // Consumed input without output (ogg headers)
+    bool     (*fatal)(int32_t ret);                        // Audio.cpp stops the song
+};
+
+// MP3
+static bool mp3Open() { return MP3Decoder_AllocateBuffers(); }
+static int32_t mp3Sync(uint8_t* d, int32_t n) { return MP3FindSyncWord(d, n); }
+static int32_t mp3Decode(uint8_t* d, int32_t* left, int16_t* out) { return MP3Decode(d, left, out, 0); }
+static uint32_t mp3Frames() { return MP3GetOutputSamps() / MP3GetChannels(); }
+static uint32_t mp3Rate() { return MP3GetSampRate(); }
+static uint8_t mp3Channels() { return MP3GetChannels(); }
+
+// AAC, ADTS or raw blocks from an M4A
+static bool aacOpen() { return AACDecoder_AllocateBuffers(); }
+static void m4aStart(const Input& in) {
+    AACSetRawBlockParams(in.channels ? in.channels : 2, in.sampleRate ? in.sampleRate : 44100,
+                         in.objectType ? in.objectType : 2);
+}
+static int32_t aacSync(uint8_t* d, int32_t n) { return AACFindSyncWord(d, n); }
+static int32_t m4aSync(uint8_t* d, int32_t n) { (void)d; (void)n; return 0; }
+static int32_t aacDecode(uint8_t* d, int32_t* left, int16_t* out) { return AACDecode(d, left, out); }
+static uint32_t aacFrames() { return AACGetOutputSamps() / AACGetChannels(); }
+static uint32_t aacRate() { return AACGetSampRate(); }
+static uint8_t aacChannels() { return AACGetChannels(); }
+
+// FLAC, native or in Ogg
+static bool flacOpen() { return FLACDecoder_AllocateBuffers(); }
+static void flacStart(const Input& in) {
+    if (in.sampleRate) {   // Native: read_FLAC_Header() has parsed STREAMINFO
+        FLACSetRawBlockParams(in.channels, in.sampleRate, in.bitsPerSample, (uint32_t)in.totalFrames,
+                              (uint32_t)(in.end - in.start));
+    }
+}
+static int32_t flacSync(uint8_t* d, int32_t n) { return FLACFindSyncWord(d, n); }
+static int32_t flacDecode(uint8_t* d, int32_t* left, int16_t* out) { return FLACDecode(d, left, out); }
+static uint32_t flacFrames() { return FLACGetOutputSamps() / FLACGetChannels(); }
+static uint32_t flacRate() { return FLACGetSampRate(); }
+static uint8_t flacChannels() { return FLACGetChannels(); }
+static bool flacSilent(int32_t ret) { return ret == FLAC_PARSE_OGG_DONE; }
+
+// Vorbis
+static bool vorbisOpen() { return VORBISDecoder_AllocateBuffers(); }
+static int32_t vorbisSync(uint8_t* d, int32_t n) { return VORBISFindSyncWord(d, n); }
+static int32_t vorbisDecode(uint8_t* d, int32_t* left, int16_t* out) { return VORBISDecode(d, left, out); }
+static uint32_t vorbisFrames() { return VORBISGetOutputSamps(); }
+static uint32_t vorbisRate() { return VORBISGetSampRate(); }
+static uint8_t vorbisChannels() { return VORBISGetChannels(); }
+static bool vorbisSilent(int32_t ret) { return ret == VORBIS_PARSE_OGG_DONE; }
+
+// Opus
+static bool opusOpen() { return OPUSDecoder_AllocateBuffers(); }
+static int32_t opusSync(uint8_t* d, int32_t n) { return OPUSFindSyncWord(d, n); }
+static int32_t opusDecode(uint8_t* d, int32_t* left, int16_t* out) { return OPUSDecode(d, left, out); }
+static uint32_t opusFrames() { return OPUSGetOutputSamps(); }
+static uint32_t opusRate() { return OPUSGetSampRate(); }
+static uint8_t opusChannels() { return OPUSGetChannels(); }
+static bool opusSilent(int32_t ret) { return ret == OPUS_PARSE_OGG_DONE || ret == OPUS_END; }
+static bool opusFatal(int32_t ret) {
+    return ret == ERR_OPUS_HYBRID_MODE_UNSUPPORTED || ret == ERR_OPUS_SILK_MODE_UNSUPPORTED ||
+           ret == ERR_OPUS_NARROW_BAND_UNSUPPORTED || ret == ERR_OPUS_WIDE_BAND_UNSUPPORTED ||
+           ret == ERR_OPUS_SUPER_WIDE_BAND_UNSUPPORTED || ret == ERR_OPUS_INVALID_SAMPLERATE;
+}
+
+static const Codec MP3  = {"mp3",  1600,     mp3Open,  MP3Decoder_FreeBuffers, nullptr, mp3Sync,
+                           mp3Decode,  mp3Frames,  mp3Rate,  mp3Channels,  nullptr, nullptr};
+static const Codec AAC  = {"aac",  1600,     aacOpen,  AACDecoder_FreeBuffers, nullptr, aacSync,
+                           aacDecode,  aacFrames,  aacRate,  aacChannels,  nullptr, nullptr};
+static const Codec M4A  = {"m4a",  1600,     aacOpen,  AACDecoder_FreeBuffers, m4aStart, m4aSync,
+                           aacDecode,  aacFrames,  aacRate,  aacChannels,  nullptr, nullptr};
+static const Codec FLAC = {"flac", 4096 * 6, flacOpen, FLACDecoder_FreeBuffers, flacStart, flacSync,
+                           flacDecode, flacFrames, flacRate, flacChannels, flacSilent, nullptr};
+static const Codec VORBIS = {"vorbis", 4096 * 2, vorbisOpen, VORBISDecoder_FreeBuffers, nullptr, vorbisSync,
+                             vorbisDecode, vorbisFrames, vorbisRate, vorbisChannels, vorbisSilent, nullptr};
+static const Codec OPUS = {"opus", 1024,     opusOpen, OPUSDecoder_FreeBuffers, nullptr, opusSync,
+                           opusDecode, opusFrames, opusRate, opusChannels, opusSilent, opusFatal};
+
+// SNR floor against a reference from another decoder. Fixed-point decoders
+// round differently from float ones, so these are loose; FLAC must be exact.
+static double floorDb(const Codec* c) {
+    if (c == &FLAC) return INFINITY;
+    if (c == &OPUS) return 30;
+    return 40;
+}
+
+// ==================== CONTAINERS ====================
+
+static uint32_t bigEndian(const uint8_t* p, int n) {
+    uint32_t v = 0;
+    for (int i = 0; i < n; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+static int find(const Input& in, size_t from, size_t to, const char* tag) {
+    size_t n = strlen(tag);
+    for (size_t i = from; i + n <= to; i++) {
+        if (memcmp(&in.data[i], tag, n) == 0) return (int)i;
+    }
+    return -1;
+}
+
+// ID3v2 in front, ID3v1 at the end
+static bool mp3Header(Input& in) {
+    const uint8_t* d = in.data.data();
+    in.start = 0;
+    in.end = in.data.size();
+    if (in.end >= 10 && memcmp(d, "ID3", 3) == 0) {
+        uint32_t size = (d[6] & 0x7F) << 21 | (d[7] & 0x7F) << 14 | (d[8] & 0x7F) << 7 | (d[9] & 0x7F);
+        in.start = 10 + size + ((d[5] & 0x10) ? 10 : 0);   // Footer flag
+    }
+    if (in.end >= 128 && memcmp(d + in.end - 128, "TAG", 3) == 0) in.end -= 128;
+    return in.start < in.end;
+}
+
+// Metadata blocks up to the first frame, STREAMINFO kept
+static bool flacHeader(Input& in) {
+    const uint8_t* d = in.data.data();
+    in.end = in.data.size();
+    if (memcmp(d, "OggS", 4) == 0) {   // FLAC in Ogg: the decoder parses it all
+        in.start = 0;
+        return true;
+    }
+    if (memcmp(d, "fLaC", 4) != 0) return false;
+    size_t pos = 4;
+    bool last = false;
+    while (!last && pos + 4 <= in.end) {
+        uint8_t type = d[pos] & 0x7F;
+        last = d[pos] & 0x80;
+        uint32_t len = bigEndian(d + pos + 1, 3);
+        const uint8_t* b = d + pos + 4;
+        if (type == 0 && len >= 34) {   // STREAMINFO
+            in.sampleRate = bigEndian(b + 10, 3) >> 4;
+            in.channels = ((b[12] >> 1) & 0x07) + 1;
+            in.bitsPerSample = (((b[12] & 0x01) << 4) | (b[13] >> 4)) + 1;
+            in.totalFrames = ((uint64_t)(b[13] & 0x0F) << 32) | bigEndian(b + 14, 4);
+            memcpy(in.md5, b + 18, 16);
+        }
+        pos += 4 + len;
+    }
+    in.start = pos;
+    return in.sampleRate && pos < in.end;
+}
+
+// Top level atoms: mdat holds the raw AAC blocks, moov the decoder config
+// (esds) and the sample entry (mp4a). Either may come first.
+static bool m4aHeader(Input& in) {
+    const uint8_t* d = in.data.data();
+    const size_t size = in.data.size();
+    size_t moov = 0, moovEnd = 0;
+    for (size_t pos = 0; pos + 8 <= size;) {
+        uint64_t len = bigEndian(d + pos, 4);
+        size_t head = 8;
+        if (len == 1 && pos + 16 <= size) {   // 64-bit size
+            len = ((uint64_t)bigEndian(d + pos + 8, 4) << 32) | bigEndian(d + pos + 12, 4);
+            head = 16;
+        }
+        if (len == 0 || pos + len > size) len = size - pos;
+        if (len < head) return false;
+        if (memcmp(d + pos + 4, "mdat", 4) == 0) {
+            in.start = pos + head;
+            in.end = pos + len;
+        }
+        if (memcmp(d + pos + 4, "moov", 4) == 0) {
+            moov = pos;
+            moovEnd = pos + len;
+        }
+        pos += len;
+    }
+    if (!in.end || !moovEnd) return false;
+
+    int esds = find(in, moov, moovEnd, "esds");
+    if (esds > 0) {
+        // Descriptors 03 (ES), 04 (decoder config), 05 (AudioSpecificConfig), each with a variable length
+        const uint8_t* p = d + esds + 8;
+        auto skipLength = [](const uint8_t*& q) { while (*q++ & 0x80) {} };
+        p++;
+        skipLength(p);
+        p += 3;
+        p++;
+        skipLength(p);
+        p += 13;
+        p++;
+        skipLength(p);
+        uint16_t asc = bigEndian(p, 2);
+        in.objectType = asc >> 11;
+        in.channels = (asc >> 3) & 0x0F;
+    }
+    int mp4a = find(in, moov, moovEnd, "mp4a");
+    if (mp4a > 0) {
+        if (!in.channels) in.channels = bigEndian(d + mp4a + 20, 2);
+        in.sampleRate = bigEndian(d + mp4a + 26, 4);
+    }
+    return true;
+}
+
+// ==================== CORPUS ====================
+
+struct Entry {
+    std::string  path;
+    std::string  name;
+    const Codec* codec;
+    Input        in;
+};
+
+static bool load(const std::string& path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data.resize(size > 0 ? size : 0);
+    bool ok = fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok && !data.empty();
+}
+
+// Codec by extension; Ogg by the first packet
+static const Codec* identify(const std::string& path, Input& in) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    in.start = 0;
+    in.end = in.data.size();
+    if (ext == ".mp3") return mp3Header(in) ? &MP3 : nullptr;
+    if (ext == ".aac") return &AAC;
+    if (ext == ".m4a" || ext == ".mp4") return m4aHeader(in) ? &M4A : nullptr;
+    if (ext == ".flac") return flacHeader(in) ? &FLAC : nullptr;
+    if (ext == ".ogg" || ext == ".oga" || ext == ".opus") {
+        size_t head = std::min(in.data.size(), (size_t)512);
+        if (find(in, 0, head, "OpusHead") >= 0) return &OPUS;
+        if (find(in, 0, head, "\x01vorbis") >= 0) return &VORBIS;
+        if (find(in, 0, head, "\x7f" "FLAC") >= 0) return flacHeader(in) ? &FLAC : nullptr;
+    }
+    return nullptr;
+}
+
+// ==================== DECODE ====================
+
+struct Decoded {
+    std::vector<int16_t> pcm;      // Interleaved
+    uint64_t frames = 0;
+    uint32_t sampleRate = 0;
+    uint8_t  channels = 0;
+    uint32_t errors = 0;
+    bool     stopped = false;      // A fatal error, as Audio.cpp stops the song
+    double   seconds = 0;          // Wall time of the decode
+    size_t   peak = 0;
+    size_t   leaked = 0;
+};
+
+static void decode(const Entry& e, Decoded& out) {
+    static int16_t outBuff[OUTBUFF_SIZE];
+    const Codec& c = *e.codec;
+    // A copy, as some decoders write into the input. The bit readers look a
+    // few bytes ahead; on the device InBuff always has room behind the data.
+    std::vector<uint8_t> data = e.in.data;
+    data.resize(data.size() + c.maxBlock);
+    uint8_t* d = data.data();
+
+    out.pcm.clear();
+    out.frames = 0;
+    out.errors = 0;
+    out.stopped = false;
+    g_inUse = g_peak = 0;
+    auto t0 = std::chrono::steady_clock::now();
+
+    bool open;
+    {
+        Metered m;
+        open = c.open();
+        if (open && c.start) c.start(e.in);
+    }
+    size_t pos = e.in.start;
+    bool playing = false;
+    while (open && pos < e.in.end) {
+        int32_t len = (int32_t)std::min((size_t)c.maxBlock, e.in.end - pos);
+        int32_t left = len, ret;
+        uint32_t frames = 0;
+        {
+            Metered m;
+            if (!playing) {
+                int32_t sync = c.findSync(d + pos, len);
+                if (sync != 0) {
+                    pos += sync < 0 ? len : sync;
+                    continue;
+                }
+                playing = true;
+            }
+            ret = c.decode(d + pos, &left, outBuff);
+            if (ret >= 0 && !(c.silent && c.silent(ret))) frames = c.frames();
+            if (frames && !out.sampleRate) {
+                out.sampleRate = c.sampleRate();
+                out.channels = c.channels();
+            }
+        }
+        if (ret < 0) {
+            out.errors++;
+            playing = false;
+            if (c.fatal && c.fatal(ret)) {
+                out.stopped = true;
+                break;
+            }
+            pos++;   // Seek the next sync word
+            continue;
+        }
+        if (left == len && ret == 0) {   // Nothing consumed
+            playing = false;
+            pos++;
+            continue;
+        }
+        pos += len - left;
+        if (frames) {
+            out.pcm.insert(out.pcm.end(), outBuff, outBuff + frames * out.channels);
+            out.frames += frames;
+        }
+    }
+    {
+        Metered m;
+        c.close();
+    }
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    out.peak = g_peak;
+    out.leaked = g_inUse;
+}
+
+// ==================== CHECKS ====================
+
+// Output of these decoders for the bundled files, the same at -O0 and
+// -O2 (AAC is built FIXED_POINT). A decoder change that moves one must
+// come with its new hash; bench/refs shows the output is still good.
+static const struct {
+    const char* name;
+    uint32_t pcm;
+} PINNED[] = {
+    {"Collide.ogg", 0x435cbf4e},
+    {"Little London Girl(lyrics).mp3", 0x5ae0e3ee},
+    {"Miss-Marple.m4a", 0xfce853aa},
+    {"Olsen-Banden.mp3", 0x0be0330d},
+    {"Santiano-Wellerman.flac", 0xf2b7920f},
+    {"sample.opus", 0xea128974},
+};
+
+static const uint32_t* pinned(const std::string& name) {
+    for (const auto& p : PINNED) {
+        if (name == p.name) return &p.pcm;
+    }
+    return nullptr;
+}
+
+static uint32_t fnv1a(const std::vector<int16_t>& pcm) {
+    uint32_t h = 2166136261u;
+    const uint8_t* p = (const uint8_t*)pcm.data();
+    for (size_t i = 0; i < pcm.size() * 2; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// RFC 1321, for the FLAC STREAMINFO signature
+static void md5(const uint8_t* msg, size_t len, uint8_t digest[16]) {
+    static const uint32_t K[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+    static const uint8_t R[64] = {7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                                  5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+                                  4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                                  6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+    uint32_t h[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+    std::vector<uint8_t> m(msg, msg + len);
+    m.push_back(0x80);
+    while (m.size() % 64 != 56) m.push_back(0);
+    for (int i = 0; i < 8; i++) m.push_back((uint8_t)(((uint64_t)len * 8) >> (8 * i)));
+
+    for (size_t off = 0; off < m.size(); off += 64) {
+        uint32_t w[16];
+        for (int i = 0; i < 16; i++) {
+            const uint8_t* b = &m[off + 4 * i];
+            w[i] = b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24;
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+        for (int i = 0; i < 64; i++) {
+            uint32_t f, g;
+            if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+            else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) % 16; }
+            else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) % 16; }
+            else             { f = c ^ (b | ~d);       g = (7 * i) % 16; }
+            uint32_t t = d;
+            d = c;
+            c = b;
+            uint32_t x = a + f + K[i] + w[g];
+            b += (x << R[i]) | (x >> (32 - R[i]));
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+    }
+    for (int i = 0; i < 16; i++) digest[i] = (uint8_t)(h[i / 4] >> (8 * (i % 4)));
+}
+
+struct Wav {
+    std::vector<int16_t> pcm;
+    uint32_t sampleRate = 0;
+    uint8_t  channels = 0;
+};
+
+// PCM16 only
+static bool readWav(const std::string& path, Wav& wav) {
+    std::vector<uint8_t> d;
+    if (!load(path, d) || d.size() < 12 || memcmp(&d[0], "RIFF", 4) || memcmp(&d[8], "WAVE", 4)) return false;
+    auto le = [&](size_t p, int n) {
+        uint32_t v = 0;
+        for (int i = n - 1; i >= 0; i--) v = (v << 8) | d[p + i];
+        return v;
+    };
+    bool fmt = false;
+    for (size_t pos = 12; pos + 8 <= d.size();) {
+        uint32_t len = le(pos + 4, 4);
+        if (memcmp(&d[pos], "fmt ", 4) == 0 && len >= 16) {
+            uint16_t format = le(pos + 8, 2);
+            wav.channels = le(pos + 10, 2);
+            wav.sampleRate = le(pos + 12, 4);
+            fmt = (format == 1 || format == 0xFFFE) && le(pos + 22, 2) == 16;
+        }
+        if (memcmp(&d[pos], "data", 4) == 0 && fmt) {
+            size_t n = std::min((size_t)len, d.size() - pos - 8) / 2;
+            wav.pcm.resize(n);
+            memcpy(wav.pcm.data(), &d[pos + 8], n * 2);
+            return true;
+        }
+        pos += 8 + len + (len & 1);
+    }
+    return false;
+}
+
+// The first `frames` frames of the output (all if 0)
+static bool writeWav(const std::string& path, const Decoded& out, uint64_t frames) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    size_t samples = frames ? std::min(out.pcm.size(), (size_t)frames * out.channels) : out.pcm.size();
+    uint32_t bytes = (uint32_t)(samples * 2);
+    uint8_t h[44];
+    auto put = [&](int p, uint32_t v, int n) { for (int i = 0; i < n; i++) h[p + i] = (uint8_t)(v >> (8 * i)); };
+    memcpy(h, "RIFF", 4);
+    put(4, 36 + bytes, 4);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put(16, 16, 4);
+    put(20, 1, 2);
+    put(22, out.channels, 2);
+    put(24, out.sampleRate, 4);
+    put(28, out.sampleRate * out.channels * 2, 4);
+    put(32, out.channels * 2, 2);
+    put(34, 16, 2);
+    memcpy(h + 36, "data", 4);
+    put(40, bytes, 4);
+    bool ok = fwrite(h, 1, 44, f) == 44 && fwrite(out.pcm.data(), 2, samples, f) == samples;
+    fclose(f);
+    return ok;
+}
+
+// Reference comparison. Decoders differ in start-up delay and priming, so the
+// output is aligned on the lag (output ahead of reference by `lag` frames)
+// with the largest correlation over half a second, one second in; over
+// the middle half of a reference shorter than two seconds.
+struct Match {
+    bool   ok = false;             // Formats agree and the signals overlap
+    int    lag = 0;
+    double snr = 0;                // dB, INFINITY when identical
+    int    maxError = 0;
+};
+
+static Match compare(const Decoded& out, const Wav& ref) {
+    Match r;
+    if (ref.channels != out.channels || ref.sampleRate != out.sampleRate) return r;
+    const int ch = out.channels;
+    const long n = (long)out.frames, m = (long)(ref.pcm.size() / ch);
+    auto mono = [ch](const std::vector<int16_t>& pcm, long i) {
+        long s = 0;
+        for (int c = 0; c < ch; c++) s += pcm[i * ch + c];
+        return (double)s;
+    };
+
+    const long from = std::min({(long)out.sampleRate, n / 4, m / 4});
+    const long window = std::min({(long)out.sampleRate / 2, n / 2, m / 2});
+    double best = -INFINITY;
+    for (int lag = -MAX_LAG; lag <= MAX_LAG; lag++) {
+        if (from + lag < 0 || from + window + lag > n || from + window > m) continue;
+        double dot = 0;
+        for (long i = from; i < from + window; i++) dot += mono(out.pcm, i + lag) * mono(ref.pcm, i);
+        if (dot > best) {
+            best = dot;
+            r.lag = lag;
+        }
+    }
+
+    double signal = 0, noise = 0;
+    long overlap = 0;
+    for (long i = std::max(0L, (long)-r.lag); i < m && i + r.lag < n; i++, overlap++) {
+        for (int c = 0; c < ch; c++) {
+            int a = out.pcm[(i + r.lag) * ch + c], b = ref.pcm[i * ch + c];
+            signal += (double)b * b;
+            noise += (double)(a - b) * (a - b);
+            r.maxError = std::max(r.maxError, abs(a - b));
+        }
+    }
+    r.ok = overlap > 0;
+    r.snr = noise == 0 ? INFINITY : 10 * log10(signal / noise);
+    return r;
+}
+
+// ==================== MAIN ====================
+
+#define LYRICS_MP3 KVN_AUDIO_LYRICS "/Little London Girl(lyrics).mp3"
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s [--runs N] [--ref DIR] [--write-ref DIR] [--ref-seconds S] [--verbose] [file...]\n"
+            "  default files: %s, %s\n"
+            "  default references: %s\n",
+            argv0, KVN_AUDIO_TESTFILES, LYRICS_MP3, KVN_AUDIO_REFS);
+}
+
+int main(int argc, char** argv) {
+    int runs = 3;
+    double refSeconds = 0;
+    std::string refDir = KVN_AUDIO_REFS, writeDir;
+    std::vector<std::string> paths;
+    kvn_log_level = KVN_LOG_NONE;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--ref") == 0 && i + 1 < argc) refDir = argv[++i];
+        else if (strcmp(argv[i], "--write-ref") == 0 && i + 1 < argc) writeDir = argv[++i];
+        else if (strcmp(argv[i], "--ref-seconds") == 0 && i + 1 < argc) refSeconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "--verbose") == 0) kvn_log_level = KVN_LOG_DEBUG;
+        else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        std::error_code ec;
+        for (const auto& f : std::filesystem::directory_iterator(KVN_AUDIO_TESTFILES, ec)) {
+            paths.push_back(f.path().string());
+        }
+        std::sort(paths.begin(), paths.end());
+        paths.push_back(LYRICS_MP3);   // CBR MP3, next to the VBR one
+    }
+
+    std::vector<Entry> corpus;
+    for (const std::string& p : paths) {
+        Entry e;
+        e.path = p;
+        e.name = std::filesystem::path(p).filename().string();
+        if (!load(p, e.in.data)) {
+            fprintf(stderr, "%s: cannot read\n", p.c_str());
+            return 2;
+        }
+        e.codec = identify(p, e.in);
+        if (e.codec) corpus.push_back(std::move(e));
+    }
+    if (corpus.empty()) {
+        fprintf(stderr, "no decodable files\n");
+        return 2;
+    }
+
+    bool ok = true;
+    int unchecked = 0;
+    printf("\n=== ESP32-audioI2S decoders, best of %d run%s ===\n", runs, runs == 1 ? "" : "s");
+    printf("%-30s %-6s %6s %2s %5s %6s %7s %8s %8s  %-10s\n", "file", "codec", "rate", "ch", "kbps", "sec",
+           "xRT", "heap KiB", "pcm", "check");
+    for (const Entry& e : corpus) {
+        Decoded out;
+        double best = INFINITY;
+        uint32_t hash = 0;
+        bool stable = true;
+        for (int r = 0; r < runs; r++) {
+            decode(e, out);
+            best = std::min(best, out.seconds);
+            uint32_t h = fnv1a(out.pcm);
+            if (r > 0 && h != hash) stable = false;
+            hash = h;
+        }
+
+        const double duration = out.sampleRate ? (double)out.frames / out.sampleRate : 0;
+        const double kbps = duration > 0 ? (e.in.end - e.in.start) * 8 / duration / 1000 : 0;
+        std::string check;
+        char part[32];
+        bool good = out.frames > 0 && !out.stopped && stable;
+
+        bool hasMd5 = false;
+        for (uint8_t b : e.in.md5) hasMd5 |= b != 0;
+        if (e.codec == &FLAC && hasMd5 && e.in.bitsPerSample == 16) {
+            uint8_t digest[16];
+            md5((const uint8_t*)out.pcm.data(), out.pcm.size() * 2, digest);
+            bool match = memcmp(digest, e.in.md5, 16) == 0;
+            check += match ? " md5 ok" : " md5 BAD";
+            good &= match;
+        }
+        if (const uint32_t* pin = pinned(e.name)) {
+            check += hash == *pin ? " pcm ok" : " pcm BAD";
+            good &= hash == *pin;
+        }
+        Wav ref;
+        std::string refPath = refDir + "/" + e.name + ".wav";
+        if (readWav(refPath, ref)) {
+            Match m = compare(out, ref);
+            bool pass = m.ok && (std::isinf(floorDb(e.codec)) ? m.maxError == 0 : m.snr >= floorDb(e.codec));
+            if (!m.ok) check += " ref format";
+            else if (std::isinf(m.snr)) check += " exact";
+            else {
+                snprintf(part, sizeof(part), " %.1f dB", m.snr);
+                check += part;
+            }
+            if (!pass) check += " LOW";
+            good &= pass;
+        } else if (refDir == KVN_AUDIO_REFS && e.codec != &FLAC && pinned(e.name)) {
+            check += " ref missing";   // Every bundled lossy file has one
+            good = false;
+        }
+        if (check.empty()) {
+            check = " unchecked";
+            unchecked++;
+        }
+        if (!writeDir.empty()) {
+            std::filesystem::create_directories(writeDir);
+            if (!writeWav(writeDir + "/" + e.name + ".wav", out, (uint64_t)(refSeconds * out.sampleRate))) {
+                fprintf(stderr, "%s: cannot write reference\n", e.name.c_str());
+                return 2;
+            }
+        }
+
+        printf("%-30s %-6s %6u %2u %5.0f %6.1f %7.0f ", e.name.c_str(), e.codec->name, out.sampleRate,
+               out.channels, kbps, duration, best > 0 ? duration / best : 0);
+        if (HEAP_METER) printf("%8.1f", out.peak / 1024.0);
+        else printf("%8s", "-");
+        printf(" %08x %s\n", hash, check.c_str());
+
+        if (out.errors) printf("  %u decode error%s%s\n", out.errors, out.errors == 1 ? "" : "s",
+                               out.stopped ? ", stopped" : "");
+        if (!stable) printf("  output differs between runs\n");
+        if (HEAP_METER && out.leaked) printf("  %zu bytes still allocated after FreeBuffers()\n", out.leaked);
+        ok &= good;
+    }
+    if (!ok) printf("\nFAILED\n");
+    else if (unchecked) printf("\nall files decoded, %d unchecked (no pin, no reference)\n", unchecked);
+    else printf("\nall files decoded and checked\n");
+    return ok ? 0 : 1;
+}
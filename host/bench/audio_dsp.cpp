@@ -0,0 +1,450 @@
+/*
+ * audio_dsp.cpp - Cost of the audio post-processing in Audio::playChunk()
+ *
+ * Before: a copy of the library's previous per-sample code, unchanged in
+ * arithmetic. computeVUlevel(), the level correction, the three float
+ * IIR_filterChain stages (int16 truncation after each), forceMono and a
+ * double Gain() ran once per frame. resampleTo48kStereo() allocated a
+ * std::vector and divided per output frame.
+ *
+ * After: AudioDSP (src/audio_dsp), built here without ESP-DSP, so this
+ * measures the portable fixed-point path. It resamples with the default
+ * tier (medium) of the polyphase resampler; kvn_bench_audio_resampler
+ * compares the tiers.
+ *
+ * The input is 44.1 kHz stereo (three tones and a little noise, about
+ * -6 dBFS) in 1152-frame chunks, one MP3 frame each. The tone setting is
+ * +6 / -3 / +3 dB at volume 18 of 21, and the balance is slightly left.
+ * Every stage is timed over the same chunks, and a copy-only pass is
+ * subtracted. Every pass folds its whole output chunk (and the VU
+ * levels) into a sink, so no stage can be optimised away. The best of
+ * --runs is kept. In the fused AudioDSP pass the cost of a stage is the
+ * difference between two configurations. The whole chunk is timed with
+ * and without resampling, since the resampler tier dominates it.
+ *
+ * Accuracy: both outputs before resampling, against a double-precision
+ * run of the same chain.
+ */
+
+#include "audio_dsp.h"
+#include "legacy_resample.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#define RATE         44100
+#define CHUNK        1152
+#define SECONDS      10
+#define VOLUME       18
+#define VOLUME_STEPS 21
+#define BALANCE      -2      // -16 (mute left) ... +16 (mute right)
+
+static const int8_t TONE[3] = {6, -3, 3};   // Low shelf, peak EQ, high shelf (dB)
+
+// ==================== COEFFICIENTS ====================
+
+struct Biquad {
+    float a0, a1, a2, b1, b2;   // Naming of Audio::IIR_calculateCoefficients()
+};
+
+// Audio::IIR_calculateCoefficients(), verbatim arithmetic
+static void toneCoefficients(const int8_t gain[3], uint32_t rate, Biquad f[3]) {
+    const float FcLS = 500, FcPKEQ = 3000;
+    float FcHS = 6000;
+    if (rate < FcHS * 2 - 100) FcHS = rate / 2 - 100;
+    float K, norm, Q, Fc, V;
+
+    Fc = FcLS / (float)rate;
+    K = tanf((float)M_PI * Fc);
+    V = powf(10, fabs(gain[0]) / 20.0);
+    if (gain[0] >= 0) {
+        norm = 1 / (1 + sqrtf(2) * K + K * K);
+        f[0] = {(1 + sqrtf(2 * V) * K + V * K * K) * norm, 2 * (V * K * K - 1) * norm,
+                (1 - sqrtf(2 * V) * K + V * K * K) * norm, 2 * (K * K - 1) * norm, (1 - sqrtf(2) * K + K * K) * norm};
+    } else {
+        norm = 1 / (1 + sqrtf(2 * V) * K + V * K * K);
+        f[0] = {(1 + sqrtf(2) * K + K * K) * norm, 2 * (K * K - 1) * norm, (1 - sqrtf(2) * K + K * K) * norm,
+                2 * (V * K * K - 1) * norm, (1 - sqrtf(2 * V) * K + V * K * K) * norm};
+    }
+
+    Fc = FcPKEQ / (float)rate;
+    K = tanf((float)M_PI * Fc);
+    V = powf(10, fabs(gain[1]) / 20.0);
+    Q = 2.5;
+    if (gain[1] >= 0) {
+        norm = 1 / (1 + 1 / Q * K + K * K);
+        f[1] = {(1 + V / Q * K + K * K) * norm, 2 * (K * K - 1) * norm, (1 - V / Q * K + K * K) * norm,
+                2 * (K * K - 1) * norm, (1 - 1 / Q * K + K * K) * norm};
+    } else {
+        norm = 1 / (1 + V / Q * K + K * K);
+        f[1] = {(1 + 1 / Q * K + K * K) * norm, 2 * (K * K - 1) * norm, (1 - 1 / Q * K + K * K) * norm,
+                2 * (K * K - 1) * norm, (1 - V / Q * K + K * K) * norm};
+    }
+
+    Fc = FcHS / (float)rate;
+    K = tanf((float)M_PI * Fc);
+    V = powf(10, fabs(gain[2]) / 20.0);
+    if (gain[2] >= 0) {
+        norm = 1 / (1 + sqrtf(2) * K + K * K);
+        f[2] = {(V + sqrtf(2 * V) * K + K * K) * norm, 2 * (K * K - V) * norm, (V - sqrtf(2 * V) * K + K * K) * norm,
+                2 * (K * K - 1) * norm, (1 - sqrtf(2) * K + K * K) * norm};
+    } else {
+        norm = 1 / (V + sqrtf(2 * V) * K + K * K);
+        f[2] = {(1 + sqrtf(2) * K + K * K) * norm, 2 * (K * K - 1) * norm, (1 - sqrtf(2) * K + K * K) * norm,
+                2 * (K * K - V) * norm, (V - sqrtf(2 * V) * K + K * K) * norm};
+    }
+}
+
+// Audio::computeLimit(), curve 0
+static void volumeGain(double& left, double& right) {
+    double l = 1, r = 1;
+    if (BALANCE > 0) r -= (double)abs(BALANCE) / 16;
+    else if (BALANCE < 0) l -= (double)abs(BALANCE) / 16;
+    double v = (double)pow(VOLUME, 2) / pow(VOLUME_STEPS, 2);
+    left = l * v;
+    right = r * v;
+}
+
+static float levelCorrection() {
+    int db = std::max(TONE[0], std::max(TONE[1], TONE[2]));
+    return powf(10, (float)db / 20);
+}
+
+// ==================== BEFORE ====================
+
+// The per-sample code as it was in Audio.cpp
+struct Legacy {
+    Biquad filter[3];
+    float filterBuff[3][2][2][2] = {};
+    float corr = 1;
+    double limitLeft = 1, limitRight = 1;
+    LegacyResampler resampler;
+    uint8_t vuLeft = 0, vuRight = 0;
+    uint8_t sampleArray[2][4][8] = {};
+    uint8_t cnt0 = 0, cnt1 = 0, cnt2 = 0, cnt3 = 0, cnt4 = 0;
+    bool fVu = false;
+
+    void computeVUlevel(int16_t sample[2]) {
+        auto avg = [&](uint8_t* a) {
+            uint16_t av = 0;
+            for (int i = 0; i < 8; i++) av += a[i];
+            return av >> 3;
+        };
+        auto largest = [&](uint8_t* a) {
+            uint16_t m = 0;
+            for (int i = 0; i < 8; i++)
+                if (m < a[i]) m = a[i];
+            return m;
+        };
+        if (cnt0 == 64) { cnt0 = 0; cnt1++; }
+        if (cnt1 == 8) { cnt1 = 0; cnt2++; }
+        if (cnt2 == 8) { cnt2 = 0; cnt3++; }
+        if (cnt3 == 8) { cnt3 = 0; cnt4++; fVu = true; }
+        if (cnt4 == 8) cnt4 = 0;
+        if (!cnt0) {
+            sampleArray[0][0][cnt1] = abs(sample[0] >> 7);
+            sampleArray[1][0][cnt1] = abs(sample[1] >> 7);
+        }
+        if (!cnt1) {
+            sampleArray[0][1][cnt2] = largest(sampleArray[0][0]);
+            sampleArray[1][1][cnt2] = largest(sampleArray[1][0]);
+        }
+        if (!cnt2) {
+            sampleArray[0][2][cnt3] = largest(sampleArray[0][1]);
+            sampleArray[1][2][cnt3] = largest(sampleArray[1][1]);
+        }
+        if (!cnt3) {
+            sampleArray[0][3][cnt4] = avg(sampleArray[0][2]);
+            sampleArray[1][3][cnt4] = avg(sampleArray[1][2]);
+        }
+        if (fVu) {
+            fVu = false;
+            vuLeft = avg(sampleArray[0][3]);
+            vuRight = avg(sampleArray[1][3]);
+        }
+        cnt1++;
+    }
+
+    void correct(int16_t s[2]) {
+        if (corr > 1) {
+            s[0] /= corr;
+            s[1] /= corr;
+        }
+    }
+
+    // IIR_filterChain0/1/2 differ only in the stage index
+    void filterChain(uint8_t k, int16_t iir_in[2]) {
+        enum : uint8_t { z1 = 0, z2 = 1, in = 0, out = 1 };
+        float inSample[2], outSample[2];
+        int16_t iir_out[2];
+        for (uint8_t ch = 0; ch < 2; ch++) {
+            inSample[ch] = (float)iir_in[ch];
+            outSample[ch] = filter[k].a0 * inSample[ch] + filter[k].a1 * filterBuff[k][z1][in][ch] +
+                            filter[k].a2 * filterBuff[k][z2][in][ch] - filter[k].b1 * filterBuff[k][z1][out][ch] -
+                            filter[k].b2 * filterBuff[k][z2][out][ch];
+            filterBuff[k][z2][in][ch] = filterBuff[k][z1][in][ch];
+            filterBuff[k][z1][in][ch] = inSample[ch];
+            filterBuff[k][z2][out][ch] = filterBuff[k][z1][out][ch];
+            filterBuff[k][z1][out][ch] = outSample[ch];
+            iir_out[ch] = (int16_t)outSample[ch];
+        }
+        iir_in[0] = iir_out[0];
+        iir_in[1] = iir_out[1];
+    }
+
+    void mono(int16_t s[2]) {
+        int32_t xy = (s[1] + s[0]) / 2;
+        s[0] = s[1] = (int16_t)xy;
+    }
+
+    void gain(int16_t* s) {
+        s[0] *= limitLeft;
+        s[1] *= limitRight;
+    }
+
+    // The loop in playChunk()
+    void chunk(int16_t* s, size_t frames, bool filters, bool mono_) {
+        for (size_t n = 0; n < frames; n++, s += 2) {
+            computeVUlevel(s);
+            if (filters) {
+                correct(s);
+                filterChain(0, s);
+                filterChain(1, s);
+                filterChain(2, s);
+            }
+            if (mono_) mono(s);
+            gain(s);
+        }
+    }
+};
+
+// ==================== REFERENCE ====================
+
+// The same chain in double precision, no intermediate rounding
+static void referenceChain(const int16_t* in, size_t frames, const Biquad f[3], double pre, double gl, double gr,
+                           bool mono, std::vector<double>& out) {
+    double x[3][2][2] = {}, y[3][2][2] = {};
+    out.resize(frames * 2);
+    for (size_t n = 0; n < frames; n++) {
+        double v[2] = {in[2 * n] * pre, in[2 * n + 1] * pre};
+        for (int k = 0; k < 3; k++) {
+            for (int ch = 0; ch < 2; ch++) {
+                double o = f[k].a0 * v[ch] + f[k].a1 * x[k][ch][0] + f[k].a2 * x[k][ch][1] - f[k].b1 * y[k][ch][0] -
+                           f[k].b2 * y[k][ch][1];
+                x[k][ch][1] = x[k][ch][0];
+                x[k][ch][0] = v[ch];
+                y[k][ch][1] = y[k][ch][0];
+                y[k][ch][0] = o;
+                v[ch] = o;
+            }
+        }
+        if (mono) v[0] = v[1] = (v[0] + v[1]) / 2;
+        out[2 * n] = v[0] * gl;
+        out[2 * n + 1] = v[1] * gr;
+    }
+}
+
+struct Accuracy {
+    int maxError;
+    double snrDb;
+};
+
+static Accuracy compare(const std::vector<int16_t>& out, const std::vector<double>& ref) {
+    double signal = 0, noise = 0;
+    int maxError = 0;
+    for (size_t i = 0; i < ref.size(); i++) {
+        double e = out[i] - ref[i];
+        signal += ref[i] * ref[i];
+        noise += e * e;
+        maxError = std::max(maxError, (int)ceil(fabs(e) - 0.5));
+    }
+    return {maxError, 10 * log10(signal / std::max(noise, 1e-12))};
+}
+
+// ==================== TIMING ====================
+
+static std::vector<int16_t> g_input;
+static std::vector<int16_t> g_work(CHUNK * 2);
+static std::vector<int16_t> g_out48k(CHUNK * 2 * 2);
+static uint64_t g_sink;   // Keeps the compiler from dropping the work
+
+// Every sample of the chunk into g_sink
+static void sinkChunk(const int16_t* s, size_t samples) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < samples; i++) sum = sum * 31 + (uint16_t)s[i];
+    g_sink += sum;
+}
+
+static void makeInput() {
+    const size_t frames = (size_t)RATE * SECONDS;
+    g_input.resize(frames * 2);
+    uint32_t noise = 1;
+    for (size_t n = 0; n < frames; n++) {
+        double t = (double)n / RATE;
+        double base = 0.25 * sin(2 * M_PI * 110 * t) + 0.15 * sin(2 * M_PI * 1000 * t) + 0.05 * sin(2 * M_PI * 7000 * t);
+        for (int ch = 0; ch < 2; ch++) {
+            noise = noise * 1664525u + 1013904223u;
+            double v = base * (ch ? 0.9 : 1.0) + ((int32_t)(noise >> 16) - 32768) / 32768.0 * 0.01;
+            g_input[2 * n + ch] = (int16_t)lrint(v * 32767);
+        }
+    }
+}
+
+// ns per frame for `fn(chunk, frames)` over the whole input, best of `runs`
+template <typename Fn> static double timeChunks(int runs, Fn fn) {
+    const size_t frames = g_input.size() / 2;
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t at = 0; at + CHUNK <= frames; at += CHUNK) {
+            memcpy(g_work.data(), &g_input[2 * at], CHUNK * 4);
+            fn(g_work.data(), (size_t)CHUNK);
+            sinkChunk(g_work.data(), CHUNK * 2);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ns / (frames / CHUNK * CHUNK));
+    }
+    return best;
+}
+
+static void configure(AudioDSP& dsp, const Biquad f[3], bool filters, bool mono) {
+    double gl, gr;
+    volumeGain(gl, gr);
+    float corr = levelCorrection();
+    for (uint8_t k = 0; k < 3; k++) {
+        if (filters) dsp.setFilter(k, f[k].a0, f[k].a1, f[k].a2, f[k].b1, f[k].b2);
+        else dsp.setFilter(k, 1, 0, 0, 0, 0);
+    }
+    dsp.setPreGain(filters && corr > 1 ? 1 / corr : 1);
+    dsp.setGain(gl, gr);
+    dsp.setMono(mono);
+    dsp.setSampleRate(RATE);
+    dsp.reset();
+}
+
+static Legacy makeLegacy(const Biquad f[3]) {
+    Legacy legacy;
+    memcpy(legacy.filter, f, sizeof(legacy.filter));
+    legacy.corr = levelCorrection();
+    volumeGain(legacy.limitLeft, legacy.limitRight);
+    legacy.resampler.setSampleRate(RATE);
+    return legacy;
+}
+
+int main(int argc, char** argv) {
+    int runs = 20;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--runs N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    makeInput();
+    Biquad f[3];
+    toneCoefficients(TONE, RATE, f);
+
+    // ---- before, one stage per pass
+    Legacy lg = makeLegacy(f);
+    double copy = timeChunks(runs, [](int16_t*, size_t) {});
+    double bVu = timeChunks(runs, [&](int16_t* s, size_t n) {
+        for (size_t i = 0; i < n; i++) lg.computeVUlevel(s + 2 * i);
+        g_sink += lg.vuLeft + lg.vuRight;
+    });
+    double bTone = timeChunks(runs, [&](int16_t* s, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            lg.correct(s + 2 * i);
+            lg.filterChain(0, s + 2 * i);
+            lg.filterChain(1, s + 2 * i);
+            lg.filterChain(2, s + 2 * i);
+        }
+    });
+    double bMono = timeChunks(runs, [&](int16_t* s, size_t n) { for (size_t i = 0; i < n; i++) lg.mono(s + 2 * i); });
+    double bGain = timeChunks(runs, [&](int16_t* s, size_t n) { for (size_t i = 0; i < n; i++) lg.gain(s + 2 * i); });
+    double bResample = timeChunks(runs, [&](int16_t* s, size_t n) {
+        size_t frames = lg.resampler.process(s, n, g_out48k.data());
+        sinkChunk(g_out48k.data(), frames * 2);
+    });
+    double bChain = timeChunks(runs, [&](int16_t* s, size_t n) {
+        lg.chunk(s, n, true, true);
+        g_sink += lg.vuLeft + lg.vuRight;
+    });
+    double bTotal = timeChunks(runs, [&](int16_t* s, size_t n) {
+        lg.chunk(s, n, true, true);
+        size_t frames = lg.resampler.process(s, n, g_out48k.data());
+        sinkChunk(g_out48k.data(), frames * 2);
+        g_sink += lg.vuLeft + lg.vuRight;
+    });
+
+    // ---- after, configurations of the fused pass
+    static AudioDSP dsp;   // Holds the block buffers, keep it off the stack
+    auto process = [&](int16_t* s, size_t n) {
+        dsp.process(s, n);
+        g_sink += dsp.vuLeft() + dsp.vuRight();
+    };
+    configure(dsp, f, false, false);
+    double aBase = timeChunks(runs, process);
+    configure(dsp, f, false, true);
+    double aMono = timeChunks(runs, process);
+    configure(dsp, f, true, false);
+    double aTone = timeChunks(runs, process);
+    size_t out48k = 0;
+    double aResample = timeChunks(runs, [&](int16_t* s, size_t n) {
+        const int16_t* out = dsp.resample48k(s, n, g_out48k.data(), &out48k);
+        sinkChunk(out, out48k * 2);
+    });
+    configure(dsp, f, true, true);
+    double aChain = timeChunks(runs, process);
+    double aTotal = timeChunks(runs, [&](int16_t* s, size_t n) {
+        process(s, n);
+        const int16_t* out = dsp.resample48k(s, n, g_out48k.data(), &out48k);
+        sinkChunk(out, out48k * 2);
+    });
+
+    auto ns = [copy](double v) { return std::max(v - copy, 0.0); };
+    printf("\n=== Audio post-processing, %u Hz stereo, %u-frame chunks, ns per frame (L+R) ===\n", RATE, CHUNK);
+    printf("tone %+d/%+d/%+d dB, volume %u/%u, balance %d, best of %d runs\n\n", TONE[0], TONE[1], TONE[2], VOLUME,
+           VOLUME_STEPS, BALANCE, runs);
+    printf("%-22s %9s %9s %8s\n", "stage", "before", "after", "speedup");
+    auto row = [](const char* name, double before, double after) {
+        if (after < 0.05) printf("%-22s %9.2f %9s %8s\n", name, before, "<0.05", "-");
+        else printf("%-22s %9.2f %9.2f %7.1fx\n", name, before, after, before / after);
+    };
+    row("vu meter + gain", ns(bVu) + ns(bGain), ns(aBase));
+    row("tone (3 biquads)", ns(bTone), std::max(ns(aTone) - ns(aBase), 0.0));
+    row("mono mix", ns(bMono), std::max(ns(aMono) - ns(aBase), 0.0));
+    row("resample -> 48 kHz", ns(bResample), ns(aResample));
+    row("chunk, no resampling", ns(bChain), ns(aChain));
+    row("whole chunk", ns(bTotal), ns(aTotal));
+    printf("(before: vu %.2f, gain %.2f; after: the fused pass runs them together)\n", ns(bVu), ns(bGain));
+    printf("(whole chunk: the resampler tier dominates; kvn_bench_audio_resampler compares the tiers)\n");
+
+    // ---- accuracy, the full chain before resampling
+    const size_t frames = g_input.size() / 2;
+    double gl, gr;
+    volumeGain(gl, gr);
+    float corr = levelCorrection();
+    std::vector<double> ref;
+    referenceChain(g_input.data(), frames, f, 1 / corr, gl, gr, true, ref);
+
+    std::vector<int16_t> before(g_input), after(g_input);
+    Legacy check = makeLegacy(f);
+    check.chunk(before.data(), frames, true, true);
+    configure(dsp, f, true, true);
+    dsp.resetMeter();
+    for (size_t at = 0; at < frames; at += CHUNK) dsp.process(&after[2 * at], std::min((size_t)CHUNK, frames - at));
+
+    Accuracy a = compare(before, ref), b = compare(after, ref);
+    printf("\n%-22s %9s %9s\n", "vs double reference", "before", "after");
+    printf("%-22s %9d %9d\n", "max error (LSB)", a.maxError, b.maxError);
+    printf("%-22s %9.1f %9.1f\n", "SNR (dB)", a.snrDb, b.snrDb);
+    printf("%-22s %9u %9u\n", "vu left/right", check.vuLeft << 8 | check.vuRight, dsp.vuLeft() << 8 | dsp.vuRight());
+
+    return g_sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,585 @@
+/*
+ * audio_pipeline.cpp - Dropouts of the ESP32-audioI2S output chain under a
+ * jittery stream and a preempted decoder
+ *
+ * A real MP3 (the MP3 decoder and AudioDSP resampler, as on the device)
+ * is streamed through threads standing in for the FreeRTOS tasks, on a
+ * device clock running --scale times faster than real time:
+ *
+ *   network  delivers the file at its bitrate in 10 ms steps, after
+ *            --burst bytes on connect (Icecast burst-on-connect, 64 KiB by
+ *            default; 0 is a source that is never ahead, which no buffer
+ *            survives, since decoding starts with the first frame). During
+ *            a stall nothing arrives; afterwards the backlog comes in at 4x
+ *            the rate, the way TCP catches up.
+ *   decoder  Audio::playAudioData(): one frame per pass, 50 ms sleep when
+ *            the input holds less than one block. Each frame costs --load
+ *            of its duration, and at the scripted stalls the task loses
+ *            the CPU (display, SD card, higher priorities).
+ *   DMA      one 1024-frame buffer every 21.3 ms.
+ *
+ * Two output chains, the same stall script:
+ *
+ *   old   Audio::playChunk() before the pipeline: the decoder writes into
+ *         the 8 DMA buffers with a 10 ms timeout; when they are full,
+ *         performAudioTask() retries every 20 ms.
+ *   new   AudioPipeline (src/audio_pipeline): the decoder pushes into the
+ *         16-slot PCM ring and sleeps until the feeder wakes it; the
+ *         feeder, woken by each DMA buffer sent, fills exactly one slot.
+ *
+ * Counted at the DMA for both:
+ *   drops     silences between two pieces of audio: audible dropouts
+ *   silent    their total length
+ *   start     silence before the first audio, at the entry of the DMA
+ *             buffers (their own latency, the same for both, left out)
+ *   starved   decoder passes that found less than one block to decode
+ *   pcm       the audio that reached the DMA, silence removed, against a
+ *             straight decode of the file: nothing lost or doubled
+ * and for the new chain AudioPipeline's own counters: underruns (equals
+ * drops), lowest PCM ring fill and overruns of the input buffer.
+ *
+ * Then flush() racing push(): the push reads its input from a page with
+ * no access, so it faults inside the ring write, after its flush check.
+ * The fault handler is the other two tasks at that instant: flush() and
+ * one feeder slot. No audio from before the flush may be heard after it.
+ *
+ * The run exits with 1 if any chain loses or reorders audio, or old audio
+ * survives the flush.
+ */
+
+#include "audio_pipeline.h"
+#include "audio_dsp.h"
+#include "mp3_decoder/mp3_decoder.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define SLOT          PIPELINE_SLOT_FRAMES
+#define SLOT_MS       (SLOT * 1000.0 / 48000)
+#define DMA_SLOTS     8            // dma_desc_num
+#define MAX_BLOCK     1600         // InBuff.getMaxBlockSize() for mp3
+#define OUTBUFF_SIZE  (4096 * 2)   // m_outbuffSize, int16 samples
+#define NET_STEP_MS   10
+#define CATCH_UP      4            // Backlog rate after a stall, x the stream rate
+
+// ==================== DEVICE CLOCK ====================
+
+using Clock = std::chrono::steady_clock;
+
+static double            g_scale = 8;
+static Clock::time_point g_t0;
+
+static Clock::duration realTime(double deviceMs) {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(deviceMs / g_scale));
+}
+
+static double nowMs() {
+    return std::chrono::duration<double, std::milli>(Clock::now() - g_t0).count() * g_scale;
+}
+
+static void sleepUntilMs(double ms) { std::this_thread::sleep_until(g_t0 + realTime(ms)); }
+static void sleepMs(double ms) { std::this_thread::sleep_for(realTime(ms)); }
+
+// A task notification: give() counts, take() waits for one and clears them
+struct Notify {
+    std::mutex              m;
+    std::condition_variable cv;
+    uint32_t                count = 0;
+
+    void give() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            count++;
+        }
+        cv.notify_one();
+    }
+    uint32_t take(double ms) {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait_for(lock, realTime(ms), [this] { return count > 0; });
+        uint32_t c = count;
+        count = 0;
+        return c;
+    }
+};
+
+// ==================== STALL SCRIPT ====================
+
+struct Window {
+    double start, end;             // Device ms
+};
+
+struct Level {
+    const char* name;
+    double      netRate, netMin, netMax;   // Network stalls per second, their length in ms
+    double      cpuRate, cpuMin, cpuMax;   // Decoder preemptions per second, their length
+};
+
+static const Level LEVELS[] = {
+    {"calm", 0,    0,   0,   0,   0,   0},
+    {"wifi", 0.3,  50,  300, 0,   0,   0},
+    {"busy", 0,    0,   0,   0.5, 80,  250},
+    {"both", 0.3,  50,  300, 0.5, 80,  250},
+    {"roam", 0.2,  2000, 6000, 0.5, 80,  250},  // Some longer than the burst lasts
+};
+
+// At most one window starting in each second, never overlapping
+static std::vector<Window> script(std::mt19937& rng, double rate, double lo, double hi, double durationMs) {
+    std::vector<Window> w;
+    std::uniform_real_distribution<double> u(0, 1);
+    double free = 0;
+    for (double s = 0; s < durationMs && rate > 0; s += 1000) {
+        if (u(rng) >= rate) continue;
+        double start = s + u(rng) * 1000;
+        if (start < free) continue;
+        double len = lo + u(rng) * (hi - lo);
+        w.push_back({start, start + len});
+        free = start + len;
+    }
+    return w;
+}
+
+// ==================== DECODER ====================
+
+// MP3 frames the way Audio::sendBytes() cuts them, resampled to 48 kHz stereo
+struct Decoder {
+    AudioDSP dsp;
+    int16_t  out[OUTBUFF_SIZE];
+    int16_t  out48[OUTBUFF_SIZE * 2];
+    uint32_t rate = 0;
+
+    enum Result { FRAME, NEED_DATA, END };
+
+    // One frame from data[*read .. written). `done`: nothing more will arrive.
+    Result next(const uint8_t* data, size_t* read, size_t written, bool done, int16_t** pcm, uint32_t* frames) {
+        while (true) {
+            size_t avail = written - *read;
+            if (avail == 0 && done) return END;
+            if (avail < MAX_BLOCK && !done) return NEED_DATA;
+            int32_t sync = MP3FindSyncWord((uint8_t*)data + *read, (int32_t)avail);
+            if (sync < 0) {
+                *read = written;
+                continue;
+            }
+            *read += sync;
+            avail -= sync;
+            int32_t block = (int32_t)(avail < MAX_BLOCK ? avail : MAX_BLOCK);
+            int32_t left = block;
+            int32_t ret = MP3Decode((uint8_t*)data + *read, &left, out, 0);
+            *read += left < block ? block - left : 1;
+            if (ret != 0) continue;
+
+            uint8_t  ch = MP3GetChannels();
+            uint32_t n = MP3GetOutputSamps() / ch;
+            if (ch == 1)
+                for (int i = (int)n - 1; i >= 0; i--) out[2 * i] = out[2 * i + 1] = out[i];
+            if ((uint32_t)MP3GetSampRate() != rate) {
+                rate = MP3GetSampRate();
+                dsp.setSampleRate(rate);
+            }
+            size_t n48 = 0;
+            *pcm = dsp.resample48k(out, n, out48, &n48);
+            *frames = (uint32_t)n48;
+            return FRAME;
+        }
+    }
+};
+
+static bool load(const std::string& path, std::vector<uint8_t>& data) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    data.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(data.data(), 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+static bool reference(const std::vector<uint8_t>& file, std::vector<int16_t>& pcm) {
+    if (!MP3Decoder_AllocateBuffers()) return false;
+    Decoder* dec = new Decoder;
+    size_t read = 0;
+    int16_t* p;
+    uint32_t n;
+    while (dec->next(file.data(), &read, file.size(), true, &p, &n) == Decoder::FRAME) pcm.insert(pcm.end(), p, p + 2 * n);
+    delete dec;
+    MP3Decoder_FreeBuffers();
+    return !pcm.empty();
+}
+
+// ==================== ONE RUN ====================
+
+struct Options {
+    double   load = 0.15;          // Decode time / audio time, ESP32-S3 mp3 at 240 MHz
+    size_t   burst = 65536;
+    size_t   inBuff = UINT16_MAX * 10;  // AudioBuffer m_buffSizePSRAM
+    unsigned seed = 1;
+};
+
+// The 8 DMA buffers as the old chain saw them: frames queue up, the DMA
+// takes one buffer's worth per period, a short buffer is padded with silence
+struct DmaQueue {
+    std::mutex              m;
+    std::condition_variable space;
+    std::vector<int16_t>    pcm;   // Interleaved, front = next to play
+
+    // i2s_channel_write(): as much as fits, waiting up to timeoutMs for room
+    uint32_t write(const int16_t* in, uint32_t frames, double timeoutMs) {
+        std::unique_lock<std::mutex> lock(m);
+        auto deadline = Clock::now() + realTime(timeoutMs);
+        uint32_t done = 0;
+        while (done < frames) {
+            uint32_t room = DMA_SLOTS * SLOT - (uint32_t)pcm.size() / 2;
+            uint32_t n = frames - done < room ? frames - done : room;
+            pcm.insert(pcm.end(), in + 2 * done, in + 2 * (done + n));
+            done += n;
+            if (done == frames) break;
+            if (space.wait_until(lock, deadline) == std::cv_status::timeout) break;
+        }
+        return done;
+    }
+    uint32_t send(std::vector<int16_t>& heard) {
+        std::lock_guard<std::mutex> lock(m);
+        uint32_t n = (uint32_t)pcm.size() / 2 < SLOT ? (uint32_t)pcm.size() / 2 : SLOT;
+        heard.insert(heard.end(), pcm.begin(), pcm.begin() + 2 * n);
+        pcm.erase(pcm.begin(), pcm.begin() + 2 * n);
+        space.notify_one();
+        return n;
+    }
+    bool empty() {
+        std::lock_guard<std::mutex> lock(m);
+        return pcm.empty();
+    }
+};
+
+struct Result {
+    uint32_t drops, silentFrames, startFrames, starved;
+    AudioPipelineStats stats;      // New chain only
+    bool     pcmOk;
+};
+
+static Result run(bool pipelined, const std::vector<uint8_t>& file, const std::vector<int16_t>& ref, double durationMs,
+                  const std::vector<Window>& netStalls, const std::vector<Window>& cpuStalls, const Options& opt) {
+    // InBuff: one linear copy of the file, so a frame is never split; the counters are the ring
+    std::atomic<size_t>   written{0}, readPos{0};
+    std::atomic<bool>     allReceived{false}, decoderDone{false}, stop{false};
+    std::atomic<uint32_t> starved{0};
+
+    std::vector<int16_t>  ring(PIPELINE_RING_SLOTS * SLOT * 2);
+    AudioPipeline         pipe;    // The old chain uses only its counters
+    DmaQueue              dma;
+    Notify                feedWake, decodeWake;
+    std::vector<uint32_t> slotAudio;   // Audio frames in each DMA buffer, the rest is silence
+    std::vector<int16_t>  heard;
+    pipe.begin(ring.data(), (uint32_t)ring.size() / 2);
+
+    MP3Decoder_AllocateBuffers();
+    g_t0 = Clock::now();
+
+    std::thread network([&] {
+        const double rate = file.size() / durationMs;     // Bytes per ms
+        size_t sent = 0;
+        bool   full = false;
+        size_t stall = 0;
+        for (double t = 0; sent < file.size(); t += NET_STEP_MS) {
+            sleepUntilMs(t);
+            while (stall < netStalls.size() && netStalls[stall].end <= t) stall++;
+            if (stall < netStalls.size() && netStalls[stall].start <= t) continue;
+            size_t due = opt.burst + (size_t)(rate * t);
+            if (due > file.size()) due = file.size();
+            size_t want = due > sent ? due - sent : 0;
+            size_t step = (size_t)(rate * NET_STEP_MS * CATCH_UP);
+            if (want > step && sent >= opt.burst) want = step;
+            size_t room = opt.inBuff - (sent - readPos.load(std::memory_order_acquire));
+            if (want && room == 0) {
+                if (!full) pipe.countOverrun();
+                full = true;
+            }
+            else full = false;
+            if (want > room) want = room;
+            sent += want;
+            written.store(sent, std::memory_order_release);
+        }
+        allReceived.store(true, std::memory_order_release);
+    });
+
+    std::thread decoder([&] {
+        Decoder* dec = new Decoder;
+        int16_t* pend = nullptr;
+        uint32_t pendFrames = 0;
+        size_t   cpu = 0;
+        bool     first = true;
+
+        // The chunk in hand to the output: true when it is gone
+        auto play = [&]() {
+            if (pipelined) {
+                uint32_t n = pipe.push(pend, pendFrames);
+                pend += 2 * n;
+                pendFrames -= n;
+            }
+            else {
+                uint32_t n = dma.write(pend, pendFrames, 10);
+                pend += 2 * n;
+                pendFrames -= n;
+            }
+            return pendFrames == 0;
+        };
+
+        while (!stop.load()) {
+            if (pipelined) decodeWake.take(pendFrames ? 20 : 1);
+            else {
+                sleepMs(1);
+                while (pendFrames && !stop.load()) { // I2S buffer full
+                    sleepMs(20);
+                    play();
+                }
+            }
+            while (cpu < cpuStalls.size() && cpuStalls[cpu].end <= nowMs()) cpu++;
+            if (cpu < cpuStalls.size() && cpuStalls[cpu].start <= nowMs()) sleepUntilMs(cpuStalls[cpu++].end);
+
+            if (pendFrames && !play()) continue;
+
+            size_t   read = readPos.load(std::memory_order_relaxed);
+            bool     done = allReceived.load(std::memory_order_acquire);
+            uint32_t frames = 0;
+            Decoder::Result r = dec->next(file.data(), &read, written.load(std::memory_order_acquire), done, &pend, &frames);
+            readPos.store(read, std::memory_order_release);
+            if (r == Decoder::END) {
+                pipe.setActive(false);
+                decoderDone.store(true);
+                break;
+            }
+            if (r == Decoder::NEED_DATA) {
+                starved++;
+                pipe.countInputStarved();
+                sleepMs(50);
+                continue;
+            }
+            if (first) pipe.setActive(true);
+            first = false;
+            sleepMs(frames * 1000.0 / 48000 * opt.load);
+            pendFrames = frames;
+            play();
+        }
+        delete dec;
+    });
+
+    std::thread feeder;
+    if (pipelined) {
+        feeder = std::thread([&] {
+            std::vector<int16_t> slot(SLOT * 2);
+            while (!stop.load()) {
+                feedWake.take(100);
+                while (pipe.due()) {
+                    uint32_t n = pipe.fillSlot(slot.data());
+                    heard.insert(heard.end(), slot.begin(), slot.begin() + 2 * n);
+                    slotAudio.push_back(n);
+                }
+                if (pipe.wantsData()) decodeWake.give();
+            }
+        });
+    }
+
+    // The DMA, until everything decoded has gone out
+    for (uint32_t k = 1;; k++) {
+        sleepUntilMs(k * SLOT_MS);
+        if (pipelined) {
+            pipe.dmaSent();
+            feedWake.give();
+            AudioPipelineStats st;
+            pipe.getStats(&st);
+            if (decoderDone.load() && st.pcmFill == 0 && pipe.due() == 0) break;
+        }
+        else {
+            slotAudio.push_back(dma.send(heard));
+            if (decoderDone.load() && dma.empty()) break;
+        }
+        if (k * SLOT_MS > 3 * durationMs + 10000) break; // Stuck
+    }
+    stop.store(true);
+    feedWake.give();
+    decodeWake.give();
+    network.join();
+    decoder.join();
+    if (feeder.joinable()) feeder.join();
+    MP3Decoder_FreeBuffers();
+
+    Result r = {};
+    bool started = false;
+    uint32_t silence = 0;
+    for (uint32_t n : slotAudio) {
+        if (n) {
+            if (!started) r.startFrames = silence;
+            else if (silence) {
+                r.drops++;
+                r.silentFrames += silence;
+            }
+            started = true;
+            silence = 0;
+        }
+        silence += SLOT - n;
+    }
+    r.starved = starved.load();
+    pipe.getStats(&r.stats);
+    r.pcmOk = heard == ref;
+    return r;
+}
+
+// ==================== FLUSH RACE ====================
+
+#define OLD_SAMPLE  1111
+#define NEW_SAMPLE  2222
+
+static AudioPipeline* g_racePipe;
+static int16_t*       g_raceSlot;
+static uint8_t*       g_racePage;
+static size_t         g_racePageSize;
+static uint32_t       g_raceHeard;     // Audio frames of the slot inside the push
+static bool           g_raceFaulted;
+
+// The decode task is inside push(): stop/seek and the feeder run now
+static void onRaceFault(int sig, siginfo_t* info, void* ctx) {
+    (void)ctx;
+    uint8_t* at = (uint8_t*)info->si_addr;
+    if (at < g_racePage || at >= g_racePage + g_racePageSize) { // A real fault
+        signal(sig, SIG_DFL);
+        return;
+    }
+    mprotect(g_racePage, g_racePageSize, PROT_READ);
+    g_raceFaulted = true;
+    g_racePipe->flush();
+    g_racePipe->dmaSent();
+    g_raceHeard += g_racePipe->fillSlot(g_raceSlot);
+}
+
+// Frames of `value` among the first `frames` of the slot
+static uint32_t count(const std::vector<int16_t>& slot, uint32_t frames, int16_t value) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < frames; i++) n += slot[2 * i] == value && slot[2 * i + 1] == value;
+    return n;
+}
+
+// Old audio heard after the flush, and new audio heard of what was pushed
+static void flushRace(uint32_t* stale, uint32_t* fresh, uint32_t* pushed) {
+    std::vector<int16_t> ring(PIPELINE_RING_SLOTS * SLOT * 2);
+    std::vector<int16_t> slot(SLOT * 2);
+    std::vector<int16_t> pcm(PIPELINE_START_SLOTS * SLOT * 2, OLD_SAMPLE);
+    AudioPipeline        pipe;
+    pipe.begin(ring.data(), (uint32_t)ring.size() / 2);
+    pipe.setActive(true);
+    pipe.push(pcm.data(), SLOT); // Queued before the flush, below the start level
+
+    const size_t page = sysconf(_SC_PAGESIZE);
+    g_racePageSize = (SLOT * 2 * sizeof(int16_t) + page - 1) / page * page;
+    g_racePage = (uint8_t*)mmap(nullptr, g_racePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    std::fill((int16_t*)g_racePage, (int16_t*)g_racePage + SLOT * 2, (int16_t)OLD_SAMPLE);
+    mprotect(g_racePage, g_racePageSize, PROT_NONE);
+    g_racePipe = &pipe;
+    g_raceSlot = slot.data();
+    g_raceHeard = 0;
+    g_raceFaulted = false;
+
+    struct sigaction sa = {}, prev;
+    sa.sa_sigaction = onRaceFault;
+    sa.sa_flags = SA_SIGINFO;
+    sigaction(SIGSEGV, &sa, &prev);
+    pipe.push((int16_t*)g_racePage, SLOT);
+    sigaction(SIGSEGV, &prev, nullptr);
+    munmap(g_racePage, g_racePageSize);
+    g_racePage = nullptr;
+
+    // New audio up to the start level, then play the ring out
+    std::fill(pcm.begin(), pcm.end(), (int16_t)NEW_SAMPLE);
+    *stale = g_raceHeard;
+    *fresh = 0;
+    *pushed = 0;
+    for (uint32_t i = 0; i < 2 * PIPELINE_RING_SLOTS; i++) {
+        if (i == 1) *pushed = pipe.push(pcm.data(), PIPELINE_START_SLOTS * SLOT);
+        pipe.dmaSent();
+        uint32_t n = pipe.fillSlot(slot.data());
+        *stale += count(slot, n, OLD_SAMPLE);
+        *fresh += count(slot, n, NEW_SAMPLE);
+    }
+}
+
+// ==================== MAIN ====================
+
+static void usage(const char* argv0) {
+    printf("usage: %s [--file F.mp3] [--scale X] [--load F] [--burst BYTES] [--inbuff BYTES] [--seed N] [--level NAME]\n",
+           argv0);
+}
+
+int main(int argc, char** argv) {
+    std::string path = std::string(KVN_AUDIO_TESTFILES) + "/Olsen-Banden.mp3";
+    std::string only;
+    Options     opt;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--file") && i + 1 < argc) path = argv[++i];
+        else if (!strcmp(argv[i], "--scale") && i + 1 < argc) g_scale = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--load") && i + 1 < argc) opt.load = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--burst") && i + 1 < argc) opt.burst = strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--inbuff") && i + 1 < argc) opt.inBuff = strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) opt.seed = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--level") && i + 1 < argc) only = argv[++i];
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (g_scale <= 0 || opt.inBuff < MAX_BLOCK) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> file;
+    std::vector<int16_t> ref;
+    if (!load(path, file) || !reference(file, ref)) {
+        fprintf(stderr, "cannot decode %s\n", path.c_str());
+        return 2;
+    }
+    const double durationMs = ref.size() / 2 * 1000.0 / 48000;
+
+    printf("\n=== audioI2S output chain, %s, %.1f s, clock x%.0f, decode load %.0f%%, burst %zu ===\n",
+           path.substr(path.find_last_of('/') + 1).c_str(), durationMs / 1000, g_scale, opt.load * 100, opt.burst);
+    printf("level  net stalls  cpu stalls  chain  drops  silent ms  start ms  starved  underruns  lowest ms  overruns  pcm\n");
+
+    bool ok = true;
+    for (const Level& lv : LEVELS) {
+        if (!only.empty() && only != lv.name) continue;
+        std::mt19937 rng(opt.seed);
+        std::vector<Window> net = script(rng, lv.netRate, lv.netMin, lv.netMax, durationMs);
+        std::vector<Window> cpu = script(rng, lv.cpuRate, lv.cpuMin, lv.cpuMax, durationMs);
+        for (int pipelined = 0; pipelined < 2; pipelined++) {
+            Result r = run(pipelined, file, ref, durationMs, net, cpu, opt);
+            ok &= r.pcmOk;
+            printf("%-5s  %10zu  %10zu  %-5s  %5u  %9.0f  %8.0f  %7u", lv.name, net.size(), cpu.size(),
+                   pipelined ? "new" : "old", r.drops, r.silentFrames * 1000.0 / 48000, r.startFrames * 1000.0 / 48000,
+                   r.starved);
+            if (pipelined)
+                printf("  %9u  %9.0f  %8u", r.stats.underruns, r.stats.pcmLowest * 1000.0 / 48000, r.stats.overruns);
+            else
+                printf("  %9s  %9s  %8u", "-", "-", r.stats.overruns);
+            printf("  %s\n", r.pcmOk ? "ok" : "LOST");
+        }
+    }
+    uint32_t stale, fresh, pushed;
+    flushRace(&stale, &fresh, &pushed);
+    bool flushed = g_raceFaulted && stale == 0 && fresh == pushed && pushed > 0;
+    printf("\nflush during a push: %u frames of old audio heard after it, %u of %u new  %s\n", stale, fresh, pushed,
+           flushed ? "ok" : "STALE");
+    ok &= flushed;
+
+    printf("\n%s\n", ok ? "no audio lost or reordered, none kept past a flush" : "AUDIO LOST, REORDERED OR STALE");
+    return ok ? 0 : 1;
+}
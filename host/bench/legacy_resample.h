@@ -0,0 +1,43 @@
+/*
+ * legacy_resample.h - Audio::resampleTo48kStereo() as it was before AudioDSP
+ *
+ * Linear interpolation in float inside each chunk, with the fractional
+ * frame count carried as a float error. Kept for the before/after
+ * benchmarks; the std::vector allocated per call is part of the cost.
+ */
+
+#ifndef LEGACY_RESAMPLE_H
+#define LEGACY_RESAMPLE_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+struct LegacyResampler {
+    float resampleError = 0;
+    float resampleRatio = 1;
+
+    void setSampleRate(uint32_t rate) { resampleRatio = 48000.0f / (float)rate; }
+
+    size_t process(const int16_t* input, size_t inputFrames, int16_t* samplesBuff48K) {
+        float exactOutputFrames = inputFrames * resampleRatio;
+        size_t outputFrames = static_cast<size_t>(std::floor(exactOutputFrames + resampleError));
+        resampleError += exactOutputFrames - outputFrames;
+
+        std::vector<int16_t> output(outputFrames * 2);
+
+        for (size_t i = 0; i < outputFrames; ++i) {
+            float inFramePos = i / resampleRatio;
+            size_t idx = static_cast<size_t>(inFramePos);
+            float frac = inFramePos - idx;
+            size_t i1 = idx * 2;
+            size_t i2 = (idx + 1 < inputFrames) ? (idx + 1) * 2 : i1;
+            samplesBuff48K[i * 2] = static_cast<int16_t>(input[i1] * (1.0f - frac) + input[i2] * frac);
+            samplesBuff48K[i * 2 + 1] = static_cast<int16_t>(input[i1 + 1] * (1.0f - frac) + input[i2 + 1] * frac);
+        }
+        return outputFrames;
+    }
+};
+
+#endif // LEGACY_RESAMPLE_H
@@ -0,0 +1,268 @@
+/*
+ * Arduino.cpp - Time, pins, sleep and UARTs on the active device
+ *
+ * Outside a device (World::onHost()), time is the host's monotonic clock
+ * and Serial is stdout, so tests and benchmarks can time library code.
+ * There are no pins there: inputs read 0 and outputs go nowhere.
+ */
+
+#include <Arduino.h>
+#include "kvn_sim.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using kvn_sim::World;
+using kvn_sim::Device;
+
+static Device& dev() {
+    return World::active();
+}
+
+// ==================== TIME ====================
+
+unsigned long millis() {
+    if (World::onHost()) return (unsigned long)(uint32_t)(kvn_sim::hostMicros() / 1000);
+    Device& d = dev();
+    d.spend(d.cost().clockReadUs);
+    return (unsigned long)(uint32_t)(d.sinceBoot() / 1000);
+}
+
+unsigned long micros() {
+    if (World::onHost()) return (unsigned long)(uint32_t)kvn_sim::hostMicros();
+    Device& d = dev();
+    d.spend(d.cost().clockReadUs);
+    return (unsigned long)(uint32_t)d.sinceBoot();
+}
+
+void delay(uint32_t ms) {
+    if (World::onHost()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        return;
+    }
+    dev().advance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (World::onHost()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return;
+    }
+    dev().advance(us);
+}
+
+void yield() {
+}
+
+int kvn_gettimeofday(struct timeval* tv, void* tz) {
+    (void)tz;
+    if (tv == nullptr) return 0;
+    uint64_t now = SIM_EPOCH_US + dev().now();
+    tv->tv_sec = (time_t)(now / 1000000);
+    tv->tv_usec = (suseconds_t)(now % 1000000);
+    return 0;
+}
+
+// Every device shares the simulated clock: there is nothing to sync
+void configTime(long gmtOffset, int daylightOffset, const char* server1, const char* server2,
+                const char* server3) {
+    (void)gmtOffset;
+    (void)daylightOffset;
+    (void)server1;
+    (void)server2;
+    (void)server3;
+}
+
+// ==================== PINS ====================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (!World::onHost()) dev().pinMode(pin, mode);
+}
+
+int digitalRead(uint8_t pin) {
+    return World::onHost() ? LOW : dev().digitalIn(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (!World::onHost()) dev().digitalWrite(pin, level);
+}
+
+uint16_t analogRead(uint8_t pin) {
+    return World::onHost() ? 0 : dev().analogIn(pin);
+}
+
+void analogWrite(uint8_t pin, int value) {
+    if (!World::onHost()) dev().analogWrite(pin, value);
+}
+
+void analogReadResolution(uint8_t bits) {
+    (void)bits;   // Models return 12-bit counts
+}
+
+void analogSetAttenuation(adc_attenuation_t attenuation) {
+    (void)attenuation;
+}
+
+// ==================== MATH ====================
+
+// Outside any World: a fixed-seed xorshift, so host runs repeat
+static uint32_t hostRandom() {
+    static uint32_t x = 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+long random(long max) {
+    if (max <= 0) return 0;
+    return (World::current() ? World::current()->random() : hostRandom()) % max;
+}
+
+long random(long min, long max) {
+    if (min >= max) return min;
+    return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+    (void)seed;   // The World's seed keeps runs reproducible
+}
+
+uint32_t esp_random() {
+    return World::current() ? World::current()->random() : hostRandom();
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    if (inMax == inMin) return outMin;
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ==================== CHIP ====================
+
+EspClass ESP;
+
+// On the host, less whatever heapMeter has counted (tests/example.cpp)
+uint32_t EspClass::getFreeHeap() {
+    if (World::onHost()) return 200 * 1024 - (uint32_t)std::min<size_t>(kvn_sim::heapMeter.inUse, 200 * 1024);
+    return 200 * 1024;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    if (World::onHost()) return 200 * 1024 - (uint32_t)std::min<size_t>(kvn_sim::heapMeter.peak, 200 * 1024);
+    return 180 * 1024;
+}
+
+uint64_t EspClass::getEfuseMac() {
+    // Espressif OUI, device index in the low byte
+    return 0x0000A4CF12000000ULL | dev().index();
+}
+
+uint32_t EspClass::getCycleCount() {
+    if (World::onHost()) {
+#if defined(__x86_64__) || defined(__i386__)
+        return (uint32_t)__rdtsc();
+#else
+        return (uint32_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+    // A 160 MHz core
+    Device& d = dev();
+    d.spend(d.cost().clockReadUs);
+    return (uint32_t)(d.sinceBoot() * 160);
+}
+
+void EspClass::restart() {
+    throw kvn_sim::Restart();
+}
+
+// ==================== SLEEP ====================
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+    switch (dev().wakeCause()) {
+        case kvn_sim::WAKE_TIMER: return ESP_SLEEP_WAKEUP_TIMER;
+        case kvn_sim::WAKE_GPIO:  return ESP_SLEEP_WAKEUP_GPIO;
+        default:                  return ESP_SLEEP_WAKEUP_UNDEFINED;
+    }
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs) {
+    dev().armTimerWake(timeUs);
+    return ESP_OK;
+}
+
+esp_err_t esp_deep_sleep_enable_gpio_wakeup(uint64_t gpioMask, esp_deepsleep_gpio_wake_up_mode_t mode) {
+    dev().armGpioWake(gpioMask, mode == ESP_GPIO_WAKEUP_GPIO_HIGH ? HIGH : LOW);
+    return ESP_OK;
+}
+
+void esp_deep_sleep_start() {
+    throw kvn_sim::DeepSleep();
+}
+
+// ==================== UART ====================
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+
+int HardwareSerial::available() {
+    if (World::onHost()) {
+        std::lock_guard<std::mutex> guard(_rxLock);
+        return (int)_rx.size();
+    }
+    return dev().uartAvailable(_port);
+}
+
+int HardwareSerial::read() {
+    if (World::onHost()) {
+        std::lock_guard<std::mutex> guard(_rxLock);
+        if (_rx.empty()) return -1;
+        uint8_t c = _rx.front();
+        _rx.pop_front();
+        return c;
+    }
+    return dev().uartRead(_port);
+}
+
+int HardwareSerial::peek() {
+    if (World::onHost()) {
+        std::lock_guard<std::mutex> guard(_rxLock);
+        return _rx.empty() ? -1 : _rx.front();
+    }
+    return dev().uartPeek(_port);
+}
+
+void HardwareSerial::onReceive(OnReceiveCb function, bool onlyOnTimeout) {
+    (void)onlyOnTimeout;
+    std::lock_guard<std::mutex> guard(_rxLock);
+    _onReceive = function;
+}
+
+void HardwareSerial::receive(const uint8_t* data, size_t length) {
+    OnReceiveCb cb;
+    {
+        std::lock_guard<std::mutex> guard(_rxLock);
+        _rx.insert(_rx.end(), data, data + length);
+        cb = _onReceive;
+    }
+    if (cb) cb();
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (World::onHost()) return _port == 0 ? fwrite(buffer, 1, size, stdout) : size;
+    dev().uartWrite(_port, buffer, size);
+    return size;
+}
+
+size_t Stream::readBytes(uint8_t* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) {
+        int c = read();
+        if (c < 0) break;
+        buffer[n++] = (uint8_t)c;
+    }
+    return n;
+}
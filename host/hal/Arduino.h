@@ -0,0 +1,151 @@
+/*
+ * Arduino.h - Host stand-in for the Arduino-ESP32 core
+ *
+ * Only what the KVN sketches and libraries use. Time, pins and sleep go
+ * to the active simulated device (sim/kvn_sim.h), so the firmware sources
+ * compile unchanged.
+ */
+
+#ifndef KVN_HAL_ARDUINO_H
+#define KVN_HAL_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+
+#include "WString.h"
+#include "Print.h"
+#include "HardwareSerial.h"
+#include "esp_sleep.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define PULLUP         0x04
+#define INPUT_PULLUP   0x05
+#define PULLDOWN       0x08
+#define INPUT_PULLDOWN 0x09
+
+#define PI 3.1415926535897932384626433832795
+
+#define F(s) (s)
+#define PROGMEM
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#ifndef __unused
+  #define __unused __attribute__((unused))   // newlib <sys/cdefs.h>
+#endif
+
+#define _min(a, b) ((a) < (b) ? (a) : (b))
+#define _max(a, b) ((a) > (b) ? (a) : (b))
+
+typedef enum {
+    ADC_0db,
+    ADC_2_5db,
+    ADC_6db,
+    ADC_11db
+} adc_attenuation_t;
+
+// ==================== TIME ====================
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// System time keeps running through deep sleep, as with the RTC timer
+int kvn_gettimeofday(struct timeval* tv, void* tz);
+#define gettimeofday kvn_gettimeofday
+void configTime(long gmtOffset, int daylightOffset, const char* server1,
+                const char* server2 = nullptr, const char* server3 = nullptr);
+
+// ==================== PINS ====================
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+uint16_t analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void analogReadResolution(uint8_t bits);
+void analogSetAttenuation(adc_attenuation_t attenuation);
+
+// ==================== MATH ====================
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+uint32_t esp_random();
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+#define constrain(x, lo, hi) ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+// ==================== STRINGS ====================
+
+// newlib has it; glibc only from 2.38
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// ==================== LOG ====================
+
+// esp32-hal-log.h levels. Messages at or below kvn_log_level go to stderr.
+enum { KVN_LOG_NONE, KVN_LOG_ERROR, KVN_LOG_WARN, KVN_LOG_INFO, KVN_LOG_DEBUG };
+inline int kvn_log_level = KVN_LOG_ERROR;
+
+#define kvn_log(level, tag, fmt, ...) \
+    do { if (kvn_log_level >= (level)) fprintf(stderr, "[" tag "] %s(): " fmt "\n", __func__, ##__VA_ARGS__); } while (0)
+#define log_e(fmt, ...) kvn_log(KVN_LOG_ERROR, "E", fmt, ##__VA_ARGS__)
+#define log_w(fmt, ...) kvn_log(KVN_LOG_WARN, "W", fmt, ##__VA_ARGS__)
+#define log_i(fmt, ...) kvn_log(KVN_LOG_INFO, "I", fmt, ##__VA_ARGS__)
+#define log_d(fmt, ...) kvn_log(KVN_LOG_DEBUG, "D", fmt, ##__VA_ARGS__)
+
+// ==================== MEMORY ====================
+
+// Boards with PSRAM; it is the same heap (esp_heap_caps.h)
+inline bool psramFound() { return true; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+inline void* ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void* ps_realloc(void* ptr, size_t size) { return realloc(ptr, size); }
+
+// ==================== CHIP ====================
+
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getHeapSize() { return 320 * 1024; }
+    const char* getChipModel() { return "KVN host"; }
+    uint64_t getEfuseMac();           // Unique per simulated device
+    uint32_t getCycleCount();         // Host: the CPU's timestamp counter
+    [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+#endif // KVN_HAL_ARDUINO_H
@@ -0,0 +1,54 @@
+/*
+ * ESP_I2S.h - Host stand-in for the Arduino-ESP32 I2S driver
+ *
+ * A silent microphone: readBytes() takes as long as the DMA would to
+ * fill the buffer at the configured rate, then returns zeros. Tests set
+ * kvnFailBegin to have begin() fail, as with no microphone wired.
+ */
+
+#ifndef KVN_HAL_ESP_I2S_H
+#define KVN_HAL_ESP_I2S_H
+
+#include <Arduino.h>
+
+typedef enum { I2S_MODE_STD, I2S_MODE_TDM, I2S_MODE_PDM_TX, I2S_MODE_PDM_RX } i2s_mode_t;
+typedef enum {
+    I2S_DATA_BIT_WIDTH_8BIT = 8,
+    I2S_DATA_BIT_WIDTH_16BIT = 16,
+    I2S_DATA_BIT_WIDTH_24BIT = 24,
+    I2S_DATA_BIT_WIDTH_32BIT = 32
+} i2s_data_bit_width_t;
+typedef enum { I2S_SLOT_MODE_MONO = 1, I2S_SLOT_MODE_STEREO = 2 } i2s_slot_mode_t;
+typedef enum { I2S_STD_SLOT_LEFT = 1, I2S_STD_SLOT_RIGHT = 2, I2S_STD_SLOT_BOTH = 3 } i2s_std_slot_mask_t;
+
+class I2SClass {
+public:
+    I2SClass() : _bytesPerSecond(0) {}
+
+    // Host only: begin() fails while set
+    static inline bool kvnFailBegin = false;
+
+    void setPins(int8_t bclk, int8_t ws, int8_t dout, int8_t din = -1, int8_t mclk = -1) {
+        (void)bclk; (void)ws; (void)dout; (void)din; (void)mclk;
+    }
+    bool begin(i2s_mode_t mode, uint32_t rate, i2s_data_bit_width_t bits, i2s_slot_mode_t slots,
+               int8_t slotMask = -1) {
+        (void)mode; (void)slotMask;
+        if (kvnFailBegin) return false;
+        _bytesPerSecond = rate * (bits / 8) * slots;
+        return _bytesPerSecond > 0;
+    }
+    bool end() { _bytesPerSecond = 0; return true; }
+
+    size_t readBytes(char* buffer, size_t size) {
+        if (_bytesPerSecond == 0) return 0;
+        delay((uint32_t)((uint64_t)size * 1000 / _bytesPerSecond));
+        memset(buffer, 0, size);
+        return size;
+    }
+
+private:
+    uint32_t _bytesPerSecond;
+};
+
+#endif // KVN_HAL_ESP_I2S_H
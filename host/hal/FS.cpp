@@ -0,0 +1,79 @@
+/*
+ * FS.cpp - Files in the active device's simulated flash
+ */
+
+#include <FS.h>
+#include <LittleFS.h>
+#include "kvn_sim.h"
+
+using kvn_sim::World;
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (_data == nullptr) return 0;
+    kvn_sim::HeapPause pause;   // A flash page, not heap
+    if (_pos + size > _data->size()) _data->resize(_pos + size);
+    memcpy(_data->data() + _pos, buffer, size);
+    _pos += size;
+    _stats->writes++;
+    _stats->bytes += size;
+    return size;
+}
+
+void File::flush() {
+    if (_data != nullptr) _stats->flushes++;
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (_data == nullptr || _pos >= _data->size()) return 0;
+    size_t n = _data->size() - _pos;
+    if (n > size) n = size;
+    memcpy(buffer, _data->data() + _pos, n);
+    _pos += n;
+    return n;
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (_data == nullptr) return false;
+    size_t base = mode == SeekSet ? 0 : mode == SeekCur ? _pos : _data->size();
+    if (base + pos > _data->size()) return false;
+    _pos = base + pos;
+    return true;
+}
+
+File FS::open(const char* path, const char* mode) {
+    kvn_sim::HeapPause pause;
+    kvn_sim::Device& device = World::active();
+    auto& flash = device.flash();
+    auto it = flash.find(path);
+
+    if (mode[0] == 'r' && mode[1] != '+') {
+        return it == flash.end() ? File() : File(&it->second, &device.flashStats());
+    }
+
+    std::vector<uint8_t>& data = flash[path];
+    if (mode[0] == 'w') data.clear();
+
+    File file(&data, &device.flashStats());
+    if (mode[0] == 'a') file.seek(0, SeekEnd);
+    return file;
+}
+
+bool FS::exists(const char* path) {
+    return World::active().flash().count(path) > 0;
+}
+
+bool FS::remove(const char* path) {
+    kvn_sim::HeapPause pause;
+    return World::active().flash().erase(path) > 0;
+}
+
+}  // namespace fs
@@ -0,0 +1,62 @@
+/*
+ * FS.h - Host stand-in for the Arduino-ESP32 file system API
+ *
+ * Files live in the active device's simulated flash, so they survive
+ * reboots and deep sleep but are private to that device.
+ */
+
+#ifndef KVN_HAL_FS_H
+#define KVN_HAL_FS_H
+
+#include <Arduino.h>
+#include <vector>
+
+namespace kvn_sim { struct FlashStats; }
+
+namespace fs {
+
+enum SeekMode { SeekSet, SeekCur, SeekEnd };
+
+class File : public Print {
+public:
+    File() : _data(nullptr), _pos(0), _stats(nullptr) {}
+    File(std::vector<uint8_t>* data, kvn_sim::FlashStats* stats)
+        : _data(data), _pos(0), _stats(stats) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    size_t read(uint8_t* buffer, size_t size);
+    int read();
+    int available() { return _data ? (int)(_data->size() - _pos) : 0; }
+
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position() const { return _pos; }
+    size_t size() const { return _data ? _data->size() : 0; }
+    void flush() override;
+    void close() { _data = nullptr; }
+
+    operator bool() const { return _data != nullptr; }
+
+private:
+    std::vector<uint8_t>* _data;
+    size_t _pos;
+    kvn_sim::FlashStats* _stats;   // The owning device's counters
+};
+
+class FS {
+public:
+    virtual ~FS() {}
+
+    // "r" needs an existing file, "w"/"w+" truncate, "a"/"r+" keep contents
+    File open(const char* path, const char* mode = "r");
+    bool exists(const char* path);
+    bool remove(const char* path);
+};
+
+}  // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#endif // KVN_HAL_FS_H
@@ -0,0 +1,206 @@
+/*
+ * FreeRTOS.cpp - FreeRTOS tasks as host threads
+ *
+ * Each task owns a notification value and state, guarded by its own
+ * mutex; waits block on a condition variable with the tick timeout.
+ */
+
+#include <Arduino.h>
+#include "kvn_sim.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using kvn_sim::World;
+
+struct tskTaskControlBlock {
+    std::string name;
+    uint32_t stackDepth;
+    UBaseType_t priority;
+    BaseType_t core;
+
+    std::mutex lock;
+    std::condition_variable notified;
+    uint32_t value;
+    bool pending;       // Notified since the last take/wait
+    uint32_t wakes;
+
+    std::atomic<bool> deleted;   // The device would have freed this TCB
+};
+
+// Thrown by vTaskDelete(nullptr), caught where the task's thread started
+struct TaskDeleted {};
+
+static std::mutex tasksLock;
+static std::vector<TaskHandle_t> tasks;   // Never freed, so a stale handle is caught, not undefined
+static thread_local TaskHandle_t currentTask = nullptr;
+
+static void runTask(TaskHandle_t task, TaskFunction_t code, void* param) {
+    currentTask = task;
+    try {
+        code(param);
+    } catch (const TaskDeleted&) {
+    }
+    task->deleted.store(true);
+}
+
+// A deleted task's handle points at freed memory on the device
+static void checkLive(TaskHandle_t task, const char* call) {
+    if (!task->deleted.load()) return;
+    fprintf(stderr, "%s() on task \"%s\" after vTaskDelete()\n", call, task->name.c_str());
+    abort();
+}
+
+// Blocks until ready() or the timeout; false on timeout. Holds `held`.
+template <typename Ready>
+static bool waitFor(TaskHandle_t task, std::unique_lock<std::mutex>& held, TickType_t ticks, Ready ready) {
+    bool ok;
+    if (ticks == portMAX_DELAY) {
+        task->notified.wait(held, ready);
+        ok = true;
+    } else {
+        ok = task->notified.wait_for(held, std::chrono::milliseconds(ticks), ready);
+    }
+    task->wakes++;
+    return ok;
+}
+
+// ==================== TASKS ====================
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth,
+                                   void* param, UBaseType_t priority, TaskHandle_t* created,
+                                   BaseType_t core) {
+    if (!World::onHost()) return pdFAIL;
+
+    TaskHandle_t task = new tskTaskControlBlock();
+    task->name = name ? name : "";
+    task->stackDepth = stackDepth;
+    task->priority = priority;
+    task->core = core;
+    task->value = 0;
+    task->pending = false;
+    task->wakes = 0;
+    task->deleted.store(false);
+    {
+        std::lock_guard<std::mutex> guard(tasksLock);
+        tasks.push_back(task);
+    }
+
+    // The handle is out before the task runs, as with a higher-priority
+    // creator on the device
+    if (created) *created = task;
+    std::thread(runTask, task, code, param).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task != nullptr && task != currentTask) return;   // Only self-delete
+    if (currentTask) throw TaskDeleted();
+
+    // loop() deleting the Arduino task: the main thread has nothing left to do
+    for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+}
+
+void vTaskSuspend(TaskHandle_t task) {
+    if (task != nullptr && task != currentTask) return;   // Only self-suspend
+    for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+    if (currentTask) {
+        std::lock_guard<std::mutex> guard(currentTask->lock);
+        currentTask->wakes++;
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask;
+}
+
+TaskHandle_t xTaskGetHandle(const char* name) {
+    std::lock_guard<std::mutex> guard(tasksLock);
+    for (TaskHandle_t task : tasks) {
+        if (task->name == name && !task->deleted.load()) return task;
+    }
+    return nullptr;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    if (task == nullptr) task = currentTask;
+    if (task == nullptr) return 0;
+    checkLive(task, "uxTaskGetStackHighWaterMark");
+    return task->stackDepth;
+}
+
+uint32_t kvnTaskWakes(TaskHandle_t task) {
+    if (task == nullptr) return 0;
+    std::lock_guard<std::mutex> guard(task->lock);
+    return task->wakes;
+}
+
+// ==================== NOTIFICATIONS ====================
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+    if (task == nullptr) return pdFAIL;
+    std::lock_guard<std::mutex> guard(task->lock);
+    switch (action) {
+        case eSetBits:                  task->value |= value; break;
+        case eIncrement:                task->value++; break;
+        case eSetValueWithOverwrite:    task->value = value; break;
+        case eSetValueWithoutOverwrite:
+            if (task->pending) return pdFAIL;
+            task->value = value;
+            break;
+        case eNoAction:                 break;
+    }
+    task->pending = true;
+    task->notified.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                              BaseType_t* higherPriorityTaskWoken) {
+    if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+    return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+    xTaskNotifyFromISR(task, 0, eIncrement, higherPriorityTaskWoken);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    TaskHandle_t task = currentTask;
+    if (task == nullptr) return 0;
+
+    std::unique_lock<std::mutex> held(task->lock);
+    waitFor(task, held, ticksToWait, [task] { return task->value != 0; });
+    uint32_t value = task->value;
+    if (value) task->value = clearCountOnExit ? 0 : value - 1;
+    task->pending = false;
+    return value;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value,
+                           TickType_t ticksToWait) {
+    TaskHandle_t task = currentTask;
+    if (task == nullptr) return pdFALSE;
+
+    std::unique_lock<std::mutex> held(task->lock);
+    if (!task->pending) task->value &= ~clearOnEntry;
+    bool got = waitFor(task, held, ticksToWait, [task] { return task->pending; });
+    if (value) *value = task->value;
+    if (got) {
+        task->value &= ~clearOnExit;
+        task->pending = false;
+    }
+    return got ? pdTRUE : pdFALSE;
+}
@@ -0,0 +1,72 @@
+/*
+ * HardwareSerial.h - Host stand-in for the ESP32 UARTs
+ *
+ * Output is collected by the active device (echoed per line with
+ * --verbose); input is whatever the scenario scripted with feedUart().
+ *
+ * Outside a device (World::onHost()) port 0 writes to stdout and input
+ * is what the test passes to receive(), from any thread. receive() then
+ * runs the onReceive() callback, as the UART driver's event task does
+ * when a burst ends. Inside a device the callback never runs.
+ */
+
+#ifndef KVN_HAL_HARDWARE_SERIAL_H
+#define KVN_HAL_HARDWARE_SERIAL_H
+
+#include "Print.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#define SERIAL_8N1 0x800001c
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    size_t readBytes(uint8_t* buffer, size_t length);
+    size_t readBytes(char* buffer, size_t length) { return readBytes((uint8_t*)buffer, length); }
+    void setTimeout(unsigned long) {}
+};
+
+typedef std::function<void(void)> OnReceiveCb;
+
+class HardwareSerial : public Stream {
+public:
+    explicit HardwareSerial(uint8_t port) : _port(port) {}
+
+    void begin(unsigned long baud, uint32_t config = 0, int8_t rxPin = -1, int8_t txPin = -1) {
+        (void)baud; (void)config; (void)rxPin; (void)txPin;
+    }
+    void end() {}
+    size_t setRxBufferSize(size_t size) { return size; }
+    bool setRxTimeout(uint8_t symbols) { (void)symbols; return true; }
+    void onReceive(OnReceiveCb function, bool onlyOnTimeout = false);
+
+    // Host side: bytes arriving on the RX pin (outside a device only)
+    void receive(const uint8_t* data, size_t length);
+
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    operator bool() const { return true; }
+
+private:
+    uint8_t _port;
+    std::mutex _rxLock;
+    std::deque<uint8_t> _rx;
+    OnReceiveCb _onReceive;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif // KVN_HAL_HARDWARE_SERIAL_H
@@ -0,0 +1,29 @@
+/*
+ * IPAddress.h - Host stand-in for the Arduino IPAddress class
+ */
+
+#ifndef KVN_HAL_IPADDRESS_H
+#define KVN_HAL_IPADDRESS_H
+
+#include <stdint.h>
+#include "Print.h"
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : _addr(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : _addr(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t addr) : _addr(addr) {}
+
+    operator uint32_t() const { return _addr; }
+    uint8_t operator[](int i) const { return (_addr >> (8 * i)) & 0xFF; }
+    bool operator==(const IPAddress& other) const { return _addr == other._addr; }
+
+    String toString() const;
+    size_t printTo(Print& p) const override;
+
+private:
+    uint32_t _addr;   // lwIP byte order: first octet in the low byte
+};
+
+#endif // KVN_HAL_IPADDRESS_H
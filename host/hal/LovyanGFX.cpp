@@ -0,0 +1,67 @@
+/*
+ * LovyanGFX.cpp - Panel transfers as simulated SPI time
+ */
+
+#include <LovyanGFX.hpp>
+#include "kvn_sim.h"
+
+using kvn_sim::World;
+using kvn_sim::Device;
+
+namespace lgfx {
+
+// Simulated microseconds to clock `bytes` out over SPI
+static uint64_t spiUs(const Device& d, uint64_t bytes) {
+    uint32_t rate = d.cost().spiBytesPerMs;
+    return rate ? bytes * 1000 / rate : 0;
+}
+
+bool LGFX_Device::init() {
+    return _panel != nullptr;
+}
+
+void LGFX_Device::setBrightness(uint8_t brightness) {
+    _brightness = brightness;
+    Light_PWM* light = _panel ? _panel->light() : nullptr;
+    if (light && light->config().pin_bl >= 0) {
+        World::active().analogWrite(light->config().pin_bl, brightness);
+    }
+}
+
+int32_t LGFX_Device::width() const {
+    return _panel ? _panel->config().panel_width : 0;
+}
+
+int32_t LGFX_Device::height() const {
+    return _panel ? _panel->config().panel_height : 0;
+}
+
+void LGFX_Device::fillScreen(uint16_t color) {
+    (void)color;
+    waitDMA();
+    Device& d = World::active();
+    d.advance(spiUs(d, (uint64_t)width() * height() * 2));
+}
+
+void LGFX_Device::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* data) {
+    (void)x;
+    (void)y;
+    (void)data;
+    waitDMA();   // One transfer in flight at a time
+
+    Device& d = World::active();
+    _dmaDoneAt = d.now() + spiUs(d, (uint64_t)w * h * 2);
+}
+
+void LGFX_Device::waitDMA() {
+    Device& d = World::active();
+    if (_dmaDoneAt > d.now()) d.advance(_dmaDoneAt - d.now());
+}
+
+void* LGFX_Sprite::createSprite(int32_t w, int32_t h) {
+    if (w <= 0 || h <= 0) return nullptr;
+    _pixels.assign((size_t)w * h * (_bits + 15) / 16, 0);
+    return _pixels.data();
+}
+
+}  // namespace lgfx
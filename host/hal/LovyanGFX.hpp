@@ -0,0 +1,176 @@
+/*
+ * LovyanGFX.hpp - Host stand-in for the LovyanGFX display driver
+ *
+ * Nothing is drawn. Panel transfers cost simulated time at the SPI rate
+ * of the cost model: pushImageDMA() runs in the background until the
+ * next waitDMA(), fillScreen() blocks for the whole frame.
+ */
+
+#ifndef KVN_HAL_LOVYANGFX_HPP
+#define KVN_HAL_LOVYANGFX_HPP
+
+#include <Arduino.h>
+#include <vector>
+
+#define SPI2_HOST 1
+#define SPI_DMA_CH_AUTO 3
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_ORANGE      0xFDA0
+#define TFT_WHITE       0xFFFF
+
+namespace lgfx {
+
+struct swap565_t {
+    uint8_t raw[2];
+};
+
+class Bus_SPI {
+public:
+    struct config_t {
+        int spi_host = SPI2_HOST;
+        uint8_t spi_mode = 0;
+        uint32_t freq_write = 40000000;
+        uint32_t freq_read = 16000000;
+        bool spi_3wire = true;
+        bool use_lock = true;
+        int dma_channel = SPI_DMA_CH_AUTO;
+        int16_t pin_sclk = -1;
+        int16_t pin_mosi = -1;
+        int16_t pin_miso = -1;
+        int16_t pin_dc = -1;
+    };
+
+    config_t config() const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+private:
+    config_t _cfg;
+};
+
+class Light_PWM {
+public:
+    struct config_t {
+        int16_t pin_bl = -1;
+        bool invert = false;
+        uint32_t freq = 12000;
+        uint8_t pwm_channel = 7;
+    };
+
+    config_t config() const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+private:
+    config_t _cfg;
+};
+
+class Panel_ST7789 {
+public:
+    struct config_t {
+        int16_t pin_cs = -1;
+        int16_t pin_rst = -1;
+        int16_t pin_busy = -1;
+        uint16_t panel_width = 240;
+        uint16_t panel_height = 320;
+        int16_t offset_x = 0;
+        int16_t offset_y = 0;
+        uint8_t offset_rotation = 0;
+        uint8_t dummy_read_pixel = 8;
+        uint8_t dummy_read_bits = 1;
+        bool readable = true;
+        bool invert = false;
+        bool rgb_order = false;
+        bool dlen_16bit = false;
+        bool bus_shared = true;
+    };
+
+    config_t config() const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+    void setBus(Bus_SPI* bus) { _bus = bus; }
+    void setLight(Light_PWM* light) { _light = light; }
+    Light_PWM* light() const { return _light; }
+
+private:
+    config_t _cfg;
+    Bus_SPI* _bus = nullptr;
+    Light_PWM* _light = nullptr;
+};
+
+// Text and shape calls shared by the panel and sprites (no pixels kept)
+class LGFXBase : public Print {
+public:
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { (void)buffer; return size; }
+    using Print::write;
+
+    void setTextColor(uint16_t fg) { _fg = fg; }
+    void setTextColor(uint16_t fg, uint16_t bg) { _fg = fg; (void)bg; }
+    void setTextSize(float size) { (void)size; }
+    void setCursor(int32_t x, int32_t y) { _cursorX = x; _cursorY = y; }
+    int32_t getCursorX() const { return _cursorX; }
+    int32_t getCursorY() const { return _cursorY; }
+    void setRotation(uint8_t rotation) { (void)rotation; }
+
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) { (void)x; (void)y; (void)w; (void)color; }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color) { (void)x; (void)y; (void)h; (void)color; }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { (void)x; (void)y; (void)w; (void)h; (void)color; }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { (void)x; (void)y; (void)w; (void)h; (void)color; }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { (void)x; (void)y; (void)r; (void)color; }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { (void)x; (void)y; (void)r; (void)color; }
+
+protected:
+    uint16_t _fg = TFT_WHITE;
+    int32_t _cursorX = 0;
+    int32_t _cursorY = 0;
+};
+
+class LGFX_Device : public LGFXBase {
+public:
+    void setPanel(Panel_ST7789* panel) { _panel = panel; }
+    bool init();
+    void setBrightness(uint8_t brightness);
+    uint8_t getBrightness() const { return _brightness; }
+    int32_t width() const;
+    int32_t height() const;
+
+    void fillScreen(uint16_t color);
+    void startWrite() {}
+    void endWrite() {}
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* data);
+    void waitDMA();
+
+private:
+    Panel_ST7789* _panel = nullptr;
+    uint8_t _brightness = 0;
+    uint64_t _dmaDoneAt = 0;   // Simulated time the transfer in flight ends
+};
+
+class LGFX_Sprite : public LGFXBase {
+public:
+    LGFX_Sprite() {}
+    explicit LGFX_Sprite(LGFX_Device* parent) { (void)parent; }
+
+    void setColorDepth(uint8_t bits) { _bits = bits; }
+    void* createSprite(int32_t w, int32_t h);
+    void deleteSprite() { _pixels.clear(); }
+    void* getBuffer() { return _pixels.empty() ? nullptr : _pixels.data(); }
+
+private:
+    uint8_t _bits = 16;
+    std::vector<uint16_t> _pixels;
+};
+
+}  // namespace lgfx
+
+using lgfx::LGFX_Sprite;
+
+#endif // KVN_HAL_LOVYANGFX_HPP
@@ -0,0 +1,73 @@
+/*
+ * Print.cpp - Implementation
+ */
+
+#include "Print.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (write(*buffer++) == 0) break;
+        n++;
+    }
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, len);
+
+    std::vector<char> big(len + 1);
+    va_start(args, format);
+    vsnprintf(big.data(), big.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)big.data(), len);
+}
+
+static size_t printNumber(Print& p, unsigned long long n, int base, bool negative) {
+    if (base < 2) base = 10;
+    char buf[72];
+    char* str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    do {
+        int digit = n % base;
+        *--str = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        n /= base;
+    } while (n);
+    if (negative) *--str = '-';
+    return p.write(str);
+}
+
+size_t Print::print(long n, int base) {
+    return print((long long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    return printNumber(*this, n, base, false);
+}
+
+size_t Print::print(long long n, int base) {
+    if (base == 10 && n < 0) return printNumber(*this, -(unsigned long long)n, 10, true);
+    return printNumber(*this, (unsigned long long)n, base, false);
+}
+
+size_t Print::print(unsigned long long n, int base) {
+    return printNumber(*this, n, base, false);
+}
+
+size_t Print::print(double n, int digits) {
+    if (isnan(n)) return write("nan");
+    if (isinf(n)) return write("inf");
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
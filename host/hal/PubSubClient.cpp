@@ -0,0 +1,273 @@
+/*
+ * PubSubClient.cpp - MQTT client on the simulated broker
+ *
+ * The broker session belongs to the active device, so sleeping or
+ * restarting drops it even though this object is a sketch global.
+ */
+
+#include <PubSubClient.h>
+#include "kvn_sim.h"
+
+using kvn_sim::World;
+using kvn_sim::Device;
+using kvn_sim::Broker;
+using kvn_sim::SimMessage;
+
+static Device& dev() {
+    return World::active();
+}
+
+// Outside a device (World::onHost()) the other end is hostBroker(), on
+// the host clock; the link is always up and nothing costs simulated time
+static Broker& broker() {
+    return World::onHost() ? kvn_sim::hostBroker() : World::current()->broker();
+}
+
+static uint64_t now(Device& d) {
+    return World::onHost() ? kvn_sim::hostMicros() : d.now();
+}
+
+static void advance(Device& d, uint64_t us) {
+    if (!World::onHost()) d.advance(us);
+}
+
+static bool linkUp(Device& d) {
+    return World::onHost() || d.wifiLink() == kvn_sim::LINK_UP;
+}
+
+PubSubClient::PubSubClient() {
+    callback = nullptr;
+    _bufferSize = MQTT_MAX_PACKET_SIZE;
+    _keepAlive = MQTT_KEEPALIVE;
+    _state = MQTT_DISCONNECTED;
+    _streamLength = 0;
+    _streamRetained = false;
+    _streaming = false;
+}
+
+PubSubClient::PubSubClient(Client& client) : PubSubClient() {
+    (void)client;
+}
+
+PubSubClient& PubSubClient::setServer(const char* domain, uint16_t port) {
+    (void)domain;
+    (void)port;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setServer(IPAddress ip, uint16_t port) {
+    (void)ip;
+    (void)port;
+    return *this;
+}
+
+PubSubClient& PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE) {
+    this->callback = callback;
+    return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) {
+    if (size == 0) return false;
+    _bufferSize = size;
+    return true;
+}
+
+// ==================== CONNECTION ====================
+
+bool PubSubClient::connect(const char* id) {
+    return connect(id, nullptr, nullptr, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+    return connect(id, user, pass, nullptr, 0, false, nullptr, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* willTopic, uint8_t willQos, bool willRetain,
+                           const char* willMessage) {
+    return connect(id, nullptr, nullptr, willTopic, willQos, willRetain, willMessage, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass, const char* willTopic,
+                           uint8_t willQos, bool willRetain, const char* willMessage) {
+    return connect(id, user, pass, willTopic, willQos, willRetain, willMessage, true);
+}
+
+bool PubSubClient::connect(const char* id, const char* user, const char* pass, const char* willTopic,
+                           uint8_t willQos, bool willRetain, const char* willMessage, bool cleanSession) {
+    (void)user;
+    (void)pass;
+    (void)willQos;
+    Device& d = dev();
+
+    if (connected()) return true;
+    if (!linkUp(d)) {
+        _state = MQTT_CONNECT_FAILED;
+        d.noteMqttConnect(false);
+        return false;
+    }
+
+    // Round trip first; the broker answers at the end of it
+    advance(d, d.cost().mqttConnectUs);
+
+    SimMessage will;
+    if (willTopic) will = {willTopic, willMessage ? willMessage : "", willRetain, 0};
+    Broker::Session* session = broker().connect(id, cleanSession, willTopic ? &will : nullptr, now(d));
+    if (session == nullptr) {
+        // Nobody answers: the socket connect times out
+        advance(d, d.cost().mqttTimeoutUs - d.cost().mqttConnectUs);
+        _state = MQTT_CONNECTION_TIMEOUT;
+        d.noteMqttConnect(false);
+        return false;
+    }
+
+    d.setMqttSession(session);
+    d.noteMqttConnect(true);
+    _state = MQTT_CONNECTED;
+    return true;
+}
+
+void PubSubClient::disconnect() {
+    Device& d = dev();
+    Broker::Session* session = d.mqttSession();
+    if (session) {
+        // Without a link the DISCONNECT never arrives: the broker notices
+        // after 1.5 keepalive periods and sends the will
+        bool graceful = linkUp(d);
+        uint64_t at = graceful ? now(d) : now(d) + _keepAlive * 1500000ULL;
+        broker().disconnect(session, graceful, at);
+        d.setMqttSession(nullptr);
+    }
+    _state = MQTT_DISCONNECTED;
+}
+
+bool PubSubClient::connected() {
+    Device& d = dev();
+    Broker::Session* session = d.mqttSession();
+    if (session == nullptr) {
+        if (_state == MQTT_CONNECTED) _state = MQTT_CONNECTION_LOST;
+        return false;
+    }
+
+    if (!linkUp(d) || !broker().alive(session, now(d))) {
+        d.setMqttSession(nullptr);
+        _state = MQTT_CONNECTION_LOST;
+        return false;
+    }
+    return true;
+}
+
+// ==================== PUBLISH ====================
+
+bool PubSubClient::publish(const char* topic, const char* payload) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, false);
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+    return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length) {
+    return publish(topic, payload, length, false);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+    if (!connected()) return false;
+
+    // Same limit as the real client: header, topic and payload in one buffer
+    size_t packet = MQTT_MAX_HEADER_SIZE + 2 + strlen(topic) + length;
+    if (packet > _bufferSize) return false;
+
+    Device& d = dev();
+    advance(d, d.cost().publishUs + (uint64_t)packet * d.cost().publishByteNs / 1000);
+    kvn_sim::HeapPause pause;
+    broker().publish(topic, std::string((const char*)payload, length), retained, now(d));
+    return true;
+}
+
+bool PubSubClient::beginPublish(const char* topic, unsigned int length, bool retained) {
+    if (!connected()) return false;
+    kvn_sim::HeapPause pause;
+    _streamTopic = topic;
+    _streamPayload.clear();
+    _streamLength = length;
+    _streamRetained = retained;
+    _streaming = true;
+    return true;
+}
+
+size_t PubSubClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t PubSubClient::write(const uint8_t* buffer, size_t size) {
+    if (!_streaming) return 0;
+    kvn_sim::HeapPause pause;
+    _streamPayload.append((const char*)buffer, size);
+    return size;
+}
+
+int PubSubClient::endPublish() {
+    if (!_streaming) return 0;
+    _streaming = false;
+    if (_streamPayload.size() != _streamLength || !connected()) return 0;
+
+    Device& d = dev();
+    size_t packet = MQTT_MAX_HEADER_SIZE + 2 + _streamTopic.size() + _streamLength;
+    advance(d, d.cost().publishUs + (uint64_t)packet * d.cost().publishByteNs / 1000);
+    kvn_sim::HeapPause pause;
+    broker().publish(_streamTopic, _streamPayload, _streamRetained, now(d));
+    return 1;
+}
+
+// ==================== SUBSCRIBE ====================
+
+bool PubSubClient::subscribe(const char* topic) {
+    return subscribe(topic, 0);
+}
+
+bool PubSubClient::subscribe(const char* topic, uint8_t qos) {
+    (void)qos;
+    if (!connected()) return false;
+    Device& d = dev();
+    advance(d, d.cost().publishUs);
+    kvn_sim::HeapPause pause;
+    broker().subscribe(d.mqttSession(), topic, now(d));
+    return true;
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+    if (!connected()) return false;
+    Device& d = dev();
+    advance(d, d.cost().publishUs);
+    broker().unsubscribe(d.mqttSession(), topic);
+    return true;
+}
+
+// ==================== RECEIVE ====================
+
+bool PubSubClient::loop() {
+    if (!connected()) return false;
+
+    // One packet per call, like the real client
+    Device& d = dev();
+    Broker::Session* session = d.mqttSession();
+    const SimMessage* msg = broker().peek(session, now(d));
+    if (msg == nullptr) return true;
+
+    size_t packet = MQTT_MAX_HEADER_SIZE + 2 + msg->topic.size() + msg->payload.size();
+    if (packet <= _bufferSize && callback) {
+        // The callback may publish, so hand it copies and pop first
+        _rxTopic = msg->topic;
+        _rxPayload = msg->payload;
+        broker().pop(session, now(d));
+        advance(d, d.cost().receiveUs + (uint64_t)packet * d.cost().publishByteNs / 1000);
+        kvn_sim::heapMeter.depth++;
+        callback(&_rxTopic[0], (uint8_t*)&_rxPayload[0], _rxPayload.size());
+        kvn_sim::heapMeter.depth--;
+    } else {
+        // Too large for the buffer: read and discarded
+        broker().pop(session, now(d));
+        advance(d, d.cost().receiveUs);
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+/*
+ * PubSubClient.h - Host stand-in for knolleary/PubSubClient
+ *
+ * Same API and the same limits as the real client: QoS 0 publishes,
+ * packets larger than the buffer are refused (or dropped on receive),
+ * and loop() hands at most one inbound message to the callback. The
+ * other end is the simulator's in-process broker; outside a device it is
+ * kvn_sim::hostBroker(), for one client at a time.
+ */
+
+#ifndef KVN_HAL_PUBSUBCLIENT_H
+#define KVN_HAL_PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <functional>
+#include <string>
+
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_MAX_HEADER_SIZE 5
+#define MQTT_KEEPALIVE 15
+
+#define MQTT_CONNECTION_TIMEOUT     -4
+#define MQTT_CONNECTION_LOST        -3
+#define MQTT_CONNECT_FAILED         -2
+#define MQTT_DISCONNECTED           -1
+#define MQTT_CONNECTED               0
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+class PubSubClient : public Print {
+public:
+    PubSubClient();
+    explicit PubSubClient(Client& client);
+
+    PubSubClient& setServer(const char* domain, uint16_t port);
+    PubSubClient& setServer(IPAddress ip, uint16_t port);
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE);
+    PubSubClient& setKeepAlive(uint16_t keepAlive) { _keepAlive = keepAlive; return *this; }
+    PubSubClient& setSocketTimeout(uint16_t timeout) { (void)timeout; return *this; }
+    bool setBufferSize(uint16_t size);
+    uint16_t getBufferSize() const { return _bufferSize; }
+
+    bool connect(const char* id);
+    bool connect(const char* id, const char* user, const char* pass);
+    bool connect(const char* id, const char* willTopic, uint8_t willQos, bool willRetain,
+                 const char* willMessage);
+    bool connect(const char* id, const char* user, const char* pass, const char* willTopic,
+                 uint8_t willQos, bool willRetain, const char* willMessage);
+    bool connect(const char* id, const char* user, const char* pass, const char* willTopic,
+                 uint8_t willQos, bool willRetain, const char* willMessage, bool cleanSession);
+    void disconnect();
+
+    bool publish(const char* topic, const char* payload);
+    bool publish(const char* topic, const char* payload, bool retained);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length);
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained);
+
+    // Streamed publish for payloads larger than the buffer
+    bool beginPublish(const char* topic, unsigned int length, bool retained);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int endPublish();
+
+    bool subscribe(const char* topic);
+    bool subscribe(const char* topic, uint8_t qos);
+    bool unsubscribe(const char* topic);
+
+    bool loop();
+    bool connected();
+    int state() const { return _state; }
+
+private:
+    MQTT_CALLBACK_SIGNATURE;
+    uint16_t _bufferSize;
+    uint16_t _keepAlive;
+    int _state;
+
+    std::string _streamTopic;
+    std::string _streamPayload;
+    unsigned int _streamLength;
+    bool _streamRetained;
+    bool _streaming;
+
+    std::string _rxTopic;
+    std::string _rxPayload;
+};
+
+#endif // KVN_HAL_PUBSUBCLIENT_H
@@ -0,0 +1,98 @@
+/*
+ * WString.cpp - Implementation
+ */
+
+#include "WString.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static std::string formatInteger(unsigned long long n, unsigned char base, bool negative) {
+    if (base < 2) base = 10;
+    std::string s;
+    do {
+        int digit = n % base;
+        s.insert(s.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+        n /= base;
+    } while (n);
+    if (negative) s.insert(s.begin(), '-');
+    return s;
+}
+
+String::String(int n, unsigned char base) : String((long)n, base) {}
+
+String::String(unsigned int n, unsigned char base) : String((unsigned long)n, base) {}
+
+String::String(long n, unsigned char base) {
+    bool negative = base == 10 && n < 0;
+    _s = formatInteger(negative ? -(unsigned long long)n : (unsigned long long)n, base, negative);
+}
+
+String::String(unsigned long n, unsigned char base) : _s(formatInteger(n, base, false)) {}
+
+String::String(float n, unsigned char decimals) : String((double)n, decimals) {}
+
+String::String(double n, unsigned char decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, n);
+    _s = buf;
+}
+
+// As Arduino: copies at most size - 1 characters and always terminates
+void String::toCharArray(char* buf, unsigned int size, unsigned int from) const {
+    if (buf == nullptr || size == 0) return;
+    size_t n = from < _s.size() ? _s.copy(buf, size - 1, from) : 0;
+    buf[n] = '\0';
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t i = _s.find(c, from);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+    size_t i = _s.find(s._s, from);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+String String::substring(unsigned int from) const {
+    return from >= _s.size() ? String() : String(_s.substr(from));
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        unsigned int t = from;
+        from = to;
+        to = t;
+    }
+    if (from >= _s.size()) return String();
+    return String(_s.substr(from, to - from));
+}
+
+bool String::endsWith(const String& s) const {
+    return _s.size() >= s._s.size() && _s.compare(_s.size() - s._s.size(), s._s.size(), s._s) == 0;
+}
+
+void String::trim() {
+    size_t start = 0;
+    while (start < _s.size() && isspace((unsigned char)_s[start])) start++;
+    size_t end = _s.size();
+    while (end > start && isspace((unsigned char)_s[end - 1])) end--;
+    _s = _s.substr(start, end - start);
+}
+
+void String::toLowerCase() {
+    for (char& c : _s) c = tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : _s) c = toupper((unsigned char)c);
+}
+
+long String::toInt() const {
+    return strtol(_s.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return strtof(_s.c_str(), nullptr);
+}
@@ -0,0 +1,65 @@
+/*
+ * WString.h - Host stand-in for the Arduino String class
+ */
+
+#ifndef KVN_HAL_WSTRING_H
+#define KVN_HAL_WSTRING_H
+
+#include <stddef.h>
+#include <string>
+
+class String {
+public:
+    String(const char* s = "") : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int n, unsigned char base = 10);
+    explicit String(unsigned int n, unsigned char base = 10);
+    explicit String(long n, unsigned char base = 10);
+    explicit String(unsigned long n, unsigned char base = 10);
+    explicit String(float n, unsigned char decimals = 2);
+    explicit String(double n, unsigned char decimals = 2);
+
+    const char* c_str() const { return _s.c_str(); }
+    unsigned int length() const { return _s.size(); }
+    bool isEmpty() const { return _s.empty(); }
+    void reserve(unsigned int size) { _s.reserve(size); }
+
+    char charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+    void toCharArray(char* buf, unsigned int size, unsigned int from = 0) const;
+    char operator[](unsigned int i) const { return charAt(i); }
+
+    String& operator+=(const String& s) { _s += s._s; return *this; }
+    String& operator+=(const char* s) { if (s) _s += s; return *this; }
+    String& operator+=(char c) { _s += c; return *this; }
+    bool concat(const String& s) { _s += s._s; return true; }
+
+    bool equals(const String& s) const { return _s == s._s; }
+    bool operator==(const String& s) const { return _s == s._s; }
+    bool operator==(const char* s) const { return s && _s == s; }
+    bool operator!=(const String& s) const { return _s != s._s; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    bool operator<(const String& s) const { return _s < s._s; }
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String& s, unsigned int from = 0) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    bool startsWith(const String& s) const { return _s.compare(0, s._s.size(), s._s) == 0; }
+    bool endsWith(const String& s) const;
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    long toInt() const;
+    float toFloat() const;
+
+    friend String operator+(const String& a, const String& b) { return String(a._s + b._s); }
+    friend String operator+(const String& a, const char* b) { return String(a._s + (b ? b : "")); }
+    friend String operator+(const char* a, const String& b) { return String((a ? a : "") + b._s); }
+    friend String operator+(const String& a, char b) { return String(a._s + b); }
+
+private:
+    std::string _s;
+};
+
+#endif // KVN_HAL_WSTRING_H
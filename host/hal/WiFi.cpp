@@ -0,0 +1,107 @@
+/*
+ * WiFi.cpp - Station on the simulated access point
+ *
+ * WiFi is one global shared by every sketch in the process, so all link
+ * state lives in the active device.
+ */
+
+#include <WiFi.h>
+#include "kvn_sim.h"
+
+using kvn_sim::World;
+using kvn_sim::Device;
+
+WiFiClass WiFi;
+
+static Device& dev() {
+    return World::active();
+}
+
+// ==================== IPADDRESS ====================
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(buf);
+}
+
+size_t IPAddress::printTo(Print& p) const {
+    return p.print(toString());
+}
+
+// ==================== WIFI ====================
+
+WiFiClass::WiFiClass() {
+    memset(_bssid, 0, sizeof(_bssid));
+}
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+    if (mode == WIFI_OFF && !World::onHost()) dev().wifiDisconnect(true);
+    return true;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* password, int32_t channel,
+                             const uint8_t* bssid, bool connect) {
+    (void)ssid;
+    (void)password;
+    if (connect && !World::onHost()) dev().wifiBegin(channel != 0 && bssid != nullptr, (uint8_t)channel, bssid);
+    return status();
+}
+
+bool WiFiClass::config(IPAddress local, IPAddress gateway, IPAddress subnet,
+                       IPAddress dns1, IPAddress dns2) {
+    (void)gateway;
+    (void)subnet;
+    (void)dns1;
+    (void)dns2;
+    if (!World::onHost()) dev().setStaticIp((uint32_t)local);
+    return true;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+    (void)eraseAp;
+    if (!World::onHost()) dev().wifiDisconnect(wifiOff);
+    return true;
+}
+
+wl_status_t WiFiClass::status() {
+    if (World::onHost()) return WL_CONNECTED;
+    return dev().wifiLink() == kvn_sim::LINK_UP ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+IPAddress WiFiClass::localIP() {
+    if (World::onHost()) return IPAddress(127, 0, 0, 1);
+    return status() == WL_CONNECTED ? IPAddress(dev().ip()) : IPAddress();
+}
+
+IPAddress WiFiClass::gatewayIP() {
+    return IPAddress(192, 168, 86, 1);
+}
+
+IPAddress WiFiClass::subnetMask() {
+    return IPAddress(255, 255, 255, 0);
+}
+
+IPAddress WiFiClass::dnsIP(uint8_t index) {
+    (void)index;
+    return IPAddress(192, 168, 86, 1);
+}
+
+uint8_t* WiFiClass::BSSID() {
+    if (World::current()) memcpy(_bssid, World::current()->apBssid(), sizeof(_bssid));
+    return _bssid;
+}
+
+int32_t WiFiClass::channel() {
+    return World::current() ? World::current()->apChannel() : 0;
+}
+
+int8_t WiFiClass::RSSI() {
+    return status() == WL_CONNECTED ? -55 : 0;
+}
+
+String WiFiClass::macAddress() {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "24:0A:C4:00:00:%02X", World::onHost() ? 0 : dev().index());
+    return String(buf);
+}
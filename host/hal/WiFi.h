@@ -0,0 +1,66 @@
+/*
+ * WiFi.h - Host stand-in for the ESP32 WiFi station
+ *
+ * The link comes up after the simulator's join time (full scan, or the
+ * faster cached BSSID/channel join) and drops for scripted AP outages.
+ * Outside a device (World::onHost()) the station is the host itself:
+ * always connected, at 127.0.0.1.
+ */
+
+#ifndef KVN_HAL_WIFI_H
+#define KVN_HAL_WIFI_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} wifi_mode_t;
+
+class WiFiClass {
+public:
+    WiFiClass();
+
+    bool mode(wifi_mode_t mode);
+    void persistent(bool persistent) { (void)persistent; }
+    void setAutoReconnect(bool autoReconnect) { (void)autoReconnect; }
+
+    wl_status_t begin(const char* ssid, const char* password = nullptr,
+                      int32_t channel = 0, const uint8_t* bssid = nullptr, bool connect = true);
+    bool config(IPAddress local, IPAddress gateway, IPAddress subnet,
+                IPAddress dns1 = IPAddress(), IPAddress dns2 = IPAddress());
+    bool disconnect(bool wifiOff = false, bool eraseAp = false);
+
+    wl_status_t status();
+    bool isConnected() { return status() == WL_CONNECTED; }
+
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t index = 0);
+    uint8_t* BSSID();
+    int32_t channel();
+    int8_t RSSI();
+    String macAddress();
+
+private:
+    uint8_t _bssid[6];
+};
+
+extern WiFiClass WiFi;
+
+#endif // KVN_HAL_WIFI_H
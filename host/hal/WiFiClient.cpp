@@ -0,0 +1,123 @@
+/*
+ * WiFiClient.cpp - TCP client on host sockets
+ */
+
+#include <WiFiClient.h>
+#include "kvn_sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using kvn_sim::World;
+
+int WiFiClient::connect(IPAddress ip, uint16_t port) {
+    char host[16];
+    snprintf(host, sizeof(host), "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+    return connect(host, port);
+}
+
+int WiFiClient::connect(const char* host, uint16_t port) {
+    stop();
+    if (!World::onHost()) return 0;
+
+    char service[8];
+    snprintf(service, sizeof(service), "%u", port);
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addr = nullptr;
+    if (getaddrinfo(host, service, &hints, &addr) != 0 || addr == nullptr) return 0;
+
+    int fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (fd < 0) {
+        freeaddrinfo(addr);
+        return 0;
+    }
+
+    // Non-blocking connect, bounded like the ESP32's
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    int rc = ::connect(fd, addr->ai_addr, addr->ai_addrlen);
+    freeaddrinfo(addr);
+    if (rc < 0 && errno == EINPROGRESS) {
+        struct pollfd p = {fd, POLLOUT, 0};
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (poll(&p, 1, WIFI_CLIENT_CONNECT_MS) == 1 &&
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0 && err == 0) {
+            rc = 0;
+        }
+    }
+    if (rc < 0) {
+        close(fd);
+        return 0;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    _fd = fd;
+    return 1;
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (_fd < 0) return 0;
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(_fd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd p = {_fd, POLLOUT, 0};
+            if (poll(&p, 1, WIFI_CLIENT_CONNECT_MS) != 1) break;
+        } else {
+            break;
+        }
+    }
+    return sent;
+}
+
+int WiFiClient::available() {
+    if (_fd < 0) return 0;
+    int n = 0;
+    if (ioctl(_fd, FIONREAD, &n) < 0) return 0;
+    return n;
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (_fd < 0) return -1;
+    ssize_t n = recv(_fd, buffer, size, MSG_DONTWAIT);
+    return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek() {
+    if (_fd < 0) return -1;
+    uint8_t c;
+    return recv(_fd, &c, 1, MSG_DONTWAIT | MSG_PEEK) == 1 ? c : -1;
+}
+
+void WiFiClient::stop() {
+    if (_fd >= 0) close(_fd);
+    _fd = -1;
+}
+
+uint8_t WiFiClient::connected() {
+    if (_fd < 0) return 0;
+    uint8_t c;
+    ssize_t n = recv(_fd, &c, 1, MSG_DONTWAIT | MSG_PEEK);
+    if (n > 0) return 1;
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 1;
+
+    // Orderly close (0) or reset, with nothing left to read
+    stop();
+    return 0;
+}
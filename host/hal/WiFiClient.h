@@ -0,0 +1,44 @@
+/*
+ * WiFiClient.h - Host stand-in for the ESP32 TCP client
+ *
+ * Outside a device (World::onHost()) this is a real TCP socket on the
+ * host, so library clients can be tested against local servers (e.g.
+ * ESP32_AI against examples/MockServer). Reads never block, like the
+ * ESP32's. Inside a simulated device there is no network to reach and
+ * connect() fails; PubSubClient talks to the simulator's broker without
+ * a socket.
+ */
+
+#ifndef KVN_HAL_WIFICLIENT_H
+#define KVN_HAL_WIFICLIENT_H
+
+#include "Client.h"
+
+#define WIFI_CLIENT_CONNECT_MS 3000
+
+class WiFiClient : public Client {
+public:
+    WiFiClient() : _fd(-1) {}
+    ~WiFiClient() override { stop(); }
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char* host, uint16_t port) override;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size) override;
+    int peek() override;
+    void stop() override;
+    // False once the peer closed and everything it sent has been read
+    uint8_t connected() override;
+    operator bool() override { return _fd >= 0; }
+
+private:
+    int _fd;
+};
+
+#endif // KVN_HAL_WIFICLIENT_H
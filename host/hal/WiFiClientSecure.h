@@ -0,0 +1,19 @@
+/*
+ * WiFiClientSecure.h - Host stand-in for the ESP32 TLS client
+ *
+ * The same transport as WiFiClient, without TLS: certificates are accepted
+ * and unused, so it only reaches plain-TCP servers on the host.
+ */
+
+#ifndef KVN_HAL_WIFICLIENTSECURE_H
+#define KVN_HAL_WIFICLIENTSECURE_H
+
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    void setInsecure() {}
+    void setCACert(const char* rootCA) { (void)rootCA; }
+};
+
+#endif // KVN_HAL_WIFICLIENTSECURE_H
@@ -0,0 +1,78 @@
+/*
+ * Wire.cpp - I2C transactions on the active device
+ */
+
+#include <Wire.h>
+#include "kvn_sim.h"
+
+using kvn_sim::World;
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    (void)scl;
+    _sda = sda;
+    if (frequency) _clockHz = frequency;
+    _started = true;
+    if (!World::onHost()) World::active().i2cBegin();
+    return true;
+}
+
+bool TwoWire::end() {
+    _started = false;
+    _held = false;
+    _transmitting = false;
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+    _clockHz = frequency;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint16_t address) {
+    _txAddress = address;
+    _txLength = 0;
+    _transmitting = true;
+    _held = false;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    if (!_started || !_transmitting) return 4;
+    _transmitting = false;
+    if (!sendStop) {
+        _held = true;
+        return 0;
+    }
+    if (World::onHost()) return 2;
+    bool ok = World::active().i2cTransfer(_sda, _clockHz, (uint8_t)_txAddress, _tx, _txLength, true,
+                                          nullptr, 0);
+    return ok ? 0 : 2;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop) {
+    (void)sendStop;
+    _rxLength = 0;
+    _rxIndex = 0;
+    if (!_started || World::onHost()) return 0;
+    if (size > I2C_BUFFER_LENGTH) size = I2C_BUFFER_LENGTH;
+
+    bool write = _held && _txAddress == address;
+    _held = false;
+    bool ok = World::active().i2cTransfer(_sda, _clockHz, (uint8_t)address, _tx, write ? _txLength : 0, write,
+                                          _rx, size);
+    _rxLength = ok ? size : 0;
+    return _rxLength;
+}
+
+size_t TwoWire::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+    if (!_transmitting) return 0;
+    size_t n = 0;
+    while (n < size && _txLength < I2C_BUFFER_LENGTH) _tx[_txLength++] = data[n++];
+    return n;
+}
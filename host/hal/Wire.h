@@ -0,0 +1,64 @@
+/*
+ * Wire.h - Host stand-in for the ESP32 TwoWire (I2C master)
+ *
+ * The bus is picked by the SDA pin passed to begin(); the active device
+ * answers for whatever I2C peripherals the scenario attached to that pin.
+ * Like the ESP32 core, endTransmission(false) sends nothing: the write is
+ * held and goes out with the next requestFrom() as one transaction.
+ * Outside a device (World::onHost()) the bus is empty: every address NACKs.
+ */
+
+#ifndef KVN_HAL_WIRE_H
+#define KVN_HAL_WIRE_H
+
+#include "HardwareSerial.h"
+
+#define I2C_BUFFER_LENGTH 128
+
+class TwoWire : public Stream {
+public:
+    explicit TwoWire(uint8_t bus) : _bus(bus) {}
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+    bool setClock(uint32_t frequency);
+    uint32_t getClock() const { return _clockHz; }
+
+    void beginTransmission(uint16_t address);
+    void beginTransmission(int address) { beginTransmission((uint16_t)address); }
+    // 0 = ACK, 2 = address NACK, 4 = bus not started
+    uint8_t endTransmission(bool sendStop = true);
+
+    size_t requestFrom(uint16_t address, size_t size, bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t size) { return (uint8_t)requestFrom((uint16_t)address, (size_t)size); }
+    uint8_t requestFrom(int address, int size) { return (uint8_t)requestFrom((uint16_t)address, (size_t)size); }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+
+    int available() override { return (int)(_rxLength - _rxIndex); }
+    int read() override { return _rxIndex < _rxLength ? _rx[_rxIndex++] : -1; }
+    int peek() override { return _rxIndex < _rxLength ? _rx[_rxIndex] : -1; }
+
+private:
+    uint8_t _bus;
+    int _sda = -1;
+    uint32_t _clockHz = 100000;
+    bool _started = false;
+
+    uint16_t _txAddress = 0;
+    uint8_t _tx[I2C_BUFFER_LENGTH];
+    size_t _txLength = 0;
+    bool _transmitting = false;
+    bool _held = false;           // endTransmission(false) pending
+
+    uint8_t _rx[I2C_BUFFER_LENGTH];
+    size_t _rxLength = 0;
+    size_t _rxIndex = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // KVN_HAL_WIRE_H
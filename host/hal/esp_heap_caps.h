@@ -0,0 +1,58 @@
+/*
+ * esp_heap_caps.h - Host stand-in for the ESP-IDF capability heap
+ *
+ * One heap: every capability, PSRAM included, is plain malloc(), so
+ * allocation counters hooked on malloc see all of it.
+ */
+
+#ifndef KVN_HAL_ESP_HEAP_CAPS_H
+#define KVN_HAL_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC     (1 << 0)
+#define MALLOC_CAP_32BIT    (1 << 1)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT  (1 << 12)
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    (void)caps;
+    return calloc(n, size);
+}
+
+inline void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+    (void)caps;
+    return realloc(ptr, size);
+}
+
+// The preferred capabilities are tried in order; on the host the first one always succeeds
+inline void* heap_caps_malloc_prefer(size_t size, size_t num, ...) {
+    (void)num;
+    return malloc(size);
+}
+
+inline void* heap_caps_calloc_prefer(size_t n, size_t size, size_t num, ...) {
+    (void)num;
+    return calloc(n, size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+    return 8 * 1024 * 1024;
+}
+
+#endif // KVN_HAL_ESP_HEAP_CAPS_H
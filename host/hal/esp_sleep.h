@@ -0,0 +1,38 @@
+/*
+ * esp_sleep.h - Host stand-in for the ESP-IDF deep sleep API
+ *
+ * esp_deep_sleep_start() does not return: it unwinds the sketch and the
+ * simulator restarts it from setup() when a wake source fires.
+ */
+
+#ifndef KVN_HAL_ESP_SLEEP_H
+#define KVN_HAL_ESP_SLEEP_H
+
+#include <stdint.h>
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER,
+    ESP_SLEEP_WAKEUP_TOUCHPAD,
+    ESP_SLEEP_WAKEUP_ULP,
+    ESP_SLEEP_WAKEUP_GPIO,
+    ESP_SLEEP_WAKEUP_UART
+} esp_sleep_wakeup_cause_t;
+
+typedef enum {
+    ESP_GPIO_WAKEUP_GPIO_LOW = 0,
+    ESP_GPIO_WAKEUP_GPIO_HIGH = 1
+} esp_deepsleep_gpio_wake_up_mode_t;
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t timeUs);
+esp_err_t esp_deep_sleep_enable_gpio_wakeup(uint64_t gpioMask, esp_deepsleep_gpio_wake_up_mode_t mode);
+[[noreturn]] void esp_deep_sleep_start();
+
+#endif // KVN_HAL_ESP_SLEEP_H
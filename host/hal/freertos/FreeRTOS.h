@@ -0,0 +1,28 @@
+/*
+ * FreeRTOS.h - Host stand-in for the ESP-IDF FreeRTOS kernel
+ *
+ * Tasks are host threads (task.h, FreeRTOS.cpp); one tick is 1 ms.
+ */
+
+#ifndef KVN_HAL_FREERTOS_H
+#define KVN_HAL_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  0
+#define pdPASS  1
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY      ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+
+#define tskNO_AFFINITY 0x7fffffff
+
+#endif // KVN_HAL_FREERTOS_H
@@ -0,0 +1,62 @@
+/*
+ * task.h - Host stand-in for FreeRTOS tasks and task notifications
+ *
+ * Outside a device (World::onHost()) each task is a host thread, so the
+ * hub's task split, its SPSC queues and its notifications run truly in
+ * parallel, as on the two cores. Priorities and core pinning are kept
+ * but not enforced: the host scheduler decides. Inside a simulated
+ * device there are no threads and xTaskCreate*() fails.
+ *
+ * vTaskDelete(nullptr) ends the calling task and vTaskSuspend(nullptr)
+ * parks it for good; acting on another task is not supported. Reading a
+ * deleted task's stack high water mark aborts: on the device that handle
+ * points at a freed TCB.
+ */
+
+#ifndef KVN_HAL_FREERTOS_TASK_H
+#define KVN_HAL_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+struct tskTaskControlBlock;
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum {
+    eNoAction,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char* name, uint32_t stackDepth,
+                                   void* param, UBaseType_t priority, TaskHandle_t* created,
+                                   BaseType_t core);
+inline BaseType_t xTaskCreate(TaskFunction_t code, const char* name, uint32_t stackDepth,
+                              void* param, UBaseType_t priority, TaskHandle_t* created) {
+    return xTaskCreatePinnedToCore(code, name, stackDepth, param, priority, created, tskNO_AFFINITY);
+}
+void vTaskDelete(TaskHandle_t task);
+void vTaskSuspend(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+TaskHandle_t xTaskGetHandle(const char* name);
+// Host threads have no fixed stack: the depth the task was created with
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value, eNotifyAction action,
+                              BaseType_t* higherPriorityTaskWoken);
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit, uint32_t* value,
+                           TickType_t ticksToWait);
+
+// Host only: times the task came back from vTaskDelay() or a notification
+// wait, for tests that check a task sleeps until it has work
+uint32_t kvnTaskWakes(TaskHandle_t task);
+
+#endif // KVN_HAL_FREERTOS_TASK_H
@@ -0,0 +1,172 @@
+/*
+ * house.cpp - Relay, hub, watchtower and scout on one simulated network
+ *
+ * All four sketches run against the same access point and broker. On
+ * every simulated day the access point goes down at 10:00 for 2 minutes
+ * and the broker at 14:00 for 5 minutes. The report shows how long each
+ * always-on device took to announce itself online again after each
+ * outage, plus the relay's stats and the hub's AI context traffic. The
+ * run fails if a board is not back within the limit for its outage:
+ * about 1.5 s after the AP, but reconnect backoff after the broker.
+ *
+ * --record writes what the hub, watchtower and scout published as a
+ * message trace (scenario.h), the input of kvn_sim_relay_trace.
+ */
+
+#include "kvn_sim.h"
+#include "scenario.h"
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define AP_OUTAGE_AT_H       10
+#define AP_OUTAGE_MIN        2
+#define BROKER_OUTAGE_AT_H   14
+#define BROKER_OUTAGE_MIN    5
+
+// Worst time back online before the run fails
+#define POWER_ON_MAX_S       10
+#define AP_BACK_MAX_S        5
+#define BROKER_BACK_MAX_S    60
+
+struct Watched {
+    const char* name;
+    const char* statusTopic;   // Published "online" on every connect
+    std::vector<uint64_t> online;
+};
+
+// False if a board was not back within `maxS`
+static bool printRecovery(const char* label, uint64_t end, double maxS, std::vector<Watched>& watched) {
+    bool ok = true;
+    printf("%-22s", label);
+    for (auto& w : watched) {
+        uint64_t back = 0;
+        for (uint64_t t : w.online) {
+            if (t >= end) {
+                back = t;
+                break;
+            }
+        }
+        if (back) printf(" %10s %6.1f s", w.name, seconds(back - end));
+        else printf(" %10s  never", w.name);
+        if (!back || seconds(back - end) > maxS) ok = false;
+    }
+    printf("\n");
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    ScenarioOptions opt = parseOptions(argc, argv, 1, "[--days N] [--seed N] [--verbose] [--record <trace>]");
+
+    World world(opt.seed);
+    world.setVerbose(opt.verbose);
+
+    Device& relay = world.add(sketch_relay, "relay");
+    Device& hub = world.add(sketch_hub_ldr, "hub");
+    Device& tower = world.add(sketch_watchtower, "watchtower");
+    Device& scout = world.add(sketch_scout_ldr, "scout1");
+
+    relay.setAnalog(0, [](uint64_t us) { return adcForLux(roomLux(us, 0, true)); });
+    hub.setAnalog(1, [](uint64_t us) { return adcForLux(roomLux(us, 1, true)); });
+    tower.setAnalog(1, [](uint64_t us) { return adcForLux(roomLux(us, 2, true)); });
+    scout.setAnalog(0, [](uint64_t us) { return adcForLux(roomLux(us, 3, false)); });
+    scout.setPower({0.06f, 22.0f, 85.0f});
+
+    // Power-on is staggered by a few seconds, as after a mains cut
+    hub.startAt(1500000);
+    tower.startAt(3200000);
+    scout.startAt(4700000);
+
+    std::vector<std::pair<uint64_t, uint64_t>> apOutages, brokerOutages;
+    for (uint32_t day = 0; day < opt.days; day++) {
+        uint64_t ap = daysUs(day) + hoursUs(AP_OUTAGE_AT_H);
+        uint64_t mq = daysUs(day) + hoursUs(BROKER_OUTAGE_AT_H);
+        apOutages.push_back({ap, ap + minutesUs(AP_OUTAGE_MIN)});
+        brokerOutages.push_back({mq, mq + minutesUs(BROKER_OUTAGE_MIN)});
+        world.apOutage(ap, ap + minutesUs(AP_OUTAGE_MIN));
+        world.broker().outage(mq, mq + minutesUs(BROKER_OUTAGE_MIN));
+    }
+
+    std::vector<Watched> watched = {
+        {"relay", "vanguard/relay/status", {}},
+        {"hub", "vanguard/hub/status", {}},
+        {"watchtower", "homeassistant/sensor/esp32_s3_node1/status", {}},
+    };
+    std::map<std::string, uint32_t> perPrefix;
+    std::string relayStats;
+    uint32_t contextDocs = 0;
+    size_t contextBytes = 0;
+    std::vector<TraceMessage> trace;
+
+    world.broker().tap([&](const SimMessage& m) {
+        for (auto& w : watched) {
+            if (m.topic == w.statusTopic && m.payload == "online") w.online.push_back(m.at);
+        }
+        size_t slash = m.topic.find('/', m.topic.find('/') + 1);
+        perPrefix[m.topic.substr(0, slash)]++;
+
+        if (m.topic == "vanguard/relay/stats") relayStats = m.payload;
+        if (m.topic == "vanguard/ai/context/light") {
+            contextDocs++;
+            contextBytes += m.payload.size();
+        }
+        // Everything but the relay's own traffic
+        if (!opt.record.empty() && m.topic.compare(0, 15, "vanguard/relay/") != 0) {
+            trace.push_back({m.topic, m.payload});
+        }
+    });
+
+    world.run(daysUs(opt.days));
+
+    printf("\n=== House, %.0f day(s): AP down %02d:00 +%d min, broker down %02d:00 +%d min ===\n",
+           opt.days, AP_OUTAGE_AT_H, AP_OUTAGE_MIN, BROKER_OUTAGE_AT_H, BROKER_OUTAGE_MIN);
+
+    // Outages that end after the run have nothing to report
+    uint64_t runEnd = daysUs(opt.days);
+    bool recovered = true;
+    printf("\nBack online after:\n");
+    recovered &= printRecovery("power-on", 0, POWER_ON_MAX_S, watched);
+    for (size_t i = 0; i < apOutages.size(); i++) {
+        char label[48];
+        snprintf(label, sizeof(label), "day %zu AP outage", i + 1);
+        if (apOutages[i].second < runEnd) {
+            recovered &= printRecovery(label, apOutages[i].second, AP_BACK_MAX_S, watched);
+        }
+        snprintf(label, sizeof(label), "day %zu broker outage", i + 1);
+        if (brokerOutages[i].second < runEnd) {
+            recovered &= printRecovery(label, brokerOutages[i].second, BROKER_BACK_MAX_S, watched);
+        }
+    }
+
+    printf("\n%-12s %6s %7s %8s %8s %8s\n", "device", "boots", "joins", "drops", "connects", "failed");
+    for (Device* d : {&relay, &hub, &tower, &scout}) {
+        printf("%-12s %6u %7u %8u %8u %8u\n", d->name(), d->boots(), d->wifiJoins(), d->linkDrops(),
+               d->mqttConnects(), d->mqttConnectFailures());
+    }
+
+    printf("\nPublished by topic prefix:\n");
+    for (const auto& p : perPrefix) printf("  %-32s %8u\n", p.first.c_str(), p.second);
+
+    printf("\nrelay stats   %s\n", relayStats.c_str());
+    printf("AI context    %u documents, %zu bytes\n", contextDocs, contextBytes);
+    printf("scout charge  %.2f mAh over %u wakes\n", scout.chargeMah(), scout.boots());
+    printf("broker        %llu published, %llu delivered, %llu dropped, %zu retained\n",
+           (unsigned long long)world.broker().published(), (unsigned long long)world.broker().delivered(),
+           (unsigned long long)world.broker().dropped(), world.broker().retainedCount());
+
+    if (!opt.record.empty()) {
+        if (!writeTrace(opt.record, trace)) {
+            fprintf(stderr, "cannot write %s\n", opt.record.c_str());
+            return 1;
+        }
+        printf("trace         %zu messages -> %s\n", trace.size(), opt.record.c_str());
+    }
+    if (!recovered) {
+        printf("FAIL: a board was not back online within %d s of power-on, %d s of the AP or %d s of the broker\n",
+               POWER_ON_MAX_S, AP_BACK_MAX_S, BROKER_BACK_MAX_S);
+    }
+    return recovered ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/*
+ * relay_throughput.cpp - How many messages a second the relay keeps up with
+ *
+ * Once the relay is connected, a load generator publishes lux readings
+ * from 200 simulated devices at a rate that steps up every 20 simulated
+ * seconds. For each step the report shows what the relay consumed, the
+ * backlog left in its broker queue and any messages the broker dropped
+ * because that queue was full (max_queued_messages, 1000).
+ *
+ * Half the load goes to homeassistant/sensor/ (counted only), half to
+ * vanguard/raw/ (coalesced and forwarded). The relay's forwards come back
+ * through its own wildcard; they are counted apart from the load.
+ *
+ * On top of the load, 4 probe sources send KVN_Probe messages at 10/s in
+ * total. The relay's own collector reports latency percentiles and loss
+ * every 10 s on vanguard/relay/probe; each step shows the last report
+ * whose window lies entirely inside it. --json writes every step, with
+ * that report verbatim, as a machine-readable report.
+ *
+ * The relay falls behind at the first step with no probe report, probe
+ * loss, or a p99 above MAX_P99_MS: the rule tools/probe_load.py applies
+ * on hardware, where what the relay consumed cannot be told from its own
+ * forwards. The run fails if that happens at KNEE_FLOOR msg/s or below.
+ */
+
+#include "kvn_sim.h"
+#include "scenario.h"
+#include <KVN_Probe.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define LOAD_DEVICES     200
+#define PROBE_SOURCES    4
+#define PROBE_RATE       10      // Probes per second, all sources together
+#define PROBE_PAD        32      // Bytes per probe payload, like a small reading
+#define WARMUP_S         15
+#define STEP_S           20
+#define MAX_P99_MS       1000
+#define KNEE_FLOOR       50      // Must keep up at this rate (falls behind at 100)
+
+static const uint32_t RATES[] = {5, 10, 20, 50, 100, 200, 500, 1000};
+
+struct Step {
+    uint32_t offered;
+    uint32_t injected;
+    uint32_t consumed;
+    uint32_t echoes;
+    size_t backlog;
+    uint32_t dropped;
+    std::string probe;     // The relay's report, JSON
+};
+
+static bool writeReport(const std::string& path, const ScenarioOptions& opt, const std::vector<Step>& steps,
+                        uint32_t knee, uint64_t uartBytes) {
+    FILE* f = fopen(path.c_str(), "w");
+    if (f == nullptr) return false;
+
+    fprintf(f, "{\"scenario\":\"relay_throughput\",\"source\":\"simulator\",\"seed\":%u,\"step_s\":%u,"
+               "\"devices\":%u,\"probe_rate\":%u,\"max_p99_ms\":%u,\"knee\":%u,\"uart_bytes\":%llu,\"steps\":[",
+            opt.seed, STEP_S, LOAD_DEVICES, PROBE_RATE, MAX_P99_MS, knee, (unsigned long long)uartBytes);
+    for (size_t i = 0; i < steps.size(); i++) {
+        const Step& s = steps[i];
+        fprintf(f, "%s\n{\"offered\":%u,\"injected\":%u,\"consumed\":%u,\"echoes\":%u,\"backlog\":%zu,"
+                   "\"dropped\":%u,\"probe\":%s}",
+                i ? "," : "", s.offered, s.injected, s.consumed, s.echoes, s.backlog, s.dropped,
+                s.probe.empty() ? "null" : s.probe.c_str());
+    }
+    fprintf(f, "]}\n");
+    return fclose(f) == 0;
+}
+
+int main(int argc, char** argv) {
+    ScenarioOptions opt = parseOptions(argc, argv, 1, "[--seed N] [--verbose] [--json <report>]");
+
+    World world(opt.seed);
+    world.setVerbose(opt.verbose);
+    Device& relay = world.add(sketch_relay, "relay");
+    relay.setAnalog(0, [](uint64_t) { return (uint16_t)2000; });
+
+    uint32_t rate = 0;
+    uint64_t nextAt = SIM_NEVER;
+    uint64_t nextProbeAt = SIM_NEVER;
+    uint32_t sent = 0, probesSent = 0;
+    uint32_t probeSeq[PROBE_SOURCES] = {};
+
+    // Publishes everything due up to the relay's clock
+    world.onStep([&](uint64_t now) {
+        while (nextAt <= now || nextProbeAt <= now) {
+            char topic[64], payload[48];
+            if (nextProbeAt <= nextAt) {
+                // Stamped with the publish time on the shared simulated clock
+                uint32_t source = probesSent % PROBE_SOURCES;
+                snprintf(topic, sizeof(topic), KVN_PROBE_TOPIC_PREFIX "probe_%u", source);
+                KVN_Probe::format(payload, sizeof(payload), probeSeq[source]++, SIM_EPOCH_US + nextProbeAt,
+                                  PROBE_PAD);
+                world.broker().publish(topic, payload, false, nextProbeAt);
+                probesSent++;
+                nextProbeAt += 1000000 / PROBE_RATE;
+                continue;
+            }
+
+            uint32_t device = sent % LOAD_DEVICES;
+            snprintf(topic, sizeof(topic), device & 1 ? "vanguard/raw/raw_%u/lux" : "homeassistant/sensor/ha_%u/lux",
+                     device);
+            snprintf(payload, sizeof(payload), "%u", 100 + scenarioHash(sent) % 400);
+            world.broker().publish(topic, payload, false, nextAt);
+            sent++;
+            nextAt += 1000000 / rate;
+        }
+    });
+
+    // Load taken off the relay's queue, and its own forwards coming back
+    uint32_t consumedLoad = 0, echoes = 0;
+    world.broker().onReceive([&](const Broker::Session&, const SimMessage& m, uint64_t) {
+        if (m.topic.compare(0, 13, "vanguard/raw/") == 0 || m.topic.find("/ha_") != std::string::npos) {
+            consumedLoad++;
+        } else if (m.topic.find("/raw_") != std::string::npos) {
+            echoes++;
+        }
+    });
+
+    // The relay's collector reports, with their publish times
+    std::vector<std::pair<uint64_t, std::string>> reports;
+    world.broker().tap([&](const SimMessage& m) {
+        if (m.topic == "vanguard/relay/probe") reports.push_back({m.at, m.payload});
+    });
+
+    world.run(WARMUP_S * 1000000ULL);
+    Broker::Session* session = world.broker().session("kvn_relay_c6");
+    if (session == nullptr || !session->connected) {
+        printf("relay did not connect within %d s\n", WARMUP_S);
+        return 1;
+    }
+
+    printf("\n=== Relay throughput, %u s per step, %u devices, %u probes/s ===\n", STEP_S, LOAD_DEVICES,
+           PROBE_RATE);
+    printf("%8s %10s %10s %8s %8s %8s %8s %8s %8s %6s %8s\n", "offered", "injected", "consumed", "msg/s",
+           "echoes", "backlog", "dropped", "p50 ms", "p99 ms", "lost", "loop ms");
+
+    std::vector<Step> steps;
+    uint32_t knee = 0;
+    uint64_t at = world.now();
+    nextProbeAt = at;
+    for (uint32_t r : RATES) {
+        uint32_t sentBefore = sent;
+        uint32_t consumedBefore = consumedLoad;
+        uint32_t echoesBefore = echoes;
+        uint32_t droppedBefore = session->dropped;
+        uint64_t stepStart = at;
+
+        rate = r;
+        nextAt = at;
+        at += STEP_S * 1000000ULL;
+        world.run(at);
+        nextAt = SIM_NEVER;
+
+        Step s = {r, sent - sentBefore, consumedLoad - consumedBefore, echoes - echoesBefore,
+                  session->inbox.size(), session->dropped - droppedBefore, ""};
+
+        // Last report whose whole window fell inside this step
+        for (const auto& report : reports) {
+            uint64_t window = jsonUInt(report.second, "window_ms") * 1000;
+            if (report.first <= at && report.first >= stepStart + window) s.probe = report.second;
+        }
+
+        printf("%8u %10u %10u %8.1f %8u %8zu %8u", r, s.injected, s.consumed, (double)s.consumed / STEP_S,
+               s.echoes, s.backlog, s.dropped);
+        if (s.probe.empty()) {
+            printf(" %8s %8s %6s %8s\n", "-", "-", "-", "-");
+        } else {
+            printf(" %8.1f %8.1f %6llu %8.1f\n", jsonUInt(s.probe, "p50_us") / 1000.0,
+                   jsonUInt(s.probe, "p99_us") / 1000.0, (unsigned long long)jsonUInt(s.probe, "lost"),
+                   jsonUInt(s.probe, "loop_max_us") / 1000.0);
+        }
+        steps.push_back(s);
+
+        bool behind = s.probe.empty() || jsonUInt(s.probe, "lost") > 0 ||
+                      jsonUInt(s.probe, "p99_us") > MAX_P99_MS * 1000ULL;
+        if (!knee && behind) knee = r;
+    }
+
+    if (knee) printf("Falls behind at %u msg/s offered\n", knee);
+    else printf("Kept up with every step\n");
+    printf("Relay UART: %llu bytes logged\n", (unsigned long long)relay.uartBytes());
+
+    if (!opt.json.empty()) {
+        if (!writeReport(opt.json, opt, steps, knee, relay.uartBytes())) {
+            fprintf(stderr, "could not write %s\n", opt.json.c_str());
+            return 1;
+        }
+        printf("Report: %s\n", opt.json.c_str());
+    }
+
+    if (knee && knee <= KNEE_FLOOR) {
+        printf("FAIL: fell behind at %u msg/s, expected to keep up with %u\n", knee, KNEE_FLOOR);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * relay_trace.cpp - The relay's MQTT ingest path on a recorded trace
+ *
+ * Once the relay is connected, a message trace is published to its
+ * broker queue as one burst, and the relay drains it at its own pace.
+ * The report shows how many messages a second it consumed (simulated
+ * C6 time) and what its MQTT callback cost on the heap: peak bytes in
+ * use and the number of allocations, which must be zero.
+ *
+ * The trace is `mosquitto_sub -v` output (scenario.h). The default,
+ * traces/house.txt, is six hours of what the hub, watchtower and scout
+ * sketches publish in kvn_sim_house (--record); --trace replays a
+ * capture from the real network the same way.
+ *
+ * malloc is replaced for the whole program (heap_meter.cpp), and counts
+ * only inside the relay's callback (kvn_sim::HeapMeter), without the simulator's own
+ * bookkeeping. kvn_sim_relay_trace_echo is the same relay built with
+ * MQTT_RX_ECHO=1. Exits with 1 if the callback allocated or the burst
+ * was not drained.
+ */
+
+#include "kvn_sim.h"
+#include "heap_meter.h"
+#include "scenario.h"
+#include "secrets.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define WARMUP_S     20
+#define DRAIN_MAX_S  600
+
+int main(int argc, char** argv) {
+    ScenarioOptions opt = parseOptions(argc, argv, 1, "[--seed N] [--verbose] [--trace <trace>]");
+    std::string path = opt.trace.empty() ? KVN_TRACE_DIR "/house.txt" : opt.trace;
+
+    std::vector<TraceMessage> trace;
+    if (!readTrace(path, trace) || trace.empty()) {
+        fprintf(stderr, "cannot read a trace from %s\n", path.c_str());
+        return 2;
+    }
+
+    World world(opt.seed);
+    world.setVerbose(opt.verbose);
+    Device& relay = world.add(sketch_relay, "relay");
+    relay.setAnalog(0, [](uint64_t) { return (uint16_t)2000; });
+    world.run((uint64_t)WARMUP_S * 1000000);
+
+    Broker& broker = world.broker();
+    Broker::Session* session = broker.session(MQTT_CLIENT_ID);
+    if (session == nullptr || !session->connected) {
+        fprintf(stderr, "relay not connected after %d s\n", WARMUP_S);
+        return 1;
+    }
+
+    // The whole trace at once; the relay's queue holds all of it
+    uint64_t burstAt = world.now();
+    size_t before = session->inbox.size();
+    broker.setMaxQueued(before + trace.size());
+    for (const TraceMessage& m : trace) broker.publish(m.topic, m.payload, false, burstAt);
+    size_t expected = session->inbox.size() - before;
+
+    uint32_t consumed = 0;
+    uint64_t lastAt = burstAt;
+    broker.onReceive([&](const Broker::Session& s, const SimMessage& m, uint64_t at) {
+        if (&s != session || m.at != burstAt) return;
+        consumed++;
+        lastAt = at;
+    });
+
+    heapMeter = {};
+    uint64_t serialBefore = relay.uartBytes();
+    uint64_t until = burstAt;
+    while (consumed < expected && until < burstAt + (uint64_t)DRAIN_MAX_S * 1000000) {
+        until += 1000000;
+        world.run(until);
+    }
+    double drainS = seconds(lastAt - burstAt);
+
+    printf("\n=== Relay ingest, %zu trace messages in one burst (%s) ===\n", trace.size(), path.c_str());
+    printf("subscribed    %zu of them\n", expected);
+    printf("consumed      %u in %.1f s: %.1f msg/s\n", consumed, drainS, drainS > 0 ? consumed / drainS : 0.0);
+    printf("serial        %llu bytes while draining\n", (unsigned long long)(relay.uartBytes() - serialBefore));
+#if KVN_HEAP_METER
+    printf("callback heap %zu bytes peak, %llu allocations\n", heapMeter.peak,
+           (unsigned long long)heapMeter.allocations);
+#else
+    printf("callback heap not metered under ASan\n");
+#endif
+
+    bool ok = consumed == expected && heapMeter.allocations == 0;
+    if (!ok) printf("FAIL: %s\n", consumed != expected ? "burst not drained" : "the callback allocated");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/*
+ * scenario.cpp - Implementation
+ */
+
+#include "scenario.h"
+#include <KVN_LDR.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+ScenarioOptions parseOptions(int argc, char** argv, double defaultDays, const char* usage) {
+    ScenarioOptions o = {defaultDays, 1, false, "", "", ""};
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--days") == 0 && hasValue) {
+            o.days = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+            o.seed = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--json") == 0 && hasValue) {
+            o.json = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && hasValue) {
+            o.record = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+            o.trace = argv[++i];
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            o.verbose = true;
+        } else {
+            fprintf(stderr, "usage: %s %s\n", argv[0], usage);
+            exit(2);
+        }
+    }
+    if (o.days <= 0) o.days = defaultDays;
+    return o;
+}
+
+uint32_t scenarioHash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352D;
+    x ^= x >> 15;
+    x *= 0x846CA68B;
+    x ^= x >> 16;
+    return x;
+}
+
+static int32_t ramp(uint32_t t, uint32_t t0, uint32_t t1, int32_t from, int32_t to) {
+    return from + (to - from) * (int32_t)(t - t0) / (int32_t)(t1 - t0);
+}
+
+uint16_t roomLux(uint64_t us, uint32_t room, bool indoor) {
+    const uint32_t H = 3600;
+    uint32_t day = (uint32_t)(us / 86400000000ULL);
+    uint32_t t = (uint32_t)(us / 1000000 % 86400);
+    int32_t peak = indoor ? 250 : 600;
+    int32_t lux;
+
+    if (t < 6 * H) {
+        lux = 2;
+    } else if (t < 8 * H) {
+        lux = ramp(t, 6 * H, 8 * H, 2, peak);                       // Sunrise
+    } else if (t < 18 * H) {
+        uint32_t block = day * 144 + t / 600 + room * 7919;          // 10 min cloud blocks
+        lux = peak + (int32_t)(scenarioHash(block) % peak) - peak / 2;
+    } else if (t < 20 * H) {
+        lux = ramp(t, 18 * H, 20 * H, peak, 5);                     // Sunset
+    } else {
+        lux = 2;
+    }
+
+    // Evening lamps
+    if (t >= 19 * H && t < 23 * H && lux < 150) lux = 150;
+
+    // Sensor noise, +-3 lux per minute
+    lux += (int32_t)(scenarioHash(day * 1440 + t / 60 + room * 104729 + 12345) % 7) - 3;
+    return lux < 0 ? 0 : lux;
+}
+
+uint16_t adcForLux(uint16_t lux) {
+    // luxFromADC() is monotonic: smallest count reading at least `lux`
+    uint16_t lo = 0, hi = 4095;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (KVN_LDR::luxFromADC(mid) < lux) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+uint64_t jsonUInt(const std::string& json, const char* key) {
+    std::string quoted = std::string("\"") + key + "\":";
+    size_t at = json.find(quoted);
+    if (at == std::string::npos) return 0;
+    return strtoull(json.c_str() + at + quoted.size(), nullptr, 10);
+}
+
+bool writeTrace(const std::string& path, const std::vector<TraceMessage>& trace) {
+    FILE* f = fopen(path.c_str(), "w");
+    if (f == nullptr) return false;
+    for (const TraceMessage& m : trace) {
+        fprintf(f, "%s ", m.topic.c_str());
+        for (char c : m.payload) {
+            if (c == '\n') fputs("\\n", f);
+            else if (c == '\\') fputs("\\\\", f);
+            else fputc(c, f);
+        }
+        fputc('\n', f);
+    }
+    return fclose(f) == 0;
+}
+
+bool readTrace(const std::string& path, std::vector<TraceMessage>& trace) {
+    FILE* f = fopen(path.c_str(), "r");
+    if (f == nullptr) return false;
+
+    char line[4096];
+    while (fgets(line, sizeof(line), f)) {
+        size_t len = strcspn(line, "\r\n");
+        line[len] = '\0';
+        char* space = strchr(line, ' ');
+        if (len == 0 || line[0] == '#') continue;
+        TraceMessage m = {space ? std::string(line, space - line) : std::string(line), ""};
+        for (const char* c = space ? space + 1 : ""; *c; c++) {
+            if (c[0] == '\\' && (c[1] == 'n' || c[1] == '\\')) {
+                m.payload += c[1] == 'n' ? '\n' : '\\';
+                c++;
+            } else {
+                m.payload += *c;
+            }
+        }
+        trace.push_back(m);
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+ * scenario.h - Shared inputs and options for the KVN simulator scenarios
+ *
+ * Light is modelled as sunrise/sunset ramps, 10 minute cloud blocks,
+ * evening lamps and a little sensor noise, and turned into ADC counts by
+ * inverting KVN_LDR::luxFromADC(), so the firmware reads back the
+ * intended lux.
+ */
+
+#ifndef KVN_SCENARIO_H
+#define KVN_SCENARIO_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct ScenarioOptions {
+    double days;
+    uint32_t seed;
+    bool verbose;
+    std::string json;      // Report path, empty = none
+    std::string record;    // Message trace to write, empty = none
+    std::string trace;     // Message trace to replay, empty = the scenario's default
+};
+
+// --days N --seed N --verbose --json <path> --record <path> --trace <path>;
+// exits with usage on anything else
+ScenarioOptions parseOptions(int argc, char** argv, double defaultDays, const char* usage);
+
+uint32_t scenarioHash(uint32_t x);
+
+// Lux at simulated time `us` (day 0 starts at midnight). `room` varies
+// the clouds and noise; indoor rooms get less daylight.
+uint16_t roomLux(uint64_t us, uint32_t room, bool indoor);
+
+// 12-bit ADC count the KVN_LDR curve maps to `lux`
+uint16_t adcForLux(uint16_t lux);
+
+// Unsigned number under "key" in a flat JSON object (a firmware report), or 0
+uint64_t jsonUInt(const std::string& json, const char* key);
+
+// Message traces as `mosquitto_sub -v` writes them: "<topic> <payload>"
+// per line, so a capture from the real network replays the same way.
+// Newlines and backslashes in a payload are written as \n and \\.
+struct TraceMessage {
+    std::string topic;
+    std::string payload;
+};
+bool writeTrace(const std::string& path, const std::vector<TraceMessage>& trace);
+bool readTrace(const std::string& path, std::vector<TraceMessage>& trace);
+
+#endif // KVN_SCENARIO_H
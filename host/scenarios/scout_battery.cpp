@@ -0,0 +1,185 @@
+/*
+ * scout_battery.cpp - Battery life of the C3 Scout under its real firmware
+ *
+ * Runs ESP32_C3_Scout_LDR.ino on a window light curve with a few PIR
+ * events a day, for --days of simulated time, and reports wakes, uplinks,
+ * radio time and charge. kvn_sim_scout_eager runs the same sketch built
+ * with WAKE_BATCH_SIZE=1 (uplink on every wake) for comparison.
+ *
+ * The same inputs then drive the fixed schedule the scout ran before
+ * WakeScheduler: by day, wake hourly and publish the light; by night,
+ * stay up 5 minutes with WiFi on watching the PIR, then sleep 5 minutes.
+ * It watched the PIR only at night, so it misses most of the events. The
+ * run fails unless the firmware beats it on radio time and charge without
+ * reporting less motion.
+ */
+
+#include "kvn_sim.h"
+#include "scenario.h"
+#include <KVN_LDR.h>
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include <stdio.h>
+
+using namespace kvn_sim;
+
+#define SCOUT_LDR_PIN      0
+#define SCOUT_PIR_PIN      2
+#define MOTION_PER_DAY     6       // PIR events, 07:00-23:00
+#define MOTION_HIGH_S      5
+#define BATTERY_MAH        1500.0
+
+// The fixed schedule, as the firmware had it
+#define FIXED_SLEEP_DAY_S     3600
+#define FIXED_SLEEP_NIGHT_S   300
+#define FIXED_AWAKE_MS        300000
+#define FIXED_DAY_ADC         1500
+#define FIXED_MOTION_HOLD_MS  10000
+#define FIXED_LIGHT_MIN_MS    60000
+
+// ESP32-C3: deep sleep incl. PIR and LDR divider, CPU awake, CPU + WiFi
+static const PowerModel C3_POWER = {0.06f, 22.0f, 85.0f};
+
+static WiFiClient fixedNet;
+static PubSubClient fixedMqtt(fixedNet);
+static KVN_LDR fixedLight(SCOUT_LDR_PIN);
+static uint32_t fixedLastMotion, fixedLastLight;
+
+[[noreturn]] static void fixedSleep(uint32_t s) {
+    fixedMqtt.disconnect();
+    WiFi.disconnect(true);
+    esp_sleep_enable_timer_wakeup((uint64_t)s * 1000000ULL);
+    esp_deep_sleep_start();
+}
+
+// Up to `tries` half-second polls for WiFi, then MQTT
+static bool fixedConnect(uint8_t tries) {
+    WiFi.begin("sim", "sim");
+    for (uint8_t i = 0; i < tries && WiFi.status() != WL_CONNECTED; i++) delay(500);
+    return WiFi.status() == WL_CONNECTED && fixedMqtt.connect("scout_fixed");
+}
+
+static void fixedPublishLight() {
+    char payload[12];
+    snprintf(payload, sizeof(payload), "%u", (unsigned)fixedLight.getLux());
+    fixedMqtt.publish("homeassistant/sensor/scout_fixed/lux", payload);
+    fixedLastLight = millis();
+}
+
+static void fixedSetup() {
+    pinMode(SCOUT_PIR_PIN, INPUT);
+    fixedLight.begin();
+    fixedLastMotion = 0;
+
+    bool day = fixedLight.isDay(FIXED_DAY_ADC);
+    if (fixedConnect(day ? 10 : 20)) {
+        fixedMqtt.publish("vanguard/scout/scout_fixed/status", "online");
+        fixedPublishLight();
+    }
+    if (day) fixedSleep(FIXED_SLEEP_DAY_S);
+}
+
+static void fixedLoop() {
+    fixedMqtt.loop();
+
+    if (digitalRead(SCOUT_PIR_PIN) == HIGH &&
+        (fixedLastMotion == 0 || millis() - fixedLastMotion > FIXED_MOTION_HOLD_MS)) {
+        fixedLastMotion = millis();
+        fixedMqtt.publish("vanguard/scout/scout_fixed/motion", "detected");
+    }
+    if (fixedLight.hasChanged(200) && millis() - fixedLastLight > FIXED_LIGHT_MIN_MS) fixedPublishLight();
+
+    if (fixedLight.isDay(FIXED_DAY_ADC)) fixedSleep(FIXED_SLEEP_DAY_S);
+    if (millis() > FIXED_AWAKE_MS) fixedSleep(FIXED_SLEEP_NIGHT_S);
+    delay(100);
+}
+
+static const Sketch fixedSketch = {"fixed schedule", fixedSetup, fixedLoop};
+
+struct ScoutRun {
+    uint32_t wakes;
+    uint32_t uplinks;
+    uint32_t motionSent;
+    uint32_t fastJoins;
+    uint32_t joins;
+    uint64_t radioUs;
+    uint64_t awakeUs;
+    double mah;
+};
+
+// One scout on the window curve with the PIR script; `uplinkTopic`
+// marks the messages counted as uplinks
+static ScoutRun runScout(const Sketch& sketch, const ScenarioOptions& opt, const char* uplinkTopic,
+                         uint32_t& motionEvents) {
+    World world(opt.seed);
+    world.setVerbose(opt.verbose);
+    Device& scout = world.add(sketch, "scout1");
+    scout.setPower(C3_POWER);
+    scout.setAnalog(SCOUT_LDR_PIN, [](uint64_t us) { return adcForLux(roomLux(us, 1, false)); });
+
+    motionEvents = 0;
+    for (uint32_t day = 0; day < opt.days; day++) {
+        for (uint32_t i = 0; i < MOTION_PER_DAY; i++) {
+            uint32_t t = 7 * 3600 + scenarioHash(opt.seed * 1000003 + day * 97 + i) % (16 * 3600);
+            uint64_t at = daysUs(day) + (uint64_t)t * 1000000;
+            scout.setDigital(SCOUT_PIR_PIN, at, 1);
+            scout.setDigital(SCOUT_PIR_PIN, at + MOTION_HIGH_S * 1000000ULL, 0);
+            motionEvents++;
+        }
+    }
+
+    ScoutRun run = {};
+    world.broker().tap([&](const SimMessage& m) {
+        if (m.topic.find(uplinkTopic) != std::string::npos) run.uplinks++;
+        if (m.topic.find("/motion") != std::string::npos) run.motionSent++;
+    });
+
+    world.run(daysUs(opt.days));
+
+    run.wakes = scout.boots();
+    run.fastJoins = scout.wifiFastJoins();
+    run.joins = scout.wifiJoins();
+    run.radioUs = scout.radioUs();
+    run.awakeUs = scout.awakeUs();
+    run.mah = scout.chargeMah();
+    return run;
+}
+
+static void printRun(const char* name, const ScoutRun& run, uint32_t motionEvents, double days) {
+    double perDay = run.mah / days;
+    printf("\n=== Scout battery (%s), %.0f days ===\n", name, days);
+    printf("wakes          %8u (%.1f/day)\n", run.wakes, run.wakes / days);
+    printf("uplinks        %8u (%.1f/day), %u fast joins, %u full scans\n",
+           run.uplinks, run.uplinks / days, run.fastJoins, run.joins - run.fastJoins);
+    printf("motion         %8u of %u events reported\n", run.motionSent, motionEvents);
+    printf("radio on       %8.1f s (%.1f s/day)\n", seconds(run.radioUs), seconds(run.radioUs) / days);
+    printf("awake          %8.1f s (%.1f s/day)\n", seconds(run.awakeUs), seconds(run.awakeUs) / days);
+    printf("charge         %8.2f mAh (%.3f mAh/day, %.1f uA average)\n",
+           run.mah, perDay, perDay / 24.0 * 1000.0);
+    printf("battery life   %8.0f days on %.0f mAh\n", perDay > 0 ? BATTERY_MAH / perDay : 0.0, BATTERY_MAH);
+}
+
+int main(int argc, char** argv) {
+    ScenarioOptions opt = parseOptions(argc, argv, 30, "[--days N] [--seed N] [--verbose]");
+
+    uint32_t motionEvents = 0;
+    ScoutRun scheduled = runScout(sketch_scout_ldr, opt, "/light_batch", motionEvents);
+    ScoutRun fixed = runScout(fixedSketch, opt, "/lux", motionEvents);
+
+    double days = opt.days;
+    printRun(sketch_scout_ldr.name, scheduled, motionEvents, days);
+    printRun(fixedSketch.name, fixed, motionEvents, days);
+
+    printf("\n%s against the fixed schedule: radio %.1f vs %.1f s/day, charge %.3f vs %.3f mAh/day\n",
+           sketch_scout_ldr.name, seconds(scheduled.radioUs) / days, seconds(fixed.radioUs) / days,
+           scheduled.mah / days, fixed.mah / days);
+
+    const char* worse = scheduled.radioUs >= fixed.radioUs ? "uses more radio time"
+                      : scheduled.mah >= fixed.mah             ? "uses more charge"
+                      : scheduled.motionSent < fixed.motionSent ? "reports less motion"
+                                                                : nullptr;
+    if (worse) printf("FAIL: WakeScheduler %s than the fixed schedule\n", worse);
+    bool ok = worse == nullptr;
+    return ok ? 0 : 1;
+}
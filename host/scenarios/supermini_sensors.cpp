@@ -0,0 +1,482 @@
+/*
+ * supermini_sensors.cpp - I2C cost of a SuperMini Scout report cycle
+ *
+ * Runs ESP32_C3_SuperMini_Scout.ino with four chips on its two buses:
+ *
+ *   SDA 8  SHT31 (0x44), BH1750 (0x23)
+ *   SDA 3  BME280 (0x76, datasheet calibration), an EEPROM (0x50, no driver)
+ *
+ * and, on the same chips, a copy of the sketch's previous loop: both
+ * buses scanned at 100 kHz every cycle (252 address probes), one
+ * discovery message per device found plus an uptime message, and no
+ * sensor read at all. For each build the report shows the I2C
+ * transactions, bus time, Serial time and MQTT messages per 10 s cycle,
+ * and how long the loop() pass that ran the cycle kept the CPU busy.
+ *
+ * Halfway through, the BME280 stops answering for three cycles (a
+ * brownout on the aux bus), which makes the poller rescan once and pick
+ * it up again. Three quarters through, the poller build is reset (a warm
+ * boot: RAM lost, the RTC sensor cache kept). The last telemetry frame is
+ * decoded and printed, so the driver arithmetic can be checked against
+ * the datasheet examples.
+ *
+ * The run fails if the poller's typical cycle takes more than one I2C
+ * transaction per device, the glitch does not cause exactly one rescan,
+ * the warm boot rescans or republishes discovery, or the BME280 pressure
+ * is not the datasheet's 1006.53 hPa.
+ */
+
+#include "kvn_sim.h"
+#include "scenario.h"
+#include "secrets.h"
+#include <KVN_Connection.h>
+#include <KVN_Telemetry.h>
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <Wire.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define SENSOR_SDA       8
+#define AUX_SDA          3
+#define CYCLE_S          10
+#define GLITCH_CYCLES    3
+#define DEVICES          4       // Chips on the two buses
+
+// ESP32-C3 always on: CPU awake, CPU + WiFi
+static const PowerModel C3_POWER = {0.06f, 22.0f, 85.0f};
+
+// ==================== CHIPS ====================
+
+// A chip that can be unplugged
+class SimChip : public I2CPeripheral {
+public:
+    bool present = true;
+};
+
+// Sensirion CRC-8
+static uint8_t crc8(const uint8_t* data) {
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < 2; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+    }
+    return crc;
+}
+
+static void putWord(uint8_t* out, uint16_t value) {
+    out[0] = value >> 8;
+    out[1] = value & 0xFF;
+    out[2] = crc8(out);
+}
+
+static float roomTemperature(uint64_t us) {
+    return 21.0f + 2.0f * sinf((float)(us % daysUs(1)) / daysUs(1) * 6.2832f);
+}
+
+class Sht31 : public SimChip {
+public:
+    bool write(const uint8_t* data, size_t length, uint64_t us) override {
+        if (!present) return false;
+        if (length == 0) return true;
+        if (length != 2) return false;
+        uint16_t command = data[0] << 8 | data[1];
+        if (command == 0x2130 && !_periodic) {
+            _periodic = true;
+            _firstResultAt = us + 1000000;
+        }
+        _command = command;
+        return true;
+    }
+
+    bool read(uint8_t* out, size_t length, uint64_t us) override {
+        if (!present) return false;
+        uint8_t word[6];
+        if (_command == 0xF32D) {
+            putWord(word, 0x8010);
+        } else if (_command == 0xE000 && _periodic && us >= _firstResultAt) {
+            putWord(word, (uint16_t)((roomTemperature(us) + 45.0f) / 175.0f * 65535.0f));
+            putWord(word + 3, (uint16_t)(0.45f * 65535.0f));
+        } else {
+            return false;   // Nothing to fetch: NACK
+        }
+        memcpy(out, word, length < 6 ? length : 6);
+        return true;
+    }
+
+private:
+    bool _periodic = false;
+    uint64_t _firstResultAt = 0;
+    uint16_t _command = 0;
+};
+
+// Register file with the BME280 datasheet example calibration (section 8.1)
+class Bme280 : public SimChip {
+public:
+    Bme280() {
+        memset(_regs, 0, sizeof(_regs));
+        const int16_t tp[12] = {27504, 26435, -1000, (int16_t)36477, -10685, 3024,
+                                2855, 140, -7, 15500, -14600, 6000};
+        for (int i = 0; i < 12; i++) {
+            _regs[0x88 + i * 2] = tp[i] & 0xFF;
+            _regs[0x89 + i * 2] = (uint16_t)tp[i] >> 8;
+        }
+        // Humidity: typical production values (the datasheet has no example)
+        int16_t h2 = 362, h4 = 313, h5 = 50;
+        _regs[0xA1] = 75;
+        _regs[0xE1] = h2 & 0xFF;
+        _regs[0xE2] = h2 >> 8;
+        _regs[0xE3] = 0;
+        _regs[0xE4] = h4 >> 4;
+        _regs[0xE5] = (h4 & 0x0F) | (h5 & 0x0F) << 4;
+        _regs[0xE6] = h5 >> 4;
+        _regs[0xE7] = 30;
+        _regs[0xD0] = 0x60;
+    }
+
+    bool write(const uint8_t* data, size_t length, uint64_t us) override {
+        (void)us;
+        if (!present) return false;
+        if (length == 0) return true;
+        // Register pointer, then (register, value) pairs
+        _pointer = data[0];
+        for (size_t i = 0; i + 1 < length; i += 2) _regs[data[i]] = data[i + 1];
+        return true;
+    }
+
+    bool read(uint8_t* out, size_t length, uint64_t us) override {
+        (void)us;
+        if (!present) return false;
+        sample();
+        for (size_t i = 0; i < length; i++) out[i] = _regs[(uint8_t)(_pointer + i)];
+        return true;
+    }
+
+private:
+    uint8_t _regs[256];
+    uint8_t _pointer = 0;
+
+    void sample() {
+        if ((_regs[0xF4] & 0x03) != 0x03) {
+            const uint8_t skipped[8] = {0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00};
+            memcpy(_regs + 0xF7, skipped, 8);
+            return;
+        }
+        // Datasheet example readings: 25.08 C, 1006.53 hPa
+        uint32_t adcP = 415148;
+        uint32_t adcT = 519888;
+        uint32_t adcH = 30000;
+        _regs[0xF7] = adcP >> 12;
+        _regs[0xF8] = adcP >> 4;
+        _regs[0xF9] = adcP << 4;
+        _regs[0xFA] = adcT >> 12;
+        _regs[0xFB] = adcT >> 4;
+        _regs[0xFC] = adcT << 4;
+        _regs[0xFD] = adcH >> 8;
+        _regs[0xFE] = adcH;
+    }
+};
+
+class Bh1750 : public SimChip {
+public:
+    bool write(const uint8_t* data, size_t length, uint64_t us) override {
+        (void)us;
+        if (!present) return false;
+        if (length == 0) return true;
+        if (length != 1) return false;
+        if (data[0] == 0x01) _on = true;
+        if (data[0] == 0x10 && _on) _continuous = true;
+        return true;
+    }
+
+    bool read(uint8_t* out, size_t length, uint64_t us) override {
+        if (!present || !_continuous || length != 2) return false;
+        uint16_t counts = (uint16_t)(roomLux(us, 1, true) * 1.2f);
+        out[0] = counts >> 8;
+        out[1] = counts & 0xFF;
+        return true;
+    }
+
+private:
+    bool _on = false;
+    bool _continuous = false;
+};
+
+// Answers anything, reads 0xFF
+class Eeprom : public SimChip {
+public:
+    bool write(const uint8_t*, size_t, uint64_t) override { return present; }
+    bool read(uint8_t* out, size_t length, uint64_t) override {
+        memset(out, 0xFF, length);
+        return present;
+    }
+};
+
+// ==================== PREVIOUS SKETCH ====================
+
+// The report cycle of ESP32_C3_SuperMini_Scout.ino before the poller
+// (radar left out: it is the same in both builds)
+namespace legacy {
+
+WiFiClient espClient;
+PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+String deviceId;
+String topicBase;
+
+TwoWire SensorBus = TwoWire(0);
+TwoWire AuxBus = TwoWire(1);
+
+void scanI2C(TwoWire& wirePort, String busName) {
+    byte error, address;
+    int nDevices = 0;
+
+    Serial.println("Scanning " + busName + "...");
+
+    for (address = 1; address < 127; address++) {
+        wirePort.beginTransmission(address);
+        error = wirePort.endTransmission();
+
+        if (error == 0) {
+            Serial.print("Device found at 0x");
+            if (address < 16) Serial.print("0");
+            Serial.println(address, HEX);
+            nDevices++;
+
+            if (mqtt.connected()) {
+                String payload = "{\"bus\":\"" + busName + "\",\"address\":\"0x" + String(address, HEX) + "\"}";
+                mqtt.publish((topicBase + "/discovery").c_str(), payload.c_str());
+            }
+        }
+    }
+    if (nDevices == 0)
+        Serial.println("No devices found.\n");
+    else
+        Serial.println("done\n");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    SensorBus.begin(8, 9, 100000);
+    AuxBus.begin(3, 4, 100000);
+    deviceId = "scout-c3-legacy";
+    topicBase = "vanguard/scout/" + deviceId;
+    mqtt.setServer(MQTT_BROKER, MQTT_PORT);
+    conn.setCleanSession(false);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, deviceId.c_str(), MQTT_USER, MQTT_PASS);
+}
+
+void loop() {
+    conn.tick();
+
+    static unsigned long lastMsg = 0;
+    unsigned long now = millis();
+    if (now - lastMsg > 10000) {
+        lastMsg = now;
+
+        digitalWrite(2, HIGH);
+        delay(50);
+        digitalWrite(2, LOW);
+
+        if (mqtt.connected()) {
+            String uptime = String(millis() / 1000);
+            mqtt.publish((topicBase + "/uptime").c_str(), uptime.c_str());
+        }
+
+        scanI2C(SensorBus, "PrimaryBus");
+        scanI2C(AuxBus, "AuxBus");
+    }
+}
+
+}  // namespace legacy
+
+static const Sketch sketch_supermini_legacy = {"supermini_legacy", legacy::setup, legacy::loop};
+
+// ==================== RUN ====================
+
+struct Cycle {
+    uint64_t transactions;
+    uint64_t busUs;
+    uint64_t passUs;        // The loop() pass that ran the cycle
+};
+
+struct Result {
+    const char* build;
+    uint32_t cycles;
+    I2CStats boot;          // setup(): scan + chip configuration
+    I2CStats run;           // Every report cycle after that
+    I2CStats warmBoot;      // setup() after the reset (poller only)
+    uint64_t uartBytes;
+    uint64_t cycleUs;       // loop() passes that ran a report cycle
+    Cycle median;           // Typical cycle (a rescan is the exception)
+    uint32_t messages;      // Sensor messages: telemetry, discovery, uptime
+    uint32_t rescans;       // Discovery messages after the first, before the reset
+    uint32_t warmDiscovery; // Discovery messages after the reset
+    std::string telemetry;  // Last frame, as JSON
+    std::string discovery;
+};
+
+// `glitch`: the BME280 outage and the reset (poller build only)
+static Result runBuild(const Sketch& sketch, const char* build, const ScenarioOptions& opt, bool glitch) {
+    Result r = {};
+    r.build = build;
+
+    World world(opt.seed);
+    world.setVerbose(opt.verbose);
+    Device& scout = world.add(sketch, "supermini");
+    scout.setPower(C3_POWER);
+
+    auto sht = std::make_shared<Sht31>();
+    auto bme = std::make_shared<Bme280>();
+    scout.attachI2C(SENSOR_SDA, 0x44, sht);
+    scout.attachI2C(SENSOR_SDA, 0x23, std::make_shared<Bh1750>());
+    scout.attachI2C(AUX_SDA, 0x76, bme);
+    scout.attachI2C(AUX_SDA, 0x50, std::make_shared<Eeprom>());
+
+    uint64_t endUs = daysUs(opt.days);
+    uint64_t glitchUs = endUs / 2;
+    uint64_t restartUs = endUs / 4 * 3;
+    if (glitch) scout.restartAt(restartUs);
+
+    uint32_t discoveries = 0;
+    world.broker().tap([&](const SimMessage& m) {
+        bool telemetry = m.topic.find("/telemetry") != std::string::npos;
+        bool discovery = m.topic.find("/discovery") != std::string::npos;
+        if (telemetry || discovery || m.topic.find("/uptime") != std::string::npos) r.messages++;
+        if (discovery) {
+            r.discovery = m.payload;
+            discoveries++;
+            if (m.at >= restartUs) r.warmDiscovery++;
+        }
+        if (telemetry) {
+            KVN_Telemetry frame;
+            char json[256];
+            if (frame.fromCBOR((const uint8_t*)m.payload.data(), m.payload.size()) && frame.toJSON(json, sizeof(json))) {
+                r.telemetry = json;
+            }
+        }
+    });
+
+    uint64_t prevUs = 0;
+    I2CStats prev = {};
+    uint32_t boots = 0;
+    std::vector<Cycle> cycles;
+    world.onStep([&](uint64_t now) {
+        if (glitch) bme->present = now < glitchUs || now >= glitchUs + GLITCH_CYCLES * CYCLE_S * 1000000ULL;
+
+        const I2CStats& i2c = scout.i2c();
+        if (boots == 0) {
+            r.boot = i2c;
+        } else if (scout.boots() != boots) {
+            r.warmBoot = {i2c.transactions - prev.transactions, i2c.nacks - prev.nacks, i2c.bytes - prev.bytes,
+                          i2c.busUs - prev.busUs};
+        } else if (i2c.transactions != prev.transactions) {
+            cycles.push_back({i2c.transactions - prev.transactions, i2c.busUs - prev.busUs, now - prevUs});
+            r.cycleUs += now - prevUs;
+            r.cycles++;
+        }
+        boots = scout.boots();
+        prev = i2c;
+        prevUs = now;
+    });
+
+    world.run(endUs);
+
+    const I2CStats& all = scout.i2c();
+    r.run = {all.transactions - r.boot.transactions - r.warmBoot.transactions,
+             all.nacks - r.boot.nacks - r.warmBoot.nacks, all.bytes - r.boot.bytes - r.warmBoot.bytes,
+             all.busUs - r.boot.busUs - r.warmBoot.busUs};
+    r.uartBytes = scout.uartBytes();
+    r.rescans = glitch && discoveries > r.warmDiscovery ? discoveries - r.warmDiscovery - 1 : 0;
+
+    if (!cycles.empty()) {
+        auto median = [&cycles](uint64_t Cycle::*field) {
+            std::vector<uint64_t> v;
+            for (const Cycle& c : cycles) v.push_back(c.*field);
+            std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+            return v[v.size() / 2];
+        };
+        r.median = {median(&Cycle::transactions), median(&Cycle::busUs), median(&Cycle::passUs)};
+    }
+    return r;
+}
+
+static double perCycle(uint64_t total, const Result& r) {
+    return r.cycles ? (double)total / r.cycles : 0.0;
+}
+
+static void printResult(const Result& r, uint32_t uartNs) {
+    printf("%-7s %5llu %8.2f %8.2f | %7.1f %8.2f %8.2f %6.2f | %4llu %7.1f\n", r.build,
+           (unsigned long long)r.median.transactions, r.median.busUs / 1000.0, r.median.passUs / 1000.0,
+           perCycle(r.run.transactions, r), perCycle(r.run.busUs, r) / 1000.0,
+           perCycle(r.uartBytes, r) * uartNs / 1e6, perCycle(r.messages, r),
+           (unsigned long long)r.boot.transactions, r.boot.busUs / 1000.0);
+}
+
+static bool writeReport(const std::string& path, const ScenarioOptions& opt, const Result* results, int count) {
+    FILE* f = fopen(path.c_str(), "w");
+    if (f == nullptr) return false;
+
+    fprintf(f, "{\"scenario\":\"supermini_sensors\",\"source\":\"simulator\",\"seed\":%u,\"cycle_s\":%u,\"builds\":[",
+            opt.seed, CYCLE_S);
+    for (int i = 0; i < count; i++) {
+        const Result& r = results[i];
+        fprintf(f, "%s\n{\"build\":\"%s\",\"cycles\":%u,\"boot_transactions\":%llu,\"boot_bus_us\":%llu,"
+                   "\"transactions\":%llu,\"nacks\":%llu,\"bytes\":%llu,\"bus_us\":%llu,\"uart_bytes\":%llu,"
+                   "\"cycle_us\":%llu,\"messages\":%u,\"rescans\":%u,\"median_transactions\":%llu,"
+                   "\"median_bus_us\":%llu,\"median_pass_us\":%llu}",
+                i ? "," : "", r.build, r.cycles, (unsigned long long)r.boot.transactions,
+                (unsigned long long)r.boot.busUs, (unsigned long long)r.run.transactions,
+                (unsigned long long)r.run.nacks, (unsigned long long)r.run.bytes, (unsigned long long)r.run.busUs,
+                (unsigned long long)r.uartBytes, (unsigned long long)r.cycleUs, r.messages, r.rescans,
+                (unsigned long long)r.median.transactions, (unsigned long long)r.median.busUs,
+                (unsigned long long)r.median.passUs);
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    ScenarioOptions opt = parseOptions(argc, argv, 10.0 / (24 * 60), "[--days N] [--seed N] [--verbose] [--json <path>]");
+
+    Result results[2] = {
+        runBuild(sketch_supermini_legacy, "scan", opt, false),
+        runBuild(sketch_supermini, "poller", opt, true),
+    };
+
+    uint32_t uartNs = World(opt.seed).cost().uartByteNs;
+    printf("\n=== SuperMini sensor cycle, %.0f min, every %u s ===\n", opt.days * 24 * 60, CYCLE_S);
+    printf("%-7s %-25s | %-33s | %s\n", "", "typical cycle", "mean per cycle", "setup()");
+    printf("%-7s %5s %8s %8s | %7s %8s %8s %6s | %4s %7s\n", "build", "txn", "i2c ms", "pass ms", "txn",
+           "i2c ms", "uart ms", "msgs", "txn", "i2c ms");
+    for (const Result& r : results) printResult(r, uartNs);
+
+    const Result& poller = results[1];
+    printf("\npoller rescans %u (BME280 out for %u cycles)\n", poller.rescans, GLITCH_CYCLES);
+    printf("warm boot      %llu I2C transactions (cold %llu), %u discovery messages after it\n",
+           (unsigned long long)poller.warmBoot.transactions, (unsigned long long)poller.boot.transactions,
+           poller.warmDiscovery);
+    printf("discovery      %s\n", poller.discovery.c_str());
+    printf("telemetry      %s\n", poller.telemetry.c_str());
+
+    if (!opt.json.empty() && !writeReport(opt.json, opt, results, 2)) {
+        fprintf(stderr, "cannot write %s\n", opt.json.c_str());
+        return 1;
+    }
+
+    const char* fail = poller.median.transactions > DEVICES ? "more than one I2C transaction per device per cycle"
+                     : poller.rescans != 1 ? "the BME280 glitch did not cause exactly one rescan"
+                     : poller.warmBoot.transactions > DEVICES ? "the warm boot rescanned the buses"
+                     : poller.warmDiscovery > 0 ? "the warm boot republished discovery"
+                     : poller.telemetry.find("\"pressure\":1006.53") == std::string::npos
+                         ? "BME280 pressure is not the datasheet's 1006.53 hPa"
+                         : nullptr;
+    if (fail) printf("FAIL: %s\n", fail);
+    return fail ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * secrets.h - Network settings for the host simulator
+ *
+ * Stands in for the per-device secrets.h the firmware is built with.
+ * Nothing here reaches a real network: WiFi and MQTT are simulated.
+ */
+
+#ifndef KVN_HOST_SECRETS_H
+#define KVN_HOST_SECRETS_H
+
+#define WIFI_SSID        "kvn-sim"
+#define WIFI_PASSWORD    "kvn-sim"
+
+#define MQTT_BROKER      "192.168.86.10"
+#define MQTT_PORT        1883
+#define MQTT_USER        "kvn"
+#define MQTT_PASS        "kvn"
+#define MQTT_CLIENT_ID   "kvn_relay_c6"
+#define MQTT_SERVER      MQTT_BROKER     // P4 hub names
+#define MQTT_PASSWORD    MQTT_PASS
+
+#define ANTHROPIC_API_KEY "kvn-sim"
+
+#define RELAY_STATIC_IP  IPAddress(192, 168, 86, 50)
+#define GATEWAY_IP       IPAddress(192, 168, 86, 1)
+#define SUBNET_MASK      IPAddress(255, 255, 255, 0)
+#define DNS_PRIMARY      IPAddress(192, 168, 86, 1)
+
+#endif // KVN_HOST_SECRETS_H
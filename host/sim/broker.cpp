@@ -0,0 +1,192 @@
+/*
+ * broker.cpp - Implementation
+ */
+
+#include "broker.h"
+
+namespace kvn_sim {
+
+Broker::Broker() {
+    _maxQueued = 1000;   // mosquitto default
+    _published = 0;
+    _delivered = 0;
+    _dropped = 0;
+}
+
+bool Broker::up(uint64_t at) const {
+    for (const auto& o : _outages) {
+        if (at >= o.first && at < o.second) return false;
+    }
+    return true;
+}
+
+bool Broker::matches(const std::string& filter, const std::string& topic) {
+    size_t f = 0, t = 0;
+    while (true) {
+        size_t fEnd = filter.find('/', f);
+        if (fEnd == std::string::npos) fEnd = filter.size();
+        size_t tEnd = topic.find('/', t);
+        if (tEnd == std::string::npos) tEnd = topic.size();
+
+        if (filter.compare(f, fEnd - f, "#") == 0) return true;
+        bool plus = filter.compare(f, fEnd - f, "+") == 0;
+        if (!plus && filter.compare(f, fEnd - f, topic, t, tEnd - t) != 0) return false;
+
+        bool filterDone = fEnd == filter.size();
+        bool topicDone = tEnd == topic.size();
+        if (filterDone || topicDone) {
+            // "a/#" also matches "a"
+            return filterDone == topicDone || (topicDone && filter.compare(fEnd, std::string::npos, "/#") == 0);
+        }
+        f = fEnd + 1;
+        t = tEnd + 1;
+    }
+}
+
+Broker::Session* Broker::session(const std::string& clientId) {
+    auto it = _sessions.find(clientId);
+    return it == _sessions.end() ? nullptr : it->second.get();
+}
+
+void Broker::dropSession(Session& s, uint64_t at) {
+    if (s.connected && s.hasWill) {
+        s.hasWill = false;
+        publish(s.will.topic, s.will.payload, s.will.retained, at);
+    }
+    s.connected = false;
+    if (s.clean) {
+        s.filters.clear();
+        s.inbox.clear();
+    }
+}
+
+Broker::Session* Broker::connect(const std::string& clientId, bool clean, const SimMessage* will,
+                                 uint64_t at) {
+    if (!up(at)) return nullptr;
+
+    std::unique_ptr<Session>& slot = _sessions[clientId];
+    if (!slot) {
+        slot.reset(new Session());
+        slot->clientId = clientId;
+        slot->received = 0;
+        slot->dropped = 0;
+        slot->maxBacklog = 0;
+    } else if (alive(slot.get(), at)) {
+        // Same client ID taking over: the old connection is closed
+        dropSession(*slot, at);
+    }
+
+    Session& s = *slot;
+    if (clean) {
+        s.filters.clear();
+        s.inbox.clear();
+    }
+    s.connected = true;
+    s.clean = clean;
+    s.connectedAt = at;
+    s.hasWill = will != nullptr;
+    if (will) s.will = *will;
+    return &s;
+}
+
+bool Broker::alive(Session* s, uint64_t at) {
+    if (s == nullptr || !s->connected) return false;
+    for (const auto& o : _outages) {
+        if (o.first > s->connectedAt && o.first <= at) {
+            // Dropped by the outage; the will goes nowhere while it is down
+            s->hasWill = false;
+            dropSession(*s, at);
+            return false;
+        }
+    }
+    return up(at);
+}
+
+void Broker::disconnect(Session* s, bool graceful, uint64_t at) {
+    if (s == nullptr || !s->connected) return;
+    if (graceful) s->hasWill = false;
+    dropSession(*s, at);
+}
+
+void Broker::subscribe(Session* s, const std::string& filter, uint64_t at) {
+    if (s == nullptr) return;
+    for (const auto& f : s->filters) {
+        if (f == filter) return;
+    }
+    s->filters.push_back(filter);
+
+    for (const auto& r : _retained) {
+        if (matches(filter, r.first)) {
+            SimMessage msg = r.second;
+            msg.at = at > msg.at ? at : msg.at;
+            enqueue(*s, msg);
+        }
+    }
+}
+
+void Broker::unsubscribe(Session* s, const std::string& filter) {
+    if (s == nullptr) return;
+    for (size_t i = 0; i < s->filters.size(); i++) {
+        if (s->filters[i] == filter) {
+            s->filters.erase(s->filters.begin() + i);
+            return;
+        }
+    }
+}
+
+void Broker::enqueue(Session& s, const SimMessage& msg) {
+    if (s.inbox.size() >= _maxQueued) {
+        s.dropped++;
+        _dropped++;
+        return;
+    }
+
+    // Publishers run on their own clocks: keep the queue in time order
+    auto it = s.inbox.end();
+    while (it != s.inbox.begin() && (it - 1)->at > msg.at) --it;
+    s.inbox.insert(it, msg);
+    _delivered++;
+    if (s.inbox.size() > s.maxBacklog) s.maxBacklog = s.inbox.size();
+}
+
+void Broker::publish(const std::string& topic, const std::string& payload, bool retained, uint64_t at) {
+    if (!up(at)) return;
+
+    SimMessage msg = {topic, payload, retained, at};
+    _published++;
+
+    if (retained) {
+        if (payload.empty()) _retained.erase(topic);
+        else _retained[topic] = msg;
+    }
+
+    for (auto& entry : _sessions) {
+        Session& s = *entry.second;
+        // Offline persistent sessions only queue QoS 1+; everything here is QoS 0
+        if (!alive(&s, at)) continue;
+        for (const auto& f : s.filters) {
+            if (matches(f, topic)) {
+                SimMessage copy = msg;
+                copy.retained = false;   // Retain flag is only set for stored messages
+                enqueue(s, copy);
+                break;
+            }
+        }
+    }
+
+    for (auto& t : _taps) t(msg);
+}
+
+const SimMessage* Broker::peek(Session* s, uint64_t at) const {
+    if (s == nullptr || s->inbox.empty() || s->inbox.front().at > at) return nullptr;
+    return &s->inbox.front();
+}
+
+void Broker::pop(Session* s, uint64_t at) {
+    if (s == nullptr || s->inbox.empty()) return;
+    for (auto& t : _receiveTaps) t(*s, s->inbox.front(), at);
+    s->inbox.pop_front();
+    s->received++;
+}
+
+}  // namespace kvn_sim
@@ -0,0 +1,113 @@
+/*
+ * broker.h - In-process MQTT broker stand-in for the KVN host simulator
+ *
+ * Enough of an MQTT broker for the firmware's PubSubClient calls:
+ * sessions by client ID (clean or persistent), '+'/'#' subscriptions,
+ * retained messages, last will, and a per-session queue bounded like
+ * mosquitto's max_queued_messages (further QoS 0 messages are dropped).
+ *
+ * Every message carries the simulated time it was published. A client
+ * only receives it once its own clock has reached that time, so devices
+ * on different clocks still see causally ordered traffic.
+ *
+ * Outages are scripted as [start, end) windows. A session connected
+ * before an outage is dropped by it; persistent sessions keep their
+ * subscriptions, as with mosquitto's persistence enabled.
+ */
+
+#ifndef KVN_SIM_BROKER_H
+#define KVN_SIM_BROKER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kvn_sim {
+
+struct SimMessage {
+    std::string topic;
+    std::string payload;
+    bool retained;
+    uint64_t at;          // Simulated publish time (us)
+};
+
+class Broker {
+public:
+    struct Session {
+        std::string clientId;
+        bool connected;
+        bool clean;
+        uint64_t connectedAt;
+        std::vector<std::string> filters;
+        std::deque<SimMessage> inbox;       // Sorted by `at`
+
+        bool hasWill;
+        SimMessage will;
+
+        uint32_t received;    // Handed to the client
+        uint32_t dropped;     // Queue full
+        size_t maxBacklog;
+    };
+
+    typedef std::function<void(const SimMessage&)> Tap;
+    typedef std::function<void(const Session&, const SimMessage&, uint64_t at)> ReceiveTap;
+
+    Broker();
+
+    // Returns nullptr while the broker is down
+    Session* connect(const std::string& clientId, bool clean, const SimMessage* will, uint64_t at);
+    // Graceful disconnects discard the will
+    void disconnect(Session* session, bool graceful, uint64_t at);
+    // False once an outage since the connect has dropped the session
+    bool alive(Session* session, uint64_t at);
+
+    void subscribe(Session* session, const std::string& filter, uint64_t at);
+    void unsubscribe(Session* session, const std::string& filter);
+    void publish(const std::string& topic, const std::string& payload, bool retained, uint64_t at);
+
+    // Next message the session may receive at `at`, or nullptr
+    const SimMessage* peek(Session* session, uint64_t at) const;
+    void pop(Session* session, uint64_t at);
+
+    // Every accepted publish, in call order (for collectors and reports)
+    void tap(Tap tap) { _taps.push_back(tap); }
+    // Every message a client took off its queue, with the time it did
+    void onReceive(ReceiveTap tap) { _receiveTaps.push_back(tap); }
+
+    void outage(uint64_t startUs, uint64_t endUs) { _outages.push_back({startUs, endUs}); }
+    bool up(uint64_t at) const;
+    void setMaxQueued(size_t max) { _maxQueued = max; }
+
+    Session* session(const std::string& clientId);
+
+    uint64_t published() const { return _published; }
+    uint64_t delivered() const { return _delivered; }
+    uint64_t dropped() const { return _dropped; }
+    size_t retainedCount() const { return _retained.size(); }
+
+    static bool matches(const std::string& filter, const std::string& topic);
+
+private:
+    std::map<std::string, std::unique_ptr<Session>> _sessions;
+    std::map<std::string, SimMessage> _retained;
+    std::vector<Tap> _taps;
+    std::vector<ReceiveTap> _receiveTaps;
+    std::vector<std::pair<uint64_t, uint64_t>> _outages;
+    size_t _maxQueued;
+
+    uint64_t _published;
+    uint64_t _delivered;
+    uint64_t _dropped;
+
+    void enqueue(Session& session, const SimMessage& msg);
+    void dropSession(Session& session, uint64_t at);
+};
+
+}  // namespace kvn_sim
+
+#endif // KVN_SIM_BROKER_H
@@ -0,0 +1,50 @@
+/*
+ * heap_meter.cpp - malloc, calloc, realloc and free, metered
+ */
+
+#include "heap_meter.h"
+#include "kvn_sim.h"
+#include <malloc.h>
+
+using kvn_sim::heapMeter;
+
+#if KVN_HEAP_METER
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void  __libc_free(void* ptr);
+
+static inline void heapAdd(void* p) {
+    if (p && heapMeter.active()) heapMeter.count(malloc_usable_size(p));
+}
+
+static inline void heapSub(void* p) {
+    if (p && heapMeter.active()) heapMeter.release(malloc_usable_size(p));
+}
+
+void* malloc(size_t size) {
+    void* p = __libc_malloc(size);
+    heapAdd(p);
+    return p;
+}
+
+void* calloc(size_t n, size_t size) {
+    void* p = __libc_calloc(n, size);
+    heapAdd(p);
+    return p;
+}
+
+void* realloc(void* ptr, size_t size) {
+    heapSub(ptr);
+    void* p = __libc_realloc(ptr, size);
+    heapAdd(p ? p : ptr);   // A failed realloc keeps the old block
+    return p;
+}
+
+void free(void* ptr) {
+    heapSub(ptr);
+    __libc_free(ptr);
+}
+}
+#endif
@@ -0,0 +1,24 @@
+/*
+ * heap_meter.h - malloc replaced to feed kvn_sim::heapMeter
+ *
+ * Link kvn_heap_meter into a program to count its heap use while
+ * heapMeter.active() (see kvn_sim.h). Not under ASan, which owns malloc:
+ * KVN_HEAP_METER is 0 there and nothing is counted.
+ */
+
+#ifndef KVN_HEAP_METER_H
+#define KVN_HEAP_METER_H
+
+#if defined(__SANITIZE_ADDRESS__)
+  #define KVN_HEAP_METER 0
+#elif defined(__has_feature)
+  #if __has_feature(address_sanitizer)
+    #define KVN_HEAP_METER 0
+  #else
+    #define KVN_HEAP_METER 1
+  #endif
+#else
+  #define KVN_HEAP_METER 1
+#endif
+
+#endif // KVN_HEAP_METER_H
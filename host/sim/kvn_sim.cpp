@@ -0,0 +1,444 @@
+/*
+ * kvn_sim.cpp - Implementation
+ */
+
+#include "kvn_sim.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+namespace kvn_sim {
+
+World* World::_current = nullptr;
+Device* World::_active = nullptr;
+HeapMeter heapMeter = {};
+
+static const uint8_t SIM_AP_BSSID[6] = {0x24, 0x0A, 0xC4, 0x4B, 0x56, 0x4E};
+
+// ==================== DEVICE ====================
+
+Device::Device(World& world, const Sketch& sketch, const char* name, uint8_t index)
+    : _world(world), _sketch(sketch), _name(name), _index(index) {
+    _now = 0;
+    _bootUs = 0;
+    _booted = false;
+    _asleep = false;
+    _halted = false;
+    _wakeAt = 0;
+    _restartAt = SIM_NEVER;
+    _wakeCause = WAKE_COLD;
+    _boots = 0;
+
+    _power = {0.01f, 20.0f, 80.0f};
+    _chargeMas = 0;
+    _sleepUs = 0;
+    _awakeUs = 0;
+    _radioUs = 0;
+
+    _echo = false;
+    _uartBytes = 0;
+    _i2c = {};
+    _flashStats = {};
+
+    _radioOn = false;
+    _link = LINK_OFF;
+    _linkReadyAt = 0;
+    _linkUpAt = 0;
+    _linkCached = false;
+    _staticIp = 0;
+    _wifiJoins = 0;
+    _wifiFastJoins = 0;
+    _linkDrops = 0;
+
+    _session = nullptr;
+    _mqttConnects = 0;
+    _mqttFailures = 0;
+
+    _timerWakeUs = 0;
+    _gpioWakeMask = 0;
+    _gpioWakeLevel = 1;
+}
+
+const CostModel& Device::cost() const {
+    return _world._cost;
+}
+
+void Device::advance(uint64_t us) {
+    _now += us;
+    _awakeUs += us;
+    float ma = _power.awakeMa;
+    if (_radioOn) {
+        _radioUs += us;
+        ma = _power.radioMa;
+    }
+    _chargeMas += ma * (us / 1e6);
+}
+
+void Device::setAnalog(uint8_t pin, std::function<uint16_t(uint64_t)> model) {
+    _analogIn[pin] = model;
+}
+
+void Device::setDigital(uint8_t pin, uint64_t us, int level) {
+    _digitalIn[pin][us] = level;
+}
+
+void Device::feedUart(uint8_t port, uint64_t us, const std::string& bytes) {
+    std::deque<UartByte>& q = _uartIn[port];
+    for (char c : bytes) q.push_back({us, (uint8_t)c});
+}
+
+void Device::attachI2C(uint8_t sdaPin, uint8_t address, std::shared_ptr<I2CPeripheral> chip) {
+    _i2cChips[{sdaPin, address}] = chip;
+}
+
+uint16_t Device::analogIn(uint8_t pin) {
+    advance(cost().analogReadUs);
+    auto it = _analogIn.find(pin);
+    return it == _analogIn.end() ? 0 : it->second(_now);
+}
+
+static int levelAt(const std::map<uint64_t, int>& script, uint64_t us) {
+    auto it = script.upper_bound(us);
+    if (it == script.begin()) return 0;
+    return (--it)->second;
+}
+
+int Device::digitalIn(uint8_t pin) {
+    auto mode = _pinMode.find(pin);
+    if (mode != _pinMode.end() && mode->second == 0x03 /* OUTPUT */) {
+        return digitalOut(pin);
+    }
+    auto it = _digitalIn.find(pin);
+    return it == _digitalIn.end() ? 0 : levelAt(it->second, _now);
+}
+
+int Device::digitalOut(uint8_t pin) const {
+    auto it = _digitalOut.find(pin);
+    return it == _digitalOut.end() ? 0 : it->second;
+}
+
+int Device::analogOut(uint8_t pin) const {
+    auto it = _analogOut.find(pin);
+    return it == _analogOut.end() ? 0 : it->second;
+}
+
+void Device::uartWrite(uint8_t port, const uint8_t* data, size_t len) {
+    _uartBytes += len;
+    advance((uint64_t)len * cost().uartByteNs / 1000);
+    if (port != 0 || !(_echo || _world._verbose)) return;
+
+    HeapPause pause;
+    for (size_t i = 0; i < len; i++) {
+        char c = (char)data[i];
+        if (c == '\r') continue;
+        if (c != '\n') {
+            _line += c;
+            continue;
+        }
+        printf("[%12.3f] %-10s %s\n", seconds(_now), _name.c_str(), _line.c_str());
+        _line.clear();
+    }
+}
+
+bool Device::i2cTransfer(int sdaPin, uint32_t clockHz, uint8_t address,
+                         const uint8_t* tx, size_t txLength, bool write,
+                         uint8_t* rx, size_t rxLength) {
+    auto it = _i2cChips.find({(uint8_t)sdaPin, address});
+    I2CPeripheral* chip = it == _i2cChips.end() ? nullptr : it->second.get();
+
+    // Start, address + ACK, 9 bits per byte, stop; a repeated start
+    // costs one more start and address
+    uint64_t bits = 2 + 9;
+    bool ok = chip != nullptr;
+    if (ok && write) {
+        bits += 9 * txLength;
+        ok = chip->write(tx, txLength, _now);
+    }
+    if (ok && rx != nullptr) {
+        if (write) bits += 1 + 9;
+        bits += 9 * rxLength;
+        ok = chip->read(rx, rxLength, _now);
+    }
+
+    uint64_t us = cost().i2cTransactionUs + (bits * 1000000 + clockHz - 1) / clockHz;
+    _i2c.transactions++;
+    _i2c.bytes += (write ? txLength : 0) + (ok && rx ? rxLength : 0);
+    _i2c.busUs += us;
+    if (!ok) _i2c.nacks++;
+    advance(us);
+    return ok;
+}
+
+int Device::uartAvailable(uint8_t port) {
+    auto it = _uartIn.find(port);
+    if (it == _uartIn.end()) return 0;
+    int n = 0;
+    for (const UartByte& b : it->second) {
+        if (b.at > _now) break;
+        n++;
+    }
+    return n;
+}
+
+int Device::uartPeek(uint8_t port) {
+    auto it = _uartIn.find(port);
+    if (it == _uartIn.end() || it->second.empty() || it->second.front().at > _now) return -1;
+    return it->second.front().value;
+}
+
+int Device::uartRead(uint8_t port) {
+    int c = uartPeek(port);
+    if (c >= 0) _uartIn[port].pop_front();
+    return c;
+}
+
+// ==================== WIFI ====================
+
+void Device::wifiBegin(bool cached, uint8_t channel, const uint8_t* bssid) {
+    _radioOn = true;
+    _link = LINK_JOINING;
+    _wifiJoins++;
+
+    bool known = !cached ||
+                 (channel == _world.apChannel() && bssid && memcmp(bssid, _world.apBssid(), 6) == 0);
+    if (!known) {
+        // Wrong channel or AP: never joins; the sketch falls back to a scan
+        _linkCached = true;
+        _linkReadyAt = SIM_NEVER;
+        return;
+    }
+
+    _linkCached = cached;
+    if (cached) _wifiFastJoins++;
+    _linkReadyAt = _world.apUpAfter(_now) + (cached ? cost().wifiFastUs : cost().wifiFullUs);
+}
+
+void Device::wifiDisconnect(bool radioOff) {
+    _link = LINK_OFF;
+    if (radioOff) _radioOn = false;
+}
+
+WifiLink Device::wifiLink() {
+    if (_link == LINK_UP) {
+        uint64_t outageEnd = _world.apOutageBetween(_linkUpAt, _now);
+        if (outageEnd == 0) return LINK_UP;
+
+        // Lost during an AP outage; the station rejoins by itself afterwards
+        _linkDrops++;
+        _link = LINK_JOINING;
+        _linkCached = false;
+        _linkReadyAt = outageEnd + cost().wifiFullUs;
+    }
+
+    if (_link == LINK_JOINING && _now >= _linkReadyAt) {
+        if (_world.apUp(_linkReadyAt)) {
+            _link = LINK_UP;
+            _linkUpAt = _linkReadyAt;
+        } else {
+            _linkReadyAt = _world.apUpAfter(_now) + cost().wifiFullUs;
+        }
+    }
+    return _link;
+}
+
+uint32_t Device::ip() const {
+    if (_staticIp) return _staticIp;
+    // DHCP lease: 192.168.86.(100 + index), in lwIP byte order
+    return 192u | (168u << 8) | (86u << 16) | ((uint32_t)(100 + _index) << 24);
+}
+
+// ==================== SLEEP AND BOOT ====================
+
+uint64_t Device::nextGpioWake(uint64_t from) const {
+    uint64_t best = SIM_NEVER;
+    for (uint8_t pin = 0; pin < 64; pin++) {
+        if (!(_gpioWakeMask & (1ULL << pin))) continue;
+        auto it = _digitalIn.find(pin);
+        if (it == _digitalIn.end()) continue;
+
+        // Level-triggered: already at the wake level wakes straight away
+        if (levelAt(it->second, from) == _gpioWakeLevel) return from;
+        for (auto e = it->second.upper_bound(from); e != it->second.end(); ++e) {
+            if (e->second == _gpioWakeLevel) {
+                if (e->first < best) best = e->first;
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+void Device::enterSleep() {
+    wifiDisconnect(true);
+    if (_session) {
+        _world._broker.disconnect(_session, false, _now);
+        _session = nullptr;
+    }
+
+    uint64_t timer = _timerWakeUs ? _now + _timerWakeUs : SIM_NEVER;
+    uint64_t gpio = _gpioWakeMask ? nextGpioWake(_now) : SIM_NEVER;
+    _wakeCause = gpio < timer ? WAKE_GPIO : WAKE_TIMER;
+    _wakeAt = gpio < timer ? gpio : timer;
+    _asleep = true;
+    _halted = _wakeAt == SIM_NEVER;
+}
+
+void Device::wake() {
+    uint64_t slept = _wakeAt - _now;
+    _sleepUs += slept;
+    _chargeMas += _power.sleepMa * (slept / 1e6);
+    _now = _wakeAt;
+    _asleep = false;
+    _booted = false;
+    clearWakeSources();
+}
+
+void Device::step() {
+    World::_active = this;
+    if (_asleep) wake();
+
+    try {
+        if (!_booted) {
+            _booted = true;
+            _bootUs = _now;
+            _boots++;
+            if (_boots > 1 && _sketch.reset) _sketch.reset();
+            _sketch.setup();
+        } else if (_now >= _restartAt) {
+            _restartAt = SIM_NEVER;
+            throw Restart();
+        } else {
+            _sketch.loop();
+        }
+        advance(cost().loopUs);
+    } catch (const DeepSleep&) {
+        enterSleep();
+    } catch (const Restart&) {
+        wifiDisconnect(true);
+        if (_session) _world._broker.disconnect(_session, false, _now);
+        _session = nullptr;
+        _booted = false;
+        _wakeCause = WAKE_COLD;
+    }
+    World::_active = nullptr;
+}
+
+// ==================== WORLD ====================
+
+World::World(uint32_t seed) : _broker() {
+    _cost.loopUs = 20;
+    _cost.clockReadUs = 1;
+    _cost.analogReadUs = 10;
+    _cost.wifiFullUs = 1500000;
+    _cost.wifiFastUs = 300000;
+    _cost.mqttConnectUs = 20000;
+    _cost.mqttTimeoutUs = 3000000;
+    _cost.publishUs = 150;
+    _cost.publishByteNs = 100;
+    _cost.receiveUs = 50;
+    _cost.uartByteNs = 86800;
+    _cost.spiBytesPerMs = 5000;
+    _cost.i2cBeginUs = 60;
+    _cost.i2cTransactionUs = 35;
+
+    _apChannel = 6;
+    memcpy(_apBssid, SIM_AP_BSSID, sizeof(_apBssid));
+
+    _rng = 0x9E3779B97F4A7C15ULL ^ seed;
+    _now = 0;
+    _verbose = false;
+    _current = this;
+}
+
+World::~World() {
+    if (_current == this) _current = nullptr;
+}
+
+Device& World::add(const Sketch& sketch, const char* name) {
+    _devices.emplace_back(new Device(*this, sketch, name, (uint8_t)_devices.size()));
+    return *_devices.back();
+}
+
+bool World::apUp(uint64_t us) const {
+    for (const auto& o : _apOutages) {
+        if (us >= o.first && us < o.second) return false;
+    }
+    return true;
+}
+
+uint64_t World::apUpAfter(uint64_t us) const {
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        for (const auto& o : _apOutages) {
+            if (us >= o.first && us < o.second) {
+                us = o.second;
+                moved = true;
+            }
+        }
+    }
+    return us;
+}
+
+uint64_t World::apOutageBetween(uint64_t fromUs, uint64_t toUs) const {
+    for (const auto& o : _apOutages) {
+        if (o.first > fromUs && o.first <= toUs) return o.second;
+    }
+    return 0;
+}
+
+uint32_t World::random() {
+    // xorshift64*
+    _rng ^= _rng >> 12;
+    _rng ^= _rng << 25;
+    _rng ^= _rng >> 27;
+    return (uint32_t)((_rng * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+void World::run(uint64_t untilUs) {
+    _current = this;
+    while (true) {
+        Device* next = nullptr;
+        for (auto& d : _devices) {
+            if (d->halted() || d->readyAt() >= untilUs) continue;
+            if (next == nullptr || d->readyAt() < next->readyAt()) next = d.get();
+        }
+        if (next == nullptr) break;
+
+        next->step();
+        if (next->now() > _now) _now = next->now();
+        if (_stepHook) _stepHook(next->now());
+    }
+    if (untilUs > _now) _now = untilUs;
+}
+
+Device& World::active() {
+    if (_active) return *_active;
+
+    // HAL calls outside any device (static constructors, tests, scenario code)
+    static World idle;
+    static const Sketch none = {"host", nullptr, nullptr};
+    static Device host(idle, none, "host", 0);
+    return host;
+}
+
+// ==================== HOST ====================
+
+uint64_t hostMicros() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+Broker& hostBroker() {
+    static Broker broker;
+    return broker;
+}
+
+// ==================== HELPERS ====================
+
+double seconds(uint64_t us) { return us / 1e6; }
+uint64_t minutesUs(double minutes) { return (uint64_t)(minutes * 60e6); }
+uint64_t hoursUs(double hours) { return (uint64_t)(hours * 3600e6); }
+uint64_t daysUs(double days) { return (uint64_t)(days * 86400e6); }
+
+}  // namespace kvn_sim
@@ -0,0 +1,384 @@
+/*
+ * kvn_sim.h - Discrete-time simulator behind the KVN host HAL
+ *
+ * Every simulated board is a Device running one sketch (setup/loop) on
+ * its own clock. The World always runs the device whose clock is
+ * furthest behind, for one loop() at a time. Inside it, delay(), ADC
+ * reads, MQTT packets and display DMA advance that device's clock, so no
+ * real time passes and a day of simulated traffic runs in seconds.
+ *
+ * The HAL headers in host/hal route Arduino calls (millis, analogRead,
+ * WiFi, PubSubClient, esp_deep_sleep_start, ...) to the active device:
+ *
+ *   - Time: micros()/millis() count from the last boot; deep sleep
+ *     resets them, like the real RTC-timer wake.
+ *   - Pins: analog inputs are functions of time, digital inputs are
+ *     scripted level changes, outputs are recorded.
+ *   - UART: Serial output is collected per device (echoed with
+ *     --verbose); input is scripted bytes with arrival times.
+ *   - I2C: peripherals are attached by SDA pin and address; every
+ *     transaction costs its bits at the bus clock plus driver overhead.
+ *   - Power: current is charged for every simulated microsecond at the
+ *     sleep, awake or radio-on rate of the device's PowerModel.
+ *   - Network: one access point and one in-process broker (broker.h),
+ *     both with scriptable outages.
+ *
+ * Deep sleep throws out of setup()/loop(); the World restarts the sketch
+ * from setup() when the timer or a GPIO wakes it. Globals are not cleared
+ * across deep sleep (only RTC_DATA_ATTR would survive on hardware), so
+ * sketches must not rely on RAM being zeroed on wake.
+ */
+
+#ifndef KVN_SIM_H
+#define KVN_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+
+#include "broker.h"
+
+namespace kvn_sim {
+
+#define SIM_NEVER UINT64_MAX
+#define SIM_EPOCH_US 1735689600000000ULL   // gettimeofday() at t = 0: 2025-01-01 00:00:00 UTC
+
+struct Sketch {
+    const char* name;
+    void (*setup)();
+    void (*loop)();
+    void (*reset)();   // RAM globals back to their initializers (ino2cpp); may be null
+};
+
+// The sketches built by host/CMakeLists.txt (see kvn_add_sketch)
+extern const Sketch sketch_relay;
+extern const Sketch sketch_hub_ldr;
+extern const Sketch sketch_hub;
+extern const Sketch sketch_watchtower;
+extern const Sketch sketch_scout_ldr;
+extern const Sketch sketch_supermini;
+
+// Thrown by esp_deep_sleep_start() and ESP.restart()
+struct DeepSleep {};
+struct Restart {};
+
+// Supply current (mA) in each power state
+struct PowerModel {
+    float sleepMa;
+    float awakeMa;
+    float radioMa;     // CPU + WiFi
+};
+
+// Cost of common operations in simulated microseconds
+struct CostModel {
+    uint32_t loopUs;          // Minimum per loop() (keeps busy loops moving)
+    uint32_t clockReadUs;     // Every millis()/micros() call
+    uint32_t analogReadUs;
+    uint32_t wifiFullUs;      // Scan + associate + DHCP
+    uint32_t wifiFastUs;      // Cached BSSID/channel, static IP
+    uint32_t mqttConnectUs;
+    uint32_t mqttTimeoutUs;   // Blocking connect to a broker that is down
+    uint32_t publishUs;       // Per packet, plus publishByteNs per byte
+    uint32_t publishByteNs;
+    uint32_t receiveUs;       // Per packet handed to the callback
+    uint32_t uartByteNs;      // Blocking UART TX (115200 baud = 86800)
+    uint32_t spiBytesPerMs;   // Display DMA rate (40 MHz SPI = 5000)
+    uint32_t i2cBeginUs;      // Wire.begin(): driver install + pin matrix
+    uint32_t i2cTransactionUs;// Per transaction, on top of the bits on the wire
+};
+
+// A chip on a simulated I2C bus. Return false to NACK.
+class I2CPeripheral {
+public:
+    virtual ~I2CPeripheral() {}
+    // Bytes written after the address (register pointer, command, data);
+    // none for an address probe
+    virtual bool write(const uint8_t* data, size_t length, uint64_t us) = 0;
+    virtual bool read(uint8_t* out, size_t length, uint64_t us) = 0;
+};
+
+struct I2CStats {
+    uint64_t transactions;    // Start to stop; a repeated start does not count again
+    uint64_t nacks;
+    uint64_t bytes;           // Data bytes, both directions
+    uint64_t busUs;           // Time the sketch was blocked on the bus (incl. Wire.begin())
+};
+
+struct FlashStats {
+    uint64_t writes;          // File::write() calls
+    uint64_t bytes;           // Bytes written
+    uint64_t flushes;         // File::flush() calls - each commits a page on LittleFS
+};
+
+enum WifiLink { LINK_OFF, LINK_JOINING, LINK_UP };
+
+enum WakeCause { WAKE_COLD, WAKE_TIMER, WAKE_GPIO };
+
+class World;
+
+class Device {
+public:
+    Device(World& world, const Sketch& sketch, const char* name, uint8_t index);
+
+    // --- Scripting ---
+    void startAt(uint64_t us) { _now = us; }
+    // A reset at `us` (watchdog, brownout): setup() again, RAM lost, RTC kept
+    void restartAt(uint64_t us) { _restartAt = us; }
+    void setPower(const PowerModel& power) { _power = power; }
+    void setEcho(bool echo) { _echo = echo; }
+
+    // Analog input as a function of absolute simulated time (us)
+    void setAnalog(uint8_t pin, std::function<uint16_t(uint64_t)> model);
+    // Digital input level from `us` on
+    void setDigital(uint8_t pin, uint64_t us, int level);
+    // Bytes arriving on UART `port` at `us`
+    void feedUart(uint8_t port, uint64_t us, const std::string& bytes);
+    // A chip answering at `address` on the bus wired to `sdaPin`
+    void attachI2C(uint8_t sdaPin, uint8_t address, std::shared_ptr<I2CPeripheral> chip);
+
+    // --- State ---
+    const char* name() const { return _name.c_str(); }
+    uint8_t index() const { return _index; }
+    uint64_t now() const { return _now; }
+    uint64_t sinceBoot() const { return _now - _bootUs; }
+    bool asleep() const { return _asleep; }
+    WakeCause wakeCause() const { return _wakeCause; }
+    uint32_t boots() const { return _boots; }
+
+    // Energy and time spent in each state
+    double chargeMah() const { return _chargeMas / 3600.0; }
+    uint64_t sleepUs() const { return _sleepUs; }
+    uint64_t awakeUs() const { return _awakeUs; }
+    uint64_t radioUs() const { return _radioUs; }
+
+    uint32_t wifiJoins() const { return _wifiJoins; }
+    uint32_t wifiFastJoins() const { return _wifiFastJoins; }
+    uint32_t linkDrops() const { return _linkDrops; }
+    uint32_t mqttConnects() const { return _mqttConnects; }
+    uint32_t mqttConnectFailures() const { return _mqttFailures; }
+    uint64_t uartBytes() const { return _uartBytes; }
+    const I2CStats& i2c() const { return _i2c; }
+
+    int digitalOut(uint8_t pin) const;
+    int analogOut(uint8_t pin) const;
+
+    // --- Used by the HAL ---
+    void advance(uint64_t us);
+    void spend(uint64_t us) { advance(us); }
+    const CostModel& cost() const;
+
+    uint16_t analogIn(uint8_t pin);
+    int digitalIn(uint8_t pin);
+    void pinMode(uint8_t pin, uint8_t mode) { _pinMode[pin] = mode; }
+    void digitalWrite(uint8_t pin, int level) { _digitalOut[pin] = level; }
+    void analogWrite(uint8_t pin, int value) { _analogOut[pin] = value; }
+
+    void uartWrite(uint8_t port, const uint8_t* data, size_t len);
+    int uartAvailable(uint8_t port);
+    int uartRead(uint8_t port);
+    int uartPeek(uint8_t port);
+
+    // One I2C transaction on the bus at `sdaPin`: an optional write, then
+    // (after a repeated start) an optional read. Returns false on a NACK.
+    void i2cBegin() { _i2c.busUs += cost().i2cBeginUs; advance(cost().i2cBeginUs); }
+    bool i2cTransfer(int sdaPin, uint32_t clockHz, uint8_t address,
+                     const uint8_t* tx, size_t txLength, bool write,
+                     uint8_t* rx, size_t rxLength);
+
+    // WiFi station
+    void wifiBegin(bool cached, uint8_t channel, const uint8_t* bssid);
+    void wifiDisconnect(bool radioOff);
+    WifiLink wifiLink();
+    bool radioOn() const { return _radioOn; }
+    void setStaticIp(uint32_t ip) { _staticIp = ip; }   // 0 = DHCP
+    uint32_t ip() const;
+
+    // MQTT session (one client per device)
+    Broker::Session* mqttSession() { return _session; }
+    void setMqttSession(Broker::Session* session) { _session = session; }
+    void noteMqttConnect(bool ok) { ok ? _mqttConnects++ : _mqttFailures++; }
+
+    // Flash file system (LittleFS), kept across reboots
+    std::map<std::string, std::vector<uint8_t>>& flash() { return _flash; }
+    FlashStats& flashStats() { return _flashStats; }
+
+    // Deep sleep wake sources, armed by esp_sleep_enable_*
+    void armTimerWake(uint64_t us) { _timerWakeUs = us; }
+    void armGpioWake(uint64_t mask, int level) { _gpioWakeMask = mask; _gpioWakeLevel = level; }
+    void clearWakeSources() { _timerWakeUs = 0; _gpioWakeMask = 0; }
+
+    // --- Used by the World ---
+    uint64_t readyAt() const { return _asleep ? _wakeAt : _now; }
+    void step();
+    bool halted() const { return _halted; }
+
+private:
+    World& _world;
+    Sketch _sketch;
+    std::string _name;
+    uint8_t _index;
+
+    uint64_t _now;
+    uint64_t _bootUs;
+    bool _booted;
+    bool _asleep;
+    bool _halted;
+    uint64_t _wakeAt;
+    uint64_t _restartAt;
+    WakeCause _wakeCause;
+    uint32_t _boots;
+
+    PowerModel _power;
+    double _chargeMas;
+    uint64_t _sleepUs;
+    uint64_t _awakeUs;
+    uint64_t _radioUs;
+
+    std::map<uint8_t, std::function<uint16_t(uint64_t)>> _analogIn;
+    std::map<uint8_t, std::map<uint64_t, int>> _digitalIn;
+    std::map<uint8_t, uint8_t> _pinMode;
+    std::map<uint8_t, int> _digitalOut;
+    std::map<uint8_t, int> _analogOut;
+
+    struct UartByte { uint64_t at; uint8_t value; };
+    std::map<uint8_t, std::deque<UartByte>> _uartIn;
+    std::string _line;
+    bool _echo;
+    uint64_t _uartBytes;
+
+    std::map<std::pair<uint8_t, uint8_t>, std::shared_ptr<I2CPeripheral>> _i2cChips;
+    I2CStats _i2c;
+
+    bool _radioOn;
+    WifiLink _link;
+    uint64_t _linkReadyAt;
+    uint64_t _linkUpAt;
+    bool _linkCached;
+    uint32_t _staticIp;
+    uint32_t _wifiJoins;
+    uint32_t _wifiFastJoins;
+    uint32_t _linkDrops;
+
+    Broker::Session* _session;
+    uint32_t _mqttConnects;
+    uint32_t _mqttFailures;
+
+    std::map<std::string, std::vector<uint8_t>> _flash;
+    FlashStats _flashStats;
+
+    uint64_t _timerWakeUs;
+    uint64_t _gpioWakeMask;
+    int _gpioWakeLevel;
+
+    void enterSleep();
+    void wake();
+    uint64_t nextGpioWake(uint64_t from) const;
+};
+
+class World {
+public:
+    World(uint32_t seed = 1);
+    ~World();
+
+    Device& add(const Sketch& sketch, const char* name);
+
+    // Run every device until its clock reaches `untilUs`
+    void run(uint64_t untilUs);
+
+    // Called between steps (after any device ran), e.g. to inject load.
+    // Receives the clock of the device that just ran.
+    void onStep(std::function<void(uint64_t)> hook) { _stepHook = hook; }
+
+    Broker& broker() { return _broker; }
+    CostModel& cost() { return _cost; }
+
+    // Access point: down in [start, end)
+    void apOutage(uint64_t startUs, uint64_t endUs) { _apOutages.push_back({startUs, endUs}); }
+    bool apUp(uint64_t us) const;
+    uint64_t apUpAfter(uint64_t us) const;   // First time >= us the AP is up
+    // End of an outage starting in (fromUs, toUs], or 0
+    uint64_t apOutageBetween(uint64_t fromUs, uint64_t toUs) const;
+    uint8_t apChannel() const { return _apChannel; }
+    void setApChannel(uint8_t channel) { _apChannel = channel; }
+    const uint8_t* apBssid() const { return _apBssid; }
+
+    // Deterministic random(), esp_random()
+    uint32_t random();
+
+    uint64_t now() const { return _now; }
+    bool verbose() const { return _verbose; }
+    void setVerbose(bool verbose) { _verbose = verbose; }
+
+    static World* current() { return _current; }
+    static Device& active();
+    // True outside any device's setup()/loop(): tests, benchmarks and
+    // scenario code. The HAL then runs on the host itself: millis() and
+    // delay() use the real clock and Serial goes to stdout.
+    static bool onHost() { return _active == nullptr; }
+
+private:
+    std::vector<std::unique_ptr<Device>> _devices;
+    Broker _broker;
+    CostModel _cost;
+
+    std::vector<std::pair<uint64_t, uint64_t>> _apOutages;
+    uint8_t _apChannel;
+    uint8_t _apBssid[6];
+
+    uint64_t _rng;
+    uint64_t _now;
+    bool _verbose;
+    std::function<void(uint64_t)> _stepHook;
+
+    static World* _current;
+    static Device* _active;
+    friend class Device;
+};
+
+// Heap used by firmware code inside MQTT callbacks. Nothing is counted
+// unless the program replaces malloc and calls count()/release() (see
+// scenarios/relay_trace.cpp). PubSubClient::loop() meters the callback;
+// the HAL pauses the meter (HeapPause) around its own bookkeeping, such
+// as broker queues and the Serial echo, which a device does not have.
+struct HeapMeter {
+    int depth;              // > 0 inside a metered callback
+    int paused;             // > 0 inside HAL bookkeeping
+    size_t inUse;
+    size_t peak;
+    uint64_t allocations;
+
+    bool active() const { return depth > 0 && paused == 0; }
+    void count(size_t bytes) {
+        inUse += bytes;
+        if (inUse > peak) peak = inUse;
+        allocations++;
+    }
+    void release(size_t bytes) { inUse = bytes > inUse ? 0 : inUse - bytes; }
+};
+
+extern HeapMeter heapMeter;
+
+struct HeapPause {
+    HeapPause() { heapMeter.paused++; }
+    ~HeapPause() { heapMeter.paused--; }
+};
+
+// Outside a device (World::onHost()): the host's clock, in us since its
+// first use, and the broker PubSubClient talks to there
+uint64_t hostMicros();
+Broker& hostBroker();
+
+// Helpers shared by scenarios
+double seconds(uint64_t us);
+uint64_t minutesUs(double minutes);
+uint64_t hoursUs(double hours);
+uint64_t daysUs(double days);
+
+}  // namespace kvn_sim
+
+#endif // KVN_SIM_H
@@ -0,0 +1,164 @@
+/*
+ * ai_mock.cpp - ESP32_AI against examples/MockServer/mock_server.py
+ *
+ * Starts the mock on a free local port (one per provider, so each
+ * counts its own requests) and talks to it through the host's socket
+ * WiFiClient. The mock streams one word per MOCK_DELAY and, with
+ * --drop-every 3, closes the connection instead of answering every third
+ * request, as an idle keep-alive timeout racing a new request would.
+ * Checks per provider:
+ *   - every reply arrives and echoes the prompt
+ *   - time to first token is one word's delay, not the whole reply
+ *   - a dropped keep-alive connection is retried once on a new one
+ *   - a repeated prompt is a cache hit, with no round trip
+ *   - peak heap during a request (AIStats.heapUsed, metered through
+ *     kvn_heap_meter) stays under HEAP_CEILING
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include "heap_meter.h"
+#include <ESP32_AI.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define MOCK_DELAY_MS 20
+#define ROUNDS        5       // Requests 3 and 6 are dropped: two retries
+#define DROP_EVERY    "3"
+#define HEAP_CEILING  1024    // Bytes; chat() builds and parses in its own buffers
+
+struct MockServer {
+    pid_t pid;
+    uint16_t port;
+};
+
+// Runs mock_server.py --port 0 and reads the port it bound
+static bool startMock(MockServer& mock) {
+    int out[2];
+    if (pipe(out) != 0) return false;
+
+    char delay[16];
+    snprintf(delay, sizeof(delay), "%.3f", MOCK_DELAY_MS / 1000.0);
+    mock.pid = fork();
+    if (mock.pid == 0) {
+        dup2(out[1], STDOUT_FILENO);
+        close(out[0]);
+        close(out[1]);
+        execl(KVN_PYTHON, KVN_PYTHON, KVN_AI_MOCK_SERVER, "--port", "0", "--delay", delay,
+              "--drop-every", DROP_EVERY, (char*)nullptr);
+        _exit(127);
+    }
+    close(out[1]);
+    if (mock.pid < 0) {
+        close(out[0]);
+        return false;
+    }
+
+    FILE* in = fdopen(out[0], "r");
+    char line[128];
+    unsigned port = 0;
+    bool ok = in && fgets(line, sizeof(line), in) && sscanf(line, "Mock AI server on port %u", &port) == 1;
+    if (in) fclose(in);
+    mock.port = (uint16_t)port;
+    return ok && port != 0;
+}
+
+static void stopMock(MockServer& mock) {
+    if (mock.pid <= 0) return;
+    kill(mock.pid, SIGTERM);
+    waitpid(mock.pid, nullptr, 0);
+}
+
+static size_t streamed;
+
+static void onToken(const char* text, size_t len) {
+    (void)text;
+    streamed += len;
+}
+
+static void runProvider(const char* provider, const char* path) {
+    printf("\n--- %s ---\n", provider);
+
+    MockServer mock = {};
+    if (!check("mock server started", startMock(mock))) {
+        stopMock(mock);
+        return;
+    }
+
+    ESP32_AI ai("mock-key", provider);
+    ai.begin();
+    ai.setEndpoint("127.0.0.1", mock.port, path, false);
+    ai.setSystemPrompt("You are the KVN home hub.");
+    ai.onToken(onToken);
+
+    uint32_t replies = 0, streamedOk = 0, retried = 0;
+    uint32_t ttftMax = 0, totalMin = UINT32_MAX, heapPeak = 0;
+    size_t meterPeak = 0;
+    char prompt[48];
+    for (int i = 0; i < ROUNDS; i++) {
+        snprintf(prompt, sizeof(prompt), "Room %d light is 42 lux", i);
+        streamed = 0;
+        uint32_t connects = ai.stats().connects;
+
+        kvn_sim::heapMeter = {};
+        kvn_sim::heapMeter.depth = 1;   // ESP.getFreeHeap() follows what chat() allocates
+        const char* reply = ai.chat(prompt);
+        kvn_sim::heapMeter.depth = 0;
+        if (kvn_sim::heapMeter.peak > meterPeak) meterPeak = kvn_sim::heapMeter.peak;
+        const AIStats& s = ai.stats();
+        printf("  #%d %s connect=%u ms ttft=%u ms total=%u ms deltas=%u heap=%u%s\n",
+               i, s.reused ? "reused" : "new   ", (unsigned)s.connectMs, (unsigned)s.firstTokenMs,
+               (unsigned)s.totalMs, (unsigned)s.deltas, (unsigned)s.heapUsed, reply ? "" : " FAILED");
+        if (s.heapUsed > heapPeak) heapPeak = s.heapUsed;
+
+        if (reply && strstr(reply, prompt)) replies++;
+        if (reply && streamed == strlen(reply)) streamedOk++;
+        if (i > 0 && s.connects > connects) retried++;   // Kept-alive one was dead
+        if (reply) {
+            if (s.firstTokenMs > ttftMax) ttftMax = s.firstTokenMs;
+            if (s.totalMs < totalMin) totalMin = s.totalMs;
+        }
+    }
+
+    check("every reply arrives and echoes its prompt", replies == ROUNDS && streamedOk == ROUNDS,
+          "%u of %d, %u streamed whole", replies, ROUNDS, streamedOk);
+    // First delta after one word's delay; the reply takes one per word
+    check("time to first token: first word, not the reply",
+          ttftMax > 0 && ttftMax < 5 * MOCK_DELAY_MS && ttftMax * 2 < totalMin,
+          "worst %u ms, shortest reply %u ms", ttftMax, totalMin);
+    check("dropped keep-alive retried on a new connection",
+          retried == 2 && ai.stats().connects == 3 && ai.stats().failures == 0,
+          "%u retries, %u connections, %u failures", retried, (unsigned)ai.stats().connects,
+          (unsigned)ai.stats().failures);
+
+#if KVN_HEAP_METER
+    // heapUsed samples the free heap between reads; the meter sees every block
+    check("peak heap per request under the ceiling", heapPeak <= HEAP_CEILING && meterPeak <= HEAP_CEILING,
+          "heapUsed %u bytes, metered %zu, ceiling %u", heapPeak, meterPeak, HEAP_CEILING);
+#else
+    printf("  peak heap not metered under ASan\n");
+#endif
+
+    uint32_t hits = ai.stats().cacheHits;
+    uint32_t connects = ai.stats().connects;
+    streamed = 0;
+    const char* cached = ai.chat("Room 0 light is 42 lux");
+    const AIStats& s = ai.stats();
+    check("repeated prompt answered from the cache",
+          cached && s.cached && s.cacheHits == hits + 1 && s.connects == connects &&
+          s.totalMs < MOCK_DELAY_MS && streamed == strlen(cached),
+          "%u ms, %u hit(s)", (unsigned)s.totalMs, (unsigned)s.cacheHits);
+
+    stopMock(mock);
+}
+
+int main(int argc, char** argv) {
+    testSeed(argc, argv);
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("\n=== ESP32_AI against the mock server (drop every %s) ===\n", DROP_EVERY);
+    runProvider("anthropic", "/v1/messages");
+    runProvider("openai", "/v1/chat/completions");
+    return testResult();
+}
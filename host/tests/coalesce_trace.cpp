@@ -0,0 +1,16 @@
+/*
+ * coalesce_trace.cpp - The relay's COALESCE_TRACE harness, on the host
+ *
+ * runCoalescerTrace() (firmware/relay/coalesce_trace.h) replays an hour of
+ * light-sensor traffic through the Coalescer and checks the window, that
+ * every forward is the latest value, that every topic ends exactly on its
+ * last value, and the heartbeat.
+ */
+
+#include "host_test.h"
+#include "coalesce_trace.h"
+
+int main() {
+    check("COALESCE_TRACE harness", runCoalescerTrace(Serial));
+    return testResult();
+}
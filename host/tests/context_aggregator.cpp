@@ -0,0 +1,16 @@
+/*
+ * context_aggregator.cpp - The hub's CONTEXT_BENCHMARK harness, on the host
+ *
+ * runContextBenchmark() (firmware/hub_ldr/context_benchmark.h) compares
+ * per-sensor strings with batched documents over a simulated hour and
+ * checks the document size, the overflow back-off and that a failed
+ * publish keeps its changes pending.
+ */
+
+#include "host_test.h"
+#include "context_benchmark.h"
+
+int main() {
+    check("CONTEXT_BENCHMARK harness", runContextBenchmark(Serial));
+    return testResult();
+}
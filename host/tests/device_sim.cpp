@@ -0,0 +1,18 @@
+/*
+ * device_sim.cpp - The relay's DEVICE_SIMULATION harness, on the host
+ *
+ * runDeviceSimulation() (firmware/relay/device_sim.h) replays an hour of
+ * 500 devices with dropouts through the DeviceTable and checks that every
+ * long dropout is caught, with no false offlines, and that the timer
+ * wheel beats a full scan.
+ */
+
+#include "host_test.h"
+#include "device_sim.h"
+
+#define DEVICE_TIMEOUT_MS 30000   // The relay's default
+
+int main() {
+    check("DEVICE_SIMULATION harness", runDeviceSimulation(Serial, DEVICE_TIMEOUT_MS));
+    return testResult();
+}
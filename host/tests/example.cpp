@@ -0,0 +1,44 @@
+/*
+ * example.cpp - Runs one sketch on the host, outside any World
+ *
+ * Library examples and the firmware's boot-time harnesses are plain
+ * sketches that print their results. Built with KVN_EXAMPLE set to the
+ * wrapped sketch (kvn_add_example), this calls its setup() and then
+ * loop() --loops times on the host: millis()/micros() are the real clock
+ * and Serial is stdout, so timings are the host CPU's. Heap use is
+ * metered (heap_meter.cpp) and shows in ESP.getFreeHeap().
+ *
+ * PASS/FAIL is the sketch's own output; ctest fails on any FAIL line.
+ */
+
+#include "kvn_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace kvn_sim {
+extern const Sketch KVN_EXAMPLE;
+}
+
+int main(int argc, char** argv) {
+    unsigned long loops = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+            loops = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--loops N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("[%s on the host]\n", kvn_sim::KVN_EXAMPLE.name);
+    fflush(stdout);
+
+    kvn_sim::heapMeter.depth = 1;
+    kvn_sim::KVN_EXAMPLE.setup();
+    for (unsigned long i = 0; i < loops; i++) {
+        kvn_sim::KVN_EXAMPLE.loop();
+    }
+    kvn_sim::heapMeter.depth = 0;
+    return 0;
+}
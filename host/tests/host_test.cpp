@@ -0,0 +1,48 @@
+/*
+ * host_test.cpp - Implementation
+ */
+
+#include "host_test.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t failures;
+
+bool check(const char* name, bool ok) {
+    printf("  %-48s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) failures++;
+    return ok;
+}
+
+bool check(const char* name, bool ok, const char* format, ...) {
+    char detail[160];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(detail, sizeof(detail), format, args);
+    va_end(args);
+
+    printf("  %-48s %s  (%s)\n", name, ok ? "PASS" : "FAIL", detail);
+    if (!ok) failures++;
+    return ok;
+}
+
+int testResult() {
+    if (failures) printf("%u check%s failed\n", failures, failures == 1 ? "" : "s");
+    fflush(stdout);
+    return failures ? 1 : 0;
+}
+
+uint32_t testSeed(int argc, char** argv) {
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seed N]\n", argv[0]);
+            exit(2);
+        }
+    }
+    return seed;
+}
@@ -0,0 +1,24 @@
+/*
+ * host_test.h - Checks shared by the KVN host tests
+ *
+ * Every test is one executable registered with ctest (kvn_add_test()).
+ * It prints one PASS/FAIL line per check, like the on-device harnesses,
+ * and exits with testResult(): 0 when every check passed.
+ */
+
+#ifndef KVN_HOST_TEST_H
+#define KVN_HOST_TEST_H
+
+#include <stdint.h>
+
+// Prints the check and returns `ok`
+bool check(const char* name, bool ok);
+bool check(const char* name, bool ok, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+// 0 when every check so far passed, 1 otherwise
+int testResult();
+
+// --seed N (default 1); exits with usage on anything else
+uint32_t testSeed(int argc, char** argv);
+
+#endif // KVN_HOST_TEST_H
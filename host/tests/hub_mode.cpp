@@ -0,0 +1,84 @@
+/*
+ * hub_mode.cpp - The hub_ldr's retained system mode across a broker outage
+ *
+ * One room reports dark lux from the start; the hub's own light stays
+ * lit until it goes dark in the middle of a broker outage, so the flip
+ * to night_security happens while the hub cannot publish. Checks:
+ *   - the mode is published on the first connect
+ *   - after the outage the retained mode is night_security
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include "scenario.h"
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <string>
+
+using namespace kvn_sim;
+
+#define HUB_LDR_PIN       1
+#define ROOM_LUX_PIN      0
+#define ROOM_PERIOD_MS    10000
+#define OUTAGE_START_US   120000000ULL
+#define HUB_DARK_US       180000000ULL
+#define OUTAGE_END_US     300000000ULL
+#define RUN_UNTIL_US      420000000ULL
+
+static WiFiClient net;
+static PubSubClient mqtt(net);
+static uint32_t lastReport;
+
+// A room sensor: the lux on its analog pin, every ROOM_PERIOD_MS
+static void roomSetup() {
+    WiFi.begin("sim", "sim");
+    lastReport = 0;
+}
+
+static void roomLoop() {
+    if (WiFi.status() != WL_CONNECTED) return;
+    if (!mqtt.connected() && !mqtt.connect("room1")) {
+        delay(1000);
+        return;
+    }
+    if (lastReport == 0 || millis() - lastReport >= ROOM_PERIOD_MS) {
+        char lux[8];
+        snprintf(lux, sizeof(lux), "%u", (unsigned)analogRead(ROOM_LUX_PIN));
+        mqtt.publish("homeassistant/sensor/room1/lux", lux);
+        lastReport = millis();
+    }
+    delay(100);
+}
+
+static const Sketch roomSketch = {"room", roomSetup, roomLoop};
+
+int main(int argc, char** argv) {
+    uint32_t seed = testSeed(argc, argv);
+
+    printf("\n=== hub_ldr system mode, night falls during a broker outage ===\n");
+
+    World world(seed);
+    Device& hub = world.add(sketch_hub_ldr, "hub");
+    Device& room = world.add(roomSketch, "room1");
+    hub.setAnalog(HUB_LDR_PIN, [](uint64_t us) { return adcForLux(us < HUB_DARK_US ? 300 : 5); });
+    room.setAnalog(ROOM_LUX_PIN, [](uint64_t) { return (uint16_t)5; });
+    room.startAt(5000000);
+    world.broker().outage(OUTAGE_START_US, OUTAGE_END_US);
+
+    std::string mode, firstMode;
+    uint64_t modeAt = 0;
+    world.broker().tap([&](const SimMessage& m) {
+        if (m.topic != "vanguard/system/mode" || !m.retained) return;
+        if (firstMode.empty()) firstMode = m.payload;
+        mode = m.payload;
+        modeAt = m.at;
+    });
+
+    world.run(RUN_UNTIL_US);
+
+    check("mode published on connect", firstMode == "normal", "first \"%s\"", firstMode.c_str());
+    check("flip during the outage republished after it", mode == "night_security" && modeAt >= OUTAGE_END_US,
+          "last \"%s\" at %.1f s", mode.c_str(), seconds(modeAt));
+
+    return testResult();
+}
@@ -0,0 +1,230 @@
+/*
+ * hub_tasks.cpp - The P4 hub's task split on host threads
+ *
+ * The hub sketch runs outside a device, so its five tasks are host
+ * threads (hal/freertos) and really run in parallel. Radar bytes arrive
+ * through HardwareSerial::receive() from this thread, the mic fails to
+ * start, the I2C bus is empty, and MQTT goes to kvn_sim::hostBroker().
+ * Checks:
+ *   - SpscQueue across a real producer and consumer thread
+ *   - radar text frames come out as retained presence messages
+ *   - the radar task sleeps until a UART reports a burst (no fixed poll)
+ *   - a burst on all four radars passes every queue without a drop
+ *   - with the mic task stopped, diagnostics still report every task
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include "spsc_queue.h"
+#include <ESP_I2S.h>
+#include <KVN_Presence.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define SPSC_ITEMS       200000
+#define WAIT_MS          3000
+#define FRAME_PERIOD_MS  50      // One radar report per 50 ms, like the LD2420
+#define BURST_MS         500
+
+// The RD-03 ports are the sketch's own UARTs (Serial1/2 are the LD2420s)
+namespace kvn_sketch_hub {
+extern HardwareSerial ZoneRadarSerial;
+extern HardwareSerial IntentRadarSerial;
+}
+using kvn_sketch_hub::ZoneRadarSerial;
+using kvn_sketch_hub::IntentRadarSerial;
+
+static std::mutex lock;
+static std::vector<SimMessage> published;
+
+// ==================== SPSC QUEUE ====================
+
+// Every item arrives once and in order; each end yields when it must wait
+static bool spscInOrder(uint32_t& wrong) {
+    static SpscQueue<uint32_t, 64> q;
+    wrong = 0;
+
+    std::thread producer([] {
+        for (uint32_t i = 0; i < SPSC_ITEMS; i++) {
+            while (!q.push(i)) std::this_thread::yield();
+        }
+    });
+    uint32_t expect = 0, item;
+    while (expect < SPSC_ITEMS) {
+        if (!q.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (item != expect) wrong++;
+        expect = item + 1;
+    }
+    producer.join();
+    return wrong == 0 && q.size() == 0;
+}
+
+// A producer that never waits: what it cannot push is counted, the rest
+// arrives in order
+static bool spscDropsCounted(uint32_t& received, uint32_t& drops) {
+    static SpscQueue<uint32_t, 16> q;
+    std::atomic<bool> done(false);
+    received = 0;
+
+    std::thread producer([&done] {
+        for (uint32_t i = 0; i < SPSC_ITEMS; i++) {
+            q.push(i);
+            if (i % 64 == 0) std::this_thread::yield();   // Interleave, even on one core
+        }
+        done.store(true);
+    });
+    bool ordered = true;
+    uint32_t last = 0, item;
+    for (;;) {
+        bool finished = done.load();
+        if (q.pop(item)) {
+            if (received && item <= last) ordered = false;
+            last = item;
+            received++;
+        } else if (finished) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    drops = q.drops();
+    return ordered && received > 0 && drops > 0 && received + drops == SPSC_ITEMS;
+}
+
+// ==================== HUB ====================
+
+static const SimMessage* find(const std::string& topic, const char* payloadPart) {
+    for (const SimMessage& m : published) {
+        if (m.topic == topic && m.payload.find(payloadPart) != std::string::npos) return &m;
+    }
+    return nullptr;
+}
+
+// Waits until a message on `topic` contains `payloadPart`; its copy in `out`
+static bool waitFor(const std::string& topic, const char* payloadPart, SimMessage* out = nullptr) {
+    for (uint32_t start = millis(); millis() - start < WAIT_MS; delay(1)) {
+        std::lock_guard<std::mutex> guard(lock);
+        const SimMessage* m = find(topic, payloadPart);
+        if (m) {
+            if (out) *out = *m;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void sendFrame(HardwareSerial& port, uint16_t cm) {
+    char line[16];
+    int n = snprintf(line, sizeof(line), "Range %u\r\n", cm);
+    port.receive((const uint8_t*)line, n);
+}
+
+// Every "drops" in a diagnostics payload is 0
+static bool noDrops(const std::string& payload, uint32_t& queues) {
+    queues = 0;
+    for (size_t at = payload.find("\"drops\":"); at != std::string::npos;
+         at = payload.find("\"drops\":", at + 1)) {
+        if (payload.compare(at + 8, 2, "0}") != 0) return false;
+        queues++;
+    }
+    return queues > 0;
+}
+
+int main(int argc, char** argv) {
+    testSeed(argc, argv);
+
+    printf("\n=== P4 hub tasks on host threads ===\n");
+
+    uint32_t wrong = 0, received = 0, drops = 0;
+    bool inOrder = spscInOrder(wrong);
+    check("SPSC queue: in order across threads", inOrder,
+          "%u items, %u out of order", SPSC_ITEMS, wrong);
+    bool counted = spscDropsCounted(received, drops);
+    check("SPSC queue: full pushes counted as drops", counted,
+          "%u received, %u dropped", received, drops);
+
+    hostBroker().tap([](const SimMessage& m) {
+        std::lock_guard<std::mutex> guard(lock);
+        published.push_back(m);
+    });
+    // No INMP441: the mic task stops, the rest of the hub carries on
+    I2SClass::kvnFailBegin = true;
+    sketch_hub.setup();
+
+    // Cameras are probed first thing; nothing answers on the host bus
+    check("hub connects and publishes its state", waitFor("vanguard/hub/camera/1", "offline"));
+
+    TaskHandle_t radar = xTaskGetHandle("radar");
+    uint32_t idleWakes = kvnTaskWakes(radar);
+    delay(BURST_MS);
+    idleWakes = kvnTaskWakes(radar) - idleWakes;
+    check("radar task sleeps while the UARTs are quiet", radar && idleWakes == 0,
+          "%u wakes in %u ms", idleWakes, BURST_MS);
+
+    // Someone at the bed: reports until the enter debounce has passed
+    uint32_t wakes = kvnTaskWakes(radar);
+    uint32_t frames = 0;
+    for (uint32_t t = 0; t <= PRESENCE_ENTER_MS + 2 * FRAME_PERIOD_MS; t += FRAME_PERIOD_MS) {
+        sendFrame(Serial1, 120);
+        frames++;
+        delay(FRAME_PERIOD_MS);
+    }
+    wakes = kvnTaskWakes(radar) - wakes;
+    SimMessage bed;
+    bool occupied = waitFor("vanguard/hub/presence/bed", "\"occupied\":true", &bed);
+    check("bed radar -> presence/bed occupied", occupied && bed.retained,
+          "%s", occupied ? bed.payload.c_str() : "not published");
+    check("radar task wakes once per UART burst", wakes >= 1 && wakes <= frames,
+          "%u wakes for %u bursts", wakes, frames);
+
+    // All four radars at 1 kHz each, far past the real report rate
+    for (uint32_t t = 0; t < BURST_MS; t++) {
+        sendFrame(Serial1, 100);
+        sendFrame(Serial2, 110);
+        sendFrame(ZoneRadarSerial, 200);
+        sendFrame(IntentRadarSerial, 300);
+        delay(1);
+    }
+    check("door radar -> presence/door occupied", waitFor("vanguard/hub/presence/door", "\"occupied\":true"));
+    check("zone + intent radars -> presence/room occupied",
+          waitFor("vanguard/hub/presence/room", "\"occupied\":true"));
+
+    // The next diagnostics report covers the burst
+    size_t seen;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        seen = published.size();
+    }
+    SimMessage diag;
+    bool reported = false;
+    for (uint32_t start = millis(); !reported && millis() - start < WAIT_MS; delay(1)) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (size_t i = seen; i < published.size(); i++) {
+            if (published[i].topic == "vanguard/hub/diagnostics") {
+                diag = published[i];
+                reported = true;
+            }
+        }
+    }
+    uint32_t queues = 0;
+    bool clean = reported && noDrops(diag.payload, queues);
+    check("burst: no queue drops", clean, "%u queues reported", queues);
+    check("diagnostics list every task", reported &&
+          diag.payload.find("\"name\":\"radar\"") != std::string::npos &&
+          diag.payload.find("\"name\":\"network\"") != std::string::npos);
+    check("mic failed to start: still listed, 0% CPU", reported &&
+          diag.payload.find("\"name\":\"mic\",\"cpu\":0.00") != std::string::npos);
+
+    // The hub's tasks never return: leave without running destructors
+    // under them
+    _Exit(testResult());
+}
@@ -0,0 +1,134 @@
+/*
+ * ldr_array.cpp - KVN_LDRArray and per-instance change detection
+ *
+ * Two channels sampled together, as in examples/MultiChannel: a window
+ * (300 counts deadband, 60 s minimum interval) and a room (150 counts,
+ * 5 s). Two more KVN_LDRs outside the array call hasChanged(200). The
+ * ADC inputs step on a script; checks:
+ *   - a step past one channel's deadband publishes that channel only
+ *   - a return inside the deadband of the last publish publishes nothing
+ *   - a flickering input publishes no faster than the minimum interval
+ *   - hasChanged() keeps its reference per instance: no cross-talk
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include <KVN_LDR.h>
+#include <KVN_LDRArray.h>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define SAMPLE_MS     250
+#define BASE_ADC      2000
+#define WINDOW_PIN    0
+#define ROOM_PIN      1
+#define STEP_PIN      2      // Outside the array: hasChanged() only
+#define STILL_PIN     3
+
+#define ROOM_STEP_S   10     // Room +250: past its deadband, not the window's
+#define RETURN_S      30     // Room back by 100, window +250: inside both
+#define FLICKER_S     50     // Room flickers 1000/3500 each second, window +1000
+#define END_S         80
+
+static KVN_LDR windowLight(WINDOW_PIN);
+static KVN_LDR roomLight(ROOM_PIN);
+static KVN_LDR stepLight(STEP_PIN);
+static KVN_LDR stillLight(STILL_PIN);
+static KVN_LDRArray lights;
+
+struct Publish {
+    uint8_t channel;
+    uint32_t ms;
+};
+static std::vector<Publish> published;
+static uint32_t stepChanges, stillChanges;
+
+static void arraySetup() {
+    windowLight.setDeadband(300);
+    windowLight.setMinPublishInterval(60000);
+    roomLight.setDeadband(150);
+    roomLight.setMinPublishInterval(5000);
+    lights.add(windowLight);
+    lights.add(roomLight);
+    lights.begin();
+    stepLight.begin();
+    stillLight.begin();
+}
+
+static void arrayLoop() {
+    uint32_t changed = lights.sampleAll();
+    for (uint8_t i = 0; i < lights.size(); i++) {
+        if (changed & (1UL << i)) published.push_back({i, (uint32_t)millis()});
+    }
+    if (stepLight.hasChanged(200)) stepChanges++;
+    if (stillLight.hasChanged(200)) stillChanges++;
+    delay(SAMPLE_MS);
+}
+
+static const Sketch arraySketch = {"ldr_array", arraySetup, arrayLoop};
+
+static uint64_t atUs(uint32_t s) { return s * 1000000ULL; }
+
+static uint16_t windowAdc(uint64_t us) {
+    if (us >= atUs(FLICKER_S)) return BASE_ADC + 1000;
+    return us >= atUs(RETURN_S) ? BASE_ADC + 250 : BASE_ADC;
+}
+
+static uint16_t roomAdc(uint64_t us) {
+    if (us >= atUs(FLICKER_S)) return (us / 1000000) % 2 ? 3500 : 1000;
+    if (us >= atUs(RETURN_S)) return BASE_ADC + 150;
+    return us >= atUs(ROOM_STEP_S) ? BASE_ADC + 250 : BASE_ADC;
+}
+
+// Publishes of `channel` in [fromS, toS)
+static uint32_t count(uint8_t channel, uint32_t fromS, uint32_t toS) {
+    uint32_t n = 0;
+    for (const Publish& p : published) n += p.channel == channel && p.ms >= fromS * 1000 && p.ms < toS * 1000;
+    return n;
+}
+
+// Shortest time between two publishes of `channel`
+static uint32_t minGap(uint8_t channel) {
+    uint32_t gap = UINT32_MAX, last = 0;
+    bool any = false;
+    for (const Publish& p : published) {
+        if (p.channel != channel) continue;
+        if (any && p.ms - last < gap) gap = p.ms - last;
+        last = p.ms;
+        any = true;
+    }
+    return gap;
+}
+
+int main(int argc, char** argv) {
+    uint32_t seed = testSeed(argc, argv);
+
+    printf("\n=== KVN_LDRArray: window (300, 60 s) and room (150, 5 s) ===\n");
+
+    World world(seed);
+    Device& device = world.add(arraySketch, "ldr_array");
+    device.setAnalog(WINDOW_PIN, windowAdc);
+    device.setAnalog(ROOM_PIN, roomAdc);
+    // One 350-count step: one crossing of the 200 threshold as the EMA follows
+    device.setAnalog(STEP_PIN, [](uint64_t us) { return (uint16_t)(us >= atUs(ROOM_STEP_S) ? BASE_ADC + 350 : BASE_ADC); });
+    device.setAnalog(STILL_PIN, [](uint64_t) { return (uint16_t)BASE_ADC; });
+    world.run(atUs(END_S));
+
+    const uint8_t window = 0, room = 1;
+    check("first sample publishes every channel", count(window, 0, 1) == 1 && count(room, 0, 1) == 1);
+    check("step past the room's deadband: room only",
+          count(room, ROOM_STEP_S, RETURN_S) == 1 && count(window, ROOM_STEP_S, RETURN_S) == 0,
+          "room %u, window %u", count(room, ROOM_STEP_S, RETURN_S), count(window, ROOM_STEP_S, RETURN_S));
+    check("moves inside the deadband publish nothing",
+          count(room, RETURN_S, FLICKER_S) == 0 && count(window, RETURN_S, FLICKER_S) == 0,
+          "room %u, window %u", count(room, RETURN_S, FLICKER_S), count(window, RETURN_S, FLICKER_S));
+    check("flicker: room at most every 5 s", count(room, FLICKER_S, END_S) >= 2 && minGap(room) >= 5000,
+          "%u publishes, shortest gap %u ms", count(room, FLICKER_S, END_S), minGap(room));
+    check("window held to its 60 s interval", count(window, FLICKER_S, END_S) == 1 && minGap(window) >= 60000,
+          "shortest gap %u ms", minGap(window));
+    check("hasChanged() reference per instance", stepChanges == 2 && stillChanges == 1,
+          "stepped %u, still %u (first call counts)", stepChanges, stillChanges);
+
+    return testResult();
+}
@@ -0,0 +1,15 @@
+/*
+ * light_aggregator.cpp - The hub's LIGHT_BENCHMARK harness, on the host
+ *
+ * runLightBenchmark() (firmware/hub_ldr/light_benchmark.h) times the
+ * LightAggregator and checks flips, the all-dark predicate, the rolling
+ * window against brute force, and expiry.
+ */
+
+#include "host_test.h"
+#include "light_benchmark.h"
+
+int main() {
+    check("LIGHT_BENCHMARK harness", runLightBenchmark(Serial));
+    return testResult();
+}
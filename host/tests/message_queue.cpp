@@ -0,0 +1,195 @@
+/*
+ * message_queue.cpp - The relay's store-and-forward queue across broker outages
+ *
+ * A producer device numbers a reading every 100 ms and publishes it
+ * through MessageQueue (8 RAM slots, spilling to LittleFS). The broker
+ * goes down for 30 s; the test checks what comes out the other side:
+ * order, loss, which end a full queue evicts, how often the spill header
+ * is committed to flash, and what a reboot mid-outage keeps.
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include "message_queue.h"
+#include <LittleFS.h>
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define RAM_SLOTS       8
+#define PUSH_PERIOD_MS  100
+#define OUTAGE_START_US 10000000ULL
+#define OUTAGE_END_US   40000000ULL
+#define PRODUCE_UNTIL   60000           // Device millis(); the backlog drains after
+#define RUN_UNTIL_US    90000000ULL
+
+static WiFiClient net;
+static PubSubClient mqtt(net);
+static QueuedMessage slots[RAM_SLOTS];
+static MessageQueue queue(slots, RAM_SLOTS);
+
+// Set by the test for each case; the sequence survives reboots
+static QueuePolicy policy;
+static uint32_t spillMax;
+static uint32_t nextSeq;
+static bool rebootNow;
+static size_t keptAfterReboot;
+
+static uint32_t lastPush, lastTry;
+
+static void producerSetup() {
+    queue = MessageQueue(slots, RAM_SLOTS, policy);
+    LittleFS.begin(true);
+    queue.beginSpill(LittleFS, "/spill.bin", spillMax);
+    keptAfterReboot = queue.size();
+
+    WiFi.begin("sim", "sim");
+    lastPush = millis();
+    lastTry = 0;
+}
+
+static void producerLoop() {
+    if (rebootNow) {
+        rebootNow = false;
+        ESP.restart();
+    }
+
+    // Catch up after blocking calls (a failed connect takes 3 s)
+    uint32_t now = millis();
+    while (nextSeq < PRODUCE_UNTIL / PUSH_PERIOD_MS && now - lastPush >= PUSH_PERIOD_MS) {
+        char payload[12];
+        snprintf(payload, sizeof(payload), "%u", (unsigned)nextSeq++);
+        queue.push("kvn/queue/seq", payload);
+        lastPush += PUSH_PERIOD_MS;
+    }
+    queue.poll(millis());
+
+    if (WiFi.status() != WL_CONNECTED) return;
+    if (!mqtt.connected()) {
+        if (millis() - lastTry >= 1000) {
+            lastTry = millis();
+            mqtt.connect("queue");
+        }
+        return;
+    }
+    mqtt.loop();
+    queue.drain(mqtt, 5);
+    delay(10);
+}
+
+static const Sketch producer = {"producer", producerSetup, producerLoop};
+
+struct QueueRun {
+    std::vector<uint32_t> delivered;   // Sequence numbers, in arrival order
+    uint32_t produced;
+    uint32_t dropped;
+    size_t keptAfterReboot;
+    FlashStats outageFlash;            // Flash traffic during the outage
+};
+
+static QueueRun runQueue(QueuePolicy p, uint32_t maxRecords, uint64_t rebootAtUs, uint32_t seed) {
+    policy = p;
+    spillMax = maxRecords;
+    nextSeq = 0;
+    rebootNow = false;
+    keptAfterReboot = 0;
+
+    QueueRun run = {};
+    World world(seed);
+    world.broker().outage(OUTAGE_START_US, OUTAGE_END_US);
+    world.broker().tap([&run](const SimMessage& m) {
+        run.delivered.push_back((uint32_t)strtoul(m.payload.c_str(), nullptr, 10));
+    });
+    Device& device = world.add(producer, "producer");
+
+    world.run(OUTAGE_START_US);
+    FlashStats before = device.flashStats();
+    if (rebootAtUs) {
+        world.run(rebootAtUs);
+        rebootNow = true;
+    }
+    world.run(OUTAGE_END_US);
+    FlashStats after = device.flashStats();
+    run.outageFlash.writes = after.writes - before.writes;
+    run.outageFlash.bytes = after.bytes - before.bytes;
+    run.outageFlash.flushes = after.flushes - before.flushes;
+
+    world.run(RUN_UNTIL_US);
+    run.produced = nextSeq;
+    run.dropped = queue.droppedCount();
+    run.keptAfterReboot = keptAfterReboot;
+    return run;
+}
+
+static bool strictlyIncreasing(const std::vector<uint32_t>& seqs) {
+    for (size_t i = 1; i < seqs.size(); i++) {
+        if (seqs[i] <= seqs[i - 1]) return false;
+    }
+    return true;
+}
+
+// Sequence numbers never delivered, as [first, last] runs
+static std::vector<std::pair<uint32_t, uint32_t>> gaps(const QueueRun& run) {
+    std::vector<bool> seen(run.produced, false);
+    for (uint32_t s : run.delivered) {
+        if (s < run.produced) seen[s] = true;
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> out;
+    for (uint32_t s = 0; s < run.produced; s++) {
+        if (seen[s]) continue;
+        if (!out.empty() && out.back().second == s - 1) out.back().second = s;
+        else out.push_back({s, s});
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    uint32_t seed = testSeed(argc, argv);
+
+    printf("\n=== Message queue (%d RAM slots, 30 s broker outage) ===\n", RAM_SLOTS);
+
+    // Room for the whole outage: nothing may be lost
+    QueueRun fits = runQueue(QUEUE_OVERWRITE_OLDEST, 1000, 0, seed);
+    check("backlog delivered in order, exactly once",
+          strictlyIncreasing(fits.delivered) && fits.delivered.size() == fits.produced &&
+          fits.dropped == 0, "%zu of %u delivered, %u dropped",
+          fits.delivered.size(), fits.produced, fits.dropped);
+
+    uint64_t records = fits.outageFlash.bytes / sizeof(QueuedMessage);
+    uint64_t maxFlushes = (OUTAGE_END_US - OUTAGE_START_US) / 1000 / QUEUE_SPILL_SYNC_MS + 2;
+    check("spill header committed per sync period",
+          records > 200 && fits.outageFlash.flushes <= maxFlushes,
+          "%llu records spilled, %llu flushes (limit %llu)",
+          (unsigned long long)records, (unsigned long long)fits.outageFlash.flushes,
+          (unsigned long long)maxFlushes);
+
+    // 48 messages of room for ~300: the oldest go, in RAM and in flash
+    QueueRun overwrite = runQueue(QUEUE_OVERWRITE_OLDEST, 40, 0, seed);
+    auto lost = gaps(overwrite);
+    check("overwrite-oldest keeps the newest, one gap",
+          strictlyIncreasing(overwrite.delivered) && lost.size() == 1 &&
+          lost[0].second - lost[0].first + 1 == overwrite.dropped,
+          "%zu gap(s), %u dropped", lost.size(), overwrite.dropped);
+
+    QueueRun dropNewest = runQueue(QUEUE_DROP_NEWEST, 40, 0, seed);
+    lost = gaps(dropNewest);
+    check("drop-newest keeps the oldest, one gap",
+          strictlyIncreasing(dropNewest.delivered) && lost.size() == 1 &&
+          lost[0].first > 0 && lost[0].second - lost[0].first + 1 == dropNewest.dropped,
+          "%zu gap(s), %u dropped", lost.size(), dropNewest.dropped);
+
+    // Reboot 17 s into the outage: RAM is gone, flash is kept up to the
+    // last header commit
+    QueueRun reboot = runQueue(QUEUE_OVERWRITE_OLDEST, 1000, 27000000ULL, seed);
+    uint32_t missing = reboot.produced - (uint32_t)reboot.delivered.size();
+    uint32_t allowed = RAM_SLOTS + QUEUE_SPILL_SYNC_MS / PUSH_PERIOD_MS + 1;
+    check("reboot keeps the committed spill, in order",
+          strictlyIncreasing(reboot.delivered) && reboot.keptAfterReboot > 100 && missing <= allowed,
+          "%zu kept across the reboot, %u lost (limit %u)",
+          reboot.keptAfterReboot, missing, allowed);
+
+    return testResult();
+}
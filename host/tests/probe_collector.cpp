@@ -0,0 +1,141 @@
+/*
+ * probe_collector.cpp - KVN_ProbeCollector loss accounting and percentiles
+ *
+ * Feeds one source's probes in a scripted order, stamped 1 ms apart on
+ * the sender's clock, and checks the totals:
+ *   - reordered and gap-filling probes count as late, not lost
+ *   - a repeated probe is a duplicate, with no latency sample
+ *   - a probe from before a long run of newer ones is late, not a restart
+ *   - a sender restarting at 0, early (inside the 32-probe window) or
+ *     late, counts one restart and no duplicates
+ * and the histogram: exact below 8 us, buckets within 12.5% above, and
+ * percentiles of a known distribution.
+ */
+
+#include "host_test.h"
+#include <KVN_Probe.h>
+#include <vector>
+
+#define SENT_BASE_US   1700000000000000ULL   // Wall clock, as on hardware
+#define PERIOD_US      1000
+#define LATENCY_US     5000
+
+struct Probe {
+    uint32_t seq;
+    uint32_t slot;   // Send time, in periods since SENT_BASE_US
+};
+
+static void feed(KVN_ProbeCollector& c, uint32_t seq, uint64_t sentUs, uint32_t latencyUs) {
+    char payload[40];
+    size_t n = KVN_Probe::format(payload, sizeof(payload), seq, sentUs);
+    c.record("s1", 2, (const uint8_t*)payload, n, sentUs + latencyUs);
+}
+
+static KVNProbeStats run(const std::vector<Probe>& probes) {
+    KVN_ProbeCollector c;
+    for (const Probe& p : probes) feed(c, p.seq, SENT_BASE_US + (uint64_t)p.slot * PERIOD_US, LATENCY_US);
+    return c.stats();
+}
+
+// Probes first..last, sent in consecutive slots from `slot`
+static void sequence(std::vector<Probe>& probes, uint32_t first, uint32_t last, uint32_t& slot) {
+    for (uint32_t seq = first; seq <= last; seq++) probes.push_back({seq, slot++});
+}
+
+// Upper edge of the bucket `us` falls in: the p50 of {us, UINT32_MAX}
+static uint32_t bucketTopOf(uint32_t us) {
+    KVN_ProbeCollector c;
+    feed(c, 0, SENT_BASE_US, us);
+    feed(c, 1, SENT_BASE_US, UINT32_MAX);
+    return c.percentile(50);
+}
+
+int main(int argc, char** argv) {
+    testSeed(argc, argv);
+
+    printf("\n=== KVN_ProbeCollector ===\n");
+
+    uint32_t slot = 0;
+    KVNProbeStats s = run({{0, 0}, {1, 1}, {3, 3}, {2, 2}, {4, 4}});
+    check("reorder: late, nothing lost", s.received == 5 && s.late == 1 && s.lost == 0 && s.duplicates == 0,
+          "received %u, late %u, lost %u", s.received, s.late, s.lost);
+
+    s = run({{0, 0}, {1, 1}, {5, 5}, {3, 3}});
+    check("gap: lost until filled", s.received == 4 && s.lost == 2 && s.late == 1,
+          "received %u, lost %u, late %u", s.received, s.lost, s.late);
+
+    s = run({{0, 0}, {1, 1}, {2, 2}, {1, 1}});
+    check("duplicate: counted, no sample", s.received == 3 && s.duplicates == 1,
+          "received %u, duplicates %u", s.received, s.duplicates);
+
+    // Probe 10 held back behind 89 newer ones: below 32 and far behind
+    std::vector<Probe> probes;
+    slot = 0;
+    sequence(probes, 0, 9, slot);
+    slot++;
+    sequence(probes, 11, 99, slot);
+    probes.push_back({10, 10});
+    s = run(probes);
+    check("far-behind probe: late, not a restart", s.late == 1 && s.restarts == 0 && s.lost == 0,
+          "late %u, restarts %u, lost %u", s.late, s.restarts, s.lost);
+
+    probes.clear();
+    slot = 0;
+    sequence(probes, 0, 19, slot);
+    sequence(probes, 0, 9, slot);   // Rebooted at 20: inside the window
+    s = run(probes);
+    check("early restart: no duplicates", s.restarts == 1 && s.duplicates == 0 && s.received == 30 && s.lost == 0,
+          "restarts %u, duplicates %u, received %u, lost %u", s.restarts, s.duplicates, s.received, s.lost);
+
+    probes.clear();
+    slot = 0;
+    sequence(probes, 0, 499, slot);
+    sequence(probes, 0, 9, slot);
+    s = run(probes);
+    check("late restart: no duplicates", s.restarts == 1 && s.duplicates == 0 && s.received == 510 && s.lost == 0,
+          "restarts %u, duplicates %u, received %u, lost %u", s.restarts, s.duplicates, s.received, s.lost);
+
+    // The first probe after the reboot overtaken by the second
+    probes.clear();
+    slot = 0;
+    sequence(probes, 0, 19, slot);
+    probes.push_back({1, slot + 1});
+    probes.push_back({0, slot});
+    s = run(probes);
+    check("restart, reordered: the first is late", s.restarts == 1 && s.late == 1 && s.lost == 0 &&
+          s.duplicates == 0, "restarts %u, late %u, lost %u", s.restarts, s.late, s.lost);
+
+    // Histogram: every bucket edge up to 2^32
+    std::vector<uint32_t> values;
+    for (uint32_t us = 0; us < 300; us++) values.push_back(us);
+    for (int bit = 8; bit < 32; bit++) {
+        uint32_t p = 1UL << bit;
+        values.insert(values.end(), {p - 1, p, p + 1, p + p / 2});
+    }
+    values.push_back(UINT32_MAX - 1);
+    uint32_t exactWrong = 0, wide = 0, worstUs = 0;
+    for (uint32_t us : values) {
+        uint32_t top = bucketTopOf(us);
+        if (us < 8 && top != us) exactWrong++;
+        if (top < us || top - us > us / 8) {
+            wide++;
+            worstUs = us;
+        }
+    }
+    check("buckets: exact below 8 us", exactWrong == 0, "%u wrong", exactWrong);
+    check("buckets: upper edge within 12.5%", wide == 0, "%zu values, %u outside (last %u us)", values.size(),
+          wide, worstUs);
+
+    KVN_ProbeCollector c;
+    check("percentile of nothing is 0", c.percentile(50) == 0);
+    for (uint32_t i = 1; i <= 100; i++) feed(c, i, SENT_BASE_US + i * PERIOD_US, i);
+    // 50 is in [48, 51], 90 in [88, 95]; p100 and 99 are capped at the max
+    uint32_t p0 = c.percentile(0), p50 = c.percentile(50), p90 = c.percentile(90);
+    uint32_t p99 = c.percentile(99), p100 = c.percentile(100);
+    check("percentiles of 1..100 us", p0 == 1 && p50 == 51 && p90 == 95 && p99 == 100 && p100 == 100,
+          "p0 %u, p50 %u, p90 %u, p99 %u, p100 %u", p0, p50, p90, p99, p100);
+    check("min / mean / max", c.stats().minUs == 1 && c.stats().meanUs() == 50 && c.stats().maxUs == 100,
+          "%u / %u / %u", c.stats().minUs, c.stats().meanUs(), c.stats().maxUs);
+
+    return testResult();
+}
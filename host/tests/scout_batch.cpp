@@ -0,0 +1,71 @@
+/*
+ * scout_batch.cpp - The C3 Scout's light_batch after a long broker outage
+ *
+ * The scout keeps waking while the broker is down for a day, so its ring
+ * of WAKE_RING_SIZE readings fills. The first uplink afterwards must carry
+ * the whole ring in one light_batch, which is larger than PubSubClient's
+ * default 256-byte buffer, and the readings must leave the ring only once
+ * that publish succeeded.
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include "wake_scheduler.h"
+#include <PubSubClient.h>
+#include <string>
+#include <vector>
+
+using namespace kvn_sim;
+
+#define SCOUT_LDR_PIN 0
+
+static size_t readingsIn(const std::string& payload) {
+    size_t n = 0;
+    for (size_t i = payload.find("\"readings\":["); i != std::string::npos && i < payload.size(); i++) {
+        if (payload[i] == '[') n++;
+    }
+    return n ? n - 1 : 0;   // Less the outer array
+}
+
+int main(int argc, char** argv) {
+    World world(testSeed(argc, argv));
+    Device& scout = world.add(sketch_scout_ldr, "scout1");
+
+    // Light that keeps changing, so every wake records a reading
+    scout.setAnalog(SCOUT_LDR_PIN, [](uint64_t us) {
+        return (uint16_t)(1000 + (us / 60000000ULL) % 2 * 1500);
+    });
+
+    const uint64_t outageStart = hoursUs(1);
+    const uint64_t outageEnd = hoursUs(25);
+    world.broker().outage(outageStart, outageEnd);
+
+    std::vector<SimMessage> batches;
+    world.broker().tap([&](const SimMessage& m) {
+        if (m.topic.find("/light_batch") != std::string::npos) batches.push_back(m);
+    });
+
+    world.run(hoursUs(30));
+
+    printf("\n=== Scout light_batch across a 24 h broker outage ===\n");
+
+    const SimMessage* first = nullptr;
+    size_t afterOutage = 0;
+    for (const SimMessage& m : batches) {
+        if (m.at < outageEnd) continue;
+        if (!first) first = &m;
+        afterOutage++;
+    }
+
+    check("uplinks resume after the outage", afterOutage > 0, "%zu batches", afterOutage);
+    size_t readings = first ? readingsIn(first->payload) : 0;
+    check("first batch carries the full ring", readings == WAKE_RING_SIZE,
+          "%zu readings", readings);
+
+    // PUBLISH: fixed header (up to 5), topic length (2), topic, payload
+    size_t packet = first ? 5 + 2 + first->topic.size() + first->payload.size() : 0;
+    check("full-ring packet exceeds the default buffer", packet > MQTT_MAX_PACKET_SIZE,
+          "%zu bytes > %d", packet, MQTT_MAX_PACKET_SIZE);
+
+    return testResult();
+}
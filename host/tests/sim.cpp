@@ -0,0 +1,106 @@
+/*
+ * sim.cpp - The simulator and HAL the other host tests stand on
+ *
+ * Topic matching, retained messages, persistent sessions across a broker
+ * outage, the broker's bounded queue, PubSubClient's buffer limit, and
+ * the host clock outside any device.
+ */
+
+#include "kvn_sim.h"
+#include "host_test.h"
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <string>
+#include <vector>
+
+using namespace kvn_sim;
+
+static WiFiClient net;
+static PubSubClient mqtt(net);
+static std::vector<std::string> inbox;
+static bool tryPublish;
+static bool smallSent, largeSent;
+
+static void onMessage(char* topic, uint8_t* payload, unsigned int length) {
+    inbox.push_back(std::string(topic) + "=" + std::string((const char*)payload, length));
+}
+
+// Subscriber with a persistent session; reconnects whenever it is dropped
+static void subSetup() {
+    WiFi.begin("sim", "sim");
+    mqtt.setCallback(onMessage);
+}
+
+static void subLoop() {
+    if (WiFi.status() != WL_CONNECTED) return;
+    if (!mqtt.connected()) {
+        if (mqtt.connect("sub", nullptr, nullptr, nullptr, 0, false, nullptr, false)) {
+            mqtt.subscribe("kvn/+/lux");
+        }
+        return;
+    }
+    mqtt.loop();
+
+    if (tryPublish) {
+        tryPublish = false;
+        mqtt.setBufferSize(64);
+        smallSent = mqtt.publish("kvn/hall/lux", "14");
+        largeSent = mqtt.publish("kvn/hall/lux", std::string(64, 'x').c_str());
+    }
+}
+
+static const Sketch subscriber = {"subscriber", subSetup, subLoop};
+
+int main(int argc, char** argv) {
+    World world(testSeed(argc, argv));
+
+    printf("\n=== Host simulator ===\n");
+
+    check("'+' matches one level", Broker::matches("a/+/c", "a/b/c") && !Broker::matches("a/+/c", "a/b/d/c"));
+    check("'#' matches the rest, and its parent", Broker::matches("a/#", "a/b/c") && Broker::matches("a/#", "a"));
+    check("levels compare whole", !Broker::matches("a/b", "a/bc") && !Broker::matches("a/b/c", "a/b"));
+
+    // A retained reading before the subscriber exists, live ones after
+    world.broker().publish("kvn/hall/lux", "12", true, 0);
+    world.add(subscriber, "sub");
+    world.run(5000000);
+    world.broker().publish("kvn/hall/lux", "13", false, 5000000);
+    world.broker().publish("kvn/hall/temp", "20", false, 5000000);
+    world.run(6000000);
+    check("retained value first, then live ones, filtered",
+          inbox == std::vector<std::string>({"kvn/hall/lux=12", "kvn/hall/lux=13"}));
+
+    // The broker restarts: the persistent session keeps its subscription
+    world.broker().outage(10000000, 15000000);
+    world.run(20000000);
+    Broker::Session* s = world.broker().session("sub");
+    world.broker().publish("kvn/porch/lux", "400", false, 20000000);
+    world.run(21000000);
+    check("subscription survives a broker outage",
+          s != nullptr && s->connected && inbox.back() == "kvn/porch/lux=400");
+
+    // A queue bounded like max_queued_messages
+    world.broker().setMaxQueued(10);
+    size_t before = inbox.size();
+    for (int i = 0; i < 25; i++) {
+        world.broker().publish("kvn/hall/lux", std::to_string(i), false, 21000000);
+    }
+    world.run(22000000);
+    check("a full queue drops, and counts the drops",
+          inbox.size() - before == 10 && s->dropped == 15, "%zu received, %u dropped",
+          inbox.size() - before, s->dropped);
+
+    // Like the real client: one buffer for header, topic and payload
+    tryPublish = true;
+    world.run(23000000);
+    check("publish larger than the buffer is refused", smallSent && !largeSent);
+
+    // Outside any device: the host's clock and stdout
+    unsigned long t0 = millis();
+    delay(20);
+    unsigned long elapsed = millis() - t0;
+    check("host clock outside devices", World::onHost() && elapsed >= 20 && elapsed < 1000,
+          "delay(20) took %lu ms", elapsed);
+
+    return testResult();
+}
@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+codec_refs.py - Reference PCM for kvn_bench_audio_codecs from ffmpeg
+
+    python3 host/tools/codec_refs.py <out dir> [file...]
+    host/build/kvn_bench_audio_codecs --ref <out dir>
+
+Decodes each file (default: the ESP32-audioI2S test files) to
+<out dir>/<file name>.wav, 16 bit, at the file's own rate and channel
+count. The bench aligns the start, so the decoders' priming and delay
+need not match.
+
+    python3 host/tools/codec_refs.py --encode <files dir> [source]
+    python3 host/tools/codec_refs.py <out dir> <files dir>/*
+    host/build/kvn_bench_audio_codecs --ref <out dir> <files dir>/*
+
+Encodes the source (default: Santiano-Wellerman.flac, lossless) once per
+lossy codec at a second, lower bitrate than the bundled file (ENCODES).
+The bundled corpus has one file per codec, plus a CBR MP3 in the lyrics
+example; these cover the rest. They are not bundled or pinned: there is
+no encoder in the build sandbox, so they are checked with --ref only.
+"""
+
+import os
+import shutil
+import subprocess
+import sys
+
+TESTFILES = os.path.join(os.path.dirname(__file__), "..", "..", "Demos", "ESP32-S3-Touch-LCD-3.5-Demo", "Arduino",
+                         "libraries", "ESP32-audioI2S-master", "additional_info", "Testfiles")
+EXTENSIONS = (".mp3", ".aac", ".m4a", ".flac", ".ogg", ".opus")
+
+# Output name suffix and ffmpeg codec options
+ENCODES = (
+    ("64k.mp3", ["-c:a", "libmp3lame", "-b:a", "64k"]),
+    ("64k.m4a", ["-c:a", "aac", "-b:a", "64k"]),
+    ("64k.ogg", ["-c:a", "libvorbis", "-b:a", "64k"]),
+    ("32k.opus", ["-c:a", "libopus", "-b:a", "32k", "-ar", "48000"]),
+)
+
+
+def encode(out_dir, source):
+    os.makedirs(out_dir, exist_ok=True)
+    stem = os.path.splitext(os.path.basename(source))[0]
+    for suffix, options in ENCODES:
+        out = os.path.join(out_dir, stem + "." + suffix)
+        subprocess.run(["ffmpeg", "-v", "error", "-y", "-i", source] + options + [out], check=True)
+        print(out)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip().splitlines()[2].strip(), file=sys.stderr)
+        sys.exit(2)
+    if not shutil.which("ffmpeg"):
+        print("ffmpeg not found", file=sys.stderr)
+        sys.exit(2)
+
+    if sys.argv[1] == "--encode":
+        if len(sys.argv) < 3:
+            print(__doc__.strip().splitlines()[10].strip(), file=sys.stderr)
+            sys.exit(2)
+        encode(sys.argv[2], sys.argv[3] if len(sys.argv) > 3 else os.path.join(TESTFILES, "Santiano-Wellerman.flac"))
+        return
+
+    out_dir = sys.argv[1]
+    files = sys.argv[2:] or sorted(os.path.join(TESTFILES, f) for f in os.listdir(TESTFILES))
+    os.makedirs(out_dir, exist_ok=True)
+    for path in files:
+        if not path.lower().endswith(EXTENSIONS):
+            continue
+        ref = os.path.join(out_dir, os.path.basename(path) + ".wav")
+        subprocess.run(["ffmpeg", "-v", "error", "-y", "-i", path, "-c:a", "pcm_s16le", "-f", "wav", ref], check=True)
+        print(ref)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+ino2cpp.py - Wrap an Arduino sketch for the KVN host build
+
+Does what the Arduino builder does to a .ino (prototypes for every
+function, so they can be called before their definition) and puts the
+sketch in its own namespace, so several sketches link into one
+simulator. The result exports kvn_sim::sketch_<role>.
+
+    ino2cpp.py <sketch.ino> <role> <output.cpp>
+
+Top-level #include lines are moved out of the namespace. The sketch's
+own headers are included by absolute path; any secrets.h becomes
+host/secrets.h (found on the include path).
+
+Plain scalar globals outside RTC_DATA_ATTR are RAM: a reset or a deep
+sleep wake loses them. The sketch's reset function puts them back to
+their initializers, which the simulator calls before every setup() but
+the first. Objects (String, clients, drivers) are left as they are.
+"""
+
+import os
+import re
+import sys
+
+FUNCTION = re.compile(
+    r"^(?!(?:if|else|for|while|switch|return|class|struct|enum|typedef|namespace|static_assert)\b)"
+    r"([A-Za-z_][\w:<>,\s\*&]*?[\s\*&])([A-Za-z_]\w*)\s*\(([^;{}]*)\)\s*(?:const\s*)?\{?\s*(?://.*)?$"
+)
+INCLUDE = re.compile(r'^\s*#\s*include\s*([<"])([^>"]+)[>"]')
+DEFAULT = re.compile(r"\s*=\s*[^,]+")
+RAM_SCALAR = re.compile(
+    r"^(?:static\s+)?(?:volatile\s+)?(?:bool|char|int|long|unsigned(?:\s+(?:int|long|char))?|float|double|size_t|u?int(?:8|16|32|64)_t)"
+    r"\s+([A-Za-z_]\w*)\s*(?:=\s*([^;{}]+?))?\s*;\s*(?://.*)?$"
+)
+
+
+def hoist_include(line, sketch_dir):
+    m = INCLUDE.match(line)
+    quote, path = m.group(1), m.group(2)
+    if quote == "<":
+        return "#include <%s>" % path
+    if os.path.basename(path) == "secrets.h":
+        return '#include "secrets.h"'
+    local = os.path.normpath(os.path.join(sketch_dir, path))
+    if os.path.exists(local):
+        return '#include "%s"' % local
+    return '#include "%s"' % path
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.stderr.write("usage: ino2cpp.py <sketch.ino> <role> <output.cpp>\n")
+        return 2
+
+    ino, role, out = os.path.abspath(sys.argv[1]), sys.argv[2], sys.argv[3]
+    sketch_dir = os.path.dirname(ino)
+    with open(ino, encoding="utf-8") as f:
+        lines = f.read().split("\n")
+
+    includes = []
+    body = []
+    prototypes = []
+    resets = []        # RAM scalars: name = initializer
+    first_function = None
+    depth = 0          # Brace depth: only top-level definitions get prototypes
+    in_comment = False
+
+    for number, line in enumerate(lines, 1):
+        stripped = line.strip()
+
+        if depth == 0 and not in_comment and INCLUDE.match(line):
+            includes.append((number, hoist_include(line, sketch_dir)))
+            body.append("")   # Keep line numbers
+            continue
+
+        if depth == 0 and not in_comment and not line[:1].isspace():
+            scalar = RAM_SCALAR.match(line)
+            if scalar:
+                resets.append("    %s = %s;" % (scalar.group(1), scalar.group(2) or "{}"))
+            m = FUNCTION.match(line)
+            following = next((l.strip() for l in lines[number:] if l.strip()), "")
+            if m and (stripped.endswith("{") or following.startswith("{")):
+                ret, name, args = m.group(1).strip(), m.group(2), m.group(3).strip()
+                prototypes.append("%s %s(%s);" % (ret, name, args))
+                # Default arguments may only be given once: in the prototype
+                if "=" in args:
+                    line = line.replace(args, DEFAULT.sub("", args), 1)
+                if first_function is None:
+                    first_function = len(body)
+
+        body.append(line)
+
+        # Track braces outside comments and string literals
+        code = re.sub(r'"(\\.|[^"\\])*"', '""', line)
+        code = re.sub(r"'(\\.|[^'\\])*'", "''", code)
+        i = 0
+        while i < len(code):
+            if in_comment:
+                end = code.find("*/", i)
+                if end < 0:
+                    break
+                in_comment = False
+                i = end + 2
+                continue
+            if code.startswith("//", i):
+                break
+            if code.startswith("/*", i):
+                in_comment = True
+                i += 2
+                continue
+            if code[i] == "{":
+                depth += 1
+            elif code[i] == "}":
+                depth -= 1
+            i += 1
+
+    if first_function is None:
+        first_function = len(body)
+
+    ns = "kvn_sketch_" + role
+    src = ino.replace("\\", "/")
+    with open(out, "w", encoding="utf-8") as f:
+        f.write("// Generated from %s by ino2cpp.py - do not edit\n\n" % src)
+        f.write("#include <Arduino.h>\n")
+        for number, include in includes:
+            f.write('#line %d "%s"\n%s\n' % (number, src, include))
+        f.write('#include "kvn_sim.h"\n\n')
+        f.write("namespace %s {\n\n" % ns)
+        f.write('#line 1 "%s"\n' % src)
+        f.write("\n".join(body[:first_function]) + "\n")
+        f.write("\n".join(prototypes) + "\n")
+        f.write('#line %d "%s"\n' % (first_function + 1, src))
+        f.write("\n".join(body[first_function:]) + "\n")
+        f.write("\n// RAM lost on a reset or a deep sleep wake\n")
+        f.write("void kvn_ram_reset() {\n%s\n}\n" % "\n".join(resets))
+        f.write("\n}  // namespace %s\n\n" % ns)
+        f.write("namespace kvn_sim {\n")
+        f.write("extern const Sketch sketch_%s;\n" % role)
+        f.write('const Sketch sketch_%s = {"%s", %s::setup, %s::loop, %s::kvn_ram_reset};\n'
+                % (role, role, ns, ns, ns))
+        f.write("}  // namespace kvn_sim\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+probe_load.py - Ramp MQTT load at a real relay and collect its probe reports
+
+The hardware counterpart of kvn_sim_relay. Against a local broker it
+publishes lux readings from simulated devices at rising rates, plus
+KVN_Probe messages ("<seq>:<sent_us>" on vanguard/probe/<source>) at a
+fixed rate. The relay (PROBE_REPORT_INTERVAL) answers with latency and
+loss on vanguard/relay/probe; for each step the last report whose window
+fell inside the step is kept. This script also subscribes to its own
+probes, which gives the broker's round trip on a single clock as a
+baseline. The relay's numbers are only as good as its NTP sync.
+
+The relay counts as behind at the first step with no report, probe loss
+or a p99 above --max-p99-ms, the same rule as kvn_sim_relay (its rx
+counter includes its own forwards, so what it consumed is not known).
+
+    probe_load.py --broker 192.168.1.10 --json relay_report.json
+
+Needs paho-mqtt (pip install paho-mqtt). Writes the report layout of
+kvn_sim_relay --json with "source":"hardware". What only the simulator
+sees (seed, uart_bytes; per step consumed, echoes, backlog, dropped) is
+null. Each step adds relay_rx and echo_p50_us.
+"""
+
+import argparse
+import json
+import random
+import threading
+import time
+
+import paho.mqtt.client as mqtt
+
+PROBE_PREFIX = "vanguard/probe/"
+REPORT_TOPIC = "vanguard/relay/probe"
+STATS_TOPIC = "vanguard/relay/stats"
+
+
+def percentile(values, pct):
+    if not values:
+        return 0
+    values = sorted(values)
+    rank = max(1, -(-len(values) * pct // 100))
+    return values[rank - 1]
+
+
+class Collector:
+    """Relay reports and our own probe echoes, shared with the MQTT thread"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.reports = []          # (received_at, report dict)
+        self.echo_us = []          # Broker round trip of our probes
+        self.stats = None
+
+    def on_message(self, client, userdata, msg):
+        now = time.time()
+        with self.lock:
+            if msg.topic == REPORT_TOPIC:
+                try:
+                    self.reports.append((now, json.loads(msg.payload)))
+                except ValueError:
+                    pass
+            elif msg.topic == STATS_TOPIC:
+                try:
+                    self.stats = json.loads(msg.payload)
+                except ValueError:
+                    pass
+            elif msg.topic.startswith(PROBE_PREFIX):
+                seq, _, sent = msg.payload.decode(errors="replace").strip().partition(":")
+                if sent.isdigit():
+                    self.echo_us.append(int(now * 1e6) - int(sent))
+
+
+def run_step(client, rate, probe_rate, args, seq):
+    """Publish `rate` load msg/s and `probe_rate` probes/s for one step"""
+    start = time.time()
+    end = start + args.step
+    next_load, next_probe = start, start
+    injected = 0
+
+    while True:
+        now = time.time()
+        if now >= end:
+            break
+        if next_probe <= next_load:
+            if next_probe > now:
+                time.sleep(next_probe - now)
+            source = sum(seq) % args.sources
+            payload = "%d:%d" % (seq[source], int(time.time() * 1e6))
+            client.publish(PROBE_PREFIX + "probe_%d" % source, payload.ljust(args.pad))
+            seq[source] += 1
+            next_probe += 1.0 / probe_rate
+        else:
+            if next_load > now:
+                time.sleep(next_load - now)
+            device = injected % args.devices
+            topic = ("vanguard/raw/raw_%d/lux" if device & 1 else "homeassistant/sensor/ha_%d/lux") % device
+            client.publish(topic, str(random.randint(100, 499)))
+            injected += 1
+            next_load += 1.0 / rate
+    return start, end, injected
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    parser.add_argument("--broker", default="localhost")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--user")
+    parser.add_argument("--password")
+    parser.add_argument("--rates", default="5,10,20,50,100,200,500")
+    parser.add_argument("--step", type=float, default=20.0, help="seconds per step (>= 2 report windows)")
+    parser.add_argument("--devices", type=int, default=200)
+    parser.add_argument("--sources", type=int, default=4)
+    parser.add_argument("--probe-rate", type=float, default=10.0)
+    parser.add_argument("--pad", type=int, default=32)
+    parser.add_argument("--max-p99-ms", type=float, default=1000.0)
+    parser.add_argument("--json", help="report path")
+    args = parser.parse_args()
+
+    collector = Collector()
+    client = mqtt.Client(client_id="kvn_probe_load")
+    if args.user:
+        client.username_pw_set(args.user, args.password)
+    client.on_message = collector.on_message
+    client.connect(args.broker, args.port)
+    client.subscribe([(REPORT_TOPIC, 0), (STATS_TOPIC, 0), (PROBE_PREFIX + "#", 0)])
+    client.loop_start()
+    time.sleep(1.0)
+
+    print("%8s %10s %10s %10s %8s %8s %8s" % ("offered", "injected", "relay rx", "echo p50", "p50 ms",
+                                              "p99 ms", "lost"))
+    steps = []
+    knee = 0
+    seq = [0] * args.sources
+    for rate in [int(r) for r in args.rates.split(",")]:
+        with collector.lock:
+            rx_before = collector.stats.get("rx", 0) if collector.stats else 0
+            collector.echo_us.clear()
+        start, end, injected = run_step(client, rate, args.probe_rate, args, seq)
+        time.sleep(1.0)  # Let the last report and stats arrive
+
+        with collector.lock:
+            report = None
+            for at, r in collector.reports:
+                if start + r.get("window_ms", 0) / 1000.0 <= at <= end + 1.0:
+                    report = r
+            relay_rx = (collector.stats.get("rx", 0) - rx_before) if collector.stats else 0
+            echo_p50 = percentile(collector.echo_us, 50)
+
+        step = {"offered": rate, "injected": injected, "consumed": None, "echoes": None, "backlog": None,
+                "dropped": None, "probe": report, "relay_rx": relay_rx, "echo_p50_us": echo_p50}
+        steps.append(step)
+        if report:
+            print("%8d %10d %10d %8.1fms %8.1f %8.1f %8d" % (rate, injected, relay_rx, echo_p50 / 1000.0,
+                                                            report["p50_us"] / 1000.0,
+                                                            report["p99_us"] / 1000.0, report["lost"]))
+        else:
+            print("%8d %10d %10d %8.1fms %8s %8s %8s" % (rate, injected, relay_rx, echo_p50 / 1000.0,
+                                                        "-", "-", "-"))
+        behind = report is None or report["lost"] > 0 or report["p99_us"] > args.max_p99_ms * 1000
+        if not knee and behind:
+            knee = rate
+
+    client.loop_stop()
+    client.disconnect()
+    print("Falls behind at %d msg/s offered" % knee if knee else "Kept up with every step")
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"scenario": "relay_throughput", "source": "hardware", "seed": None, "step_s": args.step,
+                       "devices": args.devices, "probe_rate": args.probe_rate, "max_p99_ms": args.max_p99_ms,
+                       "knee": knee, "uart_bytes": None, "steps": steps}, f, indent=1)
+        print("Report: %s" % args.json)
+
+
+if __name__ == "__main__":
+    main()
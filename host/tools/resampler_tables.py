@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+resampler_tables.py - Generate the polyphase FIR tables for the
+ESP32-audioI2S resampler (src/audio_dsp/resampler_tables.h)
+
+    python3 host/tools/resampler_tables.py <path to resampler_tables.h>
+
+Every supported rate reaches 48 kHz as up by L, down by M:
+
+    8000 6/1   16000 3/1   24000 2/1   32000 3/2   22050 320/147   44100 320/294
+
+One table per L and quality tier. The prototype is a Kaiser-windowed sinc
+at L x the input rate, with the cutoff relative to the input rate, so
+16 and 32 kHz share L = 3, and 22.05 and 44.1 kHz share L = 320.
+
+Tiers, taps per phase / stopband / stopband edge (x input rate):
+    low     8  40 dB  0.60
+    medium 24  70 dB  0.55
+    high   48  90 dB  0.52
+A stopband edge above 0.5 lets a little image energy through just above
+the input Nyquist frequency, in exchange for a wider passband.
+
+Each phase is stored in reverse, oldest input first, as Q15, and sums to
+exactly 32768 (unity gain at DC). The rounding is corrected on the taps
+with the largest residual. The resampler accumulates each half of a
+phase in int32. The script checks that the absolute taps of each half
+sum to less than 2, so a full-scale input cannot overflow.
+"""
+
+import math
+import sys
+
+Q = 15
+UPS = (2, 3, 6, 320)
+TIERS = (  # name, taps per phase, attenuation dB, stopband edge
+    ("LOW", 8, 40.0, 0.60),
+    ("MEDIUM", 24, 70.0, 0.55),
+    ("HIGH", 48, 90.0, 0.52),
+)
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-14 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def kaiser_beta(atten):
+    if atten > 50:
+        return 0.1102 * (atten - 8.7)
+    return 0.5842 * (atten - 21) ** 0.4 + 0.07886 * (atten - 21)
+
+
+def prototype(up, taps, atten, stop):
+    # Kaiser estimate: transition width (x input rate) for `taps` per phase
+    width = (atten - 7.95) / (14.36 * taps)
+    cutoff = (stop - width / 2) / up     # cycles per sample at up x the input rate
+    length = taps * up
+    centre = (length - 1) / 2
+    beta = kaiser_beta(atten)
+    norm = bessel_i0(beta)
+    h = []
+    for m in range(length):
+        x = m - centre
+        arg = 2 * cutoff * x
+        sinc = math.sin(math.pi * arg) / (math.pi * arg) if x != 0 else 1.0
+        window = bessel_i0(beta * math.sqrt(max(0.0, 1 - (2 * x / (length - 1)) ** 2))) / norm
+        h.append(2 * cutoff * sinc * window)
+    return h, stop - width
+
+
+def phases(up, taps, atten, stop):
+    h, passband = prototype(up, taps, atten, stop)
+    table = []
+    for p in range(up):
+        exact = [h[p + (taps - 1 - r) * up] for r in range(taps)]
+        total = sum(exact)
+        exact = [c / total * (1 << Q) for c in exact]
+        coef = [round(c) for c in exact]
+        error = (1 << Q) - sum(coef)
+        sign = 1 if error > 0 else -1
+        order = sorted(range(taps), key=lambda j: (exact[j] - coef[j]) * sign, reverse=True)
+        for j in order[:abs(error)]:
+            coef[j] += sign
+        for half in (coef[:taps // 2], coef[taps // 2:]):
+            if sum(abs(c) for c in half) >= 2 << Q:
+                sys.exit(f"L={up} taps={taps}: a half-phase can overflow int32")
+        if max(abs(c) for c in coef) > 32767:
+            sys.exit(f"L={up} taps={taps}: tap out of int16 range")
+        table.append(coef)
+    return table, passband
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(f"usage: {sys.argv[0]} <resampler_tables.h>")
+
+    out = [
+        "/*",
+        " * resampler_tables.h",
+        " *",
+        " * Generated by host/tools/resampler_tables.py, do not edit.",
+        " *",
+        " * Polyphase FIR tables, Q15, [phase][tap], each phase reversed (oldest",
+        " * input first) and summing to 32768.",
+        " */",
+        "#pragma once",
+        "",
+        "#include <stdint.h>",
+        "",
+    ]
+    entries = []
+    for up in UPS:
+        for name, taps, atten, stop in TIERS:
+            table, passband = phases(up, taps, atten, stop)
+            symbol = f"RS_UP{up}_{name}"
+            out.append(f"// up {up}, {taps} taps, {atten:.0f} dB from {stop:.2f} fs_in, flat to {passband:.3f} fs_in")
+            out.append(f"static const int16_t {symbol}[{up * taps}] = {{")
+            for coef in table:
+                out.append("    " + ", ".join(str(c) for c in coef) + ",")
+            out.append("};")
+            out.append("")
+            entries.append((up, name, taps, symbol))
+
+    out.append("static const ResampleTable RESAMPLE_TABLES[] = {")
+    out.append("    // up  quality          taps  coefficients")
+    for up, name, taps, symbol in entries:
+        out.append(f"    {{{up:3d}, RESAMPLE_{name + ',':8s} {taps:2d},  {symbol}}},")
+    out.append("};")
+    out.append("")
+
+    with open(sys.argv[1], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -1,37 +1,336 @@
+/*
+ * ESP32_AI.cpp - Implementation
+ */
+
 #include "ESP32_AI.h"
-// #include <ArduinoJson.h> // Uncomment when ArduinoJson is installed
+#include <string.h>
+
+#define ANTHROPIC_HOST    "api.anthropic.com"
+#define ANTHROPIC_PATH    "/v1/messages"
+#define ANTHROPIC_MODEL   "claude-3-5-haiku-latest"
+#define ANTHROPIC_VERSION "2023-06-01"
+#define OPENAI_HOST       "api.openai.com"
+#define OPENAI_PATH       "/v1/chat/completions"
+#define OPENAI_MODEL      "gpt-4o-mini"
 
 ESP32_AI::ESP32_AI(const char* apiKey, const char* provider) {
     _apiKey = apiKey;
-    _provider = provider;
+
+    // Resolved once, not compared on every call
+    if (strcmp(provider, "anthropic") == 0) {
+        _provider = AI_ANTHROPIC;
+        _host = ANTHROPIC_HOST;
+        _path = ANTHROPIC_PATH;
+        _model = ANTHROPIC_MODEL;
+    } else if (strcmp(provider, "openai") == 0) {
+        _provider = AI_OPENAI;
+        _host = OPENAI_HOST;
+        _path = OPENAI_PATH;
+        _model = OPENAI_MODEL;
+    } else {
+        _provider = AI_UNKNOWN;
+        _host = "";
+        _path = "/";
+        _model = "";
+    }
+
+    _port = 443;
+    _tls = true;
+    _verify = false;
+    _net = &_secure;
+
+    _tools = nullptr;
+    _maxTokens = ESP32_AI_MAX_TOKENS;
+    _timeoutMs = ESP32_AI_TIMEOUT_MS;
+    _cacheTtlMs = 0;
+    _tokenCb = nullptr;
+
+    _body = _request + ESP32_AI_HEAD_SIZE;
+    _bodyLen = 0;
+    _bodyOverflow = false;
+    _response[0] = '\0';
+    _error[0] = '\0';
+    memset(&_stats, 0, sizeof(_stats));
+
+    setSystemPrompt("");
 }
 
 void ESP32_AI::begin() {
-    _client.setInsecure(); // For testing, ignore SSL certificate
+    if (!_verify) {
+        _secure.setInsecure(); // No CA given: skip certificate checks
+    }
+}
+
+void ESP32_AI::setSystemPrompt(const char* prompt) {
+    strlcpy(_system, prompt, sizeof(_system));
+
+    // The model is part of the key too: another model, another answer
+    _systemHash = AIResponseCache::hash(_model, strlen(_model));
+    _systemHash = AIResponseCache::hash(_system, strlen(_system), _systemHash);
+}
+
+void ESP32_AI::setModel(const char* model) {
+    _model = model;
+    _systemHash = AIResponseCache::hash(_model, strlen(_model));
+    _systemHash = AIResponseCache::hash(_system, strlen(_system), _systemHash);
+}
+
+void ESP32_AI::setEndpoint(const char* host, uint16_t port, const char* path, bool tls) {
+    disconnect();
+    _host = host;
+    _port = port;
+    _path = path;
+    _tls = tls;
+    _net = tls ? (Client*)&_secure : (Client*)&_plain;
+}
+
+void ESP32_AI::setCACert(const char* rootCA) {
+    _secure.setCACert(rootCA);
+    _verify = true;
+}
+
+void ESP32_AI::disconnect() {
+    _net->stop();
+}
+
+const char* ESP32_AI::fail(const char* message) {
+    if (message != _error) strlcpy(_error, message, sizeof(_error));
+    _stats.failures++;
+    return nullptr;
+}
+
+// ==================== CHAT ====================
+
+const char* ESP32_AI::chat(const char* prompt) {
+    uint32_t start = millis();
+
+    _stats.requests++;
+    _stats.cached = false;
+    _stats.reused = false;
+    _stats.connectMs = 0;
+    _stats.firstTokenMs = 0;
+    _stats.totalMs = 0;
+    _stats.deltas = 0;
+    _stats.heapUsed = 0;
+    _error[0] = '\0';
+    _parser.begin(_provider, _response, sizeof(_response));
+
+    if (_provider == AI_UNKNOWN) return fail("unknown provider");
+
+    uint64_t key = AIResponseCache::hash(prompt, strlen(prompt), _systemHash);
+    const char* hit = _cache.lookup(key, start, _cacheTtlMs);
+    if (hit) {
+        strlcpy(_response, hit, sizeof(_response));
+        _stats.cached = true;
+        _stats.cacheHits++;
+        if (_tokenCb) _tokenCb(_response, strlen(_response));
+        _stats.totalMs = millis() - start;
+        return _response;
+    }
+
+    if (!buildBody(prompt)) return fail("request too large");
+
+    uint32_t heapStart = ESP.getFreeHeap();
+    uint32_t heapMin = heapStart;
+
+    // A kept-alive connection the server has since closed only shows up
+    // when the request goes unanswered; retry that once on a new one.
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        _parser.begin(_provider, _response, sizeof(_response));
+        _parser.onText(_tokenCb);
+
+        _stats.reused = _net->connected();
+        if (!_stats.reused && !ensureConnected()) return fail("connect failed");
+
+        uint32_t heap = ESP.getFreeHeap();
+        if (heap < heapMin) heapMin = heap;
+
+        bool sent = sendRequest();
+        size_t received = sent ? readResponse(millis(), heapMin) : 0;
+
+        if (received == 0 && _stats.reused && attempt == 0 && _error[0] == '\0') {
+            disconnect();
+            continue;
+        }
+        if (!sent) {
+            disconnect();
+            return fail("send failed");
+        }
+        break;
+    }
+
+    _stats.totalMs = millis() - start;
+    _stats.deltas = _parser.deltas();
+    _stats.heapUsed = heapStart - heapMin;
+
+    // Unknown position in the stream, or the server is closing: start fresh next time
+    if (!_parser.done() || !_parser.keepAlive()) disconnect();
+
+    if (_error[0]) return fail(_error);
+    if (!_parser.ok()) return fail(_parser.error()[0] ? _parser.error() : "incomplete response");
+
+    // Tool calls depend on state outside the prompt; never replay them
+    if (!_parser.truncated() && _parser.toolName()[0] == '\0') {
+        _cache.store(key, _response, _parser.length(), millis());
+    }
+    return _response;
+}
+
+bool ESP32_AI::ensureConnected() {
+    uint32_t start = millis();
+
+    _net->stop();
+    if (!_net->connect(_host, _port)) return false;
+
+    _stats.connects++;
+    _stats.connectMs = millis() - start;
+    return true;
 }
 
-void ESP32_AI::setSystemPrompt(String prompt) {
-    _systemPrompt = prompt;
+bool ESP32_AI::sendRequest() {
+    char head[ESP32_AI_HEAD_SIZE];
+    int n;
+
+    if (_provider == AI_ANTHROPIC) {
+        n = snprintf(head, sizeof(head),
+                     "POST %s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "x-api-key: %s\r\n"
+                     "anthropic-version: " ANTHROPIC_VERSION "\r\n"
+                     "content-type: application/json\r\n"
+                     "accept: text/event-stream\r\n"
+                     "connection: keep-alive\r\n"
+                     "content-length: %u\r\n\r\n",
+                     _path, _host, _apiKey, (unsigned)_bodyLen);
+    } else {
+        n = snprintf(head, sizeof(head),
+                     "POST %s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "Authorization: Bearer %s\r\n"
+                     "content-type: application/json\r\n"
+                     "accept: text/event-stream\r\n"
+                     "connection: keep-alive\r\n"
+                     "content-length: %u\r\n\r\n",
+                     _path, _host, _apiKey, (unsigned)_bodyLen);
+    }
+    if (n <= 0 || n >= (int)sizeof(head)) return false;
+
+    char* request = _body - n;
+    memcpy(request, head, n);
+
+    size_t len = n + _bodyLen;
+    return _net->write((const uint8_t*)request, len) == len;
+}
+
+// Feeds the parser until the response ends. Returns bytes received.
+size_t ESP32_AI::readResponse(uint32_t sentMs, uint32_t& heapMin) {
+    uint8_t buf[ESP32_AI_READ_CHUNK];
+    size_t received = 0;
+
+    while (!_parser.done()) {
+        int avail = _net->available();
+
+        if (avail > 0) {
+            int n = _net->read(buf, avail < (int)sizeof(buf) ? avail : sizeof(buf));
+            if (n <= 0) continue;
+
+            received += n;
+            _parser.feed(buf, n);
+            if (_stats.firstTokenMs == 0 && _parser.deltas() > 0) {
+                _stats.firstTokenMs = millis() - sentMs;
+            }
+            continue;
+        }
+
+        if (!_net->connected()) {
+            if (received) _parser.finish();
+            break;
+        }
+
+        if (millis() - sentMs >= _timeoutMs) {
+            strcpy(_error, "timeout");
+            break;
+        }
+
+        uint32_t heap = ESP.getFreeHeap();
+        if (heap < heapMin) heapMin = heap;
+        delay(1);
+    }
+
+    return received;
 }
 
-String ESP32_AI::chat(String prompt) {
-    if (String(_provider) == "anthropic") {
-        return sendAnthropicRequest(prompt);
-    } else if (String(_provider) == "openai") {
-        return sendOpenAIRequest(prompt);
+// ==================== REQUEST BODY ====================
+
+bool ESP32_AI::buildBody(const char* prompt) {
+    char num[12];
+
+    _bodyLen = 0;
+    _bodyOverflow = false;
+
+    append("{\"model\":\"");
+    appendEscaped(_model);
+    append("\",\"max_tokens\":");
+    snprintf(num, sizeof(num), "%u", _maxTokens);
+    append(num);
+    append(",\"stream\":true");
+
+    if (_provider == AI_ANTHROPIC && _system[0]) {
+        append(",\"system\":\"");
+        appendEscaped(_system);
+        append("\"");
+    }
+
+    if (_tools) {
+        append(",\"tools\":");
+        append(_tools);
+    }
+
+    append(",\"messages\":[");
+    if (_provider == AI_OPENAI && _system[0]) {
+        append("{\"role\":\"system\",\"content\":\"");
+        appendEscaped(_system);
+        append("\"},");
     }
-    return "Error: Unknown provider";
+    append("{\"role\":\"user\",\"content\":\"");
+    appendEscaped(prompt);
+    append("\"}]}");
+
+    _body[_bodyLen] = '\0';
+    return !_bodyOverflow;
 }
 
-String ESP32_AI::sendAnthropicRequest(String prompt) {
-    // Placeholder for Anthropic API request
-    // This would involve connecting to api.anthropic.com, sending JSON, and parsing response
-    Serial.println("Sending request to Anthropic...");
-    return "Hello from Claude (Simulation)";
+void ESP32_AI::append(const char* s) {
+    size_t len = strlen(s);
+    if (_bodyLen + len >= ESP32_AI_BODY_SIZE) {
+        _bodyOverflow = true;
+        return;
+    }
+    memcpy(_body + _bodyLen, s, len);
+    _bodyLen += len;
 }
 
-String ESP32_AI::sendOpenAIRequest(String prompt) {
-    // Placeholder for OpenAI API request
-    Serial.println("Sending request to OpenAI...");
-    return "Hello from GPT (Simulation)";
+void ESP32_AI::appendEscaped(const char* s) {
+    for (; *s; s++) {
+        char esc[7];
+        const char* out = esc;
+        uint8_t c = *s;
+
+        switch (c) {
+            case '"':  out = "\\\""; break;
+            case '\\': out = "\\\\"; break;
+            case '\n': out = "\\n"; break;
+            case '\r': out = "\\r"; break;
+            case '\t': out = "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    snprintf(esc, sizeof(esc), "\\u%04x", c);
+                } else {
+                    esc[0] = c;
+                    esc[1] = '\0';
+                }
+        }
+        append(out);
+        if (_bodyOverflow) return;
+    }
 }
@@ -1,30 +1,153 @@
+/*
+ * ESP32_AI.h - Streaming Anthropic / OpenAI client for KVN hubs
+ *
+ * Built for a memory-constrained hub:
+ *   - One keep-alive TLS connection, reused across requests (the
+ *     handshake is paid once, not per question)
+ *   - The request body is written into a preallocated buffer, no String
+ *   - The response is parsed as it arrives (ESP32_AI_Stream.h); each text
+ *     delta goes to the onToken() callback, e.g. straight to MQTT
+ *   - Bounded LRU cache keyed by (system prompt, prompt), so repeated
+ *     context questions skip the round trip (ESP32_AI_Cache.h)
+ *   - Tool definitions are passed through; a tool call is reported by
+ *     toolName() with its JSON arguments as the reply
+ *
+ *   ESP32_AI ai(ANTHROPIC_API_KEY, "anthropic");
+ *   ai.begin();
+ *   ai.setSystemPrompt("You are the KVN home hub.");
+ *   ai.onToken(onToken);
+ *   const char* reply = ai.chat("Is anyone home?");
+ *   if (!reply) Serial.println(ai.error());
+ *
+ * setEndpoint() points the client at a plain-HTTP mock server for tests
+ * (examples/MockServer).
+ *
+ * Author: KVN System
+ * Version: 2.0.0
+ */
+
 #ifndef ESP32_AI_H
 #define ESP32_AI_H
 
 #include <Arduino.h>
+#include <WiFiClient.h>
 #include <WiFiClientSecure.h>
+#include "ESP32_AI_Stream.h"
+#include "ESP32_AI_Cache.h"
+
+#ifndef ESP32_AI_BODY_SIZE
+#define ESP32_AI_BODY_SIZE     2048   // Request JSON
+#endif
+#define ESP32_AI_HEAD_SIZE     448    // HTTP request headers, in front of the body
+#ifndef ESP32_AI_RESPONSE_SIZE
+#define ESP32_AI_RESPONSE_SIZE 1024   // Reply text kept for chat()'s return
+#endif
+#ifndef ESP32_AI_SYSTEM_SIZE
+#define ESP32_AI_SYSTEM_SIZE   512
+#endif
+#define ESP32_AI_READ_CHUNK    256    // Bytes read from the socket per call
+#define ESP32_AI_TIMEOUT_MS    30000  // Whole request, first byte to last
+#define ESP32_AI_MAX_TOKENS    256
+
+// Measurements of the latest chat()
+struct AIStats {
+    uint32_t requests;      // chat() calls
+    uint32_t cacheHits;
+    uint32_t connects;      // TLS/TCP connections opened (1 while keep-alive holds)
+    uint32_t failures;
+
+    bool cached;            // Latest reply came from the cache
+    bool reused;            // Latest request went out on an open connection
+    uint32_t connectMs;     // Handshake time, 0 if reused
+    uint32_t firstTokenMs;  // Request sent -> first text delta
+    uint32_t totalMs;       // chat() start -> reply complete
+    uint32_t deltas;        // Text deltas streamed
+    uint32_t heapUsed;      // Free heap at start minus lowest free heap during
+};
 
 class ESP32_AI {
 public:
+    typedef void (*TokenCallback)(const char* text, size_t len);
+
+    // provider: "anthropic" or "openai"
     ESP32_AI(const char* apiKey, const char* provider = "anthropic");
-    
+
     // Initialize the client
     void begin();
-    
-    // Send a prompt to the AI and get a response
-    String chat(String prompt);
-    
-    // Set the system prompt or context
-    void setSystemPrompt(String prompt);
+
+    // Set the system prompt or context (copied)
+    void setSystemPrompt(const char* prompt);
+
+    // Send a prompt and wait for the whole reply, streaming deltas to
+    // onToken() meanwhile. Returns the reply (valid until the next call),
+    // or nullptr - see error().
+    const char* chat(const char* prompt);
+
+    void onToken(TokenCallback cb) { _tokenCb = cb; }
+
+    // Configuration (strings must outlive the client)
+    void setModel(const char* model);
+    void setMaxTokens(uint16_t maxTokens) { _maxTokens = maxTokens; }
+    void setTools(const char* toolsJson) { _tools = toolsJson; }    // Raw JSON array, nullptr = none
+    void setEndpoint(const char* host, uint16_t port, const char* path, bool tls = true);
+    void setCACert(const char* rootCA);
+    void setTimeout(uint32_t ms) { _timeoutMs = ms; }
+    void setCacheTTL(uint32_t ms) { _cacheTtlMs = ms; }              // 0 = never expire
+    void clearCache() { _cache.clear(); }
+
+    // Drop the kept-alive connection
+    void disconnect();
+
+    const char* error() const { return _error; }
+    const char* toolName() const { return _parser.toolName(); }    // Set if the reply is a tool call
+    const char* stopReason() const { return _parser.stopReason(); }
+    bool truncated() const { return _parser.truncated(); }
+    const AIStats& stats() const { return _stats; }
+    const AIResponseCache& cache() const { return _cache; }
 
 private:
     const char* _apiKey;
-    const char* _provider;
-    String _systemPrompt;
-    WiFiClientSecure _client;
-    
-    String sendAnthropicRequest(String prompt);
-    String sendOpenAIRequest(String prompt);
+    AIProvider _provider;
+    const char* _model;
+    const char* _tools;
+    uint16_t _maxTokens;
+    uint32_t _timeoutMs;
+    uint32_t _cacheTtlMs;
+
+    const char* _host;
+    uint16_t _port;
+    const char* _path;
+    bool _tls;
+    bool _verify;              // setCACert() called
+    WiFiClientSecure _secure;
+    WiFiClient _plain;
+    Client* _net;
+
+    char _system[ESP32_AI_SYSTEM_SIZE];
+    uint64_t _systemHash;      // Cache key prefix
+
+    // Headers are written just in front of the body, so the whole request
+    // goes out in one write (one TLS record, no Nagle wait between parts)
+    char _request[ESP32_AI_HEAD_SIZE + ESP32_AI_BODY_SIZE];
+    char* _body;               // _request + ESP32_AI_HEAD_SIZE
+    size_t _bodyLen;
+    bool _bodyOverflow;
+
+    char _response[ESP32_AI_RESPONSE_SIZE];
+    char _error[96];
+
+    AIStreamParser _parser;
+    AIResponseCache _cache;
+    TokenCallback _tokenCb;
+    AIStats _stats;
+
+    bool buildBody(const char* prompt);
+    void append(const char* s);
+    void appendEscaped(const char* s);
+    bool ensureConnected();
+    bool sendRequest();
+    size_t readResponse(uint32_t sentMs, uint32_t& heapMin);
+    const char* fail(const char* message);
 };
 
-#endif
+#endif // ESP32_AI_H
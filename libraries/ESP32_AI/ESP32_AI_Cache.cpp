@@ -0,0 +1,76 @@
+/*
+ * ESP32_AI_Cache.cpp - Implementation
+ */
+
+#include "ESP32_AI_Cache.h"
+#include <string.h>
+
+AIResponseCache::AIResponseCache() {
+    _hits = 0;
+    _misses = 0;
+    _evictions = 0;
+    clear();
+}
+
+uint64_t AIResponseCache::hash(const char* data, size_t len, uint64_t seed) {
+    uint64_t h = seed;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)data[i];
+        h *= 0x100000001B3ULL;
+    }
+    // Separator, so ("ab", "c") and ("a", "bc") differ
+    h ^= 0xFF;
+    h *= 0x100000001B3ULL;
+    return h ? h : 1;   // 0 marks an empty slot
+}
+
+const char* AIResponseCache::lookup(uint64_t key, uint32_t nowMs, uint32_t ttlMs) {
+    for (uint8_t i = 0; i < ESP32_AI_CACHE_ENTRIES; i++) {
+        AICacheEntry& e = _entries[i];
+        if (e.key != key) continue;
+
+        if (ttlMs && nowMs - e.storedMs >= ttlMs) {
+            e.key = 0;   // Expired
+            break;
+        }
+
+        e.used = ++_clock;
+        _hits++;
+        return e.text;
+    }
+
+    _misses++;
+    return nullptr;
+}
+
+bool AIResponseCache::store(uint64_t key, const char* text, size_t len, uint32_t nowMs) {
+    if (key == 0 || len >= ESP32_AI_CACHE_TEXT) return false;
+
+    // Same key, else an empty slot, else the least recently used
+    AICacheEntry* slot = nullptr;
+    for (uint8_t i = 0; i < ESP32_AI_CACHE_ENTRIES; i++) {
+        AICacheEntry& e = _entries[i];
+        if (e.key == key) {
+            slot = &e;
+            break;
+        }
+        if (slot == nullptr || (slot->key != 0 && (e.key == 0 || e.used < slot->used))) {
+            slot = &e;
+        }
+    }
+
+    if (slot->key != 0 && slot->key != key) _evictions++;
+
+    slot->key = key;
+    slot->used = ++_clock;
+    slot->storedMs = nowMs;
+    slot->len = len;
+    memcpy(slot->text, text, len);
+    slot->text[len] = '\0';
+    return true;
+}
+
+void AIResponseCache::clear() {
+    memset(_entries, 0, sizeof(_entries));
+    _clock = 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * ESP32_AI_Cache.h - Bounded LRU cache of AI replies
+ *
+ * Fixed slots, no heap. Keyed by a 64-bit FNV-1a hash of
+ * (system prompt, prompt), so the same context question - e.g. a light
+ * summary that has not changed since the last one - is answered without
+ * a round trip. Replies longer than a slot are not cached.
+ */
+
+#ifndef ESP32_AI_CACHE_H
+#define ESP32_AI_CACHE_H
+
+#include <Arduino.h>
+
+#ifndef ESP32_AI_CACHE_ENTRIES
+#define ESP32_AI_CACHE_ENTRIES 8
+#endif
+#ifndef ESP32_AI_CACHE_TEXT
+#define ESP32_AI_CACHE_TEXT    384   // Longest cached reply, including NUL
+#endif
+
+#define AI_HASH_SEED 0xCBF29CE484222325ULL
+
+struct AICacheEntry {
+    uint64_t key;          // 0 = empty
+    uint32_t used;         // Use counter stamp; lowest is evicted first
+    uint32_t storedMs;
+    uint16_t len;
+    char text[ESP32_AI_CACHE_TEXT];
+};
+
+class AIResponseCache {
+public:
+    AIResponseCache();
+
+    // FNV-1a, chainable: hash(prompt, len, hash(system, len))
+    static uint64_t hash(const char* data, size_t len, uint64_t seed = AI_HASH_SEED);
+
+    // Reply for `key`, or nullptr. ttlMs = 0 never expires.
+    const char* lookup(uint64_t key, uint32_t nowMs, uint32_t ttlMs);
+
+    // Returns false if the reply does not fit a slot
+    bool store(uint64_t key, const char* text, size_t len, uint32_t nowMs);
+
+    void clear();
+
+    uint32_t hits() const { return _hits; }
+    uint32_t misses() const { return _misses; }
+    uint32_t evictions() const { return _evictions; }
+
+private:
+    AICacheEntry _entries[ESP32_AI_CACHE_ENTRIES];
+    uint32_t _clock;
+    uint32_t _hits;
+    uint32_t _misses;
+    uint32_t _evictions;
+};
+
+#endif // ESP32_AI_CACHE_H
@@ -0,0 +1,429 @@
+/*
+ * ESP32_AI_Stream.cpp - Implementation
+ */
+
+#include "ESP32_AI_Stream.h"
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+AIStreamParser::AIStreamParser() {
+    _cb = nullptr;
+    _out = nullptr;
+    _outSize = 0;
+    _droppedLines = 0;
+    begin(AI_ANTHROPIC, nullptr, 0);
+}
+
+void AIStreamParser::begin(AIProvider provider, char* out, size_t outSize) {
+    _provider = provider;
+    _state = STATUS_LINE;
+    _framing = FRAME_CLOSE;
+    _sse = false;
+    _keepAlive = false;
+    _status = 0;
+    _remaining = 0;
+
+    _lineLen = 0;
+    _lineOverflow = false;
+    _line[0] = '\0';
+
+    _out = out;
+    _outSize = outSize;
+    _outLen = 0;
+    if (_out && _outSize) _out[0] = '\0';
+    _truncated = false;
+    _deltas = 0;
+
+    _tool[0] = '\0';
+    _stop[0] = '\0';
+    _error[0] = '\0';
+}
+
+size_t AIStreamParser::feed(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = data[i];
+
+        switch (_state) {
+            case STATUS_LINE:
+                if (!lineByte(b)) break;
+                // "HTTP/1.1 200 OK"; stray blank lines before it are skipped
+                if (_lineLen > 0 && !_lineOverflow) {
+                    _keepAlive = strncmp(_line, "HTTP/1.1", 8) == 0;
+                    const char* sp = strchr(_line, ' ');
+                    _status = sp ? atoi(sp + 1) : 0;
+                    _state = HEADERS;
+                }
+                _lineLen = 0;
+                _lineOverflow = false;
+                break;
+
+            case HEADERS:
+                if (!lineByte(b)) break;
+                if (_lineLen == 0 && !_lineOverflow) {
+                    startBody();
+                } else if (!_lineOverflow) {
+                    headerLine();
+                }
+                break;
+
+            case BODY:
+                bodyByte(b);
+                if (_framing == FRAME_LENGTH && --_remaining == 0) endBody();
+                break;
+
+            case CHUNK_SIZE:
+                // Hex size, optional ";extension", CRLF. _lineOverflow
+                // marks "past the digits".
+                if (b == '\n') {
+                    _state = _remaining ? CHUNK_DATA : TRAILER;
+                    _lineOverflow = false;
+                } else if (!_lineOverflow && isxdigit(b)) {
+                    _remaining = _remaining * 16 + (isdigit(b) ? b - '0' : (tolower(b) - 'a' + 10));
+                } else {
+                    _lineOverflow = true;
+                }
+                break;
+
+            case CHUNK_DATA:
+                bodyByte(b);
+                if (--_remaining == 0) _state = CHUNK_END;
+                break;
+
+            case CHUNK_END:
+                if (b == '\n') {
+                    _state = CHUNK_SIZE;
+                    _remaining = 0;
+                    _lineOverflow = false;
+                }
+                break;
+
+            case TRAILER:
+                // Trailer headers are ignored; an empty line ends the body.
+                // _remaining counts the current trailer line.
+                if (b == '\n') {
+                    if (_remaining == 0) endBody();
+                    _remaining = 0;
+                } else if (b != '\r') {
+                    _remaining++;
+                }
+                break;
+
+            case DONE:
+                return i;
+        }
+
+        if (_state == DONE) return i + 1;
+    }
+    return len;
+}
+
+void AIStreamParser::finish() {
+    if (_state == BODY && _framing == FRAME_CLOSE) {
+        endBody();
+    } else if (_state != DONE && _error[0] == '\0') {
+        strcpy(_error, "connection closed");
+    }
+}
+
+// Add one byte to the line buffer. Returns true at end of line, with the
+// line NUL-terminated and without CR/LF.
+bool AIStreamParser::lineByte(uint8_t b) {
+    if (b == '\n') {
+        if (_lineLen > 0 && _line[_lineLen - 1] == '\r') _lineLen--;
+        _line[_lineLen] = '\0';
+        return true;
+    }
+
+    if (_lineLen < ESP32_AI_LINE_SIZE - 1) {
+        _line[_lineLen++] = b;
+    } else {
+        _lineOverflow = true;
+    }
+    return false;
+}
+
+void AIStreamParser::headerLine() {
+    // Header names and the values we look for are ASCII
+    for (uint16_t i = 0; i < _lineLen; i++) {
+        _line[i] = tolower(_line[i]);
+    }
+
+    if (strncmp(_line, "transfer-encoding:", 18) == 0) {
+        if (strstr(_line + 18, "chunked")) _framing = FRAME_CHUNKED;
+    } else if (strncmp(_line, "content-length:", 15) == 0) {
+        if (_framing != FRAME_CHUNKED) {
+            _framing = FRAME_LENGTH;
+            _remaining = strtoul(_line + 15, nullptr, 10);
+        }
+    } else if (strncmp(_line, "connection:", 11) == 0) {
+        if (strstr(_line + 11, "close")) _keepAlive = false;
+        if (strstr(_line + 11, "keep-alive")) _keepAlive = true;
+    } else if (strncmp(_line, "content-type:", 13) == 0) {
+        _sse = strstr(_line + 13, "text/event-stream") != nullptr;
+    }
+
+    _lineLen = 0;
+    _lineOverflow = false;
+}
+
+void AIStreamParser::startBody() {
+    _lineLen = 0;
+    _lineOverflow = false;
+
+    // "100 Continue" is followed by the real response
+    if (_status >= 100 && _status < 200) {
+        _state = STATUS_LINE;
+        _framing = FRAME_CLOSE;
+        _sse = false;
+        return;
+    }
+
+    if (_framing == FRAME_CHUNKED) {
+        _state = CHUNK_SIZE;
+        _remaining = 0;
+    } else if (_framing == FRAME_LENGTH && _remaining == 0) {
+        endBody();
+    } else {
+        _state = BODY;
+    }
+}
+
+void AIStreamParser::bodyByte(uint8_t b) {
+    if (_sse) {
+        if (lineByte(b)) eventLine();
+        return;
+    }
+
+    // Plain body: keep as much as fits for endBody()
+    if (_lineLen < ESP32_AI_LINE_SIZE - 1) {
+        _line[_lineLen++] = b;
+        _line[_lineLen] = '\0';
+    } else {
+        _lineOverflow = true;
+    }
+}
+
+void AIStreamParser::endBody() {
+    if (_sse) {
+        if (_lineLen > 0) {
+            _line[_lineLen] = '\0';
+            eventLine();
+        }
+    } else {
+        _line[_lineLen] = '\0';
+        if (_status == 200) {
+            // Server ignored "stream": the whole reply in one document
+            appendText(_provider == AI_OPENAI ? "content" : "text", _line, true);
+        } else {
+            collectError(_line);
+        }
+    }
+
+    if (_status != 200 && _error[0] == '\0') {
+        snprintf(_error, sizeof(_error), "HTTP %d", _status);
+    }
+    _state = DONE;
+}
+
+void AIStreamParser::eventLine() {
+    if (_lineOverflow) {
+        _droppedLines++;
+    } else if (strncmp(_line, "data:", 5) == 0) {
+        const char* json = _line + 5;
+        if (*json == ' ') json++;
+
+        if (_provider == AI_OPENAI) {
+            openaiEvent(json);
+        } else {
+            anthropicEvent(json);
+        }
+    }
+    // "event:", "id:", comments and blank lines carry nothing we need
+
+    _lineLen = 0;
+    _lineOverflow = false;
+}
+
+void AIStreamParser::anthropicEvent(const char* json) {
+    char type[24];
+    if (jsonString(json, "type", type, sizeof(type)) < 0) return;
+
+    if (strcmp(type, "content_block_delta") == 0) {
+        if (strstr(json, "\"input_json_delta\"")) {
+            appendText("partial_json", json, false);
+        } else {
+            appendText("text", json, true);
+        }
+    } else if (strcmp(type, "content_block_start") == 0) {
+        if (strstr(json, "\"tool_use\"")) jsonString(json, "name", _tool, sizeof(_tool));
+    } else if (strcmp(type, "message_delta") == 0) {
+        jsonString(json, "stop_reason", _stop, sizeof(_stop));
+    } else if (strcmp(type, "error") == 0) {
+        collectError(json);
+    }
+}
+
+void AIStreamParser::openaiEvent(const char* json) {
+    if (strcmp(json, "[DONE]") == 0) return;
+
+    if (strstr(json, "\"error\"")) {
+        collectError(json);
+        return;
+    }
+
+    // null until the last chunk, so only a string overwrites it
+    jsonString(json, "finish_reason", _stop, sizeof(_stop));
+
+    if (strstr(json, "\"tool_calls\"")) {
+        jsonString(json, "name", _tool, sizeof(_tool));
+        appendText("arguments", json, false);
+    } else {
+        appendText("content", json, true);
+    }
+}
+
+void AIStreamParser::collectError(const char* json) {
+    if (jsonString(json, "message", _error, sizeof(_error)) <= 0) {
+        snprintf(_error, sizeof(_error), "HTTP %d", _status);
+    }
+}
+
+void AIStreamParser::appendText(const char* key, const char* json, bool notify) {
+    int n = jsonString(json, key, _token, sizeof(_token));
+    if (n <= 0) return;
+
+    if (_out && _outSize) {
+        size_t room = _outSize - 1 - _outLen;
+        size_t copy = (size_t)n < room ? (size_t)n : room;
+        memcpy(_out + _outLen, _token, copy);
+        _outLen += copy;
+        _out[_outLen] = '\0';
+        if (copy < (size_t)n) _truncated = true;
+    }
+
+    if (notify) {
+        _deltas++;
+        if (_cb) _cb(_token, n);
+    }
+}
+
+// ==================== JSON STRING ====================
+
+static size_t putUtf8(char* out, size_t outSize, size_t len, uint32_t cp) {
+    char buf[4];
+    size_t n;
+
+    if (cp < 0x80) {
+        buf[0] = cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        buf[0] = 0xC0 | (cp >> 6);
+        buf[1] = 0x80 | (cp & 0x3F);
+        n = 2;
+    } else if (cp < 0x10000) {
+        buf[0] = 0xE0 | (cp >> 12);
+        buf[1] = 0x80 | ((cp >> 6) & 0x3F);
+        buf[2] = 0x80 | (cp & 0x3F);
+        n = 3;
+    } else {
+        buf[0] = 0xF0 | (cp >> 18);
+        buf[1] = 0x80 | ((cp >> 12) & 0x3F);
+        buf[2] = 0x80 | ((cp >> 6) & 0x3F);
+        buf[3] = 0x80 | (cp & 0x3F);
+        n = 4;
+    }
+
+    // Never split a character
+    if (len + n >= outSize) return 0;
+    memcpy(out + len, buf, n);
+    return n;
+}
+
+static int hex4(const char* p) {
+    int v = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        char c = p[i];
+        if (!isxdigit((unsigned char)c)) return -1;
+        v = v * 16 + (isdigit((unsigned char)c) ? c - '0' : (tolower(c) - 'a' + 10));
+    }
+    return v;
+}
+
+int AIStreamParser::jsonString(const char* json, const char* key, char* out, size_t outSize) {
+    if (outSize == 0) return -1;
+    size_t keyLen = strlen(key);
+    const char* p = json;
+
+    // Find "key" : "
+    while ((p = strchr(p, '"')) != nullptr) {
+        if ((p == json || p[-1] != '\\') && strncmp(p + 1, key, keyLen) == 0 && p[1 + keyLen] == '"') {
+            const char* q = p + 2 + keyLen;
+            while (*q == ' ') q++;
+            if (*q == ':') {
+                q++;
+                while (*q == ' ') q++;
+                if (*q != '"') return -1;   // null, number, object...
+                p = q + 1;
+                break;
+            }
+        }
+        p++;
+    }
+    if (p == nullptr) return -1;
+
+    size_t len = 0;
+    bool full = false;
+    while (*p && *p != '"') {
+        uint32_t cp;
+
+        if (*p == '\\') {
+            p++;
+            switch (*p) {
+                case 'n': cp = '\n'; break;
+                case 't': cp = '\t'; break;
+                case 'r': cp = '\r'; break;
+                case 'b': cp = '\b'; break;
+                case 'f': cp = '\f'; break;
+                case 'u': {
+                    int v = hex4(p + 1);
+                    if (v < 0) return -1;
+                    p += 4;
+                    cp = v;
+                    // Surrogate pair
+                    if (v >= 0xD800 && v < 0xDC00 && p[1] == '\\' && p[2] == 'u') {
+                        int lo = hex4(p + 3);
+                        if (lo >= 0xDC00 && lo < 0xE000) {
+                            cp = 0x10000 + ((v - 0xD800) << 10) + (lo - 0xDC00);
+                            p += 6;
+                        }
+                    }
+                    break;
+                }
+                case '\0': return -1;
+                default: cp = (uint8_t)*p; break;   // \" \\ \/
+            }
+            p++;
+        } else {
+            cp = (uint8_t)*p++;
+            // Raw UTF-8 bytes are copied one by one
+            if (cp >= 0x80) {
+                if (!full && len + 1 < outSize) {
+                    out[len++] = cp;
+                } else {
+                    full = true;
+                }
+                continue;
+            }
+        }
+
+        if (!full) {
+            size_t n = putUtf8(out, outSize, len, cp);
+            if (n == 0) full = true;
+            len += n;
+        }
+    }
+
+    out[len] = '\0';
+    return (int)len;
+}
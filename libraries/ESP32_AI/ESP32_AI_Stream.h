@@ -0,0 +1,132 @@
+/*
+ * ESP32_AI_Stream.h - Incremental HTTP / SSE response parser
+ *
+ * Byte-driven like KVN_RadarParser: feed it whatever the socket returned,
+ * in any chunking, and it decodes the status line, headers, chunked or
+ * Content-Length framing and the server-sent events inside, as they
+ * arrive. Text deltas go straight to the output buffer and the token
+ * callback, so a reply can be forwarded while the model is still writing.
+ * No heap, no String.
+ *
+ * Understood event streams:
+ *   - Anthropic Messages   content_block_delta (text_delta, input_json_delta),
+ *                          content_block_start (tool_use), message_delta,
+ *                          message_stop, error
+ *   - OpenAI Chat          choices[0].delta.content / tool_calls,
+ *                          finish_reason, [DONE], error
+ * A non-streaming body (usually an HTTP error) is collected and its
+ * "message" reported by error().
+ */
+
+#ifndef ESP32_AI_STREAM_H
+#define ESP32_AI_STREAM_H
+
+#include <Arduino.h>
+
+#ifndef ESP32_AI_LINE_SIZE
+#define ESP32_AI_LINE_SIZE   768   // Longest header / SSE line kept
+#endif
+#ifndef ESP32_AI_TOKEN_SIZE
+#define ESP32_AI_TOKEN_SIZE  256   // Longest single decoded delta
+#endif
+
+enum AIProvider {
+    AI_ANTHROPIC,
+    AI_OPENAI,
+    AI_UNKNOWN
+};
+
+class AIStreamParser {
+public:
+    typedef void (*TextCallback)(const char* text, size_t len);
+
+    AIStreamParser();
+
+    // Start a new response. Text (or tool arguments) is written to `out`.
+    void begin(AIProvider provider, char* out, size_t outSize);
+
+    // Feed bytes from the socket. Returns bytes consumed; anything after
+    // the end of the response is left alone.
+    size_t feed(const uint8_t* data, size_t len);
+
+    // The server closed the connection: ends a body framed by close
+    void finish();
+
+    void onText(TextCallback cb) { _cb = cb; }
+
+    bool done() const { return _state == DONE; }
+    bool headersDone() const { return _state >= BODY; }
+    bool ok() const { return done() && _status == 200 && _error[0] == '\0'; }
+    int status() const { return _status; }
+    bool keepAlive() const { return _keepAlive; }
+
+    size_t length() const { return _outLen; }
+    bool truncated() const { return _truncated; }
+    uint32_t deltas() const { return _deltas; }             // Text deltas received
+    uint32_t droppedLines() const { return _droppedLines; } // Longer than ESP32_AI_LINE_SIZE
+
+    const char* toolName() const { return _tool; }          // "" unless the model called a tool
+    const char* stopReason() const { return _stop; }
+    const char* error() const { return _error; }
+
+    // Decode the JSON string value of `key` (first match) into `out`.
+    // Returns its length, or -1 if the key is missing or not a string.
+    static int jsonString(const char* json, const char* key, char* out, size_t outSize);
+
+private:
+    enum ParseState {
+        STATUS_LINE,
+        HEADERS,
+        BODY,
+        CHUNK_SIZE,
+        CHUNK_DATA,
+        CHUNK_END,
+        TRAILER,
+        DONE
+    };
+
+    enum Framing {
+        FRAME_CLOSE,
+        FRAME_LENGTH,
+        FRAME_CHUNKED
+    };
+
+    AIProvider _provider;
+    TextCallback _cb;
+
+    ParseState _state;
+    Framing _framing;
+    bool _sse;
+    bool _keepAlive;
+    int _status;
+    uint32_t _remaining;    // Body or chunk bytes left
+
+    char _line[ESP32_AI_LINE_SIZE];
+    uint16_t _lineLen;
+    bool _lineOverflow;
+
+    char* _out;
+    size_t _outSize;
+    size_t _outLen;
+    bool _truncated;
+    uint32_t _deltas;
+    uint32_t _droppedLines;
+
+    char _token[ESP32_AI_TOKEN_SIZE];
+    char _tool[48];
+    char _stop[24];
+    char _error[96];
+
+    bool lineByte(uint8_t b);
+    void headerLine();
+    void startBody();
+    void bodyByte(uint8_t b);
+    void endBody();
+    void eventLine();
+    void anthropicEvent(const char* json);
+    void openaiEvent(const char* json);
+    void collectError(const char* json);
+    void appendText(const char* key, const char* json, bool notify);
+};
+
+#endif // ESP32_AI_STREAM_H
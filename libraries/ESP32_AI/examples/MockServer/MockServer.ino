@@ -0,0 +1,110 @@
+/*
+ * ESP32_AI Mock Server Benchmark
+ *
+ * Runs the client against mock_server.py on a PC on the same network, so
+ * no API key or internet is needed:
+ *
+ *   python3 mock_server.py --port 8080 --delay 0.02
+ *
+ * For both providers it sends:
+ *   - ROUNDS distinct prompts: time to first token, total time, peak heap;
+ *     only the first one opens a connection (keep-alive)
+ *   - a repeated prompt: answered from the cache, no round trip
+ *   - a tool prompt: toolName() and the JSON arguments
+ *   - an error prompt: HTTP 429 reported by error(), connection kept
+ * and prints PASS when every check holds.
+ *
+ * Edit the credentials and MOCK_HOST below before uploading.
+ */
+
+#include <WiFi.h>
+#include <ESP32_AI.h>
+
+#define WIFI_SSID     "your-wifi-ssid"
+#define WIFI_PASSWORD "your-wifi-password"
+#define MOCK_HOST     "192.168.86.20"   // PC running mock_server.py
+#define MOCK_PORT     8080
+
+#define ROUNDS 5
+
+ESP32_AI anthropic("mock-key", "anthropic");
+ESP32_AI openai("mock-key", "openai");
+
+uint32_t streamed = 0;
+uint32_t failures = 0;
+
+void onToken(const char* text, size_t len) {
+    streamed += len;
+}
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        failures++;
+        Serial.printf("  FAIL: %s\n", what);
+    }
+}
+
+void runProvider(ESP32_AI& ai, const char* name, const char* path) {
+    Serial.printf("\n--- %s ---\n", name);
+
+    ai.setEndpoint(MOCK_HOST, MOCK_PORT, path, false);
+    ai.setSystemPrompt("You are the KVN home hub.");
+    ai.onToken(onToken);
+
+    char prompt[48];
+    uint32_t connectsBefore = ai.stats().connects;
+
+    for (int i = 0; i < ROUNDS; i++) {
+        snprintf(prompt, sizeof(prompt), "Room %d light is 42 lux", i);
+        streamed = 0;
+
+        const char* reply = ai.chat(prompt);
+        const AIStats& s = ai.stats();
+        Serial.printf("  #%d %s connect=%lu ms ttft=%lu ms total=%lu ms deltas=%lu heap=%lu B\n",
+                      i, s.reused ? "reused" : "new   ",
+                      (unsigned long)s.connectMs, (unsigned long)s.firstTokenMs,
+                      (unsigned long)s.totalMs, (unsigned long)s.deltas, (unsigned long)s.heapUsed);
+
+        check(reply != nullptr, ai.error());
+        check(reply && strstr(reply, prompt) != nullptr, "reply echoes prompt");
+        check(reply && streamed == strlen(reply), "streamed text matches reply");
+    }
+    check(ai.stats().connects - connectsBefore == 1, "one connection for all rounds");
+
+    // Same question again: from the cache
+    const char* cached = ai.chat("Room 0 light is 42 lux");
+    Serial.printf("  cached: %s in %lu ms\n", ai.stats().cached ? "yes" : "no",
+                  (unsigned long)ai.stats().totalMs);
+    check(cached && ai.stats().cached, "repeat answered from cache");
+
+    const char* tool = ai.chat("Use a tool for the bed");
+    Serial.printf("  tool: %s(%s) stop=%s\n", ai.toolName(), tool ? tool : "-", ai.stopReason());
+    check(tool && strcmp(ai.toolName(), "get_presence") == 0, "tool call name");
+    check(tool && strcmp(tool, "{\"zone\": \"bed\"}") == 0, "tool call arguments");
+
+    const char* err = ai.chat("Please return an error");
+    Serial.printf("  error: %s\n", ai.error());
+    check(err == nullptr && strcmp(ai.error(), "mock rate limit") == 0, "HTTP error message");
+
+    check(ai.chat("Room 9 after the 429") != nullptr, "connection usable after an error");
+    check(ai.stats().connects - connectsBefore == 1, "error kept the connection");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    while (WiFi.status() != WL_CONNECTED) delay(100);
+    Serial.println("\n=== ESP32_AI mock benchmark ===");
+    Serial.printf("Free heap: %lu B\n", (unsigned long)ESP.getFreeHeap());
+
+    runProvider(anthropic, "anthropic", "/v1/messages");
+    runProvider(openai, "openai", "/v1/chat/completions");
+
+    Serial.printf("\nMin free heap: %lu B\n", (unsigned long)ESP.getMinFreeHeap());
+    Serial.println(failures == 0 ? "PASS" : "FAIL");
+}
+
+void loop() {
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Local mock of the Anthropic Messages and OpenAI Chat streaming APIs.
+
+Serves HTTP/1.1 keep-alive with chunked server-sent events, like the real
+endpoints, so ESP32_AI can be exercised without an API key:
+
+    python3 mock_server.py --port 8080 --delay 0.02
+
+Replies echo the prompt word by word, one delta per word, `--delay`
+seconds apart. A prompt containing "tool" gets a tool call back; one
+containing "error" gets an HTTP 429. Requests and connections are logged,
+so keep-alive reuse is visible. `--drop-every N` closes the connection
+instead of answering every Nth request, like an idle keep-alive timeout
+racing a new request; the client must retry on a fresh connection.
+"""
+
+import argparse
+import json
+import socket
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class MockHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"   # Keep-alive
+    delay = 0.02
+    drop_every = 0
+    connections = 0
+    requests = 0
+
+    def setup(self):
+        super().setup()
+        # Like real API front ends: deltas go out as soon as they are written
+        self.request.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        MockHandler.connections += 1
+        self.log_message("connection #%d", MockHandler.connections)
+
+    def do_POST(self):
+        length = int(self.headers.get("content-length", 0))
+        request = json.loads(self.rfile.read(length))
+        prompt = request["messages"][-1]["content"]
+        openai = self.path.startswith("/v1/chat")
+
+        MockHandler.requests += 1
+        if self.drop_every and MockHandler.requests % self.drop_every == 0:
+            self.log_message("dropping request #%d", MockHandler.requests)
+            self.close_connection = True
+            return
+
+        if "error" in prompt:
+            body = json.dumps({"type": "error", "error": {"type": "rate_limit_error",
+                                                          "message": "mock rate limit"}}).encode()
+            self.send_response(429)
+            self.send_header("content-type", "application/json")
+            self.send_header("content-length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+            return
+
+        self.send_response(200)
+        self.send_header("content-type", "text/event-stream")
+        self.send_header("transfer-encoding", "chunked")
+        self.end_headers()
+
+        words = ("Mock reply to: " + prompt).split(" ")
+        if "tool" in prompt:
+            events = self.tool_events(openai)
+        elif openai:
+            events = self.openai_events(words)
+        else:
+            events = self.anthropic_events(words)
+
+        for event in events:
+            self.chunk(event)
+        self.chunk("")
+
+    def chunk(self, text):
+        data = text.encode()
+        self.wfile.write(b"%x\r\n%s\r\n" % (len(data), data))
+        self.wfile.flush()
+
+    def anthropic_events(self, words):
+        def sse(name, obj):
+            return "event: %s\ndata: %s\n\n" % (name, json.dumps(obj))
+
+        yield sse("message_start", {"type": "message_start", "message": {"role": "assistant"}})
+        yield sse("content_block_start", {"type": "content_block_start", "index": 0,
+                                          "content_block": {"type": "text", "text": ""}})
+        for i, word in enumerate(words):
+            time.sleep(self.delay)
+            text = word if i == 0 else " " + word
+            yield sse("content_block_delta", {"type": "content_block_delta", "index": 0,
+                                              "delta": {"type": "text_delta", "text": text}})
+        yield sse("content_block_stop", {"type": "content_block_stop", "index": 0})
+        yield sse("message_delta", {"type": "message_delta", "delta": {"stop_reason": "end_turn"}})
+        yield sse("message_stop", {"type": "message_stop"})
+
+    def openai_events(self, words):
+        def sse(delta, finish=None):
+            return "data: %s\n\n" % json.dumps({"choices": [{"index": 0, "delta": delta,
+                                                             "finish_reason": finish}]})
+
+        yield sse({"role": "assistant", "content": ""})
+        for i, word in enumerate(words):
+            time.sleep(self.delay)
+            yield sse({"content": word if i == 0 else " " + word})
+        yield sse({}, "stop")
+        yield "data: [DONE]\n\n"
+
+    def tool_events(self, openai):
+        args = ['{"zone":', ' "bed"}']
+        if openai:
+            yield "data: %s\n\n" % json.dumps({"choices": [{"delta": {"tool_calls": [
+                {"index": 0, "function": {"name": "get_presence", "arguments": ""}}]}}]})
+            for part in args:
+                yield "data: %s\n\n" % json.dumps({"choices": [{"delta": {"tool_calls": [
+                    {"index": 0, "function": {"arguments": part}}]}}]})
+            yield "data: %s\n\n" % json.dumps({"choices": [{"delta": {}, "finish_reason": "tool_calls"}]})
+            yield "data: [DONE]\n\n"
+        else:
+            yield "data: %s\n\n" % json.dumps({"type": "content_block_start", "index": 0, "content_block": {
+                "type": "tool_use", "id": "toolu_mock", "name": "get_presence", "input": {}}})
+            for part in args:
+                yield "data: %s\n\n" % json.dumps({"type": "content_block_delta", "index": 0, "delta": {
+                    "type": "input_json_delta", "partial_json": part}})
+            yield "data: %s\n\n" % json.dumps({"type": "message_delta", "delta": {"stop_reason": "tool_use"}})
+            yield "data: %s\n\n" % json.dumps({"type": "message_stop"})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--port", type=int, default=8080, help="0 = any free port")
+    parser.add_argument("--delay", type=float, default=0.02, help="seconds between deltas")
+    parser.add_argument("--drop-every", type=int, default=0, help="close instead of answering every Nth request")
+    args = parser.parse_args()
+
+    MockHandler.delay = args.delay
+    MockHandler.drop_every = args.drop_every
+    server = ThreadingHTTPServer(("0.0.0.0", args.port), MockHandler)
+    # --port 0 picks a free port; the line below names it (host tests read it)
+    print("Mock AI server on port %d (Ctrl+C to stop)" % server.server_address[1], flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,294 @@
+/*
+ * KVN_Connection.cpp - Implementation
+ */
+
+#include "KVN_Connection.h"
+#include <string.h>
+
+#define KVN_CONN_CACHE_MAGIC 0x4B564E43  // "KVNC"
+
+KVN_Connection::KVN_Connection(PubSubClient& mqtt) : _mqtt(mqtt) {
+    _ssid = nullptr;
+    _password = nullptr;
+    _clientId = nullptr;
+    _mqttUser = nullptr;
+    _mqttPass = nullptr;
+
+    _willTopic = nullptr;
+    _willMessage = nullptr;
+    _willRetained = true;
+    _willQos = 0;
+
+    _topicCount = 0;
+
+    _state = KVN_CONN_IDLE;
+    _stateSince = 0;
+    _retryAt = 0;
+    _failures = 0;
+
+    _backoffMinMs = 500;
+    _backoffMaxMs = 60000;
+    _wifiTimeoutMs = 15000;
+
+    _stateCb = nullptr;
+    _connectCb = nullptr;
+
+    _cache = nullptr;
+    _cleanSession = true;
+    _fastAttempt = false;
+    _staticIp = false;
+    memset(&_timing, 0, sizeof(_timing));
+}
+
+void KVN_Connection::begin(const char* ssid, const char* password, const char* clientId,
+                           const char* mqttUser, const char* mqttPass) {
+    _ssid = ssid;
+    _password = password;
+    _clientId = clientId;
+    _mqttUser = mqttUser;
+    _mqttPass = mqttPass;
+
+    WiFi.mode(WIFI_STA);
+
+    if (WiFi.status() == WL_CONNECTED) {
+        // Sketch brought WiFi up itself - go straight to the broker
+        _retryAt = millis();
+        setState(KVN_CONN_MQTT_BACKOFF);
+    } else {
+        startWiFi();
+    }
+}
+
+bool KVN_Connection::subscribe(const char* topic, uint8_t qos) {
+    if (_topicCount >= KVN_CONN_MAX_SUBSCRIPTIONS) return false;
+
+    _topics[_topicCount] = topic;
+    _qos[_topicCount] = qos;
+    _topicCount++;
+
+    // Already connected - subscribe now as well
+    if (connected()) {
+        _mqtt.subscribe(topic, qos);
+    }
+    return true;
+}
+
+void KVN_Connection::setWill(const char* topic, const char* message, bool retained, uint8_t qos) {
+    _willTopic = topic;
+    _willMessage = message;
+    _willRetained = retained;
+    _willQos = qos;
+}
+
+void KVN_Connection::setFastReconnect(KVNConnCache& cache) {
+    _cache = &cache;
+
+    // Cold boot: RTC memory holds whatever was there before
+    if (_cache->magic != KVN_CONN_CACHE_MAGIC) {
+        memset(_cache, 0, sizeof(*_cache));
+        _cache->magic = KVN_CONN_CACHE_MAGIC;
+    }
+
+    // Skip the NVS write WiFi.begin() otherwise does on every wake
+    WiFi.persistent(false);
+}
+
+bool KVN_Connection::waitConnected(uint32_t timeoutMs) {
+    unsigned long start = millis();
+    while (!connected() && millis() - start < timeoutMs) {
+        tick();
+        delay(5);
+    }
+    return connected();
+}
+
+void KVN_Connection::setBackoff(uint32_t minMs, uint32_t maxMs) {
+    _backoffMinMs = minMs;
+    _backoffMaxMs = maxMs < minMs ? minMs : maxMs;
+}
+
+void KVN_Connection::tick() {
+    unsigned long now = millis();
+
+    switch (_state) {
+        case KVN_CONN_IDLE:
+            break;
+
+        case KVN_CONN_WIFI_CONNECTING:
+            if (wifiConnected()) {
+                linkUp();
+                _failures = 0;
+                _retryAt = now;
+                setState(KVN_CONN_MQTT_BACKOFF);
+            } else if (_fastAttempt &&
+                       (now - _stateSince > KVN_CONN_FAST_TIMEOUT_MS ||
+                        WiFi.status() == WL_NO_SSID_AVAIL ||
+                        WiFi.status() == WL_CONNECT_FAILED)) {
+                // AP moved channel or went away - full scan straight away
+                dropLink();
+                startWiFi();
+            } else if (now - _stateSince > _wifiTimeoutMs) {
+                scheduleRetry();
+                setState(KVN_CONN_WIFI_BACKOFF);
+            }
+            break;
+
+        case KVN_CONN_WIFI_BACKOFF:
+            if (wifiConnected()) {
+                linkUp();
+                _failures = 0;
+                _retryAt = now;
+                setState(KVN_CONN_MQTT_BACKOFF);
+            } else if ((long)(now - _retryAt) >= 0) {
+                startWiFi();
+            }
+            break;
+
+        case KVN_CONN_MQTT_BACKOFF:
+            if (!wifiConnected()) {
+                startWiFi();
+            } else if ((long)(now - _retryAt) >= 0) {
+                if (tryMQTT()) break;
+
+                if (_timing.fast) {
+                    // The reused IP may belong to someone else now - rejoin
+                    // with DHCP rather than retrying on a suspect address
+                    dropLink();
+                    startWiFi();
+                } else {
+                    scheduleRetry();
+                }
+            }
+            break;
+
+        case KVN_CONN_CONNECTED:
+            if (!wifiConnected()) {
+                _mqtt.disconnect();
+                startWiFi();
+            } else if (!_mqtt.loop()) {
+                // Broker dropped us - first retry after the minimum delay
+                _failures = 0;
+                scheduleRetry();
+                setState(KVN_CONN_MQTT_BACKOFF);
+            }
+            break;
+    }
+}
+
+void KVN_Connection::startWiFi() {
+    WiFi.disconnect();
+
+    _fastAttempt = _cache != nullptr && _cache->link;
+
+    if (_fastAttempt) {
+        // Known AP: no scan, no DHCP round trip
+        WiFi.config(IPAddress(_cache->ip), IPAddress(_cache->gateway),
+                    IPAddress(_cache->subnet), IPAddress(_cache->dns));
+        _staticIp = true;
+        WiFi.begin(_ssid, _password, _cache->channel, _cache->bssid);
+    } else {
+        if (_staticIp) {
+            // Back to DHCP
+            WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
+            _staticIp = false;
+        }
+        WiFi.begin(_ssid, _password);
+    }
+
+    setState(KVN_CONN_WIFI_CONNECTING);
+}
+
+void KVN_Connection::linkUp() {
+    _timing.wifiMs = millis();
+    _timing.fast = _fastAttempt;
+    if (!_fastAttempt && _timing.fullScans < 0xFF) _timing.fullScans++;
+
+    if (_cache == nullptr) return;
+
+    memcpy(_cache->bssid, WiFi.BSSID(), sizeof(_cache->bssid));
+    _cache->channel = WiFi.channel();
+    _cache->ip = (uint32_t)WiFi.localIP();
+    _cache->gateway = (uint32_t)WiFi.gatewayIP();
+    _cache->subnet = (uint32_t)WiFi.subnetMask();
+    _cache->dns = (uint32_t)WiFi.dnsIP();
+    _cache->link = true;
+}
+
+void KVN_Connection::dropLink() {
+    _fastAttempt = false;
+    _timing.fast = false;
+    if (_cache) _cache->link = false;
+}
+
+bool KVN_Connection::tryMQTT() {
+    // PubSubClient skips the will when _willTopic is null
+    bool ok = _mqtt.connect(_clientId, _mqttUser, _mqttPass,
+                            _willTopic, _willQos, _willRetained, _willMessage,
+                            _cleanSession);
+    if (!ok) return false;
+
+    _timing.mqttMs = millis();
+
+    // A persistent session still holds the subscriptions from an earlier wake
+    bool resubscribe = _cleanSession || _cache == nullptr || !_cache->subscribed;
+    if (resubscribe) {
+        for (uint8_t i = 0; i < _topicCount; i++) {
+            _mqtt.subscribe(_topics[i], _qos[i]);
+        }
+        if (_cache && !_cleanSession) _cache->subscribed = true;
+    }
+
+    _failures = 0;
+    setState(KVN_CONN_CONNECTED);
+
+    if (_connectCb) {
+        _connectCb(_mqtt);
+    }
+    return true;
+}
+
+void KVN_Connection::scheduleRetry() {
+    // Exponential backoff: min * 2^failures, capped at max
+    uint32_t delayMs = _backoffMaxMs;
+    if (_failures < 16) {
+        uint32_t exp = _backoffMinMs << _failures;
+        if (exp < _backoffMaxMs) delayMs = exp;
+    }
+
+    // Equal jitter - keep half, randomise half - so devices that lost the
+    // broker together do not all retry in the same instant
+    delayMs = delayMs / 2 + random(delayMs / 2 + 1);
+
+    _retryAt = millis() + delayMs;
+    if (_failures < 0xFFFF) _failures++;
+}
+
+void KVN_Connection::setState(KVNConnState next) {
+    KVNConnState prev = _state;
+    _state = next;
+    _stateSince = millis();
+
+    if (prev != next && _stateCb) {
+        _stateCb(prev, next);
+    }
+}
+
+size_t KVN_Connection::formatLatency(char* buf, size_t len, uint32_t publishMs) const {
+    int n = snprintf(buf, len,
+                     "{\"wifi_ms\":%lu,\"mqtt_ms\":%lu,\"publish_ms\":%lu,\"fast\":%s,\"full_scans\":%u}",
+                     (unsigned long)_timing.wifiMs, (unsigned long)_timing.mqttMs,
+                     (unsigned long)publishMs, _timing.fast ? "true" : "false",
+                     (unsigned)_timing.fullScans);
+    return (n > 0 && (size_t)n < len) ? n : 0;
+}
+
+const char* KVN_Connection::stateName(KVNConnState state) {
+    switch (state) {
+        case KVN_CONN_IDLE:            return "IDLE";
+        case KVN_CONN_WIFI_CONNECTING: return "WIFI_CONNECTING";
+        case KVN_CONN_WIFI_BACKOFF:    return "WIFI_BACKOFF";
+        case KVN_CONN_MQTT_BACKOFF:    return "MQTT_BACKOFF";
+        case KVN_CONN_CONNECTED:       return "CONNECTED";
+    }
+    return "UNKNOWN";
+}
@@ -0,0 +1,160 @@
+/*
+ * KVN_Connection.h - Non-blocking WiFi + MQTT Connection Manager
+ *
+ * Shared connection state machine for all KVN ESP32 firmwares.
+ * Replaces the blocking `while (!mqtt.connected()) { ... delay(5000); }`
+ * reconnect loops: call tick() from loop() and it advances one step at
+ * a time, so displays, sensors and UARTs keep running during outages.
+ *
+ * Features:
+ *   - Exponential backoff with jitter for WiFi and MQTT retries
+ *   - Automatic resubscribe after every (re)connect
+ *   - Optional last-will message
+ *   - Callbacks on state transitions and on connect
+ *   - Fast reconnect for deep-sleeping devices: BSSID, channel and IP
+ *     lease cached in RTC memory, full scan only when that fails
+ *   - Persistent MQTT sessions (clean session off)
+ *
+ * Author: KVN System
+ * Version: 1.1.0
+ */
+
+#ifndef KVN_CONNECTION_H
+#define KVN_CONNECTION_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <PubSubClient.h>
+
+#define KVN_CONN_MAX_SUBSCRIPTIONS 8
+#define KVN_CONN_FAST_TIMEOUT_MS   2500   // Cached-channel join, then full scan
+
+enum KVNConnState {
+    KVN_CONN_IDLE,             // begin() not called yet
+    KVN_CONN_WIFI_CONNECTING,  // WiFi.begin() issued, waiting for link
+    KVN_CONN_WIFI_BACKOFF,     // WiFi attempt failed, waiting to retry
+    KVN_CONN_MQTT_BACKOFF,     // WiFi up, waiting to (re)try the broker
+    KVN_CONN_CONNECTED         // WiFi and MQTT both up
+};
+
+// Link details kept across deep sleep. Declare one RTC_DATA_ATTR and pass
+// it to setFastReconnect(); the manager fills it in on every connect.
+struct KVNConnCache {
+    uint32_t magic;        // Set once initialised
+    bool link;             // bssid..dns below are valid
+    bool subscribed;       // Broker holds our subscriptions (persistent session)
+    uint8_t channel;
+    uint8_t bssid[6];
+    uint32_t ip;           // Last DHCP lease, reused as a static address
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+};
+
+// millis() timestamps of the latest connect. After a deep-sleep wake
+// millis() starts at 0, so these are wake-relative on the first connect.
+struct KVNConnTiming {
+    uint32_t wifiMs;       // Link up
+    uint32_t mqttMs;       // Broker accepted the connect
+    bool fast;             // Joined on the cached BSSID/channel/IP
+    uint8_t fullScans;     // Full-scan joins since begin()
+};
+
+class KVN_Connection {
+public:
+    typedef void (*StateCallback)(KVNConnState from, KVNConnState to);
+    typedef void (*ConnectCallback)(PubSubClient& mqtt);
+
+    KVN_Connection(PubSubClient& mqtt);
+
+    // Start connecting. Strings must outlive the manager.
+    void begin(const char* ssid, const char* password, const char* clientId,
+               const char* mqttUser = nullptr, const char* mqttPass = nullptr);
+
+    // Advance the state machine; services mqtt.loop() while connected.
+    // Never blocks longer than a single MQTT connect attempt.
+    void tick();
+
+    // Topics are re-subscribed on every connect. Pointers must stay valid.
+    bool subscribe(const char* topic, uint8_t qos = 0);
+
+    // Last-will message published by the broker if we drop off
+    void setWill(const char* topic, const char* message, bool retained = true, uint8_t qos = 0);
+
+    // Retry timing (ms). Delay doubles per failure up to maxMs, with jitter.
+    void setBackoff(uint32_t minMs, uint32_t maxMs);
+    void setWiFiTimeout(uint32_t ms) { _wifiTimeoutMs = ms; }
+
+    // Join on the BSSID/channel/IP cached in `cache` (keep it in RTC
+    // memory) before falling back to a full scan with DHCP. Call before begin().
+    void setFastReconnect(KVNConnCache& cache);
+
+    // false = persistent session: the broker keeps subscriptions (and QoS 1
+    // messages) while we sleep, so they are only sent once per cold boot.
+    // Needs a client ID that is the same on every boot.
+    void setCleanSession(bool clean) { _cleanSession = clean; }
+
+    // Tick until connected or timeout. For deep-sleep sketches that wake,
+    // publish and sleep again - everything else should just call tick().
+    bool waitConnected(uint32_t timeoutMs);
+
+    void onStateChange(StateCallback cb) { _stateCb = cb; }
+    void onConnect(ConnectCallback cb) { _connectCb = cb; }
+
+    KVNConnState state() const { return _state; }
+    bool connected() const { return _state == KVN_CONN_CONNECTED; }
+    bool wifiConnected() const { return WiFi.status() == WL_CONNECTED; }
+    uint16_t failures() const { return _failures; }
+    const KVNConnTiming& timing() const { return _timing; }
+
+    // {"wifi_ms":..,"mqtt_ms":..,"publish_ms":..,"fast":true,"full_scans":0}
+    // publishMs is millis() after the sketch's first publish of this wake.
+    size_t formatLatency(char* buf, size_t len, uint32_t publishMs) const;
+
+    static const char* stateName(KVNConnState state);
+
+private:
+    PubSubClient& _mqtt;
+
+    const char* _ssid;
+    const char* _password;
+    const char* _clientId;
+    const char* _mqttUser;
+    const char* _mqttPass;
+
+    const char* _willTopic;
+    const char* _willMessage;
+    bool _willRetained;
+    uint8_t _willQos;
+
+    const char* _topics[KVN_CONN_MAX_SUBSCRIPTIONS];
+    uint8_t _qos[KVN_CONN_MAX_SUBSCRIPTIONS];
+    uint8_t _topicCount;
+
+    KVNConnState _state;
+    unsigned long _stateSince;
+    unsigned long _retryAt;
+    uint16_t _failures;
+
+    uint32_t _backoffMinMs;
+    uint32_t _backoffMaxMs;
+    uint32_t _wifiTimeoutMs;
+
+    StateCallback _stateCb;
+    ConnectCallback _connectCb;
+
+    KVNConnCache* _cache;
+    bool _cleanSession;
+    bool _fastAttempt;     // Current WiFi attempt uses the cache
+    bool _staticIp;        // WiFi.config() set a static address
+    KVNConnTiming _timing;
+
+    void setState(KVNConnState next);
+    void startWiFi();
+    void linkUp();
+    void dropLink();
+    bool tryMQTT();
+    void scheduleRetry();
+};
+
+#endif // KVN_CONNECTION_H
@@ -0,0 +1,72 @@
+/*
+ * KVN_Connection Basic Example
+ *
+ * Keeps WiFi + MQTT up without ever blocking loop().
+ * The LED keeps blinking while the broker is down to show that the
+ * sketch stays responsive during reconnects.
+ *
+ * Edit the credentials below before uploading.
+ */
+
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <KVN_Connection.h>
+
+#define WIFI_SSID     "your-wifi-ssid"
+#define WIFI_PASSWORD "your-wifi-password"
+#define MQTT_BROKER   "192.168.86.38"
+#define MQTT_PORT     1883
+#define DEVICE_ID     "kvn_connection_demo"
+
+#define LED_PIN 8
+
+WiFiClient espClient;
+PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+
+void onStateChange(KVNConnState from, KVNConnState to) {
+    Serial.print("Connection: ");
+    Serial.print(KVN_Connection::stateName(from));
+    Serial.print(" -> ");
+    Serial.println(KVN_Connection::stateName(to));
+}
+
+void onConnect(PubSubClient& client) {
+    // Runs after every (re)connect - subscriptions are already restored
+    client.publish("vanguard/demo/status", "online", true);
+}
+
+void onMessage(char* topic, byte* payload, unsigned int length) {
+    Serial.print(topic);
+    Serial.print(" = ");
+    Serial.write(payload, length);
+    Serial.println();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(500);
+
+    pinMode(LED_PIN, OUTPUT);
+
+    mqtt.setServer(MQTT_BROKER, MQTT_PORT);
+    mqtt.setCallback(onMessage);
+
+    conn.setBackoff(500, 30000);  // 0.5s doubling up to 30s
+    conn.setWill("vanguard/demo/status", "offline");
+    conn.subscribe("vanguard/demo/cmd");
+    conn.onStateChange(onStateChange);
+    conn.onConnect(onConnect);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, DEVICE_ID);
+}
+
+void loop() {
+    conn.tick();
+
+    // Work that must never stall
+    static unsigned long lastBlink = 0;
+    if (millis() - lastBlink > 250) {
+        digitalWrite(LED_PIN, !digitalRead(LED_PIN));
+        lastBlink = millis();
+    }
+}
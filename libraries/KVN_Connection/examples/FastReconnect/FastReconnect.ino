@@ -0,0 +1,58 @@
+/*
+ * KVN_Connection Fast Reconnect Example
+ *
+ * Deep-sleep cycle: wake, connect, publish, sleep 60 s. The first boot
+ * does a full scan; later wakes join the cached AP with the cached IP.
+ * Watch the latency topic: wifi_ms drops from ~1-3 s to a few hundred ms.
+ *
+ * Edit the credentials below before uploading.
+ */
+
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <KVN_Connection.h>
+
+#define WIFI_SSID     "your-wifi-ssid"
+#define WIFI_PASSWORD "your-wifi-password"
+#define MQTT_BROKER   "192.168.86.38"
+#define MQTT_PORT     1883
+#define DEVICE_ID     "kvn_fast_reconnect_demo"
+
+#define SLEEP_SECONDS 60
+
+WiFiClient espClient;
+PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+
+RTC_DATA_ATTR KVNConnCache connCache;
+RTC_DATA_ATTR uint32_t bootCount = 0;
+
+void setup() {
+    Serial.begin(115200);
+    bootCount++;
+
+    mqtt.setServer(MQTT_BROKER, MQTT_PORT);
+    conn.setFastReconnect(connCache);
+    conn.setCleanSession(false);      // DEVICE_ID is fixed, so the session survives
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, DEVICE_ID);
+
+    if (conn.waitConnected(10000)) {
+        mqtt.publish("vanguard/demo/boot", String(bootCount).c_str());
+
+        char json[112];
+        if (conn.formatLatency(json, sizeof(json), millis()) > 0) {
+            mqtt.publish("vanguard/demo/latency", json);
+            Serial.println(json);
+        }
+        mqtt.disconnect();
+    } else {
+        Serial.println("Connect failed");
+    }
+
+    Serial.flush();
+    esp_sleep_enable_timer_wakeup(SLEEP_SECONDS * 1000000ULL);
+    esp_deep_sleep_start();
+}
+
+void loop() {
+}
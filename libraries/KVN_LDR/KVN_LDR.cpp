@@ -3,16 +3,101 @@
  */
 
 #include "KVN_LDR.h"
-#include <math.h>
+
+// ==================== COMPILE-TIME TABLES ====================
+// C++11 constexpr (single-return, recursive) so the tables are built by the
+// compiler and land in flash; nothing below runs on the device.
+
+namespace {
+
+constexpr double LN2 = 0.69314718055994530942;
+constexpr double LN10 = 2.30258509299404568402;
+
+// e^x by Taylor series (x is at most ~6 here)
+constexpr double ctExpTerm(double x, int n, double term, double sum) {
+    return n > 40 ? sum : ctExpTerm(x, n + 1, term * x / n, sum + term * x / n);
+}
+constexpr double ctExp(double x) {
+    return ctExpTerm(x, 1, 1.0, 1.0);
+}
+
+// ln(x) for x in (0, 1]: halve the range into [0.5, 1], then atanh series
+constexpr double ctAtanhTerm(double z2, double zn, int k, double sum) {
+    return k > 61 ? sum : ctAtanhTerm(z2, zn * z2, k + 2, sum + zn / k);
+}
+constexpr double ctLn(double x) {
+    return x < 0.5 ? ctLn(x * 2.0) - LN2
+         : 2.0 * ctAtanhTerm(((x - 1.0) / (x + 1.0)) * ((x - 1.0) / (x + 1.0)),
+                             (x - 1.0) / (x + 1.0), 1, 0.0);
+}
+
+constexpr uint16_t ctRound(double v) {
+    return (uint16_t)(v + 0.5);
+}
+
+// Lux at ADC value adc (one table entry per 16 ADC counts)
+constexpr uint16_t luxAt(int adc) {
+    return adc <= LDR_LUX_ADC_MIN ? LDR_LUX_MIN
+         : ctRound(LDR_LUX_MIN * ctExp(LN10 * LDR_LUX_DECADES * (adc - LDR_LUX_ADC_MIN) / LDR_LUX_ADC_SPAN));
+}
+
+constexpr uint8_t gammaAt(int v) {
+    return v == 0 ? 0 : (uint8_t)(ctExp(LDR_GAMMA * ctLn(v / 255.0)) * 255.0);
+}
+
+#define LUX_ROW(i) \
+    luxAt(((i) + 0) << 4), luxAt(((i) + 1) << 4), luxAt(((i) + 2) << 4), luxAt(((i) + 3) << 4), \
+    luxAt(((i) + 4) << 4), luxAt(((i) + 5) << 4), luxAt(((i) + 6) << 4), luxAt(((i) + 7) << 4), \
+    luxAt(((i) + 8) << 4), luxAt(((i) + 9) << 4), luxAt(((i) + 10) << 4), luxAt(((i) + 11) << 4), \
+    luxAt(((i) + 12) << 4), luxAt(((i) + 13) << 4), luxAt(((i) + 14) << 4), luxAt(((i) + 15) << 4)
+
+#define GAMMA_ROW(i) \
+    gammaAt((i) + 0), gammaAt((i) + 1), gammaAt((i) + 2), gammaAt((i) + 3), \
+    gammaAt((i) + 4), gammaAt((i) + 5), gammaAt((i) + 6), gammaAt((i) + 7), \
+    gammaAt((i) + 8), gammaAt((i) + 9), gammaAt((i) + 10), gammaAt((i) + 11), \
+    gammaAt((i) + 12), gammaAt((i) + 13), gammaAt((i) + 14), gammaAt((i) + 15)
+
+// 257 entries so interpolation at the top of the 12-bit range needs no check
+constexpr uint16_t LUX_TABLE[257] = {
+    LUX_ROW(0),   LUX_ROW(16),  LUX_ROW(32),  LUX_ROW(48),
+    LUX_ROW(64),  LUX_ROW(80),  LUX_ROW(96),  LUX_ROW(112),
+    LUX_ROW(128), LUX_ROW(144), LUX_ROW(160), LUX_ROW(176),
+    LUX_ROW(192), LUX_ROW(208), LUX_ROW(224), LUX_ROW(240),
+    luxAt(4096)
+};
+
+constexpr uint8_t GAMMA_TABLE[256] = {
+    GAMMA_ROW(0),   GAMMA_ROW(16),  GAMMA_ROW(32),  GAMMA_ROW(48),
+    GAMMA_ROW(64),  GAMMA_ROW(80),  GAMMA_ROW(96),  GAMMA_ROW(112),
+    GAMMA_ROW(128), GAMMA_ROW(144), GAMMA_ROW(160), GAMMA_ROW(176),
+    GAMMA_ROW(192), GAMMA_ROW(208), GAMMA_ROW(224), GAMMA_ROW(240)
+};
+
+#undef LUX_ROW
+#undef GAMMA_ROW
+
+static_assert(LUX_TABLE[256] > LUX_TABLE[255], "lux table must be increasing");
+
+} // namespace
+
+// ==================== SAMPLING ====================
 
 KVN_LDR::KVN_LDR(uint8_t pin, uint16_t minADC, uint16_t maxADC) {
     _pin = pin;
     _minADC = minADC;
     _maxADC = maxADC;
     _lastRaw = 0;
-    _smoothedValue = 0;
-    _smoothingFactor = 0.1;  // 10% new value, 90% old value
+    _smoothedQ8 = 0;
     _lastReadTime = 0;
+    _oversample = 1;
+    memset(&_snapshot, 0, sizeof(_snapshot));
+
+    _lastReportedValue = 0;
+    _publishedValue = 0;
+    _publishedTime = 0;
+    _hasPublished = false;
+    _deadband = 200;
+    _minPublishInterval = 0;
 }
 
 void KVN_LDR::begin() {
@@ -25,73 +110,121 @@ void KVN_LDR::begin() {
     #endif
 
     // Initial reading
-    _lastRaw = analogRead(_pin);
-    _smoothedValue = _lastRaw;
-    _lastReadTime = millis();
+    readRaw();
+    _smoothedQ8 = (uint32_t)_lastRaw << 8;
+}
+
+void KVN_LDR::setOversampling(uint8_t samples) {
+    _oversample = constrain(samples, 1, 64);
 }
 
 uint16_t KVN_LDR::readRaw() {
-    _lastRaw = analogRead(_pin);
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < _oversample; i++) {
+        sum += analogRead(_pin);
+    }
+
+    _lastRaw = sum / _oversample;
     _lastReadTime = millis();
     return _lastRaw;
 }
 
-uint16_t KVN_LDR::readSmoothed() {
-    uint16_t raw = readRaw();
-
-    // Exponential moving average
-    _smoothedValue = (_smoothingFactor * raw) + ((1.0 - _smoothingFactor) * _smoothedValue);
-
-    return (uint16_t)_smoothedValue;
+void KVN_LDR::applyEMA(uint16_t raw) {
+    // Exponential moving average in Q8 fixed point. Keeping the fraction
+    // lets the average settle on the input instead of sticking a few
+    // counts short, as a truncated integer EMA does.
+    int32_t diff = ((int32_t)raw << 8) - (int32_t)_smoothedQ8;
+    _smoothedQ8 += (diff * LDR_EMA_ALPHA_Q8) / 256;
 }
 
-uint8_t KVN_LDR::getBrightness(uint8_t minBrightness, uint8_t maxBrightness, bool useGamma) {
-    uint16_t ldrValue = readSmoothed();
-
-    // Map ADC reading to brightness range
-    int brightness = map(ldrValue, _minADC, _maxADC, minBrightness, maxBrightness);
-    brightness = constrain(brightness, minBrightness, maxBrightness);
+uint16_t KVN_LDR::readSmoothed() {
+    applyEMA(readRaw());
+    return smoothedValue();
+}
 
-    // Apply gamma correction for natural perception
-    if (useGamma) {
-        return applyGamma(brightness);
-    }
+const LDRSnapshot& KVN_LDR::sample() {
+    readSmoothed();
+    return derive();
+}
 
-    return brightness;
+const LDRSnapshot& KVN_LDR::update(uint16_t raw) {
+    _lastRaw = raw;
+    _lastReadTime = millis();
+    applyEMA(raw);
+    return derive();
 }
 
-uint8_t KVN_LDR::getLightLevel() {
-    uint16_t lux = getLux();
+const LDRSnapshot& KVN_LDR::derive() {
+    uint16_t smoothed = smoothedValue();
 
-    if (lux < 10) return LDR_LEVEL_DARK;
-    else if (lux < 50) return LDR_LEVEL_DIM;
-    else if (lux < 200) return LDR_LEVEL_NORMAL;
-    else if (lux < 1000) return LDR_LEVEL_BRIGHT;
-    else return LDR_LEVEL_VERY_BRIGHT;
+    _snapshot.raw = _lastRaw;
+    _snapshot.smoothed = smoothed;
+    _snapshot.lux = luxFromADC(smoothed);
+    _snapshot.level = levelFromLux(_snapshot.lux);
+    _snapshot.brightness = brightnessFromADC(smoothed);
+    _snapshot.isDay = smoothed > LDR_DAY_THRESHOLD;
+    _snapshot.timestamp = _lastReadTime;
+
+    return _snapshot;
 }
 
-uint16_t KVN_LDR::getLux() {
-    uint16_t raw = readSmoothed();
+// ==================== CONVERSIONS ====================
 
+uint16_t KVN_LDR::luxFromADC(uint16_t adc) {
     // Approximate lux conversion for 5528 LDR
     // This is a rough approximation - actual lux depends on:
     //   - LDR spectral response
     //   - Resistor value (10kΩ assumed)
     //   - Light spectrum
 
-    // Empirical formula for 5528 with 10kΩ resistor:
+    // Empirical curve for 5528 with 10kΩ resistor:
     // ADC 500 ≈ 10 lux (dim room)
     // ADC 1500 ≈ 50 lux (normal room)
     // ADC 2500 ≈ 200 lux (bright room)
     // ADC 3500 ≈ 1000 lux (very bright)
 
-    if (raw < 500) return 5;  // Very dark
+    if (adc > 4095) adc = 4095;
+
+    // Linear interpolation between entries 16 ADC counts apart
+    uint16_t index = adc >> 4;
+    uint16_t frac = adc & 0x0F;
+    uint16_t lo = LUX_TABLE[index];
+    uint16_t hi = LUX_TABLE[index + 1];
+
+    return lo + (((uint32_t)(hi - lo) * frac) >> 4);
+}
+
+uint8_t KVN_LDR::levelFromLux(uint16_t lux) {
+    if (lux < 10) return LDR_LEVEL_DARK;
+    else if (lux < 50) return LDR_LEVEL_DIM;
+    else if (lux < 200) return LDR_LEVEL_NORMAL;
+    else if (lux < 1000) return LDR_LEVEL_BRIGHT;
+    else return LDR_LEVEL_VERY_BRIGHT;
+}
+
+uint8_t KVN_LDR::brightnessFromADC(uint16_t adc, uint8_t minBrightness, uint8_t maxBrightness, bool useGamma) const {
+    // Map ADC reading to brightness range
+    int brightness = map(adc, _minADC, _maxADC, minBrightness, maxBrightness);
+    brightness = constrain(brightness, minBrightness, maxBrightness);
 
-    // Logarithmic approximation
-    float normalized = (raw - 500) / 3000.0;  // 0.0 to 1.0
-    uint16_t lux = (uint16_t)(pow(10, normalized * 2.5) * 5);  // 5 to ~1585 lux
+    // Apply gamma correction for natural perception
+    if (useGamma) {
+        return applyGamma(brightness);
+    }
 
-    return lux;
+    return brightness;
+}
+
+uint8_t KVN_LDR::getBrightness(uint8_t minBrightness, uint8_t maxBrightness, bool useGamma) {
+    return brightnessFromADC(readSmoothed(), minBrightness, maxBrightness, useGamma);
+}
+
+uint8_t KVN_LDR::getLightLevel() {
+    return levelFromLux(getLux());
+}
+
+uint16_t KVN_LDR::getLux() {
+    return luxFromADC(readSmoothed());
 }
 
 bool KVN_LDR::isDay(uint16_t threshold) {
@@ -99,30 +232,59 @@ bool KVN_LDR::isDay(uint16_t threshold) {
 }
 
 bool KVN_LDR::hasChanged(uint16_t threshold) {
-    static uint16_t lastReportedValue = 0;
     uint16_t current = readSmoothed();
 
-    if (abs((int)current - (int)lastReportedValue) > threshold) {
-        lastReportedValue = current;
+    if (abs((int)current - (int)_lastReportedValue) > threshold) {
+        _lastReportedValue = current;
         return true;
     }
 
     return false;
 }
 
+void KVN_LDR::setDeadband(uint16_t adcCounts) {
+    _deadband = adcCounts;
+}
+
+void KVN_LDR::setMinPublishInterval(unsigned long ms) {
+    _minPublishInterval = ms;
+}
+
+bool KVN_LDR::shouldPublish() {
+    uint16_t current = _snapshot.smoothed;
+
+    if (_hasPublished) {
+        if (abs((int)current - (int)_publishedValue) <= _deadband) return false;
+        if (_snapshot.timestamp - _publishedTime < _minPublishInterval) return false;
+    }
+
+    _hasPublished = true;
+    _publishedValue = current;
+    _publishedTime = _snapshot.timestamp;
+    return true;
+}
+
+// ==================== EXPORT ====================
+
 String KVN_LDR::toJSON() {
-    uint16_t raw = readSmoothed();
-    uint16_t lux = getLux();
-    uint8_t level = getLightLevel();
+    char buffer[64];
+    toJSON(buffer, sizeof(buffer));
+    return String(buffer);
+}
 
-    String json = "{";
-    json += "\"raw\":" + String(raw) + ",";
-    json += "\"lux\":" + String(lux) + ",";
-    json += "\"level\":" + String(level) + ",";
-    json += "\"is_day\":" + String(isDay() ? "true" : "false");
-    json += "}";
+size_t KVN_LDR::toJSON(char* buffer, size_t len) {
+    return formatJSON(sample(), buffer, len);
+}
 
-    return json;
+size_t KVN_LDR::formatJSON(const LDRSnapshot& snap, char* buffer, size_t len) {
+    int n = snprintf(buffer, len, "{\"raw\":%u,\"lux\":%u,\"level\":%u,\"is_day\":%s}",
+                     snap.smoothed, snap.lux, snap.level, snap.isDay ? "true" : "false");
+    if (n < 0 || (size_t)n >= len) {
+        if (len > 0) buffer[0] = '\0';
+        return 0;
+    }
+
+    return n;
 }
 
 void KVN_LDR::setCalibration(uint16_t minADC, uint16_t maxADC) {
@@ -171,27 +333,24 @@ void KVN_LDR::autoCalibrate(uint16_t samples, uint16_t delayMs) {
 }
 
 void KVN_LDR::printDebug() {
-    uint16_t raw = readSmoothed();
-    uint16_t lux = getLux();
-    uint8_t level = getLightLevel();
-    uint8_t brightness = getBrightness();
+    printDebug(sample());
+}
 
+void KVN_LDR::printDebug(const LDRSnapshot& snap) {
     const char* levelNames[] = {"DARK", "DIM", "NORMAL", "BRIGHT", "VERY_BRIGHT"};
 
     Serial.print("LDR: Raw=");
-    Serial.print(raw);
+    Serial.print(snap.smoothed);
     Serial.print(" | Lux=");
-    Serial.print(lux);
+    Serial.print(snap.lux);
     Serial.print(" | Level=");
-    Serial.print(levelNames[level]);
+    Serial.print(levelNames[snap.level]);
     Serial.print(" | Brightness=");
-    Serial.print(brightness);
+    Serial.print(snap.brightness);
     Serial.print("/255 | Day=");
-    Serial.println(isDay() ? "YES" : "NO");
+    Serial.println(snap.isDay ? "YES" : "NO");
 }
 
-uint8_t KVN_LDR::applyGamma(uint8_t value, float gamma) {
-    float normalized = value / 255.0;
-    float corrected = pow(normalized, gamma);
-    return (uint8_t)(corrected * 255);
+uint8_t KVN_LDR::applyGamma(uint8_t value) {
+    return GAMMA_TABLE[value];
 }
@@ -13,7 +13,7 @@
  * Hardware: 5528 LDR + 10kΩ voltage divider
  *
  * Author: KVN System
- * Version: 1.0.0
+ * Version: 1.1.0
  * Last Updated: 2025-12-08
  */
 
@@ -29,6 +29,44 @@
 #define LDR_LEVEL_BRIGHT    3   // 200-1000 lux
 #define LDR_LEVEL_VERY_BRIGHT 4 // > 1000 lux
 
+// Lux curve for 5528 LDR + 10kΩ: lux = LUX_MIN * 10^(DECADES * (adc - ADC_MIN) / ADC_SPAN)
+// Baked into a lookup table at compile time; override before including to recalibrate.
+#ifndef LDR_LUX_ADC_MIN
+#define LDR_LUX_ADC_MIN     500   // Below this reads as LDR_LUX_MIN
+#endif
+#ifndef LDR_LUX_ADC_SPAN
+#define LDR_LUX_ADC_SPAN    3000
+#endif
+#ifndef LDR_LUX_DECADES
+#define LDR_LUX_DECADES     2.5
+#endif
+#ifndef LDR_LUX_MIN
+#define LDR_LUX_MIN         5
+#endif
+
+// Backlight gamma (compile-time lookup table)
+#ifndef LDR_GAMMA
+#define LDR_GAMMA           2.2
+#endif
+
+// EMA weight of a new sample in 1/256 steps (26 ≈ 0.1)
+#ifndef LDR_EMA_ALPHA_Q8
+#define LDR_EMA_ALPHA_Q8    26
+#endif
+
+#define LDR_DAY_THRESHOLD   1500
+
+// Every derived value from one ADC read
+struct LDRSnapshot {
+    uint16_t raw;          // ADC reading
+    uint16_t smoothed;     // EMA after this reading
+    uint16_t lux;
+    uint8_t level;         // LDR_LEVEL_*
+    uint8_t brightness;    // getBrightness() defaults (30-255, gamma)
+    bool isDay;            // smoothed > LDR_DAY_THRESHOLD
+    unsigned long timestamp;
+};
+
 class KVN_LDR {
 public:
     // Constructor
@@ -37,9 +75,12 @@ public:
     // Initialization
     void begin();
 
-    // Read raw ADC value (0-4095 for 12-bit)
+    // Read raw ADC value (0-4095 for 12-bit), averaged over the oversampling count
     uint16_t readRaw();
 
+    // Average this many ADC conversions per reading (1-64, default 1)
+    void setOversampling(uint8_t samples);
+
     // Read with smoothing (exponential moving average)
     uint16_t readSmoothed();
 
@@ -55,30 +96,78 @@ public:
     // Check if it's day or night (simple threshold)
     bool isDay(uint16_t threshold = 1500);
 
+    // Read the ADC once and derive everything from that reading.
+    // Prefer this over calling several getters in a row, which each read the ADC.
+    const LDRSnapshot& sample();
+
+    // Last sample() result (no ADC read)
+    const LDRSnapshot& snapshot() const { return _snapshot; }
+
+    // Feed a reading taken elsewhere (e.g. KVN_LDRArray::sampleAll) through
+    // the same smoothing and conversions as sample()
+    const LDRSnapshot& update(uint16_t raw);
+
+    // Table-driven conversions (no ADC read, no floating point)
+    static uint16_t luxFromADC(uint16_t adc);
+    static uint8_t levelFromLux(uint16_t lux);
+    uint8_t brightnessFromADC(uint16_t adc, uint8_t minBrightness = 30, uint8_t maxBrightness = 255, bool useGamma = true) const;
+
     // Check if light level changed significantly (for triggering events)
     bool hasChanged(uint16_t threshold = 200);
 
+    // Publish gating on the current snapshot: true when the smoothed value
+    // has moved more than the deadband since the last accepted publish and
+    // at least the minimum interval has passed. Always true the first time.
+    void setDeadband(uint16_t adcCounts);
+    void setMinPublishInterval(unsigned long ms);
+    bool shouldPublish();
+
     // Get JSON string for MQTT publishing
     String toJSON();
 
+    // Same JSON written into a caller buffer (no heap).
+    // Returns length written, 0 if the buffer was too small.
+    size_t toJSON(char* buffer, size_t len);
+
+    // JSON for an existing snapshot (no ADC read)
+    static size_t formatJSON(const LDRSnapshot& snap, char* buffer, size_t len);
+
     // Calibration helpers
     void setCalibration(uint16_t minADC, uint16_t maxADC);
     void autoCalibrate(uint16_t samples = 100, uint16_t delayMs = 10);
 
     // Debug output
     void printDebug();
+    // Same line for an existing snapshot (no ADC read)
+    static void printDebug(const LDRSnapshot& snap);
+
+    uint8_t pin() const { return _pin; }
 
 private:
     uint8_t _pin;
     uint16_t _minADC;
     uint16_t _maxADC;
     uint16_t _lastRaw;
-    uint16_t _smoothedValue;
-    float _smoothingFactor;
+    uint32_t _smoothedQ8;      // EMA in 1/256 ADC steps
     unsigned long _lastReadTime;
+    uint8_t _oversample;
+    LDRSnapshot _snapshot;
+
+    // Change detection (per instance)
+    uint16_t _lastReportedValue;
+    uint16_t _publishedValue;
+    unsigned long _publishedTime;
+    bool _hasPublished;
+    uint16_t _deadband;
+    unsigned long _minPublishInterval;
+
+    void applyEMA(uint16_t raw);
+    const LDRSnapshot& derive();
+
+    uint16_t smoothedValue() const { return (_smoothedQ8 + 128) >> 8; }
 
-    // Gamma correction for perceived brightness
-    uint8_t applyGamma(uint8_t value, float gamma = 2.2);
+    // Gamma correction for perceived brightness (LDR_GAMMA table)
+    static uint8_t applyGamma(uint8_t value);
 };
 
 #endif // KVN_LDR_H
@@ -0,0 +1,105 @@
+/*
+ * KVN_LDRArray.cpp - Implementation
+ */
+
+#include "KVN_LDRArray.h"
+
+#if defined(ESP32) && defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+#include "soc/soc_caps.h"
+#if SOC_ADC_DMA_SUPPORTED
+#define LDR_ARRAY_HAS_CONTINUOUS 1
+#endif
+#endif
+
+// One continuous frame is LDR_ARRAY_CONVERSIONS * channels samples;
+// at 20 kHz with 8 channels that is ~6.4 ms
+#define LDR_ARRAY_READ_TIMEOUT_MS 20
+
+KVN_LDRArray::KVN_LDRArray() {
+    _count = 0;
+    _continuous = false;
+}
+
+bool KVN_LDRArray::add(KVN_LDR& channel) {
+    if (_count >= LDR_ARRAY_MAX_CHANNELS) return false;
+    _channels[_count++] = &channel;
+    return true;
+}
+
+void KVN_LDRArray::begin() {
+    // Seeds each channel's EMA with a normal read
+    for (uint8_t i = 0; i < _count; i++) {
+        _channels[i]->begin();
+    }
+
+    _continuous = beginContinuous();
+}
+
+void KVN_LDRArray::end() {
+#ifdef LDR_ARRAY_HAS_CONTINUOUS
+    if (_continuous) {
+        analogContinuousStop();
+        analogContinuousDeinit();
+        _continuous = false;
+    }
+#endif
+}
+
+uint32_t KVN_LDRArray::sampleAll() {
+    if (_continuous) {
+        if (!readContinuous()) return 0;
+    } else {
+        for (uint8_t i = 0; i < _count; i++) {
+            _channels[i]->sample();
+        }
+    }
+
+    uint32_t changed = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_channels[i]->shouldPublish()) changed |= 1UL << i;
+    }
+    return changed;
+}
+
+bool KVN_LDRArray::beginContinuous() {
+#ifdef LDR_ARRAY_HAS_CONTINUOUS
+    if (_count == 0) return false;
+
+    uint8_t pins[LDR_ARRAY_MAX_CHANNELS];
+    for (uint8_t i = 0; i < _count; i++) {
+        pins[i] = _channels[i]->pin();
+    }
+
+    analogContinuousSetWidth(12);
+    analogContinuousSetAtten(ADC_11db);
+
+    // Fails for pins on ADC2 or without DMA support; fall back to analogRead()
+    if (!analogContinuous(pins, _count, LDR_ARRAY_CONVERSIONS, LDR_ARRAY_SAMPLE_HZ, nullptr)) {
+        return false;
+    }
+    if (!analogContinuousStart()) {
+        analogContinuousDeinit();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool KVN_LDRArray::readContinuous() {
+#ifdef LDR_ARRAY_HAS_CONTINUOUS
+    adc_continuous_data_t* result = nullptr;
+    if (!analogContinuousRead(&result, LDR_ARRAY_READ_TIMEOUT_MS)) return false;
+
+    // Result entries follow the pin order given to analogContinuous()
+    for (uint8_t i = 0; i < _count; i++) {
+        if (result[i].pin == _channels[i]->pin()) {
+            _channels[i]->update(result[i].avg_read_raw);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,70 @@
+/*
+ * KVN_LDRArray.h - Multi-channel LDR sampler
+ *
+ * Samples several KVN_LDR channels in one pass. Each channel keeps its
+ * own smoothing, deadband and publish-interval state, so two LDRs on one
+ * board never share a reference point.
+ *
+ * On Arduino-ESP32 3.x the channels are read with the continuous ADC
+ * driver: the hardware averages LDR_ARRAY_CONVERSIONS conversions per pin
+ * in the background and sampleAll() only collects the result. On older
+ * cores, or if the driver cannot be started (e.g. a pin on ADC2), each
+ * channel falls back to oversampled analogRead().
+ *
+ *   KVN_LDR window(0), door(1);
+ *   KVN_LDRArray lights;
+ *   lights.add(window);
+ *   lights.add(door);
+ *   lights.begin();
+ *
+ *   uint32_t changed = lights.sampleAll();
+ *   if (changed & (1 << 0)) publish(window.snapshot());
+ *
+ * Do not call the channels' own read functions while continuous mode is
+ * running; analogRead() and the continuous driver share the ADC.
+ *
+ * Author: KVN System
+ * Version: 1.1.0
+ */
+
+#ifndef KVN_LDR_ARRAY_H
+#define KVN_LDR_ARRAY_H
+
+#include <Arduino.h>
+#include "KVN_LDR.h"
+
+#define LDR_ARRAY_MAX_CHANNELS 8
+#define LDR_ARRAY_CONVERSIONS  16     // Conversions averaged per pin per frame
+#define LDR_ARRAY_SAMPLE_HZ    20000  // Continuous ADC sample rate
+
+class KVN_LDRArray {
+public:
+    KVN_LDRArray();
+
+    // Register a channel (not owned). Returns false when full.
+    bool add(KVN_LDR& channel);
+
+    // Configure the ADC; call after all add()s
+    void begin();
+
+    // Read every channel once, update snapshots and run each channel's
+    // shouldPublish(). Returns a bitmask of channels that should publish.
+    uint32_t sampleAll();
+
+    // Stop the continuous driver (e.g. before deep sleep)
+    void end();
+
+    uint8_t size() const { return _count; }
+    KVN_LDR& channel(uint8_t index) { return *_channels[index]; }
+    bool continuous() const { return _continuous; }
+
+private:
+    KVN_LDR* _channels[LDR_ARRAY_MAX_CHANNELS];
+    uint8_t _count;
+    bool _continuous;
+
+    bool beginContinuous();
+    bool readContinuous();
+};
+
+#endif // KVN_LDR_ARRAY_H
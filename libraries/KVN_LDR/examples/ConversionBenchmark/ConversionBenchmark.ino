@@ -0,0 +1,119 @@
+/*
+ * KVN_LDR Conversion Benchmark
+ *
+ * Measures CPU cycles per call for the old floating-point conversions
+ * (pow() per read) against the compile-time lookup tables, and the cost
+ * of reading several values the old way (one ADC read per getter) against
+ * a single sample(). Also checks the tables against the float formulas
+ * and prints PASS/FAIL.
+ *
+ * Most useful on the FPU-less ESP32-C3, where pow() is done in software.
+ *
+ * Hardware: LDR on LDR_PIN (any value works - only timing matters)
+ */
+
+#include <KVN_LDR.h>
+#include <math.h>
+
+#define LDR_PIN 0
+#define ITERATIONS 4096
+
+KVN_LDR ldr(LDR_PIN);
+
+volatile uint32_t sink;
+
+// ==================== PREVIOUS IMPLEMENTATION ====================
+
+uint16_t legacyLux(uint16_t raw) {
+    if (raw < 500) return 5;
+    float normalized = (raw - 500) / 3000.0;
+    return (uint16_t)(pow(10, normalized * 2.5) * 5);
+}
+
+uint8_t legacyGamma(uint8_t value) {
+    float normalized = value / 255.0;
+    float corrected = pow(normalized, 2.2);
+    return (uint8_t)(corrected * 255);
+}
+
+// ==================== BENCHMARK ====================
+
+void report(const char* name, uint32_t cycles, uint32_t calls) {
+    Serial.printf("%-34s %8.1f cycles/call\n", name, (float)cycles / calls);
+}
+
+void check(const char* name, bool ok) {
+    Serial.printf("  %-28s %s\n", name, ok ? "PASS" : "FAIL");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    ldr.begin();
+
+    Serial.println("\n=== KVN_LDR Conversion Benchmark ===\n");
+
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t adc = 0; adc < ITERATIONS; adc++) sink = legacyLux(adc);
+    report("lux: pow()", ESP.getCycleCount() - start, ITERATIONS);
+
+    start = ESP.getCycleCount();
+    for (uint32_t adc = 0; adc < ITERATIONS; adc++) sink = KVN_LDR::luxFromADC(adc);
+    report("lux: table", ESP.getCycleCount() - start, ITERATIONS);
+
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < ITERATIONS; i++) sink = legacyGamma(i & 0xFF);
+    report("gamma: pow()", ESP.getCycleCount() - start, ITERATIONS);
+
+    // brightnessFromADC includes the map() to the brightness range
+    start = ESP.getCycleCount();
+    for (uint32_t adc = 0; adc < ITERATIONS; adc++) sink = ldr.brightnessFromADC(adc);
+    report("brightness: map + gamma table", ESP.getCycleCount() - start, ITERATIONS);
+
+    // What toJSON() used to do: four getters, four ADC reads
+    const uint32_t reads = 256;
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < reads; i++) {
+        sink = ldr.readSmoothed();
+        sink = ldr.getLux();
+        sink = ldr.getLightLevel();
+        sink = ldr.isDay();
+    }
+    report("raw+lux+level+day: 4 getters", ESP.getCycleCount() - start, reads);
+
+    start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < reads; i++) {
+        sink = ldr.sample().lux;
+    }
+    report("raw+lux+level+day: sample()", ESP.getCycleCount() - start, reads);
+
+    // Accuracy against the float formulas: within 1 lux or 1%, one gamma step
+    int worstLux = 0;
+    uint16_t worstAt = 0;
+    bool luxOk = true;
+    for (uint16_t adc = 0; adc < 4096; adc++) {
+        int err = abs((int)KVN_LDR::luxFromADC(adc) - (int)legacyLux(adc));
+        if (err > 1 && err * 100 > legacyLux(adc)) luxOk = false;
+        if (err > worstLux) {
+            worstLux = err;
+            worstAt = adc;
+        }
+    }
+    Serial.printf("\nWorst lux difference: %d lux at ADC %u (%u lux)\n",
+                  worstLux, worstAt, legacyLux(worstAt));
+
+    int worstGamma = 0;
+    for (uint16_t adc = 0; adc < 4096; adc++) {
+        // The same mapped value, with and without the gamma table
+        uint8_t value = ldr.brightnessFromADC(adc, 0, 255, false);
+        int err = abs((int)ldr.brightnessFromADC(adc, 0, 255) - (int)legacyGamma(value));
+        if (err > worstGamma) worstGamma = err;
+    }
+    Serial.printf("Worst gamma difference: %d steps\n\n", worstGamma);
+
+    check("lux table within 1 lux or 1%", luxOk);
+    check("gamma table within 1 step", worstGamma <= 1);
+}
+
+void loop() {
+}
@@ -94,12 +94,13 @@ void loop() {
     if (ldr.hasChanged(200)) {  // Threshold: 200 ADC units
         // Publish to MQTT
         String topic = "homeassistant/sensor/" + deviceId + "/ambient_light";
-        String payload = ldr.toJSON();
+        char payload[64];
+        ldr.toJSON(payload, sizeof(payload));
 
         Serial.print("Publishing: ");
         Serial.println(payload);
 
-        mqtt.publish(topic.c_str(), payload.c_str());
+        mqtt.publish(topic.c_str(), payload);
 
         // Also publish individual values for Home Assistant auto-discovery
         String luxTopic = "homeassistant/sensor/" + deviceId + "/lux";
@@ -0,0 +1,60 @@
+/*
+ * KVN_LDR Multi-Channel Example
+ *
+ * Two LDRs on one board (e.g. window and room) sampled together with
+ * KVN_LDRArray. Each channel has its own deadband and minimum publish
+ * interval, so a change on one never triggers or suppresses the other.
+ *
+ * Hardware:
+ *   - LDR + 10kΩ divider on GPIO 0 and GPIO 1 (both ADC1)
+ */
+
+#include <KVN_LDR.h>
+#include <KVN_LDRArray.h>
+
+KVN_LDR windowLight(0);
+KVN_LDR roomLight(1);
+KVN_LDRArray lights;
+
+const char* names[] = {"window", "room"};
+
+void setup() {
+    Serial.begin(115200);
+    delay(500);
+
+    // Window light swings a lot: wider deadband, at most once a minute
+    windowLight.setDeadband(300);
+    windowLight.setMinPublishInterval(60000);
+
+    // Room light: react to lights switching on/off within 5 seconds
+    roomLight.setDeadband(150);
+    roomLight.setMinPublishInterval(5000);
+
+    // Only used on the analogRead() fallback path
+    windowLight.setOversampling(8);
+    roomLight.setOversampling(8);
+
+    lights.add(windowLight);
+    lights.add(roomLight);
+    lights.begin();
+
+    Serial.print("ADC mode: ");
+    Serial.println(lights.continuous() ? "continuous (DMA)" : "analogRead");
+}
+
+void loop() {
+    uint32_t changed = lights.sampleAll();
+
+    for (uint8_t i = 0; i < lights.size(); i++) {
+        if (!(changed & (1UL << i))) continue;
+
+        char json[64];
+        KVN_LDR::formatJSON(lights.channel(i).snapshot(), json, sizeof(json));
+
+        Serial.print(names[i]);
+        Serial.print(": ");
+        Serial.println(json);  // mqtt.publish(topic[i], json) in a real sketch
+    }
+
+    delay(250);
+}
@@ -0,0 +1,211 @@
+/*
+ * KVN_Probe.cpp - Implementation
+ */
+
+#include "KVN_Probe.h"
+#include <string.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#define SEEN_WINDOW 32
+
+// ==================== PROBE ====================
+
+KVN_Probe::KVN_Probe(const char* source) {
+    snprintf(_topic, sizeof(_topic), KVN_PROBE_TOPIC_PREFIX "%s", source);
+    _seq = 0;
+}
+
+size_t KVN_Probe::next(char* payload, size_t size, size_t padTo) {
+    size_t len = format(payload, size, _seq, nowUs(), padTo);
+    if (len) _seq++;
+    return len;
+}
+
+size_t KVN_Probe::format(char* payload, size_t size, uint32_t seq, uint64_t sentUs, size_t padTo) {
+    int len = snprintf(payload, size, "%lu:%llu", (unsigned long)seq, (unsigned long long)sentUs);
+    if (len < 0 || (size_t)len >= size) return 0;
+
+    if (padTo >= size) return 0;
+    while ((size_t)len < padTo) payload[len++] = ' ';
+    payload[len] = '\0';
+    return len;
+}
+
+bool KVN_Probe::parse(const uint8_t* payload, unsigned int length, uint32_t& seq, uint64_t& sentUs) {
+    // <seq>:<sent_us>, trailing padding ignored
+    uint64_t value = 0;
+    unsigned int i = 0, digits = 0;
+    for (; i < length && payload[i] >= '0' && payload[i] <= '9'; i++, digits++) {
+        value = value * 10 + (payload[i] - '0');
+    }
+    if (digits == 0 || digits > 10 || value > UINT32_MAX || i >= length || payload[i] != ':') return false;
+    seq = (uint32_t)value;
+
+    value = 0;
+    digits = 0;
+    for (i++; i < length && payload[i] >= '0' && payload[i] <= '9'; i++, digits++) {
+        value = value * 10 + (payload[i] - '0');
+    }
+    if (digits == 0 || digits > 19) return false;
+    for (; i < length; i++) {
+        if (payload[i] != ' ') return false;
+    }
+    sentUs = value;
+    return true;
+}
+
+uint64_t KVN_Probe::nowUs() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (uint64_t)tv.tv_sec * 1000000ULL + tv.tv_usec;
+}
+
+// ==================== COLLECTOR ====================
+
+KVN_ProbeCollector::KVN_ProbeCollector() {
+    memset(_sources, 0, sizeof(_sources));
+    _sourceCount = 0;
+    reset();
+}
+
+void KVN_ProbeCollector::reset() {
+    memset(_buckets, 0, sizeof(_buckets));
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.minUs = UINT32_MAX;
+}
+
+KVNProbeSource* KVN_ProbeCollector::source(const char* name, uint8_t length) {
+    // FNV-1a (32-bit); a handful of sources, so a linear scan
+    uint32_t h = 2166136261u;
+    for (uint8_t i = 0; i < length; i++) {
+        h ^= (uint8_t)name[i];
+        h *= 16777619u;
+    }
+    if (h == 0) h = 1;
+
+    for (uint8_t i = 0; i < _sourceCount; i++) {
+        if (_sources[i].hash == h) return &_sources[i];
+    }
+    if (_sourceCount >= KVN_PROBE_MAX_SOURCES) return nullptr;
+
+    KVNProbeSource& s = _sources[_sourceCount++];
+    s.hash = h;
+    s.expected = 0;
+    s.seen = 0;
+    s.newestUs = 0;
+    return &s;
+}
+
+void KVN_ProbeCollector::track(KVNProbeSource& s, uint32_t seq, uint64_t sentUs) {
+    if (s.seen == 0 && s.expected == 0) {
+        // First probe from this source: nothing before it is missing
+        s.expected = seq + 1;
+        s.seen = UINT32_MAX;
+        s.newestUs = sentUs;
+        return;
+    }
+
+    if (seq >= s.expected) {
+        // In order, or ahead: everything skipped is lost until it shows up
+        uint32_t gap = seq - s.expected;
+        _stats.lost += gap;
+        s.seen = gap + 1 >= SEEN_WINDOW ? 1 : (s.seen << (gap + 1)) | 1;
+        s.expected = seq + 1;
+        s.newestUs = sentUs;
+        return;
+    }
+
+    if (sentUs > s.newestUs) {
+        // Behind, but sent after the newest probe: a new sequence from a
+        // rebooted sender. Whatever it sent before this is lost until it
+        // shows up.
+        _stats.restarts++;
+        _stats.lost += seq;
+        s.expected = seq + 1;
+        s.seen = 1;
+        s.newestUs = sentUs;
+        return;
+    }
+
+    uint32_t back = s.expected - 1 - seq;
+    if (back < SEEN_WINDOW) {
+        if (s.seen & (1UL << back)) {
+            _stats.duplicates++;
+            return;
+        }
+        s.seen |= 1UL << back;
+    }
+
+    // Filled a gap counted as lost (possibly in an earlier window)
+    _stats.late++;
+    if (_stats.lost) _stats.lost--;
+}
+
+bool KVN_ProbeCollector::record(const char* name, uint8_t nameLength, const uint8_t* payload,
+                                 unsigned int length, uint64_t nowUs) {
+    uint32_t seq;
+    uint64_t sentUs;
+    if (!KVN_Probe::parse(payload, length, seq, sentUs)) {
+        _stats.malformed++;
+        return false;
+    }
+
+    KVNProbeSource* s = source(name, nameLength);
+    if (s == nullptr) return false;
+
+    uint32_t duplicates = _stats.duplicates;
+    track(*s, seq, sentUs);
+    if (_stats.duplicates != duplicates) return true;
+
+    uint32_t us;
+    if (nowUs < sentUs) {
+        _stats.skewed++;
+        us = 0;
+    } else {
+        uint64_t delta = nowUs - sentUs;
+        us = delta > UINT32_MAX ? UINT32_MAX : (uint32_t)delta;
+    }
+
+    _stats.received++;
+    _stats.sumUs += us;
+    if (us < _stats.minUs) _stats.minUs = us;
+    if (us > _stats.maxUs) _stats.maxUs = us;
+    _buckets[bucketOf(us)]++;
+    return true;
+}
+
+// 0-7 exact, then 8 linear buckets per power of two
+uint8_t KVN_ProbeCollector::bucketOf(uint32_t us) {
+    if (us < 8) return us;
+    uint8_t msb = 31 - __builtin_clz(us);
+    uint8_t sub = (us >> (msb - 3)) & 7;
+    return (msb - 2) * 8 + sub;
+}
+
+uint32_t KVN_ProbeCollector::bucketTop(uint8_t bucket) {
+    if (bucket < 8) return bucket;
+    uint8_t msb = bucket / 8 + 2;
+    uint8_t sub = bucket % 8;
+    uint32_t width = 1UL << (msb - 3);
+    return (8 + sub) * width + (width - 1);
+}
+
+uint32_t KVN_ProbeCollector::percentile(uint8_t pct) const {
+    if (_stats.received == 0) return 0;
+    if (pct > 100) pct = 100;
+
+    // Rank of the sample at `pct`, rounded up (p100 = the largest)
+    uint32_t rank = (uint32_t)(((uint64_t)_stats.received * pct + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint32_t count = 0;
+    for (uint16_t b = 0; b < KVN_PROBE_BUCKETS; b++) {
+        count += _buckets[b];
+        if (count >= rank) {
+            uint32_t top = bucketTop(b);
+            return top < _stats.maxUs ? top : _stats.maxUs;
+        }
+    }
+    return _stats.maxUs;
+}
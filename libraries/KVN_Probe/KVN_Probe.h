@@ -0,0 +1,115 @@
+/*
+ * KVN_Probe.h - Timestamped probe messages and a latency/loss collector
+ *
+ * Any firmware (or the host load generator) publishes probes on
+ * vanguard/probe/<source> with payload "<seq>:<sent_us>", where sent_us
+ * is wall-clock time in microseconds since the epoch. A collector on the
+ * receiving side (the C6 relay) subtracts that from its own clock on
+ * arrival, so both ends need the same time base: NTP on hardware (a few
+ * ms of skew), the shared simulated clock in the host build.
+ *
+ * Per source the collector tracks the next expected sequence number and
+ * a 32-message window below it, which separates loss from late (out of
+ * order) arrivals and duplicates. A lower sequence number stamped later
+ * than the newest probe can only come from a restarted sender, however
+ * far its sequence had got. Latencies go into a log-linear
+ * histogram with 8 buckets per power of two, so percentiles are exact to
+ * within 12.5% in 960 bytes. Nothing here allocates.
+ *
+ * Author: KVN System
+ * Version: 1.0.0
+ */
+
+#ifndef KVN_PROBE_H
+#define KVN_PROBE_H
+
+#include <Arduino.h>
+
+#define KVN_PROBE_TOPIC_PREFIX   "vanguard/probe/"
+#define KVN_PROBE_TOPIC_MAX_LEN  48
+#define KVN_PROBE_MAX_SOURCES    16
+#define KVN_PROBE_BUCKETS        240   // 8 exact + 29 octaves x 8 (up to 2^32 us)
+
+// Sends probes from one source: probe.next(payload, sizeof(payload)),
+// then publish payload on probe.topic()
+class KVN_Probe {
+public:
+    // `source` is copied into the topic; it must not contain '/'
+    explicit KVN_Probe(const char* source);
+
+    const char* topic() const { return _topic; }
+    uint32_t seq() const { return _seq; }
+
+    // Next probe, stamped now. Spaces pad it to `padTo` bytes, to probe
+    // with realistic payload sizes. Returns the length, or 0 if it did
+    // not fit in `size` (including the NUL).
+    size_t next(char* payload, size_t size, size_t padTo = 0);
+
+    static size_t format(char* payload, size_t size, uint32_t seq, uint64_t sentUs, size_t padTo = 0);
+    static bool parse(const uint8_t* payload, unsigned int length, uint32_t& seq, uint64_t& sentUs);
+
+    // Wall-clock microseconds since the epoch (gettimeofday)
+    static uint64_t nowUs();
+
+private:
+    char _topic[KVN_PROBE_TOPIC_MAX_LEN];
+    uint32_t _seq;
+};
+
+// Totals for the current window (since the last reset())
+struct KVNProbeStats {
+    uint32_t received;
+    uint32_t lost;         // Gaps in the sequence not (yet) filled
+    uint32_t late;         // Arrived after a higher sequence number
+    uint32_t duplicates;
+    uint32_t restarts;     // Sequence went back but sent_us forward: the sender rebooted
+    uint32_t skewed;       // Arrived "before" it was sent (clock skew), counted as 0 us
+    uint32_t malformed;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t sumUs;
+
+    uint32_t meanUs() const { return received ? (uint32_t)(sumUs / received) : 0; }
+};
+
+struct KVNProbeSource {
+    uint32_t hash;         // FNV-1a of the source name, 0 = free slot
+    uint32_t expected;     // Next sequence number
+    uint32_t seen;         // Bit i: expected - 1 - i has arrived
+    uint64_t newestUs;     // sent_us of expected - 1
+};
+
+class KVN_ProbeCollector {
+public:
+    KVN_ProbeCollector();
+
+    // One probe from `source` (e.g. the '+' capture of vanguard/probe/+),
+    // received at `nowUs` on the same clock as KVN_Probe::nowUs().
+    // Returns false if the payload is not a probe or the source table is full.
+    bool record(const char* source, uint8_t sourceLength, const uint8_t* payload, unsigned int length,
+                uint64_t nowUs);
+
+    // Latency at percentile `pct` (0-100): upper edge of its bucket,
+    // capped at the largest latency seen
+    uint32_t percentile(uint8_t pct) const;
+
+    const KVNProbeStats& stats() const { return _stats; }
+    uint8_t sourceCount() const { return _sourceCount; }
+
+    // Start a new window. Sequence tracking carries over, so a gap that
+    // spans the reset is still counted once.
+    void reset();
+
+private:
+    KVNProbeSource _sources[KVN_PROBE_MAX_SOURCES];
+    uint8_t _sourceCount;
+    uint32_t _buckets[KVN_PROBE_BUCKETS];
+    KVNProbeStats _stats;
+
+    KVNProbeSource* source(const char* name, uint8_t length);
+    void track(KVNProbeSource& source, uint32_t seq, uint64_t sentUs);
+    static uint8_t bucketOf(uint32_t us);
+    static uint32_t bucketTop(uint8_t bucket);
+};
+
+#endif // KVN_PROBE_H
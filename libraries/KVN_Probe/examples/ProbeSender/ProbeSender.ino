@@ -0,0 +1,53 @@
+/*
+ * KVN_Probe Sender Example
+ *
+ * Publishes one probe a second on vanguard/probe/<DEVICE_ID>. A relay
+ * built with PROBE_REPORT_INTERVAL reports latency and loss for every
+ * source on vanguard/relay/probe. Both boards sync their clocks over NTP
+ * first; latency is only as accurate as that sync (a few ms on a LAN).
+ *
+ * Edit the credentials below before uploading.
+ */
+
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include <KVN_Connection.h>
+#include <KVN_Probe.h>
+
+#define WIFI_SSID     "your-wifi-ssid"
+#define WIFI_PASSWORD "your-wifi-password"
+#define MQTT_BROKER   "192.168.86.38"
+#define MQTT_PORT     1883
+#define DEVICE_ID     "esp32_probe_demo"
+#define NTP_SERVER    "pool.ntp.org"
+
+#define PROBE_INTERVAL_MS 1000
+#define PROBE_PAD         32   // Pad probes to the size of a typical reading
+
+WiFiClient espClient;
+PubSubClient mqtt(espClient);
+KVN_Connection conn(mqtt);
+KVN_Probe probe(DEVICE_ID);
+
+void setup() {
+    Serial.begin(115200);
+    delay(500);
+
+    mqtt.setServer(MQTT_BROKER, MQTT_PORT);
+    conn.begin(WIFI_SSID, WIFI_PASSWORD, DEVICE_ID);
+    configTime(0, 0, NTP_SERVER);
+}
+
+void loop() {
+    conn.tick();
+
+    // Wait for NTP: before the first sync the clock reads 1970
+    static unsigned long lastProbe = 0;
+    if (conn.connected() && time(nullptr) > 1700000000 && millis() - lastProbe >= PROBE_INTERVAL_MS) {
+        char payload[48];
+        if (probe.next(payload, sizeof(payload), PROBE_PAD) && mqtt.publish(probe.topic(), payload)) {
+            Serial.printf("%s = %s\n", probe.topic(), payload);
+        }
+        lastProbe = millis();
+    }
+}
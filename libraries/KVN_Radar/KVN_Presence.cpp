@@ -0,0 +1,121 @@
+/*
+ * KVN_Presence.cpp - Implementation
+ */
+
+#include "KVN_Presence.h"
+#include <string.h>
+
+KVN_Presence::KVN_Presence() {
+    memset(_zones, 0, sizeof(_zones));
+    memset(_sources, 0, sizeof(_sources));
+    _zoneCount = 0;
+    _sourceCount = 0;
+
+    _enterMs = PRESENCE_ENTER_MS;
+    _gapMs = PRESENCE_GAP_MS;
+    _holdMs = PRESENCE_HOLD_MS;
+}
+
+int KVN_Presence::addZone(const char* name) {
+    if (_zoneCount >= PRESENCE_MAX_ZONES) return -1;
+
+    _zones[_zoneCount].name = name;
+    return _zoneCount++;
+}
+
+bool KVN_Presence::addSource(uint8_t radar, uint8_t zone, uint16_t minCm, uint16_t maxCm) {
+    if (_sourceCount >= PRESENCE_MAX_SOURCES || zone >= _zoneCount || radar >= 8) return false;
+
+    PresenceSource& s = _sources[_sourceCount++];
+    s.radar = radar;
+    s.zone = zone;
+    s.minCm = minCm;
+    s.maxCm = maxCm;
+    return true;
+}
+
+void KVN_Presence::setTiming(uint32_t enterMs, uint32_t gapMs, uint32_t holdMs) {
+    _enterMs = enterMs;
+    _gapMs = gapMs;
+    _holdMs = holdMs;
+}
+
+// Nearest detection inside [minCm, maxCm]. A detection without a distance
+// only counts for sources that watch the radar's whole range.
+uint16_t KVN_Presence::nearestIn(const KVNRadarFrame& frame, uint16_t minCm, uint16_t maxCm, bool& hit) {
+    hit = false;
+    if (!frame.presence) return 0;
+
+    if (frame.type != KVN_RADAR_TARGETS) {
+        if (frame.distance == 0) {
+            hit = minCm == 0 && maxCm == 0xFFFF;
+        } else {
+            hit = frame.distance >= minCm && frame.distance <= maxCm;
+        }
+        return frame.distance;
+    }
+
+    uint16_t nearest = 0;
+    for (uint8_t i = 0; i < frame.targetCount; i++) {
+        uint16_t d = frame.targets[i].distance;
+        if (d < minCm || d > maxCm) continue;
+        if (!hit || d < nearest) nearest = d;
+        hit = true;
+    }
+    return nearest;
+}
+
+void KVN_Presence::update(uint8_t radar, const KVNRadarFrame& frame, unsigned long now) {
+    for (uint8_t i = 0; i < _sourceCount; i++) {
+        const PresenceSource& s = _sources[i];
+        if (s.radar != radar) continue;
+
+        bool hit;
+        uint16_t distance = nearestIn(frame, s.minCm, s.maxCm, hit);
+        if (!hit) continue;
+
+        PresenceZone& z = _zones[s.zone];
+        if (!z.streak || now - z.lastHit > _gapMs) {
+            z.streak = true;
+            z.streakStart = now;
+            if (!z.occupied) z.radars = 0;
+        }
+        z.lastHit = now;
+        z.distance = distance;
+        z.radars |= 1 << radar;
+    }
+}
+
+uint32_t KVN_Presence::evaluate(unsigned long now) {
+    uint32_t changed = 0;
+
+    for (uint8_t i = 0; i < _zoneCount; i++) {
+        PresenceZone& z = _zones[i];
+
+        if (z.streak && now - z.lastHit > _gapMs) {
+            z.streak = false;
+        }
+
+        if (!z.occupied) {
+            if (z.streak && z.lastHit - z.streakStart >= _enterMs) {
+                z.occupied = true;
+                changed |= 1UL << i;
+            }
+        } else if (now - z.lastHit >= _holdMs) {
+            z.occupied = false;
+            z.distance = 0;
+            z.radars = 0;
+            changed |= 1UL << i;
+        }
+    }
+
+    return changed;
+}
+
+uint32_t KVN_Presence::occupiedMask() const {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < _zoneCount; i++) {
+        if (_zones[i].occupied) mask |= 1UL << i;
+    }
+    return mask;
+}
@@ -0,0 +1,92 @@
+/*
+ * KVN_Presence.h - Multi-radar zone occupancy with debounce
+ *
+ * Zones are named areas; sources map a radar (the parser id) onto a zone,
+ * optionally limited to a distance window so one wide radar can cover
+ * several zones. A zone sees a hit when any of its sources reports a
+ * target inside its window (OR fusion across radars).
+ *
+ * Debounce:
+ *   - enter: hits for PRESENCE_ENTER_MS without a gap longer than
+ *     PRESENCE_GAP_MS (one noisy frame is not enough)
+ *   - leave: no hit from any source for PRESENCE_HOLD_MS (people sitting
+ *     still drop out of radar returns for a few seconds)
+ *
+ *   KVN_Presence presence;
+ *   int bed = presence.addZone("bed");
+ *   presence.addSource(0, bed);                 // Radar 0, any distance
+ *   presence.addSource(2, bed, 0, 150);         // Radar 2, first 1.5 m
+ *
+ *   presence.update(radar, frame, millis());    // From the parser callback
+ *   uint32_t changed = presence.evaluate(millis());
+ *
+ * Author: KVN System
+ * Version: 1.0.0
+ */
+
+#ifndef KVN_PRESENCE_H
+#define KVN_PRESENCE_H
+
+#include <Arduino.h>
+#include "KVN_RadarParser.h"
+
+#define PRESENCE_MAX_ZONES    8
+#define PRESENCE_MAX_SOURCES  16
+#define PRESENCE_ENTER_MS     300
+#define PRESENCE_GAP_MS       1000
+#define PRESENCE_HOLD_MS      5000
+
+struct PresenceZone {
+    const char* name;        // Borrowed
+    bool occupied;
+    bool streak;             // Hits are currently arriving
+    unsigned long streakStart;
+    unsigned long lastHit;
+    uint16_t distance;       // cm, nearest hit (0 = unknown)
+    uint8_t radars;          // Bitmask of radars that hit since the last change
+};
+
+struct PresenceSource {
+    uint8_t radar;
+    uint8_t zone;
+    uint16_t minCm;
+    uint16_t maxCm;
+};
+
+class KVN_Presence {
+public:
+    KVN_Presence();
+
+    // Returns the zone index, or -1 when full. `name` must outlive the engine.
+    int addZone(const char* name);
+
+    // Map radar -> zone for targets between minCm and maxCm
+    bool addSource(uint8_t radar, uint8_t zone, uint16_t minCm = 0, uint16_t maxCm = 0xFFFF);
+
+    void setTiming(uint32_t enterMs, uint32_t gapMs, uint32_t holdMs);
+
+    // Feed one decoded frame
+    void update(uint8_t radar, const KVNRadarFrame& frame, unsigned long now);
+
+    // Apply debounce. Returns a bitmask of zones whose state changed.
+    uint32_t evaluate(unsigned long now);
+
+    uint8_t zoneCount() const { return _zoneCount; }
+    const PresenceZone& zone(uint8_t index) const { return _zones[index]; }
+    bool occupied(uint8_t index) const { return _zones[index].occupied; }
+    uint32_t occupiedMask() const;
+
+private:
+    PresenceZone _zones[PRESENCE_MAX_ZONES];
+    PresenceSource _sources[PRESENCE_MAX_SOURCES];
+    uint8_t _zoneCount;
+    uint8_t _sourceCount;
+
+    uint32_t _enterMs;
+    uint32_t _gapMs;
+    uint32_t _holdMs;
+
+    static uint16_t nearestIn(const KVNRadarFrame& frame, uint16_t minCm, uint16_t maxCm, bool& hit);
+};
+
+#endif // KVN_PRESENCE_H
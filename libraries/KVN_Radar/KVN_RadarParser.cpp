@@ -0,0 +1,353 @@
+/*
+ * KVN_RadarParser.cpp - Implementation
+ */
+
+#include "KVN_RadarParser.h"
+#include <string.h>
+
+#define TARGET_PAYLOAD (KVN_RADAR_MAX_TARGETS * 8)
+
+// Indexed by FrameKind (text lines have no binary header/footer)
+static const uint8_t HEADERS[3][4] = {
+    {0xF4, 0xF3, 0xF2, 0xF1},  // Report
+    {0xFD, 0xFC, 0xFB, 0xFA},  // Command ACK
+    {0xAA, 0xFF, 0x03, 0x00}   // Targets
+};
+
+static const uint8_t FOOTERS[3][4] = {
+    {0xF8, 0xF7, 0xF6, 0xF5},
+    {0x04, 0x03, 0x02, 0x01},
+    {0x55, 0xCC}
+};
+
+static const uint8_t FOOTER_LEN[3] = {4, 4, 2};
+
+KVN_RadarParser::KVN_RadarParser(uint8_t id) {
+    _id = id;
+    _cb = nullptr;
+    _frames = 0;
+    _badFrames = 0;
+    _dropped = 0;
+    _replayLen = 0;
+    _replayPos = 0;
+    memset(&_frame, 0, sizeof(_frame));
+    reset();
+}
+
+void KVN_RadarParser::reset() {
+    _state = SYNC_HEADER;
+    _kind = KIND_REPORT;
+    _pos = 0;
+    _len = 0;
+    _have = 0;
+}
+
+// First byte of a frame? Returns true if `b` started one.
+bool KVN_RadarParser::startHeader(uint8_t b) {
+    _pos = 0;
+    _state = SYNC_HEADER;
+
+    for (uint8_t k = KIND_REPORT; k <= KIND_TARGETS; k++) {
+        if (b == HEADERS[k][0]) {
+            _kind = (FrameKind)k;
+            _pos = 1;
+            return true;
+        }
+    }
+
+    if (b == 'O' || b == 'R') {
+        _kind = KIND_TEXT;
+        _buf[0] = b;
+        _have = 1;
+        _state = READ_TEXT;
+        return true;
+    }
+
+    _dropped++;
+    return false;
+}
+
+// Abandon the current frame and try `b` as the start of the next one
+void KVN_RadarParser::resync(uint8_t b, bool bad) {
+    if (bad) {
+        _badFrames++;
+    } else {
+        _dropped += _pos;
+    }
+    startHeader(b);
+}
+
+// A frame cut short (radar reset, UART overrun) swallows the start of the
+// next one as payload. Replay the payload and `b` so the next frame's
+// header is found instead of skipped.
+void KVN_RadarParser::replay(uint8_t b) {
+    uint8_t pending[sizeof(_replay)];
+    size_t n = 0;
+
+    for (uint16_t i = 0; i < _have && n < sizeof(pending); i++) pending[n++] = _buf[i];
+    if (n < sizeof(pending)) pending[n++] = b;
+    for (uint16_t i = _replayPos; i < _replayLen && n < sizeof(pending); i++) pending[n++] = _replay[i];
+
+    _dropped += (_have + 1 + (_replayLen - _replayPos)) - n;   // Overflow (never in practice)
+
+    memcpy(_replay, pending, n);
+    _replayLen = n;
+    _replayPos = 0;
+
+    _badFrames++;
+    reset();
+}
+
+bool KVN_RadarParser::drain() {
+    while (_replayPos < _replayLen) {
+        if (step(_replay[_replayPos++])) return true;
+    }
+    _replayLen = 0;
+    _replayPos = 0;
+    return false;
+}
+
+bool KVN_RadarParser::push(uint8_t b) {
+    if (_replayPos == _replayLen) return step(b);
+
+    // Replayed bytes come before `b`
+    if (_replayLen < sizeof(_replay)) {
+        _replay[_replayLen++] = b;
+    } else {
+        _dropped++;
+    }
+    return drain();
+}
+
+bool KVN_RadarParser::step(uint8_t b) {
+    switch (_state) {
+        case SYNC_HEADER:
+            if (_pos == 0) {
+                startHeader(b);
+            } else if (b == HEADERS[_kind][_pos]) {
+                if (++_pos == 4) {
+                    _pos = 0;
+                    _len = 0;
+                    _have = 0;
+                    if (_kind == KIND_TARGETS) {
+                        _len = TARGET_PAYLOAD;   // Fixed size, no length field
+                        _state = READ_PAYLOAD;
+                    } else {
+                        _state = READ_LENGTH;
+                    }
+                }
+            } else {
+                resync(b, false);
+            }
+            return false;
+
+        case READ_LENGTH:
+            _len |= (uint16_t)b << (8 * _pos);   // Little-endian
+            if (++_pos == 2) {
+                _pos = 0;
+                if (_len == 0 || _len > KVN_RADAR_MAX_PAYLOAD) {
+                    _badFrames++;
+                    reset();
+                } else {
+                    _state = READ_PAYLOAD;
+                }
+            }
+            return false;
+
+        case READ_PAYLOAD:
+            _buf[_have++] = b;
+            if (_have == _len) {
+                _state = READ_FOOTER;
+                _pos = 0;
+            }
+            return false;
+
+        case READ_FOOTER: {
+            if (b != FOOTERS[_kind][_pos]) {
+                replay(b);
+                return false;
+            }
+            if (++_pos < FOOTER_LEN[_kind]) return false;
+
+            bool ok = complete();
+            reset();
+            return ok;
+        }
+
+        case READ_TEXT:
+            if (b == '\n') {
+                _state = SYNC_HEADER;
+                _pos = 0;
+                if (decodeText()) {
+                    _frames++;
+                    return true;
+                }
+                _badFrames++;
+                return false;
+            }
+            if (b == '\r') return false;
+
+            if (b < 0x20 || b > 0x7E) {
+                // Not text after all - binary noise that began with 'O'/'R'
+                _dropped += _have;
+                startHeader(b);
+            } else if (_have >= KVN_RADAR_MAX_TEXT) {
+                _badFrames++;
+                startHeader(b);
+            } else {
+                _buf[_have++] = b;
+            }
+            return false;
+    }
+
+    return false;
+}
+
+bool KVN_RadarParser::complete() {
+    switch (_kind) {
+        case KIND_REPORT:
+            if (_len < 3) {
+                _badFrames++;
+                return false;
+            }
+            decodeReport();
+            break;
+
+        case KIND_TARGETS:
+            decodeTargets();
+            break;
+
+        default:
+            return false;   // ACKs carry nothing we report
+    }
+
+    _frames++;
+    return true;
+}
+
+uint32_t KVN_RadarParser::feed(const uint8_t* data, size_t len) {
+    uint32_t count = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        if (push(data[i])) {
+            count++;
+            if (_cb) _cb(_id, _frame);
+        }
+    }
+
+    // Frames still waiting in replayed bytes
+    while (_replayPos < _replayLen) {
+        if (drain()) {
+            count++;
+            if (_cb) _cb(_id, _frame);
+        }
+    }
+    return count;
+}
+
+uint32_t KVN_RadarParser::poll(Stream& in) {
+    uint8_t chunk[KVN_RADAR_READ_CHUNK];
+    uint32_t count = 0;
+    int avail;
+
+    // The UART driver's ring buffer is the only queue; copy out what it
+    // already holds, so readBytes() never waits
+    while ((avail = in.available()) > 0) {
+        size_t take = (size_t)avail < sizeof(chunk) ? (size_t)avail : sizeof(chunk);
+        take = in.readBytes(chunk, take);
+        if (take == 0) break;
+        count += feed(chunk, take);
+    }
+    return count;
+}
+
+// ==================== DECODERS ====================
+
+void KVN_RadarParser::decodeReport() {
+    memset(&_frame, 0, sizeof(_frame));
+    _frame.type = KVN_RADAR_REPORT;
+    _frame.state = _buf[0];
+    _frame.presence = _buf[0] != 0;
+    _frame.distance = _buf[1] | (_buf[2] << 8);
+
+    uint16_t gates = (_len - 3) / 2;
+    if (gates > KVN_RADAR_GATES) gates = KVN_RADAR_GATES;
+    for (uint8_t g = 0; g < gates; g++) {
+        _frame.gates[g] = _buf[3 + g * 2] | (_buf[4 + g * 2] << 8);
+    }
+    _frame.gateCount = gates;
+}
+
+void KVN_RadarParser::decodeTargets() {
+    memset(&_frame, 0, sizeof(_frame));
+    _frame.type = KVN_RADAR_TARGETS;
+
+    for (uint8_t i = 0; i < KVN_RADAR_MAX_TARGETS; i++) {
+        const uint8_t* p = &_buf[i * 8];
+        uint16_t rawX = p[0] | (p[1] << 8);
+        uint16_t rawY = p[2] | (p[3] << 8);
+        uint16_t rawSpeed = p[4] | (p[5] << 8);
+
+        if (rawX == 0 && rawY == 0) continue;   // Empty slot
+
+        KVNRadarTarget& t = _frame.targets[_frame.targetCount++];
+        t.x = signedMagnitude(rawX);
+        t.y = signedMagnitude(rawY);
+        t.speed = signedMagnitude(rawSpeed);
+        t.distance = isqrt((int32_t)t.x * t.x + (int32_t)t.y * t.y) / 10;
+
+        if (_frame.distance == 0 || t.distance < _frame.distance) {
+            _frame.distance = t.distance;
+        }
+    }
+
+    _frame.presence = _frame.targetCount > 0;
+    _frame.state = _frame.presence ? 1 : 0;
+}
+
+bool KVN_RadarParser::decodeText() {
+    memset(&_frame, 0, sizeof(_frame));
+    _frame.type = KVN_RADAR_TEXT;
+
+    if (_have == 2 && memcmp(_buf, "ON", 2) == 0) {
+        _frame.presence = true;
+        return true;
+    }
+    if (_have == 3 && memcmp(_buf, "OFF", 3) == 0) {
+        return true;
+    }
+    if (_have > 6 && memcmp(_buf, "Range ", 6) == 0) {
+        uint32_t cm = 0;
+        for (uint16_t i = 6; i < _have; i++) {
+            if (_buf[i] < '0' || _buf[i] > '9') return false;
+            cm = cm * 10 + (_buf[i] - '0');
+        }
+        _frame.presence = true;
+        _frame.distance = cm > 0xFFFF ? 0xFFFF : cm;
+        return true;
+    }
+    return false;
+}
+
+// Rd-03D coordinates: bit 15 set = positive, clear = negative
+int16_t KVN_RadarParser::signedMagnitude(uint16_t raw) {
+    int16_t value = raw & 0x7FFF;
+    return (raw & 0x8000) ? value : -value;
+}
+
+uint16_t KVN_RadarParser::isqrt(uint32_t v) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
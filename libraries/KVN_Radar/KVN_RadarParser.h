@@ -0,0 +1,143 @@
+/*
+ * KVN_RadarParser.h - Streaming frame decoder for LD2420 / Rd-03 radars
+ *
+ * Byte-driven state machine: feed it whatever the UART has, in any
+ * chunking, and it emits one fixed-size KVNRadarFrame per complete frame.
+ * A frame split across reads resumes where it stopped. Garbage, truncated
+ * frames and bad footers are dropped and the parser resyncs on the next
+ * header, including one that began inside a truncated frame's payload.
+ * No heap, no String; the partial frame lives in a 64 byte buffer.
+ *
+ * Understood formats:
+ *   - Report frames  F4 F3 F2 F1 | len16 | state, dist16, [16 x gate16] | F8 F7 F6 F5
+ *     (LD2420 energy mode, Rd-03 / S3KM1110)
+ *   - Target frames  AA FF 03 00 | 3 x (x16, y16, speed16, res16) | 55 CC
+ *     (Rd-03D multi-target tracking)
+ *   - Text lines     "ON" / "OFF" / "Range <cm>"
+ *     (LD2420 default output mode)
+ * Command ACK frames (FD FC FB FA ... 04 03 02 01) are consumed silently.
+ *
+ *   KVN_RadarParser bed(0);
+ *   bed.onFrame(onRadarFrame);
+ *   ...
+ *   bed.poll(Serial1);   // from loop()
+ *
+ * Author: KVN System
+ * Version: 1.0.0
+ */
+
+#ifndef KVN_RADAR_PARSER_H
+#define KVN_RADAR_PARSER_H
+
+#include <Arduino.h>
+
+#define KVN_RADAR_GATES        16
+#define KVN_RADAR_MAX_TARGETS  3
+#define KVN_RADAR_MAX_PAYLOAD  64   // Longest payload accepted (report frames are 35)
+#define KVN_RADAR_MAX_TEXT     20   // Longest text line accepted
+#define KVN_RADAR_READ_CHUNK   64   // Bytes copied from the UART per read
+
+enum KVNRadarFrameType {
+    KVN_RADAR_REPORT,    // Presence + distance (+ gate energies)
+    KVN_RADAR_TARGETS,   // Up to 3 tracked targets
+    KVN_RADAR_TEXT       // ON / OFF / Range line
+};
+
+struct KVNRadarTarget {
+    int16_t x;           // mm, + = right of the radar
+    int16_t y;           // mm, distance ahead
+    int16_t speed;       // cm/s, + = moving away
+    uint16_t distance;   // cm, from x/y
+};
+
+struct KVNRadarFrame {
+    KVNRadarFrameType type;
+    bool presence;
+    uint8_t state;       // Report frames: 0 none, 1 moving, 2 still (radar dependent)
+    uint16_t distance;   // cm, nearest target (0 = unknown)
+
+    uint8_t gateCount;   // Report frames in energy mode
+    uint16_t gates[KVN_RADAR_GATES];
+
+    uint8_t targetCount; // Target frames
+    KVNRadarTarget targets[KVN_RADAR_MAX_TARGETS];
+};
+
+class KVN_RadarParser {
+public:
+    typedef void (*FrameCallback)(uint8_t radar, const KVNRadarFrame& frame);
+
+    // `id` is passed to the callback to tell radars apart
+    explicit KVN_RadarParser(uint8_t id = 0);
+
+    // Feed one byte. Returns true when frame() holds a new frame.
+    bool push(uint8_t b);
+
+    // Feed a buffer; calls the callback per frame. Returns frames decoded.
+    uint32_t feed(const uint8_t* data, size_t len);
+
+    // Drain everything the UART has buffered (never waits). Returns frames.
+    uint32_t poll(Stream& in);
+
+    void onFrame(FrameCallback cb) { _cb = cb; }
+    void reset();
+
+    const KVNRadarFrame& frame() const { return _frame; }
+    uint8_t id() const { return _id; }
+
+    // Statistics
+    uint32_t frames() const { return _frames; }
+    uint32_t badFrames() const { return _badFrames; }     // Bad length/footer/text
+    uint32_t droppedBytes() const { return _dropped; }    // Skipped while resyncing
+
+private:
+    enum ParseState {
+        SYNC_HEADER,
+        READ_LENGTH,
+        READ_PAYLOAD,
+        READ_FOOTER,
+        READ_TEXT
+    };
+
+    enum FrameKind {
+        KIND_REPORT,
+        KIND_ACK,
+        KIND_TARGETS,
+        KIND_TEXT
+    };
+
+    uint8_t _id;
+    FrameCallback _cb;
+
+    ParseState _state;
+    FrameKind _kind;
+    uint8_t _pos;        // Bytes matched in the current header/length/footer
+    uint16_t _len;       // Expected payload length
+    uint16_t _have;      // Payload bytes buffered
+    uint8_t _buf[KVN_RADAR_MAX_PAYLOAD];
+
+    uint8_t _replay[KVN_RADAR_MAX_PAYLOAD + 8];   // Bytes to re-parse after a bad footer
+    uint8_t _replayLen;
+    uint8_t _replayPos;
+
+    KVNRadarFrame _frame;
+
+    uint32_t _frames;
+    uint32_t _badFrames;
+    uint32_t _dropped;
+
+    bool step(uint8_t b);
+    bool startHeader(uint8_t b);
+    void resync(uint8_t b, bool bad);
+    void replay(uint8_t b);
+    bool drain();
+    bool complete();
+    void decodeReport();
+    void decodeTargets();
+    bool decodeText();
+
+    static int16_t signedMagnitude(uint16_t raw);
+    static uint16_t isqrt(uint32_t v);
+};
+
+#endif // KVN_RADAR_PARSER_H
@@ -0,0 +1,189 @@
+/*
+ * KVN_Radar Replay Benchmark
+ *
+ * Replays captured radar UART streams through KVN_RadarParser, fed in
+ * random chunk sizes (1-64 bytes) like a real UART read loop would see
+ * them. The capture mixes every frame format with the failure cases:
+ *   - leading garbage and a half header
+ *   - a frame with a corrupt footer
+ *   - a frame cut off mid-payload, followed by a good frame
+ *   - an unknown text line
+ * Each pass must decode exactly EXPECTED_FRAMES frames, each matching
+ * EXPECTED field by field, and flag EXPECTED_BAD bad ones. Then it
+ * measures frames per second and checks that the presence debounce sets
+ * and then clears the room.
+ *
+ * No radar needed - open the Serial Monitor at 115200.
+ */
+
+#include <KVN_RadarParser.h>
+#include <KVN_Presence.h>
+
+#define PASSES          2000
+#define EXPECTED_FRAMES 6
+#define EXPECTED_BAD    3
+
+// LD2420 energy-mode report: present (1), 123 cm, 16 gate energies
+#define REPORT_FRAME(state, cmLo, cmHi) \
+    0xF4, 0xF3, 0xF2, 0xF1, 0x23, 0x00, state, cmLo, cmHi, \
+    0x10, 0x27, 0x88, 0x13, 0xE8, 0x03, 0xF4, 0x01, 0xC8, 0x00, 0x64, 0x00, 0x32, 0x00, 0x19, 0x00, \
+    0x0A, 0x00, 0x05, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+    0xF8, 0xF7, 0xF6, 0xF5
+
+static const uint8_t CAPTURE[] = {
+    // Garbage and a half header from connecting mid-stream
+    0x13, 0x37, 0x00, 0xF4, 0xF3,
+    // Good report, 123 cm
+    REPORT_FRAME(0x01, 0x7B, 0x00),
+    // Command ACK - consumed, not reported
+    0xFD, 0xFC, 0xFB, 0xFA, 0x04, 0x00, 0xFF, 0x01, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01,
+    // Rd-03D: one target at x=+300 mm, y=+400 mm, 10 cm/s (500 mm away)
+    0xAA, 0xFF, 0x03, 0x00,
+    0x2C, 0x81, 0x90, 0x81, 0x0A, 0x80, 0x68, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x55, 0xCC,
+    // Report with a corrupt footer (bad #1)
+    0xF4, 0xF3, 0xF2, 0xF1, 0x03, 0x00, 0x01, 0x32, 0x00, 0xF8, 0xF7, 0x00, 0xF5,
+    // Report cut off after 10 payload bytes (bad #2)...
+    0xF4, 0xF3, 0xF2, 0xF1, 0x23, 0x00, 0x02, 0x3C, 0x00, 0x10, 0x27, 0x88, 0x13, 0xE8, 0x03, 0xF4,
+    // ...then a good one, 77 cm, still target
+    REPORT_FRAME(0x02, 0x4D, 0x00),
+    // LD2420 text mode, plus a line we do not understand (bad #3)
+    'O', 'N', '\r', '\n',
+    'R', 'a', 'n', 'g', 'e', ' ', '5', '7', '\r', '\n',
+    'O', 'F', 'F', '\r', '\n',
+    'R', 'a', 'n', 'g', 'e', 'X', '\r', '\n'
+};
+
+// What the good frames above decode to, in order
+struct ExpectedFrame {
+    KVNRadarFrameType type;
+    bool presence;
+    uint8_t state;       // Reports only
+    uint16_t distance;
+    uint16_t gate0;      // Reports only
+    int16_t x, y, speed; // Targets only
+};
+
+static const ExpectedFrame EXPECTED[EXPECTED_FRAMES] = {
+    {KVN_RADAR_REPORT,  true,  1, 123, 10000, 0,   0,   0},
+    {KVN_RADAR_TARGETS, true,  0, 50,  0,     300, 400, 10},
+    {KVN_RADAR_REPORT,  true,  2, 77,  10000, 0,   0,   0},
+    {KVN_RADAR_TEXT,    true,  0, 0,   0,     0,   0,   0},
+    {KVN_RADAR_TEXT,    true,  0, 57,  0,     0,   0,   0},
+    {KVN_RADAR_TEXT,    false, 0, 0,   0,     0,   0,   0}
+};
+
+bool frameMatches(const KVNRadarFrame& f, const ExpectedFrame& e) {
+    if (f.type != e.type || f.presence != e.presence || f.distance != e.distance) return false;
+    if (f.type == KVN_RADAR_REPORT) {
+        return f.state == e.state && f.gateCount == KVN_RADAR_GATES && f.gates[0] == e.gate0;
+    }
+    if (f.type == KVN_RADAR_TARGETS) {
+        const KVNRadarTarget& t = f.targets[0];
+        return f.targetCount == 1 && t.x == e.x && t.y == e.y && t.speed == e.speed && t.distance == e.distance;
+    }
+    return true;
+}
+
+uint32_t framesSeen = 0;
+uint32_t wrongFields = 0;
+
+void onFrame(uint8_t radar, const KVNRadarFrame& frame) {
+    if (!frameMatches(frame, EXPECTED[framesSeen % EXPECTED_FRAMES])) wrongFields++;
+    framesSeen++;
+}
+
+bool replayOnce(KVN_RadarParser& parser, uint32_t& frames) {
+    uint32_t badBefore = parser.badFrames();
+    size_t pos = 0;
+    frames = 0;
+
+    while (pos < sizeof(CAPTURE)) {
+        size_t chunk = 1 + random(64);
+        if (pos + chunk > sizeof(CAPTURE)) chunk = sizeof(CAPTURE) - pos;
+        frames += parser.feed(CAPTURE + pos, chunk);
+        pos += chunk;
+    }
+
+    return frames == EXPECTED_FRAMES && parser.badFrames() - badBefore == EXPECTED_BAD;
+}
+
+void printFrame(const KVNRadarFrame& f) {
+    static const char* TYPES[] = {"report", "targets", "text"};
+    Serial.printf("  %-7s presence=%d distance=%u cm", TYPES[f.type], f.presence, f.distance);
+    if (f.type == KVN_RADAR_REPORT) Serial.printf(" state=%u gates=%u", f.state, f.gateCount);
+    if (f.type == KVN_RADAR_TARGETS) Serial.printf(" targets=%u x=%d y=%d", f.targetCount, f.targets[0].x, f.targets[0].y);
+    Serial.println();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("\n=== KVN_Radar replay ===");
+
+    // Decode once byte-by-byte and show the frames
+    KVN_RadarParser parser;
+    uint32_t decoded = 0, matched = 0;
+    for (size_t i = 0; i < sizeof(CAPTURE); i++) {
+        if (!parser.push(CAPTURE[i])) continue;
+        printFrame(parser.frame());
+        if (decoded < EXPECTED_FRAMES && frameMatches(parser.frame(), EXPECTED[decoded])) matched++;
+        decoded++;
+    }
+    Serial.printf("frames=%lu bad=%lu dropped=%lu\n",
+                  (unsigned long)parser.frames(), (unsigned long)parser.badFrames(),
+                  (unsigned long)parser.droppedBytes());
+    Serial.printf("%lu of %d frames decoded as expected\n", (unsigned long)matched, EXPECTED_FRAMES);
+    Serial.println(decoded == EXPECTED_FRAMES && matched == EXPECTED_FRAMES ? "PASS" : "FAIL");
+
+    // Random chunking must not change the result
+    KVN_RadarParser chunked;
+    chunked.onFrame(onFrame);
+    uint32_t failures = 0;
+    uint32_t frames;
+
+    unsigned long start = micros();
+    for (int i = 0; i < PASSES; i++) {
+        if (!replayOnce(chunked, frames)) failures++;
+    }
+    unsigned long elapsed = micros() - start;
+
+    Serial.printf("%d passes, %lu failed, %lu frames with wrong fields\n",
+                  PASSES, (unsigned long)failures, (unsigned long)wrongFields);
+    Serial.printf("%lu frames in %lu us: %.0f frames/s, %.2f MB/s\n",
+                  (unsigned long)framesSeen, elapsed,
+                  framesSeen * 1e6f / elapsed,
+                  (float)sizeof(CAPTURE) * PASSES / elapsed);
+    Serial.println(failures == 0 && wrongFields == 0 ? "PASS" : "FAIL");
+
+    // Presence debounce on the same stream: one radar, one zone
+    KVN_Presence presence;
+    int room = presence.addZone("room");
+    presence.addSource(0, room);
+
+    KVN_RadarParser live(0);
+    unsigned long now = 0;
+    bool wasOccupied = false;
+    for (size_t i = 0; i < sizeof(CAPTURE); i++) {
+        if (live.push(CAPTURE[i])) {
+            presence.update(0, live.frame(), now);
+            now += 100;   // 10 Hz frame rate
+            if (presence.evaluate(now)) {
+                Serial.printf("t=%lu ms room %s\n", now, presence.occupied(room) ? "occupied" : "clear");
+            }
+            if (presence.occupied(room)) wasOccupied = true;
+        }
+    }
+    if (presence.evaluate(now + PRESENCE_HOLD_MS)) {
+        Serial.printf("t=%lu ms room clear (hold expired)\n", now + PRESENCE_HOLD_MS);
+    }
+
+    // The stream ends with OFF: occupied while reporting, clear after the hold
+    Serial.println(wasOccupied && !presence.occupied(room) ? "PASS" : "FAIL");
+}
+
+void loop() {
+}
@@ -0,0 +1,201 @@
+/*
+ * KVN_Router.cpp - Implementation
+ */
+
+#include "KVN_Router.h"
+#include <string.h>
+
+#define ROOT 0
+
+bool KVNTopicSpan::equals(const char* s) const {
+    return strncmp(data, s, length) == 0 && s[length] == '\0';
+}
+
+bool KVNTopicSpan::copyTo(char* buf, size_t size) const {
+    if (size <= length) return false;
+    memcpy(buf, data, length);
+    buf[length] = '\0';
+    return true;
+}
+
+KVN_Router::KVN_Router() {
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(_patterns, 0, sizeof(_patterns));
+    memset(_handlers, 0, sizeof(_handlers));
+    _routeCount = 0;
+    _unmatched = 0;
+
+    KVNRouteNode& root = _nodes[ROOT];
+    root.kind = KVN_ROUTE_LITERAL;
+    root.firstChild = -1;
+    root.nextSibling = -1;
+    root.route = -1;
+    _nodeCount = 1;
+}
+
+// Find or add the child of `parent` for one pattern segment, keeping the
+// children ordered literals, '+', '#' so walk() tries the most specific first
+int KVN_Router::child(int parent, KVNRouteSegment kind, const char* segment, uint8_t length) {
+    int insertAfter = -1;
+
+    for (int c = _nodes[parent].firstChild; c >= 0; c = _nodes[c].nextSibling) {
+        const KVNRouteNode& n = _nodes[c];
+        if (n.kind == kind &&
+            (kind != KVN_ROUTE_LITERAL || (n.length == length && memcmp(n.segment, segment, length) == 0))) {
+            return c;
+        }
+        if (n.kind <= kind) insertAfter = c;
+    }
+
+    if (_nodeCount >= KVN_ROUTER_MAX_NODES) return -1;
+
+    int index = _nodeCount++;
+    KVNRouteNode& node = _nodes[index];
+    node.segment = kind == KVN_ROUTE_LITERAL ? segment : nullptr;
+    node.length = length;
+    node.kind = kind;
+    node.firstChild = -1;
+    node.route = -1;
+
+    if (insertAfter < 0) {
+        node.nextSibling = _nodes[parent].firstChild;
+        _nodes[parent].firstChild = index;
+    } else {
+        node.nextSibling = _nodes[insertAfter].nextSibling;
+        _nodes[insertAfter].nextSibling = index;
+    }
+    return index;
+}
+
+int KVN_Router::on(const char* pattern, Handler handler) {
+    if (pattern == nullptr || handler == nullptr || *pattern == '\0') return -1;
+    if (_routeCount >= KVN_ROUTER_MAX_ROUTES) return -1;
+
+    // Validate first so a bad pattern leaves the trie untouched
+    uint8_t wildcards = 0;
+    for (const char* seg = pattern;;) {
+        const char* end = strchr(seg, '/');
+        size_t len = end ? (size_t)(end - seg) : strlen(seg);
+        if (len > 255) return -1;
+
+        bool plus = len == 1 && seg[0] == '+';
+        bool hash = len == 1 && seg[0] == '#';
+        if (!plus && !hash && (memchr(seg, '+', len) || memchr(seg, '#', len))) return -1;
+        if (hash && end != nullptr) return -1;  // '#' must be last
+        if (plus || hash) wildcards++;
+
+        if (end == nullptr) break;
+        seg = end + 1;
+    }
+    if (wildcards > KVN_ROUTER_MAX_CAPTURES) return -1;
+
+    int node = ROOT;
+    for (const char* seg = pattern;;) {
+        const char* end = strchr(seg, '/');
+        uint8_t len = end ? end - seg : strlen(seg);
+
+        KVNRouteSegment kind = KVN_ROUTE_LITERAL;
+        if (len == 1 && seg[0] == '+') kind = KVN_ROUTE_PLUS;
+        else if (len == 1 && seg[0] == '#') kind = KVN_ROUTE_HASH;
+
+        node = child(node, kind, seg, len);
+        if (node < 0) return -1;  // Trie full
+
+        if (end == nullptr) break;
+        seg = end + 1;
+    }
+
+    if (_nodes[node].route >= 0) return -1;  // Duplicate
+
+    int route = _routeCount++;
+    _nodes[node].route = route;
+    _patterns[route] = pattern;
+    _handlers[route] = handler;
+    return route;
+}
+
+// Depth-first, most specific child first. Captures are pushed on the way
+// down and popped when a branch fails.
+bool KVN_Router::walk(int node, const KVNTopicSpan* segments, uint8_t count, uint8_t index,
+                      KVNTopicMatch& match) const {
+    const char* end = segments[count - 1].data + segments[count - 1].length;
+
+    for (int c = _nodes[node].firstChild; c >= 0; c = _nodes[c].nextSibling) {
+        const KVNRouteNode& n = _nodes[c];
+
+        if (n.kind == KVN_ROUTE_HASH) {
+            // Matches the rest of the topic, including nothing ("a/#" matches "a")
+            if (index == 0 && segments[0].data[0] == '$') continue;
+            KVNTopicSpan& cap = match.captures[match.captureCount++];
+            cap.data = index < count ? segments[index].data : end;
+            cap.length = end - cap.data;
+            match.route = n.route;
+            return true;
+        }
+
+        if (index >= count) continue;
+        const KVNTopicSpan& seg = segments[index];
+
+        // A truncated topic's last span holds several segments: only '#' fits
+        if (index == KVN_ROUTER_MAX_SEGMENTS - 1 && memchr(seg.data, '/', seg.length)) continue;
+
+        if (n.kind == KVN_ROUTE_LITERAL) {
+            if (n.length != seg.length || memcmp(n.segment, seg.data, seg.length) != 0) continue;
+        } else {
+            if (index == 0 && seg.length && seg.data[0] == '$') continue;
+            match.captures[match.captureCount++] = seg;
+        }
+
+        if (index + 1 == count && n.route >= 0) {
+            match.route = n.route;
+            return true;
+        }
+        if (walk(c, segments, count, index + 1, match)) return true;
+
+        if (n.kind == KVN_ROUTE_PLUS) match.captureCount--;
+    }
+
+    return false;
+}
+
+bool KVN_Router::match(const char* topic, KVNTopicMatch& m) const {
+    m.topic = topic;
+    m.payload = nullptr;
+    m.length = 0;
+    m.route = 0;
+    m.captureCount = 0;
+
+    size_t len = strlen(topic);
+    if (len == 0 || len > 255) return false;
+
+    // Split once; the last span keeps the remainder of very deep topics
+    KVNTopicSpan segments[KVN_ROUTER_MAX_SEGMENTS];
+    uint8_t count = 0;
+    const char* seg = topic;
+    const char* end = topic + len;
+    while (true) {
+        const char* slash = count < KVN_ROUTER_MAX_SEGMENTS - 1
+            ? (const char*)memchr(seg, '/', end - seg) : nullptr;
+        const char* segEnd = slash ? slash : end;
+        segments[count].data = seg;
+        segments[count].length = segEnd - seg;
+        count++;
+        if (slash == nullptr) break;
+        seg = slash + 1;
+    }
+
+    return walk(ROOT, segments, count, 0, m);
+}
+
+bool KVN_Router::dispatch(const char* topic, const uint8_t* payload, unsigned int length) {
+    KVNTopicMatch m;
+    if (!match(topic, m)) {
+        _unmatched++;
+        return false;
+    }
+
+    m.payload = payload;
+    m.length = length;
+    _handlers[m.route](m);
+    return true;
+}
@@ -0,0 +1,109 @@
+/*
+ * KVN_Router.h - MQTT topic router
+ *
+ * Handlers are registered against MQTT subscription patterns
+ * ("vanguard/+/+/presence", "homeassistant/sensor/+/#"). At registration
+ * each pattern is compiled into a segment trie, so dispatching a topic is
+ * one walk down the trie instead of a chain of indexOf() calls, and the
+ * same table gives the list of topics to subscribe to.
+ *
+ * Captures ('+' segments, then the '#' remainder) are returned as spans
+ * into the topic. Nothing here allocates: nodes and routes live in fixed
+ * arrays and patterns are borrowed.
+ *
+ * When several patterns match, the most specific one wins: at every level
+ * a literal segment is tried before '+', and '+' before '#'. Only that
+ * handler runs.
+ *
+ * Author: KVN System
+ * Version: 1.0.0
+ */
+
+#ifndef KVN_ROUTER_H
+#define KVN_ROUTER_H
+
+#include <Arduino.h>
+
+#define KVN_ROUTER_MAX_ROUTES    16
+#define KVN_ROUTER_MAX_NODES     48    // Trie nodes, one per distinct pattern segment
+#define KVN_ROUTER_MAX_CAPTURES  4
+#define KVN_ROUTER_MAX_SEGMENTS  8     // Longer topics only match through '#'
+
+// Part of a topic. Not NUL-terminated.
+struct KVNTopicSpan {
+    const char* data;
+    uint8_t length;
+
+    bool equals(const char* s) const;
+
+    // Copy into `buf` with a terminating NUL. Returns false if it did not fit.
+    bool copyTo(char* buf, size_t size) const;
+};
+
+struct KVNTopicMatch {
+    const char* topic;
+    const uint8_t* payload;
+    unsigned int length;           // Payload bytes
+    uint8_t route;                 // Index in registration order
+
+    KVNTopicSpan captures[KVN_ROUTER_MAX_CAPTURES];
+    uint8_t captureCount;
+
+    const KVNTopicSpan& operator[](uint8_t i) const { return captures[i]; }
+};
+
+enum KVNRouteSegment : uint8_t {
+    KVN_ROUTE_LITERAL,
+    KVN_ROUTE_PLUS,
+    KVN_ROUTE_HASH
+};
+
+struct KVNRouteNode {
+    const char* segment;           // Borrowed from the pattern (literals only)
+    uint8_t length;
+    KVNRouteSegment kind;
+    int8_t firstChild;             // Children: literals, then '+', then '#'
+    int8_t nextSibling;
+    int8_t route;                  // Pattern ending here, or -1
+};
+
+class KVN_Router {
+public:
+    typedef void (*Handler)(const KVNTopicMatch& match);
+
+    KVN_Router();
+
+    // Register `handler` for `pattern` (must outlive the router). Returns
+    // the route index, or -1 if the pattern is malformed, a duplicate, has
+    // more than KVN_ROUTER_MAX_CAPTURES wildcards, or a table is full.
+    int on(const char* pattern, Handler handler);
+
+    // Route one message to the best matching handler. Takes PubSubClient
+    // callback arguments as they are. Returns false if nothing matched.
+    bool dispatch(const char* topic, const uint8_t* payload, unsigned int length);
+
+    // Match only: fills `match` (payload left empty) without calling a handler
+    bool match(const char* topic, KVNTopicMatch& match) const;
+
+    // Patterns in registration order, e.g. to subscribe to each one
+    uint8_t routeCount() const { return _routeCount; }
+    const char* pattern(uint8_t route) const { return _patterns[route]; }
+
+    uint32_t unmatched() const { return _unmatched; }
+
+private:
+    KVNRouteNode _nodes[KVN_ROUTER_MAX_NODES];
+    uint8_t _nodeCount;
+
+    const char* _patterns[KVN_ROUTER_MAX_ROUTES];
+    Handler _handlers[KVN_ROUTER_MAX_ROUTES];
+    uint8_t _routeCount;
+
+    uint32_t _unmatched;
+
+    int child(int parent, KVNRouteSegment kind, const char* segment, uint8_t length);
+    bool walk(int node, const KVNTopicSpan* segments, uint8_t count, uint8_t index,
+              KVNTopicMatch& match) const;
+};
+
+#endif // KVN_ROUTER_H
@@ -0,0 +1,197 @@
+/*
+ * KVN_Router Route Benchmark
+ *
+ * Dispatches a million topics from a mix of relay and hub traffic
+ * through the old String/indexOf() classification and through
+ * KVN_Router, and prints ns per topic and heap used for each. Both must
+ * agree on the category and device ID of every topic in the mix. Then
+ * runs a set of matching checks and prints PASS/FAIL for each.
+ *
+ * No WiFi needed - open Serial Monitor at 115200.
+ */
+
+#include <KVN_Router.h>
+
+#define DISPATCHES 1000000UL
+
+enum Category { CAT_LUX, CAT_AMBIENT, CAT_PRESENCE, CAT_STATUS, CAT_CONTROL, CAT_AI, CAT_OTHER, CAT_COUNT };
+
+const char* const TOPICS[] = {
+    "homeassistant/sensor/esp32_c3_scout1/lux",
+    "homeassistant/sensor/esp32_c3_scout7/temperature",
+    "vanguard/esp32_s3_watchtower2/ambient_light",
+    "vanguard/scout/esp32_c3_scout4/presence",
+    "vanguard/node/esp32_s3_node1/status",
+    "vanguard/control/esp32_c6_relay/restart",
+    "vanguard/ai/context/light",
+    "vanguard/hub/diagnostics",
+};
+const uint8_t TOPIC_COUNT = sizeof(TOPICS) / sizeof(TOPICS[0]);
+
+uint32_t counts[CAT_COUNT];
+char lastDevice[32];
+
+// ==================== OLD: String + indexOf() ====================
+
+// The classification the relay and hub callbacks used to do
+Category classifyIndexOf(const char* topic) {
+    String topicStr = String(topic);
+
+    Category cat = CAT_OTHER;
+    if (topicStr.indexOf("/lux") > 0) cat = CAT_LUX;
+    else if (topicStr.indexOf("/ambient_light") > 0) cat = CAT_AMBIENT;
+    else if (topicStr.indexOf("/presence") > 0) cat = CAT_PRESENCE;
+    else if (topicStr.indexOf("/status") > 0 && topicStr.indexOf("esp32_") >= 0) cat = CAT_STATUS;
+    else if (topicStr.startsWith("vanguard/control/")) cat = CAT_CONTROL;
+    else if (topicStr.startsWith("vanguard/ai/")) cat = CAT_AI;
+
+    int deviceIdStart = topicStr.indexOf("esp32_");
+    if (deviceIdStart >= 0) {
+        int deviceIdEnd = topicStr.indexOf("/", deviceIdStart);
+        if (deviceIdEnd < 0) deviceIdEnd = topicStr.length();
+        String deviceId = topicStr.substring(deviceIdStart, deviceIdEnd);
+        deviceId.toCharArray(lastDevice, sizeof(lastDevice));
+    } else {
+        lastDevice[0] = '\0';
+    }
+    return cat;
+}
+
+// ==================== NEW: KVN_Router ====================
+
+KVN_Router router;
+Category routed;
+
+void onLux(const KVNTopicMatch& m)      { routed = CAT_LUX;      m[0].copyTo(lastDevice, sizeof(lastDevice)); }
+void onSensor(const KVNTopicMatch& m)   { routed = CAT_OTHER;    m[0].copyTo(lastDevice, sizeof(lastDevice)); }
+void onAmbient(const KVNTopicMatch& m)  { routed = CAT_AMBIENT;  m[0].copyTo(lastDevice, sizeof(lastDevice)); }
+void onPresence(const KVNTopicMatch& m) { routed = CAT_PRESENCE; m[1].copyTo(lastDevice, sizeof(lastDevice)); }
+void onStatus(const KVNTopicMatch& m)   { routed = CAT_STATUS;   m[1].copyTo(lastDevice, sizeof(lastDevice)); }
+void onControl(const KVNTopicMatch& m)  { routed = CAT_CONTROL;  m[0].copyTo(lastDevice, sizeof(lastDevice)); }
+void onAI(const KVNTopicMatch& m)       { routed = CAT_AI;       lastDevice[0] = '\0'; }
+
+Category classifyRouter(const char* topic) {
+    routed = CAT_OTHER;
+    lastDevice[0] = '\0';
+    router.dispatch(topic, nullptr, 0);
+    return routed;
+}
+
+// ==================== BENCHMARK ====================
+
+void benchmark(const char* name, Category (*classify)(const char*)) {
+    memset(counts, 0, sizeof(counts));
+    uint32_t heapBefore = ESP.getFreeHeap();
+    uint32_t minHeap = heapBefore;
+
+    unsigned long start = micros();
+    for (uint32_t i = 0; i < DISPATCHES; i++) {
+        counts[classify(TOPICS[i % TOPIC_COUNT])]++;
+        if ((i & 0xFFF) == 0) {
+            uint32_t heap = ESP.getFreeHeap();
+            if (heap < minHeap) minHeap = heap;
+        }
+    }
+    unsigned long elapsed = micros() - start;
+
+    Serial.printf("%-8s %7.1f ns/topic  %5u heap bytes  lux=%lu other=%lu\n",
+                  name, elapsed * 1000.0f / DISPATCHES, (unsigned)(heapBefore - minHeap),
+                  (unsigned long)counts[CAT_LUX], (unsigned long)counts[CAT_OTHER]);
+}
+
+// ==================== CHECKS ====================
+
+int lastRoute;
+char captures[KVN_ROUTER_MAX_CAPTURES][48];
+uint8_t captureCount;
+
+void record(const KVNTopicMatch& m) {
+    lastRoute = m.route;
+    captureCount = m.captureCount;
+    for (uint8_t i = 0; i < m.captureCount; i++) m[i].copyTo(captures[i], sizeof(captures[i]));
+}
+
+bool routes(KVN_Router& r, const char* topic, int route, const char* cap0 = nullptr, const char* cap1 = nullptr) {
+    lastRoute = -1;
+    captureCount = 0;
+    if (!r.dispatch(topic, nullptr, 0) || lastRoute != route) return false;
+    if (cap0 && (captureCount < 1 || strcmp(captures[0], cap0) != 0)) return false;
+    if (cap1 && (captureCount < 2 || strcmp(captures[1], cap1) != 0)) return false;
+    return true;
+}
+
+void check(const char* name, bool ok) {
+    Serial.printf("  %-32s %s\n", name, ok ? "PASS" : "FAIL");
+}
+
+void runChecks() {
+    KVN_Router r;
+    r.on("vanguard/+/+/presence", record);          // 0
+    r.on("vanguard/hub/ambient_light", record);     // 1
+    r.on("vanguard/+/ambient_light", record);       // 2
+    r.on("homeassistant/sensor/+/#", record);       // 3
+    r.on("vanguard/#", record);                     // 4
+
+    check("'+' captures", routes(r, "vanguard/scout/esp32_x/presence", 0, "scout", "esp32_x"));
+    check("literal beats '+'", routes(r, "vanguard/hub/ambient_light", 1) && captureCount == 0);
+    check("'+' beats '#'", routes(r, "vanguard/c3/ambient_light", 2, "c3"));
+    check("'#' captures the rest", routes(r, "homeassistant/sensor/x/lux/raw", 3, "x", "lux/raw"));
+    check("'#' matches the parent", routes(r, "homeassistant/sensor/x", 3, "x", ""));
+    check("'#' after a failed branch", routes(r, "vanguard/scout/esp32_x/other", 4, "scout/esp32_x/other"));
+    check("deep topics reach '#'", routes(r, "vanguard/a/b/c/d/e/f/g/h/i", 4, "a/b/c/d/e/f/g/h/i"));
+    check("no match counted", !r.dispatch("other/topic", nullptr, 0) && r.unmatched() == 1);
+    check("'+' needs exactly one level", !r.dispatch("homeassistant/sensor", nullptr, 0));
+
+    KVN_Router bad;
+    check("duplicate rejected", bad.on("a/+", record) == 0 && bad.on("a/+", record) < 0);
+    check("'#' only last", bad.on("a/#/b", record) < 0);
+    check("wildcard inside a level rejected", bad.on("a/b+", record) < 0);
+
+    KVN_Router root;
+    root.on("#", record);
+    root.on("+/x", record);
+    check("wildcards skip $ topics", !root.dispatch("$SYS/x", nullptr, 0));
+    check("empty levels match '+'", routes(root, "/x", 1, ""));
+}
+
+// ==================== SKETCH ====================
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("\n=== KVN_Router Route Benchmark ===\n");
+
+    router.on("homeassistant/sensor/+/lux", onLux);
+    router.on("homeassistant/sensor/+/+", onSensor);
+    router.on("vanguard/+/ambient_light", onAmbient);
+    router.on("vanguard/+/+/presence", onPresence);
+    router.on("vanguard/+/+/status", onStatus);
+    router.on("vanguard/control/+/+", onControl);
+    router.on("vanguard/ai/#", onAI);
+
+    // Both classifiers must agree before timing them
+    bool agree = true;
+    for (uint8_t i = 0; i < TOPIC_COUNT; i++) {
+        char device[sizeof(lastDevice)];
+        Category a = classifyIndexOf(TOPICS[i]);
+        strcpy(device, lastDevice);
+        Category b = classifyRouter(TOPICS[i]);
+        if (a != b || strcmp(device, lastDevice) != 0) {
+            Serial.printf("Mismatch: %s\n", TOPICS[i]);
+            agree = false;
+        }
+    }
+    Serial.printf("%lu dispatches over %u topics, classifiers %s\n\n",
+                  DISPATCHES, TOPIC_COUNT, agree ? "agree" : "DISAGREE");
+
+    benchmark("indexOf", classifyIndexOf);
+    benchmark("router", classifyRouter);
+
+    Serial.println("\nChecks:");
+    check("classifiers agree on every topic", agree);
+    runChecks();
+}
+
+void loop() {
+}
@@ -0,0 +1,153 @@
+/*
+ * KVN_JsonWriter.cpp - Implementation
+ */
+
+#include "KVN_JsonWriter.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+KVN_JsonWriter::KVN_JsonWriter(char* buffer, size_t capacity) {
+    _buf = buffer;
+    _cap = capacity;
+    _len = 0;
+    _overflow = capacity == 0;
+    _depth = 0;
+
+    open(nullptr, '{', '}');
+}
+
+void KVN_JsonWriter::put(char c) {
+    // Always leave room for the terminating NUL
+    if (_len + 1 >= _cap) {
+        _overflow = true;
+        return;
+    }
+    _buf[_len++] = c;
+}
+
+void KVN_JsonWriter::put(const char* s) {
+    while (*s) put(*s++);
+}
+
+void KVN_JsonWriter::putEscaped(const char* s, size_t length) {
+    put('"');
+    for (size_t i = 0; i < length; i++) {
+        char c = s[i];
+        if (c == '"' || c == '\\') {
+            put('\\');
+            put(c);
+        } else if ((uint8_t)c < 0x20) {
+            char esc[7];
+            snprintf(esc, sizeof(esc), "\\u%04x", (uint8_t)c);
+            put(esc);
+        } else {
+            put(c);
+        }
+    }
+    put('"');
+}
+
+void KVN_JsonWriter::key(const char* k) {
+    if (_depth > 0) {
+        if (!_first[_depth - 1]) put(',');
+        _first[_depth - 1] = false;
+    }
+    if (k != nullptr) {
+        putEscaped(k, strlen(k));
+        put(':');
+    }
+}
+
+void KVN_JsonWriter::open(const char* k, char opener, char closer) {
+    if (_depth >= KVN_JSON_MAX_DEPTH) {
+        _overflow = true;
+        return;
+    }
+    if (_depth > 0) key(k);
+    put(opener);
+    _closers[_depth] = closer;
+    _first[_depth] = true;
+    _depth++;
+}
+
+void KVN_JsonWriter::close() {
+    if (_depth == 0) return;
+    _depth--;
+    put(_closers[_depth]);
+}
+
+// Room for a 64-bit long: 20 characters with the sign, and the NUL
+#define NUM_CHARS 21
+
+KVN_JsonWriter& KVN_JsonWriter::addInt(const char* k, long value) {
+    char num[NUM_CHARS];
+    snprintf(num, sizeof(num), "%ld", value);
+    key(k);
+    put(num);
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::addUInt(const char* k, unsigned long value) {
+    char num[NUM_CHARS];
+    snprintf(num, sizeof(num), "%lu", value);
+    key(k);
+    put(num);
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::addFloat(const char* k, float value, uint8_t decimals) {
+    char num[24];
+    if (isnan(value) || isinf(value)) {
+        strcpy(num, "null");  // JSON has no NaN/Inf
+    } else {
+        snprintf(num, sizeof(num), "%.*f", decimals, (double)value);
+    }
+    key(k);
+    put(num);
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::addBool(const char* k, bool value) {
+    key(k);
+    put(value ? "true" : "false");
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::addString(const char* k, const char* value) {
+    return addString(k, value, strlen(value));
+}
+
+KVN_JsonWriter& KVN_JsonWriter::addString(const char* k, const char* value, size_t length) {
+    key(k);
+    putEscaped(value, length);
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::beginObject(const char* k) {
+    open(k, '{', '}');
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::endObject() {
+    close();
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::beginArray(const char* k) {
+    open(k, '[', ']');
+    return *this;
+}
+
+KVN_JsonWriter& KVN_JsonWriter::endArray() {
+    close();
+    return *this;
+}
+
+const char* KVN_JsonWriter::finish() {
+    while (_depth > 0) close();
+
+    if (_cap == 0) return nullptr;
+    _buf[_len < _cap ? _len : _cap - 1] = '\0';
+    return _overflow ? nullptr : _buf;
+}
@@ -0,0 +1,69 @@
+/*
+ * KVN_JsonWriter.h - Heap-free JSON builder
+ *
+ * Writes compact JSON straight into a caller-provided buffer (usually on
+ * the stack). Replaces chains of `String +=` that allocate on every step.
+ * On overflow the writer stops and finish() returns nullptr, so a
+ * truncated document is never published.
+ *
+ *   char buf[128];
+ *   KVN_JsonWriter json(buf, sizeof(buf));
+ *   json.addUInt("rx", messagesRX);
+ *   json.addBool("online", true);
+ *   mqtt.publish(topic, json.finish());
+ *
+ * Author: KVN System
+ * Version: 1.0.0
+ */
+
+#ifndef KVN_JSON_WRITER_H
+#define KVN_JSON_WRITER_H
+
+#include <Arduino.h>
+
+#define KVN_JSON_MAX_DEPTH 8
+
+class KVN_JsonWriter {
+public:
+    // Opens the root object immediately
+    KVN_JsonWriter(char* buffer, size_t capacity);
+
+    // Pass key = nullptr for array elements
+    KVN_JsonWriter& addInt(const char* key, long value);
+    KVN_JsonWriter& addUInt(const char* key, unsigned long value);
+    KVN_JsonWriter& addFloat(const char* key, float value, uint8_t decimals = 2);
+    KVN_JsonWriter& addBool(const char* key, bool value);
+    KVN_JsonWriter& addString(const char* key, const char* value);
+    KVN_JsonWriter& addString(const char* key, const char* value, size_t length);
+
+    KVN_JsonWriter& beginObject(const char* key = nullptr);
+    KVN_JsonWriter& endObject();
+    KVN_JsonWriter& beginArray(const char* key = nullptr);
+    KVN_JsonWriter& endArray();
+
+    // Closes any open scopes and NUL-terminates.
+    // Returns the buffer, or nullptr if it was too small.
+    const char* finish();
+
+    size_t length() const { return _len; }
+    bool overflowed() const { return _overflow; }
+
+private:
+    char* _buf;
+    size_t _cap;
+    size_t _len;
+    bool _overflow;
+
+    uint8_t _depth;
+    char _closers[KVN_JSON_MAX_DEPTH];
+    bool _first[KVN_JSON_MAX_DEPTH];
+
+    void put(char c);
+    void put(const char* s);
+    void putEscaped(const char* s, size_t length);
+    void key(const char* k);
+    void open(const char* k, char opener, char closer);
+    void close();
+};
+
+#endif // KVN_JSON_WRITER_H
@@ -0,0 +1,362 @@
+/*
+ * KVN_Telemetry.cpp - Implementation
+ */
+
+#include "KVN_Telemetry.h"
+#include <string.h>
+
+// CBOR major types
+#define CBOR_UINT   0
+#define CBOR_NEGINT 1
+#define CBOR_TEXT   3
+#define CBOR_MAP    5
+#define CBOR_SIMPLE 7
+
+#define CBOR_FALSE   0xF4
+#define CBOR_TRUE    0xF5
+#define CBOR_FLOAT32 0xFA
+
+// Frame map keys
+#define FRAME_KEY_ID     0
+#define FRAME_KEY_SEQ    1
+#define FRAME_KEY_TS     2
+#define FRAME_KEY_FIELDS 3
+
+static const char* const FIELD_KEYS[KVN_TM_FIELD_COUNT] = {
+    nullptr,
+    "raw",
+    "lux",
+    "level",
+    "is_day",
+    "battery_mv",
+    "uptime_ms",
+    "online",
+    "rssi",
+    "rx",
+    "tx",
+    "buffer",
+    "dropped",
+    "uptime",
+    "heap_min",
+    "temperature",
+    "humidity",
+    "pressure",
+};
+
+// ==================== CBOR WRITER ====================
+
+struct CborOut {
+    uint8_t* buf;
+    size_t cap;
+    size_t len;
+    bool overflow;
+
+    void byte(uint8_t b) {
+        if (len >= cap) {
+            overflow = true;
+            return;
+        }
+        buf[len++] = b;
+    }
+
+    void head(uint8_t major, uint32_t arg) {
+        major <<= 5;
+        if (arg < 24) {
+            byte(major | arg);
+        } else if (arg <= 0xFF) {
+            byte(major | 24);
+            byte(arg);
+        } else if (arg <= 0xFFFF) {
+            byte(major | 25);
+            byte(arg >> 8);
+            byte(arg);
+        } else {
+            byte(major | 26);
+            byte(arg >> 24);
+            byte(arg >> 16);
+            byte(arg >> 8);
+            byte(arg);
+        }
+    }
+
+    void text(const char* s, size_t n) {
+        head(CBOR_TEXT, n);
+        for (size_t i = 0; i < n; i++) byte(s[i]);
+    }
+};
+
+// ==================== CBOR READER ====================
+
+struct CborIn {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+
+    bool byte(uint8_t& b) {
+        if (pos >= len) return false;
+        b = data[pos++];
+        return true;
+    }
+
+    // Reads an initial byte and its argument (no 64-bit or indefinite)
+    bool head(uint8_t& major, uint8_t& info, uint32_t& arg) {
+        uint8_t ib;
+        if (!byte(ib)) return false;
+        major = ib >> 5;
+        info = ib & 0x1F;
+
+        if (info < 24) {
+            arg = info;
+            return true;
+        }
+
+        int n = info == 24 ? 1 : info == 25 ? 2 : info == 26 ? 4 : 0;
+        if (n == 0) return false;
+
+        arg = 0;
+        for (int i = 0; i < n; i++) {
+            uint8_t b;
+            if (!byte(b)) return false;
+            arg = (arg << 8) | b;
+        }
+        return true;
+    }
+
+    bool uint(uint32_t& value) {
+        uint8_t major, info;
+        return head(major, info, value) && major == CBOR_UINT;
+    }
+
+    bool text(const char*& s, uint16_t& n) {
+        uint8_t major, info;
+        uint32_t arg;
+        if (!head(major, info, arg) || major != CBOR_TEXT) return false;
+        if (arg > len - pos || arg > 0xFFFF) return false;
+        s = (const char*)data + pos;
+        n = arg;
+        pos += arg;
+        return true;
+    }
+};
+
+// ==================== FRAME ====================
+
+KVN_Telemetry::KVN_Telemetry() {
+    begin("", 0, 0);
+}
+
+void KVN_Telemetry::begin(const char* deviceId, uint32_t seq, uint32_t timestamp) {
+    _deviceId = deviceId;
+    _deviceIdLen = strlen(deviceId);
+    _seq = seq;
+    _timestamp = timestamp;
+    _count = 0;
+}
+
+KVNTelemetryValue* KVN_Telemetry::next(uint8_t field, KVNTelemetryType type) {
+    if (_count >= KVN_TM_MAX_FIELDS) return nullptr;
+
+    KVNTelemetryValue* v = &_values[_count++];
+    v->field = field;
+    v->type = type;
+    v->u = 0;
+    v->s = nullptr;
+    v->length = 0;
+    return v;
+}
+
+bool KVN_Telemetry::addUInt(uint8_t field, uint32_t value) {
+    KVNTelemetryValue* v = next(field, KVN_TM_TYPE_UINT);
+    if (v) v->u = value;
+    return v != nullptr;
+}
+
+bool KVN_Telemetry::addInt(uint8_t field, int32_t value) {
+    KVNTelemetryValue* v = next(field, KVN_TM_TYPE_INT);
+    if (v) v->i = value;
+    return v != nullptr;
+}
+
+bool KVN_Telemetry::addFloat(uint8_t field, float value) {
+    KVNTelemetryValue* v = next(field, KVN_TM_TYPE_FLOAT);
+    if (v) v->f = value;
+    return v != nullptr;
+}
+
+bool KVN_Telemetry::addBool(uint8_t field, bool value) {
+    KVNTelemetryValue* v = next(field, KVN_TM_TYPE_BOOL);
+    if (v) v->b = value;
+    return v != nullptr;
+}
+
+bool KVN_Telemetry::addString(uint8_t field, const char* value) {
+    KVNTelemetryValue* v = next(field, KVN_TM_TYPE_STRING);
+    if (v) {
+        v->s = value;
+        v->length = strlen(value);
+    }
+    return v != nullptr;
+}
+
+const KVNTelemetryValue* KVN_Telemetry::find(uint8_t field) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_values[i].field == field) return &_values[i];
+    }
+    return nullptr;
+}
+
+const char* KVN_Telemetry::fieldKey(uint8_t field) {
+    return field < KVN_TM_FIELD_COUNT ? FIELD_KEYS[field] : nullptr;
+}
+
+// ==================== JSON ====================
+
+void KVN_Telemetry::writeFields(KVN_JsonWriter& json) const {
+    char fallback[8];
+
+    for (uint8_t i = 0; i < _count; i++) {
+        const KVNTelemetryValue& v = _values[i];
+
+        // Unknown IDs (newer sender) still round-trip as "f<id>"
+        const char* key = fieldKey(v.field);
+        if (key == nullptr) {
+            snprintf(fallback, sizeof(fallback), "f%u", v.field);
+            key = fallback;
+        }
+
+        switch (v.type) {
+            case KVN_TM_TYPE_UINT:   json.addUInt(key, v.u); break;
+            case KVN_TM_TYPE_INT:    json.addInt(key, v.i); break;
+            case KVN_TM_TYPE_FLOAT:  json.addFloat(key, v.f); break;
+            case KVN_TM_TYPE_BOOL:   json.addBool(key, v.b); break;
+            case KVN_TM_TYPE_STRING: json.addString(key, v.s, v.length); break;
+        }
+    }
+}
+
+size_t KVN_Telemetry::toJSON(char* buffer, size_t capacity, bool header) const {
+    KVN_JsonWriter json(buffer, capacity);
+
+    if (header) {
+        json.addString("id", _deviceId, _deviceIdLen);
+        json.addUInt("seq", _seq);
+        json.addUInt("ts", _timestamp);
+    }
+    writeFields(json);
+
+    return json.finish() ? json.length() : 0;
+}
+
+// ==================== CBOR ====================
+
+size_t KVN_Telemetry::toCBOR(uint8_t* buffer, size_t capacity) const {
+    CborOut out = {buffer, capacity, 0, false};
+
+    out.head(CBOR_MAP, 4);
+    out.head(CBOR_UINT, FRAME_KEY_ID);
+    out.text(_deviceId, _deviceIdLen);
+    out.head(CBOR_UINT, FRAME_KEY_SEQ);
+    out.head(CBOR_UINT, _seq);
+    out.head(CBOR_UINT, FRAME_KEY_TS);
+    out.head(CBOR_UINT, _timestamp);
+
+    out.head(CBOR_UINT, FRAME_KEY_FIELDS);
+    out.head(CBOR_MAP, _count);
+    for (uint8_t i = 0; i < _count; i++) {
+        const KVNTelemetryValue& v = _values[i];
+        out.head(CBOR_UINT, v.field);
+
+        switch (v.type) {
+            case KVN_TM_TYPE_UINT:
+                out.head(CBOR_UINT, v.u);
+                break;
+            case KVN_TM_TYPE_INT:
+                if (v.i >= 0) {
+                    out.head(CBOR_UINT, (uint32_t)v.i);
+                } else {
+                    out.head(CBOR_NEGINT, (uint32_t)(-1 - v.i));
+                }
+                break;
+            case KVN_TM_TYPE_FLOAT: {
+                uint32_t bits;
+                memcpy(&bits, &v.f, sizeof(bits));
+                out.byte(CBOR_FLOAT32);
+                out.byte(bits >> 24);
+                out.byte(bits >> 16);
+                out.byte(bits >> 8);
+                out.byte(bits);
+                break;
+            }
+            case KVN_TM_TYPE_BOOL:
+                out.byte(v.b ? CBOR_TRUE : CBOR_FALSE);
+                break;
+            case KVN_TM_TYPE_STRING:
+                out.text(v.s, v.length);
+                break;
+        }
+    }
+
+    return out.overflow ? 0 : out.len;
+}
+
+bool KVN_Telemetry::fromCBOR(const uint8_t* data, size_t length) {
+    CborIn in = {data, length, 0};
+    uint8_t major, info;
+    uint32_t arg;
+
+    _count = 0;
+
+    if (!in.head(major, info, arg) || major != CBOR_MAP || arg != 4) return false;
+
+    uint32_t key;
+    if (!in.uint(key) || key != FRAME_KEY_ID) return false;
+    if (!in.text(_deviceId, _deviceIdLen)) return false;
+    if (!in.uint(key) || key != FRAME_KEY_SEQ || !in.uint(_seq)) return false;
+    if (!in.uint(key) || key != FRAME_KEY_TS || !in.uint(_timestamp)) return false;
+    if (!in.uint(key) || key != FRAME_KEY_FIELDS) return false;
+
+    uint32_t fieldCount;
+    if (!in.head(major, info, fieldCount) || major != CBOR_MAP) return false;
+    if (fieldCount > KVN_TM_MAX_FIELDS) return false;
+
+    for (uint32_t i = 0; i < fieldCount; i++) {
+        uint32_t field;
+        if (!in.uint(field) || field > 0xFF) return false;
+
+        size_t valueStart = in.pos;
+        if (!in.head(major, info, arg)) return false;
+
+        KVNTelemetryValue* v;
+        switch (major) {
+            case CBOR_UINT:
+                v = next(field, KVN_TM_TYPE_UINT);
+                v->u = arg;
+                break;
+            case CBOR_NEGINT:
+                if (arg > 0x7FFFFFFF) return false;
+                v = next(field, KVN_TM_TYPE_INT);
+                v->i = -1 - (int32_t)arg;
+                break;
+            case CBOR_TEXT:
+                in.pos = valueStart;
+                v = next(field, KVN_TM_TYPE_STRING);
+                if (!in.text(v->s, v->length)) return false;
+                break;
+            case CBOR_SIMPLE:
+                if (info == (CBOR_FALSE & 0x1F) || info == (CBOR_TRUE & 0x1F)) {
+                    v = next(field, KVN_TM_TYPE_BOOL);
+                    v->b = info == (CBOR_TRUE & 0x1F);
+                } else if (info == (CBOR_FLOAT32 & 0x1F)) {
+                    v = next(field, KVN_TM_TYPE_FLOAT);
+                    memcpy(&v->f, &arg, sizeof(arg));
+                } else {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return in.pos == length;
+}
@@ -0,0 +1,125 @@
+/*
+ * KVN_Telemetry.h - Schema-driven telemetry frames
+ *
+ * A frame carries a device ID, a sequence number, a timestamp and a set of
+ * typed fields from the shared KVN field table below. The same frame can
+ * be written as compact JSON (for Home Assistant) or as a CBOR binary
+ * frame (for battery devices that pay per byte of radio-on time), and the
+ * hub decodes binary frames back into the same structure.
+ *
+ * Nothing here allocates: frames live on the stack, strings are borrowed
+ * pointers, and output goes into caller-provided buffers.
+ *
+ * CBOR frame layout (RFC 8949 subset):
+ *   map(4) { 0: text deviceId, 1: uint seq, 2: uint timestamp,
+ *            3: map(n) { fieldId: value, ... } }
+ *
+ * Author: KVN System
+ * Version: 1.0.0
+ */
+
+#ifndef KVN_TELEMETRY_H
+#define KVN_TELEMETRY_H
+
+#include <Arduino.h>
+#include "KVN_JsonWriter.h"
+
+#define KVN_TM_MAX_FIELDS 16
+
+// Well-known field IDs. IDs go on the wire; only ever append to this list.
+enum KVNTelemetryField : uint8_t {
+    KVN_TM_RAW = 1,      // "raw"        LDR ADC value
+    KVN_TM_LUX,          // "lux"
+    KVN_TM_LEVEL,        // "level"      LDR_LEVEL_*
+    KVN_TM_IS_DAY,       // "is_day"
+    KVN_TM_BATTERY_MV,   // "battery_mv"
+    KVN_TM_UPTIME_MS,    // "uptime_ms"
+    KVN_TM_ONLINE,       // "online"
+    KVN_TM_RSSI,         // "rssi"
+    KVN_TM_RX,           // "rx"
+    KVN_TM_TX,           // "tx"
+    KVN_TM_BUFFER,       // "buffer"
+    KVN_TM_DROPPED,      // "dropped"
+    KVN_TM_UPTIME,       // "uptime"     seconds
+    KVN_TM_HEAP_MIN,     // "heap_min"
+    KVN_TM_TEMPERATURE,  // "temperature"
+    KVN_TM_HUMIDITY,     // "humidity"
+    KVN_TM_PRESSURE,     // "pressure"   hPa
+    KVN_TM_FIELD_COUNT
+};
+
+enum KVNTelemetryType : uint8_t {
+    KVN_TM_TYPE_UINT,
+    KVN_TM_TYPE_INT,
+    KVN_TM_TYPE_FLOAT,
+    KVN_TM_TYPE_BOOL,
+    KVN_TM_TYPE_STRING
+};
+
+struct KVNTelemetryValue {
+    uint8_t field;
+    KVNTelemetryType type;
+    union {
+        uint32_t u;
+        int32_t i;
+        float f;
+        bool b;
+    };
+    const char* s;     // KVN_TM_TYPE_STRING (not NUL-terminated after decode)
+    uint16_t length;   // String length
+};
+
+class KVN_Telemetry {
+public:
+    KVN_Telemetry();
+
+    // Start a new frame. deviceId is borrowed and must outlive the frame.
+    void begin(const char* deviceId, uint32_t seq, uint32_t timestamp);
+
+    // Returns false when the frame is full
+    bool addUInt(uint8_t field, uint32_t value);
+    bool addInt(uint8_t field, int32_t value);
+    bool addFloat(uint8_t field, float value);
+    bool addBool(uint8_t field, bool value);
+    bool addString(uint8_t field, const char* value);
+
+    // Compact JSON of the fields, e.g. {"raw":1234,"lux":56}.
+    // With header, "id", "seq" and "ts" are included too.
+    // Returns length written, 0 if the buffer was too small.
+    size_t toJSON(char* buffer, size_t capacity, bool header = false) const;
+
+    // Add this frame's fields to an existing JSON document
+    void writeFields(KVN_JsonWriter& json) const;
+
+    // CBOR frame. Returns bytes written, 0 if the buffer was too small.
+    size_t toCBOR(uint8_t* buffer, size_t capacity) const;
+
+    // Parse a CBOR frame. Strings point into `data`, which must stay valid
+    // while the frame is used. Returns false on malformed input.
+    bool fromCBOR(const uint8_t* data, size_t length);
+
+    const char* deviceId() const { return _deviceId; }
+    uint16_t deviceIdLength() const { return _deviceIdLen; }
+    uint32_t seq() const { return _seq; }
+    uint32_t timestamp() const { return _timestamp; }
+
+    uint8_t fieldCount() const { return _count; }
+    const KVNTelemetryValue& fieldAt(uint8_t index) const { return _values[index]; }
+    const KVNTelemetryValue* find(uint8_t field) const;
+
+    // JSON key for a field ID, or nullptr if unknown
+    static const char* fieldKey(uint8_t field);
+
+private:
+    const char* _deviceId;
+    uint16_t _deviceIdLen;
+    uint32_t _seq;
+    uint32_t _timestamp;
+
+    KVNTelemetryValue _values[KVN_TM_MAX_FIELDS];
+    uint8_t _count;
+
+    KVNTelemetryValue* next(uint8_t field, KVNTelemetryType type);
+};
+
+#endif // KVN_TELEMETRY_H
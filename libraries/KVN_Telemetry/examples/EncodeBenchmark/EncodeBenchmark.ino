@@ -0,0 +1,211 @@
+/*
+ * KVN_Telemetry Encode Benchmark
+ *
+ * Compares the old String-concatenation status payload against
+ * KVN_JsonWriter and the CBOR frame: bytes on the wire, microseconds per
+ * encode and heap used. Also round-trips a set of frames through
+ * toCBOR()/fromCBOR() and prints PASS/FAIL for each.
+ *
+ * No WiFi needed - open Serial Monitor at 115200.
+ */
+
+#include <KVN_Telemetry.h>
+#include <limits.h>
+#include <math.h>
+
+#define ITERATIONS 2000
+
+const char* NODE_ID = "A1B2C3D4E5F6";
+
+uint32_t heapLow;
+
+// Called by each encoder while its buffers are still alive
+void noteHeap() {
+    uint32_t heap = ESP.getFreeHeap();
+    if (heap < heapLow) heapLow = heap;
+}
+
+// ==================== ENCODERS UNDER TEST ====================
+
+// The builder scouts_simple used before KVN_Telemetry
+size_t encodeString(uint32_t batteryMv, uint32_t uptimeMs) {
+    String payload = String("{") +
+        "\"node\":\"" + NODE_ID + "\"," +
+        "\"battery_mv\":" + batteryMv + "," +
+        "\"uptime_ms\":" + uptimeMs + "," +
+        "\"online\":true" +
+        "}";
+    noteHeap();
+    return payload.length();
+}
+
+size_t encodeJson(uint32_t batteryMv, uint32_t uptimeMs) {
+    char buf[128];
+    KVN_JsonWriter json(buf, sizeof(buf));
+    json.addString("node", NODE_ID);
+    json.addUInt("battery_mv", batteryMv);
+    json.addUInt("uptime_ms", uptimeMs);
+    json.addBool("online", true);
+    noteHeap();
+    return json.finish() ? json.length() : 0;
+}
+
+size_t encodeCbor(uint32_t batteryMv, uint32_t uptimeMs) {
+    KVN_Telemetry frame;
+    frame.begin(NODE_ID, 1, uptimeMs / 1000);
+    frame.addUInt(KVN_TM_BATTERY_MV, batteryMv);
+    frame.addUInt(KVN_TM_UPTIME_MS, uptimeMs);
+    frame.addBool(KVN_TM_ONLINE, true);
+
+    uint8_t buf[64];
+    size_t len = frame.toCBOR(buf, sizeof(buf));
+    noteHeap();
+    return len;
+}
+
+void benchmark(const char* name, size_t (*encode)(uint32_t, uint32_t)) {
+    uint32_t heapBefore = ESP.getFreeHeap();
+    heapLow = heapBefore;
+    size_t bytes = 0;
+
+    unsigned long start = micros();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        bytes = encode(3700 + (i & 0xFF), 86400000UL + i);
+    }
+    unsigned long elapsed = micros() - start;
+
+    Serial.printf("%-14s %4u bytes  %7.2f us/encode  %5u heap bytes\n",
+                  name, (unsigned)bytes, (float)elapsed / ITERATIONS,
+                  (unsigned)(heapBefore - heapLow));
+}
+
+// ==================== ROUND TRIP ====================
+
+bool sameValue(const KVNTelemetryValue& a, const KVNTelemetryValue& b) {
+    if (a.field != b.field) return false;
+
+    // CBOR has one non-negative integer type: addInt(x >= 0) reads back as uint
+    if (a.type == KVN_TM_TYPE_INT && b.type == KVN_TM_TYPE_UINT) return a.i >= 0 && (uint32_t)a.i == b.u;
+    if (a.type != b.type) return false;
+
+    switch (a.type) {
+        case KVN_TM_TYPE_UINT:   return a.u == b.u;
+        case KVN_TM_TYPE_INT:    return a.i == b.i;
+        case KVN_TM_TYPE_FLOAT:  return (isnan(a.f) && isnan(b.f)) || a.f == b.f;
+        case KVN_TM_TYPE_BOOL:   return a.b == b.b;
+        case KVN_TM_TYPE_STRING:
+            return a.length == b.length && memcmp(a.s, b.s, a.length) == 0;
+    }
+    return false;
+}
+
+bool roundTrip(const KVN_Telemetry& in) {
+    uint8_t buf[256];
+    size_t len = in.toCBOR(buf, sizeof(buf));
+    if (len == 0) return false;
+
+    KVN_Telemetry out;
+    if (!out.fromCBOR(buf, len)) return false;
+
+    if (out.seq() != in.seq() || out.timestamp() != in.timestamp()) return false;
+    if (out.deviceIdLength() != in.deviceIdLength()) return false;
+    if (memcmp(out.deviceId(), in.deviceId(), in.deviceIdLength()) != 0) return false;
+    if (out.fieldCount() != in.fieldCount()) return false;
+
+    for (uint8_t i = 0; i < in.fieldCount(); i++) {
+        if (!sameValue(in.fieldAt(i), out.fieldAt(i))) return false;
+    }
+
+    // Truncated input must be rejected, never read past the end
+    for (size_t cut = 0; cut < len; cut++) {
+        if (out.fromCBOR(buf, cut)) return false;
+    }
+
+    return true;
+}
+
+void check(const char* name, bool ok) {
+    Serial.printf("  %-28s %s\n", name, ok ? "PASS" : "FAIL");
+}
+
+void runRoundTrips() {
+    KVN_Telemetry frame;
+
+    frame.begin("", 0, 0);
+    check("empty frame", roundTrip(frame));
+
+    frame.begin(NODE_ID, 23, 24);
+    frame.addUInt(KVN_TM_RAW, 23);
+    frame.addUInt(KVN_TM_LUX, 24);
+    frame.addUInt(KVN_TM_RX, 255);
+    frame.addUInt(KVN_TM_TX, 256);
+    frame.addUInt(KVN_TM_UPTIME, 65535);
+    frame.addUInt(KVN_TM_UPTIME_MS, 65536);
+    frame.addUInt(KVN_TM_HEAP_MIN, 0xFFFFFFFF);
+    check("uint boundaries", roundTrip(frame));
+
+    frame.begin(NODE_ID, 0xFFFFFFFF, 1700000000);
+    frame.addInt(KVN_TM_RSSI, -1);
+    frame.addInt(KVN_TM_RSSI, -24);
+    frame.addInt(KVN_TM_RSSI, -25);
+    frame.addInt(KVN_TM_TEMPERATURE, -2147483647 - 1);
+    frame.addInt(KVN_TM_TEMPERATURE, 2147483647);
+    check("signed ints", roundTrip(frame));
+
+    frame.begin(NODE_ID, 1, 2);
+    frame.addFloat(KVN_TM_TEMPERATURE, 21.375f);
+    frame.addFloat(KVN_TM_HUMIDITY, -0.0f);
+    frame.addFloat(KVN_TM_LUX, NAN);
+    frame.addBool(KVN_TM_IS_DAY, true);
+    frame.addBool(KVN_TM_ONLINE, false);
+    check("floats and bools", roundTrip(frame));
+
+    const char* longText = "a string that is longer than twenty-three bytes";
+    frame.begin("esp32_watchtower_living_room", 3, 4);
+    frame.addString(KVN_TM_LEVEL, "");
+    frame.addString(KVN_TM_LEVEL, longText);
+    check("strings", roundTrip(frame));
+
+    frame.begin(NODE_ID, 5, 6);
+    for (uint8_t i = 0; i < KVN_TM_MAX_FIELDS; i++) {
+        frame.addUInt(KVN_TM_RAW + i, i * 1000);
+    }
+    check("full frame", roundTrip(frame) && !frame.addUInt(KVN_TM_RAW, 0));
+
+    uint8_t small[8];
+    check("CBOR overflow returns 0", frame.toCBOR(small, sizeof(small)) == 0);
+
+    char json[16];
+    check("JSON overflow returns 0", frame.toJSON(json, sizeof(json)) == 0);
+
+    // long is 64 bits on some targets: the extremes must come out whole
+    char wide[96], expected[96];
+    KVN_JsonWriter writer(wide, sizeof(wide));
+    writer.addInt("min", LONG_MIN).addUInt("max", ULONG_MAX);
+    snprintf(expected, sizeof(expected), "{\"min\":%ld,\"max\":%lu}", LONG_MIN, ULONG_MAX);
+    const char* written = writer.finish();
+    check("JSON long extremes", written && strcmp(written, expected) == 0);
+
+    const uint8_t garbage[] = {0xA4, 0x00, 0x7F, 0xFF};
+    check("malformed input rejected", !frame.fromCBOR(garbage, sizeof(garbage)));
+}
+
+// ==================== SKETCH ====================
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("\n=== KVN_Telemetry Encode Benchmark ===\n");
+    Serial.printf("%d iterations of the scouts_simple status payload\n\n", ITERATIONS);
+
+    benchmark("String", encodeString);
+    benchmark("KVN_JsonWriter", encodeJson);
+    benchmark("CBOR frame", encodeCbor);
+
+    Serial.println("\nRound trip:");
+    runRoundTrips();
+}
+
+void loop() {
+}